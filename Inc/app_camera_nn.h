@@ -0,0 +1,86 @@
+/**
+ ******************************************************************************
+ * @file    app_camera_nn.h
+ * @author  GPM Application Team
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2023 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+#ifndef APP_CAMERA_NN_H
+#define APP_CAMERA_NN_H
+
+#include <stdint.h>
+#include "app_pipeline.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Zero-copy capture: the NN pipe of the DCMIPP writes, in double buffer mode, straight into the input buffer of
+ * the pipeline slots (buffer i of the DCMIPP is the input of slot i), no copy nor conversion by the CPU.
+ *
+ * A buffer is owned either by the camera or by the NPU side. The frame event gives the captured buffer to the NPU
+ * side; when the next buffer is not given back yet the pipe is asked to stop at the end of the frame (sensor frames
+ * are skipped) and resumed once the slot is released by the post-processing. The frame event doesn't wait for the
+ * stop: app_camera_nn_process() confirms it before queueing the captured frame or resuming. If the frame event came
+ * after the start of the next frame, that frame still goes to the buffer held by the NPU side: it is counted in
+ * nb_late_frames and its buffer is left to the NPU side.
+ *
+ * Usage:
+ *   app_camera_nn_init(&cam, &pipe, NN_PIPE);   after CMW_CAMERA_Init() and app_pipeline_init()
+ *   app_camera_nn_start(&cam);
+ *   while (1) {
+ *     app_camera_nn_process(&cam);              queues captured frames, gives back released slots
+ *     app_pipeline_run(&pipe); ...              then app_pipeline_get_output()/app_pipeline_release_output()
+ *   }
+ *   app_camera_nn_frame_event(&cam, pipe) has to be called from CMW_CAMERA_PIPE_FrameEventCallback(), which
+ *   belongs to the application (other pipes may have their own frame event handling)
+ */
+
+typedef enum
+{
+  APP_CAMERA_NN_BUF_CAMERA = 0, /* Being written (or about to be) by the DCMIPP */
+  APP_CAMERA_NN_BUF_CAPTURED,   /* Frame complete, not queued for inference yet */
+  APP_CAMERA_NN_BUF_NPU,        /* Queued in the pipeline, up to the release of the slot */
+} app_camera_nn_buf_owner_t;
+
+typedef struct
+{
+  app_pipeline_t *pPipe;
+  uint32_t dcmipp_pipe;
+  volatile app_camera_nn_buf_owner_t owner[APP_PIPELINE_NB_SLOTS];
+  volatile uint32_t next_buf;  /* DCMIPP buffer written by the next frame */
+  volatile int suspended;
+  volatile int late_frame;     /* A frame started before the stop request, its frame event is still to come */
+  volatile uint32_t nb_late_frames;
+  volatile uint32_t nb_frames; /* Frames captured */
+  volatile uint32_t nb_suspends;
+} app_camera_nn_t;
+
+/* Configures the DCMIPP pipe to output NN_WIDTH x NN_HEIGHT NN_FORMAT frames. The first input of the network
+ * must be exactly one such frame. Returns 0 on success */
+int app_camera_nn_init(app_camera_nn_t *pCam, app_pipeline_t *pPipe, uint32_t dcmipp_pipe);
+
+/* Starts the continuous double buffered capture. Returns 0 on success */
+int app_camera_nn_start(app_camera_nn_t *pCam);
+
+/* To be called from the main loop: queues the captured frames and gives the released slots back to the camera */
+void app_camera_nn_process(app_camera_nn_t *pCam);
+
+/* Frame event of the DCMIPP (interrupt context), to be called from CMW_CAMERA_PIPE_FrameEventCallback() */
+void app_camera_nn_frame_event(app_camera_nn_t *pCam, uint32_t dcmipp_pipe);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_CAMERA_NN_H */
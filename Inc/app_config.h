@@ -78,6 +78,8 @@
 #define NN_HEIGHT 640
 #define NN_FORMAT DCMIPP_PIXEL_PACKER_FORMAT_RGB888_YUV444_1
 #define NN_BPP 3
+/* DCMIPP pipe writing the network input in place (see app_camera_nn.h) */
+#define NN_PIPE DCMIPP_PIPE2
 
 #define VDDCORE_OVERDRIVE               1               // Use Overdrive mode (quick clocks) or not (normal clocks)
 
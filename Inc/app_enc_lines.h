@@ -0,0 +1,115 @@
+/**
+ ******************************************************************************
+ * @file    app_enc_lines.h
+ * @author  GPM Application Team
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2023 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+#ifndef APP_ENC_LINES_H
+#define APP_ENC_LINES_H
+
+#include <stdint.h>
+#include "h264encapi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Low latency capture to H.264: the encoder reads a frame while the DCMIPP is still writing it. The line event of
+ * the pipe, every 16 lines, counts the macroblock rows in memory; the encoder runs in input line buffer mode with
+ * software handshake and, each time it has read the rows it was given, its line buffer callback gives it the rows
+ * captured since (H264EncSetInputMbLines()), waiting for them if needed. The top of the frame is encoded, and its
+ * slices sent, while the bottom is captured: the latency is a few macroblock rows instead of a frame.
+ *
+ * The pipe captures in double buffer mode, the encoder may lag up to one frame behind the camera. Frames are
+ * skipped when the encoder is late; when it lags more than one frame the frame is overwritten during its encoding
+ * (counted in nb_overruns), it is then completed with the rows available.
+ *
+ * The pAppData given to the slice ready callback of the encoder is the app_enc_lines_t, pUserData is the one of
+ * the application.
+ *
+ * Usage:
+ *   CMW_CAMERA_SetPipeConfig(pipe, &conf);           output format supported by the encoder, e.g. YUV422 YUYV
+ *   app_enc_lines_init(&enc, &lines_conf);
+ *   app_enc_lines_coding_ctrl(&enc, &codingCtrl);    before H264EncSetCodingCtrl()
+ *   app_enc_lines_start(&enc);
+ *   while (1) {
+ *     app_enc_lines_encode(&enc, &encIn, &encOut);   encodes the frame being captured
+ *   }
+ *   app_enc_lines_line_event(&enc, pipe) and app_enc_lines_frame_event(&enc, pipe) have to be called from
+ *   CMW_CAMERA_PIPE_LineEventCallback() and CMW_CAMERA_PIPE_FrameEventCallback(), which belong to the application
+ *   (other pipes may have their own event handling)
+ */
+
+typedef struct
+{
+  H264EncInst encoder;
+  uint32_t dcmipp_pipe;
+  uint32_t width;              /* Frame size, in pixels */
+  uint32_t height;
+  uint8_t *pBuffers[2];        /* Frame buffers of the DCMIPP double buffer mode */
+  uint32_t chroma_offset;      /* Offset of the chroma plane in a buffer, 0 for interleaved formats */
+  uint32_t depth;              /* Macroblock rows per line buffer interrupt, mb_per_row * depth multiple of 4 */
+  uint32_t slice_rows;         /* Macroblock rows per slice, 0 for a slice per frame */
+  H264EncSliceReadyCallBackFunc slice_cb;
+  void *pUserData;
+  /* Waits for new rows in the encoder task, NULL to wait for an interrupt. E.g. an RTOS semaphore taken here */
+  void (*wait)(void *pUserData);
+  /* Called from the line and frame events when new rows are in memory. E.g. the semaphore given here */
+  void (*signal)(void *pUserData);
+} app_enc_lines_conf_t;
+
+typedef struct
+{
+  app_enc_lines_conf_t conf;
+  uint32_t mb_per_row;
+  uint32_t mb_per_col;
+  volatile uint32_t capture_buf;          /* Buffer being written by the DCMIPP */
+  volatile uint32_t frame_id;             /* Frame being written by the DCMIPP */
+  volatile uint32_t mb_rows[2];           /* Complete macroblock rows of each buffer */
+  volatile uint32_t buf_frame_id[2];      /* Frame held (or being written) by each buffer */
+  uint32_t encode_buf;                    /* Buffer being encoded */
+  uint32_t encode_frame_id;               /* Frame being encoded */
+  int overrun;                            /* Frame being encoded overwritten by the camera */
+  uint32_t last_frame_id;                 /* Last frame encoded */
+  int encoded;                            /* At least one frame encoded */
+  uint32_t nb_frames;                     /* Frames encoded */
+  uint32_t nb_skipped;                    /* Frames captured and not encoded */
+  uint32_t nb_overruns;                   /* Frames overwritten by the camera during their encoding */
+  uint32_t nb_waits;                      /* Line buffer callbacks waiting for the camera */
+} app_enc_lines_t;
+
+/* Returns 0 on success */
+int app_enc_lines_init(app_enc_lines_t *pEnc, const app_enc_lines_conf_t *pConf);
+
+/* Enables the input line buffer mode (software handshake, no loopback) and the slices */
+void app_enc_lines_coding_ctrl(const app_enc_lines_t *pEnc, H264EncCodingCtrl *pCodingCtrl);
+
+/* Enables the line event of the pipe and starts the double buffered continuous capture. Returns 0 on success */
+int app_enc_lines_start(app_enc_lines_t *pEnc);
+
+/* Encodes the next frame as soon as its capture starts. Input addresses and lineBufWrCnt of pEncIn are set here.
+ * Returns the encoder status */
+H264EncRet app_enc_lines_encode(app_enc_lines_t *pEnc, H264EncIn *pEncIn, H264EncOut *pEncOut);
+
+/* Line event of the DCMIPP (interrupt context), to be called from CMW_CAMERA_PIPE_LineEventCallback() */
+void app_enc_lines_line_event(app_enc_lines_t *pEnc, uint32_t dcmipp_pipe);
+
+/* Frame event of the DCMIPP (interrupt context), to be called from CMW_CAMERA_PIPE_FrameEventCallback() */
+void app_enc_lines_frame_event(app_enc_lines_t *pEnc, uint32_t dcmipp_pipe);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ENC_LINES_H */
@@ -0,0 +1,101 @@
+/**
+ ******************************************************************************
+ * @file    app_enc_roi.h
+ * @author  GPM Application Team
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2023 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+#ifndef APP_ENC_ROI_H
+#define APP_ENC_ROI_H
+
+#include <stdint.h>
+#include "h264encapi.h"
+#include "objdetect_pp_output_if.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Detection driven ROI map of the H.264 encoder: the boxes of the post-processing are rasterised each frame into
+ * the per macroblock ROI index map of the encoder (H264EncSetRoiMap()). Each index 1 to 3 has its own QP delta
+ * (H264EncCodingCtrl.qpOffset), index 0 is coded at the rate control QP. Boxes of wanted classes get a negative
+ * delta, the background may get a positive one: the bits go to the objects.
+ *
+ * A macroblock partially covered by a (padded) box belongs to the box. When boxes overlap, the index with the
+ * lowest QP delta wins. A macroblock stays in its ROI for hold_frames frames after its last detection, so that a
+ * missed detection does not make the quality of an object flicker.
+ *
+ * Usage:
+ *   app_enc_roi_init(&roi, &conf, map, age);
+ *   app_enc_roi_coding_ctrl(&roi, &codingCtrl);     before H264EncSetCodingCtrl()
+ *   for each frame:
+ *     app_enc_roi_update(&roi, &pp_output);          boxes of the frame (normalized to the network input)
+ *     app_enc_roi_apply(&roi, encoder);              before H264EncStrmEncode()
+ */
+
+#define APP_ENC_ROI_MB_SIZE 16
+#define APP_ENC_ROI_NB_INDEX 4
+/* Size of the map and age buffers for a width x height picture */
+#define APP_ENC_ROI_NB_MB(width, height) \
+  ((((width) + APP_ENC_ROI_MB_SIZE - 1) / APP_ENC_ROI_MB_SIZE) * \
+   (((height) + APP_ENC_ROI_MB_SIZE - 1) / APP_ENC_ROI_MB_SIZE))
+
+typedef struct
+{
+  uint32_t width;            /* Encoded picture, in pixels */
+  uint32_t height;
+  /* Area of the picture seen by the network, normalized to the picture. E.g. a centered square crop of a 4:3
+   * picture (CAM_Aspect_ratio_crop): fov_x = 0.125, fov_y = 0, fov_w = 0.75, fov_h = 1 */
+  float fov_x;
+  float fov_y;
+  float fov_w;
+  float fov_h;
+  float padding;             /* Enlargement of each side of a box, as a fraction of its size */
+  float conf_threshold;      /* Boxes of lower confidence are ignored */
+  uint8_t hold_frames;       /* 0 to 254 */
+  uint8_t background_index;  /* ROI index of the macroblocks outside of any box */
+  const uint8_t *class_index; /* ROI index of each class, background_index to ignore a class */
+  uint32_t nb_classes;
+  /* QP delta of ROI index 1, 2, 3: [-8, 7] for index 1, [-30, 30] for the others */
+  int8_t qp_delta[APP_ENC_ROI_NB_INDEX - 1];
+} app_enc_roi_conf_t;
+
+typedef struct
+{
+  app_enc_roi_conf_t conf;
+  uint32_t mb_per_row;
+  uint32_t mb_per_col;
+  uint8_t *pMap;             /* ROI index of each macroblock, raster scan order */
+  uint8_t *pAge;             /* Frames left before a macroblock goes back to the background */
+  int changed;               /* Map updated since the last app_enc_roi_apply() */
+  uint32_t nb_boxes;         /* Boxes rasterised in the last frame */
+  uint32_t nb_roi_mb[APP_ENC_ROI_NB_INDEX]; /* Macroblocks of each index in the last map */
+} app_enc_roi_t;
+
+/* pMap and pAge hold APP_ENC_ROI_NB_MB(width, height) bytes each. Returns 0 on success */
+int app_enc_roi_init(app_enc_roi_t *pRoi, const app_enc_roi_conf_t *pConf, uint8_t *pMap, uint8_t *pAge);
+
+/* Enables the ROI map and sets its QP deltas in the coding control of the encoder */
+void app_enc_roi_coding_ctrl(const app_enc_roi_t *pRoi, H264EncCodingCtrl *pCodingCtrl);
+
+/* Rasterises the boxes of a frame into the map */
+void app_enc_roi_update(app_enc_roi_t *pRoi, const postprocess_out_t *pOutput);
+
+/* Gives the map to the encoder for the next frame, only when it changed. Returns the encoder status */
+H264EncRet app_enc_roi_apply(app_enc_roi_t *pRoi, H264EncInst encoder);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_ENC_ROI_H */
@@ -0,0 +1,122 @@
+/**
+ ******************************************************************************
+ * @file    app_pipeline.h
+ * @author  GPM Application Team
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2023 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+#ifndef APP_PIPELINE_H
+#define APP_PIPELINE_H
+
+#include <stdint.h>
+#include "ll_aton_rt_user_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Two buffer sets: the NPU runs frame N+1 while the CPU post-processes frame N */
+#define APP_PIPELINE_NB_SLOTS 2
+#define APP_PIPELINE_MAX_IO 4
+
+typedef enum
+{
+  APP_PIPELINE_SLOT_FREE = 0,       /* May be given to the producer */
+  APP_PIPELINE_SLOT_FILLING,        /* Input is being written by the producer */
+  APP_PIPELINE_SLOT_QUEUED,         /* Waiting for the NPU */
+  APP_PIPELINE_SLOT_RUNNING,        /* Inference in progress */
+  APP_PIPELINE_SLOT_DONE,           /* Output ready, waiting for the consumer */
+  APP_PIPELINE_SLOT_POSTPROCESSING, /* Output is being read by the consumer */
+} app_pipeline_slot_state_t;
+
+typedef struct
+{
+  void *pInputs[APP_PIPELINE_MAX_IO];
+  void *pOutputs[APP_PIPELINE_MAX_IO];
+  app_pipeline_slot_state_t state;
+  int input_dma;             /* Inputs written by a DMA (e.g. camera), no MCU cache maintenance needed */
+  uint32_t frame_id;
+  uint64_t ts_queued_ns;
+  uint64_t ts_start_ns;
+  uint64_t ts_done_ns;
+  uint64_t ts_pp_start_ns;
+} app_pipeline_slot_t;
+
+typedef struct
+{
+  uint32_t nb_frames;
+  int started;             /* first_start_ns is set: a frame of the window has started */
+  uint64_t first_start_ns;
+  uint64_t last_release_ns;
+  uint64_t queue_ns;       /* Sum of input ready -> NPU start */
+  uint64_t inference_ns;   /* Sum of NPU start -> NPU done */
+  uint64_t ready_ns;       /* Sum of NPU done -> post-processing start */
+  uint64_t postprocess_ns; /* Sum of post-processing start -> release */
+} app_pipeline_stats_t;
+
+typedef struct
+{
+  NN_Instance_TypeDef *nn_instance;
+  uint32_t nb_inputs;
+  uint32_t input_sizes[APP_PIPELINE_MAX_IO];
+  uint32_t nb_outputs;
+  uint32_t output_sizes[APP_PIPELINE_MAX_IO];
+  app_pipeline_slot_t slots[APP_PIPELINE_NB_SLOTS];
+  int32_t filling_slot;    /* -1 when no slot is given to the producer */
+  int32_t running_slot;    /* -1 when the NPU is idle */
+  int32_t pp_slot;         /* -1 when no slot is given to the consumer */
+  uint32_t next_frame_id;
+  uint32_t nb_inferences;
+  app_pipeline_stats_t stats;
+} app_pipeline_t;
+
+/* Initializes the runtime and the network once. pInputs/pOutputs hold, for each slot, the user allocated
+ * buffers of every network input/output (the network must be generated without I/O allocation).
+ * Returns 0 on success */
+int app_pipeline_init(app_pipeline_t *pPipe, NN_Instance_TypeDef *nn_instance,
+                      void *pInputs[APP_PIPELINE_NB_SLOTS][APP_PIPELINE_MAX_IO], uint32_t nb_inputs,
+                      void *pOutputs[APP_PIPELINE_NB_SLOTS][APP_PIPELINE_MAX_IO], uint32_t nb_outputs);
+
+void app_pipeline_deinit(app_pipeline_t *pPipe);
+
+/* Returns the input buffers of a free slot to be filled by the producer, NULL if none is free */
+void **app_pipeline_get_input(app_pipeline_t *pPipe);
+
+/* Queues the slot returned by app_pipeline_get_input() for inference */
+void app_pipeline_push_input(app_pipeline_t *pPipe);
+
+/* Returns 1 if the given slot is free */
+int app_pipeline_slot_is_free(const app_pipeline_t *pPipe, int32_t slot);
+
+/* Queues a free slot whose inputs have been written in place by a DMA (zero-copy producer owning the slot buffers,
+ * not to be mixed with app_pipeline_get_input()). Returns 0 on success, -1 if the slot is not free */
+int app_pipeline_push_slot(app_pipeline_t *pPipe, int32_t slot);
+
+/* Non-blocking: advances the running inference by one step, or starts the oldest queued one.
+ * Returns LL_ATON_RT_WFE when the caller may wait for an event (NPU busy, nothing else to do for the pipeline) */
+LL_ATON_RT_RetValues_t app_pipeline_run(app_pipeline_t *pPipe);
+
+/* Returns the output buffers of the oldest finished inference, NULL if none is available */
+void **app_pipeline_get_output(app_pipeline_t *pPipe, uint32_t *pFrame_id);
+
+/* Gives back the slot returned by app_pipeline_get_output() once post-processing is over */
+void app_pipeline_release_output(app_pipeline_t *pPipe);
+
+/* Prints frames/s and the average latency of each stage, then resets the statistics */
+void app_pipeline_report(app_pipeline_t *pPipe);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_PIPELINE_H */
@@ -0,0 +1,81 @@
+/**
+ ******************************************************************************
+ * @file    app_profiler.h
+ * @author  GPM Application Team
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2023 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+#ifndef APP_PROFILER_H
+#define APP_PROFILER_H
+
+#include <stdint.h>
+#include "ll_aton_rt_user_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define APP_PROFILER_MAX_ENTRIES 128 /* Epoch blocks tracked, later ones are counted as dropped */
+#define APP_PROFILER_MAX_NETWORKS 4
+/* Duration histogram: bin 0 is below 1us, then two bins per octave up to ~1s (last bin saturates) */
+#define APP_PROFILER_NB_BINS 40
+
+typedef enum
+{
+  APP_PROFILER_KIND_HW = 0,   /* Pure HW epoch block or epoch blob */
+  APP_PROFILER_KIND_SW,       /* Pure SW epoch block: operator falling back to the CPU */
+  APP_PROFILER_KIND_HYBRID,   /* CPU part of a hybrid epoch block (ATON lib operator set-up) */
+  APP_PROFILER_KIND_INTERNAL, /* HW epoch blocks inserted by the ATON lib for a hybrid epoch block */
+  APP_PROFILER_NB_KINDS,
+} app_profiler_kind_t;
+
+typedef struct
+{
+  const NN_Instance_TypeDef *nn_instance;
+  uint8_t net;                           /* Slot of nn_instance in the profiler (0 for the first one attached) */
+  const LL_ATON_RT_EpochBlockItem_t *eb; /* Parent hybrid epoch block for APP_PROFILER_KIND_INTERNAL */
+  uint16_t index;                        /* Position of eb in the network epoch block list */
+  int16_t epoch_num;                     /* -1 without LL_ATON_EB_DBG_INFO */
+  uint8_t kind;
+  int8_t sw_node_type;                   /* ll_sw NodeType of SW epoch blocks, -1 otherwise */
+  uint32_t count;
+  uint32_t min_ns;
+  uint32_t max_ns;
+  uint64_t sum_ns;
+  uint64_t ts_start;                     /* Start of the running epoch block: DWT cycles on target, ns on host */
+  uint8_t started;
+  uint16_t hist[APP_PROFILER_NB_BINS];
+} app_profiler_entry_t;
+
+/* Installs the profiler as epoch callback of nn_instance (chaining any callback already installed).
+ * Must be called while the network is not running. Returns 0 on success */
+int app_profiler_attach(NN_Instance_TypeDef *nn_instance);
+
+void app_profiler_detach(NN_Instance_TypeDef *nn_instance);
+
+/* Clears all measurements */
+void app_profiler_reset(void);
+
+/* Prints one CSV line per epoch block (count, min/avg/p99/max in us) then the time spent per kind */
+void app_profiler_export_csv(void);
+
+/* Sends the table on the UART: "EBPF" magic, uint16 version, uint16 entry count, uint16 bin count, uint16 entry
+ * size, then per entry (little endian) network u8, index u16, epoch i16, kind u8, node type i8, count u32,
+ * min_ns u32, max_ns u32, sum_ns u64, histogram u16[APP_PROFILER_NB_BINS] */
+void app_profiler_export_bin(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_PROFILER_H */
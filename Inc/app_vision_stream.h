@@ -0,0 +1,109 @@
+/**
+ ******************************************************************************
+ * @file    app_vision_stream.h
+ * @author  GPM Application Team
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2023 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+#ifndef APP_VISION_STREAM_H
+#define APP_VISION_STREAM_H
+
+#include <stdint.h>
+#include "h264encapi.h"
+#include "nx_api.h"
+#include "nx_rtp_sender.h"
+#include "objdetect_pp_output_if.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Detections streamed with the video: the boxes of the post-processing are packed each frame in a compact record
+ * carried by the frame itself, so that the receiver gets them with the frame RTP timestamp without a second channel.
+ *   - H.264: user data unregistered SEI message (uuid of the configuration), inserted by the encoder in the access
+ *     unit of the frame (H264EncSetSeiUserData()).
+ *   - MJPEG (or H.264): RTP header extension of the first packet of the frame, RFC 8285 two-byte header element of
+ *     id ext_id. The SDP of the RTSP server announces it with "a=extmap:<ext_id> " APP_VISION_STREAM_EXTMAP_URI.
+ *
+ * Record, big endian:
+ *   version (1 byte, APP_VISION_STREAM_VERSION), number of detections (1 byte),
+ *   RTP timestamp of the frame the detections were computed on (4 bytes), then for each detection:
+ *   class (1 byte), score (1 byte, confidence * 255), x_center, y_center, width, height (2 bytes each, fraction of
+ *   the encoded picture * 65535).
+ * The detections of a frame are usually available after its encoding starts: the source timestamp tells the
+ * receiver which frame they belong to.
+ *
+ * Usage:
+ *   app_vision_stream_init(&vs, &conf);
+ *   for each frame:
+ *     app_vision_stream_update(&vs, &pp_output, ts);  boxes of the frame of RTP timestamp ts
+ *     app_vision_stream_h264_attach(&vs, encoder);    before H264EncStrmEncode(), and/or
+ *     app_vision_stream_rtp_attach(&vs, &session);    before nx_rtp_sender_session_xxx_send()
+ * The record is read by the encoder during H264EncStrmEncode() and by the RTP sender when the first packet of the
+ * frame is sent: it shall not be updated in between.
+ */
+
+#define APP_VISION_STREAM_VERSION 1
+#define APP_VISION_STREAM_MAX_DETECTIONS 24
+#define APP_VISION_STREAM_HEADER_SIZE 6
+#define APP_VISION_STREAM_DETECTION_SIZE 10
+/* Fits in a RFC 8285 two-byte header element */
+#define APP_VISION_STREAM_RECORD_MAX_SIZE \
+  (APP_VISION_STREAM_HEADER_SIZE + APP_VISION_STREAM_MAX_DETECTIONS * APP_VISION_STREAM_DETECTION_SIZE)
+#define APP_VISION_STREAM_UUID_SIZE 16
+/* RFC 8285 two-byte header profile */
+#define APP_VISION_STREAM_RTP_PROFILE 0x1000
+#define APP_VISION_STREAM_EXTMAP_URI "urn:st:stm32n6:vision-stream:detections"
+
+typedef struct
+{
+  /* Area of the picture seen by the network, normalized to the picture (see app_enc_roi_conf_t) */
+  float fov_x;
+  float fov_y;
+  float fov_w;
+  float fov_h;
+  float conf_threshold;      /* Boxes of lower confidence are not sent */
+  uint8_t uuid[APP_VISION_STREAM_UUID_SIZE]; /* Identifies the SEI messages of the stream */
+  uint8_t ext_id;            /* RTP header extension element id, 1 to 255 */
+} app_vision_stream_conf_t;
+
+typedef struct
+{
+  app_vision_stream_conf_t conf;
+  /* uuid then record, given to the encoder */
+  uint8_t sei[APP_VISION_STREAM_UUID_SIZE + APP_VISION_STREAM_RECORD_MAX_SIZE];
+  /* Element header, record and padding to 32-bit words, given to the RTP sender */
+  uint8_t ext[(2 + APP_VISION_STREAM_RECORD_MAX_SIZE + 3) & ~3];
+  uint32_t record_size;
+  uint32_t ext_size;
+  uint32_t nb_detections;    /* Detections in the record */
+  uint32_t nb_dropped;       /* Detections above APP_VISION_STREAM_MAX_DETECTIONS, since init */
+} app_vision_stream_t;
+
+/* Returns 0 on success */
+int app_vision_stream_init(app_vision_stream_t *pVs, const app_vision_stream_conf_t *pConf);
+
+/* Packs the boxes (normalized to the network input) computed on the frame of RTP timestamp source_timestamp */
+void app_vision_stream_update(app_vision_stream_t *pVs, const postprocess_out_t *pOutput, uint32_t source_timestamp);
+
+/* Inserts the record in the next frame encoded as a SEI message. Returns the encoder status */
+H264EncRet app_vision_stream_h264_attach(app_vision_stream_t *pVs, H264EncInst encoder);
+
+/* Adds the record to the first packet of the next frame sent in the session. Returns the NetX status */
+UINT app_vision_stream_rtp_attach(app_vision_stream_t *pVs, NX_RTP_SESSION *pSession);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_VISION_STREAM_H */
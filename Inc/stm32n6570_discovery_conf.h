@@ -49,6 +49,11 @@ extern "C" {
 #define LCD_LAYER_0_ADDRESS                 0x34200000U
 #define LCD_LAYER_1_ADDRESS                 0x32100000U
 
+/* Audio codec defines */
+#if defined(EI_CONTINUOUS_AUDIO) && (EI_CONTINUOUS_AUDIO == 1)
+#define USE_AUDIO_CODEC_WM8904
+#endif
+
 /* Default Audio IN internal buffer size */
 #define DEFAULT_AUDIO_IN_BUFFER_SIZE        2048U
 
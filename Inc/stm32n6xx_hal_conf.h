@@ -87,6 +87,12 @@ extern "C" {
 // #define HAL_WWDG_MODULE_ENABLED
 #define HAL_XSPI_MODULE_ENABLED
 
+/* Microphones of the continuous audio classification (mks/ei.mk) */
+#if defined(EI_CONTINUOUS_AUDIO) && (EI_CONTINUOUS_AUDIO == 1)
+#define HAL_MDF_MODULE_ENABLED
+#define HAL_SAI_MODULE_ENABLED
+#endif
+
 /* ########################## Oscillator Values adaptation ####################*/
 /**
   * @brief Adjust the value of External High Speed oscillator (HSE) used in your application.
@@ -147,7 +153,9 @@ extern "C" {
   * @brief This is the HAL system configuration section
   */
 #define  VDD_VALUE                  3300UL /*!< Value of VDD in mv */
-#define  TICK_INT_PRIORITY          ((1UL<<__NVIC_PRIO_BITS) - 1UL)  /*!< tick interrupt priority (lowest by default) */
+/* The tick preempts the DCMIPP (0x07) and the ISP task (CMW_ISP_TASK_PRIORITY): HAL_GetTick() keeps running for
+ * the sensor I2C timeouts of the ISP and the frame timestamps */
+#define  TICK_INT_PRIORITY          0x06UL /*!< tick interrupt priority */
 #define  USE_RTOS                   0U
 
 /* ########################## Assert Selection ############################## */
@@ -9,6 +9,7 @@ extern "C" {
 #endif
 
 extern HAL_StatusTypeDef timer_config_init(void);
+/* Time since timer_config_init(), in microseconds (TIM2 counts at 1 MHz) */
 extern uint64_t timer_config_read_ns(void);
 
 #ifdef __cplusplus
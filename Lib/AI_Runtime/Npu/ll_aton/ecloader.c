@@ -97,6 +97,93 @@ bool ec_copy_file(const char *path, uint8_t *ptr)
 
 #endif /* #ifdef USE_FILES */
 
+/**
+ * Return the identifier of an entry of a relocation table (\e stride equal to 3) or of a patch table (\e stride equal
+ * to 4).
+ */
+
+static inline const char *ec_get_entry_id(const ECFileEntry *table_ptr, unsigned int stride, unsigned int idx)
+{
+  return (const char *)((const uint8_t *)table_ptr + table_ptr[stride * idx + 1]);
+}
+
+/**
+ * Build the index of a relocation table (\e stride equal to 3) or of a patch table (\e stride equal to 4), that is,
+ * the indexes of its entries sorted by identifier.
+ */
+
+static bool ec_build_index(const ECFileEntry *table_ptr, unsigned int stride, unsigned int *index,
+                           unsigned int index_size)
+{
+  if ((table_ptr == NULL) || (index == NULL))
+  {
+    LL_ATON_PRINTF("Error: Cannot build the index of an Epoch Controller table because a pointer is invalid\n");
+
+    return false;
+  }
+
+  ECFileEntry size = *table_ptr;
+
+  if (index_size < size)
+  {
+    LL_ATON_PRINTF("Error: Memory allocated for the index of an Epoch Controller table is not sufficient (at least "
+                   "space for %" PRIu32 " entries must be allocated)\n",
+                   size);
+
+    return false;
+  }
+
+  // insertion sort, the index is built once per blob and tables contain one entry per memory pool or patch
+
+  for (unsigned int n = 0; n < size; n++)
+  {
+    const char *id = ec_get_entry_id(table_ptr, stride, n);
+
+    unsigned int pos = n;
+
+    while ((pos > 0) && (strcmp(ec_get_entry_id(table_ptr, stride, index[pos - 1]), id) > 0))
+    {
+      index[pos] = index[pos - 1];
+
+      pos--;
+    }
+
+    index[pos] = n;
+  }
+
+  return true;
+}
+
+/**
+ * Look up an identifier in a relocation table (\e stride equal to 3) or in a patch table (\e stride equal to 4) by
+ * binary search in its index.
+ *
+ * \return the index of the entry having identifier \e id, or -1 if not found
+ */
+
+static int ec_find_index(const ECFileEntry *table_ptr, unsigned int stride, const unsigned int *index, const char *id)
+{
+  unsigned int low = 0;
+  unsigned int high = *table_ptr;
+
+  while (low < high)
+  {
+    unsigned int mid = low + (high - low) / 2;
+
+    int cmp = strcmp(id, ec_get_entry_id(table_ptr, stride, index[mid]));
+
+    if (cmp == 0)
+      return (int)index[mid];
+
+    if (cmp < 0)
+      high = mid;
+    else
+      low = mid + 1;
+  }
+
+  return -1;
+}
+
 /**
  * Get the pointer to the blob contained in an Epoch Controller binary.
  *
@@ -569,6 +656,110 @@ bool ec_reloc_by_id(const ECFileEntry *reloc_table_ptr, ECInstr *blob, const cha
   return false;
 }
 
+/**
+ * Build the index of a relocation table, used for looking up relocations by identifier in logarithmic time.
+ *
+ * \param[in]  reloc_table_ptr is the pointer to the relocation table (contained in an Epoch Controller binary or
+ * copied from it)
+ * \param[out] index           is the pointer to the memory area (which must be already allocated) that will contain
+ * the index
+ * \param[in]  index_size      is the number of entries of the memory area pointed by \e index (at least equal to
+ * ec_get_num_relocs(reloc_table_ptr))
+ *
+ * \retval \e true  on success
+ * \retval \e false otherwise
+ */
+
+bool ec_build_reloc_index(const ECFileEntry *reloc_table_ptr, unsigned int *index, unsigned int index_size)
+{
+  return ec_build_index(reloc_table_ptr, 3, index, index_size);
+}
+
+/**
+ * Relocate all the values associated with a relocation specified by using an identifier, looked up in the index built
+ * by ec_build_reloc_index().
+ *
+ * \param[in]     reloc_table_ptr is the pointer to the relocation table (contained in an Epoch Controller binary or
+ * copied from it)
+ * \param[in]     index           is the pointer to the index of the relocation table
+ * \param[out]    blob            is the pointer to the memory area containing the Epoch Controller
+ * blob (that will be patched)
+ * \param[in]     id              is the identifier of the relocation whose values must be relocated
+ * \param[in]     base            is the offset that must be added to the values to be relocated
+ * \param[in,out] prev_base       is the pointer to a memory location containing the previous value of the base address
+ * associated with this relocation (this memory location will be updated with \e base if this function completes
+ * successfully)
+ *
+ * \retval \e true  on success
+ * \retval \e false otherwise
+ */
+
+bool ec_reloc_by_id_indexed(const ECFileEntry *reloc_table_ptr, const unsigned int *index, ECInstr *blob,
+                            const char *id, ECAddr base, ECAddr *prev_base)
+{
+  if ((reloc_table_ptr == NULL) || (index == NULL))
+  {
+    LL_ATON_PRINTF("Error: Cannot relocate because the pointer to the Epoch Controller relocation table or to its "
+                   "index is invalid\n");
+
+    return false;
+  }
+
+  if (base == *prev_base)
+    return true;
+
+  int idx = ec_find_index(reloc_table_ptr, 3, index, id);
+
+  if (idx < 0)
+  {
+    LL_ATON_PRINTF("Error: Relocation symbol '%s' not found in Epoch Controller relocation table\n", id);
+
+    return false;
+  }
+
+  return ec_reloc(reloc_table_ptr, blob, (unsigned int)idx, base, prev_base);
+}
+
+/**
+ * Relocate all the values of all the relocations whose base address changed, in a single pass over the relocation
+ * table (e.g. for re-basing a model or switching its activation buffers).
+ *
+ * \param[in]     reloc_table_ptr is the pointer to the relocation table (contained in an Epoch Controller binary or
+ * copied from it)
+ * \param[out]    blob            is the pointer to the memory area containing the Epoch Controller
+ * blob (that will be patched)
+ * \param[in]     bases           is the pointer to the array (indexed by relocation index) of the new base addresses
+ * \param[in,out] prev_bases      is the pointer to the array (indexed by relocation index) of the previous base
+ * addresses (each element will be updated with the corresponding element of \e bases if its relocation completes
+ * successfully)
+ *
+ * \retval \e true  on success
+ * \retval \e false otherwise
+ */
+
+bool ec_reloc_all(const ECFileEntry *reloc_table_ptr, ECInstr *blob, const ECAddr *bases, ECAddr *prev_bases)
+{
+  if (reloc_table_ptr == NULL)
+  {
+    LL_ATON_PRINTF("Error: Cannot relocate because the pointer to the Epoch Controller relocation table is invalid\n");
+
+    return false;
+  }
+
+  ECFileEntry size = *reloc_table_ptr;
+
+  for (unsigned int idx = 0; idx < size; idx++)
+  {
+    if (bases[idx] == prev_bases[idx])
+      continue;
+
+    if (!ec_reloc(reloc_table_ptr, blob, idx, bases[idx], &prev_bases[idx]))
+      return false;
+  }
+
+  return true;
+}
+
 /**
  * Copy to memory the patch table contained in an Epoch Controller binary.
  *
@@ -925,3 +1116,61 @@ bool ec_patch_by_id(const ECFileEntry *patch_table_ptr, ECInstr *blob, const cha
 
   return false;
 }
+
+/**
+ * Build the index of a patch table, used for looking up patches by identifier in logarithmic time.
+ *
+ * \param[in]  patch_table_ptr is the pointer to the patch table (contained in an Epoch Controller binary or
+ * copied from it)
+ * \param[out] index           is the pointer to the memory area (which must be already allocated) that will contain
+ * the index
+ * \param[in]  index_size      is the number of entries of the memory area pointed by \e index (at least equal to
+ * ec_get_num_patches(patch_table_ptr))
+ *
+ * \retval \e true  on success
+ * \retval \e false otherwise
+ */
+
+bool ec_build_patch_index(const ECFileEntry *patch_table_ptr, unsigned int *index, unsigned int index_size)
+{
+  return ec_build_index(patch_table_ptr, 4, index, index_size);
+}
+
+/**
+ * Patch all the values associated with a patch specified by using an identifier, looked up in the index built by
+ * ec_build_patch_index().
+ *
+ * \param[in]     patch_table_ptr is the pointer to the patch table (contained in an Epoch Controller binary or
+ * copied from it)
+ * \param[in]     index           is the pointer to the index of the patch table
+ * \param[out]    blob            is the pointer to the memory area containing the Epoch Controller
+ * blob (that will be patched)
+ * \param[in]     id              is the identifier of the patch whose values must be patched
+ * \param[in]     value           is the value that must be used in the patch
+ *
+ * \retval \e true  on success
+ * \retval \e false otherwise
+ */
+
+bool ec_patch_by_id_indexed(const ECFileEntry *patch_table_ptr, const unsigned int *index, ECInstr *blob,
+                            const char *id, uint32_t value)
+{
+  if ((patch_table_ptr == NULL) || (index == NULL))
+  {
+    LL_ATON_PRINTF("Error: Cannot patch because the pointer to the Epoch Controller patch table or to its index is "
+                   "invalid\n");
+
+    return false;
+  }
+
+  int idx = ec_find_index(patch_table_ptr, 4, index, id);
+
+  if (idx < 0)
+  {
+    LL_ATON_PRINTF("Error: Patch '%s' not found in Epoch Controller patch table\n", id);
+
+    return false;
+  }
+
+  return ec_patch(patch_table_ptr, blob, (unsigned int)idx, value);
+}
@@ -67,6 +67,16 @@ extern "C"
   extern bool ec_reloc_by_id(const ECFileEntry *reloc_table_ptr, ECInstr *blob, const char *id, ECAddr base,
                              ECAddr *prev_base);
 
+  // build the index (entries sorted by identifier) of a relocation table contained in an Epoch Controller binary
+  extern bool ec_build_reloc_index(const ECFileEntry *reloc_table_ptr, unsigned int *index, unsigned int index_size);
+
+  // relocate all the values associated with a relocation specified by using an identifier, looked up in an index
+  extern bool ec_reloc_by_id_indexed(const ECFileEntry *reloc_table_ptr, const unsigned int *index, ECInstr *blob,
+                                     const char *id, ECAddr base, ECAddr *prev_base);
+
+  // relocate all the values of all the relocations whose base address changed (batched re-base)
+  extern bool ec_reloc_all(const ECFileEntry *reloc_table_ptr, ECInstr *blob, const ECAddr *bases, ECAddr *prev_bases);
+
   /* functions dealing with patches */
 
   // copy to memory the patch table contained in an Epoch Controller binary
@@ -90,6 +100,13 @@ extern "C"
   // patch all the values associated with a patch specified by using an identifier
   extern bool ec_patch_by_id(const ECFileEntry *patch_table_ptr, ECInstr *blob, const char *id, uint32_t value);
 
+  // build the index (entries sorted by identifier) of a patch table contained in an Epoch Controller binary
+  extern bool ec_build_patch_index(const ECFileEntry *patch_table_ptr, unsigned int *index, unsigned int index_size);
+
+  // patch all the values associated with a patch specified by using an identifier, looked up in an index
+  extern bool ec_patch_by_id_indexed(const ECFileEntry *patch_table_ptr, const unsigned int *index, ECInstr *blob,
+                                     const char *id, uint32_t value);
+
 #ifdef __cplusplus
 }
 #endif
@@ -48,16 +48,20 @@ extern "C"
 
   typedef enum LL_ATON_RT_Callbacktype
   {
-    LL_ATON_RT_Callbacktype_PRE_START,  /**< Callback called before start_epoch_block */
-    LL_ATON_RT_Callbacktype_POST_START, /**< Callback called after start_epoch_block */
-    LL_ATON_RT_Callbacktype_PRE_END,    /**< Callback called before end_epoch_block */
-    LL_ATON_RT_Callbacktype_POST_END,   /**< Callback called after end_epoch_block */
-    LL_ATON_RT_Callbacktype_NN_Init,    /**< Callback called after `LL_ATON_RT_Init_Network`,
-                                         *     NOTE: 3rd parameter passed is `NULL` */
-    LL_ATON_RT_Callbacktype_NN_DeInit,  /**< Callback called after `LL_ATON_RT_DeInit_Network`,
-                                         *     NOTE: 3rd parameter passed is `NULL` */
-    LL_ATON_RT_Callbacktype_RT_Init,    /**< Callback called after `LL_ATON_RT_RuntimeInit` */
-    LL_ATON_RT_Callbacktype_RT_Deinit,  /**< Callback called before `LL_ATON_RT_RuntimeDeInit` */
+    LL_ATON_RT_Callbacktype_PRE_START,    /**< Callback called before start_epoch_block */
+    LL_ATON_RT_Callbacktype_POST_START,   /**< Callback called after start_epoch_block */
+    LL_ATON_RT_Callbacktype_PRE_END,      /**< Callback called before end_epoch_block */
+    LL_ATON_RT_Callbacktype_POST_END,     /**< Callback called after end_epoch_block */
+    LL_ATON_RT_Callbacktype_NN_Init,      /**< Callback called after `LL_ATON_RT_Init_Network`,
+                                           *     NOTE: 3rd parameter passed is `NULL` */
+    LL_ATON_RT_Callbacktype_NN_DeInit,    /**< Callback called after `LL_ATON_RT_DeInit_Network`,
+                                           *     NOTE: 3rd parameter passed is `NULL` */
+    LL_ATON_RT_Callbacktype_RT_Init,      /**< Callback called after `LL_ATON_RT_RuntimeInit` */
+    LL_ATON_RT_Callbacktype_RT_Deinit,    /**< Callback called before `LL_ATON_RT_RuntimeDeInit` */
+    LL_ATON_RT_Callbacktype_OUTPUT_READY, /**< Callback called once per output buffer, as soon as the epoch producing
+                                           *     it has ended (use `LL_ATON_RT_Get_Ready_Output()` to know which one),
+                                           *     NOTE: 3rd parameter is the epoch block which has just ended
+                                           *     (the terminating one at the end of the inference) */
   } LL_ATON_RT_Callbacktype_t;
 
   /**
@@ -251,7 +255,8 @@ extern "C"
                                    *   (needed for configuring streaming engines) */
     uint8_t is_user_allocated;    /**< */
     uint8_t is_param;             /**< */
-    uint16_t epoch;               /**< */
+    uint16_t epoch;               /**< Last epoch writing the buffer (numbered as `EpochBlock_ItemTypeDef.epoch_num`),
+                                   *   the buffer is complete once this epoch has ended */
     uint32_t batch;               /**< */
     const uint32_t *mem_shape;    /**< shape as seen by the user in memory (only valid for input/output buffers) */
     uint16_t mem_ndims;           /**< Number of dimensions of mem_shape (Length of mem_shape) */
@@ -401,8 +406,14 @@ extern "C"
 
 #if defined(LL_ATON_RT_RELOC)
     uint32_t inst_reloc;
+    uint32_t inst_pager; // staged weights pager of a relocatable model (0 if none)
 #endif
 
+    uint32_t nr_of_epochs_done; // number of epochs ended in the current inference (only counted w/o epoch blobs)
+    bool epochs_count_lost;     // an epoch blob ended and epochs could not be counted anymore
+    uint32_t ready_outputs;     // bitmask of output buffers already signalled as ready in the current inference
+    uint32_t ready_output;      // index of the output buffer being signalled (`LL_ATON_RT_Callbacktype_OUTPUT_READY`)
+
   } NN_Execution_State_TypeDef;
 
   struct __nn_instance_struct
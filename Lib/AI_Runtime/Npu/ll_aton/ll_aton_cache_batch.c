@@ -0,0 +1,250 @@
+/**
+ ******************************************************************************
+ * @file    ll_aton_cache_batch.c
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   ATON cache maintenance batching.
+ * @note    Clean operations requested while a batch is open are coalesced (overlapping or adjacent cache lines) and
+ *          issued when the batch is closed, with a full MCU cache clean above a size threshold
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ll_aton_util.h" // Leave blank line after the include
+
+#include "ll_aton_cache_batch.h"
+#include "ll_aton_osal.h"
+#include "ll_aton_platform.h"
+
+#if (LL_ATON_CACHE_BATCH == 1)
+
+#if (LL_ATON_OSAL != LL_ATON_OSAL_BARE_METAL)
+#error cache maintenance batching keeps a single global batch, which is only supported with `LL_ATON_OSAL_BARE_METAL`
+#endif
+
+/* Cycle counter used for the statistics */
+#ifndef LL_ATON_CACHE_BATCH_GET_CYCLES
+#if defined(DWT)
+#define LL_ATON_CACHE_BATCH_GET_CYCLES() (DWT->CYCCNT)
+#else
+#define LL_ATON_CACHE_BATCH_GET_CYCLES() (0)
+#endif
+#endif
+
+/* Cache operations may be requested from interrupt handlers (e.g. DMA copy completion) */
+#ifdef __ARM_ARCH
+#include <cmsis_compiler.h>
+#define __LL_CACHE_BATCH_ENTER_CS(_state)                                                                              \
+  do                                                                                                                   \
+  {                                                                                                                    \
+    (_state) = __get_PRIMASK();                                                                                        \
+    __disable_irq();                                                                                                   \
+  } while (0)
+#define __LL_CACHE_BATCH_EXIT_CS(_state) __set_PRIMASK(_state)
+#define __LL_CACHE_BATCH_IN_IRQ()        (__get_IPSR() != 0)
+#else
+#define __LL_CACHE_BATCH_ENTER_CS(_state) ((void)(_state))
+#define __LL_CACHE_BATCH_EXIT_CS(_state)  ((void)(_state))
+#define __LL_CACHE_BATCH_IN_IRQ()         (false)
+#endif // __ARM_ARCH
+
+typedef struct
+{
+  uintptr_t start; /**< Aligned down on a cache line */
+  uintptr_t end;   /**< Aligned up on a cache line (excluded) */
+} __ll_cache_range_t;
+
+typedef struct
+{
+  __ll_cache_range_t ranges[LL_ATON_CACHE_BATCH_MAX_RANGES]; /**< Sorted, neither overlapping nor adjacent */
+  uint32_t nr_of_ranges;
+} __ll_cache_list_t;
+
+static struct
+{
+  uint32_t depth;
+  __ll_cache_list_t lists[LL_ATON_CACHE_BATCH_NR_OF_KINDS];
+  LL_ATON_Cache_Batch_Stats_t stats;
+} __ll_cache_batch;
+
+static const uint32_t __ll_cache_line_size[LL_ATON_CACHE_BATCH_NR_OF_KINDS] = {LL_ATON_CACHE_BATCH_MCU_LINE_SIZE,
+                                                                               LL_ATON_CACHE_BATCH_NPU_LINE_SIZE};
+
+/* Inserts a range, merging it with the ranges it overlaps or touches. Returns false if the list is full. */
+static bool __LL_ATON_Cache_Batch_Insert(__ll_cache_list_t *list, uintptr_t start, uintptr_t end)
+{
+  uint32_t first = 0;
+
+  /* first range which ends at or after `start` */
+  while ((first < list->nr_of_ranges) && (list->ranges[first].end < start))
+    first++;
+
+  /* ranges starting at or before `end` are merged */
+  uint32_t last = first;
+  while ((last < list->nr_of_ranges) && (list->ranges[last].start <= end))
+  {
+    if (list->ranges[last].start < start)
+      start = list->ranges[last].start;
+    if (list->ranges[last].end > end)
+      end = list->ranges[last].end;
+    last++;
+  }
+
+  if (last == first)
+  { // no merge, a new range is inserted at `first`
+    if (list->nr_of_ranges == LL_ATON_CACHE_BATCH_MAX_RANGES)
+      return false;
+    memmove(&list->ranges[first + 1], &list->ranges[first],
+            (list->nr_of_ranges - first) * sizeof(__ll_cache_range_t));
+    list->nr_of_ranges++;
+  }
+  else if (last > (first + 1))
+  { // ranges `first + 1` to `last - 1` are absorbed
+    memmove(&list->ranges[first + 1], &list->ranges[last], (list->nr_of_ranges - last) * sizeof(__ll_cache_range_t));
+    list->nr_of_ranges -= last - (first + 1);
+  }
+
+  list->ranges[first].start = start;
+  list->ranges[first].end = end;
+
+  return true;
+}
+
+/* Issues (and drops) all the pending operations of `kind` */
+static void __LL_ATON_Cache_Batch_Flush(LL_ATON_Cache_Batch_Kind_t kind)
+{
+  __ll_cache_list_t *list = &__ll_cache_batch.lists[kind];
+  uint32_t bytes = 0;
+
+  if (list->nr_of_ranges == 0)
+    return;
+
+  uint32_t t0 = LL_ATON_CACHE_BATCH_GET_CYCLES();
+
+  for (uint32_t i = 0; i < list->nr_of_ranges; i++)
+    bytes += list->ranges[i].end - list->ranges[i].start;
+
+  if (kind == LL_ATON_CACHE_BATCH_MCU_CLEAN)
+  {
+    LL_ATON_OSAL_LOCK_MCU_CACHE();
+    if (bytes >= LL_ATON_CACHE_BATCH_MCU_FULL_THRESHOLD)
+    {
+      mcu_cache_clean();
+      __ll_cache_batch.stats.full_ops++;
+      __ll_cache_batch.stats.issued_ops++;
+    }
+    else
+    {
+      for (uint32_t i = 0; i < list->nr_of_ranges; i++)
+        mcu_cache_clean_range(list->ranges[i].start, list->ranges[i].end);
+      __ll_cache_batch.stats.issued_ops += list->nr_of_ranges;
+      __ll_cache_batch.stats.issued_bytes += bytes;
+    }
+    LL_ATON_OSAL_UNLOCK_MCU_CACHE();
+  }
+  else
+  { // the NPU cache has no full clean operation
+    LL_ATON_OSAL_LOCK_NPU_CACHE();
+    for (uint32_t i = 0; i < list->nr_of_ranges; i++)
+      npu_cache_clean_range(list->ranges[i].start, list->ranges[i].end);
+    LL_ATON_OSAL_UNLOCK_NPU_CACHE();
+    __ll_cache_batch.stats.issued_ops += list->nr_of_ranges;
+    __ll_cache_batch.stats.issued_bytes += bytes;
+  }
+
+  list->nr_of_ranges = 0;
+  __ll_cache_batch.stats.cycles += LL_ATON_CACHE_BATCH_GET_CYCLES() - t0;
+}
+
+void LL_ATON_Cache_Batch_Begin(void)
+{
+  uint32_t cs;
+
+  __LL_CACHE_BATCH_ENTER_CS(cs);
+  __ll_cache_batch.depth++;
+  __LL_CACHE_BATCH_EXIT_CS(cs);
+}
+
+void LL_ATON_Cache_Batch_End(void)
+{
+  uint32_t cs;
+
+  __LL_CACHE_BATCH_ENTER_CS(cs);
+  LL_ATON_ASSERT(__ll_cache_batch.depth > 0);
+  if (--__ll_cache_batch.depth == 0)
+  {
+    for (int kind = 0; kind < LL_ATON_CACHE_BATCH_NR_OF_KINDS; kind++)
+      __LL_ATON_Cache_Batch_Flush((LL_ATON_Cache_Batch_Kind_t)kind);
+  }
+  __LL_CACHE_BATCH_EXIT_CS(cs);
+}
+
+void LL_ATON_Cache_Batch_GetStats(LL_ATON_Cache_Batch_Stats_t *stats, bool reset)
+{
+  uint32_t cs;
+
+  __LL_CACHE_BATCH_ENTER_CS(cs);
+  if (stats != NULL)
+    *stats = __ll_cache_batch.stats;
+  if (reset)
+    memset(&__ll_cache_batch.stats, 0, sizeof(__ll_cache_batch.stats));
+  __LL_CACHE_BATCH_EXIT_CS(cs);
+}
+
+bool __LL_ATON_Cache_Batch_Add(LL_ATON_Cache_Batch_Kind_t kind, uintptr_t addr, uint32_t size)
+{
+  uint32_t cs;
+  bool queued = false;
+
+  __LL_CACHE_BATCH_ENTER_CS(cs);
+  /* operations requested by interrupt handlers are not part of the batch (e.g. followed by a DMA transfer) */
+  if ((__ll_cache_batch.depth > 0) && !__LL_CACHE_BATCH_IN_IRQ())
+  {
+    const uintptr_t mask = __ll_cache_line_size[kind] - 1;
+    const uintptr_t start = addr & ~mask;
+    const uintptr_t end = (addr + size + mask) & ~mask;
+
+    if (!__LL_ATON_Cache_Batch_Insert(&__ll_cache_batch.lists[kind], start, end))
+    {
+      __LL_ATON_Cache_Batch_Flush(kind);
+      __LL_ATON_Cache_Batch_Insert(&__ll_cache_batch.lists[kind], start, end);
+    }
+    __ll_cache_batch.stats.requested_ops++;
+    __ll_cache_batch.stats.requested_bytes += size;
+    queued = true;
+  }
+  __LL_CACHE_BATCH_EXIT_CS(cs);
+
+  return queued;
+}
+
+void __LL_ATON_Cache_Batch_Sync(LL_ATON_Cache_Batch_Kind_t kind, uintptr_t addr, uint32_t size)
+{
+  uint32_t cs;
+  const __ll_cache_list_t *list = &__ll_cache_batch.lists[kind];
+
+  __LL_CACHE_BATCH_ENTER_CS(cs);
+  for (uint32_t i = 0; i < list->nr_of_ranges; i++)
+  {
+    if ((size == 0) || ((list->ranges[i].start < (addr + size)) && (addr < list->ranges[i].end)))
+    {
+      __LL_ATON_Cache_Batch_Flush(kind);
+      break;
+    }
+  }
+  __LL_CACHE_BATCH_EXIT_CS(cs);
+}
+
+#endif // (LL_ATON_CACHE_BATCH == 1)
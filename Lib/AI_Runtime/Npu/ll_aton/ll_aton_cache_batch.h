@@ -0,0 +1,98 @@
+/**
+ ******************************************************************************
+ * @file    ll_aton_cache_batch.h
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   Header file of ATON cache maintenance batching.
+ * @note    Clean operations requested while a batch is open are coalesced (overlapping or adjacent cache lines) and
+ *          issued when the batch is closed, with a full MCU cache clean above a size threshold
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef __LL_ATON_CACHE_BATCH_H
+#define __LL_ATON_CACHE_BATCH_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Max number of coalesced ranges per cache, the pending ones are issued when full */
+#ifndef LL_ATON_CACHE_BATCH_MAX_RANGES
+#define LL_ATON_CACHE_BATCH_MAX_RANGES 16
+#endif
+
+/* Pending MCU cleans of at least this many bytes are issued as a full MCU cache clean (default: D-cache size) */
+#ifndef LL_ATON_CACHE_BATCH_MCU_FULL_THRESHOLD
+#define LL_ATON_CACHE_BATCH_MCU_FULL_THRESHOLD (32 * 1024)
+#endif
+
+/* Cache line sizes, used to coalesce ranges sharing a line */
+#ifndef LL_ATON_CACHE_BATCH_MCU_LINE_SIZE
+#define LL_ATON_CACHE_BATCH_MCU_LINE_SIZE 32
+#endif
+#ifndef LL_ATON_CACHE_BATCH_NPU_LINE_SIZE
+#define LL_ATON_CACHE_BATCH_NPU_LINE_SIZE 64
+#endif
+
+  typedef enum
+  {
+    LL_ATON_CACHE_BATCH_MCU_CLEAN = 0, /**< `LL_ATON_Cache_MCU_Clean_Range()` (virtual addresses) */
+    LL_ATON_CACHE_BATCH_NPU_CLEAN,     /**< `LL_ATON_Cache_NPU_Clean_Range()` (physical addresses) */
+    LL_ATON_CACHE_BATCH_NR_OF_KINDS,
+  } LL_ATON_Cache_Batch_Kind_t;
+
+  /**
+   * @brief Cache maintenance statistics, accumulated until reset (e.g. per inference)
+   */
+  typedef struct
+  {
+    uint32_t requested_ops;   /**< Clean range operations requested while a batch was open */
+    uint32_t requested_bytes; /**< Bytes of the above */
+    uint32_t issued_ops;      /**< Operations actually issued (ranges after coalescing and full cleans) */
+    uint32_t issued_bytes;    /**< Bytes of the issued range operations */
+    uint32_t full_ops;        /**< Full MCU cache cleans issued instead of ranges */
+    uint32_t cycles;          /**< Cycles spent issuing the operations (see `LL_ATON_CACHE_BATCH_GET_CYCLES()`) */
+  } LL_ATON_Cache_Batch_Stats_t;
+
+  /**
+   * @brief Opens a batch, batches may be nested and are issued when the outermost one is closed
+   */
+  void LL_ATON_Cache_Batch_Begin(void);
+
+  /**
+   * @brief Closes a batch, issuing the pending operations when the outermost one is closed
+   */
+  void LL_ATON_Cache_Batch_End(void);
+
+  /**
+   * @brief Copies the statistics into `stats` (if not NULL) and optionally resets them
+   */
+  void LL_ATON_Cache_Batch_GetStats(LL_ATON_Cache_Batch_Stats_t *stats, bool reset);
+
+  /*** Cache interface integration (not to be called by the user) ***/
+
+  /* Returns true if the clean operation has been queued, false if it must be issued immediately (no open batch) */
+  bool __LL_ATON_Cache_Batch_Add(LL_ATON_Cache_Batch_Kind_t kind, uintptr_t addr, uint32_t size);
+
+  /* Issues the pending operations of `kind` overlapping the range, before an operation which must not be reordered
+   * with them (e.g. an invalidate). A `size` of 0 issues all of them. */
+  void __LL_ATON_Cache_Batch_Sync(LL_ATON_Cache_Batch_Kind_t kind, uintptr_t addr, uint32_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __LL_ATON_CACHE_BATCH_H
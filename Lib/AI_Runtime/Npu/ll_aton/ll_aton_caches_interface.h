@@ -30,6 +30,10 @@ extern "C"
 #include "ll_aton_osal.h"
 #include "ll_aton_platform.h"
 
+#if (LL_ATON_CACHE_BATCH == 1) && !defined(BUILD_AI_NETWORK_RELOC)
+#include "ll_aton_cache_batch.h"
+#endif
+
 #if !defined(BUILD_AI_NETWORK_RELOC)
 
 #if (LL_ATON_PLATFORM == LL_ATON_PLAT_STM32N6)
@@ -50,6 +54,10 @@ extern "C"
    */
   static inline void LL_ATON_Cache_MCU_Clean_Range(uintptr_t virtual_addr, uint32_t size)
   {
+#if (LL_ATON_CACHE_BATCH == 1)
+    if (__LL_ATON_Cache_Batch_Add(LL_ATON_CACHE_BATCH_MCU_CLEAN, virtual_addr, size))
+      return;
+#endif
     LL_ATON_OSAL_LOCK_MCU_CACHE();
     mcu_cache_clean_range(virtual_addr, virtual_addr + size);
     LL_ATON_OSAL_UNLOCK_MCU_CACHE();
@@ -69,6 +77,9 @@ extern "C"
    */
   static inline void LL_ATON_Cache_MCU_Invalidate_Range(uintptr_t virtual_addr, uint32_t size)
   {
+#if (LL_ATON_CACHE_BATCH == 1)
+    __LL_ATON_Cache_Batch_Sync(LL_ATON_CACHE_BATCH_MCU_CLEAN, virtual_addr, size);
+#endif
     LL_ATON_OSAL_LOCK_MCU_CACHE();
     mcu_cache_invalidate_range(virtual_addr, virtual_addr + size);
     LL_ATON_OSAL_UNLOCK_MCU_CACHE();
@@ -90,6 +101,9 @@ extern "C"
    */
   static inline void LL_ATON_Cache_MCU_Clean_Invalidate_Range(uintptr_t virtual_addr, uint32_t size)
   {
+#if (LL_ATON_CACHE_BATCH == 1)
+    __LL_ATON_Cache_Batch_Sync(LL_ATON_CACHE_BATCH_MCU_CLEAN, virtual_addr, size);
+#endif
     LL_ATON_OSAL_LOCK_MCU_CACHE();
     mcu_cache_clean_invalidate_range(virtual_addr, virtual_addr + size);
     LL_ATON_OSAL_UNLOCK_MCU_CACHE();
@@ -112,6 +126,10 @@ extern "C"
    */
   static inline void LL_ATON_Cache_NPU_Clean_Range(uintptr_t virtual_addr, uint32_t size)
   {
+#if (LL_ATON_CACHE_BATCH == 1)
+    if (__LL_ATON_Cache_Batch_Add(LL_ATON_CACHE_BATCH_NPU_CLEAN, ATON_LIB_VIRTUAL_TO_PHYSICAL_ADDR(virtual_addr), size))
+      return;
+#endif
     LL_ATON_OSAL_LOCK_NPU_CACHE();
     npu_cache_clean_range(ATON_LIB_VIRTUAL_TO_PHYSICAL_ADDR(virtual_addr),
                           ATON_LIB_VIRTUAL_TO_PHYSICAL_ADDR(virtual_addr + size));
@@ -138,6 +156,9 @@ extern "C"
   {
     /* NOTE: The ATON NPU cache does not provide a pure invalidate-range function, but only a clean-invalidate range
        function! One has to take this into account when using `stai_ext_cache_npu_clean_invalidate_range`. */
+#if (LL_ATON_CACHE_BATCH == 1)
+    __LL_ATON_Cache_Batch_Sync(LL_ATON_CACHE_BATCH_NPU_CLEAN, ATON_LIB_VIRTUAL_TO_PHYSICAL_ADDR(virtual_addr), size);
+#endif
     LL_ATON_OSAL_LOCK_NPU_CACHE();
     npu_cache_clean_invalidate_range(ATON_LIB_VIRTUAL_TO_PHYSICAL_ADDR(virtual_addr),
                                      ATON_LIB_VIRTUAL_TO_PHYSICAL_ADDR(virtual_addr + size));
@@ -149,6 +170,9 @@ extern "C"
    */
   static inline void LL_ATON_Cache_NPU_Invalidate(void)
   {
+#if (LL_ATON_CACHE_BATCH == 1)
+    __LL_ATON_Cache_Batch_Sync(LL_ATON_CACHE_BATCH_NPU_CLEAN, 0, 0);
+#endif
     LL_ATON_OSAL_LOCK_NPU_CACHE();
     npu_cache_invalidate();
     LL_ATON_OSAL_UNLOCK_NPU_CACHE();
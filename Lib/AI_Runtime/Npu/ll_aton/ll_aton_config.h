@@ -41,6 +41,11 @@
  *                                                  (to be defined as `0` or `1`)
  *      optional  LL_ATON_ENABLE_CLOCK_GATING       used to enable/disable clock gating of the ATON units not involved
  *                                                  during epoch execution (to be defined as `0` or `1`)
+ *      optional  LL_ATON_DMA_COPY                  enable the asynchronous DMA copy service (see `ll_aton_dma_copy.h`)
+ *                                                  (to be defined as `0` or `1`)
+ *      optional  LL_ATON_CACHE_BATCH               coalesce the cache clean operations requested by SW epoch blocks
+ *                                                  and by the end of epoch blocks (see `ll_aton_cache_batch.h`)
+ *                                                  (to be defined as `0` or `1`)
  *
  *      NOTE: `mandatory` means that these macros must be predefined using `-D` options in the command-line of the
  *            C compiler a/o preprocessor!
@@ -123,6 +128,14 @@
 #define LL_ATON_ENABLE_CLOCK_GATING 1
 #endif
 
+#ifndef LL_ATON_DMA_COPY
+#define LL_ATON_DMA_COPY 0
+#endif
+
+#ifndef LL_ATON_CACHE_BATCH
+#define LL_ATON_CACHE_BATCH 0
+#endif
+
 /* Check if selected values are valid */
 #if (LL_ATON_PLATFORM != LL_ATON_PLAT_NCSIM)
 #if (LL_ATON_PLATFORM != LL_ATON_PLAT_STICE4)
@@ -0,0 +1,443 @@
+/**
+ ******************************************************************************
+ * @file    ll_aton_dma_copy.c
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   ATON asynchronous DMA copy service.
+ * @note    Queued memory copies executed by ATON streaming engines in between the epoch blocks of the running
+ *          networks, with completion notified from the ATON interrupt handler
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ll_aton_util.h" // Leave blank line after the include
+
+#include "ll_aton.h"
+#include "ll_aton_dma_copy.h"
+#include "ll_aton_runtime.h"
+
+#if (LL_ATON_DMA_COPY == 1)
+
+#if (LL_ATON_RT_MODE != LL_ATON_RT_ASYNC)
+#error the DMA copy service relies on the ATON interrupt, i.e. on `LL_ATON_RT_ASYNC` mode
+#endif
+
+#if defined(APP_HAS_PARALLEL_NETWORKS) && APP_HAS_PARALLEL_NETWORKS
+#error the DMA copy service releases the ATON IP from interrupt context, which is not possible with the ATON IP lock \
+    used for parallel networks
+#endif
+
+/* Copies shorter than this are done by the CPU */
+#ifndef LL_ATON_DMA_COPY_MIN_LEN
+#define LL_ATON_DMA_COPY_MIN_LEN 40
+#endif
+
+/* Streaming engines used: #0 reads, #1 writes (see `LL_ATON_Dma_memcpy()`) */
+#define __LL_DMA_COPY_WAIT_MASK (0x1 << 1)
+
+extern NN_Instance_TypeDef *volatile __ll_current_aton_ip_owner;
+
+/* Epoch block seen by the runtime interrupt handler while a copy runs */
+static const LL_ATON_RT_EpochBlockItem_t __ll_dma_copy_eb = {
+    .wait_mask = __LL_DMA_COPY_WAIT_MASK,
+    .flags = EpochBlock_Flags_pure_hw,
+};
+
+NN_Instance_TypeDef __ll_dma_copy_instance = {
+    .network = NULL, .exec_state = {.current_epoch_block = &__ll_dma_copy_eb, .first_epoch_block = &__ll_dma_copy_eb}};
+
+static const LL_Switch_InitTypeDef __ll_dma_copy_switch = {
+    LL_Switch_Init_Dest() = ATONN_DSTPORT(STRSWITCH, 0, STRENG, 1, 0),
+    LL_Switch_Init_Source(0) = ATONN_SRCPORT(STRSWITCH, 0, STRENG, 0, 0), LL_Switch_Init_Context(0) = 1,
+    LL_Switch_Init_Frames(0) = 0};
+static const LL_ATON_EnableUnits_InitTypeDef __ll_dma_copy_units[] = {{{STRENG, 1}}, {{STRENG, 0}}};
+
+static struct
+{
+  LL_ATON_DmaCopy_Desc_t *head;
+  LL_ATON_DmaCopy_Desc_t *tail;
+  LL_ATON_DmaCopy_Desc_t *current;
+  volatile bool yield; /**< A network waits for the ATON IP */
+} __ll_dma_copy;
+
+/* Bytes spanned by the lines of a copy */
+static inline uint32_t __LL_ATON_DmaCopy_Extent(uint32_t pitch, uint32_t line_len, uint32_t nlines)
+{
+  return (nlines - 1) * pitch + line_len;
+}
+
+static inline bool __LL_ATON_DmaCopy_IsLinear(const LL_ATON_DmaCopy_Desc_t *desc)
+{
+  return (desc->nlines == 1) || ((desc->src_pitch == desc->line_len) && (desc->dst_pitch == desc->line_len));
+}
+
+/* Lines are moved as pixels of `nbytes` bytes */
+static void __LL_ATON_DmaCopy_SetRaster(LL_Streng_TensorInitTypeDef *dma, uint32_t pitch, uint32_t line_len,
+                                       uint32_t nlines, uint32_t nbytes)
+{
+  dma->raw = 0;
+  dma->fwidth = line_len / nbytes;
+  dma->fheight = nlines;
+  dma->batch_depth = 1;
+  dma->batch_offset = nbytes;
+  dma->line_offset = pitch;
+  dma->frame_offset = pitch * nlines;
+  dma->offset_end = __LL_ATON_DmaCopy_Extent(pitch, line_len, nlines);
+  dma->offset_limit = dma->offset_end;
+}
+
+static void __LL_ATON_DmaCopy_Complete(LL_ATON_DmaCopy_Desc_t *desc)
+{
+  if (desc->flags & LL_ATON_DMA_COPY_FLAG_DST_INVALIDATE)
+  {
+    LL_ATON_Cache_MCU_Invalidate_Range(ATON_LIB_PHYSICAL_TO_VIRTUAL_ADDR((uintptr_t)desc->dst),
+                                       __LL_ATON_DmaCopy_Extent(desc->dst_pitch, desc->line_len, desc->nlines));
+  }
+
+  desc->state = LL_ATON_DMA_COPY_DONE;
+
+  if (desc->done_callback != NULL)
+    desc->done_callback(desc, desc->user_data);
+}
+
+/**
+ * @brief  Programs the transfer of `desc`, doing the copy with the CPU if too short
+ * @retval true if a transfer has been started
+ */
+static bool __LL_ATON_DmaCopy_Start(LL_ATON_DmaCopy_Desc_t *desc)
+{
+  uint8_t *dst = (uint8_t *)desc->dst;
+  const uint8_t *src = (const uint8_t *)desc->src;
+  bool linear = __LL_ATON_DmaCopy_IsLinear(desc);
+  uint32_t n = linear ? (desc->line_len * desc->nlines) : 0;
+
+  if (linear)
+  {
+    /* Raw transfers move 24-bit words, leading bytes are copied by the CPU */
+    uint32_t prolog_len = (n < LL_ATON_DMA_COPY_MIN_LEN) ? n : (n % 3);
+
+    if (prolog_len > 0)
+    {
+      memcpy(dst, src, prolog_len);
+      LL_ATON_Cache_MCU_Clean_Invalidate_Range(ATON_LIB_PHYSICAL_TO_VIRTUAL_ADDR((uintptr_t)dst), prolog_len);
+      dst += prolog_len;
+      src += prolog_len;
+      n -= prolog_len;
+    }
+
+    if (n == 0)
+      return false;
+  }
+  else if ((desc->line_len * desc->nlines) < LL_ATON_DMA_COPY_MIN_LEN)
+  {
+    for (uint32_t i = 0; i < desc->nlines; i++)
+    {
+      memcpy(dst + i * desc->dst_pitch, src + i * desc->src_pitch, desc->line_len);
+    }
+    LL_ATON_Cache_MCU_Clean_Invalidate_Range(
+        ATON_LIB_PHYSICAL_TO_VIRTUAL_ADDR((uintptr_t)dst),
+        __LL_ATON_DmaCopy_Extent(desc->dst_pitch, desc->line_len, desc->nlines));
+    return false;
+  }
+
+  LL_Streng_TensorInitTypeDef dma_in = {
+      .dir = 0,
+      .addr_base = {(unsigned char *)src},
+      .offset_start = 0,
+      .offset_end = n,
+      .offset_limit = n,
+      .raw = 1,
+      .frame_offset = n,
+      .frame_tot_cnt = 1,
+      .nbits_in = 24,
+      .nbits_out = 24,
+  };
+
+  LL_Streng_TensorInitTypeDef dma_out = {
+      .dir = 1,
+      .addr_base = {dst},
+      .offset_start = 0,
+      .offset_end = n,
+      .raw = 1,
+      .frame_offset = n,
+      .frame_tot_cnt = 1,
+      .nbits_in = 24,
+      .nbits_out = 24,
+  };
+
+  if (!linear)
+  {
+    /* 16-bit pixels when everything is even, bytes otherwise */
+    uint32_t nbytes =
+        (((uintptr_t)dst | (uintptr_t)src | desc->line_len | desc->src_pitch | desc->dst_pitch) & 0x1) ? 1 : 2;
+
+    dma_in.nbits_in = dma_in.nbits_out = dma_out.nbits_in = dma_out.nbits_out = (unsigned char)(nbytes * 8);
+
+    if (desc->src_pitch != desc->line_len)
+    {
+      __LL_ATON_DmaCopy_SetRaster(&dma_in, desc->src_pitch, desc->line_len, desc->nlines, nbytes);
+    }
+    else
+    {
+      dma_in.offset_end = dma_in.offset_limit = dma_in.frame_offset = desc->line_len * desc->nlines;
+    }
+
+    if (desc->dst_pitch != desc->line_len)
+    {
+      __LL_ATON_DmaCopy_SetRaster(&dma_out, desc->dst_pitch, desc->line_len, desc->nlines, nbytes);
+    }
+    else
+    {
+      dma_out.offset_end = dma_out.frame_offset = desc->line_len * desc->nlines;
+    }
+  }
+
+  if (desc->flags & LL_ATON_DMA_COPY_FLAG_SRC_NPU_CACHED)
+  {
+    dma_in.cacheable = 1;
+    dma_in.cache_allocate = 1;
+  }
+
+  if (desc->flags & LL_ATON_DMA_COPY_FLAG_DST_NPU_CACHED)
+  {
+    dma_out.cacheable = 1;
+    dma_out.cache_allocate = 1;
+  }
+
+  LL_Streng_TensorInit(0, &dma_in, 1);
+  LL_Streng_TensorInit(1, &dma_out, 1);
+  LL_Switch_Init(&__ll_dma_copy_switch, 1);
+  __LL_ATON_RT_SetWaitMask(__LL_DMA_COPY_WAIT_MASK);
+  LL_ATON_EnableUnits_Init(__ll_dma_copy_units, 2);
+
+  return true;
+}
+
+/**
+ * @brief Runs the queue while owning the ATON IP, gives the IP back once the queue is empty or a network waits for it
+ * @note  Called from thread context right after having grabbed the IP, or from the ATON interrupt handler
+ */
+static void __LL_ATON_DmaCopy_RunQueue(void)
+{
+  uint32_t cs_state;
+
+  LL_ATON_ASSERT(__ll_current_aton_ip_owner == &__ll_dma_copy_instance);
+
+  while (true)
+  {
+    LL_ATON_DmaCopy_Desc_t *desc = NULL;
+
+    LL_ATON_DMA_COPY_ENTER_CS(cs_state);
+    if (!__ll_dma_copy.yield)
+    {
+      desc = __ll_dma_copy.head;
+      if (desc != NULL)
+      {
+        __ll_dma_copy.head = desc->next;
+        if (__ll_dma_copy.head == NULL)
+          __ll_dma_copy.tail = NULL;
+        desc->next = NULL;
+        desc->state = LL_ATON_DMA_COPY_RUNNING;
+      }
+    }
+    if (desc == NULL)
+    {
+      /* Release the ATON IP (`__ll_clear_aton_owner()` is not used as it would kick the service again) */
+      __LL_ATON_RT_SetWaitMask(0);
+      __ll_dma_copy.yield = false;
+      __ll_current_aton_ip_owner = NULL;
+    }
+    LL_ATON_DMA_COPY_EXIT_CS(cs_state);
+
+    if (desc == NULL)
+      return;
+
+    __ll_dma_copy.current = desc; // before the start, the end of transfer interrupt may fire right away
+    if (__LL_ATON_DmaCopy_Start(desc))
+      return;
+
+    __ll_dma_copy.current = NULL;
+    __LL_ATON_DmaCopy_Complete(desc);
+  }
+}
+
+void LL_ATON_DmaCopy_Init(void)
+{
+  LL_ATON_ASSERT(__ll_current_aton_ip_owner != &__ll_dma_copy_instance);
+
+  memset(&__ll_dma_copy, 0, sizeof(__ll_dma_copy));
+  __ll_dma_copy_instance.exec_state.triggered_events = 0;
+}
+
+void LL_ATON_DmaCopy_Desc_Init(LL_ATON_DmaCopy_Desc_t *desc, void *dst, const void *src, uint32_t n, uint32_t flags,
+                               LL_ATON_DmaCopy_Done_FuncPtr_t done_callback, void *user_data)
+{
+  LL_ATON_DmaCopy_Desc_Init2D(desc, dst, n, src, n, n, 1, flags, done_callback, user_data);
+}
+
+void LL_ATON_DmaCopy_Desc_Init2D(LL_ATON_DmaCopy_Desc_t *desc, void *dst, uint32_t dst_pitch, const void *src,
+                                 uint32_t src_pitch, uint32_t line_len, uint32_t nlines, uint32_t flags,
+                                 LL_ATON_DmaCopy_Done_FuncPtr_t done_callback, void *user_data)
+{
+  LL_ATON_ASSERT(desc != NULL);
+  LL_ATON_ASSERT((nlines == 1) || ((dst_pitch >= line_len) && (src_pitch >= line_len)));
+
+  memset(desc, 0, sizeof(*desc));
+  desc->dst = dst;
+  desc->src = src;
+  desc->line_len = line_len;
+  desc->nlines = nlines;
+  desc->dst_pitch = dst_pitch;
+  desc->src_pitch = src_pitch;
+  desc->flags = flags;
+  desc->done_callback = done_callback;
+  desc->user_data = user_data;
+  desc->state = LL_ATON_DMA_COPY_IDLE;
+}
+
+bool LL_ATON_DmaCopy_Submit(LL_ATON_DmaCopy_Desc_t *descs, uint32_t n)
+{
+  uint32_t cs_state;
+
+  LL_ATON_ASSERT((descs != NULL) || (n == 0));
+
+  for (uint32_t i = 0; i < n; i++)
+  {
+    LL_ATON_DmaCopy_Desc_t *desc = &descs[i];
+    if ((desc->state == LL_ATON_DMA_COPY_QUEUED) || (desc->state == LL_ATON_DMA_COPY_RUNNING))
+      return false;
+  }
+
+  /* Chain the descriptors, then append the whole chain at once */
+  for (uint32_t i = 0; i < n; i++)
+  {
+    LL_ATON_DmaCopy_Desc_t *desc = &descs[i];
+    uint32_t src_len = __LL_ATON_DmaCopy_Extent(desc->src_pitch, desc->line_len, desc->nlines);
+    uint32_t dst_len = __LL_ATON_DmaCopy_Extent(desc->dst_pitch, desc->line_len, desc->nlines);
+
+    if (desc->flags & LL_ATON_DMA_COPY_FLAG_SRC_CLEAN)
+      LL_ATON_Cache_MCU_Clean_Range(ATON_LIB_PHYSICAL_TO_VIRTUAL_ADDR((uintptr_t)desc->src), src_len);
+    if (desc->flags & LL_ATON_DMA_COPY_FLAG_DST_INVALIDATE)
+      LL_ATON_Cache_MCU_Clean_Invalidate_Range(ATON_LIB_PHYSICAL_TO_VIRTUAL_ADDR((uintptr_t)desc->dst), dst_len);
+
+    desc->state = LL_ATON_DMA_COPY_QUEUED;
+    desc->next = (i + 1 < n) ? &descs[i + 1] : NULL;
+  }
+
+  if (n > 0)
+  {
+    LL_ATON_DMA_COPY_ENTER_CS(cs_state);
+    if (__ll_dma_copy.tail != NULL)
+      __ll_dma_copy.tail->next = &descs[0];
+    else
+      __ll_dma_copy.head = &descs[0];
+    __ll_dma_copy.tail = &descs[n - 1];
+    LL_ATON_DMA_COPY_EXIT_CS(cs_state);
+  }
+
+  __LL_ATON_DmaCopy_Kick();
+
+  return true;
+}
+
+void LL_ATON_DmaCopy_Poll(void)
+{
+  __LL_ATON_DmaCopy_Kick();
+}
+
+void LL_ATON_DmaCopy_Wait(LL_ATON_DmaCopy_Desc_t *desc)
+{
+  LL_ATON_ASSERT(desc != NULL);
+  LL_ATON_ASSERT(desc->state != LL_ATON_DMA_COPY_IDLE);
+
+  while (desc->state != LL_ATON_DMA_COPY_DONE)
+  {
+    /* The ATON IP may have been left to a network in the meantime */
+    __LL_ATON_DmaCopy_Kick();
+    if (desc->state == LL_ATON_DMA_COPY_DONE)
+      break;
+    LL_ATON_OSAL_WFE();
+  }
+}
+
+void __LL_ATON_DmaCopy_Kick(void)
+{
+  bool acquired = false;
+  uint32_t cs_state;
+
+  LL_ATON_DMA_COPY_ENTER_CS(cs_state);
+  if ((__ll_current_aton_ip_owner == NULL) && (__ll_dma_copy.head != NULL))
+  {
+    __ll_current_aton_ip_owner = &__ll_dma_copy_instance;
+    acquired = true;
+  }
+  LL_ATON_DMA_COPY_EXIT_CS(cs_state);
+
+  if (acquired)
+  {
+    __LL_ATON_DmaCopy_RunQueue();
+  }
+}
+
+void __LL_ATON_DmaCopy_IrqHandler(void)
+{
+  uint32_t triggered = __ll_dma_copy_instance.exec_state.triggered_events;
+
+  if ((triggered & __LL_DMA_COPY_WAIT_MASK) != __LL_DMA_COPY_WAIT_MASK)
+    return;
+
+  __ll_dma_copy_instance.exec_state.triggered_events = triggered & ~__LL_DMA_COPY_WAIT_MASK;
+
+  LL_ATON_DisableUnits_Init(__ll_dma_copy_units, 2);
+  LL_Switch_Deinit(&__ll_dma_copy_switch, 1);
+
+  LL_ATON_DmaCopy_Desc_t *desc = __ll_dma_copy.current;
+  LL_ATON_ASSERT(desc != NULL);
+  __ll_dma_copy.current = NULL;
+  __LL_ATON_DmaCopy_Complete(desc);
+
+  __LL_ATON_DmaCopy_RunQueue();
+}
+
+bool __LL_ATON_DmaCopy_TryAcquire(NN_Instance_TypeDef *new_owner)
+{
+  bool acquired;
+  uint32_t cs_state;
+
+  LL_ATON_ASSERT(new_owner != &__ll_dma_copy_instance);
+
+  LL_ATON_DMA_COPY_ENTER_CS(cs_state);
+  acquired = (__ll_current_aton_ip_owner != &__ll_dma_copy_instance);
+  if (acquired)
+  {
+    /* Same checks as `__ll_set_aton_owner()`, a `__LL_ATON_DmaCopy_Kick()` can't take the IP from now on */
+    LL_ATON_ASSERT(__ll_current_aton_ip_owner == NULL);
+#ifndef NDEBUG
+    extern uint32_t volatile __ll_current_wait_mask;
+    LL_ATON_ASSERT(__ll_current_wait_mask == 0);
+#endif // NDEBUG
+    __ll_current_aton_ip_owner = new_owner;
+  }
+  else
+  {
+    __ll_dma_copy.yield = true;
+  }
+  LL_ATON_DMA_COPY_EXIT_CS(cs_state);
+
+  return acquired;
+}
+
+#endif // (LL_ATON_DMA_COPY == 1)
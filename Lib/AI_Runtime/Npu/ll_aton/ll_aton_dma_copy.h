@@ -0,0 +1,164 @@
+/**
+ ******************************************************************************
+ * @file    ll_aton_dma_copy.h
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   Header file of ATON asynchronous DMA copy service.
+ * @note    Queued memory copies executed by ATON streaming engines in between the epoch blocks of the running
+ *          networks, with completion notified from the ATON interrupt handler
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef __LL_ATON_DMA_COPY_H
+#define __LL_ATON_DMA_COPY_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ll_aton_rt_user_api.h"
+
+  /**
+   * @brief Critical section protecting the descriptor queue and the ATON IP hand-over
+   * @note  Copies may be submitted from other threads or from interrupt handlers, hence the default masks all
+   *        interrupts. May be overridden by the user (e.g. with `TX_DISABLE`/`TX_RESTORE`).
+   */
+#ifndef LL_ATON_DMA_COPY_ENTER_CS
+#ifdef __ARM_ARCH
+#include <cmsis_compiler.h>
+#define LL_ATON_DMA_COPY_ENTER_CS(_state)                                                                              \
+  do                                                                                                                   \
+  {                                                                                                                    \
+    (_state) = __get_PRIMASK();                                                                                        \
+    __disable_irq();                                                                                                   \
+  } while (0)
+#define LL_ATON_DMA_COPY_EXIT_CS(_state) __set_PRIMASK(_state)
+#else
+#define LL_ATON_DMA_COPY_ENTER_CS(_state) ((void)(_state))
+#define LL_ATON_DMA_COPY_EXIT_CS(_state)  ((void)(_state))
+#endif // __ARM_ARCH
+#endif // LL_ATON_DMA_COPY_ENTER_CS
+
+/* Descriptor flags
+ * `DST_INVALIDATE` cleans & invalidates the destination from the MCU cache at submission and invalidates it again at
+ * completion, the destination should then be aligned on MCU cache lines */
+#define LL_ATON_DMA_COPY_FLAG_SRC_NPU_CACHED (0x1 << 0) /**< Read source through the NPU cache */
+#define LL_ATON_DMA_COPY_FLAG_DST_NPU_CACHED (0x1 << 1) /**< Write destination through the NPU cache */
+#define LL_ATON_DMA_COPY_FLAG_SRC_CLEAN      (0x1 << 2) /**< Clean source from MCU cache at submission */
+#define LL_ATON_DMA_COPY_FLAG_DST_INVALIDATE (0x1 << 3) /**< Invalidate destination from MCU cache (see above) */
+
+  typedef enum
+  {
+    LL_ATON_DMA_COPY_IDLE = 0, /**< Never submitted */
+    LL_ATON_DMA_COPY_QUEUED,   /**< Waiting for the ATON IP */
+    LL_ATON_DMA_COPY_RUNNING,  /**< Transfer in progress */
+    LL_ATON_DMA_COPY_DONE,     /**< Transfer over, the descriptor may be submitted again */
+  } LL_ATON_DmaCopy_State_t;
+
+  struct LL_ATON_DmaCopy_Desc;
+
+  /**
+   * @brief Called once the copy is over, from within the ATON interrupt handler (or from within the submitting thread
+   *        for copies too short to be worth the DMA)
+   */
+  typedef void (*LL_ATON_DmaCopy_Done_FuncPtr_t)(struct LL_ATON_DmaCopy_Desc *desc, void *user_data);
+
+  /**
+   * @brief Copy descriptor, owned by the caller until the copy is over
+   * @note  Two-dimensional copies move `nlines` lines of `line_len` bytes, lines being `src_pitch` bytes apart in
+   *        source and `dst_pitch` bytes apart in destination
+   */
+  typedef struct LL_ATON_DmaCopy_Desc
+  {
+    void *dst;
+    const void *src;
+    uint32_t line_len;  /**< Bytes per line (total size for linear copies) */
+    uint32_t nlines;    /**< Number of lines, 1 for linear copies */
+    uint32_t dst_pitch; /**< Bytes between the starts of two destination lines */
+    uint32_t src_pitch; /**< Bytes between the starts of two source lines */
+    uint32_t flags;     /**< `LL_ATON_DMA_COPY_FLAG_*` */
+    LL_ATON_DmaCopy_Done_FuncPtr_t done_callback; /**< Optional */
+    void *user_data;
+
+    /* Private */
+    struct LL_ATON_DmaCopy_Desc *next;
+    volatile uint32_t state; /**< `LL_ATON_DmaCopy_State_t` */
+  } LL_ATON_DmaCopy_Desc_t;
+
+  /**
+   * @brief Resets the service (drops any queued copy), must be called after `LL_ATON_RT_RuntimeInit()` while no
+   *        copy is running
+   */
+  void LL_ATON_DmaCopy_Init(void);
+
+  /**
+   * @brief Fills in a descriptor for a linear copy of `n` bytes
+   */
+  void LL_ATON_DmaCopy_Desc_Init(LL_ATON_DmaCopy_Desc_t *desc, void *dst, const void *src, uint32_t n, uint32_t flags,
+                                 LL_ATON_DmaCopy_Done_FuncPtr_t done_callback, void *user_data);
+
+  /**
+   * @brief Fills in a descriptor for a two-dimensional (strided) copy
+   */
+  void LL_ATON_DmaCopy_Desc_Init2D(LL_ATON_DmaCopy_Desc_t *desc, void *dst, uint32_t dst_pitch, const void *src,
+                                   uint32_t src_pitch, uint32_t line_len, uint32_t nlines, uint32_t flags,
+                                   LL_ATON_DmaCopy_Done_FuncPtr_t done_callback, void *user_data);
+
+  /**
+   * @brief  Queues `n` descriptors (copied in array order) and starts the first one if the ATON IP is free
+   * @note   A network needing the ATON IP while a copy runs waits for the end of that copy only, the remaining ones
+   *         are resumed at the end of the network's next epoch block
+   * @retval false (nothing queued) if one of the descriptors is still queued or running
+   */
+  bool LL_ATON_DmaCopy_Submit(LL_ATON_DmaCopy_Desc_t *descs, uint32_t n);
+
+  static inline bool LL_ATON_DmaCopy_IsDone(const LL_ATON_DmaCopy_Desc_t *desc)
+  {
+    return desc->state == LL_ATON_DMA_COPY_DONE;
+  }
+
+  /**
+   * @brief Starts queued copies if the ATON IP is free. Only needed when copies are queued while no network runs
+   *        and nobody waits for them (e.g. when relying on completion callbacks only)
+   */
+  void LL_ATON_DmaCopy_Poll(void);
+
+  /**
+   * @brief Blocks until `desc` is over, sleeping in `LL_ATON_OSAL_WFE()` (i.e. on the ATON event semaphore with an
+   *        RTOS) in between two ATON interrupts
+   */
+  void LL_ATON_DmaCopy_Wait(LL_ATON_DmaCopy_Desc_t *desc);
+
+  /*** Runtime integration (not to be called by the user) ***/
+
+  /* Pseudo network instance owning the ATON IP while a copy runs */
+  extern NN_Instance_TypeDef __ll_dma_copy_instance;
+
+  /* Called by the runtime each time a network releases the ATON IP */
+  void __LL_ATON_DmaCopy_Kick(void);
+
+  /* Called from `ATON_STD_IRQHandler()` while the service owns the ATON IP */
+  void __LL_ATON_DmaCopy_IrqHandler(void);
+
+  /* Makes `new_owner` the owner of the free ATON IP and returns true. Returns false (and asks the service to give
+   * the ATON IP back) if a copy is running. Check and claim are done in one critical section */
+  bool __LL_ATON_DmaCopy_TryAcquire(NN_Instance_TypeDef *new_owner);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __LL_ATON_DMA_COPY_H
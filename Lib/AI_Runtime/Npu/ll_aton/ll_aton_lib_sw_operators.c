@@ -26,14 +26,6 @@
 #include "ll_aton_lib_sw_operators.h"
 #include "ll_aton_runtime.h"
 
-/* Common data structure(s) */
-typedef struct __ll_stack_lnklst
-{
-  struct __ll_stack_lnklst *back_link;
-  uint32_t axis;
-  uint32_t index;
-} __ll_stack_lnklst_t;
-
 /* Helper Functions */
 static inline void __ll_aton_lib_copy_element(uint8_t nbytes, int32_t index, int8_t *out_target, int8_t *in_target)
 {
@@ -96,182 +88,258 @@ static inline uint32_t __ll_aton_lib_calc_offset(uint32_t n, uint32_t c, uint32_
   return result;
 }
 
-/**
- * @brief  performs a slice operation on a (multi-dimensional) matrix
- * @param  input tensor shape structure
- * @param  output tensor shape structure
- * @param  slice_rank rank of slice operation's input matrix
- * @param  slice_starts 1-D tensor of starting indices of corresponding axis from 0 to rank-1
- * @param  slice_ends 1-D tensor of ending indices (exclusive) of corresponding axis from 0 to rank-1
- * @param  slice_steps 1-D tensor of slice step of corresponding axis from 0 to rank-1
- * @retval Error code
+/* N-D strided copy engine (used by `Slice` and `Transpose`)
+ *
+ * A copy is described as a loop nest over `rank` axes, outermost first, each with its size and its input and output
+ * strides in bytes (input strides may be negative). Size-1 axes are dropped and adjacent axes which are contiguous
+ * with each other in both tensors are merged while the nest is built, so that e.g. an NCHW->NHWC transpose boils down
+ * to a 2-D transpose per batch. The innermost axis is copied with a single `memcpy` when dense on both sides, else
+ * with a strided loop (Helium gathers when available). The outer axes are walked iteratively without any allocation.
  */
-typedef const struct
-{
-  const LL_LIB_TensorShape_TypeDef *input;
-  const uint32_t *input_axes_offsets;
-  const LL_LIB_TensorShape_TypeDef *output;
-  const uint32_t *output_axes_offsets;
-  uint32_t slice_rank;
-  const int32_t *slice_starts;
-  const int32_t *slice_ends;
-  const int32_t *slice_steps;
-} __ll_slice_params_t;
-
-static inline int32_t __ll_aton_lib_is_in_slice(const __ll_slice_params_t *common_params, __ll_stack_lnklst_t *elem)
-{
-  uint32_t index = elem->index;
-  uint32_t axis = elem->axis;
+#ifndef __LL_SW_ND_COPY_MAX_RANK
+#define __LL_SW_ND_COPY_MAX_RANK 8 // after merging of contiguous axes
+#endif
 
-  uint8_t slice_forwards = (common_params->slice_steps[axis] < 0) ? 0 : 1;
+#ifndef __LL_SW_ND_COPY_TILE
+#define __LL_SW_ND_COPY_TILE 16 // elements per side of the tiles used for 2-D transposes
+#endif
 
-  int32_t ret_numerator;
-  int32_t ret_denominator = abs(common_params->slice_steps[axis]);
+#if defined(__ARM_FEATURE_MVE) && !defined(LL_ATON_LIB_SW_NO_MVE)
+#define __LL_SW_ND_COPY_MVE
+#include <arm_mve.h>
+#endif
 
-  int32_t min;
-  int32_t max;
+typedef struct
+{
+  uint32_t rank;
+  uint32_t shape[__LL_SW_ND_COPY_MAX_RANK];
+  int32_t in_stride[__LL_SW_ND_COPY_MAX_RANK];
+  int32_t out_stride[__LL_SW_ND_COPY_MAX_RANK];
+} __ll_nd_copy_t;
 
-  if (slice_forwards)
-  {
-    ret_numerator = (index - common_params->slice_starts[axis]);
-    min = common_params->slice_starts[axis];
-    max = common_params->slice_ends[axis];
-  }
-  else
+/**
+ * @brief  appends an inner axis to the loop nest, merging it with the previous one when possible
+ * @retval false if the nest would exceed `__LL_SW_ND_COPY_MAX_RANK` axes
+ */
+static bool __ll_nd_copy_push_axis(__ll_nd_copy_t *nest, uint32_t size, int32_t in_stride, int32_t out_stride)
+{
+  if (size == 1)
+    return true;
+
+  if (nest->rank > 0)
   {
-    ret_numerator = (common_params->slice_starts[axis] - index);
-    max = common_params->slice_starts[axis] + 1;
-    min = common_params->slice_ends[axis] + 1;
+    uint32_t prev = nest->rank - 1;
+    if ((nest->in_stride[prev] == (int32_t)size * in_stride) && (nest->out_stride[prev] == (int32_t)size * out_stride))
+    {
+      nest->shape[prev] *= size;
+      nest->in_stride[prev] = in_stride;
+      nest->out_stride[prev] = out_stride;
+      return true;
+    }
   }
 
-  if (((index >= min) && (index < max)) && (ret_numerator % ret_denominator == 0))
-  {
-    LL_ATON_ASSERT(ret_numerator >= 0);
-    LL_ATON_ASSERT(ret_denominator > 0);
+  if (nest->rank >= __LL_SW_ND_COPY_MAX_RANK)
+    return false;
 
-    return (ret_numerator / ret_denominator);
-  }
-  else
-  {
-    return -1;
-  }
+  nest->shape[nest->rank] = size;
+  nest->in_stride[nest->rank] = in_stride;
+  nest->out_stride[nest->rank] = out_stride;
+  nest->rank++;
+  return true;
 }
 
-static int8_t *__ll_slice_get_input_and_output_base_pos(const __ll_slice_params_t *common_params,
-                                                        __ll_stack_lnklst_t *linked_stack_list, int8_t **base_in_target)
+#if defined(__LL_SW_ND_COPY_MVE)
+/* Gathers `n` elements distant of `in_stride` (> 0) bytes into a dense output, four elements per beat */
+static void __ll_nd_copy_gather(uint8_t nbytes, uint32_t n, int8_t *out, const int8_t *in, int32_t in_stride)
 {
-  LL_ATON_ASSERT(linked_stack_list != NULL);
-
-  int8_t *in_target = (int8_t *)LL_Buffer_addr_start(common_params->input);
-  int8_t *out_target = (int8_t *)LL_Buffer_addr_start(common_params->output);
-
-  LL_ATON_ASSERT(linked_stack_list->axis == (common_params->slice_rank - 1));
+  uint32x4_t offsets = vmulq_n_u32(vidupq_n_u32(0, 1), (uint32_t)in_stride);
+  const uint32_t in_step = 4 * (uint32_t)in_stride;
 
-  for (__ll_stack_lnklst_t *elem = linked_stack_list->back_link; elem != NULL; elem = elem->back_link)
+  switch (nbytes)
   {
-    LL_ATON_ASSERT(elem->axis < (common_params->slice_rank - 1));
-    uint32_t axis = elem->axis;
-
-    /* input */
-    int32_t in_axis_size = common_params->input_axes_offsets[axis];
-    in_target += (elem->index * in_axis_size);
-
-    int32_t out_index;
-    if ((out_index = __ll_aton_lib_is_in_slice(common_params, elem)) >= 0)
+  case 1:
+    for (int32_t left = (int32_t)n; left > 0; left -= 4, in += in_step, out += 4)
     {
-      /* output */
-      int32_t out_axis_size = common_params->output_axes_offsets[axis];
-      out_target += (out_index * out_axis_size);
+      mve_pred16_t p = vctp32q(left);
+      vstrbq_p_u32((uint8_t *)out, vldrbq_gather_offset_z_u32((const uint8_t *)in, offsets, p), p);
     }
-    else
+    break;
+  case 2:
+    for (int32_t left = (int32_t)n; left > 0; left -= 4, in += in_step, out += 8)
     {
-      return NULL;
+      mve_pred16_t p = vctp32q(left);
+      vstrhq_p_u32((uint16_t *)out, vldrhq_gather_offset_z_u32((const uint16_t *)in, offsets, p), p);
     }
+    break;
+  case 4:
+    for (int32_t left = (int32_t)n; left > 0; left -= 4, in += in_step, out += 16)
+    {
+      mve_pred16_t p = vctp32q(left);
+      vstrwq_p_u32((uint32_t *)out, vldrwq_gather_offset_z_u32((const uint32_t *)in, offsets, p), p);
+    }
+    break;
+  default:
+    LL_ATON_ASSERT(false);
+    break;
   }
-
-  *base_in_target = in_target;
-  return out_target;
 }
+#endif
 
-static inline void __ll_slice_copy_elem(const __ll_slice_params_t *common_params,
-                                        __ll_stack_lnklst_t *linked_stack_list, uint32_t in_offset, uint32_t out_offset,
-                                        int8_t *base_in_target, int8_t *base_out_target)
+/* Copies `n` elements along one axis */
+static void __ll_nd_copy_run(uint8_t nbytes, uint32_t n, int8_t *out, int32_t out_stride, const int8_t *in,
+                             int32_t in_stride)
 {
-  const uint8_t byte_size = LL_LIB_NBYTES(common_params->input->nbits);
+  if ((in_stride == nbytes) && (out_stride == nbytes))
+  {
+    memcpy(out, in, n * nbytes);
+    return;
+  }
 
-  int32_t out_index;
-  if ((out_index = __ll_aton_lib_is_in_slice(common_params, linked_stack_list)) >= 0)
+#if defined(__LL_SW_ND_COPY_MVE)
+  if ((out_stride == nbytes) && (in_stride > 0) && (nbytes != 3) && (n >= 4))
   {
-    /* determine input/output position */
-    int8_t *in_target = base_in_target + (linked_stack_list->index * in_offset);
-    int8_t *out_target = base_out_target + (out_index * out_offset);
+    __ll_nd_copy_gather(nbytes, n, out, in, in_stride);
+    return;
+  }
+#endif
 
-    __ll_aton_lib_copy_element(byte_size, out_index, out_target, in_target);
+  switch (nbytes)
+  {
+  case 1:
+    for (uint32_t i = 0; i < n; i++, in += in_stride, out += out_stride)
+      *out = *in;
+    break;
+  case 2:
+    LL_ATON_ASSERT(((((uintptr_t)in) | ((uintptr_t)out) | (uint32_t)in_stride | (uint32_t)out_stride) % 2) == 0);
+    for (uint32_t i = 0; i < n; i++, in += in_stride, out += out_stride)
+      *((int16_t *)out) = *((const int16_t *)in);
+    break;
+  case 3: // NOTE: assuming no alignment
+    for (uint32_t i = 0; i < n; i++, in += in_stride, out += out_stride)
+    {
+      out[0] = in[0];
+      out[1] = in[1];
+      out[2] = in[2];
+    }
+    break;
+  case 4:
+    LL_ATON_ASSERT(((((uintptr_t)in) | ((uintptr_t)out) | (uint32_t)in_stride | (uint32_t)out_stride) % 4) == 0);
+    for (uint32_t i = 0; i < n; i++, in += in_stride, out += out_stride)
+      *((int32_t *)out) = *((const int32_t *)in);
+    break;
+  default:
+    LL_ATON_ASSERT(false);
+    break;
   }
 }
 
-static void __ll_aton_lib_slice(uint32_t curr_in_axis, __ll_stack_lnklst_t *back_link,
-                                const __ll_slice_params_t *common_params)
+/* Copies a 2-D block tile by tile so that both the input rows and the output rows being accessed stay in cache */
+static void __ll_nd_copy_tiled(uint8_t nbytes, const __ll_nd_copy_t *nest, int8_t *out, const int8_t *in)
 {
-  uint8_t slice_forwards = (common_params->slice_steps[curr_in_axis] < 0) ? 0 : 1;
-  __ll_stack_lnklst_t linked_stack_list = {
-      .back_link = back_link, .axis = curr_in_axis, .index = common_params->slice_starts[curr_in_axis]};
+  const uint32_t r = nest->rank - 2, c = nest->rank - 1;
 
-  const uint32_t index_end = common_params->slice_ends[curr_in_axis];
+  for (uint32_t i0 = 0; i0 < nest->shape[r]; i0 += __LL_SW_ND_COPY_TILE)
+  {
+    uint32_t i_end = ((nest->shape[r] - i0) > __LL_SW_ND_COPY_TILE) ? (i0 + __LL_SW_ND_COPY_TILE) : nest->shape[r];
 
-  if (curr_in_axis < (common_params->slice_rank - 1))
-  { // intermediate axis
-    if (slice_forwards)
-    { // slicing forwards
-      for (; linked_stack_list.index < index_end; linked_stack_list.index++)
+    for (uint32_t j0 = 0; j0 < nest->shape[c]; j0 += __LL_SW_ND_COPY_TILE)
+    {
+      uint32_t len = ((nest->shape[c] - j0) > __LL_SW_ND_COPY_TILE) ? __LL_SW_ND_COPY_TILE : (nest->shape[c] - j0);
+
+      for (uint32_t i = i0; i < i_end; i++)
       {
-        __ll_aton_lib_slice(curr_in_axis + 1, &linked_stack_list, common_params);
+        int8_t *out_row = out + (int32_t)i * nest->out_stride[r] + (int32_t)j0 * nest->out_stride[c];
+        const int8_t *in_row = in + (int32_t)i * nest->in_stride[r] + (int32_t)j0 * nest->in_stride[c];
+        __ll_nd_copy_run(nbytes, len, out_row, nest->out_stride[c], in_row, nest->in_stride[c]);
       }
     }
-    else
-    { // slicing backwards
-      do
-      {
-        __ll_aton_lib_slice(curr_in_axis + 1, &linked_stack_list, common_params);
-        linked_stack_list.index--;
-      } while (linked_stack_list.index > index_end);
-    }
   }
-  else
-  { // last axis
-    LL_ATON_ASSERT(curr_in_axis == (common_params->slice_rank - 1));
-
-    /* Calculate input base positions */
-    int8_t *base_in_target;
-    int8_t *base_out_target =
-        __ll_slice_get_input_and_output_base_pos(common_params, &linked_stack_list, &base_in_target);
-
-    if (base_out_target == NULL)
-      return;
+}
 
-    uint32_t curr_in_axis_input_offset = common_params->input_axes_offsets[curr_in_axis];
-    uint32_t curr_in_axis_output_offset = common_params->output_axes_offsets[curr_in_axis];
+/**
+ * @brief  executes a loop nest built with `__ll_nd_copy_push_axis()`
+ * @param  nbytes element size in bytes (1 to 4)
+ * @param  nest loop nest (may be reordered)
+ * @param  out output address of the first element
+ * @param  in input address of the first element
+ */
+static void __ll_nd_copy(uint8_t nbytes, __ll_nd_copy_t *nest, int8_t *out, const int8_t *in)
+{
+  if (nest->rank == 0)
+  { // single element
+    nest->shape[0] = 1;
+    nest->in_stride[0] = nbytes;
+    nest->out_stride[0] = nbytes;
+    nest->rank = 1;
+  }
 
-    if (slice_forwards)
-    { // slicing forwards
-      for (; linked_stack_list.index < index_end; linked_stack_list.index++)
+  /* When the innermost axis is dense in output only, bring the axis which is dense in input next to it: just above
+   * for a tiled 2-D transpose, or innermost (gathers become scatters) when the output rows are too short to tile */
+  uint32_t inner_axes = 1;
+  const uint32_t last = nest->rank - 1;
+  if ((nest->out_stride[last] == nbytes) && (nest->in_stride[last] != nbytes))
+  {
+    for (uint32_t axis = 0; axis < last; axis++)
+    {
+      if ((nest->in_stride[axis] == nbytes) && (nest->shape[axis] > 1))
       {
-        __ll_slice_copy_elem(common_params, &linked_stack_list, curr_in_axis_input_offset, curr_in_axis_output_offset,
-                             base_in_target, base_out_target);
+        const bool tiled = (nest->shape[last] >= __LL_SW_ND_COPY_TILE);
+        const uint32_t target = tiled ? (last - 1) : last;
+        uint32_t size = nest->shape[axis];
+        int32_t in_stride = nest->in_stride[axis];
+        int32_t out_stride = nest->out_stride[axis];
+        for (uint32_t a = axis; a < target; a++)
+        {
+          nest->shape[a] = nest->shape[a + 1];
+          nest->in_stride[a] = nest->in_stride[a + 1];
+          nest->out_stride[a] = nest->out_stride[a + 1];
+        }
+        nest->shape[target] = size;
+        nest->in_stride[target] = in_stride;
+        nest->out_stride[target] = out_stride;
+        inner_axes = tiled ? 2 : 1;
+        break;
       }
     }
+  }
+
+  const uint32_t outer_rank = nest->rank - inner_axes;
+  uint32_t index[__LL_SW_ND_COPY_MAX_RANK] = {0};
+
+  for (;;)
+  {
+    if (inner_axes == 2)
+      __ll_nd_copy_tiled(nbytes, nest, out, in);
     else
-    { // slicing backwards
-      do
-      {
-        __ll_slice_copy_elem(common_params, &linked_stack_list, curr_in_axis_input_offset, curr_in_axis_output_offset,
-                             base_in_target, base_out_target);
-        linked_stack_list.index--;
-      } while (linked_stack_list.index > index_end);
-    }
+      __ll_nd_copy_run(nbytes, nest->shape[last], out, nest->out_stride[last], in, nest->in_stride[last]);
+
+    /* Odometer step over the outer axes */
+    int32_t axis = (int32_t)outer_rank - 1;
+    for (; axis >= 0; axis--)
+    {
+      in += nest->in_stride[axis];
+      out += nest->out_stride[axis];
+      if (++index[axis] < nest->shape[axis])
+        break;
+      index[axis] = 0;
+      in -= (int32_t)nest->shape[axis] * nest->in_stride[axis];
+      out -= (int32_t)nest->shape[axis] * nest->out_stride[axis];
+    }
+    if (axis < 0)
+      return;
   }
 }
 
+/**
+ * @brief  performs a slice operation on a (multi-dimensional) matrix
+ * @param  input tensor shape structure
+ * @param  output tensor shape structure
+ * @param  slice_rank rank of slice operation's input matrix
+ * @param  slice_starts 1-D tensor of starting indices of corresponding axis from 0 to rank-1
+ * @param  slice_ends 1-D tensor of ending indices (exclusive) of corresponding axis from 0 to rank-1
+ * @param  slice_steps 1-D tensor of slice step of corresponding axis from 0 to rank-1
+ * @retval Error code
+ */
 int LL_ATON_LIB_Slice(const LL_LIB_TensorShape_TypeDef *input, const uint32_t *input_axes_offsets,
                       const LL_LIB_TensorShape_TypeDef *output, const uint32_t *output_axes_offsets,
                       uint32_t slice_rank, const int32_t *slice_starts, const int32_t *slice_ends,
@@ -297,18 +365,34 @@ int LL_ATON_LIB_Slice(const LL_LIB_TensorShape_TypeDef *input, const uint32_t *i
     __LL_LIB_ERROR(_ERR_NBITS, LL_ATON_INVALID_PARAM);
   }
 
-  const __ll_slice_params_t common_params = {.input = input,
-                                             .input_axes_offsets = input_axes_offsets,
-                                             .output = output,
-                                             .output_axes_offsets = output_axes_offsets,
-                                             .slice_rank = slice_rank,
-                                             .slice_starts = slice_starts,
-                                             .slice_ends = slice_ends,
-                                             .slice_steps = slice_steps};
+  /* Output index `i` of an axis reads input index `start + i * step`, backwards slices use negative input strides */
+  const int8_t *in_target = (const int8_t *)LL_Buffer_addr_start(input);
+  __ll_nd_copy_t nest = {.rank = 0};
+  for (uint32_t axis = 0; axis < slice_rank; axis++)
+  {
+    int32_t step = slice_steps[axis];
+    LL_ATON_ASSERT(step != 0);
+
+    int32_t span = (step < 0) ? (slice_starts[axis] - slice_ends[axis]) : (slice_ends[axis] - slice_starts[axis]);
+    if (span <= 0)
+    {
+      return LL_ATON_OK; // empty slice
+    }
+
+    uint32_t abs_step = (uint32_t)abs(step);
+    uint32_t size = ((uint32_t)span + abs_step - 1) / abs_step;
+
+    in_target += slice_starts[axis] * (int32_t)input_axes_offsets[axis];
+    if (!__ll_nd_copy_push_axis(&nest, size, step * (int32_t)input_axes_offsets[axis],
+                                (int32_t)output_axes_offsets[axis]))
+    {
+      __LL_LIB_ERROR(_ERR_RANK, LL_ATON_INVALID_PARAM);
+    }
+  }
 
-  __ll_aton_lib_slice(0, NULL, &common_params);
+  __ll_nd_copy(LL_LIB_NBYTES(input->nbits), &nest, (int8_t *)LL_Buffer_addr_start(output), in_target);
 
-  return LL_ATON_OK; // TODO
+  return LL_ATON_OK;
 }
 
 static int __ll_aton_lib_sw_outputs_flat_copy(const LL_LIB_TensorShape_TypeDef *input,
@@ -831,215 +915,6 @@ int LL_ATON_LIB_SW_DepthToSpace(const LL_LIB_TensorShape_TypeDef *input, const u
  * @param  perm permutation to apply
  * @retval Error code
  */
-typedef const struct
-{
-  uint32_t rank;
-  const uint8_t *perm;
-  const uint32_t *in_shape_aton;
-  const uint32_t *in_axis_off;
-  const uint32_t *out_axis_off;
-  const uint8_t byte_size;
-  const int8_t *in_tensor;
-  int8_t *out_tensor;
-} __ll_transp_params_t;
-
-static inline uint32_t __ll_transp_find_input_index(__ll_stack_lnklst_t *elem, const uint8_t *perm,
-                                                    uint32_t output_axis)
-{
-  uint32_t input_axis = (uint32_t)perm[output_axis];
-  for (; elem != NULL; elem = elem->back_link)
-  {
-    if (elem->axis == input_axis)
-    {
-      return elem->index;
-    }
-  }
-  LL_ATON_ASSERT(false); // should never be reached
-  return 0;
-}
-
-static inline int8_t *__ll_transp_get_output_base_pos(uint32_t inner_out_axis,
-                                                      const __ll_transp_params_t *common_params,
-                                                      __ll_stack_lnklst_t *linked_stack_list)
-{
-  LL_ATON_ASSERT(linked_stack_list != NULL);
-  int8_t *target = common_params->out_tensor;
-
-  for (uint32_t output_axis = 0; output_axis < common_params->rank; output_axis++)
-  {
-    if (output_axis == inner_out_axis)
-      continue;
-
-    uint32_t axis_size = common_params->out_axis_off[output_axis];
-    uint32_t input_index = __ll_transp_find_input_index(linked_stack_list, common_params->perm, output_axis);
-    target += (input_index * axis_size);
-  }
-
-  return target;
-}
-
-static int8_t *__ll_transp_get_input_base_pos(const __ll_transp_params_t *common_params,
-                                              __ll_stack_lnklst_t *linked_stack_list)
-{
-  LL_ATON_ASSERT(linked_stack_list != NULL);
-
-  const int8_t *target = common_params->in_tensor;
-
-  LL_ATON_ASSERT(linked_stack_list->axis == (common_params->rank - 1));
-
-  for (__ll_stack_lnklst_t *elem = linked_stack_list->back_link; elem != NULL; elem = elem->back_link)
-  {
-    LL_ATON_ASSERT(elem->axis < (common_params->rank - 1));
-    uint32_t axis_size = common_params->in_axis_off[elem->axis];
-    target += (elem->index * axis_size);
-  }
-
-  return (int8_t *)target;
-}
-
-static void __ll_aton_lib_transpose(uint32_t curr_in_axis, uint32_t inner_out_axis, __ll_stack_lnklst_t *back_link,
-                                    const __ll_transp_params_t *common_params)
-{
-  __ll_stack_lnklst_t linked_stack_list = {.back_link = back_link, .axis = curr_in_axis, .index = 0};
-
-  if (curr_in_axis < (common_params->rank - 1))
-  { // intermediate axis
-    for (; linked_stack_list.index < common_params->in_shape_aton[linked_stack_list.axis]; linked_stack_list.index++)
-    {
-      __ll_aton_lib_transpose(curr_in_axis + 1, inner_out_axis, &linked_stack_list, common_params);
-    }
-  }
-  else
-  { // last axis
-    LL_ATON_ASSERT(curr_in_axis == (common_params->rank - 1));
-
-    /* Calculate input/output base positions */
-    int8_t *base_out_target = __ll_transp_get_output_base_pos(inner_out_axis, common_params, &linked_stack_list);
-    int8_t *base_in_target = __ll_transp_get_input_base_pos(common_params, &linked_stack_list);
-    uint32_t out_axes_offset = common_params->out_axis_off[inner_out_axis];
-
-    const uint32_t end_index = common_params->in_shape_aton[(common_params->rank - 1)];
-    const uint8_t byte_size = common_params->byte_size;
-
-    if (byte_size != out_axes_offset)
-    {
-      for (; linked_stack_list.index < end_index; linked_stack_list.index++)
-      {
-        /* determine input/output position */
-        int8_t *in_target = base_in_target + (linked_stack_list.index * byte_size);
-        int8_t *out_target = base_out_target + (linked_stack_list.index * out_axes_offset);
-
-        __ll_aton_lib_copy_element(byte_size, linked_stack_list.index, out_target, in_target);
-      }
-    }
-    else
-    {
-      uint32_t size_in_bytes = (end_index - linked_stack_list.index) * byte_size; // `byte_size == out_axes_offset`
-
-      int8_t *in_target = base_in_target + (linked_stack_list.index * byte_size);
-      int8_t *out_target =
-          base_out_target + (linked_stack_list.index * out_axes_offset); // `byte_size == out_axes_offset`
-
-      memcpy(out_target, in_target, size_in_bytes);
-    }
-  }
-}
-
-static inline uint32_t __ll_transp_find_input_index_3or4(uint32_t *indexes, const uint8_t *perm, uint32_t output_axis)
-{
-  uint32_t input_axis = (uint32_t)perm[output_axis];
-  return indexes[input_axis];
-}
-
-static inline int8_t *__ll_transp_get_output_base_pos_3or4(uint32_t inner_out_axis,
-                                                           const __ll_transp_params_t *common_params, uint32_t *indexes)
-{
-  int8_t *target = common_params->out_tensor;
-
-  for (uint32_t output_axis = 0; output_axis < common_params->rank; output_axis++)
-  {
-    if (output_axis == inner_out_axis)
-      continue;
-
-    LL_ATON_ASSERT((uint32_t)common_params->perm[output_axis] < (common_params->rank - 1));
-
-    uint32_t input_index = __ll_transp_find_input_index_3or4(indexes, common_params->perm, output_axis);
-    uint32_t axis_size = common_params->out_axis_off[output_axis];
-    target += (input_index * axis_size);
-  }
-
-  return target;
-}
-
-static int8_t *__ll_transp_get_input_base_pos_3or4(const __ll_transp_params_t *common_params, uint32_t *indexes)
-{
-  const int8_t *target = common_params->in_tensor;
-
-  for (uint32_t axis = 0; axis < (common_params->rank - 1); axis++)
-  {
-    uint32_t axis_size = common_params->in_axis_off[axis];
-    target += (indexes[axis] * axis_size);
-  }
-
-  return (int8_t *)target;
-}
-
-static inline uint32_t __ll_transp_get_inner_out_axis(const __ll_transp_params_t *common_params)
-{
-  for (unsigned int i = 0; i < common_params->rank; i++)
-  {
-    if (((uint32_t)common_params->perm[i]) == (common_params->rank - 1))
-      return i;
-  }
-  LL_ATON_ASSERT(false);
-  return common_params->rank; // make compiler happy
-}
-
-static void __ll_aton_lib_transpose_3or4(const __ll_transp_params_t *common_params)
-{
-  LL_ATON_ASSERT((common_params->rank == 4) || ((common_params->rank == 3)));
-  uint32_t inner_out_axis = __ll_transp_get_inner_out_axis(common_params);
-  uint32_t out_axes_offset = common_params->out_axis_off[inner_out_axis];
-  const uint8_t byte_size = common_params->byte_size;
-
-  uint32_t size_n = (common_params->rank == 4) ? common_params->in_shape_aton[0] : 1;
-  uint32_t size_c = (common_params->rank == 4) ? common_params->in_shape_aton[1] : common_params->in_shape_aton[0];
-  uint32_t size_h = (common_params->rank == 4) ? common_params->in_shape_aton[2] : common_params->in_shape_aton[1];
-  uint32_t size_w = (common_params->rank == 4) ? common_params->in_shape_aton[3] : common_params->in_shape_aton[2];
-
-  for (uint32_t index_n = 0; index_n < size_n; index_n++)
-  {
-    for (uint32_t index_c = 0; index_c < size_c; index_c++)
-    {
-      for (uint32_t index_h = 0; index_h < size_h; index_h++)
-      {
-        uint32_t indexes_array[] = {index_n, index_c, index_h};
-        uint32_t *indexes = (common_params->rank == 4) ? &indexes_array[0] : &indexes_array[1];
-
-        int8_t *base_out_target = __ll_transp_get_output_base_pos_3or4(inner_out_axis, common_params, indexes);
-        int8_t *base_in_target = __ll_transp_get_input_base_pos_3or4(common_params, indexes);
-
-        if (byte_size != out_axes_offset)
-        {
-          for (uint32_t index_w = 0; index_w < size_w; index_w++)
-          {
-            /* determine input/output position */
-            int8_t *in_target = base_in_target + (index_w * byte_size);
-            int8_t *out_target = base_out_target + (index_w * out_axes_offset);
-
-            __ll_aton_lib_copy_element(byte_size, index_w, out_target, in_target);
-          }
-        }
-        else
-        {
-          uint32_t size_in_bytes = size_w * byte_size; // `byte_size == out_axes_offset`
-          memcpy(base_out_target, base_in_target, size_in_bytes);
-        }
-      }
-    }
-  }
-}
-
 int LL_ATON_LIB_Transpose(const LL_LIB_TensorShape_TypeDef *input, const uint32_t *input_axes_offsets,
                           const LL_LIB_TensorShape_TypeDef *output, const uint32_t *output_axes_offsets,
                           const uint8_t *perm)
@@ -1064,25 +939,23 @@ int LL_ATON_LIB_Transpose(const LL_LIB_TensorShape_TypeDef *input, const uint32_
     __LL_LIB_ERROR(_ERR_NBITS, LL_ATON_INVALID_PARAM);
   }
 
-  const __ll_transp_params_t common_params = {.perm = perm,
-                                              .rank = input->ndims,
-                                              .in_shape_aton = input->shape,
-                                              .in_axis_off = input_axes_offsets,
-                                              .out_axis_off = output_axes_offsets,
-                                              .byte_size = LL_LIB_NBYTES(input->nbits),
-                                              .in_tensor = (int8_t *)LL_Buffer_addr_start(input),
-                                              .out_tensor = (int8_t *)LL_Buffer_addr_start(output)};
-
-  if (input->ndims <= 4)
+  /* Loop nest in output order: output is written sequentially, input is gathered */
+  __ll_nd_copy_t nest = {.rank = 0};
+  for (uint32_t out_axis = 0; out_axis < (uint32_t)input->ndims; out_axis++)
   {
-    __ll_aton_lib_transpose_3or4(&common_params);
-  }
-  else
-  {
-    uint32_t inner_out_axis = __ll_transp_get_inner_out_axis(&common_params);
-    __ll_aton_lib_transpose(0, inner_out_axis, NULL, &common_params);
+    uint32_t in_axis = (uint32_t)perm[out_axis];
+    LL_ATON_ASSERT(in_axis < (uint32_t)input->ndims);
+
+    if (!__ll_nd_copy_push_axis(&nest, input->shape[in_axis], (int32_t)input_axes_offsets[in_axis],
+                                (int32_t)output_axes_offsets[out_axis]))
+    {
+      __LL_LIB_ERROR(_ERR_RANK, LL_ATON_INVALID_PARAM);
+    }
   }
 
+  __ll_nd_copy(LL_LIB_NBYTES(input->nbits), &nest, (int8_t *)LL_Buffer_addr_start(output),
+               (const int8_t *)LL_Buffer_addr_start(input));
+
   return LL_ATON_OK;
 }
 
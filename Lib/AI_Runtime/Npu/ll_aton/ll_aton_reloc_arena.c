@@ -0,0 +1,238 @@
+/**
+ ******************************************************************************
+ * @file    ll_aton_reloc_arena.c
+ * @author  MCD/AIS Team
+ * @brief   Implementation of the ATON LL module sharing memory between relocatable models
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#if defined(LL_ATON_RT_RELOC)
+
+#include "ll_aton_reloc_arena.h"
+
+#if !defined(AI_RELOC_LOG_ENABLE)
+#define AI_RELOC_LOG_ENABLE 1 /* 1: enable debug trace support (printf-based) */
+#endif
+
+#if defined(AI_RELOC_LOG_ENABLE) && AI_RELOC_LOG_ENABLE == 1 && !defined(NDEBUG)
+#define AI_RELOC_LOG(...) printf(__VA_ARGS__)
+#else
+#define AI_RELOC_LOG(...)                                                                                              \
+  do                                                                                                                   \
+  {                                                                                                                    \
+  } while (0)
+#endif
+
+#define AI_RELOC_ARENA_ROUND_UP(_v) (((_v) + (AI_RELOC_ARENA_ALIGN - 1)) & ~(AI_RELOC_ARENA_ALIGN - 1))
+
+static inline bool _arena_overlap(uintptr_t a, uint32_t a_sz, uintptr_t b, uint32_t b_sz)
+{
+  return (a < (b + b_sz)) && (b < (a + a_sz));
+}
+
+static bool _arena_concurrent(const ll_aton_reloc_arena_model *models, uint32_t i, uint32_t j)
+{
+  return ((models[i].concurrent_mask >> j) & 1) || ((models[j].concurrent_mask >> i) & 1);
+}
+
+/*
+ * Return true if the external RAM pool of a model also holds params (copied at install time)
+ */
+static bool _arena_ext_ram_is_persistent(uintptr_t file_ptr)
+{
+  const ll_aton_reloc_mem_pool_desc *desc;
+  int index = 0;
+
+  while ((desc = ll_aton_reloc_get_mem_pool_desc(file_ptr, index++)))
+  {
+    if (AI_RELOC_MPOOL_IS_RELOC(desc->flags) && (AI_RELOC_MPOOL_GET_ID(desc->flags) == 1) &&
+        AI_RELOC_MPOOL_IS_MIXED(desc->flags))
+      return true;
+  }
+
+  return false;
+}
+
+/*
+ * Count the fixed pools of two models which overlap while they can not be shared
+ */
+static uint32_t _arena_check_fixed_pools(const ll_aton_reloc_arena_model *models, uint32_t i, uint32_t j)
+{
+  const ll_aton_reloc_mem_pool_desc *desc_i;
+  const ll_aton_reloc_mem_pool_desc *desc_j;
+  const bool concurrent = _arena_concurrent(models, i, j);
+  uint32_t conflicts = 0;
+  int index_i = 0;
+
+  while ((desc_i = ll_aton_reloc_get_mem_pool_desc(models[i].file_ptr, index_i++)))
+  {
+    if (AI_RELOC_MPOOL_IS_RELOC(desc_i->flags) || !desc_i->size)
+      continue;
+
+    int index_j = 0;
+    while ((desc_j = ll_aton_reloc_get_mem_pool_desc(models[j].file_ptr, index_j++)))
+    {
+      if (AI_RELOC_MPOOL_IS_RELOC(desc_j->flags) || !desc_j->size)
+        continue;
+
+      if (!_arena_overlap(desc_i->dst, desc_i->size, desc_j->dst, desc_j->size))
+        continue;
+
+      /* Only scratch memory (activations) of exclusive models can be shared */
+      if (concurrent || !AI_RELOC_MPOOL_IS_ACTIV(desc_i->flags) || !AI_RELOC_MPOOL_IS_ACTIV(desc_j->flags))
+      {
+        AI_RELOC_LOG("AI RELOC ERROR: pool %d of model %d overlaps pool %d of model %d\r\n", index_i - 1, (int)i,
+                     index_j - 1, (int)j);
+        conflicts++;
+      }
+    }
+  }
+
+  return conflicts;
+}
+
+/* -----------------------------------------------------------------------------
+ * Public API implementation
+ * -----------------------------------------------------------------------------
+ */
+
+/*
+ * Place the external RAM pools of the models in the arena [arena_addr, arena_addr + arena_size[
+ *
+ * Pools are placed from the largest to the smallest one, each one at the lowest offset which does not overlap the
+ * pools already placed for the models which may run at the same time (first-fit).
+ */
+int ll_aton_reloc_arena_plan(uintptr_t arena_addr, size_t arena_size, ll_aton_reloc_arena_model *models,
+                             uint32_t nb_models, ll_aton_reloc_arena_report *report)
+{
+  uint8_t order[AI_RELOC_ARENA_MAX_MODELS];
+  uint32_t offsets[AI_RELOC_ARENA_MAX_MODELS];
+  uint32_t persistent = 0;
+  ll_aton_reloc_arena_report res = {0};
+
+  if (!models || !nb_models || (nb_models > AI_RELOC_ARENA_MAX_MODELS))
+    return AI_RELOC_RT_ERR_ARG;
+
+  if ((arena_addr & (AI_RELOC_ARENA_ALIGN - 1)) != 0)
+    return AI_RELOC_RT_ERR_PARAM_ADDR;
+
+  /* Requirements of each model, sorted by decreasing size */
+  for (uint32_t i = 0; i < nb_models; i++)
+  {
+    ll_aton_reloc_info rt_info;
+
+    if (ll_aton_reloc_get_info(models[i].file_ptr, &rt_info))
+      return AI_RELOC_RT_ERR_INVALID_BIN;
+
+    models[i].ext_ram_size = AI_RELOC_ARENA_ROUND_UP(rt_info.ext_ram_sz);
+    models[i].ext_ram_addr = 0;
+    if (_arena_ext_ram_is_persistent(models[i].file_ptr))
+      persistent |= 1UL << i;
+    res.unshared_size += models[i].ext_ram_size;
+
+    uint32_t pos = i;
+    while ((pos > 0) && (models[order[pos - 1]].ext_ram_size < models[i].ext_ram_size))
+    {
+      order[pos] = order[pos - 1];
+      pos--;
+    }
+    order[pos] = (uint8_t)i;
+  }
+
+  /* First-fit placement */
+  for (uint32_t n = 0; n < nb_models; n++)
+  {
+    const uint32_t i = order[n];
+    const uint32_t size = models[i].ext_ram_size;
+    uint32_t offset = 0;
+    bool moved = true;
+
+    if (!size)
+      continue;
+
+    /* Move past the placed pools it can not share, until it fits in a hole */
+    while (moved)
+    {
+      moved = false;
+      for (uint32_t m = 0; m < n; m++)
+      {
+        const uint32_t j = order[m];
+        const bool shared = !_arena_concurrent(models, i, j) && !((persistent >> i) & 1) && !((persistent >> j) & 1);
+
+        if (!shared && models[j].ext_ram_size && _arena_overlap(offset, size, offsets[j], models[j].ext_ram_size))
+        {
+          offset = offsets[j] + models[j].ext_ram_size;
+          moved = true;
+        }
+      }
+    }
+
+    offsets[i] = offset;
+    if ((offset + size) > res.arena_size)
+      res.arena_size = offset + size;
+  }
+
+  /* Fixed pools */
+  for (uint32_t i = 0; i < nb_models; i++)
+    for (uint32_t j = i + 1; j < nb_models; j++)
+      res.conflicts += _arena_check_fixed_pools(models, i, j);
+
+  if (report)
+    *report = res;
+
+  if (res.arena_size > arena_size)
+    return AI_RELOC_RT_ERR_MEMORY;
+
+  if (res.conflicts)
+    return AI_RELOC_RT_ERR_PARAM_ADDR;
+
+  for (uint32_t i = 0; i < nb_models; i++)
+    if (models[i].ext_ram_size)
+      models[i].ext_ram_addr = arena_addr + offsets[i];
+
+  return AI_RELOC_RT_ERR_NONE;
+}
+
+void ll_aton_reloc_arena_log(const ll_aton_reloc_arena_model *models, uint32_t nb_models,
+                             const ll_aton_reloc_arena_report *report)
+{
+#if defined(AI_RELOC_LOG_ENABLE) && AI_RELOC_LOG_ENABLE == 1
+  if (!models || !report)
+    return;
+
+  AI_RELOC_LOG("\r\nArena plan (%d models)\r\n", (int)nb_models);
+  AI_RELOC_LOG("----------------------------------------------------------------\n");
+
+  for (uint32_t i = 0; i < nb_models; i++)
+  {
+    ll_aton_reloc_info rt_info;
+
+    if (ll_aton_reloc_get_info(models[i].file_ptr, &rt_info))
+      continue;
+
+    AI_RELOC_LOG("  %d: \"%s\" ext ram @0x%08x s=%d concurrent=0x%08x\r\n", (int)i, rt_info.c_name,
+                 (int)models[i].ext_ram_addr, (int)models[i].ext_ram_size, (int)models[i].concurrent_mask);
+  }
+
+  AI_RELOC_LOG("  peak          : %d\r\n", (int)report->arena_size);
+  AI_RELOC_LOG("  unshared      : %d\r\n", (int)report->unshared_size);
+  AI_RELOC_LOG("  conflicts     : %d\r\n", (int)report->conflicts);
+  AI_RELOC_LOG("\r\n");
+#endif /* AI_RELOC_LOG_ENABLE == 1 */
+}
+
+#endif /* defined(LL_ATON_RT_RELOC) */
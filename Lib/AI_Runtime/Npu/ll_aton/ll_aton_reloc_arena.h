@@ -0,0 +1,79 @@
+/**
+ ******************************************************************************
+ * @file    ll_aton_reloc_arena.h
+ * @author  MCD/AIS Team
+ * @brief   Header file of ATON LL module sharing memory between relocatable models
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef __LL_ATON_RELOC_ARENA_H__
+#define __LL_ATON_RELOC_ARENA_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "ll_aton_reloc_network.h"
+
+/* Max number of models planned together (see concurrent_mask) */
+#define AI_RELOC_ARENA_MAX_MODELS 32
+
+/* Alignment of the external RAM pools placed in the arena (MCU cache line) */
+#define AI_RELOC_ARENA_ALIGN 32
+
+  /*
+   * Arena planner
+   *
+   * The external RAM pool (mempool id 1) of each model is placed in a single arena provided by the application,
+   * models which never run at the same time sharing the same addresses. Activations are not preserved from one
+   * inference to the other, a model is then free to use the memory left by another one. External RAM pools holding
+   * params (mixed pools) are never shared.
+   *
+   * The pools placed at fixed addresses by the compiler (from the .mpool file) are checked as well: activations
+   * pools of two models may only overlap if the models never run at the same time, params pools should never overlap
+   * any other pool.
+   */
+  typedef struct _ll_aton_reloc_arena_model
+  {
+    uintptr_t file_ptr;       /* @ of the memory-mapped binary object */
+    uint32_t concurrent_mask; /* bit i set: may run at the same time as the model i (either side is enough) */
+    /* Set by ll_aton_reloc_arena_plan() */
+    uint32_t ext_ram_size;  /* requested size of the external RAM pool */
+    uintptr_t ext_ram_addr; /* @ of the external RAM pool, to be used in ll_aton_reloc_config */
+  } ll_aton_reloc_arena_model;
+
+  typedef struct _ll_aton_reloc_arena_report
+  {
+    uint32_t arena_size;    /* peak size of the arena */
+    uint32_t unshared_size; /* size of the arena if no memory was shared */
+    uint32_t conflicts;     /* number of overlapping fixed pools which can not be shared */
+  } ll_aton_reloc_arena_report;
+
+  /* -----------------------------------------------------------------------------
+   * Public API declaration
+   * ----------------------------------------------------------------------------- */
+
+  int ll_aton_reloc_arena_plan(uintptr_t arena_addr, size_t arena_size, ll_aton_reloc_arena_model *models,
+                               uint32_t nb_models, ll_aton_reloc_arena_report *report);
+
+  void ll_aton_reloc_arena_log(const ll_aton_reloc_arena_model *models, uint32_t nb_models,
+                               const ll_aton_reloc_arena_report *report);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LL_ATON_RELOC_ARENA_H__ */
@@ -91,6 +91,11 @@
   } while (0)
 #endif
 
+/* Copy of a weights page (AI_RELOC_RT_LOAD_MODE_STAGED), may be overridden to use a DMA */
+#if !defined(AI_RELOC_PAGE_COPY)
+#define AI_RELOC_PAGE_COPY(_dst, _src, _size) memcpy((void *)(_dst), (const void *)(_src), (size_t)(_size))
+#endif
+
 /*
  *  Implementation of the call-backs fcts
  */
@@ -591,7 +596,13 @@ static int _ai_reloc_prepare_mpools(const uintptr_t file_ptr, struct id_mpool_ma
     }
     else /* !AI_RELOC_MPOOL_IS_RELOC */
     {
-      if (AI_RELOC_MPOOL_IS_COPY(flags))
+      if (AI_RELOC_MPOOL_IS_COPY(flags) && (mode & AI_RELOC_RT_LOAD_MODE_STAGED) && AI_RELOC_MPOOL_IS_PARAM(flags))
+      {
+        /* Paged in while the NPU runs, the NPU cache can not be invalidated then */
+        if (AI_RELOC_MPOOL_IS_CACHEABLE(flags))
+          return AI_RELOC_RT_ERR_PARAM_DESC;
+      }
+      else if (AI_RELOC_MPOOL_IS_COPY(flags))
       {
         memcpy((void *)dst, (void const *)(src), sz);
         RELOC_MCU_D_CACHE_CLEAN_INVALIDATE(dst, sz);
@@ -619,6 +630,42 @@ static int _ai_reloc_prepare_mpools(const uintptr_t file_ptr, struct id_mpool_ma
   return AI_RELOC_RT_ERR_NONE;
 }
 
+/*
+ * Check the paging plan of a staged install, each page should be inside a COPY params memory pool
+ */
+static int _ai_reloc_check_pager(const uintptr_t file_ptr, const ll_aton_reloc_pager *pager)
+{
+  if (!pager || !pager->pages || !pager->nb_pages)
+    return AI_RELOC_RT_ERR_ARG;
+
+  for (uint32_t i = 0; i < pager->nb_pages; i++)
+  {
+    const ll_aton_reloc_page *page = &pager->pages[i];
+    const ll_aton_reloc_mem_pool_desc *desc;
+    bool found = false;
+    int index = 0;
+
+    if ((i > 0) && (page->epoch_block < pager->pages[i - 1].epoch_block))
+      return AI_RELOC_RT_ERR_ARG;
+
+    while (!found && (desc = ll_aton_reloc_get_mem_pool_desc(file_ptr, index++)))
+    {
+      found = !AI_RELOC_MPOOL_IS_RELOC(desc->flags) && AI_RELOC_MPOOL_IS_COPY(desc->flags) &&
+              AI_RELOC_MPOOL_IS_PARAM(desc->flags) && (page->dst >= desc->dst) &&
+              ((page->dst + page->size) <= (desc->dst + desc->size));
+    }
+
+    if (!found)
+    {
+      AI_RELOC_LOG("AI RELOC ERROR: page %d (dst=%08x s=%d) is not in a COPY params mempool\r\n", (int)i,
+                   (int)page->dst, (int)page->size);
+      return AI_RELOC_RT_ERR_PARAM_DESC;
+    }
+  }
+
+  return AI_RELOC_RT_ERR_NONE;
+}
+
 static int _ai_reloc_got_update(const struct ai_reloc_bin_hdr *bin, uintptr_t ram_addr, uintptr_t param_0_addr,
                                 uintptr_t param_1_addr)
 {
@@ -731,6 +778,10 @@ int _ai_reloc_ram_update(const struct ai_reloc_bin_hdr *bin, uintptr_t ram_addr,
  * 	            code (text/rodata section) is executed-in-place
  * 	COPY mode - code is also copied in RAM
  *
+ * 	STAGED mode - (in addition to XIP or COPY mode) the COPY params memory
+ * 	            pools are not filled, the weights are paged in epoch block by
+ * 	            epoch block by the runtime according to the 'pager' plan
+ *
  *
  * obj@                               ram_addr@       -> should be aligned 8-bytes
  *   ----------- rom_addr@              -----------
@@ -756,7 +807,8 @@ int _ai_reloc_ram_update(const struct ai_reloc_bin_hdr *bin, uintptr_t ram_addr,
  *
  */
 static int _ai_reloc_install(const uintptr_t file_ptr, uintptr_t ram_addr, size_t ram_size, uint32_t ext_ram_addr,
-                             size_t ext_ram_size, uintptr_t param_addr, uint32_t mode, NN_Instance_TypeDef *nn_instance)
+                             size_t ext_ram_size, uintptr_t param_addr, uint32_t mode, ll_aton_reloc_pager *pager,
+                             NN_Instance_TypeDef *nn_instance)
 {
   int res;
   uint32_t state = AI_RELOC_RT_STATE_NOT_INITIALIZED;
@@ -780,6 +832,13 @@ static int _ai_reloc_install(const uintptr_t file_ptr, uintptr_t ram_addr, size_
   if (ram_addr && ram_size && !AI_RELOC_IS_ALIGNED(ram_addr))
     return AI_RELOC_RT_ERR_MEMORY;
 
+  if (mode & AI_RELOC_RT_LOAD_MODE_STAGED)
+  {
+    res = _ai_reloc_check_pager(file_ptr, pager);
+    if (res)
+      return res;
+  }
+
   res = _ai_reloc_prepare_mpools(file_ptr, &id_map, mode);
   if (res)
     return res;
@@ -838,6 +897,14 @@ static int _ai_reloc_install(const uintptr_t file_ptr, uintptr_t ram_addr, size_
   memset(&nn_instance->exec_state, 0, sizeof(NN_Execution_State_TypeDef));
   nn_instance->exec_state.inst_reloc = (uint32_t)rt_ctx;
 
+  if (mode & AI_RELOC_RT_LOAD_MODE_STAGED)
+  {
+    pager->params_addr = param_addr ? param_addr : file_ptr + AI_RELOC_GET_OFFSET(rom_addr->sect.params_offset);
+    pager->next = 0;
+    pager->last_block = UINT32_MAX;
+    nn_instance->exec_state.inst_pager = (uint32_t)pager;
+  }
+
   return AI_RELOC_RT_ERR_NONE;
 }
 
@@ -1018,7 +1085,7 @@ int ll_aton_reloc_install(const uintptr_t file_ptr, const ll_aton_reloc_config *
 
   int res;
   res = _ai_reloc_install(file_ptr, config->exec_ram_addr, config->exec_ram_size, config->ext_ram_addr,
-                          config->ext_ram_size, config->ext_param_addr, config->mode, nn_instance);
+                          config->ext_ram_size, config->ext_param_addr, config->mode, config->pager, nn_instance);
 
   if (!res)
     res = ll_aton_reloc_set_callbacks(nn_instance, &_network_reloc_callback);
@@ -1227,6 +1294,57 @@ void ai_rel_call_start_end_function(uintptr_t inst, start_end_func_ptr fct, cons
   __asm volatile("mov r9, %0\n\t" ::"r"(_saved_r9));
 }
 
+/*
+ * Load the pages (staged install) up to the epoch block 'block', return immediately if already done
+ */
+static void _ai_rel_page_load(ll_aton_reloc_pager *pager, uint32_t block)
+{
+  while ((pager->next < pager->nb_pages) && (pager->pages[pager->next].epoch_block <= block))
+  {
+    const ll_aton_reloc_page *page = &pager->pages[pager->next];
+    AI_RELOC_PAGE_COPY(page->dst, pager->params_addr + page->foff, page->size);
+    RELOC_MCU_D_CACHE_CLEAN_INVALIDATE(page->dst, page->size);
+    pager->next++;
+  }
+}
+
+/*
+ * Called by the runtime before starting an epoch block
+ */
+void ai_rel_network_page_in(uintptr_t hdl, const EpochBlock_ItemTypeDef *epoch_blocks,
+                            const EpochBlock_ItemTypeDef *epoch_block)
+{
+  ll_aton_reloc_pager *pager = (ll_aton_reloc_pager *)hdl;
+
+  /* Epoch blocks inserted by the LL ATON lib do not read weights */
+  if (EpochBlock_IsEpochInternal(epoch_block))
+    return;
+
+  const uint32_t block = (uint32_t)(epoch_block - epoch_blocks);
+
+  /* Back to a previous epoch block: new inference */
+  if (block < pager->last_block)
+    pager->next = 0;
+  pager->last_block = block;
+
+  _ai_rel_page_load(pager, block);
+}
+
+/*
+ * Called by the runtime once an epoch block is started, the pages of the next epoch block are copied while
+ * the NPU executes the current one
+ */
+void ai_rel_network_page_ahead(uintptr_t hdl, const EpochBlock_ItemTypeDef *epoch_blocks,
+                               const EpochBlock_ItemTypeDef *epoch_block)
+{
+  ll_aton_reloc_pager *pager = (ll_aton_reloc_pager *)hdl;
+
+  if (EpochBlock_IsEpochInternal(epoch_block) || EpochBlock_IsLastEpochBlock(epoch_block))
+    return;
+
+  _ai_rel_page_load(pager, (uint32_t)(epoch_block - epoch_blocks) + 1);
+}
+
 int ll_aton_reloc_get_file_ptr(const NN_Instance_TypeDef *nn_inst, uintptr_t *file_ptr)
 {
   if (!nn_inst || !file_ptr || !nn_inst->exec_state.inst_reloc)
@@ -47,6 +47,7 @@ extern "C"
                                             copied in RAM, code is executed in-place */
 #define AI_RELOC_RT_LOAD_MODE_COPY  (1 << 1) /* code and data sections are copied in RAM */
 #define AI_RELOC_RT_LOAD_MODE_CLEAR (1 << 2) /* clear the acts memory pools */
+#define AI_RELOC_RT_LOAD_MODE_STAGED (1 << 3) /* COPY params memory pools are paged in (see ll_aton_reloc_pager) */
 
 /* AI RT error definitions */
 #define AI_RELOC_RT_ERR_NONE          (0)
@@ -228,6 +229,35 @@ extern "C"
     uint32_t rt_version_extra;   /* rt version extra */
   } ll_aton_reloc_info;
 
+  /*
+   * Staged install (AI_RELOC_RT_LOAD_MODE_STAGED)
+   *
+   * The COPY params memory pools (on-chip destination) are not filled at install time. Instead the pages of the
+   * paging plan are copied from the memory-mapped binary right before the first epoch block reading them, the pages
+   * of the next epoch block being copied while the current one is executed by the NPU.
+   *
+   * The plan is produced offline from the memory map of the compiled model (the binary does not record which epoch
+   * block reads which weights). Pages are sorted by increasing epoch block index and the pages read by an epoch block
+   * should not overlap the ones read by the previous epoch block (double-buffered windows).
+   */
+  typedef struct _ll_aton_reloc_page
+  {
+    uint32_t epoch_block; /* index of the first epoch block reading the page (see ll_aton_reloc_get_epoch_items()) */
+    uint32_t foff;        /* offset of the page in the params/weights blob */
+    uint32_t dst;         /* dst @, inside a COPY params memory pool */
+    uint32_t size;        /* size in bytes */
+  } ll_aton_reloc_page;
+
+  typedef struct _ll_aton_reloc_pager
+  {
+    const ll_aton_reloc_page *pages; /* paging plan */
+    uint32_t nb_pages;               /* number of pages */
+    /* Private - set by ll_aton_reloc_install() */
+    uintptr_t params_addr; /* base@ of the memory-mapped params/weights blob */
+    uint32_t next;         /* index of the first page not loaded for the current inference */
+    uint32_t last_block;   /* index of the previous epoch block */
+  } ll_aton_reloc_pager;
+
   typedef struct _ll_aton_reloc_config
   {
     uintptr_t exec_ram_addr;  /* base@ of the exec memory region to place the relocatable code/data (8-Bytes aligned) */
@@ -236,6 +266,7 @@ extern "C"
     size_t ext_ram_size;      /* max size in byte of the external memory region */
     uintptr_t ext_param_addr; /* base@ of the param memory region (if requested) */
     uint32_t mode;
+    ll_aton_reloc_pager *pager; /* paging plan and state (AI_RELOC_RT_LOAD_MODE_STAGED only) */
   } ll_aton_reloc_config;
 
   typedef struct _ll_aton_reloc_mem_pool_desc
@@ -332,6 +363,11 @@ extern "C"
 
   void ai_rel_call_start_end_function(uintptr_t inst, start_end_func_ptr fct, const void *epoch_block);
 
+  void ai_rel_network_page_in(uintptr_t pager, const EpochBlock_ItemTypeDef *epoch_blocks,
+                              const EpochBlock_ItemTypeDef *epoch_block);
+  void ai_rel_network_page_ahead(uintptr_t pager, const EpochBlock_ItemTypeDef *epoch_blocks,
+                                 const EpochBlock_ItemTypeDef *epoch_block);
+
 #if defined(BUILD_AI_NETWORK_RELOC)
 
   /* -----------------------------------------------------------------------------
@@ -0,0 +1,235 @@
+/**
+ ******************************************************************************
+ * @file    ll_aton_rt_scheduler.c
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   ATON LL runtime scheduler.
+ * @note    Interleaves several network instances on the NPU at epoch block granularity
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ll_aton_rt_scheduler.h"
+
+extern NN_Instance_TypeDef *volatile __ll_current_aton_ip_owner;
+
+static inline uint64_t __LL_ATON_RT_Sched_Now(LL_ATON_RT_Scheduler_t *sched)
+{
+  return (sched->now_ns != NULL) ? sched->now_ns() : 0;
+}
+
+/**
+ * @brief Returns true if job `a` must run before job `b`
+ * @note  Higher class first, then earliest deadline (no deadline is the latest), then submission order
+ */
+static inline bool __LL_ATON_RT_Sched_Before(const LL_ATON_RT_Sched_Job_t *a, const LL_ATON_RT_Sched_Job_t *b)
+{
+  if (a->priority != b->priority)
+  {
+    return a->priority < b->priority;
+  }
+  if (a->deadline_ns != b->deadline_ns)
+  {
+    if (a->deadline_ns == 0)
+      return false;
+    if (b->deadline_ns == 0)
+      return true;
+    return a->deadline_ns < b->deadline_ns;
+  }
+  return (int32_t)(a->seq - b->seq) < 0; // wrap-around safe
+}
+
+static LL_ATON_RT_Sched_Job_t *__LL_ATON_RT_Sched_Select(LL_ATON_RT_Scheduler_t *sched)
+{
+  LL_ATON_RT_Sched_Job_t *best = NULL;
+  uint32_t cs_state;
+
+  LL_ATON_RT_SCHED_ENTER_CS(cs_state);
+  for (LL_ATON_RT_Sched_Job_t *job = sched->jobs; job != NULL; job = job->next)
+  {
+    if (job->state == LL_ATON_RT_SCHED_JOB_IDLE)
+      continue;
+    if ((best == NULL) || __LL_ATON_RT_Sched_Before(job, best))
+      best = job;
+  }
+  LL_ATON_RT_SCHED_EXIT_CS(cs_state);
+
+  return best;
+}
+
+static void __LL_ATON_RT_Sched_Complete(LL_ATON_RT_Scheduler_t *sched, LL_ATON_RT_Sched_Job_t *job)
+{
+  LL_ATON_RT_Sched_Stats_t *stats = &sched->stats[job->priority];
+  uint64_t now = __LL_ATON_RT_Sched_Now(sched);
+  uint64_t latency = now - job->submit_ns;
+
+  LL_ATON_RT_Reset_Network(job->nn_instance);
+
+  stats->nb_done++;
+  stats->latency_sum_ns += latency;
+  if (latency > stats->latency_max_ns)
+    stats->latency_max_ns = latency;
+  if ((job->deadline_ns != 0) && (now > job->deadline_ns))
+    stats->nb_deadline_missed++;
+
+  sched->current = NULL;
+  job->state = LL_ATON_RT_SCHED_JOB_IDLE; // from now on the job may be submitted again
+
+  if (job->done_callback != NULL)
+    job->done_callback(job, job->user_data);
+}
+
+void LL_ATON_RT_Sched_Init(LL_ATON_RT_Scheduler_t *sched, uint64_t (*now_ns)(void))
+{
+  LL_ATON_ASSERT(sched != NULL);
+
+  memset(sched, 0, sizeof(*sched));
+  sched->now_ns = now_ns;
+}
+
+void LL_ATON_RT_Sched_Add_Job(LL_ATON_RT_Scheduler_t *sched, LL_ATON_RT_Sched_Job_t *job,
+                              NN_Instance_TypeDef *nn_instance, LL_ATON_RT_Sched_Priority_t priority,
+                              LL_ATON_RT_Sched_Done_FuncPtr_t done_callback, void *user_data)
+{
+  uint32_t cs_state;
+
+  LL_ATON_ASSERT((sched != NULL) && (job != NULL) && (nn_instance != NULL));
+  LL_ATON_ASSERT(priority < LL_ATON_RT_SCHED_NB_PRIOS);
+
+  memset(job, 0, sizeof(*job));
+  job->nn_instance = nn_instance;
+  job->priority = priority;
+  job->done_callback = done_callback;
+  job->user_data = user_data;
+  job->state = LL_ATON_RT_SCHED_JOB_IDLE;
+
+  LL_ATON_RT_SCHED_ENTER_CS(cs_state);
+  job->next = sched->jobs;
+  sched->jobs = job;
+  LL_ATON_RT_SCHED_EXIT_CS(cs_state);
+}
+
+bool LL_ATON_RT_Sched_Remove_Job(LL_ATON_RT_Scheduler_t *sched, LL_ATON_RT_Sched_Job_t *job)
+{
+  bool removed = false;
+  uint32_t cs_state;
+
+  LL_ATON_ASSERT((sched != NULL) && (job != NULL));
+
+  LL_ATON_RT_SCHED_ENTER_CS(cs_state);
+  if (job->state == LL_ATON_RT_SCHED_JOB_IDLE)
+  {
+    for (LL_ATON_RT_Sched_Job_t **link = &sched->jobs; *link != NULL; link = &(*link)->next)
+    {
+      if (*link == job)
+      {
+        *link = job->next;
+        job->next = NULL;
+        removed = true;
+        break;
+      }
+    }
+  }
+  LL_ATON_RT_SCHED_EXIT_CS(cs_state);
+
+  return removed;
+}
+
+bool LL_ATON_RT_Sched_Submit(LL_ATON_RT_Scheduler_t *sched, LL_ATON_RT_Sched_Job_t *job, uint64_t deadline_ns)
+{
+  uint64_t now = __LL_ATON_RT_Sched_Now(sched);
+  uint32_t cs_state;
+
+  LL_ATON_ASSERT((sched != NULL) && (job != NULL));
+
+  LL_ATON_RT_SCHED_ENTER_CS(cs_state);
+  if (job->state != LL_ATON_RT_SCHED_JOB_IDLE)
+  {
+    LL_ATON_RT_SCHED_EXIT_CS(cs_state);
+    return false;
+  }
+  job->deadline_ns = deadline_ns;
+  job->submit_ns = now;
+  job->seq = sched->next_seq++;
+  job->nr_of_epoch_blocks = 0;
+  job->state = LL_ATON_RT_SCHED_JOB_QUEUED;
+  LL_ATON_RT_SCHED_EXIT_CS(cs_state);
+
+  /* Wake up the scheduler thread in case it is waiting in `LL_ATON_OSAL_WFE()` */
+  LL_ATON_OSAL_SIGNAL_EVENT();
+
+  return true;
+}
+
+LL_ATON_RT_RetValues_t LL_ATON_RT_Sched_Run(LL_ATON_RT_Scheduler_t *sched)
+{
+  LL_ATON_ASSERT(sched != NULL);
+
+  LL_ATON_RT_Sched_Job_t *job = sched->current;
+
+  /* In between two epoch blocks (ATON IP released, or lent to the DMA copy service) the most urgent job may take
+   * over */
+  if ((job == NULL) || (__ll_current_aton_ip_owner != job->nn_instance))
+  {
+    LL_ATON_RT_Sched_Job_t *next = __LL_ATON_RT_Sched_Select(sched);
+
+    if ((job != NULL) && (next != job))
+    {
+      sched->stats[job->priority].nb_preempted++;
+    }
+    job = next;
+    sched->current = job;
+
+    if (job == NULL)
+    {
+      return LL_ATON_RT_WFE;
+    }
+  }
+
+  job->state = LL_ATON_RT_SCHED_JOB_RUNNING;
+
+  LL_ATON_RT_RetValues_t ret = LL_ATON_RT_RunEpochBlock(job->nn_instance);
+
+  switch (ret)
+  {
+  case LL_ATON_RT_NO_WFE:
+    job->nr_of_epoch_blocks++;
+    break;
+  case LL_ATON_RT_WFE:
+    break;
+  case LL_ATON_RT_DONE:
+    __LL_ATON_RT_Sched_Complete(sched, job);
+    break;
+  default:
+    LL_ATON_ASSERT(false);
+    break;
+  }
+
+  return ret;
+}
+
+void LL_ATON_RT_Sched_Get_Stats(LL_ATON_RT_Scheduler_t *sched, LL_ATON_RT_Sched_Priority_t priority,
+                                LL_ATON_RT_Sched_Stats_t *stats, bool reset)
+{
+  LL_ATON_ASSERT((sched != NULL) && (stats != NULL));
+  LL_ATON_ASSERT(priority < LL_ATON_RT_SCHED_NB_PRIOS);
+
+  *stats = sched->stats[priority];
+  if (reset)
+  {
+    memset(&sched->stats[priority], 0, sizeof(sched->stats[priority]));
+  }
+}
@@ -0,0 +1,179 @@
+/**
+ ******************************************************************************
+ * @file    ll_aton_rt_scheduler.h
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   Header file of ATON LL runtime scheduler.
+ * @note    Interleaves several network instances on the NPU at epoch block granularity
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef __LL_ATON_RT_SCHEDULER_H
+#define __LL_ATON_RT_SCHEDULER_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ll_aton_rt_user_api.h"
+
+  /**
+   * @brief Critical section protecting the job list against concurrent `LL_ATON_RT_Sched_Submit()` calls
+   * @note  `LL_ATON_OSAL_ENTER_CS()` only masks the ATON interrupt, which is not enough when jobs get submitted from
+   *        other threads or from interrupt handlers, hence the default masks all interrupts.
+   *        May be overridden by the user (e.g. with `TX_DISABLE`/`TX_RESTORE`).
+   */
+#ifndef LL_ATON_RT_SCHED_ENTER_CS
+#ifdef __ARM_ARCH
+#include <cmsis_compiler.h>
+#define LL_ATON_RT_SCHED_ENTER_CS(_state)                                                                              \
+  do                                                                                                                   \
+  {                                                                                                                    \
+    (_state) = __get_PRIMASK();                                                                                        \
+    __disable_irq();                                                                                                   \
+  } while (0)
+#define LL_ATON_RT_SCHED_EXIT_CS(_state) __set_PRIMASK(_state)
+#else
+#define LL_ATON_RT_SCHED_ENTER_CS(_state) ((void)(_state))
+#define LL_ATON_RT_SCHED_EXIT_CS(_state)  ((void)(_state))
+#endif // __ARM_ARCH
+#endif // LL_ATON_RT_SCHED_ENTER_CS
+
+  /**
+   * @brief Priority classes, a queued job of a higher class always runs before any job of a lower class
+   */
+  typedef enum
+  {
+    LL_ATON_RT_SCHED_PRIO_REALTIME = 0,
+    LL_ATON_RT_SCHED_PRIO_HIGH,
+    LL_ATON_RT_SCHED_PRIO_NORMAL,
+    LL_ATON_RT_SCHED_PRIO_BACKGROUND,
+    LL_ATON_RT_SCHED_NB_PRIOS,
+  } LL_ATON_RT_Sched_Priority_t;
+
+  typedef enum
+  {
+    LL_ATON_RT_SCHED_JOB_IDLE = 0, /**< Registered, no inference requested */
+    LL_ATON_RT_SCHED_JOB_QUEUED,   /**< Inference requested, not started yet */
+    LL_ATON_RT_SCHED_JOB_RUNNING,  /**< Inference started (possibly preempted in between two epoch blocks) */
+  } LL_ATON_RT_Sched_Job_State_t;
+
+  struct LL_ATON_RT_Sched_Job;
+
+  /**
+   * @brief Called from within `LL_ATON_RT_Sched_Run()` once the inference of a job is over
+   *        (the network instance has already been reset and the job may be submitted again)
+   */
+  typedef void (*LL_ATON_RT_Sched_Done_FuncPtr_t)(struct LL_ATON_RT_Sched_Job *job, void *user_data);
+
+  typedef struct LL_ATON_RT_Sched_Job
+  {
+    NN_Instance_TypeDef *nn_instance;
+    LL_ATON_RT_Sched_Priority_t priority;
+    LL_ATON_RT_Sched_Done_FuncPtr_t done_callback;
+    void *user_data;
+
+    /* Private */
+    volatile LL_ATON_RT_Sched_Job_State_t state;
+    uint64_t deadline_ns; /**< Absolute deadline, 0 if none */
+    uint64_t submit_ns;
+    uint32_t seq; /**< Submission order, used to serve jobs of the same class and deadline in FIFO order */
+    uint32_t nr_of_epoch_blocks;
+    struct LL_ATON_RT_Sched_Job *next;
+  } LL_ATON_RT_Sched_Job_t;
+
+  typedef struct
+  {
+    uint32_t nb_done;
+    uint32_t nb_deadline_missed;
+    uint32_t nb_preempted; /**< Switches away from a started inference of this class */
+    uint64_t latency_sum_ns;
+    uint64_t latency_max_ns;
+  } LL_ATON_RT_Sched_Stats_t;
+
+  typedef struct
+  {
+    LL_ATON_RT_Sched_Job_t *jobs;
+    LL_ATON_RT_Sched_Job_t *current; /**< Job whose epoch block ran last */
+    uint32_t next_seq;
+    uint64_t (*now_ns)(void);
+    LL_ATON_RT_Sched_Stats_t stats[LL_ATON_RT_SCHED_NB_PRIOS];
+  } LL_ATON_RT_Scheduler_t;
+
+  /**
+   * @brief Initialise a scheduler
+   * @param sched  Pointer to the scheduler
+   * @param now_ns Monotonic clock used for deadlines and latencies (may be `NULL`, then deadlines are ignored)
+   *
+   * @note  The ATON runtime must have been initialised with `LL_ATON_RT_RuntimeInit()`.
+   *        All network instances of the scheduler must be run exclusively through `LL_ATON_RT_Sched_Run()`,
+   *        called from a single thread.
+   */
+  void LL_ATON_RT_Sched_Init(LL_ATON_RT_Scheduler_t *sched, uint64_t (*now_ns)(void));
+
+  /**
+   * @brief Register a job running an already initialised network instance (see `LL_ATON_RT_Init_Network()`)
+   * @param sched         Pointer to the scheduler
+   * @param job           Pointer to the job (must stay valid until `LL_ATON_RT_Sched_Remove_Job()`)
+   * @param nn_instance   Network instance run by the job
+   * @param priority      Priority class of the job
+   * @param done_callback Completion callback (may be `NULL`)
+   * @param user_data     Passed to `done_callback`
+   */
+  void LL_ATON_RT_Sched_Add_Job(LL_ATON_RT_Scheduler_t *sched, LL_ATON_RT_Sched_Job_t *job,
+                                NN_Instance_TypeDef *nn_instance, LL_ATON_RT_Sched_Priority_t priority,
+                                LL_ATON_RT_Sched_Done_FuncPtr_t done_callback, void *user_data);
+
+  /**
+   * @brief Unregister an idle job
+   * @retval false if the job is queued or running
+   */
+  bool LL_ATON_RT_Sched_Remove_Job(LL_ATON_RT_Scheduler_t *sched, LL_ATON_RT_Sched_Job_t *job);
+
+  /**
+   * @brief Request one inference of a job (may be called from any thread)
+   * @param sched       Pointer to the scheduler
+   * @param job         Pointer to a registered job
+   * @param deadline_ns Absolute deadline on the `now_ns` clock, 0 if none.
+   *                    Within a priority class the earliest deadline runs first.
+   * @retval false if the previous inference of the job is not over yet
+   */
+  bool LL_ATON_RT_Sched_Submit(LL_ATON_RT_Scheduler_t *sched, LL_ATON_RT_Sched_Job_t *job, uint64_t deadline_ns);
+
+  /**
+   * @brief  Runs one epoch block of the most urgent job.
+   *         Switching to another job only happens in between two epoch blocks while no network instance owns the
+   *         ATON IP, i.e. never in the middle of a hybrid epoch block or of an inserted ATON lib epoch block array.
+   * @param  sched Pointer to the scheduler
+   * @retval LL_ATON_RT_NO_WFE Call again
+   * @retval LL_ATON_RT_WFE    NPU busy or no job queued, the caller may call `LL_ATON_OSAL_WFE()`
+   *                           (`LL_ATON_RT_Sched_Submit()` signals an event)
+   * @retval LL_ATON_RT_DONE   A job just completed and its callback has been called, call again
+   */
+  LL_ATON_RT_RetValues_t LL_ATON_RT_Sched_Run(LL_ATON_RT_Scheduler_t *sched);
+
+  /**
+   * @brief Copy the statistics of a priority class
+   * @param reset Clear the statistics afterwards
+   */
+  void LL_ATON_RT_Sched_Get_Stats(LL_ATON_RT_Scheduler_t *sched, LL_ATON_RT_Sched_Priority_t priority,
+                                  LL_ATON_RT_Sched_Stats_t *stats, bool reset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __LL_ATON_RT_SCHEDULER_H
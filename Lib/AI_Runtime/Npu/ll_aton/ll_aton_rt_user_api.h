@@ -241,6 +241,20 @@ extern "C"
    */
   static inline const LL_Buffer_InfoTypeDef *LL_ATON_Internal_Buffers_Info(const NN_Instance_TypeDef *nn_instance);
 
+  /**
+   * @brief  Returns the index of the output buffer signalled by a `LL_ATON_RT_Callbacktype_OUTPUT_READY` event
+   * @param  nn_instance pointer to the network instance
+   * @retval zero based index of the output buffer which is ready
+   *
+   * @note   Only meaningful from within the epoch callback handling `LL_ATON_RT_Callbacktype_OUTPUT_READY`.
+   *         The output buffer has been written by the NPU, but cache maintenance (i.e. invalidation of the
+   *         corresponding MCU cache lines) is still up to the user before reading it.
+   *         The callback is executed from within `LL_ATON_RT_RunEpochBlock()`, processing the buffer should rather
+   *         be deferred to the point where `LL_ATON_RT_RunEpochBlock()` returns `LL_ATON_RT_WFE`, so that it overlaps
+   *         with the execution of the following epochs.
+   */
+  static inline uint32_t LL_ATON_RT_Get_Ready_Output(const NN_Instance_TypeDef *nn_instance);
+
   /**
    * @brief De-initialise a network instance
    * @param nn_instance Pointer to network instance to de-initialize
@@ -307,6 +321,12 @@ extern "C"
     return nn_instance->network->internal_buffers_info();
   }
 
+  static inline uint32_t LL_ATON_RT_Get_Ready_Output(const NN_Instance_TypeDef *nn_instance)
+  {
+    assert(nn_instance != NULL);
+    return nn_instance->exec_state.ready_output;
+  }
+
   /**
    * @}
    */
@@ -31,6 +31,14 @@
 #include "ll_aton_reloc_network.h"
 #endif
 
+#if (LL_ATON_DMA_COPY == 1)
+#include "ll_aton_dma_copy.h"
+#endif
+
+#if (LL_ATON_CACHE_BATCH == 1)
+#include "ll_aton_cache_batch.h"
+#endif
+
 /*** ATON RT Variables ***/
 
 /* Check if current runtime is prepared for underlying ATON IP instance */
@@ -99,6 +107,12 @@ static inline void __LL_ATON_RT_ExecStartEpochBlock(const LL_ATON_RT_EpochBlockI
   if (nn_instance->exec_state.epoch_callback_function != NULL)
     nn_instance->exec_state.epoch_callback_function(LL_ATON_RT_Callbacktype_PRE_START, nn_instance, eb);
 
+#if defined(LL_ATON_RT_RELOC)
+  /* Make sure the weights of a staged relocatable model are in place */
+  if (nn_instance->exec_state.inst_pager != 0)
+    ai_rel_network_page_in(nn_instance->exec_state.inst_pager, nn_instance->exec_state.first_epoch_block, eb);
+#endif
+
   /* Is it the first epoch block in an AtoNN epoch? */
   if (EpochBlock_IsEpochStart(eb))
   {
@@ -109,7 +123,12 @@ static inline void __LL_ATON_RT_ExecStartEpochBlock(const LL_ATON_RT_EpochBlockI
   if (EpochBlock_IsEpochPureHW(eb) ||
       EpochBlock_IsEpochHybrid(eb)) // epoch blobs are flagged as pure HW, so checking for epoch blob is not necessary
   {
+#if (LL_ATON_DMA_COPY == 1)
+    /* Already claimed by `LL_ATON_RT_RunEpochBlock()` (see `__ll_try_set_aton_owner()`) */
+    LL_ATON_ASSERT(__ll_current_aton_ip_owner == nn_instance);
+#else  // (LL_ATON_DMA_COPY == 0)
     __ll_set_aton_owner(nn_instance);
+#endif // (LL_ATON_DMA_COPY == 0)
   }
 
   if (!EpochBlock_IsEpochBlob(eb))
@@ -141,6 +160,13 @@ static inline void __LL_ATON_RT_ExecStartEpochBlock(const LL_ATON_RT_EpochBlockI
 
   if (eb->start_epoch_block != NULL)
   {
+#if (LL_ATON_CACHE_BATCH == 1)
+    /* SW epoch blocks do not start the ATON IP, their cache cleans are issued once they are over */
+    const bool cache_batch = EpochBlock_IsEpochPureSW(eb);
+    if (cache_batch)
+      LL_ATON_Cache_Batch_Begin();
+#endif
+
     /* start epoch block */
 #if defined(LL_ATON_RT_RELOC)
     if (nn_instance->exec_state.inst_reloc != 0)
@@ -154,6 +180,11 @@ static inline void __LL_ATON_RT_ExecStartEpochBlock(const LL_ATON_RT_EpochBlockI
 #else
     eb->start_epoch_block((const void *)eb);
 #endif
+
+#if (LL_ATON_CACHE_BATCH == 1)
+    if (cache_batch)
+      LL_ATON_Cache_Batch_End();
+#endif
   }
 
   if (EpochBlock_IsEpochBlob(eb))
@@ -176,10 +207,110 @@ static inline void __LL_ATON_RT_ExecStartEpochBlock(const LL_ATON_RT_EpochBlockI
 #endif // !ATON_EPOCHCTRL_NUM
   }
 
+#if defined(LL_ATON_RT_RELOC)
+  /* Page in the weights of the next epoch block while this one executes */
+  if (nn_instance->exec_state.inst_pager != 0)
+    ai_rel_network_page_ahead(nn_instance->exec_state.inst_pager, nn_instance->exec_state.first_epoch_block, eb);
+#endif
+
   if (nn_instance->exec_state.epoch_callback_function != NULL)
     nn_instance->exec_state.epoch_callback_function(LL_ATON_RT_Callbacktype_POST_START, nn_instance, eb);
 }
 
+static inline const LL_Buffer_InfoTypeDef *__LL_ATON_RT_GetOutputBuffersInfo(NN_Instance_TypeDef *nn_instance)
+{
+#if defined(LL_ATON_RT_RELOC)
+  if (nn_instance->exec_state.inst_reloc != 0)
+  {
+    return ai_rel_network_get_output_buffers_info(nn_instance->exec_state.inst_reloc);
+  }
+#endif
+  return nn_instance->network->output_buffers_info();
+}
+
+static inline void __LL_ATON_RT_ResetReadyOutputs(NN_Instance_TypeDef *nn_instance)
+{
+  nn_instance->exec_state.nr_of_epochs_done = 0;
+  nn_instance->exec_state.epochs_count_lost = false;
+  nn_instance->exec_state.ready_outputs = 0;
+  nn_instance->exec_state.ready_output = 0;
+}
+
+/* Calls the epoch callback with `LL_ATON_RT_Callbacktype_OUTPUT_READY` for each output buffer whose producing epoch
+ * has ended. With `flush` set (i.e. end of inference) all not yet signalled output buffers are signalled. */
+static void __LL_ATON_RT_SignalReadyOutputs(const LL_ATON_RT_EpochBlockItem_t *eb, NN_Instance_TypeDef *nn_instance,
+                                            bool flush)
+{
+  int32_t last_epoch_done = INT32_MAX;
+
+  if (nn_instance->exec_state.epoch_callback_function == NULL)
+  {
+    return;
+  }
+
+  if (!flush)
+  {
+    /* Epoch blocks of an inserted array and hybrid epochs whose SW part is pending do not end an epoch */
+    if ((nn_instance->exec_state.saved_current_epoch_block != NULL) ||
+        (nn_instance->exec_state.next_epoch_block != NULL))
+    {
+      return;
+    }
+
+#ifdef LL_ATON_EB_DBG_INFO
+    /* An epoch block which does not end its epoch (e.g. HW part followed by a SW epoch block) only completes the
+     * epochs before its own */
+    if (EpochBlock_IsEpochEnd(eb) || EpochBlock_IsEpochBlob(eb))
+    {
+      last_epoch_done = eb->last_epoch_num;
+    }
+    else
+    {
+      last_epoch_done = eb->epoch_num - 1;
+    }
+#else  // !LL_ATON_EB_DBG_INFO
+    if (EpochBlock_IsEpochBlob(eb))
+    { // the number of epochs within a blob is only known with `LL_ATON_EB_DBG_INFO`
+      nn_instance->exec_state.epochs_count_lost = true;
+    }
+    else if (EpochBlock_IsEpochEnd(eb))
+    {
+      nn_instance->exec_state.nr_of_epochs_done++;
+    }
+    if (nn_instance->exec_state.epochs_count_lost)
+    { // outputs will be signalled at the end of the inference
+      return;
+    }
+    /* Whether epochs are numbered from 0 or 1 is not known here, stay one epoch on the safe side */
+    last_epoch_done = (int32_t)nn_instance->exec_state.nr_of_epochs_done - 1;
+#endif // !LL_ATON_EB_DBG_INFO
+  }
+
+  const LL_Buffer_InfoTypeDef *buf = __LL_ATON_RT_GetOutputBuffersInfo(nn_instance);
+  if (buf == NULL)
+  {
+    return;
+  }
+
+  for (uint32_t num = 0; (buf->name != NULL) && (num < 32); buf++)
+  {
+    if (buf->is_param)
+    {
+      continue;
+    }
+
+    /* `epoch` is the last epoch writing the buffer (numbered as `EpochBlock_ItemTypeDef.epoch_num`), set by the code
+     * generator in the output buffers info: the buffer is complete once this epoch has ended */
+    if (((nn_instance->exec_state.ready_outputs & (1u << num)) == 0) && ((int32_t)buf->epoch <= last_epoch_done))
+    {
+      nn_instance->exec_state.ready_outputs |= (1u << num);
+      nn_instance->exec_state.ready_output = num;
+      nn_instance->exec_state.epoch_callback_function(LL_ATON_RT_Callbacktype_OUTPUT_READY, nn_instance, eb);
+    }
+    num++;
+  }
+}
+
 static inline void __LL_ATON_RT_ExecEndEpochBlock(const LL_ATON_RT_EpochBlockItem_t *eb,
                                                   NN_Instance_TypeDef *nn_instance)
 {
@@ -204,6 +335,10 @@ static inline void __LL_ATON_RT_ExecEndEpochBlock(const LL_ATON_RT_EpochBlockIte
 
   if (eb->end_epoch_block != NULL)
   {
+#if (LL_ATON_CACHE_BATCH == 1)
+    LL_ATON_Cache_Batch_Begin();
+#endif
+
 #if defined(LL_ATON_RT_RELOC)
     if (nn_instance->exec_state.inst_reloc != 0)
     {
@@ -216,6 +351,10 @@ static inline void __LL_ATON_RT_ExecEndEpochBlock(const LL_ATON_RT_EpochBlockIte
 #else
     eb->end_epoch_block((const void *)eb);
 #endif
+
+#if (LL_ATON_CACHE_BATCH == 1)
+    LL_ATON_Cache_Batch_End();
+#endif
   }
 
   /* Reset wait mask */
@@ -241,6 +380,8 @@ static inline void __LL_ATON_RT_ExecEndEpochBlock(const LL_ATON_RT_EpochBlockIte
   {
     nn_instance->exec_state.epoch_callback_function(LL_ATON_RT_Callbacktype_POST_END, nn_instance, eb);
   }
+
+  __LL_ATON_RT_SignalReadyOutputs(eb, nn_instance, false);
 }
 
 static void __LL_ATON_RT_DetermineNextEpochBlock(NN_Instance_TypeDef *nn_instance)
@@ -341,6 +482,7 @@ static inline void __LL_ATON_RT_Init_Network(NN_Instance_TypeDef *nn_instance)
 
   /* set information about running inference */
   nn_instance->exec_state.inference_started = false;
+  __LL_ATON_RT_ResetReadyOutputs(nn_instance);
 
   /* set asynchronous status variables */
 #if (LL_ATON_RT_MODE == LL_ATON_RT_ASYNC)
@@ -612,6 +754,7 @@ LL_ATON_RT_RetValues_t LL_ATON_RT_RunEpochBlock(NN_Instance_TypeDef *nn_instance
 
     /* Set inference started flag to `true` */
     nn_instance->exec_state.inference_started = true;
+    __LL_ATON_RT_ResetReadyOutputs(nn_instance);
 
     /* Placeholder for things which need to be done before starting an inference */
     /* ==> here <== */
@@ -672,6 +815,9 @@ LL_ATON_RT_RetValues_t LL_ATON_RT_RunEpochBlock(NN_Instance_TypeDef *nn_instance
       }
       else
       {
+        /* Signal output buffers not signalled yet */
+        __LL_ATON_RT_SignalReadyOutputs(nn_instance->exec_state.current_epoch_block, nn_instance, true);
+
         /* Reached end of execution */
         return LL_ATON_RT_DONE;
       }
@@ -687,6 +833,16 @@ LL_ATON_RT_RetValues_t LL_ATON_RT_RunEpochBlock(NN_Instance_TypeDef *nn_instance
 
     if (!nn_instance->exec_state.current_epoch_block_started)
     {
+#if (LL_ATON_DMA_COPY == 1)
+      /* Grab the ATON IP before the epoch block callbacks, atomically with the check of the DMA copy service.
+         If the IP is lent to the service: wait for the end of the running copy */
+      const LL_ATON_RT_EpochBlockItem_t *eb = nn_instance->exec_state.current_epoch_block;
+      if ((EpochBlock_IsEpochPureHW(eb) || EpochBlock_IsEpochHybrid(eb)) && !__ll_try_set_aton_owner(nn_instance))
+      {
+        return LL_ATON_RT_WFE;
+      }
+#endif // (LL_ATON_DMA_COPY == 1)
+
       nn_instance->exec_state.current_epoch_block_started = true;
 
       __LL_ATON_RT_ExecStartEpochBlock(nn_instance->exec_state.current_epoch_block, nn_instance);
@@ -1016,6 +1172,14 @@ void ATON_STD_IRQHandler(void)
   /* Data Synchronization Barrier */
   LL_ATON_OSAL_DSB();
 
+#if (LL_ATON_DMA_COPY == 1)
+  /* End of a DMA copy: start the next one or give the ATON IP back */
+  if (__ll_current_aton_ip_owner == &__ll_dma_copy_instance)
+  {
+    __LL_ATON_DmaCopy_IrqHandler();
+  }
+#endif // (LL_ATON_DMA_COPY == 1)
+
   /* Signal event */
   LL_ATON_OSAL_SIGNAL_EVENT();
 
@@ -51,6 +51,26 @@ extern "C"
     __ll_current_aton_ip_owner = new_owner;
   }
 
+#if (LL_ATON_DMA_COPY == 1)
+  /* Replaces `__ll_set_aton_owner()` when the DMA copy service is enabled: the IP is claimed in the same critical
+   * section as the check of the service, which could otherwise take it in between (copies may be submitted from
+   * interrupt handlers). Returns false, and asks the service to give the IP back, if the IP is lent to the service */
+  static inline bool __ll_try_set_aton_owner(NN_Instance_TypeDef *new_owner)
+  {
+    extern bool __LL_ATON_DmaCopy_TryAcquire(NN_Instance_TypeDef * new_owner);
+
+    LL_ATON_OSAL_LOCK_ATON();
+
+    if (!__LL_ATON_DmaCopy_TryAcquire(new_owner))
+    {
+      LL_ATON_OSAL_UNLOCK_ATON();
+      return false;
+    }
+
+    return true;
+  }
+#endif // (LL_ATON_DMA_COPY == 1)
+
   static inline void __ll_clear_aton_owner(NN_Instance_TypeDef *current_owner)
   {
     extern NN_Instance_TypeDef *volatile __ll_current_aton_ip_owner;
@@ -63,6 +83,12 @@ extern "C"
 
     __ll_current_aton_ip_owner = NULL;
     LL_ATON_OSAL_UNLOCK_ATON();
+
+#if (LL_ATON_DMA_COPY == 1)
+    /* Resume queued DMA copies in between two epoch blocks */
+    extern void __LL_ATON_DmaCopy_Kick(void);
+    __LL_ATON_DmaCopy_Kick();
+#endif // (LL_ATON_DMA_COPY == 1)
   }
 
   /**
@@ -591,6 +591,18 @@ extern "C"
     Tensor_info ozp;
   } Requantizelinear_sw_info;
 
+  // ############################ ############################ ###########################
+  // ############################          PROFILING           ###########################
+  // ############################ ############################ ###########################
+
+  /**
+   * @brief `NodeType` of the node last run by a `ll_sw_forward_*()` function (-1 before the first one).
+   *        Lets epoch callbacks attribute the time of SW fallback epoch blocks to operators.
+   */
+  extern volatile int32_t ll_sw_last_node_type;
+
+#define LL_SW_TRACE_NODE(sw_info_struct) (ll_sw_last_node_type = (int32_t)((const General *)(sw_info_struct))->type)
+
 #ifdef __cplusplus
 }
 #endif
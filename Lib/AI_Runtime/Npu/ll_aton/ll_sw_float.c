@@ -26,6 +26,7 @@
 
 #include "ll_sw.h"
 #include "ll_sw_float.h"
+#include "ll_sw_kernels.h"
 
 #include "ai_datatypes_internal.h"
 #include "ai_math_helpers.h"
@@ -33,6 +34,8 @@
 #include "layers.h"
 #include "ll_aton_util.h"
 
+volatile int32_t ll_sw_last_node_type = -1;
+
 #define FORMAT AI_ARRAY_FORMAT_FLOAT
 
 #define SHAPE_INIT(a_, b_, c_, d_) AI_SHAPE_INIT(4, (d_), (c_), (b_), (a_))
@@ -68,6 +71,7 @@ static int helper_emit_shape_index_axis(int onnx_axis)
 /** Conv forward function */
 void ll_sw_forward_conv(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Conv_sw_info *sw_info = (Conv_sw_info *)sw_info_struct;
   // array init
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
@@ -145,6 +149,7 @@ void ll_sw_forward_conv(/* int processor, */ void *sw_info_struct)
 /** GEMM forward function */
 void ll_sw_forward_gemm(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Gemm_sw_info *sw_info = (Gemm_sw_info *)sw_info_struct;
   // array init
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
@@ -200,6 +205,7 @@ void ll_sw_forward_gemm(/* int processor, */ void *sw_info_struct)
 /** MatMul forward function */
 void ll_sw_forward_matmul(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Matmul_sw_info *sw_info = (Matmul_sw_info *)sw_info_struct;
   // array init
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
@@ -244,6 +250,7 @@ void ll_sw_forward_matmul(/* int processor, */ void *sw_info_struct)
 /** Resize forward function */
 void ll_sw_forward_resize(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Resize_sw_info *sw_info = (Resize_sw_info *)sw_info_struct;
   // array init
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
@@ -317,6 +324,7 @@ void ll_sw_forward_resize(/* int processor, */ void *sw_info_struct)
 /** Softmax forward function */
 void ll_sw_forward_softmax(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Softmax_sw_info *sw_info = (Softmax_sw_info *)sw_info_struct;
 
   // array init
@@ -368,6 +376,7 @@ void ll_sw_forward_softmax(/* int processor, */ void *sw_info_struct)
 /** activ forward function  */
 void ll_sw_forward_activ(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Activ_sw_info *sw_info = (Activ_sw_info *)sw_info_struct;
   // array init
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
@@ -681,6 +690,7 @@ void ll_sw_forward_activ(/* int processor, */ void *sw_info_struct)
 /** activ forward function  */
 void ll_sw_forward_arith(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Arith_sw_info *sw_info = (Arith_sw_info *)sw_info_struct;
   // array init
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
@@ -841,6 +851,7 @@ void ll_sw_forward_arith(/* int processor, */ void *sw_info_struct)
 /** pool forward function  */
 void ll_sw_forward_pool(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Pool_sw_info *sw_info = (Pool_sw_info *)sw_info_struct;
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
                        sw_info->general.input.mem.start_offset, sw_info->general.input.dim.num_elem, )
@@ -891,7 +902,12 @@ void ll_sw_forward_pool(/* int processor, */ void *sw_info_struct)
 /** Globalpool forward function  */
 void ll_sw_forward_global_pool(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Global_pool_sw_info *sw_info = (Global_pool_sw_info *)sw_info_struct;
+#if LL_SW_NATIVE_KERNELS == 1
+  if (ll_sw_kernel_global_pool(sw_info))
+    return;
+#endif
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
                        sw_info->general.input.mem.start_offset, sw_info->general.input.dim.num_elem, )
   AI_ARRAY_OBJ_DECLARE(pool_output_array, FORMAT, sw_info->general.output.mem.start_offset,
@@ -938,6 +954,7 @@ void ll_sw_forward_global_pool(/* int processor, */ void *sw_info_struct)
 /** ArgMax forward function  */
 void ll_sw_forward_argmax(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Argmax_sw_info *sw_info = (Argmax_sw_info *)sw_info_struct;
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
                        sw_info->general.input.mem.start_offset, sw_info->general.input.dim.num_elem, )
@@ -971,6 +988,7 @@ void ll_sw_forward_argmax(/* int processor, */ void *sw_info_struct)
 /** Gather forward function  */
 void ll_sw_forward_gather(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Gather_sw_info *sw_info = (Gather_sw_info *)sw_info_struct;
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
                        sw_info->general.input.mem.start_offset, sw_info->general.input.dim.num_elem, )
@@ -1014,6 +1032,7 @@ void ll_sw_forward_gather(/* int processor, */ void *sw_info_struct)
 /** ArgMin forward function  */
 void ll_sw_forward_argmin(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Argmin_sw_info *sw_info = (Argmin_sw_info *)sw_info_struct;
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
                        sw_info->general.input.mem.start_offset, sw_info->general.input.dim.num_elem, )
@@ -1047,6 +1066,7 @@ void ll_sw_forward_argmin(/* int processor, */ void *sw_info_struct)
 /** Reduce forward function  */
 void ll_sw_forward_reduce(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Reduce_sw_info *sw_info = (Reduce_sw_info *)sw_info_struct;
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
                        sw_info->general.input.mem.start_offset, sw_info->general.input.dim.num_elem, )
@@ -1123,6 +1143,7 @@ void ll_sw_forward_reduce(/* int processor, */ void *sw_info_struct)
 /** Batch Norm forward function  */
 void ll_sw_forward_bn(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Bn_sw_info *sw_info = (Bn_sw_info *)sw_info_struct;
 
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
@@ -1211,6 +1232,7 @@ void ll_sw_forward_bn(/* int processor, */ void *sw_info_struct)
 /** Instance Norm forward function  */
 void ll_sw_forward_instance_normalization(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Instance_normalization_sw_info *sw_info = (Instance_normalization_sw_info *)sw_info_struct;
 
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
@@ -1265,6 +1287,7 @@ void ll_sw_forward_instance_normalization(/* int processor, */ void *sw_info_str
 /** Lp Norm forward function  */
 void ll_sw_forward_lpnormalization(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Lpnormalization_sw_info *sw_info = (Lpnormalization_sw_info *)sw_info_struct;
 
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
@@ -1301,6 +1324,7 @@ void ll_sw_forward_lpnormalization(/* int processor, */ void *sw_info_struct)
 /** Sign forward function  */
 void ll_sw_forward_sign(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Sign_sw_info *sw_info = (Sign_sw_info *)sw_info_struct;
 
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
@@ -1336,6 +1360,7 @@ void ll_sw_forward_sign(/* int processor, */ void *sw_info_struct)
 /** LRN Local Response Normalization forward function  */
 void ll_sw_forward_lrn(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Lrn_sw_info *sw_info = (Lrn_sw_info *)sw_info_struct;
 
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
@@ -1377,6 +1402,7 @@ void ll_sw_forward_lrn(/* int processor, */ void *sw_info_struct)
 /** Tile forward function  */
 void ll_sw_forward_tile(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Tile_sw_info *sw_info = (Tile_sw_info *)sw_info_struct;
 
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
@@ -1417,6 +1443,7 @@ void ll_sw_forward_tile(/* int processor, */ void *sw_info_struct)
 /** concat forward function  */
 void ll_sw_forward_concat(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Concat_sw_info *sw_info = (Concat_sw_info *)sw_info_struct;
 
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
@@ -25,6 +25,7 @@
 
 #include "ll_sw.h"
 #include "ll_sw_integer.h"
+#include "ll_sw_kernels.h"
 
 #include "ai_datatypes_internal.h"
 #include "ai_math_helpers.h"
@@ -66,6 +67,7 @@ static int helper_emit_shape_index_axis(int onnx_axis)
 /** QLinearMatMul forward function */
 void ll_sw_forward_qlinearmatmul(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Qlinearmatmul_sw_info *sw_info = (Qlinearmatmul_sw_info *)sw_info_struct;
 
   /*
@@ -181,6 +183,7 @@ void ll_sw_forward_qlinearmatmul(/* int processor, */ void *sw_info_struct)
 /** QLinearMatMul forward function */
 void ll_sw_forward_gemm_integer(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Gemm_integer_sw_info *sw_info = (Gemm_integer_sw_info *)sw_info_struct;
 
   /*
@@ -292,7 +295,12 @@ void ll_sw_forward_gemm_integer(/* int processor, */ void *sw_info_struct)
 /** QuantizeLinear forward function */
 void ll_sw_forward_quantizelinear(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Quantizelinear_sw_info *sw_info = (Quantizelinear_sw_info *)sw_info_struct;
+#if LL_SW_NATIVE_KERNELS == 1
+  if (ll_sw_kernel_quantizelinear(sw_info))
+    return;
+#endif
 
   // array init
   AI_ARRAY_OBJ_DECLARE(input_output_array, AI_ARRAY_FORMAT_FLOAT, sw_info->general.input.mem.start_offset,
@@ -339,7 +347,12 @@ void ll_sw_forward_quantizelinear(/* int processor, */ void *sw_info_struct)
 /** Dequantizelinear forward function */
 void ll_sw_forward_dequantizelinear(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Dequantizelinear_sw_info *sw_info = (Dequantizelinear_sw_info *)sw_info_struct;
+#if LL_SW_NATIVE_KERNELS == 1
+  if (ll_sw_kernel_dequantizelinear(sw_info))
+    return;
+#endif
 
   // array init
   int32_t format = sw_info->general.input.format.is_signed ? (AI_ARRAY_FORMAT_S8 | AI_FMT_FLAG_IS_IO)
@@ -388,7 +401,12 @@ void ll_sw_forward_dequantizelinear(/* int processor, */ void *sw_info_struct)
 /** QuantizeLinear forward function */
 void ll_sw_forward_requantizelinear(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Requantizelinear_sw_info *sw_info = (Requantizelinear_sw_info *)sw_info_struct;
+#if LL_SW_NATIVE_KERNELS == 1
+  if (ll_sw_kernel_requantizelinear(sw_info))
+    return;
+#endif
   // array init
   int32_t format = sw_info->general.input.format.is_signed ? (AI_ARRAY_FORMAT_S8 | AI_FMT_FLAG_IS_IO)
                                                            : (AI_ARRAY_FORMAT_U8 | AI_FMT_FLAG_IS_IO);
@@ -448,6 +466,7 @@ void ll_sw_forward_requantizelinear(/* int processor, */ void *sw_info_struct)
 /** Conv integer forward function */
 void ll_sw_forward_conv_integer(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Conv_integer_sw_info *sw_info = (Conv_integer_sw_info *)sw_info_struct;
 
   int32_t format;
@@ -631,7 +650,12 @@ void ll_sw_forward_conv_integer(/* int processor, */ void *sw_info_struct)
 /** Element Wise forward function */
 void ll_sw_forward_eltwise_integer(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Eltwise_integer_sw_info *sw_info = (Eltwise_integer_sw_info *)sw_info_struct;
+#if LL_SW_NATIVE_KERNELS == 1
+  if (ll_sw_kernel_eltwise_integer(sw_info))
+    return;
+#endif
 
   // array init
   int32_t format = sw_info->general.input.format.is_signed ? (AI_ARRAY_FORMAT_S8 | AI_FMT_FLAG_IS_IO)
@@ -752,6 +776,7 @@ void ll_sw_forward_eltwise_integer(/* int processor, */ void *sw_info_struct)
 /** Pool forward function */
 void ll_sw_forward_pool_integer(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Pool_integer_sw_info *sw_info = (Pool_integer_sw_info *)sw_info_struct;
 
   // array init
@@ -836,6 +861,7 @@ void ll_sw_forward_pool_integer(/* int processor, */ void *sw_info_struct)
 /** Pool forward function */
 void ll_sw_forward_global_pool_integer(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Global_pool_integer_sw_info *sw_info = (Global_pool_integer_sw_info *)sw_info_struct;
 
   // array init
@@ -918,6 +944,7 @@ void ll_sw_forward_global_pool_integer(/* int processor, */ void *sw_info_struct
 /** Softmax forward function */
 void ll_sw_forward_softmax_integer(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Softmax_integer_sw_info *sw_info = (Softmax_integer_sw_info *)sw_info_struct;
 
   // array init
@@ -992,6 +1019,7 @@ void ll_sw_forward_softmax_integer(/* int processor, */ void *sw_info_struct)
 /** Activ forward function */
 void ll_sw_forward_activ_integer(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Activ_integer_sw_info *sw_info = (Activ_integer_sw_info *)sw_info_struct;
 
   // array init
@@ -1130,6 +1158,7 @@ void ll_sw_forward_activ_integer(/* int processor, */ void *sw_info_struct)
 /** Resize forward function */
 void ll_sw_forward_resize_integer(/* int processor, */ void *sw_info_struct)
 {
+  LL_SW_TRACE_NODE(sw_info_struct);
   Resize_integer_sw_info *sw_info = (Resize_integer_sw_info *)sw_info_struct;
   // array init
 
@@ -0,0 +1,451 @@
+/**
+ ******************************************************************************
+ * @file    ll_sw_kernels.c
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   ll_sw native kernels.
+ * @note    Fast paths used by `ll_sw_forward_*()` instead of the generic network runtime layers whenever the
+ *          tensors are dense and quantized per tensor.
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include "ll_aton_config.h"
+
+#if LL_ATON_SW_FALLBACK == 1
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ll_sw_kernels.h"
+
+#if defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 2) && !defined(LL_SW_KERNELS_NO_MVE)
+#define LL_SW_KERNELS_MVEF
+#include <arm_mve.h>
+#endif
+
+/* Keeps float to int conversions defined, any value beyond is saturated anyway */
+#define LL_SW_KERNELS_ROUND_LIMIT (16777216.0f)
+
+typedef struct
+{
+  float scale;
+  int32_t zero_point;
+  bool is_signed;
+} ll_sw_kernel_quant_t;
+
+/* Per tensor quantization only. Zero point signedness follows the scale tensor format as for the generic layers */
+static bool ll_sw_kernel_get_quant(const Tensor_info *scale, const Tensor_info *zero_point, bool is_signed,
+                                   ll_sw_kernel_quant_t *quant)
+{
+  if ((scale->dim.num_elem != 1) || (zero_point->dim.num_elem != 1) || (scale->mem.start_offset == NULL) ||
+      (zero_point->mem.start_offset == NULL))
+  {
+    return false;
+  }
+
+  memcpy(&quant->scale, scale->mem.start_offset, sizeof(float));
+  quant->zero_point = scale->format.is_signed ? (int32_t) * (const int8_t *)zero_point->mem.start_offset
+                                              : (int32_t) * (const uint8_t *)zero_point->mem.start_offset;
+  quant->is_signed = is_signed;
+
+  return (quant->scale != 0.0f);
+}
+
+/* True if the tensor has no gap whatever the order of its dimensions in memory (strides are in bytes) */
+static bool ll_sw_kernel_is_dense(const Tensor_info *t, uint32_t elem_size)
+{
+  const uint32_t size[4] = {t->dim.tensor_b, t->dim.tensor_c, t->dim.tensor_h, t->dim.tensor_w};
+  const uint32_t stride[4] = {t->stride.b, t->stride.c, t->stride.h, t->stride.w};
+
+  if ((t->mem.start_offset == NULL) || (size[0] * size[1] * size[2] * size[3] != t->dim.num_elem))
+  {
+    return false;
+  }
+
+  for (int i = 0; i < 4; i++)
+  {
+    if (size[i] <= 1)
+      continue;
+
+    uint32_t expected = elem_size;
+    for (int j = 0; j < 4; j++)
+    {
+      if ((j == i) || (size[j] <= 1))
+        continue;
+      if (stride[j] == stride[i])
+        return false;
+      if (stride[j] < stride[i])
+        expected *= size[j];
+    }
+    if (stride[i] != expected)
+      return false;
+  }
+
+  return true;
+}
+
+/* True if both tensors are dense and element `i` of one matches element `i` of the other */
+static bool ll_sw_kernel_same_layout(const Tensor_info *a, uint32_t a_elem_size, const Tensor_info *b,
+                                     uint32_t b_elem_size)
+{
+  const uint32_t a_size[4] = {a->dim.tensor_b, a->dim.tensor_c, a->dim.tensor_h, a->dim.tensor_w};
+  const uint32_t b_size[4] = {b->dim.tensor_b, b->dim.tensor_c, b->dim.tensor_h, b->dim.tensor_w};
+  const uint32_t a_stride[4] = {a->stride.b, a->stride.c, a->stride.h, a->stride.w};
+  const uint32_t b_stride[4] = {b->stride.b, b->stride.c, b->stride.h, b->stride.w};
+
+  if (!ll_sw_kernel_is_dense(a, a_elem_size) || !ll_sw_kernel_is_dense(b, b_elem_size))
+  {
+    return false;
+  }
+
+  for (int i = 0; i < 4; i++)
+  {
+    if (a_size[i] != b_size[i])
+      return false;
+    if ((a_size[i] > 1) && (a_stride[i] / a_elem_size != b_stride[i] / b_elem_size))
+      return false;
+  }
+
+  return true;
+}
+
+static inline bool ll_sw_kernel_overlap(const void *a, uint32_t a_len, const void *b, uint32_t b_len)
+{
+  const uint8_t *pa = (const uint8_t *)a;
+  const uint8_t *pb = (const uint8_t *)b;
+
+  return (pa < pb + b_len) && (pb < pa + a_len);
+}
+
+#ifdef LL_SW_KERNELS_MVEF
+
+static inline int32x4_t ll_sw_kernel_load8(const void *p, bool is_signed, mve_pred16_t pred)
+{
+  return is_signed ? vldrbq_z_s32((const int8_t *)p, pred)
+                   : vreinterpretq_s32_u32(vldrbq_z_u32((const uint8_t *)p, pred));
+}
+
+/* Rounds half to even like QuantizeLinear and saturates to the 8-bit range */
+static inline void ll_sw_kernel_store8(void *p, float32x4_t v, int32_t zero_point, bool is_signed, mve_pred16_t pred)
+{
+  int32x4_t q = vaddq_n_s32(vcvtnq_s32_f32(v), zero_point);
+
+  q = vmaxq_s32(q, vdupq_n_s32(is_signed ? INT8_MIN : 0));
+  q = vminq_s32(q, vdupq_n_s32(is_signed ? INT8_MAX : UINT8_MAX));
+  vstrbq_p_s32((int8_t *)p, q, pred);
+}
+
+#else // !LL_SW_KERNELS_MVEF
+
+static inline int32_t ll_sw_kernel_load8(const void *p, bool is_signed)
+{
+  return is_signed ? (int32_t) * (const int8_t *)p : (int32_t) * (const uint8_t *)p;
+}
+
+static inline void ll_sw_kernel_store8(void *p, float v, int32_t zero_point, bool is_signed)
+{
+  v = fminf(fmaxf(v, -LL_SW_KERNELS_ROUND_LIMIT), LL_SW_KERNELS_ROUND_LIMIT);
+
+  int32_t q = (int32_t)lrintf(v) + zero_point;
+  int32_t q_min = is_signed ? INT8_MIN : 0;
+  int32_t q_max = is_signed ? INT8_MAX : UINT8_MAX;
+
+  q = (q < q_min) ? q_min : ((q > q_max) ? q_max : q);
+  if (is_signed)
+    *(int8_t *)p = (int8_t)q;
+  else
+    *(uint8_t *)p = (uint8_t)q;
+}
+
+#endif // !LL_SW_KERNELS_MVEF
+
+/** y = saturate(round(x / scale) + zero_point) */
+static void ll_sw_kernel_quantize(const float *pIn, uint8_t *pOut, uint32_t nb, const ll_sw_kernel_quant_t *out_q)
+{
+  const float inv_scale = 1.0f / out_q->scale;
+
+#ifdef LL_SW_KERNELS_MVEF
+  for (int32_t n = (int32_t)nb; n > 0; n -= 4, pIn += 4, pOut += 4)
+  {
+    mve_pred16_t pred = vctp32q(n);
+    float32x4_t v = vmulq_n_f32(vldrwq_z_f32(pIn, pred), inv_scale);
+    ll_sw_kernel_store8(pOut, v, out_q->zero_point, out_q->is_signed, pred);
+  }
+#else
+  for (uint32_t i = 0; i < nb; i++)
+  {
+    ll_sw_kernel_store8(&pOut[i], pIn[i] * inv_scale, out_q->zero_point, out_q->is_signed);
+  }
+#endif
+}
+
+/** y = (x - zero_point) * scale */
+static void ll_sw_kernel_dequantize(const uint8_t *pIn, float *pOut, uint32_t nb, const ll_sw_kernel_quant_t *in_q)
+{
+#ifdef LL_SW_KERNELS_MVEF
+  for (int32_t n = (int32_t)nb; n > 0; n -= 4, pIn += 4, pOut += 4)
+  {
+    mve_pred16_t pred = vctp32q(n);
+    int32x4_t v = vsubq_n_s32(ll_sw_kernel_load8(pIn, in_q->is_signed, pred), in_q->zero_point);
+    vstrwq_p_f32(pOut, vmulq_n_f32(vcvtq_f32_s32(v), in_q->scale), pred);
+  }
+#else
+  for (uint32_t i = 0; i < nb; i++)
+  {
+    pOut[i] = (float)(ll_sw_kernel_load8(&pIn[i], in_q->is_signed) - in_q->zero_point) * in_q->scale;
+  }
+#endif
+}
+
+/** y = saturate(round((x - in_zero_point) * in_scale / out_scale) + out_zero_point) */
+static void ll_sw_kernel_requantize(const uint8_t *pIn, uint8_t *pOut, uint32_t nb, const ll_sw_kernel_quant_t *in_q,
+                                    const ll_sw_kernel_quant_t *out_q)
+{
+  const float ratio = in_q->scale / out_q->scale;
+
+#ifdef LL_SW_KERNELS_MVEF
+  for (int32_t n = (int32_t)nb; n > 0; n -= 4, pIn += 4, pOut += 4)
+  {
+    mve_pred16_t pred = vctp32q(n);
+    int32x4_t v = vsubq_n_s32(ll_sw_kernel_load8(pIn, in_q->is_signed, pred), in_q->zero_point);
+    ll_sw_kernel_store8(pOut, vmulq_n_f32(vcvtq_f32_s32(v), ratio), out_q->zero_point, out_q->is_signed, pred);
+  }
+#else
+  for (uint32_t i = 0; i < nb; i++)
+  {
+    float v = (float)(ll_sw_kernel_load8(&pIn[i], in_q->is_signed) - in_q->zero_point) * ratio;
+    ll_sw_kernel_store8(&pOut[i], v, out_q->zero_point, out_q->is_signed);
+  }
+#endif
+}
+
+/** Add, subtract or multiply in the real domain then quantize the result */
+static void ll_sw_kernel_eltwise(NodeType type, const uint8_t *pA, const uint8_t *pB, uint8_t *pOut, uint32_t nb,
+                                 const ll_sw_kernel_quant_t *a_q, const ll_sw_kernel_quant_t *b_q,
+                                 const ll_sw_kernel_quant_t *out_q)
+{
+  const float inv_out_scale = 1.0f / out_q->scale;
+
+#ifdef LL_SW_KERNELS_MVEF
+  for (int32_t n = (int32_t)nb; n > 0; n -= 4, pA += 4, pB += 4, pOut += 4)
+  {
+    mve_pred16_t pred = vctp32q(n);
+    float32x4_t a =
+        vmulq_n_f32(vcvtq_f32_s32(vsubq_n_s32(ll_sw_kernel_load8(pA, a_q->is_signed, pred), a_q->zero_point)),
+                    a_q->scale);
+    float32x4_t b =
+        vmulq_n_f32(vcvtq_f32_s32(vsubq_n_s32(ll_sw_kernel_load8(pB, b_q->is_signed, pred), b_q->zero_point)),
+                    b_q->scale);
+    float32x4_t r = (type == LL_SW_ARITHMUL) ? vmulq_f32(a, b) : ((type == LL_SW_ARITHSUB) ? vsubq_f32(a, b)
+                                                                                         : vaddq_f32(a, b));
+    ll_sw_kernel_store8(pOut, vmulq_n_f32(r, inv_out_scale), out_q->zero_point, out_q->is_signed, pred);
+  }
+#else
+  for (uint32_t i = 0; i < nb; i++)
+  {
+    float a = (float)(ll_sw_kernel_load8(&pA[i], a_q->is_signed) - a_q->zero_point) * a_q->scale;
+    float b = (float)(ll_sw_kernel_load8(&pB[i], b_q->is_signed) - b_q->zero_point) * b_q->scale;
+    float r = (type == LL_SW_ARITHMUL) ? (a * b) : ((type == LL_SW_ARITHSUB) ? (a - b) : (a + b));
+    ll_sw_kernel_store8(&pOut[i], r * inv_out_scale, out_q->zero_point, out_q->is_signed);
+  }
+#endif
+}
+
+/** Channels innermost: the output row is used as accumulator, updated once per spatial position */
+static void ll_sw_kernel_global_pool_chlast(bool is_max, const float *pIn, float *pOut, uint32_t nb_pos,
+                                            uint32_t nb_ch)
+{
+  memcpy(pOut, pIn, nb_ch * sizeof(float));
+
+  for (uint32_t p = 1; p < nb_pos; p++)
+  {
+    const float *pRow = &pIn[p * nb_ch];
+#ifdef LL_SW_KERNELS_MVEF
+    for (int32_t n = (int32_t)nb_ch, c = 0; n > 0; n -= 4, c += 4)
+    {
+      mve_pred16_t pred = vctp32q(n);
+      float32x4_t acc = vldrwq_z_f32(&pOut[c], pred);
+      float32x4_t v = vldrwq_z_f32(&pRow[c], pred);
+      vstrwq_p_f32(&pOut[c], is_max ? vmaxnmq_f32(acc, v) : vaddq_f32(acc, v), pred);
+    }
+#else
+    for (uint32_t c = 0; c < nb_ch; c++)
+    {
+      pOut[c] = is_max ? fmaxf(pOut[c], pRow[c]) : (pOut[c] + pRow[c]);
+    }
+#endif
+  }
+
+  if (!is_max)
+  {
+    const float inv = 1.0f / (float)nb_pos;
+    for (uint32_t c = 0; c < nb_ch; c++)
+    {
+      pOut[c] *= inv;
+    }
+  }
+}
+
+/** Channels outermost: every channel is a contiguous run reduced on its own */
+static void ll_sw_kernel_global_pool_chfirst(bool is_max, const float *pIn, float *pOut, uint32_t nb_pos,
+                                             uint32_t nb_ch)
+{
+  for (uint32_t c = 0; c < nb_ch; c++, pIn += nb_pos)
+  {
+#ifdef LL_SW_KERNELS_MVEF
+    float32x4_t acc = is_max ? vdupq_n_f32(pIn[0]) : vdupq_n_f32(0.0f);
+    for (int32_t n = (int32_t)nb_pos, p = 0; n > 0; n -= 4, p += 4)
+    {
+      mve_pred16_t pred = vctp32q(n);
+      float32x4_t v = vldrwq_z_f32(&pIn[p], pred);
+      acc = is_max ? vmaxnmq_m_f32(acc, acc, v, pred) : vaddq_f32(acc, v);
+    }
+    float r = is_max ? vmaxnmvq_f32(pIn[0], acc)
+                     : (vgetq_lane_f32(acc, 0) + vgetq_lane_f32(acc, 1)) +
+                           (vgetq_lane_f32(acc, 2) + vgetq_lane_f32(acc, 3));
+#else
+    float r = pIn[0];
+    if (is_max)
+    {
+      for (uint32_t p = 1; p < nb_pos; p++)
+        r = fmaxf(r, pIn[p]);
+    }
+    else
+    {
+      for (uint32_t p = 1; p < nb_pos; p++)
+        r += pIn[p];
+    }
+#endif
+    pOut[c] = is_max ? r : (r / (float)nb_pos);
+  }
+}
+
+bool ll_sw_kernel_quantizelinear(const Quantizelinear_sw_info *sw_info)
+{
+  const Tensor_info *in = &sw_info->general.input;
+  const Tensor_info *out = &sw_info->general.output;
+  ll_sw_kernel_quant_t out_q;
+
+  if (!ll_sw_kernel_get_quant(&sw_info->os, &sw_info->ozp, out->format.is_signed, &out_q) ||
+      !ll_sw_kernel_same_layout(in, sizeof(float), out, 1) ||
+      ll_sw_kernel_overlap(in->mem.start_offset, in->dim.num_elem * sizeof(float), out->mem.start_offset,
+                           out->dim.num_elem))
+  {
+    return false;
+  }
+
+  ll_sw_kernel_quantize((const float *)in->mem.start_offset, out->mem.start_offset, in->dim.num_elem, &out_q);
+  return true;
+}
+
+bool ll_sw_kernel_dequantizelinear(const Dequantizelinear_sw_info *sw_info)
+{
+  const Tensor_info *in = &sw_info->general.input;
+  const Tensor_info *out = &sw_info->general.output;
+  ll_sw_kernel_quant_t in_q;
+
+  if (!ll_sw_kernel_get_quant(&sw_info->is, &sw_info->izp, in->format.is_signed, &in_q) ||
+      !ll_sw_kernel_same_layout(in, 1, out, sizeof(float)) ||
+      ll_sw_kernel_overlap(in->mem.start_offset, in->dim.num_elem, out->mem.start_offset,
+                           out->dim.num_elem * sizeof(float)))
+  {
+    return false;
+  }
+
+  ll_sw_kernel_dequantize(in->mem.start_offset, (float *)out->mem.start_offset, in->dim.num_elem, &in_q);
+  return true;
+}
+
+bool ll_sw_kernel_requantizelinear(const Requantizelinear_sw_info *sw_info)
+{
+  const Tensor_info *in = &sw_info->general.input;
+  const Tensor_info *out = &sw_info->general.output;
+  ll_sw_kernel_quant_t in_q;
+  ll_sw_kernel_quant_t out_q;
+
+  /* Element-wise with same sized elements: in place is fine */
+  if (!ll_sw_kernel_get_quant(&sw_info->is, &sw_info->izp, in->format.is_signed, &in_q) ||
+      !ll_sw_kernel_get_quant(&sw_info->os, &sw_info->ozp, out->format.is_signed, &out_q) ||
+      !ll_sw_kernel_same_layout(in, 1, out, 1))
+  {
+    return false;
+  }
+
+  ll_sw_kernel_requantize(in->mem.start_offset, out->mem.start_offset, in->dim.num_elem, &in_q, &out_q);
+  return true;
+}
+
+bool ll_sw_kernel_eltwise_integer(const Eltwise_integer_sw_info *sw_info)
+{
+  const Tensor_info *a = &sw_info->general.input;
+  const Tensor_info *b = &sw_info->operand;
+  const Tensor_info *out = &sw_info->general.output;
+  ll_sw_kernel_quant_t a_q;
+  ll_sw_kernel_quant_t b_q;
+  ll_sw_kernel_quant_t out_q;
+  NodeType type = sw_info->general.type;
+
+  /* Division and broadcasting are left to the generic layer */
+  if (((type != LL_SW_ARITHSUM) && (type != LL_SW_ARITHSUB) && (type != LL_SW_ARITHMUL)) ||
+      (sw_info->num_of_inputs != 2) ||
+      !ll_sw_kernel_get_quant(&sw_info->is, &sw_info->izp, a->format.is_signed, &a_q) ||
+      !ll_sw_kernel_get_quant(&sw_info->operand_s, &sw_info->operand_zp, b->format.is_signed, &b_q) ||
+      !ll_sw_kernel_get_quant(&sw_info->os, &sw_info->ozp, out->format.is_signed, &out_q) ||
+      !ll_sw_kernel_same_layout(a, 1, out, 1) || !ll_sw_kernel_same_layout(b, 1, out, 1))
+  {
+    return false;
+  }
+
+  ll_sw_kernel_eltwise(type, a->mem.start_offset, b->mem.start_offset, out->mem.start_offset, out->dim.num_elem, &a_q,
+                       &b_q, &out_q);
+  return true;
+}
+
+bool ll_sw_kernel_global_pool(const Global_pool_sw_info *sw_info)
+{
+  const Tensor_info *in = &sw_info->general.input;
+  const Tensor_info *out = &sw_info->general.output;
+  const uint32_t nb_ch = in->dim.tensor_c;
+  const uint32_t nb_pos = in->dim.tensor_h * in->dim.tensor_w;
+  bool is_max = (sw_info->general.type == LL_SW_MAXPOOL);
+
+  /* The generic layer pools over a `tensor_w` x `tensor_w` window: only square inputs are taken over */
+  if (((sw_info->general.type != LL_SW_AVGPOOL) && !is_max) || (in->dim.tensor_b > 1) ||
+      (in->dim.tensor_h != in->dim.tensor_w) || (nb_pos == 0) || (out->dim.num_elem != nb_ch) ||
+      !ll_sw_kernel_is_dense(in, sizeof(float)) || !ll_sw_kernel_is_dense(out, sizeof(float)) ||
+      ll_sw_kernel_overlap(in->mem.start_offset, in->dim.num_elem * sizeof(float), out->mem.start_offset,
+                           nb_ch * sizeof(float)))
+  {
+    return false;
+  }
+
+  if ((nb_ch == 1) || (nb_pos == 1) || (in->stride.c == sizeof(float)))
+  {
+    ll_sw_kernel_global_pool_chlast(is_max, (const float *)in->mem.start_offset, (float *)out->mem.start_offset,
+                                    nb_pos, nb_ch);
+  }
+  else if (in->stride.c == nb_pos * sizeof(float))
+  {
+    ll_sw_kernel_global_pool_chfirst(is_max, (const float *)in->mem.start_offset, (float *)out->mem.start_offset,
+                                     nb_pos, nb_ch);
+  }
+  else
+  {
+    return false;
+  }
+
+  return true;
+}
+
+#endif // LL_ATON_SW_FALLBACK == 1
@@ -0,0 +1,56 @@
+/**
+ ******************************************************************************
+ * @file    ll_sw_kernels.h
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   Header file of ll_sw native kernels.
+ * @note    Fast paths used by `ll_sw_forward_*()` instead of the generic network runtime layers whenever the
+ *          tensors are dense and quantized per tensor. Helium (MVE) versions are used when the compiler targets it,
+ *          plain C versions otherwise (e.g. host builds).
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef __LL_SW_KERNELS_H__
+#define __LL_SW_KERNELS_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ll_sw.h"
+
+/* The native kernels are not bit-exact against the generic layers (rounding of the requantization and of the
+ * element-wise operators): a value next to a half may be one step away (see sim/ll_sw_kernels_test.c), they are only
+ * used when `LL_SW_NATIVE_KERNELS` is defined as `1` */
+#ifndef LL_SW_NATIVE_KERNELS
+#define LL_SW_NATIVE_KERNELS 0
+#endif
+
+  /* Each function returns `false` without touching any buffer when the node is not supported, the caller then runs
+   * the generic implementation.
+   * Define `LL_SW_KERNELS_NO_MVE` to force the plain C kernels on a Helium target. */
+
+  bool ll_sw_kernel_quantizelinear(const Quantizelinear_sw_info *sw_info);
+  bool ll_sw_kernel_dequantizelinear(const Dequantizelinear_sw_info *sw_info);
+  bool ll_sw_kernel_requantizelinear(const Requantizelinear_sw_info *sw_info);
+  bool ll_sw_kernel_eltwise_integer(const Eltwise_integer_sw_info *sw_info);
+  bool ll_sw_kernel_global_pool(const Global_pool_sw_info *sw_info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __LL_SW_KERNELS_H__
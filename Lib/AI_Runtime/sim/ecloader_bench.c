@@ -0,0 +1,263 @@
+/**
+ ******************************************************************************
+ * @file    ecloader_bench.c
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   Host benchmark of the Epoch Controller blob loader on synthetic
+ *          binaries: lookups by identifier with and without the sorted
+ *          index, and re-basing all the memory pools one by one or in a
+ *          single pass. The blobs patched both ways are checked identical.
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ll_aton_sim.h"
+
+/* Unit under test */
+#include "ecloader.c"
+
+#define SIM_BLOB_SIZE    (64 * 1024) /* instructions */
+#define SIM_MAX_ENTRIES  1024
+#define SIM_MAX_OFFSETS  64
+#define SIM_BINARY_WORDS (256 * 1024)
+
+static uint32_t sim_seed = 0x6B8B4567;
+
+static uint32_t sim_rand(void)
+{
+  sim_seed ^= sim_seed << 13;
+  sim_seed ^= sim_seed >> 17;
+  sim_seed ^= sim_seed << 5;
+  return sim_seed;
+}
+
+/* Synthetic Epoch Controller binary: header, relocation table, patch table and blob */
+static ECFileEntry sim_binary[SIM_BINARY_WORDS];
+static char sim_reloc_ids[SIM_MAX_ENTRIES][48];
+static char sim_patch_ids[SIM_MAX_ENTRIES][48];
+
+static ECInstr sim_blob_a[SIM_BLOB_SIZE + 2];
+static ECInstr sim_blob_b[SIM_BLOB_SIZE + 2];
+static unsigned int sim_index[SIM_MAX_ENTRIES];
+static ECAddr sim_bases[SIM_MAX_ENTRIES];
+static ECAddr sim_prev_a[SIM_MAX_ENTRIES];
+static ECAddr sim_prev_b[SIM_MAX_ENTRIES];
+
+/* Table of `nr_of_entries` entries of `stride` words, identifiers and offset lists following the entries */
+static uint32_t sim_build_table(uint32_t pos, uint32_t stride, uint32_t nr_of_entries, char (*ids)[48],
+                                uint32_t nr_of_offsets)
+{
+  ECFileEntry *table = &sim_binary[pos];
+  uint32_t end = 1 + stride * nr_of_entries;
+
+  table[0] = nr_of_entries;
+  for (uint32_t n = 0; n < nr_of_entries; n++)
+  {
+    ECFileEntry *entry = &table[1 + stride * n];
+    uint32_t len = (uint32_t)strlen(ids[n]) + 1;
+
+    entry[0] = end * sizeof(ECFileEntry);
+    memcpy(&table[end], ids[n], len);
+    end += (len + sizeof(ECFileEntry) - 1) / sizeof(ECFileEntry);
+
+    if (stride == 4)
+    {
+      entry[1] = 0x00FFFF00UL;
+    }
+    entry[stride - 2] = nr_of_offsets;
+    entry[stride - 1] = end * sizeof(ECFileEntry);
+    for (uint32_t i = 0; i < nr_of_offsets; i++)
+    {
+      table[end++] = sim_rand() % SIM_BLOB_SIZE;
+    }
+  }
+
+  return pos + end;
+}
+
+static void sim_build_binary(uint32_t nr_of_relocs, uint32_t nr_of_patches, uint32_t nr_of_offsets)
+{
+  uint32_t pos = 5;
+
+  /* Identifiers share long prefixes, as the generated ones */
+  for (uint32_t n = 0; n < nr_of_relocs; n++)
+  {
+    snprintf(sim_reloc_ids[n], sizeof(sim_reloc_ids[n]), "_mem_pool_npuRAM%lu_%05lu", (unsigned long)(n % 6),
+             (unsigned long)((n * 7919) % 100000));
+  }
+  for (uint32_t n = 0; n < nr_of_patches; n++)
+  {
+    snprintf(sim_patch_ids[n], sizeof(sim_patch_ids[n]), "_patch_epoch_%lu_streng_%lu", (unsigned long)(n / 8),
+             (unsigned long)(n % 8));
+  }
+
+  memset(sim_binary, 0, sizeof(sim_binary));
+  sim_binary[0] = ECASM_BINARY_MAGIC;
+  sim_binary[1] = pos * sizeof(ECFileEntry);
+  pos = sim_build_table(pos, 3, nr_of_relocs, sim_reloc_ids, nr_of_offsets);
+  sim_binary[2] = pos * sizeof(ECFileEntry);
+  pos = sim_build_table(pos, 4, nr_of_patches, sim_patch_ids, 4);
+  pos = (pos + 1) & ~1UL;
+  sim_binary[4] = pos * sizeof(ECFileEntry);
+  sim_binary[pos] = ECASM_BLOB_MAGIC;
+  sim_binary[pos + 1] = SIM_BLOB_SIZE;
+  for (uint32_t i = 0; i < SIM_BLOB_SIZE; i++)
+  {
+    sim_binary[pos + 2 + i] = sim_rand();
+  }
+}
+
+static void sim_load_blobs(void)
+{
+  unsigned int size = SIM_BLOB_SIZE + 2;
+
+  SIM_CHECK(ec_copy_blob(sim_blob_a, (const uint8_t *)sim_binary, &size));
+  memcpy(sim_blob_b, sim_blob_a, sizeof(sim_blob_a));
+}
+
+/* The index lists all the entries once, sorted by identifier */
+static void check_index(const ECFileEntry *table, unsigned int nr_of_entries, const unsigned int *index,
+                        const char *(*get_id)(const ECFileEntry *, unsigned int))
+{
+  bool seen[SIM_MAX_ENTRIES] = {false};
+
+  for (unsigned int n = 0; n < nr_of_entries; n++)
+  {
+    SIM_CHECK((index[n] < nr_of_entries) && !seen[index[n]]);
+    seen[index[n]] = true;
+    if (n > 0)
+    {
+      SIM_CHECK(strcmp(get_id(table, index[n - 1]), get_id(table, index[n])) <= 0);
+    }
+  }
+}
+
+static void bench(uint32_t nr_of_relocs, uint32_t nr_of_patches, uint32_t nr_of_offsets)
+{
+  const uint32_t nb_runs = 20;
+  const ECFileEntry *relocs;
+  const ECFileEntry *patches;
+  uint64_t t0, t_linear, t_indexed, t_build, t_all;
+  bool ok;
+
+  sim_build_binary(nr_of_relocs, nr_of_patches, nr_of_offsets);
+  relocs = ec_get_reloc_table_ptr((const uint8_t *)sim_binary);
+  patches = ec_get_patch_table_ptr((const uint8_t *)sim_binary);
+  SIM_CHECK(ec_get_num_relocs(relocs) == nr_of_relocs);
+  SIM_CHECK(ec_get_num_patches(patches) == nr_of_patches);
+
+  /* Patches by identifier: linear scan vs binary search */
+  sim_load_blobs();
+  t0 = sim_time_ns();
+  ok = true;
+  for (uint32_t run = 0; run < nb_runs; run++)
+  {
+    for (uint32_t n = 0; n < nr_of_patches; n++)
+    {
+      ok &= ec_patch_by_id(patches, sim_blob_a, sim_patch_ids[n], run * 0x100 + n);
+    }
+  }
+  t_linear = sim_time_ns() - t0;
+  SIM_CHECK(ok);
+
+  t0 = sim_time_ns();
+  SIM_CHECK(ec_build_patch_index(patches, sim_index, SIM_MAX_ENTRIES));
+  t_build = sim_time_ns() - t0;
+  check_index(patches, nr_of_patches, sim_index, ec_get_patch_id);
+
+  t0 = sim_time_ns();
+  ok = true;
+  for (uint32_t run = 0; run < nb_runs; run++)
+  {
+    for (uint32_t n = 0; n < nr_of_patches; n++)
+    {
+      ok &= ec_patch_by_id_indexed(patches, sim_index, sim_blob_b, sim_patch_ids[n], run * 0x100 + n);
+    }
+  }
+  t_indexed = sim_time_ns() - t0;
+  SIM_CHECK(ok);
+  SIM_CHECK(memcmp(sim_blob_a, sim_blob_b, sizeof(sim_blob_a)) == 0);
+  SIM_CHECK(!ec_patch_by_id_indexed(patches, sim_index, sim_blob_b, "_patch_unknown", 0));
+
+  printf("%4lu patches: by id %8.1f us, indexed %7.1f us (x%5.1f), index built in %7.1f us\n",
+         (unsigned long)nr_of_patches, t_linear / 1e3 / nb_runs, t_indexed / 1e3 / nb_runs,
+         (double)t_linear / (double)(t_indexed + 1), t_build / 1e3);
+
+  /* Re-base of the memory pools, half of them moving at each run: by id, indexed, in one pass */
+  sim_load_blobs();
+  memset(sim_prev_a, 0, sizeof(sim_prev_a));
+  memset(sim_prev_b, 0, sizeof(sim_prev_b));
+  memset(sim_bases, 0, sizeof(sim_bases));
+  SIM_CHECK(ec_build_reloc_index(relocs, sim_index, SIM_MAX_ENTRIES));
+  check_index(relocs, nr_of_relocs, sim_index, ec_get_reloc_id);
+
+  t_linear = t_indexed = t_all = 0;
+  for (uint32_t run = 0; run < nb_runs; run++)
+  {
+    for (uint32_t n = 0; n < nr_of_relocs; n++)
+    {
+      if (sim_rand() & 1)
+      {
+        sim_bases[n] = 0x34000000UL + (sim_rand() & 0xFFFF00UL);
+      }
+    }
+
+    t0 = sim_time_ns();
+    ok = true;
+    for (uint32_t n = 0; n < nr_of_relocs; n++)
+    {
+      ok &= ec_reloc_by_id(relocs, sim_blob_a, sim_reloc_ids[n], sim_bases[n], &sim_prev_a[n]);
+    }
+    t_linear += sim_time_ns() - t0;
+    SIM_CHECK(ok);
+
+    /* Indexed lookups, undone to compare the single pass from the same state */
+    ECAddr prev[SIM_MAX_ENTRIES];
+    memcpy(prev, sim_prev_b, sizeof(prev));
+    t0 = sim_time_ns();
+    ok = true;
+    for (uint32_t n = 0; n < nr_of_relocs; n++)
+    {
+      ok &= ec_reloc_by_id_indexed(relocs, sim_index, sim_blob_b, sim_reloc_ids[n], sim_bases[n], &prev[n]);
+    }
+    t_indexed += sim_time_ns() - t0;
+    SIM_CHECK(ok);
+    SIM_CHECK(memcmp(sim_blob_a, sim_blob_b, sizeof(sim_blob_a)) == 0);
+    SIM_CHECK(ec_reloc_all(relocs, sim_blob_b, sim_prev_b, prev));
+
+    t0 = sim_time_ns();
+    SIM_CHECK(ec_reloc_all(relocs, sim_blob_b, sim_bases, sim_prev_b));
+    t_all += sim_time_ns() - t0;
+    SIM_CHECK(memcmp(sim_blob_a, sim_blob_b, sizeof(sim_blob_a)) == 0);
+    SIM_CHECK(memcmp(sim_prev_a, sim_prev_b, sizeof(sim_prev_a)) == 0);
+  }
+
+  printf("%4lu pools x %2lu offsets: re-base by id %7.1f us, indexed %7.1f us, in one pass %7.1f us (x%5.1f)\n",
+         (unsigned long)nr_of_relocs, (unsigned long)nr_of_offsets, t_linear / 1e3 / nb_runs,
+         t_indexed / 1e3 / nb_runs, t_all / 1e3 / nb_runs, (double)t_linear / (double)(t_all + 1));
+
+  SIM_CHECK(!ec_reloc_by_id_indexed(relocs, sim_index, sim_blob_b, "_mem_pool_unknown", 1, &sim_prev_b[0]));
+  SIM_CHECK(!ec_build_reloc_index(relocs, sim_index, nr_of_relocs - 1));
+}
+
+int main(void)
+{
+  bench(8, 64, 32);
+  bench(32, 256, 32);
+  bench(128, 1000, 16);
+  bench(512, 1000, 4);
+
+  return sim_report("ecloader_bench");
+}
@@ -0,0 +1,258 @@
+/**
+ ******************************************************************************
+ * @file    ll_aton_cache_batch_test.c
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   Host unit tests of the ATON cache maintenance batching: range
+ *          coalescing (overlap, adjacency, full list), issue at the end of
+ *          the outermost batch and issue before an overlapping invalidate.
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ll_aton_sim.h"
+
+/* Cache operations issued by the batch, in order */
+#define SIM_MAX_OPS 64
+
+typedef struct
+{
+  char op; /* 'C': MCU clean range, 'F': MCU full clean, 'N': NPU clean range */
+  uint32_t start;
+  uint32_t end;
+} sim_cache_op_t;
+
+static sim_cache_op_t sim_ops[SIM_MAX_OPS];
+static uint32_t sim_nr_of_ops;
+
+static void sim_log(char op, uint32_t start, uint32_t end)
+{
+  if (sim_nr_of_ops < SIM_MAX_OPS)
+  {
+    sim_ops[sim_nr_of_ops].op = op;
+    sim_ops[sim_nr_of_ops].start = start;
+    sim_ops[sim_nr_of_ops].end = end;
+  }
+  sim_nr_of_ops++;
+}
+
+int mcu_cache_clean(void)
+{
+  sim_log('F', 0, 0);
+  return 0;
+}
+
+int mcu_cache_clean_range(uint32_t start_addr, uint32_t end_addr)
+{
+  sim_log('C', start_addr, end_addr);
+  return 0;
+}
+
+void npu_cache_clean_range(uint32_t start_addr, uint32_t end_addr)
+{
+  sim_log('N', start_addr, end_addr);
+}
+
+/* Unit under test, its static functions are reached from here */
+#include "ll_aton_cache_batch.c"
+
+static __ll_cache_list_t list;
+
+static void list_reset(void)
+{
+  memset(&list, 0, sizeof(list));
+}
+
+/* Checks the list against `n` (start, end) pairs */
+static int list_is(uint32_t n, const uintptr_t *expected)
+{
+  if (list.nr_of_ranges != n)
+    return 0;
+  for (uint32_t i = 0; i < n; i++)
+  {
+    if ((list.ranges[i].start != expected[2 * i]) || (list.ranges[i].end != expected[2 * i + 1]))
+      return 0;
+  }
+  return 1;
+}
+
+static void batch_reset(void)
+{
+  memset(&__ll_cache_batch, 0, sizeof(__ll_cache_batch));
+  sim_nr_of_ops = 0;
+}
+
+static void test_overlap(void)
+{
+  list_reset();
+  SIM_CHECK(__LL_ATON_Cache_Batch_Insert(&list, 0x100, 0x140));
+  SIM_CHECK(__LL_ATON_Cache_Batch_Insert(&list, 0x120, 0x180));
+  SIM_CHECK(list_is(1, (const uintptr_t[]){0x100, 0x180}));
+
+  /* Contained range */
+  SIM_CHECK(__LL_ATON_Cache_Batch_Insert(&list, 0x120, 0x140));
+  SIM_CHECK(list_is(1, (const uintptr_t[]){0x100, 0x180}));
+
+  /* Overlapping the start of the range */
+  SIM_CHECK(__LL_ATON_Cache_Batch_Insert(&list, 0x0c0, 0x120));
+  SIM_CHECK(list_is(1, (const uintptr_t[]){0x0c0, 0x180}));
+
+  /* Spanning three ranges and the gaps between them */
+  list_reset();
+  SIM_CHECK(__LL_ATON_Cache_Batch_Insert(&list, 0x000, 0x020));
+  SIM_CHECK(__LL_ATON_Cache_Batch_Insert(&list, 0x040, 0x060));
+  SIM_CHECK(__LL_ATON_Cache_Batch_Insert(&list, 0x080, 0x0a0));
+  SIM_CHECK(__LL_ATON_Cache_Batch_Insert(&list, 0x100, 0x120));
+  SIM_CHECK(__LL_ATON_Cache_Batch_Insert(&list, 0x010, 0x090));
+  SIM_CHECK(list_is(2, (const uintptr_t[]){0x000, 0x0a0, 0x100, 0x120}));
+}
+
+static void test_adjacency(void)
+{
+  list_reset();
+  SIM_CHECK(__LL_ATON_Cache_Batch_Insert(&list, 0x100, 0x120));
+  /* Touching the end */
+  SIM_CHECK(__LL_ATON_Cache_Batch_Insert(&list, 0x120, 0x140));
+  SIM_CHECK(list_is(1, (const uintptr_t[]){0x100, 0x140}));
+  /* Touching the start */
+  SIM_CHECK(__LL_ATON_Cache_Batch_Insert(&list, 0x0e0, 0x100));
+  SIM_CHECK(list_is(1, (const uintptr_t[]){0x0e0, 0x140}));
+
+  /* One line apart: kept separate and sorted */
+  SIM_CHECK(__LL_ATON_Cache_Batch_Insert(&list, 0x160, 0x180));
+  SIM_CHECK(__LL_ATON_Cache_Batch_Insert(&list, 0x0a0, 0x0c0));
+  SIM_CHECK(list_is(3, (const uintptr_t[]){0x0a0, 0x0c0, 0x0e0, 0x140, 0x160, 0x180}));
+
+  /* Filling both gaps exactly joins everything */
+  SIM_CHECK(__LL_ATON_Cache_Batch_Insert(&list, 0x140, 0x160));
+  SIM_CHECK(__LL_ATON_Cache_Batch_Insert(&list, 0x0c0, 0x0e0));
+  SIM_CHECK(list_is(1, (const uintptr_t[]){0x0a0, 0x180}));
+
+  /* Requests sharing a cache line are merged once aligned */
+  batch_reset();
+  LL_ATON_Cache_Batch_Begin();
+  SIM_CHECK(__LL_ATON_Cache_Batch_Add(LL_ATON_CACHE_BATCH_MCU_CLEAN, 0x1004, 8));
+  SIM_CHECK(__LL_ATON_Cache_Batch_Add(LL_ATON_CACHE_BATCH_MCU_CLEAN, 0x1010, 4));
+  SIM_CHECK(__LL_ATON_Cache_Batch_Add(LL_ATON_CACHE_BATCH_MCU_CLEAN, 0x1018, 16));
+  SIM_CHECK(sim_nr_of_ops == 0);
+  LL_ATON_Cache_Batch_End();
+  SIM_CHECK(sim_nr_of_ops == 1);
+  SIM_CHECK((sim_ops[0].op == 'C') && (sim_ops[0].start == 0x1000) && (sim_ops[0].end == 0x1040));
+}
+
+static void test_full_list(void)
+{
+  list_reset();
+  for (uint32_t i = 0; i < LL_ATON_CACHE_BATCH_MAX_RANGES; i++)
+  {
+    SIM_CHECK(__LL_ATON_Cache_Batch_Insert(&list, 0x1000 + 0x100 * i, 0x1020 + 0x100 * i));
+  }
+  SIM_CHECK(list.nr_of_ranges == LL_ATON_CACHE_BATCH_MAX_RANGES);
+
+  /* A new range doesn't fit, the list is left untouched */
+  SIM_CHECK(!__LL_ATON_Cache_Batch_Insert(&list, 0x0000, 0x0020));
+  SIM_CHECK(list.nr_of_ranges == LL_ATON_CACHE_BATCH_MAX_RANGES);
+  SIM_CHECK((list.ranges[0].start == 0x1000) && (list.ranges[0].end == 0x1020));
+
+  /* Ranges merging with a pending one still fit */
+  SIM_CHECK(__LL_ATON_Cache_Batch_Insert(&list, 0x1020, 0x1040));
+  SIM_CHECK(list.nr_of_ranges == LL_ATON_CACHE_BATCH_MAX_RANGES);
+
+  /* Through the batch: the pending cleans are issued to make room, in address order, then the new one is queued */
+  batch_reset();
+  LL_ATON_Cache_Batch_Begin();
+  for (uint32_t i = 0; i < LL_ATON_CACHE_BATCH_MAX_RANGES; i++)
+  {
+    SIM_CHECK(__LL_ATON_Cache_Batch_Add(LL_ATON_CACHE_BATCH_NPU_CLEAN, 0x2000 + 0x100 * i, 0x40));
+  }
+  SIM_CHECK(sim_nr_of_ops == 0);
+  SIM_CHECK(__LL_ATON_Cache_Batch_Add(LL_ATON_CACHE_BATCH_NPU_CLEAN, 0x0000, 0x40));
+  SIM_CHECK(sim_nr_of_ops == LL_ATON_CACHE_BATCH_MAX_RANGES);
+  for (uint32_t i = 0; i < LL_ATON_CACHE_BATCH_MAX_RANGES; i++)
+  {
+    SIM_CHECK((sim_ops[i].op == 'N') && (sim_ops[i].start == 0x2000 + 0x100 * i) &&
+              (sim_ops[i].end == 0x2040 + 0x100 * i));
+  }
+  SIM_CHECK(__ll_cache_batch.lists[LL_ATON_CACHE_BATCH_NPU_CLEAN].nr_of_ranges == 1);
+  LL_ATON_Cache_Batch_End();
+  SIM_CHECK(sim_nr_of_ops == LL_ATON_CACHE_BATCH_MAX_RANGES + 1);
+  SIM_CHECK((sim_ops[LL_ATON_CACHE_BATCH_MAX_RANGES].start == 0x0000) &&
+            (sim_ops[LL_ATON_CACHE_BATCH_MAX_RANGES].end == 0x0040));
+}
+
+static void test_flush_before_invalidate(void)
+{
+  batch_reset();
+  LL_ATON_Cache_Batch_Begin();
+  SIM_CHECK(__LL_ATON_Cache_Batch_Add(LL_ATON_CACHE_BATCH_MCU_CLEAN, 0x3000, 0x40));
+  SIM_CHECK(__LL_ATON_Cache_Batch_Add(LL_ATON_CACHE_BATCH_MCU_CLEAN, 0x5000, 0x40));
+
+  /* An invalidate elsewhere doesn't issue anything */
+  __LL_ATON_Cache_Batch_Sync(LL_ATON_CACHE_BATCH_MCU_CLEAN, 0x4000, 0x100);
+  SIM_CHECK(sim_nr_of_ops == 0);
+  /* Nor one ending right before a pending range */
+  __LL_ATON_Cache_Batch_Sync(LL_ATON_CACHE_BATCH_MCU_CLEAN, 0x2f00, 0x100);
+  SIM_CHECK(sim_nr_of_ops == 0);
+  /* Nor one of the other cache */
+  __LL_ATON_Cache_Batch_Sync(LL_ATON_CACHE_BATCH_NPU_CLEAN, 0x3000, 0x40);
+  SIM_CHECK(sim_nr_of_ops == 0);
+
+  /* An invalidate of the last byte of a pending clean issues all the pending cleans before it */
+  __LL_ATON_Cache_Batch_Sync(LL_ATON_CACHE_BATCH_MCU_CLEAN, 0x303f, 1);
+  SIM_CHECK(sim_nr_of_ops == 2);
+  SIM_CHECK((sim_ops[0].op == 'C') && (sim_ops[0].start == 0x3000) && (sim_ops[0].end == 0x3040));
+  SIM_CHECK((sim_ops[1].op == 'C') && (sim_ops[1].start == 0x5000) && (sim_ops[1].end == 0x5040));
+  SIM_CHECK(__ll_cache_batch.lists[LL_ATON_CACHE_BATCH_MCU_CLEAN].nr_of_ranges == 0);
+
+  /* A full invalidate (size 0) issues whatever is pending */
+  SIM_CHECK(__LL_ATON_Cache_Batch_Add(LL_ATON_CACHE_BATCH_NPU_CLEAN, 0x6000, 0x40));
+  __LL_ATON_Cache_Batch_Sync(LL_ATON_CACHE_BATCH_NPU_CLEAN, 0, 0);
+  SIM_CHECK(sim_nr_of_ops == 3);
+  SIM_CHECK(sim_ops[2].op == 'N');
+
+  LL_ATON_Cache_Batch_End();
+  SIM_CHECK(sim_nr_of_ops == 3);
+}
+
+static void test_nesting_and_threshold(void)
+{
+  batch_reset();
+
+  /* Without an open batch, cleans are issued by the caller */
+  SIM_CHECK(!__LL_ATON_Cache_Batch_Add(LL_ATON_CACHE_BATCH_MCU_CLEAN, 0x1000, 0x40));
+
+  LL_ATON_Cache_Batch_Begin();
+  LL_ATON_Cache_Batch_Begin();
+  SIM_CHECK(__LL_ATON_Cache_Batch_Add(LL_ATON_CACHE_BATCH_MCU_CLEAN, 0x10000, LL_ATON_CACHE_BATCH_MCU_FULL_THRESHOLD));
+  LL_ATON_Cache_Batch_End();
+  /* Still inside the outer batch */
+  SIM_CHECK(sim_nr_of_ops == 0);
+  LL_ATON_Cache_Batch_End();
+  SIM_CHECK((sim_nr_of_ops == 1) && (sim_ops[0].op == 'F'));
+
+  LL_ATON_Cache_Batch_Stats_t stats;
+  LL_ATON_Cache_Batch_GetStats(&stats, true);
+  SIM_CHECK((stats.requested_ops == 1) && (stats.issued_ops == 1) && (stats.full_ops == 1));
+}
+
+int main(void)
+{
+  test_overlap();
+  test_adjacency();
+  test_full_list();
+  test_flush_before_invalidate();
+  test_nesting_and_threshold();
+
+  return sim_report("ll_aton_cache_batch_test");
+}
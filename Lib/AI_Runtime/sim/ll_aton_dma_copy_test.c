@@ -0,0 +1,461 @@
+/**
+ ******************************************************************************
+ * @file    ll_aton_dma_copy_test.c
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   Host unit tests of the ATON DMA copy service: queue order, split
+ *          of linear copies between CPU prolog and 24-bit raw transfer,
+ *          two-dimensional rasters, completion callbacks and hand-over of the
+ *          ATON IP to a network starting an epoch block.
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ll_aton_sim.h"
+
+/* Unit under test, its static functions are reached from here */
+#include "ll_aton_dma_copy.c"
+
+/* Runtime state shared with the service (see `ll_aton_runtime.c`) */
+NN_Instance_TypeDef *volatile __ll_current_aton_ip_owner = NULL;
+uint32_t volatile __ll_current_wait_mask = 0;
+
+/*** Streaming engines: the programmed transfer is done at once by `sim_dma_irq()` ***/
+
+static LL_Streng_TensorInitTypeDef sim_streng[2];
+static bool sim_streng_set[2];
+static bool sim_dma_running;
+static uint32_t sim_nr_of_dma_starts;
+static uint32_t sim_nr_of_dma_bytes;
+
+/* ATON registers accessed directly (interrupt controller masks) */
+static uint32_t sim_aton_regs[0x2000 / sizeof(uint32_t)];
+
+uintptr_t get_ec_aton_base(void)
+{
+  return (uintptr_t)sim_aton_regs;
+}
+
+/* Interrupts of the epoch block in progress */
+static uint32_t sim_irq_wait_mask(void)
+{
+  return ~ATON_INTCTRL_INTANDMSK_GET(0, ATON_STD_IRQ_LINE) >> ATON_STRENG_INT(0);
+}
+
+void ec_trace_write(uintptr_t dstreg, unsigned int val)
+{
+  (void)dstreg;
+  (void)val;
+}
+
+int LL_Streng_TensorInit(int id, const LL_Streng_TensorInitTypeDef *conf, int n)
+{
+  SIM_CHECK((n == 1) && (id >= 0) && (id < 2));
+  SIM_CHECK(!sim_dma_running);
+  sim_streng[id] = *conf;
+  sim_streng_set[id] = true;
+  return 0;
+}
+
+int LL_Switch_Init(const LL_Switch_InitTypeDef *conf, int n)
+{
+  SIM_CHECK((conf == &__ll_dma_copy_switch) && (n == 1));
+  return 0;
+}
+
+int LL_Switch_Deinit(const LL_Switch_DeinitTypeDef *conf, int n)
+{
+  SIM_CHECK((conf == &__ll_dma_copy_switch) && (n == 1));
+  return 0;
+}
+
+int LL_ATON_EnableUnits_Init(const LL_ATON_EnableUnits_InitTypeDef *units, int n)
+{
+  SIM_CHECK((units == __ll_dma_copy_units) && (n == 2));
+  SIM_CHECK(sim_streng_set[0] && sim_streng_set[1]);
+  SIM_CHECK(__ll_current_aton_ip_owner == &__ll_dma_copy_instance);
+  SIM_CHECK(__ll_current_wait_mask == __LL_DMA_COPY_WAIT_MASK);
+  SIM_CHECK(sim_irq_wait_mask() == __LL_DMA_COPY_WAIT_MASK);
+  sim_dma_running = true;
+  sim_nr_of_dma_starts++;
+  return 0;
+}
+
+int LL_ATON_DisableUnits_Init(const LL_ATON_DisableUnits_InitTypeDef *units, int n)
+{
+  SIM_CHECK((units == __ll_dma_copy_units) && (n == 2));
+  sim_dma_running = false;
+  sim_streng_set[0] = sim_streng_set[1] = false;
+  return 0;
+}
+
+/* Bytes of a stream: contiguous in raw mode, `fheight` lines of `fwidth` pixels `line_offset` bytes apart otherwise */
+static uint32_t sim_streng_len(const LL_Streng_TensorInitTypeDef *s)
+{
+  uint32_t nbytes = s->nbits_in / 8;
+
+  SIM_CHECK(s->nbits_in == s->nbits_out);
+  SIM_CHECK((nbytes >= 1) && (nbytes <= 3));
+  SIM_CHECK(s->offset_start == 0);
+  if (s->raw)
+  {
+    /* Whole words only */
+    SIM_CHECK((s->offset_end % nbytes) == 0);
+    return s->offset_end;
+  }
+
+  SIM_CHECK((s->batch_depth == 1) && (s->batch_offset == nbytes));
+  SIM_CHECK(s->offset_end == (s->fheight - 1) * s->line_offset + s->fwidth * nbytes);
+  return s->fheight * s->fwidth * nbytes;
+}
+
+static uint8_t *sim_streng_byte(const LL_Streng_TensorInitTypeDef *s, uint32_t i)
+{
+  if (s->raw)
+    return s->addr_base.p + i;
+
+  uint32_t line_len = s->fwidth * (s->nbits_in / 8);
+  return s->addr_base.p + (i / line_len) * s->line_offset + (i % line_len);
+}
+
+/* End of transfer: moves the data and raises the interrupts of both streaming engines */
+static void sim_dma_irq(void)
+{
+  static uint8_t stream[1 << 16];
+  const LL_Streng_TensorInitTypeDef *in = &sim_streng[0];
+  const LL_Streng_TensorInitTypeDef *out = &sim_streng[1];
+
+  SIM_CHECK(sim_dma_running);
+  if (!sim_dma_running)
+    return;
+
+  uint32_t len = sim_streng_len(in);
+  SIM_CHECK((in->dir == 0) && (out->dir == 1));
+  SIM_CHECK(len == sim_streng_len(out));
+  SIM_CHECK(len <= sizeof(stream));
+  SIM_CHECK(in->nbits_in == out->nbits_in);
+
+  for (uint32_t i = 0; i < len; i++)
+    stream[i] = *sim_streng_byte(in, i);
+  for (uint32_t i = 0; i < len; i++)
+    *sim_streng_byte(out, i) = stream[i];
+  sim_nr_of_dma_bytes += len;
+
+  /* Both engines end, the handler acts on the one of the writer */
+  __ll_dma_copy_instance.exec_state.triggered_events |= 0x3;
+  __LL_ATON_DmaCopy_IrqHandler();
+}
+
+/*** Copies ***/
+
+#define SIM_BUF_SIZE 4096
+#define SIM_FILL     0xEE
+
+static uint8_t sim_src[SIM_BUF_SIZE];
+static uint8_t sim_dst[SIM_BUF_SIZE];
+
+/* Completion order */
+#define SIM_MAX_DONE 32
+static LL_ATON_DmaCopy_Desc_t *sim_done[SIM_MAX_DONE];
+static uint32_t sim_nr_of_done;
+
+static void sim_done_callback(LL_ATON_DmaCopy_Desc_t *desc, void *user_data)
+{
+  SIM_CHECK(user_data == (void *)desc);
+  SIM_CHECK(LL_ATON_DmaCopy_IsDone(desc));
+  if (sim_nr_of_done < SIM_MAX_DONE)
+    sim_done[sim_nr_of_done] = desc;
+  sim_nr_of_done++;
+}
+
+static void sim_reset(void)
+{
+  LL_ATON_DmaCopy_Init();
+  sim_dma_running = false;
+  sim_nr_of_dma_starts = 0;
+  sim_nr_of_dma_bytes = 0;
+  sim_nr_of_done = 0;
+  for (uint32_t i = 0; i < SIM_BUF_SIZE; i++)
+    sim_src[i] = (uint8_t)(rand() & 0xFF);
+  memset(sim_dst, SIM_FILL, sizeof(sim_dst));
+}
+
+/* Lines copied, the bytes in between and around untouched */
+static int sim_check_copy(uint32_t dst_offset, uint32_t dst_pitch, uint32_t src_offset, uint32_t src_pitch,
+                          uint32_t line_len, uint32_t nlines)
+{
+  for (uint32_t i = 0; i < SIM_BUF_SIZE; i++)
+  {
+    uint8_t expected = SIM_FILL;
+
+    if (i >= dst_offset)
+    {
+      uint32_t line = (i - dst_offset) / dst_pitch;
+      uint32_t col = (i - dst_offset) % dst_pitch;
+
+      if ((line < nlines) && (col < line_len))
+        expected = sim_src[src_offset + line * src_pitch + col];
+    }
+    if (sim_dst[i] != expected)
+      return 0;
+  }
+  return 1;
+}
+
+static void sim_desc_init(LL_ATON_DmaCopy_Desc_t *desc, uint32_t dst_offset, uint32_t src_offset, uint32_t n)
+{
+  LL_ATON_DmaCopy_Desc_Init(desc, &sim_dst[dst_offset], &sim_src[src_offset], n, 0, sim_done_callback, desc);
+}
+
+/* Linear copies: below `LL_ATON_DMA_COPY_MIN_LEN` by the CPU, otherwise the `n % 3` leading bytes by the CPU and the
+ * rest as 24-bit words */
+static void test_linear_split(void)
+{
+  for (uint32_t n = 1; n < 100; n++)
+  {
+    for (uint32_t offset = 0; offset < 3; offset++)
+    {
+      LL_ATON_DmaCopy_Desc_t desc;
+      uint32_t prolog_len = n % 3;
+
+      sim_reset();
+      sim_desc_init(&desc, 16 + offset, 7 + offset, n);
+      SIM_CHECK(LL_ATON_DmaCopy_Submit(&desc, 1));
+
+      if (n < LL_ATON_DMA_COPY_MIN_LEN)
+      {
+        SIM_CHECK(sim_nr_of_dma_starts == 0);
+        SIM_CHECK(LL_ATON_DmaCopy_IsDone(&desc));
+        SIM_CHECK(__ll_current_aton_ip_owner == NULL);
+        SIM_CHECK(__ll_current_wait_mask == 0);
+      }
+      else
+      {
+        SIM_CHECK(sim_nr_of_dma_starts == 1);
+        SIM_CHECK(desc.state == LL_ATON_DMA_COPY_RUNNING);
+        SIM_CHECK(sim_nr_of_done == 0);
+        SIM_CHECK(sim_streng[0].raw && sim_streng[1].raw);
+        SIM_CHECK((sim_streng[0].nbits_in == 24) && (sim_streng[1].nbits_out == 24));
+        SIM_CHECK(sim_streng[0].addr_base.p == &sim_src[7 + offset + prolog_len]);
+        SIM_CHECK(sim_streng[1].addr_base.p == &sim_dst[16 + offset + prolog_len]);
+        SIM_CHECK(sim_streng[1].offset_end == n - prolog_len);
+
+        /* The prolog is already there */
+        SIM_CHECK(memcmp(&sim_dst[16 + offset], &sim_src[7 + offset], prolog_len) == 0);
+
+        sim_dma_irq();
+        SIM_CHECK(sim_nr_of_dma_bytes == n - prolog_len);
+        SIM_CHECK(__ll_current_aton_ip_owner == NULL);
+        SIM_CHECK(__ll_current_wait_mask == 0);
+      }
+
+      SIM_CHECK(sim_nr_of_done == 1);
+      SIM_CHECK(sim_check_copy(16 + offset, n, 7 + offset, n, n, 1));
+    }
+  }
+}
+
+/* Strided copies: lines as 16-bit pixels when every address and pitch is even, as bytes otherwise */
+static void test_2d(void)
+{
+  static const uint32_t cases[][6] = {
+      /* dst_offset, dst_pitch, src_offset, src_pitch, line_len, nlines */
+      {0, 64, 0, 48, 32, 10},    /* Both strided, even */
+      {1, 64, 0, 48, 32, 10},    /* Odd destination */
+      {0, 64, 0, 47, 33, 10},    /* Odd pitch and length */
+      {0, 40, 0, 40, 40, 4},     /* Dense both sides: one linear copy */
+      {0, 33, 0, 100, 33, 20},   /* Dense destination */
+      {2, 200, 4, 30, 30, 15},   /* Dense source */
+      {0, 8, 0, 9, 4, 9},        /* Too short for the DMA */
+      {10, 130, 3, 120, 120, 1}, /* One line */
+  };
+
+  for (uint32_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++)
+  {
+    const uint32_t *k = cases[c];
+    LL_ATON_DmaCopy_Desc_t desc;
+    uint32_t size = k[4] * k[5];
+    bool linear = (k[5] == 1) || ((k[1] == k[4]) && (k[3] == k[4]));
+
+    sim_reset();
+    LL_ATON_DmaCopy_Desc_Init2D(&desc, &sim_dst[k[0]], k[1], &sim_src[k[2]], k[3], k[4], k[5], 0, sim_done_callback,
+                                &desc);
+    SIM_CHECK(LL_ATON_DmaCopy_Submit(&desc, 1));
+
+    if (size < LL_ATON_DMA_COPY_MIN_LEN)
+    {
+      SIM_CHECK(sim_nr_of_dma_starts == 0);
+    }
+    else
+    {
+      SIM_CHECK(sim_nr_of_dma_starts == 1);
+      if (linear)
+      {
+        SIM_CHECK(sim_streng[0].raw && sim_streng[1].raw && (sim_streng[0].nbits_in == 24));
+      }
+      else
+      {
+        uint32_t nbytes = ((k[0] | k[1] | k[2] | k[3] | k[4]) & 0x1) ? 1 : 2;
+
+        SIM_CHECK(sim_streng[0].nbits_in == nbytes * 8);
+        SIM_CHECK(sim_streng[0].raw == (k[3] == k[4]));
+        SIM_CHECK(sim_streng[1].raw == (k[1] == k[4]));
+      }
+      sim_dma_irq();
+    }
+
+    SIM_CHECK(sim_nr_of_done == 1);
+    SIM_CHECK(sim_check_copy(k[0], k[1], k[2], k[3], k[4], k[5]));
+  }
+}
+
+/* Descriptors run one at a time in submission order, callbacks included, a busy descriptor can't be submitted again */
+static void test_queue_order(void)
+{
+  LL_ATON_DmaCopy_Desc_t first[3];
+  LL_ATON_DmaCopy_Desc_t second[2];
+
+  sim_reset();
+  for (uint32_t i = 0; i < 3; i++)
+    sim_desc_init(&first[i], 512 * i, 512 * i, 300 + i);
+  for (uint32_t i = 0; i < 2; i++)
+    sim_desc_init(&second[i], 2048 + 512 * i, 2048 + 512 * i, (i == 0) ? 10 : 400); /* The first one by the CPU */
+
+  SIM_CHECK(LL_ATON_DmaCopy_Submit(first, 3));
+  SIM_CHECK(first[0].state == LL_ATON_DMA_COPY_RUNNING);
+  SIM_CHECK((first[1].state == LL_ATON_DMA_COPY_QUEUED) && (first[2].state == LL_ATON_DMA_COPY_QUEUED));
+
+  /* Appended behind the running queue, not started */
+  SIM_CHECK(LL_ATON_DmaCopy_Submit(second, 2));
+  SIM_CHECK(sim_nr_of_dma_starts == 1);
+  SIM_CHECK(second[0].state == LL_ATON_DMA_COPY_QUEUED);
+
+  /* Busy */
+  SIM_CHECK(!LL_ATON_DmaCopy_Submit(&first[1], 1));
+  SIM_CHECK(!LL_ATON_DmaCopy_Submit(first, 1));
+
+  /* Partial events of the reader only are ignored */
+  __ll_dma_copy_instance.exec_state.triggered_events = 0x1;
+  __LL_ATON_DmaCopy_IrqHandler();
+  SIM_CHECK(first[0].state == LL_ATON_DMA_COPY_RUNNING);
+  SIM_CHECK(sim_nr_of_done == 0);
+
+  for (uint32_t i = 0; (i < 10) && sim_dma_running; i++)
+    sim_dma_irq();
+
+  SIM_CHECK(sim_nr_of_dma_starts == 4);
+  SIM_CHECK(sim_nr_of_done == 5);
+  SIM_CHECK((sim_done[0] == &first[0]) && (sim_done[1] == &first[1]) && (sim_done[2] == &first[2]));
+  SIM_CHECK((sim_done[3] == &second[0]) && (sim_done[4] == &second[1]));
+  SIM_CHECK(__ll_current_aton_ip_owner == NULL);
+  SIM_CHECK(__ll_dma_copy.head == NULL && __ll_dma_copy.tail == NULL && __ll_dma_copy.current == NULL);
+
+  for (uint32_t i = 0; i < 3; i++)
+  {
+    SIM_CHECK(memcmp(&sim_dst[512 * i], &sim_src[512 * i], 300 + i) == 0);
+    SIM_CHECK(sim_dst[512 * i + 300 + i] == SIM_FILL);
+  }
+  for (uint32_t i = 0; i < 2; i++)
+  {
+    uint32_t n = (i == 0) ? 10 : 400;
+    SIM_CHECK(memcmp(&sim_dst[2048 + 512 * i], &sim_src[2048 + 512 * i], n) == 0);
+    SIM_CHECK(sim_dst[2048 + 512 * i + n] == SIM_FILL);
+  }
+
+  /* Done descriptors may be submitted again, without callback */
+  first[0].done_callback = NULL;
+  SIM_CHECK(LL_ATON_DmaCopy_Submit(first, 1));
+  sim_dma_irq();
+  SIM_CHECK(LL_ATON_DmaCopy_IsDone(&first[0]));
+  SIM_CHECK(sim_nr_of_done == 5);
+}
+
+/* A network starting an epoch block while a copy runs waits for the end of that copy only, the queue resumes when
+ * the network gives the ATON IP back */
+static void test_contention(void)
+{
+  NN_Instance_TypeDef net;
+  LL_ATON_DmaCopy_Desc_t descs[3];
+
+  memset(&net, 0, sizeof(net));
+  sim_reset();
+  for (uint32_t i = 0; i < 3; i++)
+    sim_desc_init(&descs[i], 1024 * i, 1024 * i, 600);
+
+  SIM_CHECK(LL_ATON_DmaCopy_Submit(descs, 3));
+  SIM_CHECK(__ll_current_aton_ip_owner == &__ll_dma_copy_instance);
+
+  /* The IP is lent to the service: the network is told to retry */
+  SIM_CHECK(!__ll_try_set_aton_owner(&net));
+  SIM_CHECK(__ll_dma_copy.yield);
+  SIM_CHECK(__ll_current_aton_ip_owner == &__ll_dma_copy_instance);
+
+  /* End of the running copy: the IP is given back instead of starting the next one */
+  sim_dma_irq();
+  SIM_CHECK(LL_ATON_DmaCopy_IsDone(&descs[0]));
+  SIM_CHECK(descs[1].state == LL_ATON_DMA_COPY_QUEUED);
+  SIM_CHECK(__ll_current_aton_ip_owner == NULL);
+  SIM_CHECK(__ll_current_wait_mask == 0);
+  SIM_CHECK(!__ll_dma_copy.yield);
+  SIM_CHECK(!sim_dma_running);
+
+  SIM_CHECK(__ll_try_set_aton_owner(&net));
+  SIM_CHECK(__ll_current_aton_ip_owner == &net);
+
+  /* Neither polling nor new submissions take the IP from the network */
+  LL_ATON_DmaCopy_Poll();
+  SIM_CHECK(__ll_current_aton_ip_owner == &net);
+  SIM_CHECK(sim_nr_of_dma_starts == 1);
+
+  /* End of the epoch block of the network: the queue resumes */
+  __ll_clear_aton_owner(&net);
+  SIM_CHECK(__ll_current_aton_ip_owner == &__ll_dma_copy_instance);
+  SIM_CHECK(descs[1].state == LL_ATON_DMA_COPY_RUNNING);
+  SIM_CHECK(sim_nr_of_dma_starts == 2);
+
+  sim_dma_irq();
+  sim_dma_irq();
+  SIM_CHECK(sim_nr_of_done == 3);
+  SIM_CHECK(__ll_current_aton_ip_owner == NULL);
+  for (uint32_t i = 0; i < 3; i++)
+    SIM_CHECK(memcmp(&sim_dst[1024 * i], &sim_src[1024 * i], 600) == 0);
+
+  /* Free IP: the network gets it right away, then copies queued meanwhile wait for it */
+  SIM_CHECK(__ll_try_set_aton_owner(&net));
+  SIM_CHECK(LL_ATON_DmaCopy_Submit(descs, 1));
+  SIM_CHECK(descs[0].state == LL_ATON_DMA_COPY_QUEUED);
+  SIM_CHECK(sim_nr_of_dma_starts == 3);
+
+  /* Released without going through the runtime (e.g. at the end of the network): `LL_ATON_DmaCopy_Poll()` starts
+   * them */
+  __LL_ATON_RT_SetWaitMask(0);
+  __ll_current_aton_ip_owner = NULL;
+  LL_ATON_DmaCopy_Poll();
+  SIM_CHECK(descs[0].state == LL_ATON_DMA_COPY_RUNNING);
+  sim_dma_irq();
+  SIM_CHECK(LL_ATON_DmaCopy_IsDone(&descs[0]));
+  SIM_CHECK(__ll_current_aton_ip_owner == NULL);
+}
+
+int main(void)
+{
+  srand(1);
+
+  test_linear_split();
+  test_2d();
+  test_queue_order();
+  test_contention();
+
+  return sim_report("ll_aton_dma_copy_test");
+}
@@ -0,0 +1,387 @@
+/**
+ ******************************************************************************
+ * @file    ll_aton_lib_sw_copy_test.c
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   Host tests of the SW `Slice` and `Transpose` operators: the N-D
+ *          copy engine must be bit-exact against the former recursive
+ *          implementation on random shapes, permutations and slices, and the
+ *          time of both is reported on a few usual layout changes.
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ll_aton_sim.h"
+
+/* Unit under test */
+#include "ll_aton_lib_sw_operators.c"
+
+#include "ll_aton_lib_sw_ref.h"
+
+#define SIM_MAX_RANK   6
+#define SIM_BUFFER_MAX (1024 * 1024)
+#define SIM_NB_RUNS    3000
+#define SIM_SENTINEL   0xA5
+
+/* The DMA based operators of `ll_aton_lib.c` are not reached by `Slice` and `Transpose` */
+NN_Instance_TypeDef *volatile __ll_current_aton_ip_owner = NULL;
+
+int LL_ATON_LIB_DMA_Outputs_Flat_Copy(const LL_LIB_TensorShape_TypeDef *input,
+                                      const LL_LIB_TensorShape_TypeDef *outputs, unsigned int nr_of_outputs, int dma_in,
+                                      int dma_out)
+{
+  abort();
+}
+
+int LL_ATON_LIB_DMA_Outputs_Channel_Split_Aton(const LL_LIB_TensorShape_TypeDef *input,
+                                               const LL_LIB_TensorShape_TypeDef *outputs, unsigned int nr_of_outputs,
+                                               unsigned int leading_dims, int dma_in, int dma_out)
+{
+  abort();
+}
+
+int LL_ATON_LIB_DMA_Outputs_Channel_Split_Batched(const LL_LIB_TensorShape_TypeDef *input,
+                                                  const LL_LIB_TensorShape_TypeDef *outputs,
+                                                  unsigned int nr_of_outputs, int dma_in, int dma_out)
+{
+  abort();
+}
+
+int LL_ATON_LIB_DMA_Pad_Memset(void *output, int32_t constant_value, size_t out_size,
+                               __ll_pad_sw_params_t *common_params)
+{
+  abort();
+}
+
+int LL_ATON_LIB_DMA_Pad_Filling(__ll_pad_sw_params_t *init_common_params)
+{
+  abort();
+}
+
+/* Any parameter error of the operators fails the test */
+void __ll_lib_error(int err_code, int line, const char *func)
+{
+  printf("%s:%d: error %d\n", func, line, err_code);
+  sim_nr_of_failures++;
+}
+
+static int8_t sim_in[SIM_BUFFER_MAX] __attribute__((aligned(4)));
+static int8_t sim_out[SIM_BUFFER_MAX] __attribute__((aligned(4)));
+static int8_t sim_ref[SIM_BUFFER_MAX] __attribute__((aligned(4)));
+
+static uint32_t sim_seed = 0x12345678;
+
+static uint32_t sim_rand(void)
+{
+  sim_seed ^= sim_seed << 13;
+  sim_seed ^= sim_seed >> 17;
+  sim_seed ^= sim_seed << 5;
+  return sim_seed;
+}
+
+/* Random value in [min, max] */
+static int32_t sim_rand_in(int32_t min, int32_t max)
+{
+  return min + (int32_t)(sim_rand() % (uint32_t)(max - min + 1));
+}
+
+typedef struct
+{
+  LL_LIB_TensorShape_TypeDef info;
+  uint32_t shape[SIM_MAX_RANK];
+  uint32_t axes_offsets[SIM_MAX_RANK];
+} sim_tensor_t;
+
+/* Row-major tensor, the axes may be padded (`gaps`) as for an ATON buffer with aligned lines */
+static uint32_t sim_tensor_init(sim_tensor_t *t, int8_t *buffer, uint32_t rank, const uint32_t *shape, uint8_t nbits,
+                                bool gaps)
+{
+  uint32_t offset = LL_LIB_NBYTES(nbits);
+
+  memset(t, 0, sizeof(*t));
+  for (uint32_t axis = rank; axis-- > 0;)
+  {
+    t->shape[axis] = shape[axis];
+    t->axes_offsets[axis] = offset;
+    offset *= shape[axis];
+    if (gaps && (axis > 0) && ((sim_rand() & 3) == 0))
+    {
+      offset += LL_LIB_NBYTES(nbits) * (uint32_t)sim_rand_in(1, 3);
+    }
+  }
+  t->info.addr_base.p = (unsigned char *)buffer;
+  t->info.offset_start = 0;
+  t->info.offset_end = offset;
+  t->info.ndims = (uint8_t)rank;
+  t->info.nbits = nbits;
+  t->info.shape = t->shape;
+
+  return offset;
+}
+
+static uint8_t sim_rand_nbits(void)
+{
+  static const uint8_t nbits[] = {8, 16, 24, 32};
+  return nbits[sim_rand() % 4];
+}
+
+static void sim_fill(int8_t *buffer, uint32_t size)
+{
+  for (uint32_t i = 0; i < size; i++)
+  {
+    buffer[i] = (int8_t)sim_rand();
+  }
+}
+
+static uint32_t nr_of_mismatches;
+
+static void sim_compare(const char *op, uint32_t run, uint32_t size)
+{
+  bool same = (memcmp(sim_out, sim_ref, size) == 0);
+
+  SIM_CHECK(same);
+  if (!same && (nr_of_mismatches++ < 5))
+  {
+    printf("%s: run %lu differs from the reference\n", op, (unsigned long)run);
+  }
+}
+
+static void test_transpose(void)
+{
+  for (uint32_t run = 0; run < SIM_NB_RUNS; run++)
+  {
+    sim_tensor_t in, out, out_ref;
+    uint32_t rank = (uint32_t)sim_rand_in(3, SIM_MAX_RANK);
+    uint32_t in_shape[SIM_MAX_RANK], out_shape[SIM_MAX_RANK];
+    uint8_t perm[SIM_MAX_RANK];
+    uint8_t nbits = sim_rand_nbits();
+    uint32_t in_size, out_size;
+
+    for (uint32_t axis = 0; axis < rank; axis++)
+    {
+      /* Some long axes for the tiled 2-D transposes */
+      in_shape[axis] = (uint32_t)(((sim_rand() % 8) == 0) ? sim_rand_in(16, 40) : sim_rand_in(1, 6));
+      perm[axis] = (uint8_t)axis;
+    }
+    for (uint32_t axis = rank - 1; axis > 0; axis--)
+    {
+      uint32_t other = sim_rand() % (axis + 1);
+      uint8_t tmp = perm[axis];
+      perm[axis] = perm[other];
+      perm[other] = tmp;
+    }
+    for (uint32_t axis = 0; axis < rank; axis++)
+    {
+      out_shape[axis] = in_shape[perm[axis]];
+    }
+
+    in_size = sim_tensor_init(&in, sim_in, rank, in_shape, nbits, true);
+    out_size = sim_tensor_init(&out, sim_out, rank, out_shape, nbits, (sim_rand() & 1) != 0);
+    if ((in_size > SIM_BUFFER_MAX) || (out_size > SIM_BUFFER_MAX))
+    {
+      continue;
+    }
+    out_ref = out;
+    out_ref.info.addr_base.p = (unsigned char *)sim_ref;
+    out_ref.info.shape = out_ref.shape;
+
+    sim_fill(sim_in, in_size);
+    memset(sim_out, SIM_SENTINEL, out_size);
+    memset(sim_ref, SIM_SENTINEL, out_size);
+
+    SIM_CHECK(LL_ATON_LIB_Transpose(&in.info, in.axes_offsets, &out.info, out.axes_offsets, perm) == LL_ATON_OK);
+    SIM_CHECK(__ll_ref_Transpose(&in.info, in.axes_offsets, &out_ref.info, out_ref.axes_offsets, perm) == LL_ATON_OK);
+    sim_compare("transpose", run, out_size);
+  }
+}
+
+/* Number of indexes of a slice axis */
+static uint32_t sim_slice_size(int32_t start, int32_t end, int32_t step)
+{
+  int32_t span = (step < 0) ? (start - end) : (end - start);
+  int32_t abs_step = (step < 0) ? -step : step;
+
+  return (span <= 0) ? 0 : (uint32_t)((span + abs_step - 1) / abs_step);
+}
+
+/* `end_minus_one`: backwards slices may run down to index 0 (end -1), which the former implementation stops at the
+ * first index of, the expected output is then computed element by element */
+static void test_slice(bool end_minus_one)
+{
+  for (uint32_t run = 0; run < SIM_NB_RUNS; run++)
+  {
+    sim_tensor_t in, out, out_ref;
+    uint32_t rank = (uint32_t)sim_rand_in(3, SIM_MAX_RANK);
+    uint32_t in_shape[SIM_MAX_RANK], out_shape[SIM_MAX_RANK];
+    int32_t starts[SIM_MAX_RANK], ends[SIM_MAX_RANK], steps[SIM_MAX_RANK];
+    uint8_t nbits = sim_rand_nbits();
+    uint32_t in_size, out_size;
+    bool ref_is_exact = true;
+
+    for (uint32_t axis = 0; axis < rank; axis++)
+    {
+      int32_t size = ((sim_rand() % 8) == 0) ? sim_rand_in(16, 40) : sim_rand_in(1, 8);
+      in_shape[axis] = (uint32_t)size;
+      steps[axis] = sim_rand_in(1, 3) * (((sim_rand() % 4) == 0) ? -1 : 1);
+      if (steps[axis] > 0)
+      {
+        starts[axis] = sim_rand_in(0, size - 1);
+        ends[axis] = sim_rand_in(starts[axis] + 1, size);
+      }
+      else
+      {
+        starts[axis] = sim_rand_in(0, size - 1);
+        ends[axis] = (end_minus_one && (sim_rand() & 1)) ? -1 : sim_rand_in(-1, starts[axis] - 1);
+        if ((ends[axis] == -1) && (starts[axis] + steps[axis] > ends[axis]))
+        {
+          ref_is_exact = false;
+        }
+        if (ends[axis] < 0)
+        {
+          ends[axis] = -1;
+        }
+      }
+      out_shape[axis] = sim_slice_size(starts[axis], ends[axis], steps[axis]);
+    }
+    if (!end_minus_one && !ref_is_exact)
+    {
+      continue;
+    }
+
+    in_size = sim_tensor_init(&in, sim_in, rank, in_shape, nbits, true);
+    out_size = sim_tensor_init(&out, sim_out, rank, out_shape, nbits, (sim_rand() & 1) != 0);
+    if ((in_size > SIM_BUFFER_MAX) || (out_size > SIM_BUFFER_MAX))
+    {
+      continue;
+    }
+    out_ref = out;
+    out_ref.info.addr_base.p = (unsigned char *)sim_ref;
+    out_ref.info.shape = out_ref.shape;
+
+    sim_fill(sim_in, in_size);
+    memset(sim_out, SIM_SENTINEL, out_size);
+    memset(sim_ref, SIM_SENTINEL, out_size);
+
+    SIM_CHECK(LL_ATON_LIB_Slice(&in.info, in.axes_offsets, &out.info, out.axes_offsets, rank, starts, ends, steps) ==
+              LL_ATON_OK);
+
+    if (!end_minus_one)
+    {
+      SIM_CHECK(__ll_ref_Slice(&in.info, in.axes_offsets, &out_ref.info, out_ref.axes_offsets, rank, starts, ends,
+                               steps) == LL_ATON_OK);
+    }
+    else
+    {
+      /* Output element `i` reads the input at `start + i * step` on each axis */
+      uint32_t nbytes = LL_LIB_NBYTES(nbits);
+      uint32_t index[SIM_MAX_RANK] = {0};
+      uint32_t nr_of_elems = 1;
+
+      for (uint32_t axis = 0; axis < rank; axis++)
+      {
+        nr_of_elems *= out_shape[axis];
+      }
+      for (uint32_t elem = 0; elem < nr_of_elems; elem++)
+      {
+        uint32_t in_offset = 0, out_offset = 0;
+        for (uint32_t axis = 0; axis < rank; axis++)
+        {
+          in_offset += (uint32_t)(starts[axis] + (int32_t)index[axis] * steps[axis]) * in.axes_offsets[axis];
+          out_offset += index[axis] * out.axes_offsets[axis];
+        }
+        memcpy(&sim_ref[out_offset], &sim_in[in_offset], nbytes);
+        for (uint32_t axis = rank; axis-- > 0;)
+        {
+          if (++index[axis] < out_shape[axis])
+            break;
+          index[axis] = 0;
+        }
+      }
+    }
+    sim_compare(end_minus_one ? "slice down to index 0" : "slice", run, out_size);
+  }
+}
+
+/* Empty slices leave the output untouched */
+static void test_empty_slice(void)
+{
+  sim_tensor_t in, out;
+  const uint32_t shape[3] = {2, 3, 4};
+  const uint32_t out_shape[3] = {2, 3, 4};
+  const int32_t starts[3] = {0, 2, 0};
+  const int32_t ends[3] = {2, 2, 4};
+  const int32_t steps[3] = {1, 1, 1};
+
+  sim_tensor_init(&in, sim_in, 3, shape, 8, false);
+  sim_tensor_init(&out, sim_out, 3, out_shape, 8, false);
+  memset(sim_out, SIM_SENTINEL, 24);
+  memset(sim_ref, SIM_SENTINEL, 24);
+
+  SIM_CHECK(LL_ATON_LIB_Slice(&in.info, in.axes_offsets, &out.info, out.axes_offsets, 3, starts, ends, steps) ==
+            LL_ATON_OK);
+  SIM_CHECK(memcmp(sim_out, sim_ref, 24) == 0);
+}
+
+/* Time of the new and former implementations on an 8-bit 1x32x56x56 tensor */
+static void bench_transpose(const char *name, const uint8_t *perm)
+{
+  const uint32_t shape[4] = {1, 32, 56, 56};
+  uint32_t out_shape[4];
+  sim_tensor_t in, out;
+  uint64_t t0, t1, t2;
+  const uint32_t nb_runs = 50;
+
+  for (uint32_t axis = 0; axis < 4; axis++)
+  {
+    out_shape[axis] = shape[perm[axis]];
+  }
+  sim_tensor_init(&in, sim_in, 4, shape, 8, false);
+  sim_tensor_init(&out, sim_out, 4, out_shape, 8, false);
+  sim_fill(sim_in, in.info.offset_end);
+
+  t0 = sim_time_ns();
+  for (uint32_t run = 0; run < nb_runs; run++)
+  {
+    __ll_ref_Transpose(&in.info, in.axes_offsets, &out.info, out.axes_offsets, perm);
+  }
+  t1 = sim_time_ns();
+  for (uint32_t run = 0; run < nb_runs; run++)
+  {
+    LL_ATON_LIB_Transpose(&in.info, in.axes_offsets, &out.info, out.axes_offsets, perm);
+  }
+  t2 = sim_time_ns();
+
+  printf("%-13s recursive %8.1f us, N-D copy %7.1f us (x%.1f)\n", name, (t1 - t0) / 1000.0 / nb_runs,
+         (t2 - t1) / 1000.0 / nb_runs, (double)(t1 - t0) / (double)(t2 - t1 + 1));
+}
+
+int main(void)
+{
+  static const uint8_t nchw_to_nhwc[4] = {0, 2, 3, 1};
+  static const uint8_t nhwc_to_nchw[4] = {0, 3, 1, 2};
+  static const uint8_t nchw_to_cnhw[4] = {1, 0, 2, 3};
+  static const uint8_t nchw_to_ncwh[4] = {0, 1, 3, 2};
+
+  test_transpose();
+  test_slice(false);
+  test_slice(true);
+  test_empty_slice();
+
+  bench_transpose("NCHW->NHWC", nchw_to_nhwc);
+  bench_transpose("NHWC->NCHW", nhwc_to_nchw);
+  bench_transpose("NCHW->CNHW", nchw_to_cnhw);
+  bench_transpose("NCHW->NCWH", nchw_to_ncwh);
+
+  return sim_report("ll_aton_lib_sw_copy_test");
+}
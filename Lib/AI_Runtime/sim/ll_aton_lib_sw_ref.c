@@ -0,0 +1,566 @@
+/**
+ ******************************************************************************
+ * @file    ll_aton_lib_sw_ref.c
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   Former recursive implementation of the SW `Slice` and `Transpose`
+ *          operators, kept as the reference of ll_aton_lib_sw_copy_test.
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2024 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ll_aton_util.h" // Leave blank line after the include
+
+#include "ll_aton_lib.h"
+#include "ll_aton_lib_sw_operators.h"
+#include "ll_aton_runtime.h"
+
+#include "ll_aton_lib_sw_ref.h"
+
+/* Common data structure(s) */
+typedef struct __ll_stack_lnklst
+{
+  struct __ll_stack_lnklst *back_link;
+  uint32_t axis;
+  uint32_t index;
+} __ll_stack_lnklst_t;
+
+/* Helper Functions */
+static inline void __ll_aton_lib_copy_element(uint8_t nbytes, int32_t index, int8_t *out_target, int8_t *in_target)
+{
+  LL_ATON_LIB_UNUSED(index);
+
+  switch (nbytes)
+  {
+  case 1:
+#if defined(DUMP_DEBUG_SW_OPS)
+    LL_ATON_PRINTF("[%d]\t%d\t@ out: 0x%lx, in: 0x%lx\n", index, *in_target, (uintptr_t)out_target,
+                   (uintptr_t)in_target);
+#endif
+    *out_target = *in_target;
+    return;
+
+  case 2:
+#if defined(DUMP_DEBUG_SW_OPS)
+    LL_ATON_PRINTF("[%d]\t%d\t@ out: 0x%lx, in: 0x%lx\n", index, *((int16_t *)in_target), (uintptr_t)out_target,
+                   (uintptr_t)in_target);
+#endif
+    LL_ATON_ASSERT((((uintptr_t)in_target) % 2) == 0);
+    LL_ATON_ASSERT((((uintptr_t)out_target) % 2) == 0);
+
+    *((int16_t *)out_target) = *((int16_t *)in_target);
+    return;
+
+  case 3: // NOTE: assuming no alignment
+    *out_target++ = *in_target++;
+    *out_target++ = *in_target++;
+    *out_target++ = *in_target++;
+    return;
+
+  case 4:
+#if defined(DUMP_DEBUG_SW_OPS)
+    LL_ATON_PRINTF("[%d]\t%d\t@ out: 0x%lx, in: 0x%lx\n", index, *((int32_t *)in_target), (uintptr_t)out_target,
+                   (uintptr_t)in_target);
+#endif
+    LL_ATON_ASSERT((((uintptr_t)in_target) % 4) == 0);
+    LL_ATON_ASSERT((((uintptr_t)out_target) % 4) == 0);
+
+    *((int32_t *)out_target) = *((int32_t *)in_target);
+    return;
+
+  default:
+    LL_ATON_ASSERT(false);
+    return;
+  }
+}
+
+
+/**
+ * @brief  performs a slice operation on a (multi-dimensional) matrix
+ * @param  input tensor shape structure
+ * @param  output tensor shape structure
+ * @param  slice_rank rank of slice operation's input matrix
+ * @param  slice_starts 1-D tensor of starting indices of corresponding axis from 0 to rank-1
+ * @param  slice_ends 1-D tensor of ending indices (exclusive) of corresponding axis from 0 to rank-1
+ * @param  slice_steps 1-D tensor of slice step of corresponding axis from 0 to rank-1
+ * @retval Error code
+ */
+typedef const struct
+{
+  const LL_LIB_TensorShape_TypeDef *input;
+  const uint32_t *input_axes_offsets;
+  const LL_LIB_TensorShape_TypeDef *output;
+  const uint32_t *output_axes_offsets;
+  uint32_t slice_rank;
+  const int32_t *slice_starts;
+  const int32_t *slice_ends;
+  const int32_t *slice_steps;
+} __ll_slice_params_t;
+
+static inline int32_t __ll_aton_lib_is_in_slice(const __ll_slice_params_t *common_params, __ll_stack_lnklst_t *elem)
+{
+  uint32_t index = elem->index;
+  uint32_t axis = elem->axis;
+
+  uint8_t slice_forwards = (common_params->slice_steps[axis] < 0) ? 0 : 1;
+
+  int32_t ret_numerator;
+  int32_t ret_denominator = abs(common_params->slice_steps[axis]);
+
+  int32_t min;
+  int32_t max;
+
+  if (slice_forwards)
+  {
+    ret_numerator = (index - common_params->slice_starts[axis]);
+    min = common_params->slice_starts[axis];
+    max = common_params->slice_ends[axis];
+  }
+  else
+  {
+    ret_numerator = (common_params->slice_starts[axis] - index);
+    max = common_params->slice_starts[axis] + 1;
+    min = common_params->slice_ends[axis] + 1;
+  }
+
+  if (((index >= min) && (index < max)) && (ret_numerator % ret_denominator == 0))
+  {
+    LL_ATON_ASSERT(ret_numerator >= 0);
+    LL_ATON_ASSERT(ret_denominator > 0);
+
+    return (ret_numerator / ret_denominator);
+  }
+  else
+  {
+    return -1;
+  }
+}
+
+static int8_t *__ll_slice_get_input_and_output_base_pos(const __ll_slice_params_t *common_params,
+                                                        __ll_stack_lnklst_t *linked_stack_list, int8_t **base_in_target)
+{
+  LL_ATON_ASSERT(linked_stack_list != NULL);
+
+  int8_t *in_target = (int8_t *)LL_Buffer_addr_start(common_params->input);
+  int8_t *out_target = (int8_t *)LL_Buffer_addr_start(common_params->output);
+
+  LL_ATON_ASSERT(linked_stack_list->axis == (common_params->slice_rank - 1));
+
+  for (__ll_stack_lnklst_t *elem = linked_stack_list->back_link; elem != NULL; elem = elem->back_link)
+  {
+    LL_ATON_ASSERT(elem->axis < (common_params->slice_rank - 1));
+    uint32_t axis = elem->axis;
+
+    /* input */
+    int32_t in_axis_size = common_params->input_axes_offsets[axis];
+    in_target += (elem->index * in_axis_size);
+
+    int32_t out_index;
+    if ((out_index = __ll_aton_lib_is_in_slice(common_params, elem)) >= 0)
+    {
+      /* output */
+      int32_t out_axis_size = common_params->output_axes_offsets[axis];
+      out_target += (out_index * out_axis_size);
+    }
+    else
+    {
+      return NULL;
+    }
+  }
+
+  *base_in_target = in_target;
+  return out_target;
+}
+
+static inline void __ll_slice_copy_elem(const __ll_slice_params_t *common_params,
+                                        __ll_stack_lnklst_t *linked_stack_list, uint32_t in_offset, uint32_t out_offset,
+                                        int8_t *base_in_target, int8_t *base_out_target)
+{
+  const uint8_t byte_size = LL_LIB_NBYTES(common_params->input->nbits);
+
+  int32_t out_index;
+  if ((out_index = __ll_aton_lib_is_in_slice(common_params, linked_stack_list)) >= 0)
+  {
+    /* determine input/output position */
+    int8_t *in_target = base_in_target + (linked_stack_list->index * in_offset);
+    int8_t *out_target = base_out_target + (out_index * out_offset);
+
+    __ll_aton_lib_copy_element(byte_size, out_index, out_target, in_target);
+  }
+}
+
+static void __ll_aton_lib_slice(uint32_t curr_in_axis, __ll_stack_lnklst_t *back_link,
+                                const __ll_slice_params_t *common_params)
+{
+  uint8_t slice_forwards = (common_params->slice_steps[curr_in_axis] < 0) ? 0 : 1;
+  __ll_stack_lnklst_t linked_stack_list = {
+      .back_link = back_link, .axis = curr_in_axis, .index = common_params->slice_starts[curr_in_axis]};
+
+  const uint32_t index_end = common_params->slice_ends[curr_in_axis];
+
+  if (curr_in_axis < (common_params->slice_rank - 1))
+  { // intermediate axis
+    if (slice_forwards)
+    { // slicing forwards
+      for (; linked_stack_list.index < index_end; linked_stack_list.index++)
+      {
+        __ll_aton_lib_slice(curr_in_axis + 1, &linked_stack_list, common_params);
+      }
+    }
+    else
+    { // slicing backwards
+      do
+      {
+        __ll_aton_lib_slice(curr_in_axis + 1, &linked_stack_list, common_params);
+        linked_stack_list.index--;
+      } while (linked_stack_list.index > index_end);
+    }
+  }
+  else
+  { // last axis
+    LL_ATON_ASSERT(curr_in_axis == (common_params->slice_rank - 1));
+
+    /* Calculate input base positions */
+    int8_t *base_in_target;
+    int8_t *base_out_target =
+        __ll_slice_get_input_and_output_base_pos(common_params, &linked_stack_list, &base_in_target);
+
+    if (base_out_target == NULL)
+      return;
+
+    uint32_t curr_in_axis_input_offset = common_params->input_axes_offsets[curr_in_axis];
+    uint32_t curr_in_axis_output_offset = common_params->output_axes_offsets[curr_in_axis];
+
+    if (slice_forwards)
+    { // slicing forwards
+      for (; linked_stack_list.index < index_end; linked_stack_list.index++)
+      {
+        __ll_slice_copy_elem(common_params, &linked_stack_list, curr_in_axis_input_offset, curr_in_axis_output_offset,
+                             base_in_target, base_out_target);
+      }
+    }
+    else
+    { // slicing backwards
+      do
+      {
+        __ll_slice_copy_elem(common_params, &linked_stack_list, curr_in_axis_input_offset, curr_in_axis_output_offset,
+                             base_in_target, base_out_target);
+        linked_stack_list.index--;
+      } while (linked_stack_list.index > index_end);
+    }
+  }
+}
+
+int __ll_ref_Slice(const LL_LIB_TensorShape_TypeDef *input, const uint32_t *input_axes_offsets,
+                   const LL_LIB_TensorShape_TypeDef *output, const uint32_t *output_axes_offsets,
+                   uint32_t slice_rank, const int32_t *slice_starts, const int32_t *slice_ends,
+                   const int32_t *slice_steps)
+{
+  if (slice_rank != input->ndims)
+  {
+    __LL_LIB_ERROR(_ERR_RANK, LL_ATON_INVALID_PARAM);
+  }
+
+  if (input->ndims != output->ndims)
+  {
+    __LL_LIB_ERROR(_ERR_RANK, LL_ATON_INVALID_PARAM);
+  }
+
+  if (input->nbits != output->nbits)
+  { // TODO: should we support this?
+    __LL_LIB_ERROR(_ERR_NBITS, LL_ATON_INVALID_PARAM);
+  }
+
+  if ((input->nbits < 8) || (input->nbits > 32))
+  {
+    __LL_LIB_ERROR(_ERR_NBITS, LL_ATON_INVALID_PARAM);
+  }
+
+  const __ll_slice_params_t common_params = {.input = input,
+                                             .input_axes_offsets = input_axes_offsets,
+                                             .output = output,
+                                             .output_axes_offsets = output_axes_offsets,
+                                             .slice_rank = slice_rank,
+                                             .slice_starts = slice_starts,
+                                             .slice_ends = slice_ends,
+                                             .slice_steps = slice_steps};
+
+  __ll_aton_lib_slice(0, NULL, &common_params);
+
+  return LL_ATON_OK; // TODO
+}
+
+
+/**
+ * @brief  performs a transpose operation on a (multi-dimensional) matrix
+ * @param  input tensor shape structure
+ * @param  output tensor shape structure
+ * @param  perm permutation to apply
+ * @retval Error code
+ */
+typedef const struct
+{
+  uint32_t rank;
+  const uint8_t *perm;
+  const uint32_t *in_shape_aton;
+  const uint32_t *in_axis_off;
+  const uint32_t *out_axis_off;
+  const uint8_t byte_size;
+  const int8_t *in_tensor;
+  int8_t *out_tensor;
+} __ll_transp_params_t;
+
+static inline uint32_t __ll_transp_find_input_index(__ll_stack_lnklst_t *elem, const uint8_t *perm,
+                                                    uint32_t output_axis)
+{
+  uint32_t input_axis = (uint32_t)perm[output_axis];
+  for (; elem != NULL; elem = elem->back_link)
+  {
+    if (elem->axis == input_axis)
+    {
+      return elem->index;
+    }
+  }
+  LL_ATON_ASSERT(false); // should never be reached
+  return 0;
+}
+
+static inline int8_t *__ll_transp_get_output_base_pos(uint32_t inner_out_axis,
+                                                      const __ll_transp_params_t *common_params,
+                                                      __ll_stack_lnklst_t *linked_stack_list)
+{
+  LL_ATON_ASSERT(linked_stack_list != NULL);
+  int8_t *target = common_params->out_tensor;
+
+  for (uint32_t output_axis = 0; output_axis < common_params->rank; output_axis++)
+  {
+    if (output_axis == inner_out_axis)
+      continue;
+
+    uint32_t axis_size = common_params->out_axis_off[output_axis];
+    uint32_t input_index = __ll_transp_find_input_index(linked_stack_list, common_params->perm, output_axis);
+    target += (input_index * axis_size);
+  }
+
+  return target;
+}
+
+static int8_t *__ll_transp_get_input_base_pos(const __ll_transp_params_t *common_params,
+                                              __ll_stack_lnklst_t *linked_stack_list)
+{
+  LL_ATON_ASSERT(linked_stack_list != NULL);
+
+  const int8_t *target = common_params->in_tensor;
+
+  LL_ATON_ASSERT(linked_stack_list->axis == (common_params->rank - 1));
+
+  for (__ll_stack_lnklst_t *elem = linked_stack_list->back_link; elem != NULL; elem = elem->back_link)
+  {
+    LL_ATON_ASSERT(elem->axis < (common_params->rank - 1));
+    uint32_t axis_size = common_params->in_axis_off[elem->axis];
+    target += (elem->index * axis_size);
+  }
+
+  return (int8_t *)target;
+}
+
+static void __ll_aton_lib_transpose(uint32_t curr_in_axis, uint32_t inner_out_axis, __ll_stack_lnklst_t *back_link,
+                                    const __ll_transp_params_t *common_params)
+{
+  __ll_stack_lnklst_t linked_stack_list = {.back_link = back_link, .axis = curr_in_axis, .index = 0};
+
+  if (curr_in_axis < (common_params->rank - 1))
+  { // intermediate axis
+    for (; linked_stack_list.index < common_params->in_shape_aton[linked_stack_list.axis]; linked_stack_list.index++)
+    {
+      __ll_aton_lib_transpose(curr_in_axis + 1, inner_out_axis, &linked_stack_list, common_params);
+    }
+  }
+  else
+  { // last axis
+    LL_ATON_ASSERT(curr_in_axis == (common_params->rank - 1));
+
+    /* Calculate input/output base positions */
+    int8_t *base_out_target = __ll_transp_get_output_base_pos(inner_out_axis, common_params, &linked_stack_list);
+    int8_t *base_in_target = __ll_transp_get_input_base_pos(common_params, &linked_stack_list);
+    uint32_t out_axes_offset = common_params->out_axis_off[inner_out_axis];
+
+    const uint32_t end_index = common_params->in_shape_aton[(common_params->rank - 1)];
+    const uint8_t byte_size = common_params->byte_size;
+
+    if (byte_size != out_axes_offset)
+    {
+      for (; linked_stack_list.index < end_index; linked_stack_list.index++)
+      {
+        /* determine input/output position */
+        int8_t *in_target = base_in_target + (linked_stack_list.index * byte_size);
+        int8_t *out_target = base_out_target + (linked_stack_list.index * out_axes_offset);
+
+        __ll_aton_lib_copy_element(byte_size, linked_stack_list.index, out_target, in_target);
+      }
+    }
+    else
+    {
+      uint32_t size_in_bytes = (end_index - linked_stack_list.index) * byte_size; // `byte_size == out_axes_offset`
+
+      int8_t *in_target = base_in_target + (linked_stack_list.index * byte_size);
+      int8_t *out_target =
+          base_out_target + (linked_stack_list.index * out_axes_offset); // `byte_size == out_axes_offset`
+
+      memcpy(out_target, in_target, size_in_bytes);
+    }
+  }
+}
+
+static inline uint32_t __ll_transp_find_input_index_3or4(uint32_t *indexes, const uint8_t *perm, uint32_t output_axis)
+{
+  uint32_t input_axis = (uint32_t)perm[output_axis];
+  return indexes[input_axis];
+}
+
+static inline int8_t *__ll_transp_get_output_base_pos_3or4(uint32_t inner_out_axis,
+                                                           const __ll_transp_params_t *common_params, uint32_t *indexes)
+{
+  int8_t *target = common_params->out_tensor;
+
+  for (uint32_t output_axis = 0; output_axis < common_params->rank; output_axis++)
+  {
+    if (output_axis == inner_out_axis)
+      continue;
+
+    LL_ATON_ASSERT((uint32_t)common_params->perm[output_axis] < (common_params->rank - 1));
+
+    uint32_t input_index = __ll_transp_find_input_index_3or4(indexes, common_params->perm, output_axis);
+    uint32_t axis_size = common_params->out_axis_off[output_axis];
+    target += (input_index * axis_size);
+  }
+
+  return target;
+}
+
+static int8_t *__ll_transp_get_input_base_pos_3or4(const __ll_transp_params_t *common_params, uint32_t *indexes)
+{
+  const int8_t *target = common_params->in_tensor;
+
+  for (uint32_t axis = 0; axis < (common_params->rank - 1); axis++)
+  {
+    uint32_t axis_size = common_params->in_axis_off[axis];
+    target += (indexes[axis] * axis_size);
+  }
+
+  return (int8_t *)target;
+}
+
+static inline uint32_t __ll_transp_get_inner_out_axis(const __ll_transp_params_t *common_params)
+{
+  for (unsigned int i = 0; i < common_params->rank; i++)
+  {
+    if (((uint32_t)common_params->perm[i]) == (common_params->rank - 1))
+      return i;
+  }
+  LL_ATON_ASSERT(false);
+  return common_params->rank; // make compiler happy
+}
+
+static void __ll_aton_lib_transpose_3or4(const __ll_transp_params_t *common_params)
+{
+  LL_ATON_ASSERT((common_params->rank == 4) || ((common_params->rank == 3)));
+  uint32_t inner_out_axis = __ll_transp_get_inner_out_axis(common_params);
+  uint32_t out_axes_offset = common_params->out_axis_off[inner_out_axis];
+  const uint8_t byte_size = common_params->byte_size;
+
+  uint32_t size_n = (common_params->rank == 4) ? common_params->in_shape_aton[0] : 1;
+  uint32_t size_c = (common_params->rank == 4) ? common_params->in_shape_aton[1] : common_params->in_shape_aton[0];
+  uint32_t size_h = (common_params->rank == 4) ? common_params->in_shape_aton[2] : common_params->in_shape_aton[1];
+  uint32_t size_w = (common_params->rank == 4) ? common_params->in_shape_aton[3] : common_params->in_shape_aton[2];
+
+  for (uint32_t index_n = 0; index_n < size_n; index_n++)
+  {
+    for (uint32_t index_c = 0; index_c < size_c; index_c++)
+    {
+      for (uint32_t index_h = 0; index_h < size_h; index_h++)
+      {
+        uint32_t indexes_array[] = {index_n, index_c, index_h};
+        uint32_t *indexes = (common_params->rank == 4) ? &indexes_array[0] : &indexes_array[1];
+
+        int8_t *base_out_target = __ll_transp_get_output_base_pos_3or4(inner_out_axis, common_params, indexes);
+        int8_t *base_in_target = __ll_transp_get_input_base_pos_3or4(common_params, indexes);
+
+        if (byte_size != out_axes_offset)
+        {
+          for (uint32_t index_w = 0; index_w < size_w; index_w++)
+          {
+            /* determine input/output position */
+            int8_t *in_target = base_in_target + (index_w * byte_size);
+            int8_t *out_target = base_out_target + (index_w * out_axes_offset);
+
+            __ll_aton_lib_copy_element(byte_size, index_w, out_target, in_target);
+          }
+        }
+        else
+        {
+          uint32_t size_in_bytes = size_w * byte_size; // `byte_size == out_axes_offset`
+          memcpy(base_out_target, base_in_target, size_in_bytes);
+        }
+      }
+    }
+  }
+}
+
+int __ll_ref_Transpose(const LL_LIB_TensorShape_TypeDef *input, const uint32_t *input_axes_offsets,
+                       const LL_LIB_TensorShape_TypeDef *output, const uint32_t *output_axes_offsets,
+                       const uint8_t *perm)
+{
+  if (input->ndims <= 2)
+  {
+    __LL_LIB_ERROR(_ERR_RANK, LL_ATON_INVALID_PARAM);
+  }
+
+  if (input->ndims != output->ndims)
+  {
+    __LL_LIB_ERROR(_ERR_RANK, LL_ATON_INVALID_PARAM);
+  }
+
+  if (input->nbits != output->nbits)
+  { // TODO: should we support this?
+    __LL_LIB_ERROR(_ERR_NBITS, LL_ATON_INVALID_PARAM);
+  }
+
+  if ((input->nbits < 8) || (input->nbits > 32))
+  {
+    __LL_LIB_ERROR(_ERR_NBITS, LL_ATON_INVALID_PARAM);
+  }
+
+  const __ll_transp_params_t common_params = {.perm = perm,
+                                              .rank = input->ndims,
+                                              .in_shape_aton = input->shape,
+                                              .in_axis_off = input_axes_offsets,
+                                              .out_axis_off = output_axes_offsets,
+                                              .byte_size = LL_LIB_NBYTES(input->nbits),
+                                              .in_tensor = (int8_t *)LL_Buffer_addr_start(input),
+                                              .out_tensor = (int8_t *)LL_Buffer_addr_start(output)};
+
+  if (input->ndims <= 4)
+  {
+    __ll_aton_lib_transpose_3or4(&common_params);
+  }
+  else
+  {
+    uint32_t inner_out_axis = __ll_transp_get_inner_out_axis(&common_params);
+    __ll_aton_lib_transpose(0, inner_out_axis, NULL, &common_params);
+  }
+
+  return LL_ATON_OK;
+}
@@ -0,0 +1,35 @@
+/**
+ ******************************************************************************
+ * @file    ll_aton_lib_sw_ref.h
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   Former recursive implementation of the SW `Slice` and `Transpose`
+ *          operators, kept as the reference of ll_aton_lib_sw_copy_test.
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef __LL_ATON_LIB_SW_REF_H
+#define __LL_ATON_LIB_SW_REF_H
+
+#include "ll_aton_lib_sw_operators.h"
+
+/* Same parameters as `LL_ATON_LIB_Slice()`. Backwards slices ending at -1 stop after their first index. */
+int __ll_ref_Slice(const LL_LIB_TensorShape_TypeDef *input, const uint32_t *input_axes_offsets,
+                   const LL_LIB_TensorShape_TypeDef *output, const uint32_t *output_axes_offsets, uint32_t slice_rank,
+                   const int32_t *slice_starts, const int32_t *slice_ends, const int32_t *slice_steps);
+
+/* Same parameters as `LL_ATON_LIB_Transpose()` */
+int __ll_ref_Transpose(const LL_LIB_TensorShape_TypeDef *input, const uint32_t *input_axes_offsets,
+                       const LL_LIB_TensorShape_TypeDef *output, const uint32_t *output_axes_offsets,
+                       const uint8_t *perm);
+
+#endif // __LL_ATON_LIB_SW_REF_H
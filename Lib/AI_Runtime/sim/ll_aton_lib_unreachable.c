@@ -0,0 +1,44 @@
+/**
+ ******************************************************************************
+ * @file    ll_aton_lib_unreachable.c
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   LL ATON lib entries referenced by the callbacks given to the
+ *          relocatable models. The host tests of the relocatable runtime
+ *          never call the model code, so these only have to link: they do
+ *          not include `ll_aton_lib.h` and abort if ever reached.
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <stdlib.h>
+
+#define SIM_UNREACHABLE(_func)                                                                                         \
+  void _func(void);                                                                                                    \
+  void _func(void)                                                                                                     \
+  {                                                                                                                    \
+    abort();                                                                                                           \
+  }
+
+SIM_UNREACHABLE(LL_ATON_LIB_Concat)
+SIM_UNREACHABLE(LL_ATON_LIB_Cast)
+SIM_UNREACHABLE(LL_ATON_LIB_Softmax)
+SIM_UNREACHABLE(LL_ATON_LIB_DMA_ImageToRow)
+SIM_UNREACHABLE(LL_ATON_LIB_DMA_SpaceToDepth)
+SIM_UNREACHABLE(LL_ATON_LIB_DMA_RowToImage)
+SIM_UNREACHABLE(LL_ATON_LIB_DMA_DepthToSpace)
+SIM_UNREACHABLE(LL_ATON_LIB_DMA_Outputs_Flat_Copy)
+SIM_UNREACHABLE(LL_ATON_LIB_DMA_Outputs_Slice_SplitLike)
+SIM_UNREACHABLE(LL_ATON_LIB_DMA_Outputs_Channel_Split_Aton)
+SIM_UNREACHABLE(LL_ATON_LIB_DMA_Outputs_Channel_Split_Batched)
+SIM_UNREACHABLE(LL_ATON_LIB_DMA_Pad_Memset)
+SIM_UNREACHABLE(LL_ATON_LIB_DMA_Pad_Filling)
+SIM_UNREACHABLE(LL_ATON_LIB_DMA_Transpose)
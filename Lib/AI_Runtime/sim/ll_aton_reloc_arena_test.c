@@ -0,0 +1,363 @@
+/**
+ ******************************************************************************
+ * @file    ll_aton_reloc_arena_test.c
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   Host unit tests of the arena planner of the relocatable models:
+ *          sharing between exclusive models, concurrent models kept apart,
+ *          mixed external RAM pools never shared, first-fit placement order,
+ *          conflicts of the fixed pools and arena too small.
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ll_aton_sim.h"
+
+/* Unit under test, its static functions are reached from here */
+#include "ll_aton_reloc_arena.c"
+
+/*
+ * Relocatable models stand-in: `file_ptr` is the index of the model in `sim_bins`, only the external RAM size and
+ * the memory pool descriptors are read by the planner
+ */
+#define SIM_MAX_BINS  8
+#define SIM_MAX_POOLS 4
+
+#define SIM_ARENA_ADDR 0x90000000UL
+
+#define SIM_POOL(_type, _dtype, _id) (((_type) << 24) | ((_dtype) << 16) | (_id))
+#define SIM_EXT_ACTIV                SIM_POOL(AI_RELOC_MPOOL_TYPE_RELOC, AI_RELOC_MPOOL_DTYPE_ACTIV, 1)
+#define SIM_EXT_MIXED                SIM_POOL(AI_RELOC_MPOOL_TYPE_RELOC, AI_RELOC_MPOOL_DTYPE_MIXED, 1)
+#define SIM_FIXED_ACTIV              SIM_POOL(AI_RELOC_MPOOL_TYPE_RESET, AI_RELOC_MPOOL_DTYPE_ACTIV, 0)
+#define SIM_FIXED_PARAM              SIM_POOL(AI_RELOC_MPOOL_TYPE_COPY, AI_RELOC_MPOOL_DTYPE_PARAM, 0)
+
+typedef struct
+{
+  uint32_t ext_ram_sz;
+  bool invalid;
+  uint32_t nb_pools;
+  ll_aton_reloc_mem_pool_desc pools[SIM_MAX_POOLS];
+} sim_bin_t;
+
+static sim_bin_t sim_bins[SIM_MAX_BINS];
+
+int ll_aton_reloc_get_info(const uintptr_t file_ptr, ll_aton_reloc_info *rt)
+{
+  if ((file_ptr >= SIM_MAX_BINS) || sim_bins[file_ptr].invalid)
+    return AI_RELOC_RT_ERR_INVALID_BIN;
+
+  memset(rt, 0, sizeof(*rt));
+  rt->c_name = "sim";
+  rt->ext_ram_sz = sim_bins[file_ptr].ext_ram_sz;
+  return AI_RELOC_RT_ERR_NONE;
+}
+
+ll_aton_reloc_mem_pool_desc *ll_aton_reloc_get_mem_pool_desc(const uintptr_t file_ptr, int index)
+{
+  if ((file_ptr >= SIM_MAX_BINS) || (index < 0) || ((uint32_t)index >= sim_bins[file_ptr].nb_pools))
+    return NULL;
+
+  return &sim_bins[file_ptr].pools[index];
+}
+
+static ll_aton_reloc_arena_model sim_models[AI_RELOC_ARENA_MAX_MODELS + 1];
+static ll_aton_reloc_arena_report sim_report_res;
+
+/* Model `i` with an external RAM pool of `ext_ram_sz` bytes (activations only unless `mixed`) */
+static void sim_model(uint32_t i, uint32_t ext_ram_sz, bool mixed, uint32_t concurrent_mask)
+{
+  sim_bin_t *bin = &sim_bins[i];
+
+  memset(bin, 0, sizeof(*bin));
+  bin->ext_ram_sz = ext_ram_sz;
+  bin->pools[0] = (ll_aton_reloc_mem_pool_desc){"ext", mixed ? SIM_EXT_MIXED : SIM_EXT_ACTIV, 0, 0, ext_ram_sz};
+  bin->nb_pools = 1;
+
+  memset(&sim_models[i], 0, sizeof(sim_models[i]));
+  sim_models[i].file_ptr = i;
+  sim_models[i].concurrent_mask = concurrent_mask;
+}
+
+static void sim_fixed_pool(uint32_t i, uint32_t flags, uint32_t dst, uint32_t size)
+{
+  sim_bin_t *bin = &sim_bins[i];
+
+  bin->pools[bin->nb_pools++] = (ll_aton_reloc_mem_pool_desc){"fixed", flags, 0, dst, size};
+}
+
+static void sim_reset(void)
+{
+  memset(sim_bins, 0, sizeof(sim_bins));
+  memset(sim_models, 0, sizeof(sim_models));
+  memset(&sim_report_res, 0, sizeof(sim_report_res));
+}
+
+static int sim_plan(size_t arena_size, uint32_t nb_models)
+{
+  return ll_aton_reloc_arena_plan(SIM_ARENA_ADDR, arena_size, sim_models, nb_models, &sim_report_res);
+}
+
+static uint32_t sim_offset(uint32_t i)
+{
+  return (uint32_t)(sim_models[i].ext_ram_addr - SIM_ARENA_ADDR);
+}
+
+/* Pools of models which may run at the same time, or holding params, never overlap */
+static bool sim_placement_is_valid(uint32_t nb_models)
+{
+  for (uint32_t i = 0; i < nb_models; i++)
+  {
+    for (uint32_t j = i + 1; j < nb_models; j++)
+    {
+      bool may_share = !_arena_concurrent(sim_models, i, j) && !_arena_ext_ram_is_persistent(i) &&
+                       !_arena_ext_ram_is_persistent(j);
+
+      if (!may_share && _arena_overlap(sim_models[i].ext_ram_addr, sim_models[i].ext_ram_size,
+                                       sim_models[j].ext_ram_addr, sim_models[j].ext_ram_size))
+        return false;
+    }
+  }
+  return true;
+}
+
+/* Models never running at the same time share the arena */
+static void test_exclusive(void)
+{
+  sim_reset();
+  sim_model(0, 1000, false, 0);
+  sim_model(1, 3000, false, 0);
+  sim_model(2, 2000, false, 0);
+
+  SIM_CHECK(sim_plan(4096, 3) == AI_RELOC_RT_ERR_NONE);
+  for (uint32_t i = 0; i < 3; i++)
+    SIM_CHECK(sim_models[i].ext_ram_addr == SIM_ARENA_ADDR);
+
+  /* Sizes rounded up to the MCU cache lines */
+  SIM_CHECK(sim_models[0].ext_ram_size == 1024);
+  SIM_CHECK(sim_models[1].ext_ram_size == 3008);
+  SIM_CHECK(sim_models[2].ext_ram_size == 2016);
+  SIM_CHECK(sim_report_res.arena_size == 3008);
+  SIM_CHECK(sim_report_res.unshared_size == 1024 + 3008 + 2016);
+  SIM_CHECK(sim_report_res.conflicts == 0);
+}
+
+/* Models which may run at the same time get their own pools, either side of the mask is enough */
+static void test_concurrent(void)
+{
+  sim_reset();
+  sim_model(0, 1024, false, 1 << 1);
+  sim_model(1, 2048, false, 0);
+  sim_model(2, 512, false, 1 << 0);
+
+  SIM_CHECK(sim_plan(8192, 3) == AI_RELOC_RT_ERR_NONE);
+  SIM_CHECK(sim_placement_is_valid(3));
+  SIM_CHECK(sim_offset(1) == 0);
+  SIM_CHECK(sim_offset(0) == 2048);
+  /* Not concurrent with model 1: placed under it */
+  SIM_CHECK(sim_offset(2) == 0);
+  SIM_CHECK(sim_report_res.arena_size == 3072);
+
+  /* Every one with every other one: nothing shared */
+  sim_reset();
+  for (uint32_t i = 0; i < 4; i++)
+    sim_model(i, 256 * (i + 1), false, 0xF & ~(1u << i));
+  SIM_CHECK(sim_plan(8192, 4) == AI_RELOC_RT_ERR_NONE);
+  SIM_CHECK(sim_placement_is_valid(4));
+  SIM_CHECK(sim_report_res.arena_size == sim_report_res.unshared_size);
+  SIM_CHECK(sim_report_res.arena_size == 256 * (1 + 2 + 3 + 4));
+}
+
+/* External RAM pools holding params are kept from one inference to the other: never shared, even between exclusive
+ * models */
+static void test_mixed(void)
+{
+  sim_reset();
+  sim_model(0, 2048, false, 0);
+  sim_model(1, 1024, true, 0);
+  sim_model(2, 512, false, 0);
+
+  SIM_CHECK(sim_plan(8192, 3) == AI_RELOC_RT_ERR_NONE);
+  SIM_CHECK(sim_placement_is_valid(3));
+  SIM_CHECK(sim_offset(0) == 0);
+  SIM_CHECK(sim_offset(1) == 2048);
+  SIM_CHECK(sim_offset(2) == 0);
+  SIM_CHECK(sim_report_res.arena_size == 3072);
+
+  /* Two mixed pools */
+  sim_model(2, 512, true, 0);
+  SIM_CHECK(sim_plan(8192, 3) == AI_RELOC_RT_ERR_NONE);
+  SIM_CHECK(sim_placement_is_valid(3));
+  SIM_CHECK(sim_offset(2) == 3072);
+  SIM_CHECK(sim_report_res.arena_size == 3584);
+
+  /* Only the external RAM pool (id 1) matters */
+  sim_reset();
+  sim_model(0, 1024, false, 0);
+  sim_model(1, 1024, false, 0);
+  sim_bins[1].pools[1] = (ll_aton_reloc_mem_pool_desc){
+      "other", SIM_POOL(AI_RELOC_MPOOL_TYPE_RELOC, AI_RELOC_MPOOL_DTYPE_MIXED, 2), 0, 0, 64};
+  sim_bins[1].nb_pools = 2;
+  SIM_CHECK(sim_plan(8192, 2) == AI_RELOC_RT_ERR_NONE);
+  SIM_CHECK(sim_report_res.arena_size == 1024);
+}
+
+/* Largest pool first, each one at the lowest offset not overlapping the pools it can't share (holes included) */
+static void test_first_fit(void)
+{
+  sim_reset();
+  /* Placed in order 1 (1024), 3 (768), 0 (512), 2 and 4 (256, index order) */
+  sim_model(0, 512, false, (1 << 1) | (1 << 3));
+  sim_model(1, 1024, false, 0);
+  sim_model(2, 256, false, (1 << 3) | (1 << 4));
+  sim_model(3, 768, false, 0);
+  sim_model(4, 256, false, 1 << 1);
+
+  SIM_CHECK(sim_plan(8192, 5) == AI_RELOC_RT_ERR_NONE);
+  SIM_CHECK(sim_placement_is_valid(5));
+  SIM_CHECK(sim_offset(1) == 0);
+  SIM_CHECK(sim_offset(3) == 0);
+  /* Past 1 and 3 */
+  SIM_CHECK(sim_offset(0) == 1024);
+  /* Past 3 only, in the hole under 0 */
+  SIM_CHECK(sim_offset(2) == 768);
+  /* Past 1, 2 ends right there: shares the pool of 0 */
+  SIM_CHECK(sim_offset(4) == 1024);
+  SIM_CHECK(sim_report_res.arena_size == 1536);
+
+  /* Same size: index order */
+  sim_reset();
+  sim_model(0, 512, false, 1 << 1);
+  sim_model(1, 512, false, 0);
+  SIM_CHECK(sim_plan(8192, 2) == AI_RELOC_RT_ERR_NONE);
+  SIM_CHECK((sim_offset(0) == 0) && (sim_offset(1) == 512));
+
+  /* No external RAM: nothing placed */
+  sim_reset();
+  sim_model(0, 0, false, 1 << 1);
+  sim_model(1, 512, false, 0);
+  SIM_CHECK(sim_plan(8192, 2) == AI_RELOC_RT_ERR_NONE);
+  SIM_CHECK(sim_models[0].ext_ram_addr == 0);
+  SIM_CHECK(sim_offset(1) == 0);
+  SIM_CHECK(sim_report_res.arena_size == 512);
+
+  /* Random masks: the placement is always valid and never larger than without sharing */
+  srand(3);
+  for (uint32_t run = 0; run < 200; run++)
+  {
+    const uint32_t nb_models = 2 + (uint32_t)rand() % 7;
+
+    sim_reset();
+    for (uint32_t i = 0; i < nb_models; i++)
+      sim_model(i, 32 * (1 + (uint32_t)rand() % 64), (rand() % 8) == 0, (uint32_t)rand() & ((1u << nb_models) - 1));
+    SIM_CHECK(sim_plan(1 << 20, nb_models) == AI_RELOC_RT_ERR_NONE);
+    SIM_CHECK(sim_placement_is_valid(nb_models));
+    SIM_CHECK(sim_report_res.arena_size <= sim_report_res.unshared_size);
+  }
+}
+
+/* Fixed pools: activations of exclusive models may overlap, params and concurrent models may not */
+static void test_fixed_pools(void)
+{
+  sim_reset();
+  sim_model(0, 1024, false, 0);
+  sim_model(1, 1024, false, 0);
+  sim_fixed_pool(0, SIM_FIXED_ACTIV, 0x34100000, 0x1000);
+  sim_fixed_pool(1, SIM_FIXED_ACTIV, 0x34100800, 0x1000);
+  SIM_CHECK(sim_plan(8192, 2) == AI_RELOC_RT_ERR_NONE);
+  SIM_CHECK(sim_report_res.conflicts == 0);
+
+  /* Concurrent */
+  sim_models[1].concurrent_mask = 1 << 0;
+  SIM_CHECK(sim_plan(8192, 2) == AI_RELOC_RT_ERR_PARAM_ADDR);
+  SIM_CHECK(sim_report_res.conflicts == 1);
+  SIM_CHECK((sim_models[0].ext_ram_addr == 0) && (sim_models[1].ext_ram_addr == 0));
+
+  /* Params overlapping activations of an exclusive model, and another params pool */
+  sim_models[1].concurrent_mask = 0;
+  sim_fixed_pool(0, SIM_FIXED_PARAM, 0x34200000, 0x100);
+  sim_fixed_pool(1, SIM_FIXED_PARAM, 0x342000F0, 0x100);
+  sim_bins[1].pools[1].dst = 0x34200080;
+  SIM_CHECK(sim_plan(8192, 2) == AI_RELOC_RT_ERR_PARAM_ADDR);
+  SIM_CHECK(sim_report_res.conflicts == 2);
+
+  /* Touching pools and empty pools don't overlap */
+  sim_bins[1].pools[1].dst = 0x34200100;
+  sim_bins[1].pools[2].dst = 0x34200100;
+  sim_fixed_pool(1, SIM_FIXED_PARAM, 0x34200000, 0);
+  SIM_CHECK(sim_plan(8192, 2) == AI_RELOC_RT_ERR_NONE);
+  SIM_CHECK(sim_report_res.conflicts == 0);
+
+  /* The external RAM pools (RELOC) are left to the planner */
+  sim_reset();
+  sim_model(0, 1024, false, 1 << 1);
+  sim_model(1, 1024, false, 0);
+  SIM_CHECK(sim_plan(8192, 2) == AI_RELOC_RT_ERR_NONE);
+  SIM_CHECK(sim_report_res.conflicts == 0);
+}
+
+/* Arena too small: `AI_RELOC_RT_ERR_MEMORY`, the report gives the size needed */
+static void test_memory(void)
+{
+  sim_reset();
+  sim_model(0, 1024, false, 1 << 1);
+  sim_model(1, 1000, false, 0);
+
+  SIM_CHECK(sim_plan(2047, 2) == AI_RELOC_RT_ERR_MEMORY);
+  SIM_CHECK(sim_report_res.arena_size == 2048);
+  SIM_CHECK((sim_models[0].ext_ram_addr == 0) && (sim_models[1].ext_ram_addr == 0));
+
+  /* Exactly the size needed */
+  SIM_CHECK(sim_plan(2048, 2) == AI_RELOC_RT_ERR_NONE);
+  SIM_CHECK(sim_models[1].ext_ram_addr == SIM_ARENA_ADDR + 1024);
+
+  /* Checked before the conflicts */
+  sim_fixed_pool(0, SIM_FIXED_PARAM, 0x34200000, 0x100);
+  sim_fixed_pool(1, SIM_FIXED_PARAM, 0x34200000, 0x100);
+  SIM_CHECK(sim_plan(1024, 2) == AI_RELOC_RT_ERR_MEMORY);
+  SIM_CHECK(sim_report_res.conflicts == 1);
+
+  /* Without report */
+  SIM_CHECK(ll_aton_reloc_arena_plan(SIM_ARENA_ADDR, 1024, sim_models, 2, NULL) == AI_RELOC_RT_ERR_MEMORY);
+}
+
+static void test_args(void)
+{
+  sim_reset();
+  for (uint32_t i = 0; i <= AI_RELOC_ARENA_MAX_MODELS; i++)
+    sim_models[i].file_ptr = 0;
+  sim_model(0, 1024, false, 0);
+
+  SIM_CHECK(ll_aton_reloc_arena_plan(SIM_ARENA_ADDR, 8192, NULL, 1, NULL) == AI_RELOC_RT_ERR_ARG);
+  SIM_CHECK(sim_plan(8192, 0) == AI_RELOC_RT_ERR_ARG);
+  SIM_CHECK(sim_plan(8192, AI_RELOC_ARENA_MAX_MODELS) == AI_RELOC_RT_ERR_NONE);
+  SIM_CHECK(sim_plan(8192, AI_RELOC_ARENA_MAX_MODELS + 1) == AI_RELOC_RT_ERR_ARG);
+  SIM_CHECK(ll_aton_reloc_arena_plan(SIM_ARENA_ADDR + 16, 8192, sim_models, 1, NULL) == AI_RELOC_RT_ERR_PARAM_ADDR);
+
+  sim_bins[0].invalid = true;
+  SIM_CHECK(sim_plan(8192, 1) == AI_RELOC_RT_ERR_INVALID_BIN);
+}
+
+int main(void)
+{
+  test_exclusive();
+  test_concurrent();
+  test_mixed();
+  test_first_fit();
+  test_fixed_pools();
+  test_memory();
+  test_args();
+
+  return sim_report("ll_aton_reloc_arena_test");
+}
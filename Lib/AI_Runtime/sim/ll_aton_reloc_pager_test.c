@@ -0,0 +1,513 @@
+/**
+ ******************************************************************************
+ * @file    ll_aton_reloc_pager_test.c
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   Host test of the staged install of the relocatable models: a
+ *          synthetic relocatable binary is installed from a simulated
+ *          memory-mapped NOR flash with a modelled read latency, then the
+ *          epoch blocks of a few inferences are replayed as the runtime
+ *          drives them, checking that the weights of each epoch block are in
+ *          place when it runs and that the copies overlap the NPU execution.
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ll_aton_sim.h"
+
+#include "ll_aton_lib.h"
+#include "ll_aton_reloc_network.h"
+#include "ll_aton_version.h"
+
+/*
+ * Simulated octal NOR flash (memory-mapped): each read costs a fixed latency (command, address and dummy cycles)
+ * then a transfer time (200 MHz DTR, 8 bits)
+ */
+#define SIM_FLASH_LATENCY_NS 150
+#define SIM_FLASH_NS_PER_KB  2560
+
+#define SIM_FLASH_SIZE  (2 * 1024 * 1024)
+#define SIM_RO_SIZE     0x1000     /* hdr, text and rodata */
+#define SIM_REL_OFF     0x1400     /* rel section, after the data section */
+#define SIM_PARAMS_OFF  0x2000     /* params/weights blob */
+#define SIM_XIP_PARAMS  0x10000    /* weights read in-place (RELOC params memory pool) */
+#define SIM_WINDOW_SIZE (48 * 1024) /* paged weights window, two for double buffering */
+
+/* RAM layout of the data/got/bss sections */
+#define SIM_RAM_CTX    0x000
+#define SIM_RAM_MPOOLS 0x100
+#define SIM_RAM_GOT    0x200
+#define SIM_RAM_GOT_N  8
+#define SIM_RAM_REL    0x230
+#define SIM_RAM_BSS    0x240
+#define SIM_RAM_END    0x400
+
+#define SIM_NB_BLOCKS     24
+#define SIM_NB_INFERENCES 3
+#define SIM_MAX_PAGES     (3 * SIM_NB_BLOCKS)
+
+/* The relocatable runtime stores addresses on 32 bits: the test is linked at low addresses (no PIE) and uses
+ * static buffers only */
+static uint8_t sim_flash[SIM_FLASH_SIZE] __attribute__((aligned(8)));
+static uint8_t sim_exec_ram[64 * 1024] __attribute__((aligned(8)));
+static uint8_t sim_window[2 * SIM_WINDOW_SIZE] __attribute__((aligned(8)));
+
+static NN_Instance_TypeDef sim_instance;
+static ll_aton_reloc_page sim_pages[SIM_MAX_PAGES];
+static ll_aton_reloc_pager sim_pager;
+static uint32_t sim_nr_of_pages;
+
+static EpochBlock_ItemTypeDef sim_blocks[SIM_NB_BLOCKS];
+static EpochBlock_ItemTypeDef sim_inserted[2]; /* inserted by the LL ATON lib from the hybrid epoch blocks */
+static uint32_t sim_exec_ns[SIM_NB_BLOCKS];
+
+static uint64_t sim_flash_ns;    /* time spent reading the flash */
+static uint32_t sim_flash_bytes; /* bytes read from the flash */
+static uint32_t sim_page_copies[SIM_MAX_PAGES];
+static const ll_aton_reloc_page *sim_dirty_page; /* copied, D-cache not yet cleaned */
+
+static uint32_t sim_seed = 0x2545F491;
+
+static uint32_t sim_rand(void)
+{
+  sim_seed ^= sim_seed << 13;
+  sim_seed ^= sim_seed >> 17;
+  sim_seed ^= sim_seed << 5;
+  return sim_seed;
+}
+
+static bool sim_in_flash(uintptr_t addr)
+{
+  return (addr >= (uintptr_t)sim_flash) && (addr < (uintptr_t)sim_flash + SIM_FLASH_SIZE);
+}
+
+static void sim_flash_read(uintptr_t src, size_t size)
+{
+  if (sim_in_flash(src))
+  {
+    sim_flash_ns += SIM_FLASH_LATENCY_NS + ((uint64_t)size * SIM_FLASH_NS_PER_KB) / 1024;
+    sim_flash_bytes += (uint32_t)size;
+  }
+}
+
+/* Copies of the install: only the reads of the flash are accounted */
+static void *sim_memcpy(void *dst, const void *src, size_t size)
+{
+  sim_flash_read((uintptr_t)src, size);
+  return memcpy(dst, src, size);
+}
+
+/* Copy of a page of the paging plan: from the params blob in flash to a window */
+static void sim_page_copy(uint32_t dst, uintptr_t src, uint32_t size)
+{
+  const ll_aton_reloc_page *page = &sim_pages[sim_pager.next];
+
+  SIM_CHECK(sim_dirty_page == NULL);
+  SIM_CHECK((dst == page->dst) && (size == page->size));
+  SIM_CHECK(src == sim_pager.params_addr + page->foff);
+  SIM_CHECK(sim_in_flash(src) && sim_in_flash(src + size - 1));
+  SIM_CHECK((dst >= (uintptr_t)sim_window) && (dst + size <= (uintptr_t)sim_window + sizeof(sim_window)));
+
+  sim_flash_read(src, size);
+  memcpy((void *)(uintptr_t)dst, (const void *)src, size);
+  sim_page_copies[sim_pager.next]++;
+  sim_dirty_page = page;
+}
+
+/* Cache maintenance of the STM32N6 platform: the copied pages must be cleaned for the NPU */
+int mcu_cache_clean_invalidate_range(uint32_t start_addr, uint32_t end_addr)
+{
+  if ((sim_dirty_page != NULL) && (start_addr <= sim_dirty_page->dst) &&
+      (end_addr >= sim_dirty_page->dst + sim_dirty_page->size))
+  {
+    sim_dirty_page = NULL;
+  }
+  return 0;
+}
+
+int mcu_cache_clean_range(uint32_t start_addr, uint32_t end_addr)
+{
+  (void)start_addr;
+  (void)end_addr;
+  return 0;
+}
+
+int mcu_cache_invalidate_range(uint32_t start_addr, uint32_t end_addr)
+{
+  (void)start_addr;
+  (void)end_addr;
+  return 0;
+}
+
+void npu_cache_invalidate(void)
+{
+}
+
+void npu_cache_clean_range(uint32_t start_addr, uint32_t end_addr)
+{
+  (void)start_addr;
+  (void)end_addr;
+}
+
+void npu_cache_clean_invalidate_range(uint32_t start_addr, uint32_t end_addr)
+{
+  (void)start_addr;
+  (void)end_addr;
+}
+
+void SCB_InvalidateICache_by_Addr(volatile void *addr, int32_t isize)
+{
+  (void)addr;
+  (void)isize;
+}
+
+/* Unit under test: the Cortex-M helpers calling the model code are never run, their assembly is compiled out */
+#define AI_RELOC_PAGE_COPY(_dst, _src, _size) sim_page_copy((uint32_t)(_dst), (uintptr_t)(_src), (uint32_t)(_size))
+#define memcpy(_dst, _src, _size)             sim_memcpy(_dst, _src, _size)
+#define __asm__
+#define __asm
+#define volatile(...)
+#define naked noinline
+#include "ll_aton_reloc_network.c"
+#undef naked
+#undef volatile
+#undef __asm
+#undef __asm__
+#undef memcpy
+
+/*
+ * Synthetic relocatable binary
+ */
+
+#define SIM_MPOOL_FLAGS(_type, _dtype, _attr, _id) (((_type) << 24) | ((_dtype) << 16) | ((_attr) << 8) | (_id))
+
+static struct ai_reloc_bin_hdr *sim_hdr = (struct ai_reloc_bin_hdr *)sim_flash;
+static uint8_t *const sim_data = sim_flash + SIM_RO_SIZE;
+static uint8_t *const sim_params = sim_flash + SIM_PARAMS_OFF;
+static ll_aton_reloc_mem_pool_desc *const sim_mpools = (ll_aton_reloc_mem_pool_desc *)(sim_flash + SIM_RO_SIZE +
+                                                                                         SIM_RAM_MPOOLS);
+
+static const uint32_t sim_got[SIM_RAM_GOT_N] = {
+    AI_RELOC_RAM_BASE | SIM_RAM_BSS, AI_RELOC_FLASH_BASE | 0x40, AI_RELOC_PARAM_0_BASE | 0x100, 0,
+    AI_RELOC_RAM_BASE | SIM_RAM_CTX, 0,                          AI_RELOC_PARAM_0_BASE | 0x800, 0,
+};
+
+static void sim_build_binary(void)
+{
+  uint32_t paged_off = SIM_XIP_PARAMS;
+  uint32_t nr_of_paged_blocks = 0;
+
+  for (uint32_t i = 0; i < SIM_FLASH_SIZE; i++)
+  {
+    sim_flash[i] = (uint8_t)sim_rand();
+  }
+
+  memset(sim_hdr, 0, sizeof(*sim_hdr));
+  sim_hdr->hdr.magic = AI_RELOC_MAGIC;
+  sim_hdr->sect.data_start = AI_RELOC_RAM_BASE;
+  sim_hdr->sect.data_end = AI_RELOC_RAM_BASE | SIM_RAM_BSS;
+  sim_hdr->sect.data_data = AI_RELOC_FLASH_BASE | SIM_RO_SIZE;
+  sim_hdr->sect.bss_start = AI_RELOC_RAM_BASE | SIM_RAM_BSS;
+  sim_hdr->sect.bss_end = AI_RELOC_RAM_BASE | SIM_RAM_END;
+  sim_hdr->sect.got_start = AI_RELOC_RAM_BASE | SIM_RAM_GOT;
+  sim_hdr->sect.got_end = AI_RELOC_RAM_BASE | (SIM_RAM_GOT + sizeof(sim_got));
+  sim_hdr->sect.rel_start = AI_RELOC_FLASH_BASE | SIM_REL_OFF;
+  sim_hdr->sect.rel_end = AI_RELOC_FLASH_BASE | (SIM_REL_OFF + 4);
+  sim_hdr->sect.params_start = AI_RELOC_RAM_BASE | SIM_RAM_MPOOLS;
+  sim_hdr->sect.params_offset = AI_RELOC_FLASH_BASE | SIM_PARAMS_OFF;
+  sim_hdr->vec.ctx = AI_RELOC_RAM_BASE | SIM_RAM_CTX;
+
+  /* Data section: RT context, memory pools, GOT and a word relocated through the rel section */
+  memset(sim_data, 0, SIM_RAM_BSS);
+  memcpy(sim_data + SIM_RAM_GOT, sim_got, sizeof(sim_got));
+  *(uint32_t *)(sim_data + SIM_RAM_REL) = AI_RELOC_PARAM_0_BASE | 0x10;
+  *(uint32_t *)(sim_flash + SIM_REL_OFF) = AI_RELOC_RAM_BASE | SIM_RAM_REL;
+
+  sim_mpools[0] = (ll_aton_reloc_mem_pool_desc){
+      .name = "xSPI2",
+      .flags = SIM_MPOOL_FLAGS(AI_RELOC_MPOOL_TYPE_RELOC, AI_RELOC_MPOOL_DTYPE_PARAM, AI_RELOC_MPOOL_DATTR_READ, 0),
+      .foff = 0,
+      .dst = 0,
+      .size = SIM_XIP_PARAMS};
+  sim_mpools[1] = (ll_aton_reloc_mem_pool_desc){
+      .name = "npuRAM3",
+      .flags = SIM_MPOOL_FLAGS(AI_RELOC_MPOOL_TYPE_COPY, AI_RELOC_MPOOL_DTYPE_PARAM, AI_RELOC_MPOOL_DATTR_READ, 0),
+      .foff = SIM_XIP_PARAMS,
+      .dst = (uint32_t)(uintptr_t)sim_window,
+      .size = sizeof(sim_window)};
+
+  /* Epoch blocks: some SW ones without weights, some hybrid ones inserting lib epoch blocks. The weights of the
+   * paged epoch blocks go alternately to the two windows, in 1 to 3 pages */
+  sim_nr_of_pages = 0;
+  for (uint32_t block = 0; block < SIM_NB_BLOCKS; block++)
+  {
+    uint32_t kind = sim_rand() % 6;
+
+    sim_blocks[block].flags = (kind == 0)   ? EpochBlock_Flags_pure_sw
+                              : (kind == 1) ? EpochBlock_Flags_hybrid
+                                            : EpochBlock_Flags_pure_hw;
+    sim_exec_ns[block] = 20000 + sim_rand() % 300000;
+    if ((kind == 0) && (block != 0))
+    {
+      continue;
+    }
+
+    uint32_t nr_of_pages = 1 + sim_rand() % 3;
+    uint32_t dst = (uint32_t)(uintptr_t)sim_window + (nr_of_paged_blocks++ % 2) * SIM_WINDOW_SIZE;
+    for (uint32_t i = 0; i < nr_of_pages; i++)
+    {
+      uint32_t size = (1024 + sim_rand() % (SIM_WINDOW_SIZE / 3 - 1024)) & ~7UL;
+      sim_pages[sim_nr_of_pages++] = (ll_aton_reloc_page){
+          .epoch_block = block, .foff = paged_off, .dst = dst, .size = size};
+      paged_off += size;
+      dst += size;
+    }
+  }
+  sim_blocks[SIM_NB_BLOCKS - 1].flags |= EpochBlock_Flags_last_eb;
+  sim_inserted[0].flags = EpochBlock_Flags_internal | EpochBlock_Flags_pure_sw;
+  sim_inserted[1].flags = EpochBlock_Flags_internal | EpochBlock_Flags_pure_sw | EpochBlock_Flags_last_eb;
+
+  assert(SIM_PARAMS_OFF + paged_off <= SIM_FLASH_SIZE);
+  sim_pager = (ll_aton_reloc_pager){.pages = sim_pages, .nb_pages = sim_nr_of_pages};
+}
+
+static int sim_install(uint32_t mode, ll_aton_reloc_pager *pager)
+{
+  memset(sim_exec_ram, 0, sizeof(sim_exec_ram));
+  memset(sim_window, 0xA5, sizeof(sim_window));
+  sim_flash_ns = 0;
+  sim_flash_bytes = 0;
+
+  return _ai_reloc_install((uintptr_t)sim_flash, (uintptr_t)sim_exec_ram, sizeof(sim_exec_ram), 0, 0, 0, mode, pager,
+                           &sim_instance);
+}
+
+static bool sim_window_untouched(void)
+{
+  for (uint32_t i = 0; i < sizeof(sim_window); i++)
+  {
+    if (sim_window[i] != 0xA5)
+      return false;
+  }
+  return true;
+}
+
+/* Install, check the relocations and that the weights are not copied up-front */
+static void test_install(uint32_t mode)
+{
+  const uintptr_t ram = (uintptr_t)sim_exec_ram + ((mode & AI_RELOC_RT_LOAD_MODE_COPY) ? SIM_RO_SIZE : 0);
+  const uintptr_t rom = (mode & AI_RELOC_RT_LOAD_MODE_COPY) ? (uintptr_t)sim_exec_ram : (uintptr_t)sim_flash;
+  const uintptr_t params_0 = (uintptr_t)sim_params;
+
+  SIM_CHECK(sim_install(mode | AI_RELOC_RT_LOAD_MODE_STAGED, &sim_pager) == AI_RELOC_RT_ERR_NONE);
+
+  const uint32_t *got = (const uint32_t *)(ram + SIM_RAM_GOT);
+  SIM_CHECK(got[0] == ram + SIM_RAM_BSS);
+  SIM_CHECK(got[1] == rom + 0x40);
+  SIM_CHECK(got[2] == params_0 + 0x100);
+  SIM_CHECK(got[3] == 0);
+  SIM_CHECK(got[4] == ram + SIM_RAM_CTX);
+  SIM_CHECK(got[6] == params_0 + 0x800);
+  SIM_CHECK(*(const uint32_t *)(ram + SIM_RAM_REL) == params_0 + 0x10);
+
+  const struct ai_reloc_rt_ctx *rt_ctx = (const struct ai_reloc_rt_ctx *)(ram + SIM_RAM_CTX);
+  SIM_CHECK(rt_ctx->ll_instance == &sim_instance);
+  SIM_CHECK(rt_ctx->file_addr == (uint32_t)(uintptr_t)sim_flash);
+  SIM_CHECK(sim_instance.exec_state.inst_reloc == (uint32_t)(uintptr_t)rt_ctx);
+  SIM_CHECK(sim_instance.exec_state.inst_pager == (uint32_t)(uintptr_t)&sim_pager);
+  SIM_CHECK(sim_pager.params_addr == params_0);
+
+  /* Only the code/data of the model are read, the paged weights are left in flash */
+  const uint32_t code_bytes = SIM_RAM_BSS + ((mode & AI_RELOC_RT_LOAD_MODE_COPY) ? SIM_RO_SIZE : 0);
+  SIM_CHECK(sim_flash_bytes == code_bytes);
+  SIM_CHECK(sim_window_untouched());
+
+  printf("install %s+STAGED: %5lu bytes read from flash, %6.1f us\n",
+         (mode & AI_RELOC_RT_LOAD_MODE_COPY) ? "COPY" : "XIP ", (unsigned long)sim_flash_bytes, sim_flash_ns / 1e3);
+
+  /* Without staging, the COPY params memory pool is filled at install */
+  SIM_CHECK(sim_install(mode, NULL) == AI_RELOC_RT_ERR_NONE);
+  SIM_CHECK(sim_flash_bytes == code_bytes + sizeof(sim_window));
+  SIM_CHECK(memcmp(sim_window, sim_params + SIM_XIP_PARAMS, sizeof(sim_window)) == 0);
+  SIM_CHECK(sim_instance.exec_state.inst_pager == 0);
+}
+
+/* Plans the install must reject */
+static void test_invalid_plans(void)
+{
+  ll_aton_reloc_page pages[2] = {sim_pages[0], sim_pages[1]};
+  ll_aton_reloc_pager pager = {.pages = pages, .nb_pages = 2};
+
+  SIM_CHECK(sim_install(AI_RELOC_RT_LOAD_MODE_XIP | AI_RELOC_RT_LOAD_MODE_STAGED, NULL) == AI_RELOC_RT_ERR_ARG);
+
+  /* Not sorted by epoch block */
+  pages[0].epoch_block = pages[1].epoch_block + 1;
+  SIM_CHECK(sim_install(AI_RELOC_RT_LOAD_MODE_XIP | AI_RELOC_RT_LOAD_MODE_STAGED, &pager) == AI_RELOC_RT_ERR_ARG);
+  pages[0] = sim_pages[0];
+
+  /* Out of the COPY params memory pool */
+  pages[1].dst = (uint32_t)(uintptr_t)sim_window + sizeof(sim_window) - 8;
+  SIM_CHECK(sim_install(AI_RELOC_RT_LOAD_MODE_XIP | AI_RELOC_RT_LOAD_MODE_STAGED, &pager) ==
+            AI_RELOC_RT_ERR_PARAM_DESC);
+  pages[1] = sim_pages[1];
+  SIM_CHECK(sim_install(AI_RELOC_RT_LOAD_MODE_XIP | AI_RELOC_RT_LOAD_MODE_STAGED, &pager) == AI_RELOC_RT_ERR_NONE);
+
+  /* The NPU cache can't be maintained while the NPU runs */
+  const uint32_t flags = sim_mpools[1].flags;
+  sim_mpools[1].flags |= AI_RELOC_MPOOL_DATTR_CACHEABLE << 8;
+  SIM_CHECK(sim_install(AI_RELOC_RT_LOAD_MODE_XIP | AI_RELOC_RT_LOAD_MODE_STAGED, &sim_pager) ==
+            AI_RELOC_RT_ERR_PARAM_DESC);
+  sim_mpools[1].flags = flags;
+}
+
+/*
+ * Replay of the inferences
+ */
+
+typedef struct
+{
+  uint64_t total_ns; /* inference time */
+  uint64_t stall_ns; /* NPU waiting for weights */
+  uint64_t npu_ns;   /* NPU busy */
+  uint64_t copy_ns;  /* flash reads of the weights */
+} sim_replay_t;
+
+static bool sim_block_pages_in_place(uint32_t block)
+{
+  for (uint32_t i = 0; i < sim_nr_of_pages; i++)
+  {
+    const ll_aton_reloc_page *page = &sim_pages[i];
+    if ((page->epoch_block == block) &&
+        (memcmp((const void *)(uintptr_t)page->dst, sim_params + page->foff, page->size) != 0))
+      return false;
+  }
+  return true;
+}
+
+/* As `__LL_ATON_RT_ExecStartEpochBlock()`: the pages are loaded before the epoch block starts, the pages of the
+ * next epoch block while the NPU executes it */
+static void sim_run_block(const EpochBlock_ItemTypeDef *first, const EpochBlock_ItemTypeDef *eb, uint64_t exec_ns,
+                          sim_replay_t *replay)
+{
+  const bool is_network_block = (first == sim_blocks);
+  uint64_t flash_ns = sim_flash_ns;
+
+  ai_rel_network_page_in(sim_instance.exec_state.inst_pager, first, eb);
+  SIM_CHECK(sim_dirty_page == NULL);
+
+  const uint64_t stall_ns = sim_flash_ns - flash_ns;
+  replay->stall_ns += stall_ns;
+  replay->total_ns += stall_ns;
+
+  /* Only the first epoch block of an inference waits for its weights */
+  if (is_network_block)
+  {
+    SIM_CHECK(sim_block_pages_in_place((uint32_t)(eb - first)));
+    SIM_CHECK((eb == first) || (stall_ns == 0));
+  }
+
+  flash_ns = sim_flash_ns;
+  ai_rel_network_page_ahead(sim_instance.exec_state.inst_pager, first, eb);
+  SIM_CHECK(sim_dirty_page == NULL);
+
+  /* The NPU reads the weights of the epoch block while the next ones are copied */
+  const uint64_t ahead_ns = sim_flash_ns - flash_ns;
+  if (is_network_block)
+  {
+    SIM_CHECK(sim_block_pages_in_place((uint32_t)(eb - first)));
+  }
+
+  replay->npu_ns += exec_ns;
+  replay->total_ns += (ahead_ns > exec_ns) ? ahead_ns : exec_ns;
+  replay->stall_ns += (ahead_ns > exec_ns) ? (ahead_ns - exec_ns) : 0;
+}
+
+static void sim_run_inference(sim_replay_t *replay)
+{
+  const uint64_t flash_ns = sim_flash_ns;
+
+  memset(replay, 0, sizeof(*replay));
+  memset(sim_page_copies, 0, sizeof(sim_page_copies));
+
+  for (uint32_t block = 0; block < SIM_NB_BLOCKS; block++)
+  {
+    sim_run_block(sim_blocks, &sim_blocks[block], sim_exec_ns[block], replay);
+
+    if (EpochBlock_IsEpochHybrid(&sim_blocks[block]))
+    {
+      sim_run_block(sim_inserted, &sim_inserted[0], 15000, replay);
+      sim_run_block(sim_inserted, &sim_inserted[1], 15000, replay);
+    }
+  }
+  replay->copy_ns = sim_flash_ns - flash_ns;
+
+  /* Each page is copied once per inference */
+  for (uint32_t i = 0; i < sim_nr_of_pages; i++)
+  {
+    SIM_CHECK(sim_page_copies[i] == 1);
+  }
+}
+
+static void test_replay(uint32_t mode)
+{
+  const char *mode_name = (mode & AI_RELOC_RT_LOAD_MODE_COPY) ? "COPY" : "XIP ";
+  uint32_t paged_bytes = 0;
+
+  for (uint32_t i = 0; i < sim_nr_of_pages; i++)
+  {
+    paged_bytes += sim_pages[i].size;
+  }
+
+  SIM_CHECK(sim_install(mode | AI_RELOC_RT_LOAD_MODE_STAGED, &sim_pager) == AI_RELOC_RT_ERR_NONE);
+
+  for (uint32_t inference = 0; inference < SIM_NB_INFERENCES; inference++)
+  {
+    sim_replay_t replay;
+
+    sim_run_inference(&replay);
+
+    /* The NPU only waits for the pages of the first epoch block and the copies longer than an epoch block */
+    SIM_CHECK(replay.total_ns == replay.npu_ns + replay.stall_ns);
+    SIM_CHECK(replay.total_ns < replay.npu_ns + replay.copy_ns);
+
+    if ((inference == 0) && (mode & AI_RELOC_RT_LOAD_MODE_XIP))
+    {
+      printf("%lu epoch blocks, %lu pages, %lu KB streamed from flash (%.1f us of reads) per inference\n",
+             (unsigned long)SIM_NB_BLOCKS, (unsigned long)sim_nr_of_pages, (unsigned long)(paged_bytes / 1024),
+             replay.copy_ns / 1e3);
+    }
+    if (inference == 0)
+    {
+      printf("inference %s+STAGED: %.1f us, NPU busy %.1f us, waiting for weights %.1f us (%.1f us without paging "
+             "ahead)\n",
+             mode_name, replay.total_ns / 1e3, replay.npu_ns / 1e3, replay.stall_ns / 1e3, replay.copy_ns / 1e3);
+    }
+  }
+}
+
+int main(void)
+{
+  sim_build_binary();
+
+  test_install(AI_RELOC_RT_LOAD_MODE_XIP);
+  test_install(AI_RELOC_RT_LOAD_MODE_COPY);
+  test_invalid_plans();
+  test_replay(AI_RELOC_RT_LOAD_MODE_XIP);
+  test_replay(AI_RELOC_RT_LOAD_MODE_COPY);
+
+  return sim_report("ll_aton_reloc_pager_test");
+}
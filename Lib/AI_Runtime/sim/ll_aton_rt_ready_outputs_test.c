@@ -0,0 +1,344 @@
+/**
+ ******************************************************************************
+ * @file    ll_aton_rt_ready_outputs_test.c
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   Host unit tests of the early signalling of the output buffers
+ *          (`LL_ATON_RT_Callbacktype_OUTPUT_READY`): an output written over
+ *          several epochs is only signalled once its last writer has ended,
+ *          each output is signalled once, inserted epoch block arrays and
+ *          pending hybrid epochs do not end an epoch, and epoch blobs defer
+ *          the signals to the end of the inference when epochs are counted.
+ *          Built with and without `LL_ATON_EB_DBG_INFO`.
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ll_aton_sim.h"
+
+/* Unit under test, its static functions are reached from here. The functions accessing the ATON IP are never called,
+ * they are dropped at link time (see Makefile.sim) */
+#include "ll_aton_runtime.c"
+
+#define SIM_MAX_EBS     64
+#define SIM_NB_EPOCHS   6
+#define SIM_NB_OUTPUTS  4
+#define SIM_NOT_SIGNALLED 0xFFFFu
+
+/* Outputs of the simulated network (plus a parameter buffer which is never signalled) and the epochs writing each of
+ * them, numbered from 0: output 1 is written by epochs 1 to 4, i.e. its last writer is epoch 4 */
+static const uint32_t sim_writers[SIM_NB_OUTPUTS] = {
+    (1u << 2),
+    (1u << 1) | (1u << 2) | (1u << 3) | (1u << 4),
+    (1u << 0) | (1u << 5),
+    (1u << 3),
+};
+
+static LL_Buffer_InfoTypeDef sim_outputs[SIM_NB_OUTPUTS + 2];
+static EpochBlock_ItemTypeDef sim_ebs[SIM_MAX_EBS];
+static EpochBlock_ItemTypeDef sim_lib_ebs[2];
+static NN_Interface_TypeDef sim_interface;
+static NN_Instance_TypeDef sim_instance;
+
+/* Epochs of the network ended so far, as seen by the test */
+static uint32_t sim_epochs_ended;
+static uint16_t sim_signalled_at[SIM_NB_OUTPUTS];
+static uint32_t sim_nr_of_signals;
+
+static const LL_Buffer_InfoTypeDef *sim_output_buffers_info(void)
+{
+  return sim_outputs;
+}
+
+static void sim_callback(LL_ATON_RT_Callbacktype_t ctype, const NN_Instance_TypeDef *nn_instance,
+                         const EpochBlock_ItemTypeDef *eb)
+{
+  uint32_t num = LL_ATON_RT_Get_Ready_Output(nn_instance);
+
+  (void)eb;
+  if (ctype != LL_ATON_RT_Callbacktype_OUTPUT_READY)
+  {
+    return;
+  }
+
+  sim_nr_of_signals++;
+  SIM_CHECK(num < SIM_NB_OUTPUTS);
+  if (num < SIM_NB_OUTPUTS)
+  {
+    SIM_CHECK(sim_signalled_at[num] == SIM_NOT_SIGNALLED);
+    sim_signalled_at[num] = (uint16_t)sim_epochs_ended;
+  }
+}
+
+/* Last epoch writing the output, numbered from `base` as the generated `epoch` fields */
+static uint16_t sim_last_writer(uint32_t num, uint32_t base)
+{
+  return (uint16_t)(31 - __builtin_clz(sim_writers[num]) + base);
+}
+
+/* `epoch` of each output is its last writer, numbered from `base`, the parameter buffer is written by epoch 0 */
+static void sim_outputs_init(uint32_t base)
+{
+  memset(sim_outputs, 0, sizeof(sim_outputs));
+  for (uint32_t i = 0, num = 0; i < SIM_NB_OUTPUTS + 1; i++)
+  {
+    sim_outputs[i].name = "out";
+    if (i == 2)
+    {
+      sim_outputs[i].is_param = 1;
+      sim_outputs[i].epoch = (uint16_t)base;
+      continue;
+    }
+    sim_outputs[i].epoch = sim_last_writer(num++, base);
+  }
+
+  memset(&sim_interface, 0, sizeof(sim_interface));
+  sim_interface.network_name = "sim";
+  sim_interface.output_buffers_info = sim_output_buffers_info;
+
+  memset(&sim_instance, 0, sizeof(sim_instance));
+  sim_instance.network = &sim_interface;
+  sim_instance.exec_state.epoch_callback_function = sim_callback;
+  __LL_ATON_RT_ResetReadyOutputs(&sim_instance);
+
+  for (uint32_t num = 0; num < SIM_NB_OUTPUTS; num++)
+  {
+    sim_signalled_at[num] = SIM_NOT_SIGNALLED;
+  }
+  sim_epochs_ended = 0;
+  sim_nr_of_signals = 0;
+}
+
+static uint32_t sim_add_eb(uint32_t n, uint16_t flags, int16_t first, int16_t last)
+{
+  memset(&sim_ebs[n], 0, sizeof(sim_ebs[n]));
+  sim_ebs[n].flags = flags;
+#ifdef LL_ATON_EB_DBG_INFO
+  sim_ebs[n].epoch_num = first;
+  sim_ebs[n].last_epoch_num = last;
+#else
+  (void)first;
+  (void)last;
+#endif
+  return n + 1;
+}
+
+/* Epoch blocks of the network, numbered from `base`: epochs made of one or two epoch blocks, the epochs from
+ * `blob_first` to `blob_last` (if any) in a single epoch blob */
+static uint32_t sim_ebs_init(uint32_t base, int32_t blob_first, int32_t blob_last)
+{
+  uint32_t n = 0;
+
+  for (int32_t e = 0; e < SIM_NB_EPOCHS; e++)
+  {
+    int16_t num = (int16_t)(e + base);
+
+    if (e == blob_first)
+    {
+      n = sim_add_eb(n, EpochBlock_Flags_blob | EpochBlock_Flags_epoch_start | EpochBlock_Flags_epoch_end, num,
+                     (int16_t)(blob_last + base));
+      e = blob_last;
+      continue;
+    }
+    if ((e % 2) != 0)
+    {
+      n = sim_add_eb(n, EpochBlock_Flags_epoch_start | EpochBlock_Flags_pure_hw, num, num);
+      n = sim_add_eb(n, EpochBlock_Flags_epoch_end | EpochBlock_Flags_pure_sw, num, num);
+    }
+    else
+    {
+      n = sim_add_eb(n, EpochBlock_Flags_epoch_start | EpochBlock_Flags_epoch_end | EpochBlock_Flags_hybrid, num,
+                     num);
+    }
+  }
+
+  return sim_add_eb(n, EpochBlock_Flags_last_eb, -1, -1);
+}
+
+/* Epochs covered by an epoch block (the ones numbered as the network, from 0) */
+static uint32_t sim_eb_last_epoch(uint32_t index, int32_t blob_last)
+{
+  uint32_t e = 0;
+
+  for (uint32_t i = 0; i <= index; i++)
+  {
+    if (EpochBlock_IsEpochBlob(&sim_ebs[i]))
+    {
+      e = (uint32_t)blob_last + 1;
+    }
+    else if (EpochBlock_IsEpochEnd(&sim_ebs[i]))
+    {
+      e++;
+    }
+  }
+
+  return e;
+}
+
+/* Ends the epoch blocks as `__LL_ATON_RT_ExecEndEpochBlock()` and `LL_ATON_RT_RunEpochBlock()` do: a hybrid epoch is
+ * first ended with its SW part pending, an inserted epoch block array runs in the middle of epoch 3 */
+static void sim_run(uint32_t nr_of_ebs, int32_t blob_last)
+{
+  for (uint32_t i = 0; i < nr_of_ebs; i++)
+  {
+    const EpochBlock_ItemTypeDef *eb = &sim_ebs[i];
+
+    if (EpochBlock_IsLastEpochBlock(eb))
+    {
+      __LL_ATON_RT_SignalReadyOutputs(eb, &sim_instance, true);
+      break;
+    }
+
+    if (EpochBlock_IsEpochHybrid(eb))
+    {
+      sim_instance.exec_state.next_epoch_block = &sim_lib_ebs[0];
+      __LL_ATON_RT_SignalReadyOutputs(eb, &sim_instance, false);
+      sim_instance.exec_state.next_epoch_block = NULL;
+    }
+
+    if (EpochBlock_IsEpochPureHW(eb) && (sim_epochs_ended == 3))
+    {
+      sim_instance.exec_state.saved_current_epoch_block = eb;
+      for (uint32_t j = 0; j < 2; j++)
+      {
+        __LL_ATON_RT_SignalReadyOutputs(&sim_lib_ebs[j], &sim_instance, false);
+      }
+      sim_instance.exec_state.saved_current_epoch_block = NULL;
+    }
+
+    sim_epochs_ended = sim_eb_last_epoch(i, blob_last);
+    __LL_ATON_RT_SignalReadyOutputs(eb, &sim_instance, false);
+  }
+}
+
+/* Outputs are signalled once, never before their last writer has ended and, when epochs are counted (i.e. one epoch
+ * late when numbered from 1), at most `late` epochs after it */
+static void sim_check_signals(uint32_t late)
+{
+  SIM_CHECK(sim_nr_of_signals == SIM_NB_OUTPUTS);
+  SIM_CHECK(sim_instance.exec_state.ready_outputs == ((1u << SIM_NB_OUTPUTS) - 1));
+
+  for (uint32_t num = 0; num < SIM_NB_OUTPUTS; num++)
+  {
+    uint32_t ended = sim_last_writer(num, 0) + 1u;
+
+    SIM_CHECK(sim_signalled_at[num] != SIM_NOT_SIGNALLED);
+    SIM_CHECK(sim_signalled_at[num] >= ended);
+    SIM_CHECK(sim_signalled_at[num] <= ended + late);
+  }
+}
+
+static void test_epochs(uint32_t base)
+{
+  uint32_t n;
+
+  sim_outputs_init(base);
+  n = sim_ebs_init(base, -1, -1);
+  sim_run(n, -1);
+
+#ifdef LL_ATON_EB_DBG_INFO
+  sim_check_signals(0);
+#else
+  sim_check_signals(base);
+#endif
+
+  /* The multi-epoch output is not signalled by its first writers */
+  SIM_CHECK(sim_signalled_at[1] > 4);
+}
+
+static void test_blob(uint32_t base)
+{
+  uint32_t n;
+
+  sim_outputs_init(base);
+  n = sim_ebs_init(base, 1, 3);
+  sim_run(n, 3);
+
+#ifdef LL_ATON_EB_DBG_INFO
+  /* The blob ends epochs 1 to 3 at once */
+  SIM_CHECK(sim_signalled_at[0] == 4);
+  SIM_CHECK(sim_signalled_at[3] == 4);
+  sim_check_signals(1);
+#else
+  /* The epochs within the blob are not known, all signals are at the end of the inference */
+  SIM_CHECK(sim_instance.exec_state.epochs_count_lost);
+  for (uint32_t num = 0; num < SIM_NB_OUTPUTS; num++)
+  {
+    SIM_CHECK(sim_signalled_at[num] == SIM_NB_EPOCHS);
+  }
+  sim_check_signals(SIM_NB_EPOCHS);
+#endif
+}
+
+/* Without epoch callback nothing is counted nor signalled */
+static void test_no_callback(void)
+{
+  uint32_t n;
+
+  sim_outputs_init(0);
+  sim_instance.exec_state.epoch_callback_function = NULL;
+  n = sim_ebs_init(0, -1, -1);
+  sim_run(n, -1);
+
+  SIM_CHECK(sim_nr_of_signals == 0);
+  SIM_CHECK(sim_instance.exec_state.ready_outputs == 0);
+}
+
+/* A new inference signals all outputs again */
+static void test_reset(void)
+{
+  uint32_t n;
+
+  sim_outputs_init(0);
+  n = sim_ebs_init(0, -1, -1);
+  sim_run(n, -1);
+  SIM_CHECK(sim_nr_of_signals == SIM_NB_OUTPUTS);
+
+  __LL_ATON_RT_ResetReadyOutputs(&sim_instance);
+  for (uint32_t num = 0; num < SIM_NB_OUTPUTS; num++)
+  {
+    sim_signalled_at[num] = SIM_NOT_SIGNALLED;
+  }
+  sim_nr_of_signals = 0;
+  sim_epochs_ended = 0;
+  sim_run(n, -1);
+  sim_check_signals(0);
+}
+
+int main(void)
+{
+  sim_lib_ebs[0].flags = EpochBlock_Flags_epoch_start | EpochBlock_Flags_epoch_end | EpochBlock_Flags_internal;
+  sim_lib_ebs[1].flags = EpochBlock_Flags_epoch_start | EpochBlock_Flags_epoch_end | EpochBlock_Flags_internal;
+#ifdef LL_ATON_EB_DBG_INFO
+  /* The epochs of an inserted array are not numbered as the ones of the network */
+  for (uint32_t j = 0; j < 2; j++)
+  {
+    sim_lib_ebs[j].epoch_num = SIM_NB_EPOCHS + 1;
+    sim_lib_ebs[j].last_epoch_num = SIM_NB_EPOCHS + 1;
+  }
+#endif
+
+  test_epochs(0);
+  test_epochs(1);
+  test_blob(0);
+  test_blob(1);
+  test_no_callback();
+  test_reset();
+
+#ifdef LL_ATON_EB_DBG_INFO
+  return sim_report("ll_aton_rt_ready_outputs_test (LL_ATON_EB_DBG_INFO)");
+#else
+  return sim_report("ll_aton_rt_ready_outputs_test");
+#endif
+}
@@ -0,0 +1,322 @@
+/**
+ ******************************************************************************
+ * @file    ll_aton_rt_scheduler_test.c
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   Host unit tests of the ATON runtime scheduler on simulated epoch
+ *          blocks: priority classes, deadlines, FIFO order, fairness, no
+ *          switch while an instance owns the ATON IP, and statistics.
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ll_aton_sim.h"
+#include "ll_aton_sim_network.h"
+
+/* Unit under test */
+#include "ll_aton_rt_scheduler.c"
+
+#define SIM_MAX_TRACE 256
+#define SIM_NB_NETS   4
+
+static LL_ATON_RT_Scheduler_t sched;
+static sim_network_t nets[SIM_NB_NETS];
+static LL_ATON_RT_Sched_Job_t jobs[SIM_NB_NETS];
+
+/* Network of each epoch block step, and network of each completion */
+static uint32_t trace[SIM_MAX_TRACE];
+static uint32_t nr_of_traces;
+static uint32_t done[SIM_MAX_TRACE];
+static uint32_t nr_of_done;
+
+/* Job submitted from within the scheduler loop once a given number of steps have run */
+static LL_ATON_RT_Sched_Job_t *late_job;
+static uint32_t late_job_step;
+static uint64_t late_job_deadline_ns;
+
+static bool resubmit;
+static uint32_t nr_of_done_per_net[SIM_NB_NETS];
+
+static uint64_t sim_now_ns(void)
+{
+  return sim_clock_ns;
+}
+
+static void on_step(sim_network_t *net)
+{
+  if (nr_of_traces < SIM_MAX_TRACE)
+  {
+    trace[nr_of_traces] = net->id;
+  }
+  nr_of_traces++;
+
+  if ((late_job != NULL) && (nr_of_traces == late_job_step))
+  {
+    SIM_CHECK(LL_ATON_RT_Sched_Submit(&sched, late_job, late_job_deadline_ns));
+    late_job = NULL;
+  }
+}
+
+static void on_done(LL_ATON_RT_Sched_Job_t *job, void *user_data)
+{
+  sim_network_t *net = user_data;
+
+  if (nr_of_done < SIM_MAX_TRACE)
+  {
+    done[nr_of_done] = net->id;
+  }
+  nr_of_done++;
+  nr_of_done_per_net[net->id]++;
+
+  if (resubmit)
+  {
+    SIM_CHECK(LL_ATON_RT_Sched_Submit(&sched, job, 0));
+  }
+}
+
+static void setup(const char *const blocks[SIM_NB_NETS], const LL_ATON_RT_Sched_Priority_t prios[SIM_NB_NETS])
+{
+  LL_ATON_RT_Sched_Init(&sched, sim_now_ns);
+  for (uint32_t i = 0; i < SIM_NB_NETS; i++)
+  {
+    sim_network_init(&nets[i], i, blocks[i]);
+    LL_ATON_RT_Sched_Add_Job(&sched, &jobs[i], &nets[i].instance, prios[i], on_done, &nets[i]);
+  }
+  __ll_current_aton_ip_owner = NULL;
+  sim_on_step = on_step;
+  sim_clock_ns = 1000000;
+  sim_nr_of_switches_within_block = 0;
+  nr_of_traces = 0;
+  nr_of_done = 0;
+  memset(nr_of_done_per_net, 0, sizeof(nr_of_done_per_net));
+  late_job = NULL;
+  resubmit = false;
+}
+
+/* Runs the scheduler until nothing is queued, or for `max_calls` calls */
+static void run(uint32_t max_calls)
+{
+  uint32_t nr_of_wfe = 0;
+
+  for (uint32_t i = 0; i < max_calls; i++)
+  {
+    LL_ATON_RT_RetValues_t ret = LL_ATON_RT_Sched_Run(&sched);
+
+    if (ret == LL_ATON_RT_WFE)
+    {
+      /* The simulated NPU is done at the next call: only an empty queue gives two WFE in a row */
+      if (++nr_of_wfe == 2)
+      {
+        break;
+      }
+    }
+    else
+    {
+      nr_of_wfe = 0;
+    }
+  }
+}
+
+/* Index of the first step of network `id` in the trace, from `from` */
+static uint32_t first_step_of(uint32_t id, uint32_t from)
+{
+  for (uint32_t i = from; i < nr_of_traces; i++)
+  {
+    if (trace[i] == id)
+      return i;
+  }
+  return UINT32_MAX;
+}
+
+static uint32_t last_step_of(uint32_t id)
+{
+  for (uint32_t i = nr_of_traces; i > 0; i--)
+  {
+    if (trace[i - 1] == id)
+      return i - 1;
+  }
+  return UINT32_MAX;
+}
+
+static void test_priority_classes(void)
+{
+  static const char *const blocks[SIM_NB_NETS] = {"SHS", "SHS", "SHS", "SHS"};
+  static const LL_ATON_RT_Sched_Priority_t prios[SIM_NB_NETS] = {
+      LL_ATON_RT_SCHED_PRIO_BACKGROUND, LL_ATON_RT_SCHED_PRIO_NORMAL, LL_ATON_RT_SCHED_PRIO_HIGH,
+      LL_ATON_RT_SCHED_PRIO_REALTIME};
+
+  setup(blocks, prios);
+  for (uint32_t i = 0; i < SIM_NB_NETS; i++)
+  {
+    SIM_CHECK(LL_ATON_RT_Sched_Submit(&sched, &jobs[i], 0));
+  }
+  run(100);
+
+  SIM_CHECK(nr_of_done == 4);
+  SIM_CHECK((done[0] == 3) && (done[1] == 2) && (done[2] == 1) && (done[3] == 0));
+  SIM_CHECK(sim_nr_of_switches_within_block == 0);
+}
+
+static void test_deadlines_then_fifo(void)
+{
+  static const char *const blocks[SIM_NB_NETS] = {"SS", "SS", "SS", "SS"};
+  static const LL_ATON_RT_Sched_Priority_t prios[SIM_NB_NETS] = {
+      LL_ATON_RT_SCHED_PRIO_NORMAL, LL_ATON_RT_SCHED_PRIO_NORMAL, LL_ATON_RT_SCHED_PRIO_NORMAL,
+      LL_ATON_RT_SCHED_PRIO_NORMAL};
+
+  setup(blocks, prios);
+  /* No deadline runs after any deadline, in submission order */
+  SIM_CHECK(LL_ATON_RT_Sched_Submit(&sched, &jobs[0], 0));
+  SIM_CHECK(LL_ATON_RT_Sched_Submit(&sched, &jobs[1], sim_clock_ns + 900000));
+  SIM_CHECK(LL_ATON_RT_Sched_Submit(&sched, &jobs[2], 0));
+  SIM_CHECK(LL_ATON_RT_Sched_Submit(&sched, &jobs[3], sim_clock_ns + 500000));
+  run(100);
+
+  SIM_CHECK(nr_of_done == 4);
+  SIM_CHECK((done[0] == 3) && (done[1] == 1) && (done[2] == 0) && (done[3] == 2));
+
+  /* A job is submitted again only once its inference is over */
+  setup(blocks, prios);
+  SIM_CHECK(LL_ATON_RT_Sched_Submit(&sched, &jobs[0], 0));
+  SIM_CHECK(!LL_ATON_RT_Sched_Submit(&sched, &jobs[0], 0));
+  SIM_CHECK(!LL_ATON_RT_Sched_Remove_Job(&sched, &jobs[0]));
+  run(100);
+  SIM_CHECK(nr_of_done == 1);
+  SIM_CHECK(LL_ATON_RT_Sched_Remove_Job(&sched, &jobs[0]));
+  SIM_CHECK(LL_ATON_RT_Sched_Submit(&sched, &jobs[1], 0));
+  run(100);
+  SIM_CHECK(nr_of_done == 2);
+}
+
+/* A realtime job submitted in the middle of a background inference takes over at the next epoch block boundary
+ * where the ATON IP is free, never within a hybrid block or an inserted lib epoch block array */
+static void test_switch_at_block_boundaries(void)
+{
+  static const char *const blocks[SIM_NB_NETS] = {"SYLHSS", "SHS", "", ""};
+  /* Background steps at the end of each block: S 1 step, Y SIM_HYBRID_STEPS, L SIM_LIB_STEPS, H 2 */
+  static const uint32_t bg_boundaries[] = {1,
+                                           1 + SIM_HYBRID_STEPS,
+                                           1 + SIM_HYBRID_STEPS + SIM_LIB_STEPS,
+                                           1 + SIM_HYBRID_STEPS + SIM_LIB_STEPS + 2,
+                                           1 + SIM_HYBRID_STEPS + SIM_LIB_STEPS + 2 + 1,
+                                           1 + SIM_HYBRID_STEPS + SIM_LIB_STEPS + 2 + 2};
+  static const LL_ATON_RT_Sched_Priority_t prios[SIM_NB_NETS] = {
+      LL_ATON_RT_SCHED_PRIO_BACKGROUND, LL_ATON_RT_SCHED_PRIO_REALTIME, LL_ATON_RT_SCHED_PRIO_NORMAL,
+      LL_ATON_RT_SCHED_PRIO_NORMAL};
+
+  /* The realtime job comes at each step of the background inference in turn */
+  for (uint32_t at = 1; at <= bg_boundaries[sizeof(bg_boundaries) / sizeof(*bg_boundaries) - 1]; at++)
+  {
+    LL_ATON_RT_Sched_Stats_t stats;
+    uint32_t rt_first, rt_last, bg_last_before;
+
+    setup(blocks, prios);
+    late_job = &jobs[1];
+    late_job_step = at;
+    late_job_deadline_ns = 0;
+    SIM_CHECK(LL_ATON_RT_Sched_Submit(&sched, &jobs[0], 0));
+    run(200);
+
+    SIM_CHECK(nr_of_done == 2);
+    SIM_CHECK(sim_nr_of_switches_within_block == 0);
+
+    /* Once started, the realtime inference runs to its end */
+    rt_first = first_step_of(1, 0);
+    rt_last = last_step_of(1);
+    SIM_CHECK((rt_first != UINT32_MAX) && (first_step_of(0, rt_first) > rt_last));
+
+    /* The background steps before the switch end with a whole block */
+    bg_last_before = (rt_first > 0) ? rt_first - 1 : UINT32_MAX;
+    if (bg_last_before != UINT32_MAX)
+    {
+      uint32_t nr_of_bg_steps = bg_last_before + 1;
+      bool at_boundary = false;
+      for (uint32_t b = 0; b < sizeof(bg_boundaries) / sizeof(*bg_boundaries); b++)
+      {
+        at_boundary |= (nr_of_bg_steps == bg_boundaries[b]);
+      }
+      SIM_CHECK(at_boundary);
+      /* The switch happens at the first boundary after the submission */
+      SIM_CHECK(nr_of_bg_steps >= at);
+    }
+
+    LL_ATON_RT_Sched_Get_Stats(&sched, LL_ATON_RT_SCHED_PRIO_BACKGROUND, &stats, false);
+    SIM_CHECK(stats.nb_done == 1);
+    SIM_CHECK(stats.nb_preempted == ((done[0] == 1) ? 1 : 0));
+  }
+}
+
+/* Jobs of the same class submitting again from their callback are served in turn */
+static void test_fairness(void)
+{
+  static const char *const blocks[SIM_NB_NETS] = {"SHS", "SYS", "HLH", "S"};
+  static const LL_ATON_RT_Sched_Priority_t prios[SIM_NB_NETS] = {
+      LL_ATON_RT_SCHED_PRIO_NORMAL, LL_ATON_RT_SCHED_PRIO_NORMAL, LL_ATON_RT_SCHED_PRIO_NORMAL,
+      LL_ATON_RT_SCHED_PRIO_NORMAL};
+  uint32_t min = UINT32_MAX;
+  uint32_t max = 0;
+
+  setup(blocks, prios);
+  resubmit = true;
+  for (uint32_t i = 0; i < SIM_NB_NETS; i++)
+  {
+    SIM_CHECK(LL_ATON_RT_Sched_Submit(&sched, &jobs[i], 0));
+  }
+  run(5000);
+
+  for (uint32_t i = 0; i < SIM_NB_NETS; i++)
+  {
+    min = (nr_of_done_per_net[i] < min) ? nr_of_done_per_net[i] : min;
+    max = (nr_of_done_per_net[i] > max) ? nr_of_done_per_net[i] : max;
+  }
+  SIM_CHECK(min > 100);
+  SIM_CHECK(max - min <= 1);
+  SIM_CHECK(sim_nr_of_switches_within_block == 0);
+}
+
+static void test_stats(void)
+{
+  static const char *const blocks[SIM_NB_NETS] = {"SSSS", "SS", "", ""};
+  static const LL_ATON_RT_Sched_Priority_t prios[SIM_NB_NETS] = {
+      LL_ATON_RT_SCHED_PRIO_HIGH, LL_ATON_RT_SCHED_PRIO_HIGH, LL_ATON_RT_SCHED_PRIO_NORMAL,
+      LL_ATON_RT_SCHED_PRIO_NORMAL};
+  LL_ATON_RT_Sched_Stats_t stats;
+
+  setup(blocks, prios);
+  /* 4 steps of 1 us: job 0 makes it, job 1 (2 steps after job 0) does not */
+  SIM_CHECK(LL_ATON_RT_Sched_Submit(&sched, &jobs[0], sim_clock_ns + 5 * sim_step_ns));
+  SIM_CHECK(LL_ATON_RT_Sched_Submit(&sched, &jobs[1], sim_clock_ns + 5 * sim_step_ns));
+  run(100);
+
+  LL_ATON_RT_Sched_Get_Stats(&sched, LL_ATON_RT_SCHED_PRIO_HIGH, &stats, true);
+  SIM_CHECK(stats.nb_done == 2);
+  SIM_CHECK(stats.nb_deadline_missed == 1);
+  SIM_CHECK(stats.nb_preempted == 0);
+  SIM_CHECK(stats.latency_max_ns == 6 * sim_step_ns);
+  SIM_CHECK(stats.latency_sum_ns == (4 + 6) * sim_step_ns);
+
+  LL_ATON_RT_Sched_Get_Stats(&sched, LL_ATON_RT_SCHED_PRIO_HIGH, &stats, false);
+  SIM_CHECK((stats.nb_done == 0) && (stats.latency_sum_ns == 0));
+}
+
+int main(void)
+{
+  test_priority_classes();
+  test_deadlines_then_fifo();
+  test_switch_at_block_boundaries();
+  test_fairness();
+  test_stats();
+
+  return sim_report("ll_aton_rt_scheduler_test");
+}
@@ -0,0 +1,185 @@
+/**
+ ******************************************************************************
+ * @file    ll_aton_rt_scheduler_tx_test.c
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   Host test of the ATON runtime scheduler on the ThreadX Linux port:
+ *          a camera thread submits realtime inferences with a deadline while
+ *          a background inference runs back to back, the NPU completes its
+ *          epoch blocks from a timer through the ThreadX OSAL events.
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tx_api.h"
+
+/* Submissions come from the camera thread and from the scheduler thread */
+#define LL_ATON_RT_SCHED_ENTER_CS(_state) ((_state) = tx_interrupt_control(TX_INT_DISABLE))
+#define LL_ATON_RT_SCHED_EXIT_CS(_state)  ((void)tx_interrupt_control(_state))
+
+#include "ll_aton_sim.h"
+#include "ll_aton_sim_network.h"
+
+/* Unit under test */
+#include "ll_aton_rt_scheduler.c"
+
+#define SIM_TICK_NS              (1000000000ULL / TX_TIMER_TICKS_PER_SECOND)
+#define SIM_CAMERA_PERIOD_TICKS  6
+#define SIM_CAMERA_DEADLINE_TICK 5
+#define SIM_CAMERA_NB_FRAMES     40
+#define SIM_STACK_SIZE           16384
+
+static LL_ATON_RT_Scheduler_t sched;
+static sim_network_t rt_net;
+static sim_network_t bg_net;
+static LL_ATON_RT_Sched_Job_t rt_job;
+static LL_ATON_RT_Sched_Job_t bg_job;
+
+static TX_THREAD sched_thread;
+static TX_THREAD camera_thread;
+static TX_TIMER npu_timer;
+static uint8_t sched_stack[SIM_STACK_SIZE];
+static uint8_t camera_stack[SIM_STACK_SIZE];
+
+static sim_network_t *volatile npu_net;
+static volatile bool stop;
+static uint32_t nr_of_rt_submitted;
+static uint32_t nr_of_rt_rejected;
+
+static uint64_t sim_now_ns(void)
+{
+  return (uint64_t)tx_time_get() * SIM_TICK_NS;
+}
+
+/* Each HW epoch block keeps the NPU busy for one tick */
+static void npu_start(sim_network_t *net)
+{
+  npu_net = net;
+  tx_timer_change(&npu_timer, 1, 0);
+  tx_timer_activate(&npu_timer);
+}
+
+static void npu_timer_expired(ULONG arg)
+{
+  (void)arg;
+  sim_network_t *net = npu_net;
+
+  if (net != NULL)
+  {
+    npu_net = NULL;
+    sim_npu_done(net);
+  }
+}
+
+static void on_done(LL_ATON_RT_Sched_Job_t *job, void *user_data)
+{
+  (void)user_data;
+
+  if ((job == &bg_job) && !stop)
+  {
+    SIM_CHECK(LL_ATON_RT_Sched_Submit(&sched, &bg_job, 0));
+  }
+}
+
+static void sched_entry(ULONG arg)
+{
+  (void)arg;
+
+  while (!stop || (rt_job.state != LL_ATON_RT_SCHED_JOB_IDLE) || (bg_job.state != LL_ATON_RT_SCHED_JOB_IDLE))
+  {
+    if (LL_ATON_RT_Sched_Run(&sched) == LL_ATON_RT_WFE)
+    {
+      LL_ATON_OSAL_WFE();
+    }
+  }
+}
+
+static void camera_entry(ULONG arg)
+{
+  (void)arg;
+  LL_ATON_RT_Sched_Stats_t rt_stats;
+  LL_ATON_RT_Sched_Stats_t bg_stats;
+
+  SIM_CHECK(LL_ATON_RT_Sched_Submit(&sched, &bg_job, 0));
+
+  for (uint32_t frame = 0; frame < SIM_CAMERA_NB_FRAMES; frame++)
+  {
+    tx_thread_sleep(SIM_CAMERA_PERIOD_TICKS);
+    if (LL_ATON_RT_Sched_Submit(&sched, &rt_job, sim_now_ns() + SIM_CAMERA_DEADLINE_TICK * SIM_TICK_NS))
+    {
+      nr_of_rt_submitted++;
+    }
+    else
+    {
+      nr_of_rt_rejected++;
+    }
+  }
+
+  /* Lets the last inferences end */
+  stop = true;
+  LL_ATON_OSAL_SIGNAL_EVENT();
+  while (sched_thread.tx_thread_state != TX_COMPLETED)
+  {
+    tx_thread_sleep(1);
+  }
+
+  LL_ATON_RT_Sched_Get_Stats(&sched, LL_ATON_RT_SCHED_PRIO_REALTIME, &rt_stats, false);
+  LL_ATON_RT_Sched_Get_Stats(&sched, LL_ATON_RT_SCHED_PRIO_BACKGROUND, &bg_stats, false);
+
+  printf("realtime:   %lu done, %lu deadline missed, latency avg %.1f ms max %.1f ms\n", (unsigned long)rt_stats.nb_done,
+         (unsigned long)rt_stats.nb_deadline_missed, rt_stats.latency_sum_ns / 1e6 / (rt_stats.nb_done + !rt_stats.nb_done),
+         rt_stats.latency_max_ns / 1e6);
+  printf("background: %lu done, %lu preempted, latency avg %.1f ms\n", (unsigned long)bg_stats.nb_done,
+         (unsigned long)bg_stats.nb_preempted, bg_stats.latency_sum_ns / 1e6 / (bg_stats.nb_done + !bg_stats.nb_done));
+
+  /* Every frame is inferred before the next one, within its deadline, and the background keeps running */
+  SIM_CHECK(nr_of_rt_rejected == 0);
+  SIM_CHECK(rt_stats.nb_done == nr_of_rt_submitted);
+  SIM_CHECK(rt_stats.nb_deadline_missed == 0);
+  SIM_CHECK(rt_stats.latency_max_ns <= SIM_CAMERA_DEADLINE_TICK * SIM_TICK_NS);
+  SIM_CHECK(bg_stats.nb_done > 0);
+  SIM_CHECK(bg_stats.nb_preempted > 0);
+  SIM_CHECK(sim_nr_of_switches_within_block == 0);
+
+  exit(sim_report("ll_aton_rt_scheduler_tx_test"));
+}
+
+void tx_application_define(void *first_unused_memory)
+{
+  (void)first_unused_memory;
+
+  LL_ATON_OSAL_INIT();
+
+  /* Background: 4 HW blocks, within a hybrid block and an inserted lib array too */
+  sim_network_init(&bg_net, 0, "SHYHLHSH");
+  sim_network_init(&rt_net, 1, "SHS");
+  sim_npu_start = npu_start;
+
+  LL_ATON_RT_Sched_Init(&sched, sim_now_ns);
+  LL_ATON_RT_Sched_Add_Job(&sched, &bg_job, &bg_net.instance, LL_ATON_RT_SCHED_PRIO_BACKGROUND, on_done, NULL);
+  LL_ATON_RT_Sched_Add_Job(&sched, &rt_job, &rt_net.instance, LL_ATON_RT_SCHED_PRIO_REALTIME, on_done, NULL);
+
+  tx_timer_create(&npu_timer, "npu", npu_timer_expired, 0, 1, 0, TX_NO_ACTIVATE);
+  tx_thread_create(&sched_thread, "sched", sched_entry, 0, sched_stack, sizeof(sched_stack), 10, 10, TX_NO_TIME_SLICE,
+                   TX_AUTO_START);
+  tx_thread_create(&camera_thread, "camera", camera_entry, 0, camera_stack, sizeof(camera_stack), 5, 5,
+                   TX_NO_TIME_SLICE, TX_AUTO_START);
+}
+
+int main(void)
+{
+  tx_kernel_enter();
+
+  return 1;
+}
@@ -0,0 +1,58 @@
+/**
+ ******************************************************************************
+ * @file    ll_aton_sim.h
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   Checks and report shared by the host tests of the ATON runtime.
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef __LL_ATON_SIM_H
+#define __LL_ATON_SIM_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+static uint32_t sim_nr_of_checks;
+static uint32_t sim_nr_of_failures;
+
+/* Counts and reports a failed condition, the test goes on */
+#define SIM_CHECK(_cond)                                                                                               \
+  do                                                                                                                   \
+  {                                                                                                                    \
+    sim_nr_of_checks++;                                                                                                \
+    if (!(_cond))                                                                                                      \
+    {                                                                                                                  \
+      sim_nr_of_failures++;                                                                                            \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #_cond);                                                 \
+    }                                                                                                                  \
+  } while (0)
+
+static inline uint64_t sim_time_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* Prints the summary, returns the exit code of the test (1 on failure) */
+static inline int sim_report(const char *name)
+{
+  printf("%s: %lu checks, %lu failures\n", name, (unsigned long)sim_nr_of_checks, (unsigned long)sim_nr_of_failures);
+
+  return (sim_nr_of_failures != 0) ? 1 : 0;
+}
+
+#endif // __LL_ATON_SIM_H
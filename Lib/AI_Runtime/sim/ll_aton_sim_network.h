@@ -0,0 +1,162 @@
+/**
+ ******************************************************************************
+ * @file    ll_aton_sim_network.h
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   Simulated network instances standing for the ATON runtime in the
+ *          host tests of the scheduler: sequences of epoch blocks taking and
+ *          releasing the ATON IP as `LL_ATON_RT_RunEpochBlock()` does.
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef __LL_ATON_SIM_NETWORK_H
+#define __LL_ATON_SIM_NETWORK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ll_aton_rt_user_api.h"
+#include "ll_aton_sim.h"
+
+/* Kinds of the simulated epoch blocks, one character each in `sim_network_t.blocks`:
+ *   'S' pure SW: one call, the ATON IP is not taken
+ *   'H' pure HW: the ATON IP is taken, the NPU runs until `sim_npu_done()`
+ *   'Y' hybrid: the ATON IP is held over SIM_HYBRID_STEPS calls (SW parts in between HW parts)
+ *   'L' ATON lib epoch block array inserted by a SW operator: the ATON IP is held over SIM_LIB_STEPS calls */
+#define SIM_HYBRID_STEPS 3
+#define SIM_LIB_STEPS    4
+
+typedef struct
+{
+  NN_Instance_TypeDef instance; /* First: the runtime calls are given &instance */
+  const char *blocks;
+  uint32_t id;
+  /* Private */
+  uint32_t next_block;
+  uint32_t step;
+  volatile bool npu_busy;
+  uint32_t nr_of_calls;
+} sim_network_t;
+
+NN_Instance_TypeDef *volatile __ll_current_aton_ip_owner;
+
+/* Called when an 'H' block starts on the NPU: sim_npu_done() must be called later on (e.g. from a timer).
+ * When NULL, the NPU is done at the next call of the owner. */
+static void (*sim_npu_start)(sim_network_t *net);
+/* Called on each epoch block step, for the traces of the tests */
+static void (*sim_on_step)(sim_network_t *net);
+/* Time spent by the CPU on each step, when the test has its own clock */
+static uint64_t sim_clock_ns;
+static uint64_t sim_step_ns = 1000;
+/* Calls made for an instance while another one owns the ATON IP in the middle of a block */
+static uint32_t sim_nr_of_switches_within_block;
+
+static inline sim_network_t *sim_network(NN_Instance_TypeDef *nn_instance)
+{
+  return (sim_network_t *)nn_instance;
+}
+
+static inline void sim_network_init(sim_network_t *net, uint32_t id, const char *blocks)
+{
+  memset(net, 0, sizeof(*net));
+  net->id = id;
+  net->blocks = blocks;
+}
+
+static inline void sim_npu_done(sim_network_t *net)
+{
+  net->npu_busy = false;
+  LL_ATON_OSAL_SIGNAL_EVENT();
+}
+
+void LL_ATON_RT_Reset_Network(NN_Instance_TypeDef *nn_instance)
+{
+  sim_network_t *net = sim_network(nn_instance);
+
+  SIM_CHECK(__ll_current_aton_ip_owner != nn_instance);
+  net->next_block = 0;
+  net->step = 0;
+}
+
+LL_ATON_RT_RetValues_t LL_ATON_RT_RunEpochBlock(NN_Instance_TypeDef *nn_instance)
+{
+  sim_network_t *net = sim_network(nn_instance);
+  char kind = net->blocks[net->next_block];
+
+  net->nr_of_calls++;
+  sim_clock_ns += sim_step_ns;
+
+  if (kind == '\0')
+  {
+    return LL_ATON_RT_DONE;
+  }
+
+  /* The runtime only lets the owner of the ATON IP go on */
+  if ((__ll_current_aton_ip_owner != NULL) && (__ll_current_aton_ip_owner != nn_instance))
+  {
+    sim_nr_of_switches_within_block++;
+    return LL_ATON_RT_WFE;
+  }
+
+  if (sim_on_step != NULL)
+  {
+    sim_on_step(net);
+  }
+
+  switch (kind)
+  {
+  case 'S':
+    break;
+  case 'H':
+    if (net->step == 0)
+    {
+      __ll_current_aton_ip_owner = nn_instance;
+      net->step = 1;
+      net->npu_busy = true;
+      if (sim_npu_start != NULL)
+      {
+        sim_npu_start(net);
+      }
+      else
+      {
+        net->npu_busy = false;
+      }
+      return LL_ATON_RT_WFE;
+    }
+    if (net->npu_busy)
+    {
+      return LL_ATON_RT_WFE;
+    }
+    __ll_current_aton_ip_owner = NULL;
+    break;
+  case 'Y':
+  case 'L':
+    __ll_current_aton_ip_owner = nn_instance;
+    if (++net->step < ((kind == 'Y') ? SIM_HYBRID_STEPS : SIM_LIB_STEPS))
+    {
+      return LL_ATON_RT_NO_WFE;
+    }
+    __ll_current_aton_ip_owner = NULL;
+    break;
+  default:
+    SIM_CHECK(false);
+    break;
+  }
+
+  net->step = 0;
+  net->next_block++;
+
+  return (net->blocks[net->next_block] == '\0') ? LL_ATON_RT_DONE : LL_ATON_RT_NO_WFE;
+}
+
+#endif // __LL_ATON_SIM_NETWORK_H
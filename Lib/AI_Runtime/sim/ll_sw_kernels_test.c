@@ -0,0 +1,409 @@
+/**
+ ******************************************************************************
+ * @file    ll_sw_kernels_test.c
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   Host unit tests of the plain C native kernels of the SW fallback
+ *          operators against the reference formulas of the generic layers
+ *          (QuantizeLinear, DequantizeLinear, requantization, quantized
+ *          Add/Sub/Mul, global average/max pooling): rounding half to even,
+ *          saturation edges and the nodes left to the generic layers.
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ll_aton_sim.h"
+
+/* Unit under test, its static functions are reached from here */
+#include "ll_sw_kernels.c"
+
+#define SIM_MAX_ELEMS 1024
+
+static float sim_f_in[SIM_MAX_ELEMS];
+static float sim_f_out[SIM_MAX_ELEMS];
+static uint8_t sim_q_a[SIM_MAX_ELEMS];
+static uint8_t sim_q_b[SIM_MAX_ELEMS];
+static uint8_t sim_q_out[SIM_MAX_ELEMS];
+
+/* Scalars of the quantization parameters */
+static float sim_scale[3];
+static uint8_t sim_zp[3];
+
+/* Requantized values which are not the reference one, the rounding of the float computation may differ by one step
+ * from the exact value when it falls next to a half */
+static uint32_t sim_nr_of_off_by_one;
+static uint32_t sim_nr_of_values;
+
+static uint32_t sim_seed = 0x12345678u;
+
+static uint32_t sim_rand(void)
+{
+  sim_seed ^= sim_seed << 13;
+  sim_seed ^= sim_seed >> 17;
+  sim_seed ^= sim_seed << 5;
+  return sim_seed;
+}
+
+static float sim_randf(float min, float max)
+{
+  return min + (max - min) * (float)(sim_rand() >> 8) / (float)(1u << 24);
+}
+
+/* Dense tensor of `n` elements, channels innermost (b, h, w, c) */
+static void sim_tensor(Tensor_info *t, void *p, uint32_t elem_size, bool is_signed, uint32_t h, uint32_t w,
+                       uint32_t c)
+{
+  memset(t, 0, sizeof(*t));
+  t->dim.tensor_b = 1;
+  t->dim.tensor_h = h;
+  t->dim.tensor_w = w;
+  t->dim.tensor_c = c;
+  t->dim.num_elem = h * w * c;
+  t->stride.c = elem_size;
+  t->stride.w = c * elem_size;
+  t->stride.h = w * c * elem_size;
+  t->stride.b = h * w * c * elem_size;
+  t->mem.start_offset = p;
+  t->format.is_signed = is_signed;
+}
+
+/* Channels outermost (b, c, h, w) */
+static void sim_tensor_chfirst(Tensor_info *t, void *p, uint32_t elem_size, uint32_t h, uint32_t w, uint32_t c)
+{
+  sim_tensor(t, p, elem_size, false, h, w, c);
+  t->stride.w = elem_size;
+  t->stride.h = w * elem_size;
+  t->stride.c = h * w * elem_size;
+}
+
+/* Per tensor scale and zero point, the zero point signedness follows the one of the scale tensor */
+static void sim_quant(Tensor_info *s, Tensor_info *zp, uint32_t i, float scale, int32_t zero_point, bool is_signed)
+{
+  sim_scale[i] = scale;
+  sim_zp[i] = (uint8_t)zero_point;
+  sim_tensor(s, &sim_scale[i], sizeof(float), is_signed, 1, 1, 1);
+  sim_tensor(zp, &sim_zp[i], 1, is_signed, 1, 1, 1);
+}
+
+/* Reference: saturate(round_half_to_even(v) + zero_point) */
+static int32_t sim_ref_quantize(double v, int32_t zero_point, bool is_signed)
+{
+  double q = nearbyint(v) + zero_point;
+  double q_min = is_signed ? INT8_MIN : 0;
+  double q_max = is_signed ? INT8_MAX : UINT8_MAX;
+
+  return (int32_t)((q < q_min) ? q_min : ((q > q_max) ? q_max : q));
+}
+
+static int32_t sim_load(const uint8_t *p, bool is_signed)
+{
+  return is_signed ? (int32_t) * (const int8_t *)p : (int32_t)*p;
+}
+
+/* Exact when `exact`, otherwise one step away at most where the exact value is next to a half */
+static void sim_check_q(int32_t q, int32_t ref, double exact_v, bool exact)
+{
+  sim_nr_of_values++;
+  if (q == ref)
+  {
+    return;
+  }
+  sim_nr_of_off_by_one++;
+  SIM_CHECK(!exact);
+  SIM_CHECK(abs(q - ref) == 1);
+  SIM_CHECK(fabs(fabs(exact_v - floor(exact_v)) - 0.5) < 1e-4);
+}
+
+static void test_quantize(bool is_signed, float scale, int32_t zero_point, bool exact)
+{
+  Quantizelinear_sw_info info;
+  const uint32_t n = 37; /* Not a multiple of the vector length */
+
+  memset(&info, 0, sizeof(info));
+  sim_tensor(&info.general.input, sim_f_in, sizeof(float), true, 1, 1, n);
+  sim_tensor(&info.general.output, sim_q_out, 1, is_signed, 1, 1, n);
+  sim_quant(&info.os, &info.ozp, 0, scale, zero_point, is_signed);
+
+  for (int32_t round = 0; round < 20; round++)
+  {
+    for (uint32_t i = 0; i < n; i++)
+    {
+      switch (sim_rand() % 4)
+      {
+      case 0: /* Halves: round half to even */
+        sim_f_in[i] = ((float)((int32_t)(sim_rand() % 300) - 150) + 0.5f) * scale;
+        break;
+      case 1: /* Beyond the range and beyond the float to int conversion limit */
+        sim_f_in[i] = ((sim_rand() & 1) ? 1.0f : -1.0f) * ((sim_rand() & 2) ? 1e30f : 200.0f * scale);
+        break;
+      default:
+        sim_f_in[i] = sim_randf(-160.0f, 160.0f) * scale;
+        break;
+      }
+    }
+
+    SIM_CHECK(ll_sw_kernel_quantizelinear(&info));
+    for (uint32_t i = 0; i < n; i++)
+    {
+      double v = (double)sim_f_in[i] / scale;
+      sim_check_q(sim_load(&sim_q_out[i], is_signed), sim_ref_quantize(v, zero_point, is_signed), v, exact);
+    }
+  }
+}
+
+static void test_dequantize(bool is_signed, float scale, int32_t zero_point)
+{
+  Dequantizelinear_sw_info info;
+  const uint32_t n = 256;
+
+  memset(&info, 0, sizeof(info));
+  sim_tensor(&info.general.input, sim_q_a, 1, is_signed, 4, 4, 16);
+  sim_tensor(&info.general.output, sim_f_out, sizeof(float), true, 4, 4, 16);
+  sim_quant(&info.is, &info.izp, 0, scale, zero_point, is_signed);
+
+  for (uint32_t i = 0; i < n; i++)
+  {
+    sim_q_a[i] = (uint8_t)i;
+  }
+
+  SIM_CHECK(ll_sw_kernel_dequantizelinear(&info));
+  for (uint32_t i = 0; i < n; i++)
+  {
+    float ref = (float)(sim_load(&sim_q_a[i], is_signed) - zero_point) * scale;
+    SIM_CHECK(sim_f_out[i] == ref);
+  }
+}
+
+static void test_requantize(bool in_signed, bool out_signed, float in_scale, float out_scale, bool exact)
+{
+  Requantizelinear_sw_info info;
+  const uint32_t n = 256;
+  const int32_t in_zp = in_signed ? -3 : 128;
+  const int32_t out_zp = out_signed ? 5 : 100;
+
+  memset(&info, 0, sizeof(info));
+  sim_tensor(&info.general.input, sim_q_a, 1, in_signed, 1, 16, 16);
+  sim_tensor(&info.general.output, sim_q_out, 1, out_signed, 1, 16, 16);
+  sim_quant(&info.is, &info.izp, 0, in_scale, in_zp, in_signed);
+  sim_quant(&info.os, &info.ozp, 1, out_scale, out_zp, out_signed);
+
+  /* Every input value once */
+  for (uint32_t i = 0; i < n; i++)
+  {
+    sim_q_a[i] = (uint8_t)i;
+  }
+
+  SIM_CHECK(ll_sw_kernel_requantizelinear(&info));
+  for (uint32_t i = 0; i < n; i++)
+  {
+    double v = (double)(sim_load(&sim_q_a[i], in_signed) - in_zp) * in_scale / out_scale;
+    sim_check_q(sim_load(&sim_q_out[i], out_signed), sim_ref_quantize(v, out_zp, out_signed), v, exact);
+  }
+
+  /* In place */
+  for (uint32_t i = 0; i < n; i++)
+  {
+    sim_q_a[i] = (uint8_t)i;
+  }
+  info.general.output.mem.start_offset = sim_q_a;
+  SIM_CHECK(ll_sw_kernel_requantizelinear(&info));
+  SIM_CHECK(memcmp(sim_q_a, sim_q_out, n) == 0);
+}
+
+static void test_eltwise(NodeType type, bool is_signed, const float scales[3], bool exact)
+{
+  Eltwise_integer_sw_info info;
+  const uint32_t n = 255;
+  const int32_t zp[3] = {is_signed ? 1 : 120, is_signed ? -7 : 130, is_signed ? 0 : 128};
+
+  memset(&info, 0, sizeof(info));
+  info.general.type = type;
+  info.num_of_inputs = 2;
+  sim_tensor(&info.general.input, sim_q_a, 1, is_signed, 1, 15, 17);
+  sim_tensor(&info.operand, sim_q_b, 1, is_signed, 1, 15, 17);
+  sim_tensor(&info.general.output, sim_q_out, 1, is_signed, 1, 15, 17);
+  sim_quant(&info.is, &info.izp, 0, scales[0], zp[0], is_signed);
+  sim_quant(&info.operand_s, &info.operand_zp, 1, scales[1], zp[1], is_signed);
+  sim_quant(&info.os, &info.ozp, 2, scales[2], zp[2], is_signed);
+
+  for (int32_t round = 0; round < 20; round++)
+  {
+    for (uint32_t i = 0; i < n; i++)
+    {
+      /* The extremes first: saturation both ways */
+      sim_q_a[i] = (round == 0) ? (uint8_t)((i & 1) ? 0x7F : 0x80) : (uint8_t)sim_rand();
+      sim_q_b[i] = (round == 0) ? (uint8_t)((i & 2) ? 0x7F : 0x80) : (uint8_t)sim_rand();
+    }
+
+    SIM_CHECK(ll_sw_kernel_eltwise_integer(&info));
+    for (uint32_t i = 0; i < n; i++)
+    {
+      double a = (double)(sim_load(&sim_q_a[i], is_signed) - zp[0]) * scales[0];
+      double b = (double)(sim_load(&sim_q_b[i], is_signed) - zp[1]) * scales[1];
+      double r = (type == LL_SW_ARITHMUL) ? (a * b) : ((type == LL_SW_ARITHSUB) ? (a - b) : (a + b));
+      double v = r / scales[2];
+      sim_check_q(sim_load(&sim_q_out[i], is_signed), sim_ref_quantize(v, zp[2], is_signed), v, exact);
+    }
+  }
+}
+
+static void test_global_pool(NodeType type, bool chfirst, uint32_t hw, uint32_t nb_ch)
+{
+  Global_pool_sw_info info;
+  const uint32_t nb_pos = hw * hw;
+
+  memset(&info, 0, sizeof(info));
+  info.general.type = type;
+  if (chfirst)
+  {
+    sim_tensor_chfirst(&info.general.input, sim_f_in, sizeof(float), hw, hw, nb_ch);
+  }
+  else
+  {
+    sim_tensor(&info.general.input, sim_f_in, sizeof(float), true, hw, hw, nb_ch);
+  }
+  sim_tensor(&info.general.output, sim_f_out, sizeof(float), true, 1, 1, nb_ch);
+
+  for (uint32_t i = 0; i < nb_pos * nb_ch; i++)
+  {
+    sim_f_in[i] = sim_randf(-100.0f, 100.0f);
+  }
+
+  SIM_CHECK(ll_sw_kernel_global_pool(&info));
+  for (uint32_t c = 0; c < nb_ch; c++)
+  {
+    double sum = 0.0;
+    float max = -INFINITY;
+
+    for (uint32_t p = 0; p < nb_pos; p++)
+    {
+      float v = chfirst ? sim_f_in[c * nb_pos + p] : sim_f_in[p * nb_ch + c];
+      sum += v;
+      max = fmaxf(max, v);
+    }
+    if (type == LL_SW_MAXPOOL)
+    {
+      SIM_CHECK(sim_f_out[c] == max);
+    }
+    else
+    {
+      SIM_CHECK(fabs(sim_f_out[c] - sum / nb_pos) <= 1e-4 * (1.0 + fabs(sum / nb_pos)));
+    }
+  }
+}
+
+/* Nodes left to the generic layers: `false` and the output is not written */
+static void test_not_supported(void)
+{
+  Quantizelinear_sw_info q;
+  Eltwise_integer_sw_info e;
+  Global_pool_sw_info g;
+
+  memset(sim_q_out, 0xA5, sizeof(sim_q_out));
+
+  /* Per channel quantization */
+  memset(&q, 0, sizeof(q));
+  sim_tensor(&q.general.input, sim_f_in, sizeof(float), true, 1, 1, 8);
+  sim_tensor(&q.general.output, sim_q_out, 1, true, 1, 1, 8);
+  sim_quant(&q.os, &q.ozp, 0, 0.5f, 0, true);
+  q.os.dim.num_elem = 8;
+  SIM_CHECK(!ll_sw_kernel_quantizelinear(&q));
+
+  /* Zero scale */
+  sim_quant(&q.os, &q.ozp, 0, 0.0f, 0, true);
+  SIM_CHECK(!ll_sw_kernel_quantizelinear(&q));
+
+  /* Overlapping input and output */
+  sim_quant(&q.os, &q.ozp, 0, 0.5f, 0, true);
+  q.general.output.mem.start_offset = (uint8_t *)sim_f_in + 4;
+  SIM_CHECK(!ll_sw_kernel_quantizelinear(&q));
+
+  /* Not dense */
+  q.general.output.mem.start_offset = sim_q_out;
+  q.general.output.stride.c = 2;
+  SIM_CHECK(!ll_sw_kernel_quantizelinear(&q));
+
+  /* Division and broadcasting */
+  memset(&e, 0, sizeof(e));
+  e.general.type = LL_SW_ARITHDIV;
+  e.num_of_inputs = 2;
+  sim_tensor(&e.general.input, sim_q_a, 1, true, 1, 4, 4);
+  sim_tensor(&e.operand, sim_q_b, 1, true, 1, 4, 4);
+  sim_tensor(&e.general.output, sim_q_out, 1, true, 1, 4, 4);
+  sim_quant(&e.is, &e.izp, 0, 0.5f, 0, true);
+  sim_quant(&e.operand_s, &e.operand_zp, 1, 0.5f, 0, true);
+  sim_quant(&e.os, &e.ozp, 2, 0.5f, 0, true);
+  SIM_CHECK(!ll_sw_kernel_eltwise_integer(&e));
+  e.general.type = LL_SW_ARITHSUM;
+  sim_tensor(&e.operand, sim_q_b, 1, true, 1, 1, 4);
+  SIM_CHECK(!ll_sw_kernel_eltwise_integer(&e));
+
+  /* Non square global pooling */
+  memset(&g, 0, sizeof(g));
+  g.general.type = LL_SW_AVGPOOL;
+  sim_tensor(&g.general.input, sim_f_in, sizeof(float), true, 2, 3, 4);
+  sim_tensor(&g.general.output, sim_f_out, sizeof(float), true, 1, 1, 4);
+  SIM_CHECK(!ll_sw_kernel_global_pool(&g));
+
+  for (uint32_t i = 0; i < sizeof(sim_q_out); i++)
+  {
+    SIM_CHECK(sim_q_out[i] == 0xA5);
+  }
+}
+
+int main(void)
+{
+  static const float pow2_scales[3] = {0.25f, 0.125f, 0.5f};
+  static const float any_scales[3] = {0.0137f, 0.0291f, 0.0417f};
+  static const NodeType eltwise_types[3] = {LL_SW_ARITHSUM, LL_SW_ARITHSUB, LL_SW_ARITHMUL};
+
+  for (int s = 0; s < 2; s++)
+  {
+    bool is_signed = (s != 0);
+
+    /* Power of two scales: the float computation is exact, so must be the result */
+    test_quantize(is_signed, 0.125f, is_signed ? -10 : 128, true);
+    test_quantize(is_signed, 0.0078125f, 0, true);
+    test_quantize(is_signed, 0.0235f, is_signed ? 3 : 17, false);
+
+    test_dequantize(is_signed, 0.0235f, is_signed ? -4 : 131);
+    test_dequantize(is_signed, 8.0f, 0);
+
+    test_requantize(is_signed, is_signed, 0.5f, 0.25f, true);
+    test_requantize(is_signed, !is_signed, 0.25f, 1.0f, true);
+    test_requantize(is_signed, is_signed, 0.0173f, 0.0291f, false);
+
+    for (int t = 0; t < 3; t++)
+    {
+      test_eltwise(eltwise_types[t], is_signed, pow2_scales, true);
+      test_eltwise(eltwise_types[t], is_signed, any_scales, false);
+    }
+  }
+
+  for (int chfirst = 0; chfirst < 2; chfirst++)
+  {
+    test_global_pool(LL_SW_AVGPOOL, chfirst, 7, 19);
+    test_global_pool(LL_SW_MAXPOOL, chfirst, 7, 19);
+    test_global_pool(LL_SW_AVGPOOL, chfirst, 1, 8);
+    test_global_pool(LL_SW_MAXPOOL, chfirst, 3, 1);
+  }
+
+  test_not_supported();
+
+  printf("ll_sw_kernels_test: %lu of %lu requantized values one step away from the reference (next to a half)\n",
+         (unsigned long)sim_nr_of_off_by_one, (unsigned long)sim_nr_of_values);
+
+  return sim_report("ll_sw_kernels_test");
+}
@@ -0,0 +1,24 @@
+/**
+ ******************************************************************************
+ * @file    stm32n6xx.h
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   Host stand-in of the STM32N6 device header (see stm32n6xx_hal.h).
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef __STM32N6xx_H
+#define __STM32N6xx_H
+
+#include "stm32n6xx_hal.h"
+
+#endif // __STM32N6xx_H
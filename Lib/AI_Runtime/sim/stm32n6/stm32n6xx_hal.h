@@ -0,0 +1,36 @@
+/**
+ ******************************************************************************
+ * @file    stm32n6xx_hal.h
+ * @author  SRA Artificial Intelligence & Embedded Architectures
+ * @brief   Host stand-in of the STM32N6 HAL for the tests built with the
+ *          `LL_ATON_PLAT_STM32N6` platform: only what `ll_aton_platform.h`
+ *          and the cache headers use. The cache maintenance functions are
+ *          provided by the tests.
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef __STM32N6xx_HAL_H
+#define __STM32N6xx_HAL_H
+
+#include <stdint.h>
+
+#define __STATIC_FORCEINLINE static inline __attribute__((always_inline))
+
+#define __STM32N6xx_HAL_VERSION 0x01010000UL
+
+#define NPU_BASE_NS 0x48000000UL
+#define NPU_BASE_S  0x58000000UL
+
+void SCB_InvalidateICache_by_Addr(volatile void *addr, int32_t isize);
+
+#endif // __STM32N6xx_HAL_H
@@ -25,11 +25,17 @@
 
 /* Exported types ------------------------------------------------------------*/
 /* Exported constants --------------------------------------------------------*/
+/* Number of ISP instances whose algorithms can run at the same time */
+#ifndef ISP_ALGO_MAX_INSTANCES
+#define ISP_ALGO_MAX_INSTANCES 1
+#endif
+
 /* Exported macro ------------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
 ISP_StatusTypeDef ISP_Algo_Init(ISP_HandleTypeDef *hIsp);
 ISP_StatusTypeDef ISP_Algo_DeInit(ISP_HandleTypeDef *hIsp);
 ISP_StatusTypeDef ISP_Algo_Process(ISP_HandleTypeDef *hIsp);
+uint32_t ISP_Algo_GetAWBProfileId(ISP_HandleTypeDef *hIsp);
 
 /* Exported variables --------------------------------------------------------*/
 
@@ -30,6 +30,8 @@
 #include "stm32mp2xx_hal.h"
 #elif defined (LINUX)
 #include "iqtune-linux-wrapper.h"
+#elif defined (ISP_SIM)
+#include "isp_sim_hal.h"
 #else
 #error Add header files for your specific board
 #endif
@@ -42,6 +44,10 @@
 #elif defined (STM32MP257Fxx)
 #define DCMIPP_MAJ_REV                       2U
 #define DCMIPP_MIN_REV                       0U
+#elif defined (ISP_SIM)
+/* Host simulation of the STM32N6 DCMIPP */
+#define DCMIPP_MAJ_REV                       2U
+#define DCMIPP_MIN_REV                       1U
 #endif
 
 #endif /* __ISP_CONF_H */
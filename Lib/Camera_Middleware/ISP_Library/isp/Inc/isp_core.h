@@ -212,6 +212,8 @@ typedef struct
   uint32_t cameraInstance;
   ISP_StatAreaTypeDef statArea;
   ISP_AlgoTypeDef **algorithm;
+  void *algoContext;            /* State of the algorithms of this instance */
+  uint32_t algoLastFrameId;     /* Main pipe frame processed by the last algorithms run */
   ISP_AppliHelpersTypeDef appliHelpers;
   ISP_AppliCBTypeDef appliCB;
   uint32_t MainPipe_FrameCount;
@@ -156,17 +156,60 @@ ISP_AlgoTypeDef *ISP_Algo_List[] = {
     &ISP_Algo_SimpleAWB_CCT,
 };
 
-/* Algo internal */
-static evision_ae_estimator_t *pIspAECestimator;
-static evision_awb_estimator_t* pIspAWBestimator;
+#define ISP_ALGO_NB (sizeof(ISP_Algo_List) / sizeof(*ISP_Algo_List))
 
-static uint32_t evision_ae_lut_exposure [EVISION_AE_LUT_EXPOSURE_SIZE];
-static uint32_t evision_ae_lut_gain [EVISION_AE_LUT_GAIN_SIZE];
-
-/* Global variables ----------------------------------------------------------*/
-uint32_t current_awb_profId = 0;
+/* Algo internal : state of the algorithms of one ISP instance. ISP_Algo_List holds the templates of the
+ * algorithm handles, each instance works on its own copy so that several ISP instances can run side by side */
+typedef struct
+{
+  ISP_HandleTypeDef *hIsp;                  /* Owner, NULL when the context is free */
+  ISP_AlgoTypeDef algo[ISP_ALGO_NB];
+  ISP_AlgoTypeDef *list[ISP_ALGO_NB];       /* Registered in hIsp->algorithm */
+  /* BadPixel */
+  uint32_t badPixelCount;
+  int8_t badPixelStep;
+  /* BlackLevel */
+  int8_t BLCR_current, BLCG_current, BLCB_current;
+  /* SimpleAWB */
+  ISP_SVC_StatStateTypeDef simpleAWBStats;
+  /* SimpleAEC */
+  ISP_SVC_StatStateTypeDef simpleAECStats;
+  /* AEC */
+  ISP_SVC_StatStateTypeDef AECStats;
+  evision_ae_estimator_t *pIspAECestimator;
+  uint32_t evision_ae_lut_exposure[EVISION_AE_LUT_EXPOSURE_SIZE];
+  uint32_t evision_ae_lut_gain[EVISION_AE_LUT_GAIN_SIZE];
+#ifdef ALGO_AEC_DBG_LOGS
+  double currentL;
+#endif
+  /* AWB */
+  ISP_SVC_StatStateTypeDef AWBStats;
+  evision_awb_estimator_t *pIspAWBestimator;
+  uint8_t enableCurrent;
+  uint8_t reconfigureRequest;
+  uint32_t currentColorTemp;
+  uint32_t awbProfId;                       /* Profile of currentColorTemp, reported to the IQ tuning tool */
+  evision_awb_profile_t awbProfiles[ISP_AWB_COLORTEMP_REF];
+  float colorTempThresholds[ISP_AWB_COLORTEMP_REF - 1];
+  /* SimpleAWB_CCT */
+  ISP_SVC_StatStateTypeDef simpleAWBCCTStats;
+  uint32_t colorTempCurrent, preventUpdate, nbSelection[ISP_AWB_COLORTEMP_REF];
+} ISP_AlgoContextTypeDef;
+
+static ISP_AlgoContextTypeDef ISP_Algo_Context[ISP_ALGO_MAX_INSTANCES];
 
 /* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  ISP_Algo_GetContext
+  *         Get the algorithm context of an ISP instance
+  * @param  hIsp:  ISP device handle. To cast in (ISP_HandleTypeDef *).
+  * @retval algorithm context
+  */
+static ISP_AlgoContextTypeDef *ISP_Algo_GetContext(void *hIsp)
+{
+  return (ISP_AlgoContextTypeDef *)((ISP_HandleTypeDef *)hIsp)->algoContext;
+}
+
 /**
   * @brief  ISP_Algo_BadPixel_Init
   *         Initialize the BadPixel algorithm
@@ -207,10 +250,8 @@ ISP_StatusTypeDef ISP_Algo_BadPixel_DeInit(void *hIsp, void *pAlgo)
   */
 ISP_StatusTypeDef ISP_Algo_BadPixel_Process(void *hIsp, void *pAlgo)
 {
-  (void)hIsp; /* unused */
   (void)pAlgo; /* unused */
-  static uint32_t BadPixelCount;
-  static int8_t Step;
+  ISP_AlgoContextTypeDef *ctx = ISP_Algo_GetContext(hIsp);
   ISP_BadPixelTypeDef BadPixelConfig;
   ISP_IQParamTypeDef *IQParamConfig;
   ISP_StatusTypeDef ret;
@@ -222,7 +263,7 @@ ISP_StatusTypeDef ISP_Algo_BadPixel_Process(void *hIsp, void *pAlgo)
     return ISP_OK;
   }
 
-  if (Step++ >= 0)
+  if (ctx->badPixelStep++ >= 0)
   {
     /* Measure the number of bad pixels */
     ret  = ISP_SVC_ISP_GetBadPixel(hIsp, &BadPixelConfig);
@@ -230,20 +271,20 @@ ISP_StatusTypeDef ISP_Algo_BadPixel_Process(void *hIsp, void *pAlgo)
     {
       return ret;
     }
-    BadPixelCount += BadPixelConfig.count;
+    ctx->badPixelCount += BadPixelConfig.count;
   }
 
-  if (Step == 10)
+  if (ctx->badPixelStep == 10)
   {
     /* All measures done : make an average and compare with threshold */
-    BadPixelCount /= 10;
+    ctx->badPixelCount /= 10;
 
-    if ((BadPixelCount > IQParamConfig->badPixelAlgo.threshold) && (BadPixelConfig.strength > 0))
+    if ((ctx->badPixelCount > IQParamConfig->badPixelAlgo.threshold) && (BadPixelConfig.strength > 0))
     {
       /* Bad pixel is above target : decrease strength */
       BadPixelConfig.strength--;
     }
-    else if ((BadPixelCount < IQParamConfig->badPixelAlgo.threshold) && (BadPixelConfig.strength < ISP_BADPIXEL_STRENGTH_MAX - 1))
+    else if ((ctx->badPixelCount < IQParamConfig->badPixelAlgo.threshold) && (BadPixelConfig.strength < ISP_BADPIXEL_STRENGTH_MAX - 1))
     {
       /* Bad pixel is below target : increase strength. (exclude ISP_BADPIXEL_STRENGTH_MAX which gives weird results) */
       BadPixelConfig.strength++;
@@ -258,8 +299,8 @@ ISP_StatusTypeDef ISP_Algo_BadPixel_Process(void *hIsp, void *pAlgo)
     }
 
     /* Set Step to -1 to wait for an extra frame before a new measurement (the ISP HW needs one frame to update after reconfig) */
-    Step = -1;
-    BadPixelCount = 0;
+    ctx->badPixelStep = -1;
+    ctx->badPixelCount = 0;
   }
 
   return ISP_OK;
@@ -306,7 +347,7 @@ ISP_StatusTypeDef ISP_Algo_BlackLevel_DeInit(void *hIsp, void *pAlgo)
 ISP_StatusTypeDef ISP_Algo_BlackLevel_Process(void *hIsp, void *pAlgo)
 {
   (void)pAlgo; /* unused */
-  static int8_t BLCR_current, BLCG_current, BLCB_current;
+  ISP_AlgoContextTypeDef *ctx = ISP_Algo_GetContext(hIsp);
   ISP_SensorGainTypeDef Gain;
   uint32_t GainDiff, MinGainDiff;
   uint8_t i, i_ref;
@@ -345,7 +386,7 @@ ISP_StatusTypeDef ISP_Algo_BlackLevel_Process(void *hIsp, void *pAlgo)
   BL_ref.BLCR = IQParamConfig->blackLevelAlgo.BLCR[i_ref];
   BL_ref.BLCG = IQParamConfig->blackLevelAlgo.BLCG[i_ref];
   BL_ref.BLCB = IQParamConfig->blackLevelAlgo.BLCB[i_ref];
-  if ((BL_ref.BLCR != BLCR_current) || (BL_ref.BLCG != BLCG_current) || (BL_ref.BLCB != BLCB_current))
+  if ((BL_ref.BLCR != ctx->BLCR_current) || (BL_ref.BLCG != ctx->BLCG_current) || (BL_ref.BLCB != ctx->BLCB_current))
   {
     /* Apply new Black Level values */
     BL_ref.enable = 1;
@@ -355,9 +396,9 @@ ISP_StatusTypeDef ISP_Algo_BlackLevel_Process(void *hIsp, void *pAlgo)
       return ret;
     }
 
-    BLCR_current = BL_ref.BLCR;
-    BLCG_current = BL_ref.BLCG;
-    BLCB_current = BL_ref.BLCB;
+    ctx->BLCR_current = BL_ref.BLCR;
+    ctx->BLCG_current = BL_ref.BLCG;
+    ctx->BLCB_current = BL_ref.BLCB;
   }
 
   return ISP_OK;
@@ -450,7 +491,8 @@ ISP_StatusTypeDef ISP_Algo_SimpleAWB_StatCb(ISP_AlgoTypeDef *pAlgo)
   */
 ISP_StatusTypeDef ISP_Algo_SimpleAWB_Process(void *hIsp, void *pAlgo)
 {
-  static ISP_SVC_StatStateTypeDef stats;
+  ISP_AlgoContextTypeDef *ctx = ISP_Algo_GetContext(hIsp);
+  ISP_SVC_StatStateTypeDef *stats = &ctx->simpleAWBStats;
   ISP_AlgoTypeDef *algo = (ISP_AlgoTypeDef *)pAlgo;
   ISP_IQParamTypeDef *IQParamConfig;
   ISP_ISPGainTypeDef gainConfig;
@@ -472,7 +514,7 @@ ISP_StatusTypeDef ISP_Algo_SimpleAWB_Process(void *hIsp, void *pAlgo)
   case ISP_ALGO_STATE_INIT:
   case ISP_ALGO_STATE_NEED_STAT:
     /* Ask for stats */
-    ret = ISP_SVC_Stats_GetNext(hIsp, &ISP_Algo_SimpleAWB_StatCb, pAlgo, &stats, ISP_STAT_LOC_DOWN, ISP_STAT_TYPE_AVG, 0);
+    ret = ISP_SVC_Stats_GetNext(hIsp, &ISP_Algo_SimpleAWB_StatCb, pAlgo, stats, ISP_STAT_LOC_DOWN, ISP_STAT_TYPE_AVG, 0);
     if (ret != ISP_OK)
     {
       return ret;
@@ -487,7 +529,7 @@ ISP_StatusTypeDef ISP_Algo_SimpleAWB_Process(void *hIsp, void *pAlgo)
     break;
 
   case ISP_ALGO_STATE_STAT_READY:
-    if ((stats.down.averageR != 0) && (stats.down.averageG != 0) && (stats.down.averageB != 0))
+    if ((stats->down.averageR != 0) && (stats->down.averageG != 0) && (stats->down.averageB != 0))
     {
       /* Read the current ISP gain */
       if (ISP_SVC_ISP_GetGain(hIsp, &gainConfig) == ISP_OK)
@@ -503,13 +545,13 @@ ISP_StatusTypeDef ISP_Algo_SimpleAWB_Process(void *hIsp, void *pAlgo)
         /* Compute the ISP gain to reach 128 for all components */
         gainConfig.enable = 1;
         val = gainConfig.ispGainR;
-        val = val * 128 / stats.down.averageR;
+        val = val * 128 / stats->down.averageR;
         gainConfig.ispGainR = val;
         val = gainConfig.ispGainG;
-        val = val * 128 / stats.down.averageG;
+        val = val * 128 / stats->down.averageG;
         gainConfig.ispGainG = val;
         val = gainConfig.ispGainB;
-        val = val * 128 / stats.down.averageB;
+        val = val * 128 / stats->down.averageB;
         gainConfig.ispGainB = val;
 
         /* Update component gains so the overall gain equals x1.0 */
@@ -529,7 +571,7 @@ ISP_StatusTypeDef ISP_Algo_SimpleAWB_Process(void *hIsp, void *pAlgo)
     }
 
     /* Ask for stats */
-    ret = ISP_SVC_Stats_GetNext(hIsp, &ISP_Algo_SimpleAWB_StatCb, pAlgo, &stats, ISP_STAT_LOC_DOWN,
+    ret = ISP_SVC_Stats_GetNext(hIsp, &ISP_Algo_SimpleAWB_StatCb, pAlgo, stats, ISP_STAT_LOC_DOWN,
                                 ISP_STAT_TYPE_AVG, ALGO_ISP_VSYNC_LATENCY);
 
     /* Wait for stats to be ready */
@@ -597,7 +639,8 @@ ISP_StatusTypeDef ISP_Algo_SimpleAEC_StatCb(ISP_AlgoTypeDef *pAlgo)
   */
 ISP_StatusTypeDef ISP_Algo_SimpleAEC_Process(void *hIsp, void *pAlgo)
 {
-  static ISP_SVC_StatStateTypeDef stats;
+  ISP_AlgoContextTypeDef *ctx = ISP_Algo_GetContext(hIsp);
+  ISP_SVC_StatStateTypeDef *stats = &ctx->simpleAECStats;
   ISP_AlgoTypeDef *algo = (ISP_AlgoTypeDef *)pAlgo;
   ISP_IQParamTypeDef *IQParamConfig;
   ISP_StatusTypeDef ret = ISP_OK;
@@ -619,7 +662,7 @@ ISP_StatusTypeDef ISP_Algo_SimpleAEC_Process(void *hIsp, void *pAlgo)
   case ISP_ALGO_STATE_INIT:
   case ISP_ALGO_STATE_NEED_STAT:
     /* Ask for stats */
-    ret = ISP_SVC_Stats_GetNext(hIsp, &ISP_Algo_SimpleAEC_StatCb, pAlgo, &stats, ISP_STAT_LOC_UP, ISP_STAT_TYPE_AVG, 0);
+    ret = ISP_SVC_Stats_GetNext(hIsp, &ISP_Algo_SimpleAEC_StatCb, pAlgo, stats, ISP_STAT_LOC_UP, ISP_STAT_TYPE_AVG, 0);
     if (ret != ISP_OK)
     {
       return ret;
@@ -634,7 +677,7 @@ ISP_StatusTypeDef ISP_Algo_SimpleAEC_Process(void *hIsp, void *pAlgo)
     break;
 
   case ISP_ALGO_STATE_STAT_READY:
-    avgL = stats.up.averageL;
+    avgL = stats->up.averageL;
     if (avgL != 0)
     {
       /* Read the current sensor gain */
@@ -677,7 +720,7 @@ ISP_StatusTypeDef ISP_Algo_SimpleAEC_Process(void *hIsp, void *pAlgo)
     }
 
     /* Ask for stats */
-    ret = ISP_SVC_Stats_GetNext(hIsp, &ISP_Algo_SimpleAEC_StatCb, pAlgo, &stats,
+    ret = ISP_SVC_Stats_GetNext(hIsp, &ISP_Algo_SimpleAEC_StatCb, pAlgo, stats,
                                 ISP_STAT_LOC_UP, ISP_STAT_TYPE_AVG, ALGO_ISP_SENSOR_VSYNC_LATENCY);
     /* Wait for stats to be ready */
     algo->state = ISP_ALGO_STATE_WAITING_STAT;
@@ -763,6 +806,7 @@ void ISP_Algo_ApplyCConv(ISP_HandleTypeDef *hIsp, uint32_t inR, uint32_t inG, ui
   */
 ISP_StatusTypeDef ISP_Algo_AEC_Init(void *hIsp, void *pAlgo)
 {
+  ISP_AlgoContextTypeDef *ctx = ISP_Algo_GetContext(hIsp);
   ISP_AlgoTypeDef *algo = (ISP_AlgoTypeDef *)pAlgo;
   ISP_IQParamTypeDef *IQParamConfig;
   evision_return_t e_ret;
@@ -774,16 +818,16 @@ ISP_StatusTypeDef ISP_Algo_AEC_Init(void *hIsp, void *pAlgo)
     EVISION_AE_LUT_EXPOSURE_SIZE
   };
   uint32_t* exposure_luts[EVISION_AE_MAX_SENSOR_CONFIGS] = {
-    evision_ae_lut_exposure,
-    evision_ae_lut_exposure
+    ctx->evision_ae_lut_exposure,
+    ctx->evision_ae_lut_exposure
   };
   uint32_t gain_lut_full_sizes[EVISION_AE_MAX_SENSOR_CONFIGS] = {
     EVISION_AE_LUT_GAIN_SIZE,
     EVISION_AE_LUT_GAIN_SIZE
   };
   uint32_t* gain_luts[EVISION_AE_MAX_SENSOR_CONFIGS] = {
-    evision_ae_lut_gain,
-    evision_ae_lut_gain
+    ctx->evision_ae_lut_gain,
+    ctx->evision_ae_lut_gain
   };
   ISP_SensorInfoTypeDef SensorInfo = {0};
   uint32_t idx;
@@ -800,48 +844,49 @@ ISP_StatusTypeDef ISP_Algo_AEC_Init(void *hIsp, void *pAlgo)
   /* Fill lookup tables */
   for (idx = 0; idx < EVISION_AE_LUT_EXPOSURE_SIZE; idx++)
   {
-    evision_ae_lut_exposure[idx] = SensorInfo.exposure_min + idx * (SensorInfo.exposure_max - SensorInfo.exposure_min) / (EVISION_AE_LUT_EXPOSURE_SIZE - 1);
+    ctx->evision_ae_lut_exposure[idx] = SensorInfo.exposure_min + idx * (SensorInfo.exposure_max - SensorInfo.exposure_min) / (EVISION_AE_LUT_EXPOSURE_SIZE - 1);
   }
 
   for (idx = 0; idx < EVISION_AE_LUT_GAIN_SIZE; idx++)
   {
-    evision_ae_lut_gain[idx] = SensorInfo.gain_min + idx * (SensorInfo.gain_max - SensorInfo.gain_min) / (EVISION_AE_LUT_GAIN_SIZE - 1);
+    ctx->evision_ae_lut_gain[idx] = SensorInfo.gain_min + idx * (SensorInfo.gain_max - SensorInfo.gain_min) / (EVISION_AE_LUT_GAIN_SIZE - 1);
   }
 
   /* Create estimator */
-  pIspAECestimator = evision_api_ae_new();
-  if (pIspAECestimator == NULL)
+  ctx->pIspAECestimator = evision_api_ae_new();
+  if (ctx->pIspAECestimator == NULL)
   {
     return ISP_ERR_ALGO;
   }
 
   /* Initialize estimator */
-  e_ret = evision_api_ae_init(pIspAECestimator,
+  e_ret = evision_api_ae_init(ctx->pIspAECestimator,
                               exposure_lut_sizes,
                               (const uint32_t**)exposure_luts,
                               gain_lut_full_sizes,
                               (const uint32_t**)gain_luts);
   if (e_ret != EVISION_RET_SUCCESS)
   {
-    evision_api_ae_delete(pIspAECestimator);
+    evision_api_ae_delete(ctx->pIspAECestimator);
+    ctx->pIspAECestimator = NULL;
     return ISP_ERR_ALGO;
   }
 
   /* Configure algo (AEC target) */
-  pIspAECestimator->hyper_params.desired_luminosity = IQParamConfig->AECAlgo.exposureTarget;
+  ctx->pIspAECestimator->hyper_params.desired_luminosity = IQParamConfig->AECAlgo.exposureTarget;
 
   /* Configure algo (sensor config) */
-  pIspAECestimator->active_sensor_cfg = &pIspAECestimator->sensor_configs[EVISION_AE_DEFAULT_SENSOR_CONFIG];
-  pIspAECestimator->hyper_params.exposure_min = pIspAECestimator->active_sensor_cfg->lut_exposure[0u];
-  pIspAECestimator->hyper_params.exposure_max = pIspAECestimator->active_sensor_cfg->lut_exposure[pIspAECestimator->active_sensor_cfg->lut_exposure_size - 1u];
-  pIspAECestimator->hyper_params.gain_min = pIspAECestimator->active_sensor_cfg->full_lut_gain[0u];
-  pIspAECestimator->hyper_params.gain_max = pIspAECestimator->active_sensor_cfg->full_lut_gain[pIspAECestimator->active_sensor_cfg->full_lut_gain_size - 1u];
+  ctx->pIspAECestimator->active_sensor_cfg = &ctx->pIspAECestimator->sensor_configs[EVISION_AE_DEFAULT_SENSOR_CONFIG];
+  ctx->pIspAECestimator->hyper_params.exposure_min = ctx->pIspAECestimator->active_sensor_cfg->lut_exposure[0u];
+  ctx->pIspAECestimator->hyper_params.exposure_max = ctx->pIspAECestimator->active_sensor_cfg->lut_exposure[ctx->pIspAECestimator->active_sensor_cfg->lut_exposure_size - 1u];
+  ctx->pIspAECestimator->hyper_params.gain_min = ctx->pIspAECestimator->active_sensor_cfg->full_lut_gain[0u];
+  ctx->pIspAECestimator->hyper_params.gain_max = ctx->pIspAECestimator->active_sensor_cfg->full_lut_gain[ctx->pIspAECestimator->active_sensor_cfg->full_lut_gain_size - 1u];
 
   /* Initialize exposure and gain at min value */
-  pIspAECestimator->exposure = pIspAECestimator->active_sensor_cfg->lut_exposure[0];
-  pIspAECestimator->gain = pIspAECestimator->active_sensor_cfg->full_lut_gain[0];
-  exposureConfig.exposure = (uint32_t)pIspAECestimator->exposure;
-  gainConfig.gain = pIspAECestimator->gain;
+  ctx->pIspAECestimator->exposure = ctx->pIspAECestimator->active_sensor_cfg->lut_exposure[0];
+  ctx->pIspAECestimator->gain = ctx->pIspAECestimator->active_sensor_cfg->full_lut_gain[0];
+  exposureConfig.exposure = (uint32_t)ctx->pIspAECestimator->exposure;
+  gainConfig.gain = ctx->pIspAECestimator->gain;
 
   if (IQParamConfig->AECAlgo.enable == true)
   {
@@ -867,12 +912,13 @@ ISP_StatusTypeDef ISP_Algo_AEC_Init(void *hIsp, void *pAlgo)
   */
 ISP_StatusTypeDef ISP_Algo_AEC_DeInit(void *hIsp, void *pAlgo)
 {
-  (void)hIsp; /* unused */
   (void)pAlgo; /* unused */
+  ISP_AlgoContextTypeDef *ctx = ISP_Algo_GetContext(hIsp);
 
-  if (pIspAECestimator != NULL)
+  if (ctx->pIspAECestimator != NULL)
   {
-    evision_api_ae_delete(pIspAECestimator);
+    evision_api_ae_delete(ctx->pIspAECestimator);
+    ctx->pIspAECestimator = NULL;
   }
 
   return ISP_OK;
@@ -902,7 +948,8 @@ ISP_StatusTypeDef ISP_Algo_AEC_StatCb(ISP_AlgoTypeDef *pAlgo)
   */
 ISP_StatusTypeDef ISP_Algo_AEC_Process(void *hIsp, void *pAlgo)
 {
-  static ISP_SVC_StatStateTypeDef stats;
+  ISP_AlgoContextTypeDef *ctx = ISP_Algo_GetContext(hIsp);
+  ISP_SVC_StatStateTypeDef *stats = &ctx->AECStats;
   ISP_AlgoTypeDef *algo = (ISP_AlgoTypeDef *)pAlgo;
   ISP_IQParamTypeDef *IQParamConfig;
   evision_return_t e_ret;
@@ -911,9 +958,6 @@ ISP_StatusTypeDef ISP_Algo_AEC_Process(void *hIsp, void *pAlgo)
   ISP_SensorExposureTypeDef exposureConfig;
   double ccAvgL;
   uint32_t index_max, index_current, index_max_step;
-#ifdef ALGO_AEC_DBG_LOGS
-  static double currentL;
-#endif
 
   IQParamConfig = ISP_SVC_IQParam_Get(hIsp);
 
@@ -926,9 +970,9 @@ ISP_StatusTypeDef ISP_Algo_AEC_Process(void *hIsp, void *pAlgo)
     /* Restore sensor exposure and gain, if it has been changed by user or application */
     ret = ISP_SVC_Sensor_GetGain(hIsp, &gainConfig);
 
-    if ((ret == ISP_OK) && (gainConfig.gain != pIspAECestimator->gain))
+    if ((ret == ISP_OK) && (gainConfig.gain != ctx->pIspAECestimator->gain))
     {
-      gainConfig.gain = pIspAECestimator->gain;
+      gainConfig.gain = ctx->pIspAECestimator->gain;
       ret = ISP_SVC_Sensor_SetGain(hIsp, &gainConfig);
     }
 
@@ -939,9 +983,9 @@ ISP_StatusTypeDef ISP_Algo_AEC_Process(void *hIsp, void *pAlgo)
 
     ret = ISP_SVC_Sensor_GetExposure(hIsp, &exposureConfig);
 
-    if ((ret == ISP_OK) && (exposureConfig.exposure != pIspAECestimator->exposure))
+    if ((ret == ISP_OK) && (exposureConfig.exposure != ctx->pIspAECestimator->exposure))
     {
-      exposureConfig.exposure = (uint32_t) pIspAECestimator->exposure;
+      exposureConfig.exposure = (uint32_t) ctx->pIspAECestimator->exposure;
       ret = ISP_SVC_Sensor_SetExposure(hIsp, &exposureConfig);
     }
 
@@ -955,7 +999,7 @@ ISP_StatusTypeDef ISP_Algo_AEC_Process(void *hIsp, void *pAlgo)
   {
   case ISP_ALGO_STATE_INIT:
     /* Upon estimator first run, it is expected that the sensor has min values of sensor gain & exposure, so with a Luminance of 0 */
-    memset(&stats, 0, sizeof(stats));
+    memset(stats, 0, sizeof(*stats));
 
     /* Claim that stats are ready */
     algo->state = ISP_ALGO_STATE_STAT_READY;
@@ -963,7 +1007,7 @@ ISP_StatusTypeDef ISP_Algo_AEC_Process(void *hIsp, void *pAlgo)
 
   case ISP_ALGO_STATE_NEED_STAT:
     /* Ask for stats */
-    ret = ISP_SVC_Stats_GetNext(hIsp, &ISP_Algo_AEC_StatCb, pAlgo, &stats, ISP_STAT_LOC_DOWN,
+    ret = ISP_SVC_Stats_GetNext(hIsp, &ISP_Algo_AEC_StatCb, pAlgo, stats, ISP_STAT_LOC_DOWN,
                                 ISP_STAT_TYPE_AVG, ALGO_ISP_SENSOR_VSYNC_LATENCY);
     if (ret != ISP_OK)
     {
@@ -980,29 +1024,29 @@ ISP_StatusTypeDef ISP_Algo_AEC_Process(void *hIsp, void *pAlgo)
 
   case ISP_ALGO_STATE_STAT_READY:
     /* Align on the target update (may have been updated with ISP_SetExposureTarget()) */
-    pIspAECestimator->hyper_params.desired_luminosity = IQParamConfig->AECAlgo.exposureTarget;
-    ccAvgL = (double)stats.down.averageL;
+    ctx->pIspAECestimator->hyper_params.desired_luminosity = IQParamConfig->AECAlgo.exposureTarget;
+    ccAvgL = (double)stats->down.averageL;
 #ifdef ALGO_AEC_DBG_LOGS
-    if (ccAvgL != currentL)
+    if (ccAvgL != ctx->currentL)
     {
       printf("L = %ld\r\n", (uint32_t) ccAvgL);
-      currentL = ccAvgL;
+      ctx->currentL = ccAvgL;
     }
 #endif
 
     /* Run algo to estimate exposure and gain to apply */
-    e_ret = evision_api_ae_run_average(pIspAECestimator, NULL, 1, ccAvgL);
+    e_ret = evision_api_ae_run_average(ctx->pIspAECestimator, NULL, 1, ccAvgL);
     if (e_ret == EVISION_RET_SUCCESS)
     {
       ret = ISP_SVC_Sensor_GetGain(hIsp, &gainConfig);
 
-      if ((ret == ISP_OK) && (gainConfig.gain != pIspAECestimator->gain))
+      if ((ret == ISP_OK) && (gainConfig.gain != ctx->pIspAECestimator->gain))
       {
         /* Set new gain */
 #ifdef ALGO_AEC_DBG_LOGS
-        printf("New gain = %ld\r\n", pIspAECestimator->gain);
+        printf("New gain = %ld\r\n", ctx->pIspAECestimator->gain);
 #endif
-        gainConfig.gain = pIspAECestimator->gain;
+        gainConfig.gain = ctx->pIspAECestimator->gain;
         ret = ISP_SVC_Sensor_SetGain(hIsp, &gainConfig);
       }
 
@@ -1013,13 +1057,13 @@ ISP_StatusTypeDef ISP_Algo_AEC_Process(void *hIsp, void *pAlgo)
 
       ret = ISP_SVC_Sensor_GetExposure(hIsp, &exposureConfig);
 
-      if ((ret == ISP_OK) && (exposureConfig.exposure != pIspAECestimator->exposure))
+      if ((ret == ISP_OK) && (exposureConfig.exposure != ctx->pIspAECestimator->exposure))
       {
         /* Set new exposure */
 #ifdef ALGO_AEC_DBG_LOGS
-        printf("New Exposure = %ld\r\n", (uint32_t)pIspAECestimator->exposure);
+        printf("New Exposure = %ld\r\n", (uint32_t)ctx->pIspAECestimator->exposure);
 #endif
-        exposureConfig.exposure = (uint32_t) pIspAECestimator->exposure;
+        exposureConfig.exposure = (uint32_t) ctx->pIspAECestimator->exposure;
         ret = ISP_SVC_Sensor_SetExposure(hIsp, &exposureConfig);
       }
 
@@ -1030,17 +1074,17 @@ ISP_StatusTypeDef ISP_Algo_AEC_Process(void *hIsp, void *pAlgo)
 
       /* Limit to 6 dB steps (when the algo accepts that constraint) */
       /* TODO: since this is specific to IMX335, it shall be reworked to be generic */
-      index_max = pIspAECestimator->active_sensor_cfg->full_lut_gain_size;
-      index_current = pIspAECestimator->runtime_vars.index_gain;
+      index_max = ctx->pIspAECestimator->active_sensor_cfg->full_lut_gain_size;
+      index_current = ctx->pIspAECestimator->runtime_vars.index_gain;
       index_max_step = EVISION_AE_LUT_GAIN_SIZE / 10;
-      pIspAECestimator->hyper_params.index_diff_gain_max = index_max - (index_current + index_max_step);
+      ctx->pIspAECestimator->hyper_params.index_diff_gain_max = index_max - (index_current + index_max_step);
       if (index_current > index_max_step)
       {
-        pIspAECestimator->hyper_params.index_diff_gain_min = index_current - index_max_step;
+        ctx->pIspAECestimator->hyper_params.index_diff_gain_min = index_current - index_max_step;
       }
       else
       {
-        pIspAECestimator->hyper_params.index_diff_gain_min = 0;
+        ctx->pIspAECestimator->hyper_params.index_diff_gain_min = 0;
       }
     }
     else
@@ -1049,7 +1093,7 @@ ISP_StatusTypeDef ISP_Algo_AEC_Process(void *hIsp, void *pAlgo)
     }
 
     /* Ask for stats */
-    ret_stat = ISP_SVC_Stats_GetNext(hIsp, &ISP_Algo_AEC_StatCb, pAlgo, &stats, ISP_STAT_LOC_DOWN,
+    ret_stat = ISP_SVC_Stats_GetNext(hIsp, &ISP_Algo_AEC_StatCb, pAlgo, stats, ISP_STAT_LOC_DOWN,
                                      ISP_STAT_TYPE_AVG, ALGO_ISP_SENSOR_VSYNC_LATENCY);
     ret = (ret != ISP_OK) ? ret : ret_stat;
 
@@ -1070,12 +1114,12 @@ ISP_StatusTypeDef ISP_Algo_AEC_Process(void *hIsp, void *pAlgo)
   */
 ISP_StatusTypeDef ISP_Algo_AWB_Init(void *hIsp, void *pAlgo)
 {
-  (void)hIsp; /* unused */
+  ISP_AlgoContextTypeDef *ctx = ISP_Algo_GetContext(hIsp);
   ISP_AlgoTypeDef *algo = (ISP_AlgoTypeDef *)pAlgo;
 
   /* Create estimator */
-  pIspAWBestimator = evision_api_awb_new();
-  if (pIspAWBestimator == NULL)
+  ctx->pIspAWBestimator = evision_api_awb_new();
+  if (ctx->pIspAWBestimator == NULL)
   {
     return ISP_ERR_ALGO;
   }
@@ -1096,12 +1140,13 @@ ISP_StatusTypeDef ISP_Algo_AWB_Init(void *hIsp, void *pAlgo)
   */
 ISP_StatusTypeDef ISP_Algo_AWB_DeInit(void *hIsp, void *pAlgo)
 {
-  (void)hIsp; /* unused */
   (void)pAlgo; /* unused */
+  ISP_AlgoContextTypeDef *ctx = ISP_Algo_GetContext(hIsp);
 
-  if (pIspAWBestimator != NULL)
+  if (ctx->pIspAWBestimator != NULL)
   {
-    evision_api_awb_delete(pIspAWBestimator);
+    evision_api_awb_delete(ctx->pIspAWBestimator);
+    ctx->pIspAWBestimator = NULL;
   }
 
   return ISP_OK;
@@ -1134,12 +1179,8 @@ ISP_StatusTypeDef ISP_Algo_AWB_StatCb(ISP_AlgoTypeDef *pAlgo)
   */
 ISP_StatusTypeDef ISP_Algo_AWB_Process(void *hIsp, void *pAlgo)
 {
-  static ISP_SVC_StatStateTypeDef stats;
-  static uint8_t enableCurrent = false;
-  static uint8_t reconfigureRequest = false;
-  static uint32_t currentColorTemp = 0;
-  static evision_awb_profile_t awbProfiles[ISP_AWB_COLORTEMP_REF];
-  static float colorTempThresholds[ISP_AWB_COLORTEMP_REF - 1];
+  ISP_AlgoContextTypeDef *ctx = ISP_Algo_GetContext(hIsp);
+  ISP_SVC_StatStateTypeDef *stats = &ctx->AWBStats;
   ISP_IQParamTypeDef *IQParamConfig;
   ISP_ColorConvTypeDef ColorConvConfig;
   ISP_ISPGainTypeDef ISPGainConfig;
@@ -1154,16 +1195,16 @@ ISP_StatusTypeDef ISP_Algo_AWB_Process(void *hIsp, void *pAlgo)
 
   if (IQParamConfig->AWBAlgo.enable == false)
   {
-    enableCurrent = false;
+    ctx->enableCurrent = false;
     return ISP_OK;
   }
-  else if ((enableCurrent == false) || (IQParamConfig->AWBAlgo.enable == ISP_AWB_ENABLE_RECONFIGURE))
+  else if ((ctx->enableCurrent == false) || (IQParamConfig->AWBAlgo.enable == ISP_AWB_ENABLE_RECONFIGURE))
   {
     /* Start or resume algo : set state to INIT in order to read the IQ params */
     algo->state = ISP_ALGO_STATE_INIT;
     IQParamConfig->AWBAlgo.enable = true;
-    reconfigureRequest = true;
-    enableCurrent = true;
+    ctx->reconfigureRequest = true;
+    ctx->enableCurrent = true;
   }
 
   switch(algo->state)
@@ -1180,12 +1221,12 @@ ISP_StatusTypeDef ISP_Algo_AWB_Process(void *hIsp, void *pAlgo)
       if (profNb > 0)
       {
         /* Profile decision threshold = average of two reference temperatures */
-        colorTempThresholds[profNb - 1] = (float) ((colorTemp + IQParamConfig->AWBAlgo.referenceColorTemp[profId - 1]) /2 );
+        ctx->colorTempThresholds[profNb - 1] = (float) ((colorTemp + IQParamConfig->AWBAlgo.referenceColorTemp[profId - 1]) /2 );
 
         /* Improve D65 detection : set D50/D65 threshold to 5500 */
         if ((colorTemp == 6500) && (IQParamConfig->AWBAlgo.referenceColorTemp[profId - 1] == 5000))
         {
-          colorTempThresholds[profNb - 1] = 5300;
+          ctx->colorTempThresholds[profNb - 1] = 5300;
         }
       }
 
@@ -1205,7 +1246,7 @@ ISP_StatusTypeDef ISP_Algo_AWB_Process(void *hIsp, void *pAlgo)
       }
 
       /* Set profile */
-      evision_api_awb_set_profile(&awbProfiles[profId], (float) colorTemp, cfaGains, ccmCoeffs, ccmOffsets);
+      evision_api_awb_set_profile(&ctx->awbProfiles[profId], (float) colorTemp, cfaGains, ccmCoeffs, ccmOffsets);
       profNb++;
     }
 
@@ -1215,9 +1256,9 @@ ISP_StatusTypeDef ISP_Algo_AWB_Process(void *hIsp, void *pAlgo)
     }
 
     /* Register profiles */
-    e_ret = evision_api_awb_init_profiles(pIspAWBestimator, (double) IQParamConfig->AWBAlgo.referenceColorTemp[0],
+    e_ret = evision_api_awb_init_profiles(ctx->pIspAWBestimator, (double) IQParamConfig->AWBAlgo.referenceColorTemp[0],
                                           (double) IQParamConfig->AWBAlgo.referenceColorTemp[profNb - 1], profNb,
-                                          colorTempThresholds, awbProfiles);
+                                          ctx->colorTempThresholds, ctx->awbProfiles);
     if (e_ret != EVISION_RET_SUCCESS)
     {
       return ISP_ERR_ALGO;
@@ -1225,13 +1266,13 @@ ISP_StatusTypeDef ISP_Algo_AWB_Process(void *hIsp, void *pAlgo)
 
     /* Configure algo */
     /* TODO: check if this shall be an IQ tuning parameter (like the LUT tables of AE algo) */
-    pIspAWBestimator->hyper_params.speed_p_min = 1.35;
-    pIspAWBestimator->hyper_params.speed_p_max = 2.0;
-    pIspAWBestimator->hyper_params.gm_tolerance = 1;
-    pIspAWBestimator->hyper_params.conv_criterion = 3;
+    ctx->pIspAWBestimator->hyper_params.speed_p_min = 1.35;
+    ctx->pIspAWBestimator->hyper_params.speed_p_max = 2.0;
+    ctx->pIspAWBestimator->hyper_params.gm_tolerance = 1;
+    ctx->pIspAWBestimator->hyper_params.conv_criterion = 3;
 
     /* Ask for stats */
-    ret = ISP_SVC_Stats_GetNext(hIsp, &ISP_Algo_AWB_StatCb, pAlgo, &stats, ISP_STAT_LOC_DOWN,
+    ret = ISP_SVC_Stats_GetNext(hIsp, &ISP_Algo_AWB_StatCb, pAlgo, stats, ISP_STAT_LOC_DOWN,
                                 ISP_STAT_TYPE_AVG, ALGO_ISP_VSYNC_LATENCY);
     if (ret != ISP_OK)
     {
@@ -1243,7 +1284,7 @@ ISP_StatusTypeDef ISP_Algo_AWB_Process(void *hIsp, void *pAlgo)
     break;
 
   case ISP_ALGO_STATE_NEED_STAT:
-    ret = ISP_SVC_Stats_GetNext(hIsp, &ISP_Algo_AWB_StatCb, pAlgo, &stats, ISP_STAT_LOC_DOWN,
+    ret = ISP_SVC_Stats_GetNext(hIsp, &ISP_Algo_AWB_StatCb, pAlgo, stats, ISP_STAT_LOC_DOWN,
                                 ISP_STAT_TYPE_AVG, ALGO_ISP_VSYNC_LATENCY);
     if (ret != ISP_OK)
     {
@@ -1260,7 +1301,7 @@ ISP_StatusTypeDef ISP_Algo_AWB_Process(void *hIsp, void *pAlgo)
 
   case ISP_ALGO_STATE_STAT_READY:
     /* Get stats after color conversion */
-    ISP_Algo_ApplyCConv(hIsp, stats.down.averageR, stats.down.averageG, stats.down.averageB, &ccAvgR, &ccAvgG, &ccAvgB);
+    ISP_Algo_ApplyCConv(hIsp, stats->down.averageR, stats->down.averageG, stats->down.averageB, &ccAvgR, &ccAvgG, &ccAvgB);
 
     /* Apply gamma */
     meas[0] = ISP_Algo_ApplyGammaInverse(hIsp, ccAvgR);
@@ -1268,7 +1309,7 @@ ISP_StatusTypeDef ISP_Algo_AWB_Process(void *hIsp, void *pAlgo)
     meas[2] = ISP_Algo_ApplyGammaInverse(hIsp, ccAvgB);
 
     /* Run algo to estimate gain and color conversion to apply */
-    e_ret = evision_api_awb_run_average(pIspAWBestimator, NULL, 1, meas);
+    e_ret = evision_api_awb_run_average(ctx->pIspAWBestimator, NULL, 1, meas);
     if (e_ret == EVISION_RET_SUCCESS)
     {
 #ifdef ALGO_AWB_DBG_LOGS
@@ -1276,10 +1317,10 @@ ISP_StatusTypeDef ISP_Algo_AWB_Process(void *hIsp, void *pAlgo)
       static int nb_colortemp_change[ISP_AWB_COLORTEMP_REF];
 
       nb_meas++;
-      if (pIspAWBestimator->out_temp != currentColorTemp)
+      if (ctx->pIspAWBestimator->out_temp != ctx->currentColorTemp)
         nb_changes++;
       for (int i = 0; i < ISP_AWB_COLORTEMP_REF; i++) {
-        if (pIspAWBestimator->out_temp == IQParamConfig->AWBAlgo.referenceColorTemp[i])
+        if (ctx->pIspAWBestimator->out_temp == IQParamConfig->AWBAlgo.referenceColorTemp[i])
         {
           nb_colortemp_change[i]++;
           continue;
@@ -1303,18 +1344,18 @@ ISP_StatusTypeDef ISP_Algo_AWB_Process(void *hIsp, void *pAlgo)
         }
       }
 #endif
-      if (pIspAWBestimator->out_temp != currentColorTemp || reconfigureRequest == true)
+      if (ctx->pIspAWBestimator->out_temp != ctx->currentColorTemp || ctx->reconfigureRequest == true)
       {
-        /* Force to apply a WB profile when reconfigureRequest is true */
-        reconfigureRequest = false;
+        /* Force to apply a WB profile when ctx->reconfigureRequest is true */
+        ctx->reconfigureRequest = false;
 
 #ifdef ALGO_AWB_DBG_LOGS
-        printf("Color temperature = %ld\r\n", (uint32_t) pIspAWBestimator->out_temp);
+        printf("Color temperature = %ld\r\n", (uint32_t) ctx->pIspAWBestimator->out_temp);
 #endif
         /* Find the index profile for this referenceColorTemp */
         for (profId = 0; profId < ISP_AWB_COLORTEMP_REF; profId++)
         {
-          if (pIspAWBestimator->out_temp == IQParamConfig->AWBAlgo.referenceColorTemp[profId])
+          if (ctx->pIspAWBestimator->out_temp == IQParamConfig->AWBAlgo.referenceColorTemp[profId])
             break;
         }
 
@@ -1340,8 +1381,8 @@ ISP_StatusTypeDef ISP_Algo_AWB_Process(void *hIsp, void *pAlgo)
             ret = ISP_SVC_ISP_SetGain(hIsp, &ISPGainConfig);
             if (ret == ISP_OK)
             {
-              currentColorTemp = (uint32_t) pIspAWBestimator->out_temp ;
-              current_awb_profId = profId;
+              ctx->currentColorTemp = (uint32_t) ctx->pIspAWBestimator->out_temp ;
+              ctx->awbProfId = profId;
             }
           }
         }
@@ -1353,7 +1394,7 @@ ISP_StatusTypeDef ISP_Algo_AWB_Process(void *hIsp, void *pAlgo)
     }
 
     /* Ask for stats */
-    ret_stat = ISP_SVC_Stats_GetNext(hIsp, &ISP_Algo_AWB_StatCb, pAlgo, &stats, ISP_STAT_LOC_DOWN,
+    ret_stat = ISP_SVC_Stats_GetNext(hIsp, &ISP_Algo_AWB_StatCb, pAlgo, stats, ISP_STAT_LOC_DOWN,
                                      ISP_STAT_TYPE_AVG, ALGO_ISP_VSYNC_LATENCY);
     ret = (ret != ISP_OK) ? ret : ret_stat;
 
@@ -1367,24 +1408,43 @@ ISP_StatusTypeDef ISP_Algo_AWB_Process(void *hIsp, void *pAlgo)
 
 /**
   * @brief  ISP_Algo_SimpleAWB_CCT_LinearSrgb
-  *         Convert sRGB component to linear value
-  * @param  c:   sRGB component
-  * @retval linear component
+  *         Linear value of the 8-bit sRGB components: ((c / 255 + 0.055) / 1.055) ^ 2.4, or c / 255 / 12.92
+  *         below 0.04045. Precomputed to avoid pow() and double precision (emulated on the single precision FPU)
   */
-static double_t ISP_Algo_SimpleAWB_CCT_LinearSrgb(double c)
-{
-  double linh;
-
-  if (c <= 0.04045)
-  {
-    linh = c / 12.92;
-  }
-  else
-  {
-    linh = pow((c + 0.055) / 1.055, 2.4);
-  }
-  return linh;
-}
+static const float ISP_Algo_SimpleAWB_CCT_LinearSrgb[256] = {
+  0.0f, 0.00030352698f, 0.00060705397f, 0.00091058095f, 0.0012141079f, 0.0015176349f, 0.0018211619f, 0.0021246889f,
+  0.0024282159f, 0.0027317429f, 0.0030352698f, 0.0033465358f, 0.0036765073f, 0.004024717f, 0.004391442f, 0.0047769535f,
+  0.0051815167f, 0.0056053916f, 0.006048833f, 0.0065120908f, 0.0069954102f, 0.007499032f, 0.008023193f, 0.0085681256f,
+  0.0091340587f, 0.0097212173f, 0.010329823f, 0.010960094f, 0.011612245f, 0.012286488f, 0.012983032f, 0.013702083f,
+  0.014443844f, 0.015208514f, 0.015996293f, 0.016807376f, 0.017641954f, 0.01850022f, 0.019382361f, 0.020288563f,
+  0.02121901f, 0.022173885f, 0.023153366f, 0.024157632f, 0.02518686f, 0.026241222f, 0.027320892f, 0.028426039f,
+  0.029556834f, 0.030713444f, 0.031896033f, 0.033104767f, 0.034339807f, 0.035601315f, 0.03688945f, 0.038204372f,
+  0.039546235f, 0.040915197f, 0.042311411f, 0.043735029f, 0.045186204f, 0.046665086f, 0.048171824f, 0.049706566f,
+  0.051269458f, 0.052860647f, 0.054480276f, 0.05612849f, 0.05780543f, 0.059511238f, 0.061246054f, 0.063010018f,
+  0.064803267f, 0.066625939f, 0.06847817f, 0.070360096f, 0.072271851f, 0.074213568f, 0.076185381f, 0.078187422f,
+  0.08021982f, 0.082282707f, 0.084376212f, 0.086500462f, 0.088655586f, 0.090841711f, 0.093058963f, 0.095307467f,
+  0.097587347f, 0.099898728f, 0.10224173f, 0.10461648f, 0.1070231f, 0.10946171f, 0.11193243f, 0.11443537f,
+  0.11697067f, 0.11953843f, 0.12213877f, 0.12477182f, 0.12743768f, 0.13013648f, 0.13286832f, 0.13563333f,
+  0.13843162f, 0.14126329f, 0.14412847f, 0.14702727f, 0.14995979f, 0.15292615f, 0.15592646f, 0.15896084f,
+  0.16202938f, 0.16513219f, 0.1682694f, 0.1714411f, 0.1746474f, 0.17788842f, 0.18116424f, 0.18447499f,
+  0.18782077f, 0.19120168f, 0.19461783f, 0.19806932f, 0.20155625f, 0.20507874f, 0.20863687f, 0.21223076f,
+  0.2158605f, 0.2195262f, 0.22322796f, 0.22696587f, 0.23074005f, 0.23455058f, 0.23839757f, 0.24228112f,
+  0.24620133f, 0.25015828f, 0.25415209f, 0.25818285f, 0.26225066f, 0.2663556f, 0.27049779f, 0.27467731f,
+  0.27889426f, 0.28314874f, 0.28744084f, 0.29177065f, 0.29613827f, 0.30054379f, 0.30498731f, 0.30946892f,
+  0.31398871f, 0.31854678f, 0.32314321f, 0.3277781f, 0.33245154f, 0.33716362f, 0.34191442f, 0.34670406f,
+  0.3515326f, 0.35640014f, 0.36130678f, 0.3662526f, 0.37123768f, 0.37626212f, 0.38132601f, 0.38642943f,
+  0.39157248f, 0.39675523f, 0.40197778f, 0.40724021f, 0.41254261f, 0.41788507f, 0.42326767f, 0.4286905f,
+  0.43415364f, 0.43965717f, 0.44520119f, 0.45078578f, 0.45641102f, 0.462077f, 0.4677838f, 0.4735315f,
+  0.47932018f, 0.48514994f, 0.49102085f, 0.496933f, 0.50288646f, 0.50888132f, 0.51491767f, 0.52099557f,
+  0.52711513f, 0.5332764f, 0.53947949f, 0.54572446f, 0.5520114f, 0.55834039f, 0.56471151f, 0.57112483f,
+  0.57758044f, 0.58407842f, 0.59061884f, 0.59720179f, 0.60382734f, 0.61049557f, 0.61720656f, 0.62396039f,
+  0.63075714f, 0.63759687f, 0.64447968f, 0.65140564f, 0.65837482f, 0.6653873f, 0.67244316f, 0.67954247f,
+  0.68668531f, 0.69387176f, 0.70110189f, 0.70837578f, 0.7156935f, 0.72305513f, 0.73046074f, 0.73791041f,
+  0.74540421f, 0.75294222f, 0.7605245f, 0.76815115f, 0.77582222f, 0.78353779f, 0.79129794f, 0.79910274f,
+  0.80695226f, 0.81484657f, 0.82278575f, 0.83076988f, 0.83879901f, 0.84687323f, 0.85499261f, 0.86315721f,
+  0.87136712f, 0.8796224f, 0.88792312f, 0.89626935f, 0.90466117f, 0.91309865f, 0.92158186f, 0.93011086f,
+  0.93868573f, 0.94730654f, 0.95597335f, 0.96468625f, 0.97344529f, 0.98225055f, 0.9911021f, 1.0f
+};
 
 /**
   * @brief  ISP_Algo_SimpleAWB_CCT_ComputeCCT
@@ -1394,21 +1454,21 @@ static double_t ISP_Algo_SimpleAWB_CCT_LinearSrgb(double c)
   * @param  b: Blue component
   * @retval Correlated Color Temperature in °K
   */
-static double_t ISP_Algo_SimpleAWB_CCT_ComputeCCT(uint8_t r, uint8_t g, uint8_t b)
+static float ISP_Algo_SimpleAWB_CCT_ComputeCCT(uint8_t r, uint8_t g, uint8_t b)
 {
   /* Correlation matrix used in order to convert RBG values to XYZ space */
   /* Illuminant = D65      RGB (R709) [sRGB or HDTV] to XYZ */
-  const double_t Cx[] = {0.4124, 0.3576, 0.1805};
-  const double_t Cy[] = {0.2126, 0.7152, 0.0722};
-  const double_t Cz[] = {0.0193, 0.1192, 0.9505};
+  const float Cx[] = {0.4124f, 0.3576f, 0.1805f};
+  const float Cy[] = {0.2126f, 0.7152f, 0.0722f};
+  const float Cz[] = {0.0193f, 0.1192f, 0.9505f};
   uint8_t i;
-  double_t data[3], xyNormFactor, m_xNormCoeff, m_yNormCoeff, nCoeff, cct;
-  double_t X_tmp = 0, Y_tmp = 0, Z_tmp = 0;
+  float data[3], xyNormFactor, m_xNormCoeff, m_yNormCoeff, nCoeff, cct;
+  float X_tmp = 0, Y_tmp = 0, Z_tmp = 0;
 
   /* Normalize and prepare RGB channels values for cct computation */
-  data[0] = ISP_Algo_SimpleAWB_CCT_LinearSrgb(r / 255.0);
-  data[1] = ISP_Algo_SimpleAWB_CCT_LinearSrgb(g / 255.0);
-  data[2] = ISP_Algo_SimpleAWB_CCT_LinearSrgb(b / 255.0);
+  data[0] = ISP_Algo_SimpleAWB_CCT_LinearSrgb[r];
+  data[1] = ISP_Algo_SimpleAWB_CCT_LinearSrgb[g];
+  data[2] = ISP_Algo_SimpleAWB_CCT_LinearSrgb[b];
 
   /* Apply correlation matrix to RGB channels to obtain (X,Y,Z) */
   for (i = 0; i < 3; i++)
@@ -1423,9 +1483,9 @@ static double_t ISP_Algo_SimpleAWB_CCT_ComputeCCT(uint8_t r, uint8_t g, uint8_t
   m_xNormCoeff = X_tmp / xyNormFactor;
   m_yNormCoeff = Y_tmp / xyNormFactor;
 
-  /* Apply McCamy's formula to obtain CCT value */
-  nCoeff = (m_xNormCoeff - 0.3320) / (0.1858 - m_yNormCoeff);
-  cct = (449 * pow(nCoeff, 3) + 3525 * pow(nCoeff, 2) + 6823.3 * nCoeff + 5520.33);
+  /* Apply McCamy's formula to obtain CCT value (Horner form) */
+  nCoeff = (m_xNormCoeff - 0.3320f) / (0.1858f - m_yNormCoeff);
+  cct = ((449.0f * nCoeff + 3525.0f) * nCoeff + 6823.3f) * nCoeff + 5520.33f;
 
   return cct;
 }
@@ -1436,10 +1496,10 @@ static double_t ISP_Algo_SimpleAWB_CCT_ComputeCCT(uint8_t r, uint8_t g, uint8_t
   * @param  cct: theoretical correlated color temperature
   * @retval Correlated Color Temperature corrected
   */
-static double_t ISP_Algo_SimpleAWB_CCT_FixCCT(double cct)
+static float ISP_Algo_SimpleAWB_CCT_FixCCT(float cct)
 {
   /* Correction = 0.0005517 CCT² – 4.597 CCT + 12208 */
-  return 0.0005517 * cct * cct -4.597 * cct + 12208;
+  return (0.0005517f * cct - 4.597f) * cct + 12208.0f;
 }
 
 /**
@@ -1587,14 +1647,14 @@ ISP_StatusTypeDef ISP_Algo_SimpleAWB_CCT_StatCb(ISP_AlgoTypeDef *pAlgo)
   */
 ISP_StatusTypeDef ISP_Algo_SimpleAWB_CCT_Process(void *hIsp, void *pAlgo)
 {
-  static ISP_SVC_StatStateTypeDef stats;
+  ISP_AlgoContextTypeDef *ctx = ISP_Algo_GetContext(hIsp);
+  ISP_SVC_StatStateTypeDef *stats = &ctx->simpleAWBCCTStats;
   ISP_AlgoTypeDef *algo = (ISP_AlgoTypeDef *)pAlgo;
   ISP_IQParamTypeDef *IQParamConfig;
   ISP_StatusTypeDef ret = ISP_OK;
-  double cct;
+  float cct;
   uint32_t noGainR, noGainG, noGainB, fixedCCT, distance, colorTemp;
   uint32_t profId, bestProfId, bestNbSel;
-  static uint32_t colorTempCurrent, preventUpdate, nbSelection[ISP_AWB_COLORTEMP_REF];
 #ifdef ALGO_AWB_CCT_DBG_LOGS
   static int dbg_nb_cct_meas, dbg_nb_cct_change, dbg_nb_cct_6500, dbg_nb_cct_5000, dbg_nb_cct_4200, dbg_nb_cct_4000, dbg_nb_cct_2856;
 #endif
@@ -1613,7 +1673,7 @@ ISP_StatusTypeDef ISP_Algo_SimpleAWB_CCT_Process(void *hIsp, void *pAlgo)
   case ISP_ALGO_STATE_INIT:
   case ISP_ALGO_STATE_NEED_STAT:
     /* Ask for stats */
-    ret = ISP_SVC_Stats_GetNext(hIsp, &ISP_Algo_SimpleAWB_CCT_StatCb, pAlgo, &stats, ISP_STAT_LOC_DOWN, ISP_STAT_TYPE_AVG, 0);
+    ret = ISP_SVC_Stats_GetNext(hIsp, &ISP_Algo_SimpleAWB_CCT_StatCb, pAlgo, stats, ISP_STAT_LOC_DOWN, ISP_STAT_TYPE_AVG, 0);
     if (ret != ISP_OK)
     {
       return ret;
@@ -1628,10 +1688,10 @@ ISP_StatusTypeDef ISP_Algo_SimpleAWB_CCT_Process(void *hIsp, void *pAlgo)
     break;
 
   case ISP_ALGO_STATE_STAT_READY:
-    if ((stats.down.averageR != 0) && (stats.down.averageG != 0) && (stats.down.averageB != 0))
+    if ((stats->down.averageR != 0) && (stats->down.averageG != 0) && (stats->down.averageB != 0))
     {
       /* Get RGB before ISP gain */
-      ISP_Algo_SimpleAWB_CCT_StatNoGain(hIsp, stats.down.averageR, stats.down.averageG, stats.down.averageB, &noGainR, &noGainG, &noGainB);
+      ISP_Algo_SimpleAWB_CCT_StatNoGain(hIsp, stats->down.averageR, stats->down.averageG, stats->down.averageB, &noGainR, &noGainG, &noGainB);
 
       /* Get CCT from McCamy’s approximation */
       cct = ISP_Algo_SimpleAWB_CCT_ComputeCCT(noGainR, noGainG, noGainB);
@@ -1659,10 +1719,10 @@ ISP_StatusTypeDef ISP_Algo_SimpleAWB_CCT_Process(void *hIsp, void *pAlgo)
 
       colorTemp = IQParamConfig->AWBAlgo.referenceColorTemp[profId];
 
-      if (preventUpdate == 0)
+      if (ctx->preventUpdate == 0)
       {
         /* Profile can be updated */
-        if (colorTemp != colorTempCurrent)
+        if (colorTemp != ctx->colorTempCurrent)
         {
           /* Apply profile */
 #ifdef ALGO_AWB_CCT_DBG_LOGS
@@ -1671,11 +1731,11 @@ ISP_StatusTypeDef ISP_Algo_SimpleAWB_CCT_Process(void *hIsp, void *pAlgo)
           ret = ISP_Algo_SimpleAWB_CCT_ApplyProfile(hIsp, profId);
           if (ret == ISP_OK)
           {
-            colorTempCurrent = colorTemp;
+            ctx->colorTempCurrent = colorTemp;
 
             /* Prevent update for a while */
-            preventUpdate = ALGO_AWB_CCT_PREVENT_NB;
-            memset(nbSelection, 0, sizeof(nbSelection));
+            ctx->preventUpdate = ALGO_AWB_CCT_PREVENT_NB;
+            memset(ctx->nbSelection, 0, sizeof(ctx->nbSelection));
 
 #ifdef ALGO_AWB_CCT_DBG_LOGS
             dbg_nb_cct_change++;
@@ -1689,25 +1749,25 @@ ISP_StatusTypeDef ISP_Algo_SimpleAWB_CCT_Process(void *hIsp, void *pAlgo)
         //printf("! Skipping color temperature = %ld\r\n", colorTemp);
 #endif
         /* Monitor the proposed profiles */
-        nbSelection[profId]++;
+        ctx->nbSelection[profId]++;
 
         /* Check if profile can not be update now */
-        if (--preventUpdate == 0)
+        if (--ctx->preventUpdate == 0)
         {
           /* End of profile selection monitoring. Get the 'best' profile */
           bestProfId = 0;
           bestNbSel = 0;
           for (uint32_t i = 0; i < ISP_AWB_COLORTEMP_REF; i++)
           {
-            if (nbSelection[i] > bestNbSel)
+            if (ctx->nbSelection[i] > bestNbSel)
             {
-              bestNbSel = nbSelection[i];
+              bestNbSel = ctx->nbSelection[i];
               bestProfId = i;
             }
           }
 
           colorTemp = IQParamConfig->AWBAlgo.referenceColorTemp[bestProfId];
-          if (colorTemp != colorTempCurrent)
+          if (colorTemp != ctx->colorTempCurrent)
           {
             /* Apply new profile */
 #ifdef ALGO_AWB_CCT_DBG_LOGS
@@ -1716,11 +1776,11 @@ ISP_StatusTypeDef ISP_Algo_SimpleAWB_CCT_Process(void *hIsp, void *pAlgo)
             ret = ISP_Algo_SimpleAWB_CCT_ApplyProfile(hIsp, bestProfId);
             if (ret == ISP_OK)
             {
-              colorTempCurrent = colorTemp;
+              ctx->colorTempCurrent = colorTemp;
 
               /* Prevent update for a while */
-              preventUpdate = ALGO_AWB_CCT_PREVENT_NB;
-              memset(nbSelection, 0, sizeof(nbSelection));
+              ctx->preventUpdate = ALGO_AWB_CCT_PREVENT_NB;
+              memset(ctx->nbSelection, 0, sizeof(ctx->nbSelection));
 
 #ifdef ALGO_AWB_CCT_DBG_LOGS
               dbg_nb_cct_change++;
@@ -1731,15 +1791,15 @@ ISP_StatusTypeDef ISP_Algo_SimpleAWB_CCT_Process(void *hIsp, void *pAlgo)
       }
 
 #ifdef ALGO_AWB_CCT_DBG_LOGS
-      if (colorTempCurrent == 6500)
+      if (ctx->colorTempCurrent == 6500)
         dbg_nb_cct_6500++;
-      else if (colorTempCurrent == 5000)
+      else if (ctx->colorTempCurrent == 5000)
         dbg_nb_cct_5000++;
-      else if (colorTempCurrent == 4200)
+      else if (ctx->colorTempCurrent == 4200)
         dbg_nb_cct_4200++;
-      else if (colorTempCurrent == 4000)
+      else if (ctx->colorTempCurrent == 4000)
         dbg_nb_cct_4000++;
-      else if (colorTempCurrent == 2856)
+      else if (ctx->colorTempCurrent == 2856)
         dbg_nb_cct_2856++;
 
       if (++dbg_nb_cct_meas == 100)
@@ -1759,7 +1819,7 @@ ISP_StatusTypeDef ISP_Algo_SimpleAWB_CCT_Process(void *hIsp, void *pAlgo)
     }
 
     /* Ask for stats */
-    ret = ISP_SVC_Stats_GetNext(hIsp, &ISP_Algo_SimpleAWB_CCT_StatCb, pAlgo, &stats, ISP_STAT_LOC_DOWN,
+    ret = ISP_SVC_Stats_GetNext(hIsp, &ISP_Algo_SimpleAWB_CCT_StatCb, pAlgo, stats, ISP_STAT_LOC_DOWN,
                                 ISP_STAT_TYPE_AVG, ALGO_ISP_VSYNC_LATENCY);
 
     /* Wait for stats to be ready */
@@ -1779,13 +1839,42 @@ ISP_StatusTypeDef ISP_Algo_SimpleAWB_CCT_Process(void *hIsp, void *pAlgo)
   */
 ISP_StatusTypeDef ISP_Algo_Init(ISP_HandleTypeDef *hIsp)
 {
+  ISP_AlgoContextTypeDef *ctx = NULL;
   ISP_AlgoTypeDef *algo;
   ISP_StatusTypeDef ret;
   uint8_t i;
 
-  hIsp->algorithm = ISP_Algo_List;
+  /* Get a context: the one already owned by this instance (init without deinit) or a free one */
+  for (i = 0; i < ISP_ALGO_MAX_INSTANCES; i++)
+  {
+    if (ISP_Algo_Context[i].hIsp == hIsp)
+    {
+      ctx = &ISP_Algo_Context[i];
+      break;
+    }
+    if ((ctx == NULL) && (ISP_Algo_Context[i].hIsp == NULL))
+    {
+      ctx = &ISP_Algo_Context[i];
+    }
+  }
+
+  if (ctx == NULL)
+  {
+    return ISP_ERR_ALGO;
+  }
 
-  for (i = 0; i < sizeof(ISP_Algo_List) / sizeof(*ISP_Algo_List); i++)
+  memset(ctx, 0, sizeof(*ctx));
+  ctx->hIsp = hIsp;
+  for (i = 0; i < ISP_ALGO_NB; i++)
+  {
+    ctx->algo[i] = *ISP_Algo_List[i];
+    ctx->list[i] = &ctx->algo[i];
+  }
+
+  hIsp->algoContext = ctx;
+  hIsp->algorithm = ctx->list;
+
+  for (i = 0; i < ISP_ALGO_NB; i++)
   {
     algo = hIsp->algorithm[i];
     if ((algo != NULL) && (algo->Init != NULL))
@@ -1809,11 +1898,17 @@ ISP_StatusTypeDef ISP_Algo_Init(ISP_HandleTypeDef *hIsp)
   */
 ISP_StatusTypeDef ISP_Algo_DeInit(ISP_HandleTypeDef *hIsp)
 {
+  ISP_AlgoContextTypeDef *ctx = ISP_Algo_GetContext(hIsp);
   ISP_AlgoTypeDef *algo;
   ISP_StatusTypeDef ret;
   uint8_t i;
 
-  for (i = 0; i < sizeof(ISP_Algo_List) / sizeof(*ISP_Algo_List); i++)
+  if (ctx == NULL)
+  {
+    return ISP_OK;
+  }
+
+  for (i = 0; i < ISP_ALGO_NB; i++)
   {
     algo = hIsp->algorithm[i];
     if ((algo != NULL) && (algo->DeInit != NULL))
@@ -1826,9 +1921,27 @@ ISP_StatusTypeDef ISP_Algo_DeInit(ISP_HandleTypeDef *hIsp)
     }
   }
 
+  /* Release the context */
+  ctx->hIsp = NULL;
+  hIsp->algoContext = NULL;
+  hIsp->algorithm = NULL;
+
   return ISP_OK;
 }
 
+/**
+  * @brief  ISP_Algo_GetAWBProfileId
+  *         Get the AWB profile applied by the AWB algorithm
+  * @param  hIsp: ISP device handle
+  * @retval profile index in IQParamConfig->AWBAlgo, 0 if the algorithms are not initialized
+  */
+uint32_t ISP_Algo_GetAWBProfileId(ISP_HandleTypeDef *hIsp)
+{
+  ISP_AlgoContextTypeDef *ctx = ISP_Algo_GetContext(hIsp);
+
+  return (ctx != NULL) ? ctx->awbProfId : 0;
+}
+
 /**
   * @brief  ISP_Algo_Process
   *         Process all the algorithms
@@ -1841,7 +1954,12 @@ ISP_StatusTypeDef ISP_Algo_Process(ISP_HandleTypeDef *hIsp)
   ISP_StatusTypeDef ret;
   uint8_t i;
 
-  for (i = 0; i < sizeof(ISP_Algo_List) / sizeof(*ISP_Algo_List); i++)
+  if (hIsp->algorithm == NULL)
+  {
+    return ISP_OK;
+  }
+
+  for (i = 0; i < ISP_ALGO_NB; i++)
   {
     algo = hIsp->algorithm[i];
     if ((algo != NULL) && (algo->Process != NULL))
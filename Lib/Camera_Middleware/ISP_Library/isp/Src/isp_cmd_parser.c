@@ -23,6 +23,7 @@
 #include "isp_cmd_parser.h"
 #include "isp_tool_com.h"
 #include "isp_services.h"
+#include "isp_algo.h"
 
 /* Private types -------------------------------------------------------------*/
 typedef enum {
@@ -283,8 +284,6 @@ static ISP_StatusTypeDef ISP_CmdParser_StatDownCb(ISP_AlgoTypeDef *pAlgo);
 /* Private variables ---------------------------------------------------------*/
 static ISP_SVC_StatStateTypeDef ISP_CmdParser_stats;
 
-extern uint32_t current_awb_profId;
-
 /* Private functions ---------------------------------------------------------*/
 /**
   * @brief  ISP_CmdParser_ProcessCommand
@@ -638,8 +637,8 @@ static ISP_StatusTypeDef ISP_CmdParser_GetConfig(ISP_HandleTypeDef *hIsp, uint8_
     break;
 
   case ISP_CMD_AWBPROFILE:
-    strcpy(c.AWBProfile.data.id, IQParamConfig->AWBAlgo.id[current_awb_profId]);
-    c.AWBProfile.data.referenceColorTemp = IQParamConfig->AWBAlgo.referenceColorTemp[current_awb_profId];
+    strcpy(c.AWBProfile.data.id, IQParamConfig->AWBAlgo.id[ISP_Algo_GetAWBProfileId(hIsp)]);
+    c.AWBProfile.data.referenceColorTemp = IQParamConfig->AWBAlgo.referenceColorTemp[ISP_Algo_GetAWBProfileId(hIsp)];
     break;
 
   case ISP_CMD_ISPGAINSTATIC:
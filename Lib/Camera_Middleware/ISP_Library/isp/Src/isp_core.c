@@ -321,7 +321,6 @@ ISP_StatusTypeDef ISP_Start(ISP_HandleTypeDef *hIsp)
   */
 ISP_StatusTypeDef ISP_BackgroundProcess(ISP_HandleTypeDef *hIsp)
 {
-  static uint32_t LastFrameId;
   uint32_t CurrentFrameId;
   ISP_StatusTypeDef retCmdParser = ISP_OK, retAlgo = ISP_OK, retStats = ISP_OK;
 #ifdef ISP_MW_TUNING_TOOL_SUPPORT
@@ -344,10 +343,10 @@ ISP_StatusTypeDef ISP_BackgroundProcess(ISP_HandleTypeDef *hIsp)
   retStats = ISP_SVC_Stats_ProcessCallbacks(hIsp);
 
   CurrentFrameId = ISP_SVC_Misc_GetMainFrameId(hIsp);
-  if (CurrentFrameId != LastFrameId)
+  if (CurrentFrameId != hIsp->algoLastFrameId)
   {
     /* A new frame has been received : process the algorithms */
-    LastFrameId = CurrentFrameId;
+    hIsp->algoLastFrameId = CurrentFrameId;
     retAlgo = ISP_Algo_Process(hIsp);
   }
 
@@ -0,0 +1,411 @@
+/**
+ ******************************************************************************
+ * @file    evision_ref.c
+ * @author  AIS Application Team
+ * @brief   Host reference of the evision AE and AWB estimators, linked by
+ *          Makefile.sim when no host build of the evision library is given
+ *          (EVISION_LIB). It implements the API used by isp_algo.c with
+ *          simple control laws: it is not the evision algorithm, its
+ *          convergence figures only validate the ISP middleware around it.
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <string.h>
+#include "evision-api-ae.h"
+#include "evision-api-awb.h"
+
+/* Private constants ---------------------------------------------------------*/
+/* AE: largest exposure change per run (ratio), exposure used when the sensor is at 0 us */
+#define EVISION_REF_AE_MAX_RATIO       8.0
+#define EVISION_REF_AE_MIN_EXPOSURE    1.0
+/* AWB: gamma applied to the measurements by the ISP (see ISP_Algo_ApplyGammaInverse()) */
+#define EVISION_REF_AWB_GAMMA          2.2
+
+/* Private functions ---------------------------------------------------------*/
+static double EVISION_REF_GainLinear(uint32_t gain)
+{
+  return pow(10.0, (double)gain / 20000.0);
+}
+
+/* Index of the largest LUT entry below or equal to value, 0 if none */
+static uint32_t EVISION_REF_FindBelow(const uint32_t *lut, uint32_t size, double value)
+{
+  uint32_t i = 0;
+
+  while ((i + 1U < size) && ((double)lut[i + 1U] <= value))
+  {
+    i++;
+  }
+
+  return i;
+}
+
+/* 3x3 matrix inverse, 0 if singular */
+static int EVISION_REF_Invert(const float m[3][3], double inv[3][3])
+{
+  double det = m[0][0] * ((double)m[1][1] * m[2][2] - (double)m[1][2] * m[2][1]) -
+               m[0][1] * ((double)m[1][0] * m[2][2] - (double)m[1][2] * m[2][0]) +
+               m[0][2] * ((double)m[1][0] * m[2][1] - (double)m[1][1] * m[2][0]);
+
+  if (fabs(det) < 1e-9)
+  {
+    return 0;
+  }
+
+  for (uint32_t i = 0; i < 3U; i++)
+  {
+    for (uint32_t j = 0; j < 3U; j++)
+    {
+      uint32_t r0 = (j + 1U) % 3U, r1 = (j + 2U) % 3U, c0 = (i + 1U) % 3U, c1 = (i + 2U) % 3U;
+
+      inv[i][j] = ((double)m[r0][c0] * m[r1][c1] - (double)m[r0][c1] * m[r1][c0]) / det;
+    }
+  }
+
+  return 1;
+}
+
+/* Raw R / G and B / G ratios (log) of a grey under the illuminant of a profile: inverse of its white balance gains */
+static void EVISION_REF_ProfileRatio(const evision_awb_profile_t *profile, double ratio[2])
+{
+  ratio[0] = log(profile->gain_values[1] / profile->gain_values[0]);
+  ratio[1] = log(profile->gain_values[1] / profile->gain_values[3]);
+}
+
+/* Color temperature whose profile ratios, interpolated in mired, are the closest to the measured raw ratios */
+static double EVISION_REF_EstimateTemp(const evision_awb_calib_data_t *calib, const double raw[2])
+{
+  double best = -1.0, bestTemp = calib->temperatures[0];
+
+  for (uint32_t i = 0; i < calib->profiles_count; i++)
+  {
+    uint32_t j = (i + 1U < calib->profiles_count) ? i + 1U : i;
+    double r0[2], r1[2], d[2], t = 0.0, len;
+
+    EVISION_REF_ProfileRatio(&calib->profiles[i], r0);
+    EVISION_REF_ProfileRatio(&calib->profiles[j], r1);
+    d[0] = r1[0] - r0[0];
+    d[1] = r1[1] - r0[1];
+    len = d[0] * d[0] + d[1] * d[1];
+    if (len > 0.0)
+    {
+      t = ((raw[0] - r0[0]) * d[0] + (raw[1] - r0[1]) * d[1]) / len;
+      t = fmin(fmax(t, 0.0), 1.0);
+    }
+
+    double e0 = raw[0] - (r0[0] + t * d[0]), e1 = raw[1] - (r0[1] + t * d[1]);
+    double dist = e0 * e0 + e1 * e1;
+
+    if ((best < 0.0) || (dist < best))
+    {
+      double m0 = 1e6 / calib->temperatures[i], m1 = 1e6 / calib->temperatures[j];
+
+      best = dist;
+      bestTemp = 1e6 / (m0 + t * (m1 - m0));
+    }
+  }
+
+  return bestTemp;
+}
+
+/* Exported functions --------------------------------------------------------*/
+evision_ae_estimator_t* evision_api_ae_new(void)
+{
+  return (evision_ae_estimator_t *)calloc(1, sizeof(evision_ae_estimator_t));
+}
+
+evision_return_t evision_api_ae_delete(evision_ae_estimator_t* self)
+{
+  if (self == NULL)
+  {
+    return EVISION_RET_PARAM_ERR;
+  }
+  free(self);
+
+  return EVISION_RET_SUCCESS;
+}
+
+evision_return_t evision_api_ae_init(evision_ae_estimator_t* const self,
+    uint32_t exposure_lut_sizes[EVISION_AE_MAX_SENSOR_CONFIGS],
+    const uint32_t* exposure_luts[EVISION_AE_MAX_SENSOR_CONFIGS],
+    uint32_t gain_lut_full_sizes[EVISION_AE_MAX_SENSOR_CONFIGS],
+    const uint32_t* gain_luts[EVISION_AE_MAX_SENSOR_CONFIGS])
+{
+  evision_ae_hyper_param_t *hp;
+
+  if ((self == NULL) || (exposure_lut_sizes == NULL) || (exposure_luts == NULL) || (gain_lut_full_sizes == NULL) ||
+      (gain_luts == NULL))
+  {
+    return EVISION_RET_PARAM_ERR;
+  }
+
+  memset(self, 0, sizeof(*self));
+  for (uint32_t i = 0; i < EVISION_AE_MAX_SENSOR_CONFIGS; i++)
+  {
+    self->sensor_configs[i].lut_exposure_size = exposure_lut_sizes[i];
+    self->sensor_configs[i].lut_exposure = exposure_luts[i];
+    self->sensor_configs[i].full_lut_gain_size = gain_lut_full_sizes[i];
+    self->sensor_configs[i].full_lut_gain = gain_luts[i];
+  }
+  self->active_sensor_cfg = &self->sensor_configs[EVISION_AE_DEFAULT_SENSOR_CONFIG];
+  if ((self->active_sensor_cfg->lut_exposure == NULL) || (self->active_sensor_cfg->lut_exposure_size == 0U) ||
+      (self->active_sensor_cfg->full_lut_gain == NULL) || (self->active_sensor_cfg->full_lut_gain_size == 0U))
+  {
+    return EVISION_RET_PARAM_ERR;
+  }
+
+  hp = &self->hyper_params;
+  hp->ae_process_ratio = 1;
+  hp->speed_p_increment = 0.1;
+  hp->speed_p_min = 1.0;
+  hp->speed_p_max = 3.0;
+  hp->desired_luminosity = EVISION_AE_LUMINOSITY_MEDIUM;
+  hp->delta_c = 15.0;
+  hp->delta_c_bw = 2.0;
+  hp->exposure_max = 1.0;
+  hp->enable_gain = 1;
+  hp->gain_min = 1;
+  hp->gain_max = 1;
+  self->runtime_vars.speed_p_value = hp->speed_p_min;
+  self->state = EVISION_STATE_INIT;
+
+  return EVISION_RET_SUCCESS;
+}
+
+/* Proportional control of the total exposure (time x gain) on the measured luminance, exposure time first */
+evision_return_t evision_api_ae_run_average(evision_ae_estimator_t* const self, const evision_image_t* const image,
+    uint8_t use_ext_lum, double ext_lum)
+{
+  const evision_ae_sensor_config_t *cfg;
+  const evision_ae_hyper_param_t *hp;
+  evision_ae_priv_param_runtime_t *rt;
+  uint32_t idxExp, idxGain, lower, upper;
+  double target, ratio, total, exposure;
+
+  (void)image;
+  if ((self == NULL) || (self->active_sensor_cfg == NULL) || (use_ext_lum == 0U))
+  {
+    /* Only the external (ISP statistics) measurement is supported */
+    return EVISION_RET_PARAM_ERR;
+  }
+
+  cfg = self->active_sensor_cfg;
+  hp = &self->hyper_params;
+  rt = &self->runtime_vars;
+  self->state = EVISION_STATE_RUN;
+
+  target = (double)hp->desired_luminosity;
+  rt->converged = (fabs(ext_lum - target) <= hp->delta_c) ? 1U : 0U;
+  if (rt->converged)
+  {
+    return EVISION_RET_SUCCESS;
+  }
+
+  ratio = (ext_lum > 0.0) ? target / ext_lum : EVISION_REF_AE_MAX_RATIO;
+  ratio = fmin(fmax(ratio, 1.0 / EVISION_REF_AE_MAX_RATIO), EVISION_REF_AE_MAX_RATIO);
+  total = fmax(self->exposure, EVISION_REF_AE_MIN_EXPOSURE) * EVISION_REF_GainLinear(self->gain) * ratio;
+
+  /* Exposure time, within the hyper parameters */
+  exposure = fmin(fmax(total, hp->exposure_min), hp->exposure_max);
+  idxExp = EVISION_REF_FindBelow(cfg->lut_exposure, cfg->lut_exposure_size, exposure);
+  if ((cfg->lut_exposure[idxExp] == 0U) && (idxExp + 1U < cfg->lut_exposure_size))
+  {
+    /* No light at all with a null exposure time */
+    idxExp++;
+  }
+
+  /* Gain for the remainder, within the gain range and index guards set by the caller */
+  idxGain = 0;
+  if (hp->enable_gain)
+  {
+    double gain = 20000.0 * log10(total / fmax((double)cfg->lut_exposure[idxExp], EVISION_REF_AE_MIN_EXPOSURE));
+
+    gain = fmin(fmax(gain, (double)hp->gain_min), (double)hp->gain_max);
+    idxGain = EVISION_REF_FindBelow(cfg->full_lut_gain, cfg->full_lut_gain_size, gain);
+    lower = (hp->index_diff_gain_min < cfg->full_lut_gain_size) ? hp->index_diff_gain_min : 0U;
+    upper = (hp->index_diff_gain_max < cfg->full_lut_gain_size) ? cfg->full_lut_gain_size - hp->index_diff_gain_max :
+                                                                  cfg->full_lut_gain_size - 1U;
+    upper = (upper < cfg->full_lut_gain_size) ? upper : cfg->full_lut_gain_size - 1U;
+    if (lower <= upper)
+    {
+      idxGain = (idxGain < lower) ? lower : (idxGain > upper) ? upper : idxGain;
+    }
+  }
+
+  rt->index_exposure = idxExp;
+  rt->index_gain = idxGain;
+  self->exposure = (double)cfg->lut_exposure[idxExp];
+  self->gain = cfg->full_lut_gain[idxGain];
+
+  return EVISION_RET_SUCCESS;
+}
+
+evision_awb_estimator_t* evision_api_awb_new(void)
+{
+  return (evision_awb_estimator_t *)calloc(1, sizeof(evision_awb_estimator_t));
+}
+
+evision_return_t evision_api_awb_delete(evision_awb_estimator_t* self)
+{
+  if (self == NULL)
+  {
+    return EVISION_RET_PARAM_ERR;
+  }
+  free(self);
+
+  return EVISION_RET_SUCCESS;
+}
+
+void evision_api_awb_set_profile(evision_awb_profile_t* awb_profile,
+    float color_temperature, const float cfa_gains[EVISION_AWB_NB_DG_CFA_GAINS],
+    const float ccm_coefficients[EVISION_AWB_CCM_SIZE][EVISION_AWB_CCM_SIZE],
+    const float ccm_offsets[EVISION_AWB_CCM_SIZE])
+{
+  awb_profile->color_temperature = color_temperature;
+  memcpy(awb_profile->gain_values, cfa_gains, sizeof(awb_profile->gain_values));
+  memcpy(awb_profile->ccm_coefficients, ccm_coefficients, sizeof(awb_profile->ccm_coefficients));
+  memcpy(awb_profile->ccm_offsets, ccm_offsets, sizeof(awb_profile->ccm_offsets));
+}
+
+evision_return_t evision_api_awb_init_profiles(evision_awb_estimator_t* const self,
+    double min_temp, double max_temp,
+    uint16_t nb_profiles, float decision_thresholds[EVISION_AWB_MAX_PROFILE_COUNT - 1],
+    evision_awb_profile_t awb_profiles[EVISION_AWB_MAX_PROFILE_COUNT])
+{
+  evision_awb_calib_data_t *calib;
+
+  if ((self == NULL) || (nb_profiles == 0U) || (nb_profiles > EVISION_AWB_MAX_PROFILE_COUNT) ||
+      (min_temp <= 0.0) || (max_temp < min_temp) || (awb_profiles == NULL) ||
+      ((nb_profiles > 1U) && (decision_thresholds == NULL)))
+  {
+    return EVISION_RET_PARAM_ERR;
+  }
+
+  for (uint32_t i = 0; i < nb_profiles; i++)
+  {
+    if ((awb_profiles[i].gain_values[0] <= 0.0f) || (awb_profiles[i].gain_values[1] <= 0.0f) ||
+        (awb_profiles[i].gain_values[3] <= 0.0f) ||
+        ((i > 0U) && (awb_profiles[i].color_temperature <= awb_profiles[i - 1U].color_temperature)))
+    {
+      return EVISION_RET_PARAM_ERR;
+    }
+  }
+
+  memset(self, 0, sizeof(*self));
+  calib = &self->calib_data;
+  calib->min_temp = min_temp;
+  calib->max_temp = max_temp;
+  calib->profiles_count = nb_profiles;
+  for (uint32_t i = 0; i < nb_profiles; i++)
+  {
+    calib->profiles[i] = awb_profiles[i];
+    calib->temperatures[i] = awb_profiles[i].color_temperature;
+    if (i + 1U < nb_profiles)
+    {
+      calib->decision_thresholds[i] = decision_thresholds[i];
+    }
+  }
+  calib->active_profile = NULL;
+
+  self->awb_mode = EVISION_AWB_USE_PROFILE_SELECTION_AWB;
+  self->hyper_params.awb_process_ratio = 1;
+  self->hyper_params.speed_p_min = 1.0;
+  self->hyper_params.speed_p_max = 2.0;
+  self->hyper_params.hysteresis_offset = 100.0f;
+  self->runtime_vars.int_temp = -1.0;
+  self->state = EVISION_STATE_INIT;
+
+  return EVISION_RET_SUCCESS;
+}
+
+/* Profile selection: the measurement (after ISP gains, color conversion and gamma of the active profile) is brought
+ * back to the raw ratios, whose color temperature selects the profile through the decision thresholds. The active
+ * profile is kept within hysteresis_offset of the thresholds around it. */
+evision_return_t evision_api_awb_run_average(evision_awb_estimator_t* const self, const evision_image_t* const image,
+    uint8_t use_ext_meas, double ext_meas[EVISION_AWB_EXT_MEAS_SIZE])
+{
+  evision_awb_calib_data_t *calib;
+  const evision_awb_profile_t *active;
+  double lin[3], cam[3], inv[3][3], raw[2], temp;
+  uint32_t sel, cur;
+
+  (void)image;
+  if ((self == NULL) || (use_ext_meas == 0U) || (ext_meas == NULL))
+  {
+    /* Only the external (ISP statistics) measurement is supported */
+    return EVISION_RET_PARAM_ERR;
+  }
+
+  calib = &self->calib_data;
+  if (calib->profiles_count == 0U)
+  {
+    return EVISION_RET_FAILURE;
+  }
+  self->state = EVISION_STATE_RUN;
+
+  /* Before the first decision, the static configuration of the ISP is assumed to be the first profile */
+  active = (calib->active_profile != NULL) ? calib->active_profile : &calib->profiles[0];
+  cur = (uint32_t)(active - calib->profiles);
+
+  for (uint32_t i = 0; i < 3U; i++)
+  {
+    lin[i] = 255.0 * pow(fmax(ext_meas[i], 0.0) / 255.0, EVISION_REF_AWB_GAMMA);
+  }
+  if (!EVISION_REF_Invert(active->ccm_coefficients, inv))
+  {
+    return EVISION_RET_INVALID_VALUE;
+  }
+  for (uint32_t i = 0; i < 3U; i++)
+  {
+    cam[i] = inv[i][0] * (lin[0] - active->ccm_offsets[0]) + inv[i][1] * (lin[1] - active->ccm_offsets[1]) +
+             inv[i][2] * (lin[2] - active->ccm_offsets[2]);
+  }
+  if ((cam[0] <= 0.0) || (cam[1] <= 0.0) || (cam[2] <= 0.0))
+  {
+    /* Dark scene: no decision, the active profile is kept */
+    sel = cur;
+  }
+  else
+  {
+    raw[0] = log((cam[0] / active->gain_values[0]) / (cam[1] / active->gain_values[1]));
+    raw[1] = log((cam[2] / active->gain_values[3]) / (cam[1] / active->gain_values[1]));
+    temp = EVISION_REF_EstimateTemp(calib, raw);
+    self->runtime_vars.int_temp = temp;
+
+    sel = 0;
+    while ((sel + 1U < calib->profiles_count) && (temp > calib->decision_thresholds[sel]))
+    {
+      sel++;
+    }
+  }
+  if ((calib->active_profile != NULL) && (sel != cur))
+  {
+    uint32_t border = (sel > cur) ? cur : cur - 1U;
+
+    if (fabs(temp - calib->decision_thresholds[border]) < self->hyper_params.hysteresis_offset)
+    {
+      sel = cur;
+    }
+  }
+
+  self->runtime_vars.temp_changed = (calib->active_profile != &calib->profiles[sel]) ? 1U : 0U;
+  calib->active_profile = &calib->profiles[sel];
+  self->out_temp = calib->active_profile->color_temperature;
+  memcpy(self->dg_cf, calib->active_profile->gain_values, sizeof(self->dg_cf));
+  memcpy(self->ccm, calib->active_profile->ccm_coefficients, sizeof(self->ccm));
+  memcpy(self->ccm_offsets, calib->active_profile->ccm_offsets, sizeof(self->ccm_offsets));
+
+  return EVISION_RET_SUCCESS;
+}
@@ -0,0 +1,231 @@
+/**
+ ******************************************************************************
+ * @file    isp_algo_cct_test.c
+ * @author  AIS Application Team
+ * @brief   Host accuracy test of the SimpleAWB_CCT estimate (linearisation
+ *          table, single precision) against the former double precision
+ *          implementation, over all the 8-bit RGB triplets. Also reports the
+ *          cost of both implementations.
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <time.h>
+
+/* Unit under test: its static functions are reached by including it. The other algorithms are never called, the
+ * services and evision references are dropped at link time (see Makefile.sim) */
+#include "isp_algo.c"
+#include "isp_param_conf.h"
+
+/* Private constants ---------------------------------------------------------*/
+/* Range of validity of McCamy's approximation */
+#define CCT_TEST_MIN              1500.0
+#define CCT_TEST_MAX              12000.0
+
+/* Accepted deviations from the double precision implementation */
+#define CCT_TEST_MAX_REL_ERROR    0.001       /* on the McCamy CCT */
+#define CCT_TEST_MAX_FIXED_ERROR  20.0        /* K, on the corrected CCT */
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t NbChecks;
+static uint32_t NbFailures;
+
+/* Private macro -------------------------------------------------------------*/
+#define CCT_TEST_CHECK(cond) \
+  do \
+  { \
+    NbChecks++; \
+    if (!(cond)) \
+    { \
+      if (NbFailures++ < 10) \
+      { \
+        printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+      } \
+    } \
+  } while (0)
+
+/* Private functions ---------------------------------------------------------*/
+static uint64_t CCT_TEST_GetCpuTimeNs(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+
+  return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+/* Former double precision implementation */
+static double CCT_TEST_RefLinearSrgb(double c)
+{
+  if (c <= 0.04045)
+  {
+    return c / 12.92;
+  }
+  return pow((c + 0.055) / 1.055, 2.4);
+}
+
+static double CCT_TEST_RefComputeCCT(uint8_t r, uint8_t g, uint8_t b)
+{
+  const double Cx[] = {0.4124, 0.3576, 0.1805};
+  const double Cy[] = {0.2126, 0.7152, 0.0722};
+  const double Cz[] = {0.0193, 0.1192, 0.9505};
+  double data[3], xyNormFactor, nCoeff;
+  double X_tmp = 0, Y_tmp = 0, Z_tmp = 0;
+
+  data[0] = CCT_TEST_RefLinearSrgb(r / 255.0);
+  data[1] = CCT_TEST_RefLinearSrgb(g / 255.0);
+  data[2] = CCT_TEST_RefLinearSrgb(b / 255.0);
+
+  for (int i = 0; i < 3; i++)
+  {
+    X_tmp += Cx[i] * data[i];
+    Y_tmp += Cy[i] * data[i];
+    Z_tmp += Cz[i] * data[i];
+  }
+
+  xyNormFactor = X_tmp + Y_tmp + Z_tmp;
+  nCoeff = (X_tmp / xyNormFactor - 0.3320) / (0.1858 - Y_tmp / xyNormFactor);
+
+  return 449 * pow(nCoeff, 3) + 3525 * pow(nCoeff, 2) + 6823.3 * nCoeff + 5520.33;
+}
+
+static double CCT_TEST_RefFixCCT(double cct)
+{
+  return 0.0005517 * cct * cct -4.597 * cct + 12208;
+}
+
+/* Profile selection of ISP_Algo_SimpleAWB_CCT_Process() */
+static uint32_t CCT_TEST_ClosestProfile(const ISP_AWBAlgoTypeDef *awb, uint32_t fixedCCT)
+{
+  uint32_t distance = UINT_MAX;
+  uint32_t profId = 0;
+
+  for (uint32_t i = 0; i < ISP_AWB_COLORTEMP_REF; i++)
+  {
+    if (awb->referenceColorTemp[i] == 0)
+      continue;
+
+    uint32_t diff = abs((int)(awb->referenceColorTemp[i] - fixedCCT));
+    if (diff < distance)
+    {
+      distance = diff;
+      profId = i;
+    }
+  }
+
+  return profId;
+}
+
+/* A different profile is only accepted where the corrected CCT is at the midpoint between two profiles */
+static int CCT_TEST_IsMidpoint(const ISP_AWBAlgoTypeDef *awb, uint32_t prof1, uint32_t prof2, double fixedCCT)
+{
+  double midpoint = (awb->referenceColorTemp[prof1] + awb->referenceColorTemp[prof2]) / 2.0;
+
+  return fabs(fixedCCT - midpoint) <= CCT_TEST_MAX_FIXED_ERROR;
+}
+
+static void CCT_TEST_Accuracy(const ISP_AWBAlgoTypeDef *awb)
+{
+  double maxRelError = 0, maxFixedError = 0;
+  uint32_t nbTested = 0, nbProfileDiff = 0;
+
+  for (uint32_t rgb = 0; rgb < (1U << 24); rgb++)
+  {
+    uint8_t r = rgb >> 16, g = rgb >> 8, b = rgb;
+    double ref = CCT_TEST_RefComputeCCT(r, g, b);
+
+    if (!(ref >= CCT_TEST_MIN && ref <= CCT_TEST_MAX))
+      continue;
+
+    float cct = ISP_Algo_SimpleAWB_CCT_ComputeCCT(r, g, b);
+    double fixedRef = CCT_TEST_RefFixCCT(ref);
+    float fixedCCT = ISP_Algo_SimpleAWB_CCT_FixCCT(cct);
+    double relError = fabs(cct - ref) / ref;
+    double fixedError = fabs(fixedCCT - fixedRef);
+    uint32_t profRef = CCT_TEST_ClosestProfile(awb, (uint32_t) fixedRef);
+    uint32_t prof = CCT_TEST_ClosestProfile(awb, (uint32_t) fixedCCT);
+
+    nbTested++;
+    maxRelError = fmax(maxRelError, relError);
+    maxFixedError = fmax(maxFixedError, fixedError);
+    if (relError > CCT_TEST_MAX_REL_ERROR || fixedError > CCT_TEST_MAX_FIXED_ERROR)
+    {
+      CCT_TEST_CHECK(0);
+      printf("  R=%u G=%u B=%u: CCT %.1f (ref %.1f), corrected %.1f (ref %.1f)\n", r, g, b, cct, ref, fixedCCT,
+             fixedRef);
+    }
+    if (prof != profRef)
+    {
+      nbProfileDiff++;
+      CCT_TEST_CHECK(CCT_TEST_IsMidpoint(awb, prof, profRef, fixedRef));
+    }
+  }
+
+  CCT_TEST_CHECK(nbTested > 0);
+  printf("%lu triplets in [%.0f, %.0f] K: max relative error %.4f%%, max corrected CCT error %.1f K, "
+         "%lu other profile choices\n", (unsigned long) nbTested, CCT_TEST_MIN, CCT_TEST_MAX, 100 * maxRelError,
+         maxFixedError, (unsigned long) nbProfileDiff);
+}
+
+static void CCT_TEST_Linearisation(void)
+{
+  for (uint32_t c = 0; c < 256; c++)
+  {
+    double ref = CCT_TEST_RefLinearSrgb(c / 255.0);
+
+    CCT_TEST_CHECK(fabs(ISP_Algo_SimpleAWB_CCT_LinearSrgb[c] - ref) <= 1e-6 * fmax(ref, 1e-3));
+    if (c > 0)
+    {
+      CCT_TEST_CHECK(ISP_Algo_SimpleAWB_CCT_LinearSrgb[c] > ISP_Algo_SimpleAWB_CCT_LinearSrgb[c - 1]);
+    }
+  }
+}
+
+static void CCT_TEST_Cost(void)
+{
+  const uint32_t nbCalls = 1U << 20;
+  volatile double sinkRef = 0;
+  volatile float sink = 0;
+  uint64_t t0, tRef, t;
+
+  t0 = CCT_TEST_GetCpuTimeNs();
+  for (uint32_t i = 0; i < nbCalls; i++)
+  {
+    sinkRef += CCT_TEST_RefFixCCT(CCT_TEST_RefComputeCCT(96 + (i & 0x3F), 128, 160 - ((i >> 6) & 0x3F)));
+  }
+  tRef = CCT_TEST_GetCpuTimeNs() - t0;
+
+  t0 = CCT_TEST_GetCpuTimeNs();
+  for (uint32_t i = 0; i < nbCalls; i++)
+  {
+    sink += ISP_Algo_SimpleAWB_CCT_FixCCT(ISP_Algo_SimpleAWB_CCT_ComputeCCT(96 + (i & 0x3F), 128,
+                                                                            160 - ((i >> 6) & 0x3F)));
+  }
+  t = CCT_TEST_GetCpuTimeNs() - t0;
+
+  printf("CCT estimate (host): double %.1f ns, table + single precision %.1f ns (x%.1f)\n",
+         (double) tRef / nbCalls, (double) t / nbCalls, (double) tRef / (double) (t + 1));
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(void)
+{
+  CCT_TEST_Linearisation();
+  CCT_TEST_Accuracy(&ISP_IQParamCacheInit.AWBAlgo);
+  CCT_TEST_Cost();
+
+  printf("isp_algo_cct_test: %lu checks, %lu failures\n", (unsigned long) NbChecks, (unsigned long) NbFailures);
+
+  return NbFailures ? 1 : 0;
+}
@@ -0,0 +1,34 @@
+/**
+ ******************************************************************************
+ * @file    isp_param_conf.h
+ * @author  AIS Application Team
+ * @brief   IQ parameters of the host simulation: the sensor tuning file is
+ *          selected at build time with ISP_SIM_PARAM_CONF.
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+/* Not __ISP_PARAM_CONF__H: this is the guard of the included tuning file */
+#ifndef __ISP_SIM_PARAM_CONF__H
+#define __ISP_SIM_PARAM_CONF__H
+
+/* Includes ------------------------------------------------------------------*/
+#include "isp_core.h"
+
+#ifndef ISP_SIM_PARAM_CONF
+#define ISP_SIM_PARAM_CONF "imx335_E27_isp_param_conf.h"
+#endif
+
+#include ISP_SIM_PARAM_CONF
+
+#endif /* __ISP_SIM_PARAM_CONF__H */
@@ -0,0 +1,580 @@
+/**
+ ******************************************************************************
+ * @file    isp_sim.c
+ * @author  AIS Application Team
+ * @brief   Host simulation of the ISP middleware: replays synthetic scenes or
+ *          recorded statistics through the ISP services and algorithms, and
+ *          reports the AEC / AWB convergence and the CPU cost of the algorithms.
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include "isp_api.h"
+#include "isp_services.h"
+
+/* Private types -------------------------------------------------------------*/
+/* Scene seen by the sensor during a segment of the sequence */
+typedef struct
+{
+  char label[24];
+  uint32_t nbFrames;
+  float radiance[3];          /* Raw R, G, B level (8-bit, above black) per ms of exposure at 0 dB */
+} ISP_SIM_SegmentTypeDef;
+
+/* Sensor model: exposure and gain are applied 'delay' frames after being set */
+#define ISP_SIM_SENSOR_DELAY_MAX  4U
+typedef struct
+{
+  ISP_SensorInfoTypeDef info;
+  uint32_t delay;
+  uint8_t pedestal;           /* Black level added by the sensor */
+  int32_t exposure;           /* Last set (us) */
+  int32_t gain;               /* Last set (mdB) */
+  int32_t exposureHist[ISP_SIM_SENSOR_DELAY_MAX];
+  int32_t gainHist[ISP_SIM_SENSOR_DELAY_MAX];
+  int32_t exposureFrame;      /* Applied to the frame being received */
+  int32_t gainFrame;
+} ISP_SIM_SensorTypeDef;
+
+/* Control outputs of the ISP compared from frame to frame to detect the convergence */
+typedef struct
+{
+  int32_t exposure;
+  int32_t gain;
+  DCMIPP_ExposureConfTypeDef ispGain;
+  DCMIPP_ColorConversionConfTypeDef colorConv;
+} ISP_SIM_ControlTypeDef;
+
+typedef struct
+{
+  uint64_t calls;
+  uint64_t totalNs;
+  uint64_t maxNs;
+} ISP_SIM_CostTypeDef;
+
+/* Private constants ---------------------------------------------------------*/
+#define ISP_SIM_MAX_SEGMENTS      64U
+/* Controls unchanged for this number of frames: converged */
+#define ISP_SIM_STABLE_FRAMES     10U
+
+/* Names of the algorithms of isp_algo.c, in the order of their id */
+static const char *const ISP_SIM_AlgoName[] = {
+  "BadPixel", "BlackLevel", "SimpleAWB", "SimpleAEC", "AEC", "AWB", "SimpleAWB_CCT"
+};
+#define ISP_SIM_NB_ALGO           (sizeof(ISP_SIM_AlgoName) / sizeof(ISP_SIM_AlgoName[0]))
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static DCMIPP_HandleTypeDef hDcmipp;
+static ISP_HandleTypeDef hIsp;
+static ISP_SIM_SensorTypeDef Sensor = {
+  /* IMX335 */
+  .info = {
+    .name = "IMX335 (simulated)",
+    .bayer_pattern = ISP_DEMOS_TYPE_RGGB,
+    .color_depth = 10,
+    .width = 2592,
+    .height = 1944,
+    .gain_min = 0,
+    .gain_max = 72000,
+    .exposure_min = 0,
+    .exposure_max = 33266,
+  },
+  .delay = 1,
+  .pedestal = 12,
+  .exposure = 23814,
+  .gain = 20000,
+};
+
+static ISP_SIM_SegmentTypeDef Segments[ISP_SIM_MAX_SEGMENTS];
+static uint32_t NbSegments;
+
+static ISP_StatusTypeDef (*AlgoProcess[ISP_SIM_NB_ALGO])(void *pIsp, void *pAlgo);
+static ISP_SIM_CostTypeDef AlgoCost[ISP_SIM_NB_ALGO];
+
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+static uint64_t ISP_SIM_GetCpuTimeNs(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+
+  return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+static void ISP_SIM_AddCost(ISP_SIM_CostTypeDef *pCost, uint64_t ns)
+{
+  pCost->calls++;
+  pCost->totalNs += ns;
+  if (ns > pCost->maxNs)
+  {
+    pCost->maxNs = ns;
+  }
+}
+
+/* Application helpers: simulated sensor */
+static ISP_StatusTypeDef ISP_SIM_GetSensorInfo(uint32_t Instance, ISP_SensorInfoTypeDef *Info)
+{
+  (void)Instance;
+  *Info = Sensor.info;
+  return ISP_OK;
+}
+
+static ISP_StatusTypeDef ISP_SIM_SetSensorGain(uint32_t Instance, int32_t Gain)
+{
+  (void)Instance;
+  if ((Gain < (int32_t)Sensor.info.gain_min) || (Gain > (int32_t)Sensor.info.gain_max))
+  {
+    return ISP_ERR_SENSORGAIN;
+  }
+  Sensor.gain = Gain;
+  return ISP_OK;
+}
+
+static ISP_StatusTypeDef ISP_SIM_GetSensorGain(uint32_t Instance, int32_t *Gain)
+{
+  (void)Instance;
+  *Gain = Sensor.gain;
+  return ISP_OK;
+}
+
+static ISP_StatusTypeDef ISP_SIM_SetSensorExposure(uint32_t Instance, int32_t Exposure)
+{
+  (void)Instance;
+  if ((Exposure < (int32_t)Sensor.info.exposure_min) || (Exposure > (int32_t)Sensor.info.exposure_max))
+  {
+    return ISP_ERR_SENSOREXPOSURE;
+  }
+  Sensor.exposure = Exposure;
+  return ISP_OK;
+}
+
+static ISP_StatusTypeDef ISP_SIM_GetSensorExposure(uint32_t Instance, int32_t *Exposure)
+{
+  (void)Instance;
+  *Exposure = Sensor.exposure;
+  return ISP_OK;
+}
+
+/* Sensor VSYNC: selects the exposure and gain of the frame starting */
+static void ISP_SIM_Sensor_Vsync(void)
+{
+  for (uint32_t i = ISP_SIM_SENSOR_DELAY_MAX - 1U; i > 0U; i--)
+  {
+    Sensor.exposureHist[i] = Sensor.exposureHist[i - 1U];
+    Sensor.gainHist[i] = Sensor.gainHist[i - 1U];
+  }
+  Sensor.exposureHist[0] = Sensor.exposure;
+  Sensor.gainHist[0] = Sensor.gain;
+
+  Sensor.exposureFrame = Sensor.exposureHist[Sensor.delay - 1U];
+  Sensor.gainFrame = Sensor.gainHist[Sensor.delay - 1U];
+}
+
+static void ISP_SIM_Sensor_Init(void)
+{
+  for (uint32_t i = 0; i < ISP_SIM_SENSOR_DELAY_MAX; i++)
+  {
+    Sensor.exposureHist[i] = Sensor.exposure;
+    Sensor.gainHist[i] = Sensor.gain;
+  }
+  Sensor.exposureFrame = Sensor.exposure;
+  Sensor.gainFrame = Sensor.gain;
+}
+
+static float ISP_SIM_GainLinear(int32_t gain)
+{
+  return powf(10.0f, (float)gain / 20000.0f);
+}
+
+static void ISP_SIM_GetFrame(const ISP_SIM_SegmentTypeDef *pSegment, ISP_SIM_HAL_FrameTypeDef *pFrame)
+{
+  float scale = ((float)Sensor.exposureFrame / 1000.0f) * ISP_SIM_GainLinear(Sensor.gainFrame);
+
+  for (uint32_t i = 0; i < 3U; i++)
+  {
+    pFrame->mean[i] = pSegment->radiance[i] * scale;
+  }
+  pFrame->pedestal = Sensor.pedestal;
+}
+
+/* Time spent in each algorithm */
+static ISP_StatusTypeDef ISP_SIM_AlgoProcess(void *pIsp, void *pAlgo)
+{
+  uint8_t id = ((ISP_AlgoTypeDef *)pAlgo)->id;
+  uint64_t start = ISP_SIM_GetCpuTimeNs();
+  ISP_StatusTypeDef ret = AlgoProcess[id](pIsp, pAlgo);
+
+  ISP_SIM_AddCost(&AlgoCost[id], ISP_SIM_GetCpuTimeNs() - start);
+
+  return ret;
+}
+
+static int ISP_SIM_HookAlgorithms(void)
+{
+  for (uint32_t i = 0; i < ISP_SIM_NB_ALGO; i++)
+  {
+    ISP_AlgoTypeDef *algo = hIsp.algorithm[i];
+
+    if ((algo == NULL) || (algo->id != i))
+    {
+      printf("ERROR: algorithm %lu is not %s, update ISP_SIM_AlgoName\n", (unsigned long)i, ISP_SIM_AlgoName[i]);
+      return -1;
+    }
+    AlgoProcess[i] = algo->Process;
+    if (algo->Process != NULL)
+    {
+      algo->Process = ISP_SIM_AlgoProcess;
+    }
+  }
+
+  return 0;
+}
+
+/* Raw R / G and B / G ratios of a grey under the illuminant of an AWB profile */
+static void ISP_SIM_GetProfileRatio(const ISP_AWBAlgoTypeDef *awb, uint32_t i, float *pRatioR, float *pRatioB)
+{
+  *pRatioR = (float)awb->ispGainG[i] / (float)awb->ispGainR[i];
+  *pRatioB = (float)awb->ispGainG[i] / (float)awb->ispGainB[i];
+}
+
+/* Synthetic scene: neutral grey lit by a black body at 'colorTemp'. The raw color ratios are the inverse of the
+ * white balance gains of the tuning, interpolated in mired between its AWB profiles (sorted by color temperature).
+ */
+static void ISP_SIM_AddScene(const char *label, uint32_t nbFrames, float level, float colorTemp)
+{
+  const ISP_AWBAlgoTypeDef *awb = &ISP_SVC_IQParam_Get(&hIsp)->AWBAlgo;
+  ISP_SIM_SegmentTypeDef *pSegment = &Segments[NbSegments++];
+  float ratioR = 1.0f, ratioB = 1.0f, mired = 1e6f / colorTemp;
+  uint32_t i, nb = 0;
+
+  while ((nb < ISP_AWB_COLORTEMP_REF) && (awb->referenceColorTemp[nb] != 0))
+  {
+    nb++;
+  }
+
+  if (nb != 0U)
+  {
+    /* No extrapolation outside of the profiles */
+    i = 0;
+    while ((i < nb - 1U) && (mired < 1e6f / (float)awb->referenceColorTemp[i + 1U]))
+    {
+      i++;
+    }
+    ISP_SIM_GetProfileRatio(awb, i, &ratioR, &ratioB);
+
+    float m0 = 1e6f / (float)awb->referenceColorTemp[i];
+    if ((i < nb - 1U) && (mired < m0))
+    {
+      float m1 = 1e6f / (float)awb->referenceColorTemp[i + 1U];
+      float t = (m0 - mired) / (m0 - m1), ratioR1, ratioB1;
+
+      ISP_SIM_GetProfileRatio(awb, i + 1U, &ratioR1, &ratioB1);
+      ratioR += t * (ratioR1 - ratioR);
+      ratioB += t * (ratioB1 - ratioB);
+    }
+  }
+
+  snprintf(pSegment->label, sizeof(pSegment->label), "%s", label);
+  pSegment->nbFrames = nbFrames;
+  pSegment->radiance[0] = level * ratioR;
+  pSegment->radiance[1] = level;
+  pSegment->radiance[2] = level * ratioB;
+}
+
+static void ISP_SIM_AddDefaultScenes(void)
+{
+  ISP_SIM_AddScene("indoor 5000K", 150, 2.0f, 5000.0f);
+  ISP_SIM_AddScene("+4 EV", 150, 32.0f, 5000.0f);
+  ISP_SIM_AddScene("-6 EV", 150, 0.5f, 5000.0f);
+  ISP_SIM_AddScene("indoor 2856K (A)", 150, 2.0f, 2856.0f);
+  ISP_SIM_AddScene("indoor 6500K (D65)", 150, 2.0f, 6500.0f);
+  ISP_SIM_AddScene("indoor 4000K", 150, 2.0f, 4000.0f);
+}
+
+/* Recorded statistics: one segment per line "frames,R,G,B,exposure_us,gain_mdB", where R, G, B are the up
+ * averages (before black level correction) reported by the ISP with this sensor exposure and gain.
+ */
+static int ISP_SIM_LoadStats(const char *path)
+{
+  char line[256];
+  FILE *f = fopen(path, "r");
+  uint32_t lineNb = 0;
+
+  if (f == NULL)
+  {
+    printf("ERROR: can't open %s\n", path);
+    return -1;
+  }
+
+  while (fgets(line, sizeof(line), f) != NULL)
+  {
+    unsigned int nbFrames;
+    float avg[3], exposure, gain, scale;
+
+    lineNb++;
+    if ((line[0] == '#') || (line[0] == '\n') || (line[0] == '\r'))
+    {
+      continue;
+    }
+    if ((sscanf(line, "%u,%f,%f,%f,%f,%f", &nbFrames, &avg[0], &avg[1], &avg[2], &exposure, &gain) != 6) ||
+        (exposure <= 0.0f))
+    {
+      printf("ERROR: %s:%lu: expected frames,R,G,B,exposure_us,gain_mdB\n", path, (unsigned long)lineNb);
+      fclose(f);
+      return -1;
+    }
+    if (NbSegments == ISP_SIM_MAX_SEGMENTS)
+    {
+      printf("ERROR: %s: more than %u segments\n", path, ISP_SIM_MAX_SEGMENTS);
+      fclose(f);
+      return -1;
+    }
+
+    ISP_SIM_SegmentTypeDef *pSegment = &Segments[NbSegments++];
+    scale = (exposure / 1000.0f) * ISP_SIM_GainLinear((int32_t)gain);
+    snprintf(pSegment->label, sizeof(pSegment->label), "%s:%lu", "line", (unsigned long)lineNb);
+    pSegment->nbFrames = nbFrames;
+    for (uint32_t i = 0; i < 3U; i++)
+    {
+      pSegment->radiance[i] = fmaxf(avg[i] - (float)Sensor.pedestal, 0.0f) / scale;
+    }
+  }
+
+  fclose(f);
+
+  return (NbSegments != 0U) ? 0 : -1;
+}
+
+static void ISP_SIM_GetControl(ISP_SIM_ControlTypeDef *pControl)
+{
+  memset(pControl, 0, sizeof(*pControl));
+  pControl->exposure = Sensor.exposure;
+  pControl->gain = Sensor.gain;
+  if (HAL_DCMIPP_PIPE_IsEnabledISPExposure(&hDcmipp, DCMIPP_PIPE1))
+  {
+    HAL_DCMIPP_PIPE_GetISPExposureConfig(&hDcmipp, DCMIPP_PIPE1, &pControl->ispGain);
+  }
+  if (HAL_DCMIPP_PIPE_IsEnabledISPColorConversion(&hDcmipp, DCMIPP_PIPE1))
+  {
+    HAL_DCMIPP_PIPE_GetISPColorConversionConfig(&hDcmipp, DCMIPP_PIPE1, &pControl->colorConv);
+  }
+}
+
+/* AWB profile whose gains are applied, "-" if none */
+static const char *ISP_SIM_GetAWBProfile(void)
+{
+  const ISP_AWBAlgoTypeDef *awb = &ISP_SVC_IQParam_Get(&hIsp)->AWBAlgo;
+  ISP_ISPGainTypeDef ispGain;
+
+  if ((ISP_SVC_ISP_GetGain(&hIsp, &ispGain) != ISP_OK) || !ispGain.enable)
+  {
+    return "-";
+  }
+
+  for (uint32_t i = 0; (i < ISP_AWB_COLORTEMP_REF) && (awb->referenceColorTemp[i] != 0); i++)
+  {
+    /* Register precision */
+    if ((labs((long)ispGain.ispGainR - (long)awb->ispGainR[i]) < (long)awb->ispGainR[i] / 64) &&
+        (labs((long)ispGain.ispGainB - (long)awb->ispGainB[i]) < (long)awb->ispGainB[i] / 64))
+    {
+      return awb->id[i];
+    }
+  }
+
+  return "-";
+}
+
+static void ISP_SIM_Usage(const char *name)
+{
+  printf("Usage: %s [-c stats.csv] [-d sensor_delay] [-b black_level] [-t]\n", name);
+  printf("  -c  replay recorded statistics, one segment per line: frames,R,G,B,exposure_us,gain_mdB\n");
+  printf("      (default: built-in synthetic scenes)\n");
+  printf("  -d  frames between the sensor exposure / gain update and its effect (1 to %u, default %lu)\n",
+         ISP_SIM_SENSOR_DELAY_MAX, (unsigned long)Sensor.delay);
+  printf("  -b  sensor black level (default %u)\n", Sensor.pedestal);
+  printf("  -t  trace each frame, as CSV on stderr\n");
+}
+
+/* Exported functions --------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+  ISP_AppliHelpersTypeDef appliHelpers = {
+    .GetSensorInfo = ISP_SIM_GetSensorInfo,
+    .SetSensorGain = ISP_SIM_SetSensorGain,
+    .GetSensorGain = ISP_SIM_GetSensorGain,
+    .SetSensorExposure = ISP_SIM_SetSensorExposure,
+    .GetSensorExposure = ISP_SIM_GetSensorExposure,
+  };
+  ISP_SIM_ControlTypeDef control, previous;
+  ISP_SIM_HAL_FrameTypeDef frame;
+  ISP_SIM_CostTypeDef backgroundCost = {0};
+  ISP_ExposureCompTypeDef exposureComp;
+  ISP_StatusTypeDef ret;
+  const char *statsPath = NULL;
+  uint32_t exposureTarget, frameId = 0, nbNotConverged = 0;
+  int trace = 0, opt;
+
+  while ((opt = getopt(argc, argv, "c:d:b:th")) != -1)
+  {
+    switch (opt)
+    {
+    case 'c':
+      statsPath = optarg;
+      break;
+    case 'd':
+      Sensor.delay = (uint32_t)atoi(optarg);
+      break;
+    case 'b':
+      Sensor.pedestal = (uint8_t)atoi(optarg);
+      break;
+    case 't':
+      trace = 1;
+      break;
+    default:
+      ISP_SIM_Usage(argv[0]);
+      return (opt == 'h') ? 0 : 1;
+    }
+  }
+
+  if ((Sensor.delay < 1U) || (Sensor.delay > ISP_SIM_SENSOR_DELAY_MAX))
+  {
+    ISP_SIM_Usage(argv[0]);
+    return 1;
+  }
+
+  ISP_SIM_HAL_Init(&hDcmipp);
+  ISP_SIM_Sensor_Init();
+
+  ret = ISP_Init(&hIsp, &hDcmipp, 0, &appliHelpers, NULL);
+  if (ret == ISP_OK)
+  {
+    ret = ISP_Start(&hIsp);
+  }
+  if (ret != ISP_OK)
+  {
+    printf("ERROR: ISP init failed (%d)\n", ret);
+    return 1;
+  }
+
+  if (ISP_SIM_HookAlgorithms() != 0)
+  {
+    return 1;
+  }
+
+  if (statsPath != NULL)
+  {
+    if (ISP_SIM_LoadStats(statsPath) != 0)
+    {
+      return 1;
+    }
+  }
+  else
+  {
+    ISP_SIM_AddDefaultScenes();
+  }
+
+  ISP_GetExposureTarget(&hIsp, &exposureComp, &exposureTarget);
+  printf("Sensor %s, delay %lu frame(s), black level %u, exposure target %lu\n\n", Sensor.info.name,
+         (unsigned long)Sensor.delay, Sensor.pedestal, (unsigned long)exposureTarget);
+  if (trace)
+  {
+    fprintf(stderr, "frame,segment,exposure_us,gain_mdB,down_R,down_G,down_B,awb_profile\n");
+  }
+  printf("%-20s %6s %9s %9s %8s %7s %7s %s\n", "segment", "frames", "converged", "exposure", "gain", "L", "WB err",
+         "AWB profile");
+
+  ISP_SIM_GetControl(&previous);
+  for (uint32_t s = 0; s < NbSegments; s++)
+  {
+    const ISP_SIM_SegmentTypeDef *pSegment = &Segments[s];
+    uint32_t segmentStart = frameId, lastChange = frameId;
+    uint8_t changed = 0;
+    float down[3] = {0};
+
+    for (uint32_t n = 0; n < pSegment->nbFrames; n++, frameId++)
+    {
+      /* VSYNC: end of the frame received with the settings selected at the previous VSYNC */
+      ISP_SIM_GetFrame(pSegment, &frame);
+      ISP_SIM_HAL_Vsync(&hDcmipp, &frame);
+      ISP_SIM_Sensor_Vsync();
+      ISP_GatherStatistics(&hIsp);
+      /* Frame event of the main pipe */
+      ISP_IncMainFrameId(&hIsp);
+
+      uint64_t start = ISP_SIM_GetCpuTimeNs();
+      ret = ISP_BackgroundProcess(&hIsp);
+      ISP_SIM_AddCost(&backgroundCost, ISP_SIM_GetCpuTimeNs() - start);
+      if (ret != ISP_OK)
+      {
+        printf("WARNING: frame %lu: ISP background process error %d\n", (unsigned long)frameId, ret);
+      }
+
+      ISP_SIM_GetControl(&control);
+      if (memcmp(&control, &previous, sizeof(control)) != 0)
+      {
+        lastChange = frameId;
+        changed = 1;
+        previous = control;
+      }
+
+      ISP_SIM_HAL_GetDownAverage(&hDcmipp, &frame, down);
+      if (trace)
+      {
+        fprintf(stderr, "%lu,%lu,%ld,%ld,%.1f,%.1f,%.1f,%s\n", (unsigned long)frameId, (unsigned long)s,
+                (long)Sensor.exposureFrame, (long)Sensor.gainFrame, down[0], down[1], down[2],
+                ISP_SIM_GetAWBProfile());
+      }
+    }
+
+    /* Last frame of the segment */
+    float luminance = 0.299f * down[0] + 0.587f * down[1] + 0.114f * down[2];
+    float wbError = (down[1] > 0.0f) ? 100.0f * fmaxf(fabsf(down[0] / down[1] - 1.0f),
+                                                      fabsf(down[2] / down[1] - 1.0f)) : 0.0f;
+    char converged[16];
+
+    if ((frameId - lastChange) < ISP_SIM_STABLE_FRAMES)
+    {
+      snprintf(converged, sizeof(converged), "no");
+      nbNotConverged++;
+    }
+    else
+    {
+      snprintf(converged, sizeof(converged), "%lu", changed ? (unsigned long)(lastChange - segmentStart + 1U) : 0UL);
+    }
+
+    printf("%-20s %6lu %9s %7ldus %5.1fdB %7.1f %6.1f%% %s\n", pSegment->label, (unsigned long)pSegment->nbFrames,
+           converged, (long)Sensor.exposure, (float)Sensor.gain / 1000.0f, luminance, wbError, ISP_SIM_GetAWBProfile());
+  }
+
+  printf("\nCPU time per call (us)        calls       avg       max\n");
+  for (uint32_t i = 0; i < ISP_SIM_NB_ALGO; i++)
+  {
+    if (AlgoCost[i].calls != 0U)
+    {
+      printf("  %-24s %10llu %9.2f %9.2f\n", ISP_SIM_AlgoName[i], (unsigned long long)AlgoCost[i].calls,
+             (double)AlgoCost[i].totalNs / AlgoCost[i].calls / 1000.0, (double)AlgoCost[i].maxNs / 1000.0);
+    }
+  }
+  printf("  %-24s %10llu %9.2f %9.2f\n", "ISP_BackgroundProcess", (unsigned long long)backgroundCost.calls,
+         (double)backgroundCost.totalNs / backgroundCost.calls / 1000.0, (double)backgroundCost.maxNs / 1000.0);
+
+  ISP_DeInit(&hIsp);
+
+  /* Usable as a regression check */
+  return (nbNotConverged != 0U) ? 2 : 0;
+}
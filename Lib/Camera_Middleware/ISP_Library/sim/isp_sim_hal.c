@@ -0,0 +1,609 @@
+/**
+ ******************************************************************************
+ * @file    isp_sim_hal.c
+ * @author  AIS Application Team
+ * @brief   Simulated DCMIPP HAL used to run the ISP middleware on a host
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include <time.h>
+#include "isp_sim_hal.h"
+
+/* Private types -------------------------------------------------------------*/
+/* Private constants ---------------------------------------------------------*/
+/* Number of pixel values used to integrate the uniform distribution of a component */
+#define ISP_SIM_HAL_RAMP_SAMPLES  64U
+
+#define ISP_SIM_HAL_SOURCE_COMPONENT(source)  ((source) & 0x3U)
+#define ISP_SIM_HAL_SOURCE_IS_DOWN(source)    (((source) & 0x4U) != 0U)
+
+/* Private macro -------------------------------------------------------------*/
+#define ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe)  (((hdcmipp) != NULL) && ((Pipe) == DCMIPP_PIPE1))
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+static float ISP_SIM_HAL_Gain(uint8_t Shift, uint8_t Multiplier)
+{
+  return ((float)Multiplier / 128.0f) * (float)(1U << Shift);
+}
+
+/* Average of one component (0: R, 1: G, 2: B) at the up (raw) or down (black level + ISP gain) location */
+static float ISP_SIM_HAL_ComponentAverage(const ISP_SIM_HAL_ISPTypeDef *isp, const ISP_SIM_HAL_FrameTypeDef *pFrame,
+                                          uint32_t component, uint8_t down)
+{
+  const uint8_t blackLevel[3] = {
+    isp->blackLevel.RedCompBlackLevel, isp->blackLevel.GreenCompBlackLevel, isp->blackLevel.BlueCompBlackLevel
+  };
+  float gain = 1.0f, offset = 0.0f, sum = 0.0f;
+  uint32_t i;
+
+  if (down && isp->exposureEnableActive)
+  {
+    const DCMIPP_ExposureConfTypeDef *exp = &isp->exposureActive;
+    gain = (component == 0U) ? ISP_SIM_HAL_Gain(exp->ShiftRed, exp->MultiplierRed) :
+           (component == 1U) ? ISP_SIM_HAL_Gain(exp->ShiftGreen, exp->MultiplierGreen) :
+                               ISP_SIM_HAL_Gain(exp->ShiftBlue, exp->MultiplierBlue);
+  }
+
+  if (down && isp->blackLevelEnable)
+  {
+    offset = (float)blackLevel[component];
+  }
+
+  for (i = 0; i < ISP_SIM_HAL_RAMP_SAMPLES; i++)
+  {
+    float value = (2.0f * pFrame->mean[component] * ((float)i + 0.5f)) / ISP_SIM_HAL_RAMP_SAMPLES;
+
+    value += (float)pFrame->pedestal;
+
+    /* 8-bit raw sample */
+    value = (value > 255.0f) ? 255.0f : value;
+    if (down)
+    {
+      value = (value - offset) * gain;
+      value = (value < 0.0f) ? 0.0f : (value > 255.0f) ? 255.0f : value;
+    }
+    sum += value;
+  }
+
+  return sum / ISP_SIM_HAL_RAMP_SAMPLES;
+}
+
+static float ISP_SIM_HAL_SourceAverage(const ISP_SIM_HAL_ISPTypeDef *isp, const ISP_SIM_HAL_FrameTypeDef *pFrame,
+                                       uint32_t source)
+{
+  uint32_t component = ISP_SIM_HAL_SOURCE_COMPONENT(source);
+  uint8_t down = ISP_SIM_HAL_SOURCE_IS_DOWN(source);
+
+  if (component == 3U)
+  {
+    /* Luminance (BT.601) */
+    return 0.299f * ISP_SIM_HAL_ComponentAverage(isp, pFrame, 0, down) +
+           0.587f * ISP_SIM_HAL_ComponentAverage(isp, pFrame, 1, down) +
+           0.114f * ISP_SIM_HAL_ComponentAverage(isp, pFrame, 2, down);
+  }
+
+  return ISP_SIM_HAL_ComponentAverage(isp, pFrame, component, down);
+}
+
+/* Number of pixels of a component in the statistic area (raw bayer at the up location) */
+static uint32_t ISP_SIM_HAL_SourcePixels(const ISP_SIM_HAL_ISPTypeDef *isp, uint32_t source)
+{
+  uint32_t nb = isp->statArea.HSize * isp->statArea.VSize;
+  uint32_t component = ISP_SIM_HAL_SOURCE_COMPONENT(source);
+
+  if (!ISP_SIM_HAL_SOURCE_IS_DOWN(source) && (component != 3U))
+  {
+    nb /= (component == 1U) ? 2U : 4U;
+  }
+
+  return nb;
+}
+
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  ISP_SIM_HAL_Init
+  *         Reset the simulated DCMIPP, all pipes ready
+  * @param  hdcmipp: simulated DCMIPP handle
+  * @retval None
+  */
+void ISP_SIM_HAL_Init(DCMIPP_HandleTypeDef *hdcmipp)
+{
+  memset(hdcmipp, 0, sizeof(*hdcmipp));
+  hdcmipp->State = HAL_DCMIPP_STATE_READY;
+  for (uint32_t i = 0; i < DCMIPP_NUM_OF_PIPES; i++)
+  {
+    hdcmipp->PipeState[i] = HAL_DCMIPP_PIPE_STATE_READY;
+  }
+}
+
+/**
+  * @brief  ISP_SIM_HAL_Vsync
+  *         End of frame: computes the statistics of the frame with the configuration latched at its start, then
+  *         latches the configuration written since the previous VSYNC (shadow registers) for the next frame.
+  *         To be called before ISP_GatherStatistics().
+  * @param  hdcmipp: simulated DCMIPP handle
+  * @param  pFrame: frame which has just been received
+  * @retval None
+  */
+void ISP_SIM_HAL_Vsync(DCMIPP_HandleTypeDef *hdcmipp, const ISP_SIM_HAL_FrameTypeDef *pFrame)
+{
+  ISP_SIM_HAL_ISPTypeDef *isp = &hdcmipp->Isp;
+  uint32_t i;
+
+  for (i = 0; i < DCMIPP_STATEXT_MODULE3; i++)
+  {
+    const DCMIPP_StatisticExtractionConfTypeDef *conf = &isp->statActive[i];
+
+    if (!isp->statEnable[i] || !isp->statAreaEnable || (conf->Mode != DCMIPP_STAT_EXT_MODE_AVERAGE))
+    {
+      /* Histograms are not simulated */
+      isp->statCounter[i] = 0;
+      continue;
+    }
+
+    /* The accumulator is the sum of the 8-bit values divided by 256 */
+    isp->statCounter[i] = (uint32_t)((ISP_SIM_HAL_SourceAverage(isp, pFrame, conf->Source) *
+                                      (float)ISP_SIM_HAL_SourcePixels(isp, conf->Source)) / 256.0f + 0.5f);
+  }
+
+  memcpy(isp->statActive, isp->statConf, sizeof(isp->statActive));
+  isp->exposureActive = isp->exposure;
+  isp->exposureEnableActive = isp->exposureEnable;
+}
+
+/**
+  * @brief  ISP_SIM_HAL_GetDownAverage
+  *         Average of the components of a frame after the ISP gain, with the configuration currently latched
+  * @param  hdcmipp: simulated DCMIPP handle
+  * @param  pFrame: frame
+  * @param  pAverage: red, green and blue averages (output)
+  * @retval None
+  */
+void ISP_SIM_HAL_GetDownAverage(const DCMIPP_HandleTypeDef *hdcmipp, const ISP_SIM_HAL_FrameTypeDef *pFrame,
+                                float *pAverage)
+{
+  for (uint32_t i = 0; i < 3U; i++)
+  {
+    pAverage[i] = ISP_SIM_HAL_ComponentAverage(&hdcmipp->Isp, pFrame, i, 1);
+  }
+}
+
+uint32_t HAL_GetTick(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint32_t)((ts.tv_sec * 1000U) + (ts.tv_nsec / 1000000U));
+}
+
+HAL_DCMIPP_StateTypeDef HAL_DCMIPP_GetState(const DCMIPP_HandleTypeDef *hdcmipp)
+{
+  return (hdcmipp != NULL) ? hdcmipp->State : HAL_DCMIPP_STATE_RESET;
+}
+
+HAL_DCMIPP_PipeStateTypeDef HAL_DCMIPP_PIPE_GetState(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  return ((hdcmipp != NULL) && (Pipe < DCMIPP_NUM_OF_PIPES)) ? hdcmipp->PipeState[Pipe] : HAL_DCMIPP_PIPE_STATE_RESET;
+}
+
+/* Demosaicing */
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_SetISPRawBayer2RGBConfig(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                           const DCMIPP_RawBayer2RGBConfTypeDef *pRawBayer2RGBConfig)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe) || (pRawBayer2RGBConfig == NULL))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.demosaicing = *pRawBayer2RGBConfig;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_EnableISPRawBayer2RGB(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.demosaicingEnable = 1;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_DisableISPRawBayer2RGB(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.demosaicingEnable = 0;
+  return HAL_OK;
+}
+
+/* Statistic removal */
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_SetISPRemovalStatisticConfig(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                               uint32_t NbFirstLines, uint32_t NbLastLines)
+{
+  (void)NbFirstLines;
+  (void)NbLastLines;
+  return ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe) ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_EnableISPRemovalStatistic(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.statRemovalEnable = 1;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_DisableISPRemovalStatistic(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.statRemovalEnable = 0;
+  return HAL_OK;
+}
+
+/* Decimation */
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_SetISPDecimationConfig(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                         const DCMIPP_DecimationConfTypeDef *pDecConfig)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe) || (pDecConfig == NULL))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.decimation = *pDecConfig;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_EnableISPDecimation(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  return ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe) ? HAL_OK : HAL_ERROR;
+}
+
+/* Contrast */
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_SetISPCtrlContrastConfig(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                           const DCMIPP_ContrastConfTypeDef *pContrastConfig)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe) || (pContrastConfig == NULL))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.contrast = *pContrastConfig;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_EnableISPCtrlContrast(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.contrastEnable = 1;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_DisableISPCtrlContrast(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.contrastEnable = 0;
+  return HAL_OK;
+}
+
+/* Statistic extraction */
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_SetISPAreaStatisticExtractionConfig(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                                      const DCMIPP_StatisticExtractionAreaConfTypeDef
+                                                                      *pStatisticExtractionAreaConfig)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe) || (pStatisticExtractionAreaConfig == NULL))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.statArea = *pStatisticExtractionAreaConfig;
+  return HAL_OK;
+}
+
+void HAL_DCMIPP_PIPE_GetISPAreaStatisticExtractionConfig(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                         DCMIPP_StatisticExtractionAreaConfTypeDef
+                                                         *pStatisticExtractionAreaConfig)
+{
+  if (ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe) && (pStatisticExtractionAreaConfig != NULL))
+  {
+    *pStatisticExtractionAreaConfig = hdcmipp->Isp.statArea;
+  }
+}
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_EnableISPAreaStatisticExtraction(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.statAreaEnable = 1;
+  return HAL_OK;
+}
+
+uint32_t HAL_DCMIPP_PIPE_IsEnabledISPAreaStatisticExtraction(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  return ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe) ? hdcmipp->Isp.statAreaEnable : 0U;
+}
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_SetISPStatisticExtractionConfig(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                                  uint8_t ModuleID,
+                                                                  const DCMIPP_StatisticExtractionConfTypeDef
+                                                                  *pStatisticExtractionConfig)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe) || (pStatisticExtractionConfig == NULL) ||
+      (ModuleID < DCMIPP_STATEXT_MODULE1) || (ModuleID > DCMIPP_STATEXT_MODULE3))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.statConf[ModuleID - DCMIPP_STATEXT_MODULE1] = *pStatisticExtractionConfig;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_EnableISPStatisticExtraction(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                               uint8_t ModuleID)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe) ||
+      (ModuleID < DCMIPP_STATEXT_MODULE1) || (ModuleID > DCMIPP_STATEXT_MODULE3))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.statEnable[ModuleID - DCMIPP_STATEXT_MODULE1] = 1;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_GetISPAccumulatedStatisticsCounter(const DCMIPP_HandleTypeDef *hdcmipp,
+                                                                     uint32_t Pipe, uint8_t ModuleID,
+                                                                     uint32_t *pCounter)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe) || (pCounter == NULL) ||
+      (ModuleID < DCMIPP_STATEXT_MODULE1) || (ModuleID > DCMIPP_STATEXT_MODULE3))
+  {
+    return HAL_ERROR;
+  }
+  *pCounter = hdcmipp->Isp.statCounter[ModuleID - DCMIPP_STATEXT_MODULE1];
+  return HAL_OK;
+}
+
+/* Bad pixel removal */
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_SetISPBadPixelRemovalConfig(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                              uint32_t Strength)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.badPixelStrength = Strength;
+  return HAL_OK;
+}
+
+uint32_t HAL_DCMIPP_PIPE_GetISPBadPixelRemovalConfig(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  return ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe) ? hdcmipp->Isp.badPixelStrength : 0U;
+}
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_EnableISPBadPixelRemoval(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.badPixelEnable = 1;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_DisableISPBadPixelRemoval(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.badPixelEnable = 0;
+  return HAL_OK;
+}
+
+uint32_t HAL_DCMIPP_PIPE_IsEnabledISPBadPixelRemoval(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  return ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe) ? hdcmipp->Isp.badPixelEnable : 0U;
+}
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_GetISPRemovedBadPixelCounter(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                               uint32_t *pCounter)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe) || (pCounter == NULL))
+  {
+    return HAL_ERROR;
+  }
+  /* The simulated sensor has no defective pixel */
+  *pCounter = 0;
+  return HAL_OK;
+}
+
+/* Black level calibration */
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_SetISPBlackLevelCalibrationConfig(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                                    const DCMIPP_BlackLevelConfTypeDef
+                                                                    *pBlackLevelConfig)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe) || (pBlackLevelConfig == NULL))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.blackLevel = *pBlackLevelConfig;
+  return HAL_OK;
+}
+
+void HAL_DCMIPP_PIPE_GetISPBlackLevelCalibrationConfig(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                       DCMIPP_BlackLevelConfTypeDef *pBlackLevelConfig)
+{
+  if (ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe) && (pBlackLevelConfig != NULL))
+  {
+    *pBlackLevelConfig = hdcmipp->Isp.blackLevel;
+  }
+}
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_EnableISPBlackLevelCalibration(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.blackLevelEnable = 1;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_DisableISPBlackLevelCalibration(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.blackLevelEnable = 0;
+  return HAL_OK;
+}
+
+uint32_t HAL_DCMIPP_PIPE_IsEnabledISPBlackLevelCalibration(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  return ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe) ? hdcmipp->Isp.blackLevelEnable : 0U;
+}
+
+/* Exposure (ISP gain) */
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_SetISPExposureConfig(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                       const DCMIPP_ExposureConfTypeDef *pExposureConfig)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe) || (pExposureConfig == NULL))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.exposure = *pExposureConfig;
+  return HAL_OK;
+}
+
+void HAL_DCMIPP_PIPE_GetISPExposureConfig(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                          DCMIPP_ExposureConfTypeDef *pExposureConfig)
+{
+  if (ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe) && (pExposureConfig != NULL))
+  {
+    *pExposureConfig = hdcmipp->Isp.exposure;
+  }
+}
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_EnableISPExposure(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.exposureEnable = 1;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_DisableISPExposure(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.exposureEnable = 0;
+  return HAL_OK;
+}
+
+uint32_t HAL_DCMIPP_PIPE_IsEnabledISPExposure(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  return ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe) ? hdcmipp->Isp.exposureEnable : 0U;
+}
+
+/* Color conversion */
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_SetISPColorConversionConfig(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                              const DCMIPP_ColorConversionConfTypeDef
+                                                              *pColorConversionConfig)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe) || (pColorConversionConfig == NULL))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.colorConv = *pColorConversionConfig;
+  return HAL_OK;
+}
+
+void HAL_DCMIPP_PIPE_GetISPColorConversionConfig(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                 DCMIPP_ColorConversionConfTypeDef *pColorConversionConfig)
+{
+  if (ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe) && (pColorConversionConfig != NULL))
+  {
+    *pColorConversionConfig = hdcmipp->Isp.colorConv;
+  }
+}
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_EnableISPColorConversion(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.colorConvEnable = 1;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_DisableISPColorConversion(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  if (!ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.colorConvEnable = 0;
+  return HAL_OK;
+}
+
+uint32_t HAL_DCMIPP_PIPE_IsEnabledISPColorConversion(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  return ISP_SIM_HAL_IS_ISP_PIPE(hdcmipp, Pipe) ? hdcmipp->Isp.colorConvEnable : 0U;
+}
+
+/* Gamma (pipes 1 and 2) */
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_EnableGammaConversion(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  if ((hdcmipp == NULL) || (Pipe == DCMIPP_PIPE0) || (Pipe >= DCMIPP_NUM_OF_PIPES))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.gammaEnable[Pipe] = 1;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_DisableGammaConversion(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  if ((hdcmipp == NULL) || (Pipe == DCMIPP_PIPE0) || (Pipe >= DCMIPP_NUM_OF_PIPES))
+  {
+    return HAL_ERROR;
+  }
+  hdcmipp->Isp.gammaEnable[Pipe] = 0;
+  return HAL_OK;
+}
+
+uint32_t HAL_DCMIPP_PIPE_IsEnabledGammaConversion(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  return ((hdcmipp != NULL) && (Pipe < DCMIPP_NUM_OF_PIPES)) ? hdcmipp->Isp.gammaEnable[Pipe] : 0U;
+}
@@ -0,0 +1,321 @@
+/**
+ ******************************************************************************
+ * @file    isp_sim_hal.h
+ * @author  AIS Application Team
+ * @brief   Header file of the simulated DCMIPP HAL used to run the ISP
+ *          middleware on a host (included by isp_conf.h when ISP_SIM is
+ *          defined).
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __ISP_SIM_HAL__H
+#define __ISP_SIM_HAL__H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+/* Subset of the HAL types used by the ISP middleware. The register level behavior is not simulated: the
+ * configurations are stored as written and the statistics are computed from a frame description provided by
+ * the simulation at each VSYNC (see ISP_SIM_HAL_Vsync()).
+ */
+typedef enum
+{
+  HAL_OK       = 0x00U,
+  HAL_ERROR    = 0x01U,
+  HAL_BUSY     = 0x02U,
+  HAL_TIMEOUT  = 0x03U,
+} HAL_StatusTypeDef;
+
+typedef enum
+{
+  DISABLE = 0U,
+  ENABLE = !DISABLE,
+} FunctionalState;
+
+typedef enum
+{
+  HAL_DCMIPP_STATE_RESET = 0x00U,
+  HAL_DCMIPP_STATE_INIT  = 0x01U,
+  HAL_DCMIPP_STATE_READY = 0x02U,
+  HAL_DCMIPP_STATE_BUSY  = 0x03U,
+  HAL_DCMIPP_STATE_ERROR = 0x04U,
+} HAL_DCMIPP_StateTypeDef;
+
+typedef enum
+{
+  HAL_DCMIPP_PIPE_STATE_RESET = 0x00U,
+  HAL_DCMIPP_PIPE_STATE_READY = 0x01U,
+  HAL_DCMIPP_PIPE_STATE_BUSY  = 0x02U,
+  HAL_DCMIPP_PIPE_STATE_ERROR = 0x06U,
+} HAL_DCMIPP_PipeStateTypeDef;
+
+typedef struct
+{
+  uint32_t Mode;
+  uint32_t Source;
+  uint32_t Bins;
+} DCMIPP_StatisticExtractionConfTypeDef;
+
+typedef struct
+{
+  uint32_t VStart;
+  uint32_t HStart;
+  uint32_t VSize;
+  uint32_t HSize;
+} DCMIPP_StatisticExtractionAreaConfTypeDef;
+
+typedef struct
+{
+  uint8_t ShiftRed;
+  uint8_t MultiplierRed;
+  uint8_t ShiftGreen;
+  uint8_t MultiplierGreen;
+  uint8_t ShiftBlue;
+  uint8_t MultiplierBlue;
+} DCMIPP_ExposureConfTypeDef;
+
+typedef struct
+{
+  FunctionalState ClampOutputSamples;
+  uint8_t OutputSamplesType;
+  int16_t RR;
+  int16_t RG;
+  int16_t RB;
+  int16_t RA;
+  int16_t GR;
+  int16_t GG;
+  int16_t GB;
+  int16_t GA;
+  int16_t BR;
+  int16_t BG;
+  int16_t BB;
+  int16_t BA;
+} DCMIPP_ColorConversionConfTypeDef;
+
+typedef struct
+{
+  uint8_t RedCompBlackLevel;
+  uint8_t GreenCompBlackLevel;
+  uint8_t BlueCompBlackLevel;
+} DCMIPP_BlackLevelConfTypeDef;
+
+typedef struct
+{
+  uint32_t VLineStrength;
+  uint32_t HLineStrength;
+  uint32_t RawBayerType;
+  uint32_t PeakStrength;
+  uint32_t EdgeStrength;
+} DCMIPP_RawBayer2RGBConfTypeDef;
+
+typedef struct
+{
+  uint32_t VRatio;
+  uint32_t HRatio;
+} DCMIPP_DecimationConfTypeDef;
+
+typedef struct
+{
+  uint8_t LUM_0;
+  uint8_t LUM_32;
+  uint8_t LUM_64;
+  uint8_t LUM_96;
+  uint8_t LUM_128;
+  uint8_t LUM_160;
+  uint8_t LUM_192;
+  uint8_t LUM_224;
+  uint8_t LUM_256;
+} DCMIPP_ContrastConfTypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+#define DCMIPP_NUM_OF_PIPES                     3U
+
+#define DCMIPP_PIPE0                            0U
+#define DCMIPP_PIPE1                            1U
+#define DCMIPP_PIPE2                            2U
+
+#define DCMIPP_STATEXT_MODULE1                  1U
+#define DCMIPP_STATEXT_MODULE2                  2U
+#define DCMIPP_STATEXT_MODULE3                  3U
+
+#define DCMIPP_STAT_EXT_MODE_AVERAGE            0U
+#define DCMIPP_STAT_EXT_MODE_BINS               1U
+
+/* Source encoding of the simulation: bits [1:0] component (R, G, B, L), bit 2 location (0 up, 1 down) */
+#define DCMIPP_STAT_EXT_SOURCE_PRE_BLKLVL_R     0x0U
+#define DCMIPP_STAT_EXT_SOURCE_PRE_BLKLVL_G     0x1U
+#define DCMIPP_STAT_EXT_SOURCE_PRE_BLKLVL_B     0x2U
+#define DCMIPP_STAT_EXT_SOURCE_PRE_BLKLVL_L     0x3U
+#define DCMIPP_STAT_EXT_SOURCE_POST_DEMOS_R     0x4U
+#define DCMIPP_STAT_EXT_SOURCE_POST_DEMOS_G     0x5U
+#define DCMIPP_STAT_EXT_SOURCE_POST_DEMOS_B     0x6U
+#define DCMIPP_STAT_EXT_SOURCE_POST_DEMOS_L     0x7U
+
+#define DCMIPP_STAT_EXT_AVER_MODE_ALL_PIXELS    0U
+#define DCMIPP_STAT_EXT_BINS_MODE_LOWER_BINS    0U
+#define DCMIPP_STAT_EXT_BINS_MODE_LOWMID_BINS   1U
+#define DCMIPP_STAT_EXT_BINS_MODE_UPMID_BINS    2U
+#define DCMIPP_STAT_EXT_BINS_MODE_UP_BINS       3U
+
+#define DCMIPP_VDEC_ALL                         0U
+#define DCMIPP_VDEC_1_OUT_2                     1U
+#define DCMIPP_VDEC_1_OUT_4                     2U
+#define DCMIPP_VDEC_1_OUT_8                     3U
+#define DCMIPP_HDEC_ALL                         0U
+#define DCMIPP_HDEC_1_OUT_2                     1U
+#define DCMIPP_HDEC_1_OUT_4                     2U
+#define DCMIPP_HDEC_1_OUT_8                     3U
+
+#define DCMIPP_RAWBAYER_RGGB                    0U
+#define DCMIPP_RAWBAYER_GRBG                    1U
+#define DCMIPP_RAWBAYER_GBRG                    2U
+#define DCMIPP_RAWBAYER_BGGR                    3U
+
+/* Simulated DCMIPP ISP (pipe 1) */
+typedef struct
+{
+  DCMIPP_StatisticExtractionConfTypeDef statConf[DCMIPP_STATEXT_MODULE3];   /* Written by the middleware */
+  DCMIPP_StatisticExtractionConfTypeDef statActive[DCMIPP_STATEXT_MODULE3]; /* Latched at VSYNC */
+  uint8_t statEnable[DCMIPP_STATEXT_MODULE3];
+  uint32_t statCounter[DCMIPP_STATEXT_MODULE3];
+  DCMIPP_StatisticExtractionAreaConfTypeDef statArea;
+  uint8_t statAreaEnable;
+  DCMIPP_DecimationConfTypeDef decimation;
+  DCMIPP_ExposureConfTypeDef exposure;
+  DCMIPP_ExposureConfTypeDef exposureActive;
+  uint8_t exposureEnable;
+  uint8_t exposureEnableActive;
+  DCMIPP_BlackLevelConfTypeDef blackLevel;
+  uint8_t blackLevelEnable;
+  DCMIPP_ColorConversionConfTypeDef colorConv;
+  uint8_t colorConvEnable;
+  DCMIPP_RawBayer2RGBConfTypeDef demosaicing;
+  uint8_t demosaicingEnable;
+  DCMIPP_ContrastConfTypeDef contrast;
+  uint8_t contrastEnable;
+  uint32_t badPixelStrength;
+  uint8_t badPixelEnable;
+  uint8_t statRemovalEnable;
+  uint8_t gammaEnable[DCMIPP_NUM_OF_PIPES];
+} ISP_SIM_HAL_ISPTypeDef;
+
+typedef struct
+{
+  HAL_DCMIPP_StateTypeDef State;
+  HAL_DCMIPP_PipeStateTypeDef PipeState[DCMIPP_NUM_OF_PIPES];
+  ISP_SIM_HAL_ISPTypeDef Isp;
+} DCMIPP_HandleTypeDef;
+
+/* Description of a frame received by the ISP: the pixels of each raw component (sensor black level included)
+ * are spread uniformly between 0 and twice the mean, then clipped to the 8-bit range. Red, green, blue order.
+ */
+typedef struct
+{
+  float mean[3];
+  uint8_t pedestal;
+} ISP_SIM_HAL_FrameTypeDef;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+/* Simulation control */
+void ISP_SIM_HAL_Init(DCMIPP_HandleTypeDef *hdcmipp);
+void ISP_SIM_HAL_Vsync(DCMIPP_HandleTypeDef *hdcmipp, const ISP_SIM_HAL_FrameTypeDef *pFrame);
+void ISP_SIM_HAL_GetDownAverage(const DCMIPP_HandleTypeDef *hdcmipp, const ISP_SIM_HAL_FrameTypeDef *pFrame,
+                                float *pAverage);
+
+/* HAL subset */
+uint32_t HAL_GetTick(void);
+
+HAL_DCMIPP_StateTypeDef HAL_DCMIPP_GetState(const DCMIPP_HandleTypeDef *hdcmipp);
+HAL_DCMIPP_PipeStateTypeDef HAL_DCMIPP_PIPE_GetState(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_SetISPRawBayer2RGBConfig(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                           const DCMIPP_RawBayer2RGBConfTypeDef *pRawBayer2RGBConfig);
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_EnableISPRawBayer2RGB(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_DisableISPRawBayer2RGB(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_SetISPRemovalStatisticConfig(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                               uint32_t NbFirstLines, uint32_t NbLastLines);
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_EnableISPRemovalStatistic(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_DisableISPRemovalStatistic(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_SetISPDecimationConfig(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                         const DCMIPP_DecimationConfTypeDef *pDecConfig);
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_EnableISPDecimation(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_SetISPCtrlContrastConfig(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                           const DCMIPP_ContrastConfTypeDef *pContrastConfig);
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_EnableISPCtrlContrast(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_DisableISPCtrlContrast(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_SetISPAreaStatisticExtractionConfig(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                                      const DCMIPP_StatisticExtractionAreaConfTypeDef
+                                                                      *pStatisticExtractionAreaConfig);
+void HAL_DCMIPP_PIPE_GetISPAreaStatisticExtractionConfig(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                         DCMIPP_StatisticExtractionAreaConfTypeDef
+                                                         *pStatisticExtractionAreaConfig);
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_EnableISPAreaStatisticExtraction(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+uint32_t HAL_DCMIPP_PIPE_IsEnabledISPAreaStatisticExtraction(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_SetISPStatisticExtractionConfig(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                                  uint8_t ModuleID,
+                                                                  const DCMIPP_StatisticExtractionConfTypeDef
+                                                                  *pStatisticExtractionConfig);
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_EnableISPStatisticExtraction(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                               uint8_t ModuleID);
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_GetISPAccumulatedStatisticsCounter(const DCMIPP_HandleTypeDef *hdcmipp,
+                                                                     uint32_t Pipe, uint8_t ModuleID,
+                                                                     uint32_t *pCounter);
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_SetISPBadPixelRemovalConfig(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                              uint32_t Strength);
+uint32_t HAL_DCMIPP_PIPE_GetISPBadPixelRemovalConfig(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_EnableISPBadPixelRemoval(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_DisableISPBadPixelRemoval(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+uint32_t HAL_DCMIPP_PIPE_IsEnabledISPBadPixelRemoval(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_GetISPRemovedBadPixelCounter(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                               uint32_t *pCounter);
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_SetISPBlackLevelCalibrationConfig(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                                    const DCMIPP_BlackLevelConfTypeDef
+                                                                    *pBlackLevelConfig);
+void HAL_DCMIPP_PIPE_GetISPBlackLevelCalibrationConfig(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                       DCMIPP_BlackLevelConfTypeDef *pBlackLevelConfig);
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_EnableISPBlackLevelCalibration(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_DisableISPBlackLevelCalibration(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+uint32_t HAL_DCMIPP_PIPE_IsEnabledISPBlackLevelCalibration(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_SetISPExposureConfig(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                       const DCMIPP_ExposureConfTypeDef *pExposureConfig);
+void HAL_DCMIPP_PIPE_GetISPExposureConfig(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                          DCMIPP_ExposureConfTypeDef *pExposureConfig);
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_EnableISPExposure(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_DisableISPExposure(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+uint32_t HAL_DCMIPP_PIPE_IsEnabledISPExposure(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_SetISPColorConversionConfig(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                              const DCMIPP_ColorConversionConfTypeDef
+                                                              *pColorConversionConfig);
+void HAL_DCMIPP_PIPE_GetISPColorConversionConfig(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                 DCMIPP_ColorConversionConfTypeDef *pColorConversionConfig);
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_EnableISPColorConversion(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_DisableISPColorConversion(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+uint32_t HAL_DCMIPP_PIPE_IsEnabledISPColorConversion(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_EnableGammaConversion(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+HAL_StatusTypeDef HAL_DCMIPP_PIPE_DisableGammaConversion(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+uint32_t HAL_DCMIPP_PIPE_IsEnabledGammaConversion(const DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe);
+
+#endif /* __ISP_SIM_HAL__H */
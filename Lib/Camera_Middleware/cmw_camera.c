@@ -23,6 +23,7 @@
 #include "isp_api.h"
 #include "stm32n6xx_hal_dcmipp.h"
 #include "cmw_utils.h"
+#include "cmw_frame_ring.h"
 #include "cmw_vd55g1.h"
 #include "cmw_imx335.h"
 #include "cmw_ov5640.h"
@@ -56,6 +57,10 @@ CAMERA_Ctx_t  Camera_Ctx;
 DCMIPP_HandleTypeDef hcamera_dcmipp;
 static CMW_Sensor_if_t Camera_Drv;
 
+/* ISP task: frames between two runs, 0 when the ISP is run by CMW_CAMERA_Run() */
+static volatile uint32_t isp_task_period;
+static uint32_t isp_task_vsync_count;
+
 static union
 {
 #if defined(USE_IMX335_SENSOR)
@@ -406,6 +411,112 @@ int32_t CMW_CAMERA_Suspend(uint32_t pipe)
   return CMW_ERROR_NONE;
 }
 
+/**
+  * @brief  Requests the capture of the selected pipe to stop at the end of the frame in progress, without waiting
+  *         for it: may be called from the frame event. CMW_CAMERA_IsCaptureActive() tells when no frame is
+  *         written anymore, CMW_CAMERA_Resume() restarts the capture.
+  * @param  pipe Dcmipp pipe.
+  * @retval CMW status
+  */
+int32_t CMW_CAMERA_RequestSuspend(uint32_t pipe)
+{
+  if (pipe >= DCMIPP_NUM_OF_PIPES)
+  {
+    return CMW_ERROR_WRONG_PARAM;
+  }
+
+  if (hcamera_dcmipp.PipeState[pipe] == HAL_DCMIPP_PIPE_STATE_BUSY)
+  {
+    /* Same as HAL_DCMIPP_PIPE_Suspend() without the polling of CPTACT */
+    if (pipe == DCMIPP_PIPE0)
+    {
+      CLEAR_BIT(hcamera_dcmipp.Instance->P0FCTCR, DCMIPP_P0FCTCR_CPTREQ);
+    }
+    else if (pipe == DCMIPP_PIPE1)
+    {
+      CLEAR_BIT(hcamera_dcmipp.Instance->P1FCTCR, DCMIPP_P1FCTCR_CPTREQ);
+    }
+    else
+    {
+      CLEAR_BIT(hcamera_dcmipp.Instance->P2FCTCR, DCMIPP_P2FCTCR_CPTREQ);
+    }
+    hcamera_dcmipp.PipeState[pipe] = HAL_DCMIPP_PIPE_STATE_SUSPEND;
+  }
+
+  /* Return CMW status */
+  return CMW_ERROR_NONE;
+}
+
+/**
+  * @brief  Tells whether a frame is being captured by the selected pipe (from start of frame to frame complete)
+  * @param  pipe Dcmipp pipe.
+  * @retval 1 if a capture is active, 0 otherwise
+  */
+int CMW_CAMERA_IsCaptureActive(uint32_t pipe)
+{
+  static const uint32_t cptact[DCMIPP_NUM_OF_PIPES] = {
+    DCMIPP_CMSR1_P0CPTACT, DCMIPP_CMSR1_P1CPTACT, DCMIPP_CMSR1_P2CPTACT
+  };
+
+  if (pipe >= DCMIPP_NUM_OF_PIPES)
+  {
+    return 0;
+  }
+
+  return (READ_BIT(hcamera_dcmipp.Instance->CMSR1, cptact[pipe]) != 0U) ? 1 : 0;
+}
+
+/**
+  * @brief  Resume the CAMERA capture on selected pipe
+  * @param  pipe Dcmipp pipe.
+  * @retval CMW status
+  */
+int32_t CMW_CAMERA_Resume(uint32_t pipe)
+{
+  if (hcamera_dcmipp.PipeState[pipe] == HAL_DCMIPP_PIPE_STATE_SUSPEND)
+  {
+    if (HAL_DCMIPP_PIPE_Resume(&hcamera_dcmipp, pipe) != HAL_OK)
+    {
+      return CMW_ERROR_PERIPH_FAILURE;
+    }
+  }
+
+  /* Return CMW status */
+  return CMW_ERROR_NONE;
+}
+
+/**
+  * @brief  Enables the line event of the selected pipe: CMW_CAMERA_PIPE_LineEventCallback() is called each time
+  *         a group of lines of the frame is written to memory, e.g. to process a frame while it is captured.
+  * @param  pipe Dcmipp pipe.
+  * @param  multiline Number of lines per event, DCMIPP_MULTILINE_1_LINE to DCMIPP_MULTILINE_128_LINES
+  * @retval CMW status
+  */
+int32_t CMW_CAMERA_EnableLineEvent(uint32_t pipe, uint32_t multiline)
+{
+  if (HAL_DCMIPP_PIPE_EnableLineEvent(&hcamera_dcmipp, pipe, multiline) != HAL_OK)
+  {
+    return CMW_ERROR_PERIPH_FAILURE;
+  }
+
+  return CMW_ERROR_NONE;
+}
+
+/**
+  * @brief  Disables the line event of the selected pipe
+  * @param  pipe Dcmipp pipe.
+  * @retval CMW status
+  */
+int32_t CMW_CAMERA_DisableLineEvent(uint32_t pipe)
+{
+  if (HAL_DCMIPP_PIPE_DisableLineEvent(&hcamera_dcmipp, pipe) != HAL_OK)
+  {
+    return CMW_ERROR_PERIPH_FAILURE;
+  }
+
+  return CMW_ERROR_NONE;
+}
+
 /**
   * @brief  Set the camera gain.
   * @param  Gain     Gain in dB
@@ -575,6 +686,12 @@ int32_t CMW_CAMERA_GetSensorInfo(ISP_SensorInfoTypeDef *info)
 
 int32_t CMW_CAMERA_Run()
 {
+  if (isp_task_period != 0)
+  {
+    /* Run by the ISP task */
+    return CMW_ERROR_NONE;
+  }
+
   if(Camera_Drv.Run != NULL)
   {
       return Camera_Drv.Run(&camera_bsp);
@@ -582,6 +699,64 @@ int32_t CMW_CAMERA_Run()
   return CMW_ERROR_NONE;
 }
 
+#if defined(CMW_ISP_TASK_IRQn)
+#if defined(TICK_INT_PRIORITY) && (CMW_ISP_TASK_PRIORITY <= TICK_INT_PRIORITY)
+#error "CMW_ISP_TASK_PRIORITY must be less urgent (numerically higher) than TICK_INT_PRIORITY, the ISP task waits on HAL_GetTick()"
+#endif
+
+/**
+  * @brief  Moves the ISP background process (statistics and IQ algorithms) from CMW_CAMERA_Run() to the
+  *         CMW_ISP_TASK_IRQn interrupt, pended on the VSYNC of the main pipe. The ISP is updated at the frame rate
+  *         whatever the load of the application (e.g. waiting for the end of an inference), and CMW_CAMERA_Run()
+  *         does nothing. The task can preempt the application: the ISP settings should not be changed meanwhile.
+  * @param  period  Number of frames between two runs of the ISP, 0 to go back to CMW_CAMERA_Run()
+  * @retval CMW status
+  */
+int32_t CMW_CAMERA_EnableISPTask(uint32_t period)
+{
+  isp_task_period = 0;
+  isp_task_vsync_count = 0;
+
+  if (period == 0)
+  {
+    return CMW_ERROR_NONE;
+  }
+
+  NVIC_SetPriority(CMW_ISP_TASK_IRQn, CMW_ISP_TASK_PRIORITY);
+  if ((int32_t)CMW_ISP_TASK_IRQn >= 0)
+  {
+    NVIC_EnableIRQ(CMW_ISP_TASK_IRQn);
+  }
+  isp_task_period = period;
+
+  return CMW_ERROR_NONE;
+}
+
+/**
+  * @brief  ISP task, to be called from the CMW_ISP_TASK_IRQn interrupt handler
+  * @retval None
+  */
+void CMW_CAMERA_ISPTaskHandler(void)
+{
+  if ((isp_task_period != 0) && (Camera_Drv.Run != NULL))
+  {
+    (void)Camera_Drv.Run(&camera_bsp);
+  }
+}
+
+static void CMW_CAMERA_PendISPTask(void)
+{
+  if (CMW_ISP_TASK_IRQn == PendSV_IRQn)
+  {
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+  }
+  else
+  {
+    NVIC_SetPendingIRQ(CMW_ISP_TASK_IRQn);
+  }
+}
+#endif
+
 /**
  * @brief  Vsync Event callback on pipe
  * @param  hdcmipp DCMIPP device handle
@@ -608,6 +783,19 @@ __weak int CMW_CAMERA_PIPE_FrameEventCallback(uint32_t pipe)
   return HAL_OK;
 }
 
+/**
+ * @brief  Line Event callback on pipe
+ * @param  hdcmipp DCMIPP device handle
+ *         Pipe    Pipe receiving the callback
+ * @retval None
+ */
+__weak int CMW_CAMERA_PIPE_LineEventCallback(uint32_t pipe)
+{
+  UNUSED(pipe);
+
+  return HAL_OK;
+}
+
 /**
  * @brief  Vsync Event callback on pipe
  * @param  hdcmipp DCMIPP device handle
@@ -621,6 +809,14 @@ void HAL_DCMIPP_PIPE_VsyncEventCallback(DCMIPP_HandleTypeDef *hdcmipp, uint32_t
   {
       Camera_Drv.VsyncEventCallback(&camera_bsp, Pipe);
   }
+  /* Statistics of the frame are gathered: time to run the ISP */
+#if defined(CMW_ISP_TASK_IRQn)
+  if ((isp_task_period != 0) && (Pipe == DCMIPP_PIPE1) && (++isp_task_vsync_count >= isp_task_period))
+  {
+    isp_task_vsync_count = 0;
+    CMW_CAMERA_PendISPTask();
+  }
+#endif
   CMW_CAMERA_PIPE_VsyncEventCallback(Pipe);
 }
 
@@ -637,9 +833,23 @@ void HAL_DCMIPP_PIPE_FrameEventCallback(DCMIPP_HandleTypeDef *hdcmipp, uint32_t
   {
       Camera_Drv.FrameEventCallback(&camera_bsp, Pipe);
   }
+  /* Re-arm the capture first, the application callback may acquire the frame */
+  CMW_FRAME_RING_FrameEventCallback(Pipe);
   CMW_CAMERA_PIPE_FrameEventCallback(Pipe);
 }
 
+/**
+ * @brief  Line Event callback on pipe
+ * @param  hdcmipp DCMIPP device handle
+ *         Pipe    Pipe receiving the callback
+ * @retval None
+ */
+void HAL_DCMIPP_PIPE_LineEventCallback(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe)
+{
+  UNUSED(hdcmipp);
+  CMW_CAMERA_PIPE_LineEventCallback(Pipe);
+}
+
 /**
   * @brief  Initializes the DCMIPP MSP.
   * @param  hdcmipp  DCMIPP handle
@@ -189,16 +189,40 @@ typedef struct {
 #define CMW_MIRRORFLIP_MIRROR        0x02U   /* Set camera mirror config        */
 #define CMW_MIRRORFLIP_FLIP_MIRROR   0x03U   /* Set camera flip + mirror config */
 
+/* ISP task: interrupt running the ISP background process, pended on the VSYNC of the main pipe. By default a spare
+ * line of an unused peripheral (GPU2D) whose handler, CMW_ISP_TASK_IRQHandler, calls CMW_CAMERA_ISPTaskHandler().
+ * The exceptions of the cores (PendSV) are left to the RTOS. The ISP task waits on the sensor I2C, whose timeouts
+ * rely on HAL_GetTick(): its priority must be lower than the DCMIPP one (0x07) and lower than the tick one, i.e.
+ * TICK_INT_PRIORITY numerically below CMW_ISP_TASK_PRIORITY, otherwise the tick is frozen while the task runs.
+ * Without a default line, CMW_ISP_TASK_IRQn and CMW_ISP_TASK_IRQHandler must be defined to use
+ * CMW_CAMERA_EnableISPTask() */
+#if !defined(CMW_ISP_TASK_IRQn) && defined(STM32N657xx)
+#define CMW_ISP_TASK_IRQn            GPU2D_IRQn
+#define CMW_ISP_TASK_IRQHandler      GPU2D_IRQHandler
+#endif
+#ifndef CMW_ISP_TASK_PRIORITY
+#define CMW_ISP_TASK_PRIORITY        0x08UL
+#endif
+
 DCMIPP_HandleTypeDef* CMW_CAMERA_GetDCMIPPHandle();
 
 int32_t CMW_CAMERA_Init( CMW_CameraInit_t *init_conf );
 int32_t CMW_CAMERA_DeInit();
 int32_t CMW_CAMERA_Run();
+#if defined(CMW_ISP_TASK_IRQn)
+int32_t CMW_CAMERA_EnableISPTask(uint32_t period);
+void CMW_CAMERA_ISPTaskHandler(void);
+#endif
 int32_t CMW_CAMERA_SetPipeConfig(uint32_t pipe, DCMIPP_Conf_t *p_conf);
 
 int32_t CMW_CAMERA_Start(uint32_t pipe, uint8_t *pbuff, uint32_t Mode);
 int32_t CMW_CAMERA_DoubleBufferStart(uint32_t pipe, uint8_t *pbuff1, uint8_t *pbuff2, uint32_t Mode);
 int32_t CMW_CAMERA_Suspend(uint32_t pipe);
+int32_t CMW_CAMERA_RequestSuspend(uint32_t pipe);
+int CMW_CAMERA_IsCaptureActive(uint32_t pipe);
+int32_t CMW_CAMERA_Resume(uint32_t pipe);
+int32_t CMW_CAMERA_EnableLineEvent(uint32_t pipe, uint32_t multiline);
+int32_t CMW_CAMERA_DisableLineEvent(uint32_t pipe);
 
 
 int CMW_CAMERA_SetAntiFlickerMode(int flicker_mode);
@@ -223,6 +247,7 @@ HAL_StatusTypeDef MX_DCMIPP_ClockConfig(DCMIPP_HandleTypeDef *hdcmipp);
 
 int CMW_CAMERA_PIPE_FrameEventCallback(uint32_t pipe);
 int CMW_CAMERA_PIPE_VsyncEventCallback(uint32_t pipe);
+int CMW_CAMERA_PIPE_LineEventCallback(uint32_t pipe);
 
 #ifdef __cplusplus
 }
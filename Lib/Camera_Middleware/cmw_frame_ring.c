@@ -0,0 +1,351 @@
+/**
+ ******************************************************************************
+ * @file    cmw_frame_ring.c
+ * @author  GPM Application Team
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2024 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+
+#include "cmw_frame_ring.h"
+#include "cmw_camera.h"
+
+/* Minimum: 1 buffer captured, 1 acquired and 1 ready */
+#define CMW_FRAME_RING_MIN_BUFFERS 3
+
+static CMW_FrameRing_t *frame_rings[DCMIPP_NUM_OF_PIPES];
+
+static uint32_t CMW_FRAME_RING_EnterCritical(void)
+{
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+
+  return primask;
+}
+
+static void CMW_FRAME_RING_ExitCritical(uint32_t primask)
+{
+  __set_PRIMASK(primask);
+}
+
+/* Ready buffer with the lowest (oldest) or highest (newest) sequence number, -1 if none */
+static int32_t CMW_FRAME_RING_FindReady(const CMW_FrameRing_t *ring, int newest)
+{
+  int32_t found = -1;
+
+  for (uint32_t i = 0; i < ring->nb_buffers; i++)
+  {
+    if (ring->state[i] != CMW_FRAME_BUFFER_READY)
+    {
+      continue;
+    }
+    if (found < 0)
+    {
+      found = i;
+      continue;
+    }
+
+    int32_t diff = (int32_t)(ring->sequence[i] - ring->sequence[found]);
+    if ((newest && (diff > 0)) || (!newest && (diff < 0)))
+    {
+      found = i;
+    }
+  }
+
+  return found;
+}
+
+static int32_t CMW_FRAME_RING_FindFree(const CMW_FrameRing_t *ring)
+{
+  for (uint32_t i = 0; i < ring->nb_buffers; i++)
+  {
+    if (ring->state[i] == CMW_FRAME_BUFFER_FREE)
+    {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+/**
+  * @brief  Starts the continuous capture of a pipe into a ring of buffers.
+  * @param  ring  Ring context, owned by the middleware until stopped
+  * @param  pipe  DCMIPP Pipe, configured with CMW_CAMERA_SetPipeConfig()
+  * @param  buffers  Frame buffers, each one large enough for a frame of the pipe
+  * @param  nb_buffers  Number of buffers, from 3 to CMW_FRAME_RING_MAX_BUFFERS
+  * @param  policy  Frame drop policy
+  * @retval CMW status
+  */
+int32_t CMW_CAMERA_FrameRingStart(CMW_FrameRing_t *ring, uint32_t pipe, uint8_t **buffers, uint32_t nb_buffers,
+                                  CMW_FrameRing_Policy_t policy)
+{
+  int32_t ret;
+
+  if ((ring == NULL) || (buffers == NULL) || (pipe >= DCMIPP_NUM_OF_PIPES) ||
+      (nb_buffers < CMW_FRAME_RING_MIN_BUFFERS) || (nb_buffers > CMW_FRAME_RING_MAX_BUFFERS))
+  {
+    return CMW_ERROR_WRONG_PARAM;
+  }
+
+  if (frame_rings[pipe] != NULL)
+  {
+    return CMW_ERROR_BUSY;
+  }
+
+  ring->pipe = pipe;
+  ring->policy = policy;
+  ring->nb_buffers = nb_buffers;
+  for (uint32_t i = 0; i < nb_buffers; i++)
+  {
+    ring->buffers[i] = buffers[i];
+    ring->state[i] = CMW_FRAME_BUFFER_FREE;
+    ring->sequence[i] = 0;
+    ring->timestamp_ms[i] = 0;
+  }
+  ring->capture_index = 0;
+  ring->armed_index = 0;
+  ring->state[0] = CMW_FRAME_BUFFER_CAPTURE;
+  ring->next_sequence = 0;
+  ring->stats.captured = 0;
+  ring->stats.dropped = 0;
+  ring->stats.acquired = 0;
+  ring->stats.late = 0;
+
+  frame_rings[pipe] = ring;
+
+  /* Single address mode: the address is updated on each frame event for the next frame */
+  ret = CMW_CAMERA_Start(pipe, buffers[0], CAMERA_MODE_CONTINUOUS);
+  if (ret != CMW_ERROR_NONE)
+  {
+    frame_rings[pipe] = NULL;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Stops the capture of the pipe, frames still acquired remain valid.
+  * @param  ring  Ring context
+  * @retval CMW status
+  */
+int32_t CMW_CAMERA_FrameRingStop(CMW_FrameRing_t *ring)
+{
+  if ((ring == NULL) || (frame_rings[ring->pipe] != ring))
+  {
+    return CMW_ERROR_WRONG_PARAM;
+  }
+
+  if (HAL_DCMIPP_CSI_PIPE_Stop(CMW_CAMERA_GetDCMIPPHandle(), ring->pipe, DCMIPP_VIRTUAL_CHANNEL0) != HAL_OK)
+  {
+    return CMW_ERROR_PERIPH_FAILURE;
+  }
+
+  frame_rings[ring->pipe] = NULL;
+
+  return CMW_ERROR_NONE;
+}
+
+/**
+  * @brief  Gives a complete frame to the application, until released.
+  *         LATEST_ONLY returns the freshest frame, DROP_OLDEST the oldest one not dropped.
+  * @param  ring  Ring context
+  * @param  frame Acquired frame
+  * @retval CMW status, CMW_ERROR_BUSY if no frame is ready
+  */
+int32_t CMW_CAMERA_FrameRingAcquire(CMW_FrameRing_t *ring, CMW_Frame_t *frame)
+{
+  uint32_t primask;
+  int32_t index;
+
+  if ((ring == NULL) || (frame == NULL))
+  {
+    return CMW_ERROR_WRONG_PARAM;
+  }
+
+  primask = CMW_FRAME_RING_EnterCritical();
+  index = CMW_FRAME_RING_FindReady(ring, ring->policy == CMW_FRAME_RING_LATEST_ONLY);
+  if (index >= 0)
+  {
+    ring->state[index] = CMW_FRAME_BUFFER_ACQUIRED;
+    ring->stats.acquired++;
+    frame->buffer = ring->buffers[index];
+    frame->index = index;
+    frame->sequence = ring->sequence[index];
+    frame->timestamp_ms = ring->timestamp_ms[index];
+  }
+  CMW_FRAME_RING_ExitCritical(primask);
+
+  return (index >= 0) ? CMW_ERROR_NONE : CMW_ERROR_BUSY;
+}
+
+/**
+  * @brief  Gives back a frame returned by CMW_CAMERA_FrameRingAcquire().
+  * @param  ring  Ring context
+  * @param  frame Frame to release
+  * @retval CMW status
+  */
+int32_t CMW_CAMERA_FrameRingRelease(CMW_FrameRing_t *ring, const CMW_Frame_t *frame)
+{
+  uint32_t primask;
+  int32_t ret = CMW_ERROR_NONE;
+
+  if ((ring == NULL) || (frame == NULL) || (frame->index >= ring->nb_buffers))
+  {
+    return CMW_ERROR_WRONG_PARAM;
+  }
+
+  primask = CMW_FRAME_RING_EnterCritical();
+  if ((ring->state[frame->index] == CMW_FRAME_BUFFER_ACQUIRED) && (ring->buffers[frame->index] == frame->buffer))
+  {
+    ring->state[frame->index] = CMW_FRAME_BUFFER_FREE;
+  }
+  else
+  {
+    ret = CMW_ERROR_WRONG_PARAM;
+  }
+  CMW_FRAME_RING_ExitCritical(primask);
+
+  return ret;
+}
+
+/**
+  * @brief  Reads the counters of the ring.
+  * @param  ring  Ring context
+  * @param  stats Counters since start
+  * @retval None
+  */
+void CMW_CAMERA_FrameRingGetStats(CMW_FrameRing_t *ring, CMW_FrameRing_Stats_t *stats)
+{
+  uint32_t primask = CMW_FRAME_RING_EnterCritical();
+
+  *stats = ring->stats;
+  CMW_FRAME_RING_ExitCritical(primask);
+}
+
+/* Buffer for the next frame: a free one, else the oldest ready one (dropped), else `current` */
+static uint32_t CMW_FRAME_RING_PickNext(CMW_FrameRing_t *ring, uint32_t current)
+{
+  int32_t next = CMW_FRAME_RING_FindFree(ring);
+
+  if (next < 0)
+  {
+    next = CMW_FRAME_RING_FindReady(ring, 0);
+    if (next >= 0)
+    {
+      ring->stats.dropped++;
+    }
+  }
+  if (next < 0)
+  {
+    /* Every other buffer is acquired: the frame in `current` is overwritten, counted at its frame event */
+    next = current;
+  }
+
+  ring->state[next] = CMW_FRAME_BUFFER_CAPTURE;
+
+  return next;
+}
+
+static void CMW_FRAME_RING_Arm(CMW_FrameRing_t *ring, uint32_t index)
+{
+  ring->armed_index = index;
+  (void)HAL_DCMIPP_PIPE_SetMemoryAddress(CMW_CAMERA_GetDCMIPPHandle(), ring->pipe, DCMIPP_MEMORY_ADDRESS_0,
+                                         (uint32_t)ring->buffers[index]);
+}
+
+static void CMW_FRAME_RING_Publish(CMW_FrameRing_t *ring, uint32_t done)
+{
+  ring->state[done] = CMW_FRAME_BUFFER_READY;
+  ring->sequence[done] = ring->next_sequence++;
+  ring->timestamp_ms[done] = HAL_GetTick();
+
+  if (ring->policy == CMW_FRAME_RING_LATEST_ONLY)
+  {
+    for (uint32_t i = 0; i < ring->nb_buffers; i++)
+    {
+      if ((i != done) && (ring->state[i] == CMW_FRAME_BUFFER_READY))
+      {
+        ring->state[i] = CMW_FRAME_BUFFER_FREE;
+        ring->stats.dropped++;
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Publishes the captured frame and gives the DCMIPP a buffer for the next one.
+  *         The DCMIPP latches the memory address at the start of each frame. When the frame event is handled after
+  *         the start of the next frame, that frame goes to the buffer previously armed: if this is the buffer just
+  *         captured, the frame is dropped (it is being overwritten) and the buffer published at the next event.
+  * @param  pipe  Pipe receiving the frame event
+  * @retval None
+  */
+void CMW_FRAME_RING_FrameEventCallback(uint32_t pipe)
+{
+  CMW_FrameRing_t *ring;
+  uint32_t done;
+  uint32_t in_flight;
+  int late;
+
+  if (pipe >= DCMIPP_NUM_OF_PIPES)
+  {
+    return;
+  }
+
+  ring = frame_rings[pipe];
+  if (ring == NULL)
+  {
+    return;
+  }
+
+  done = ring->capture_index;
+  in_flight = ring->armed_index;
+  ring->stats.captured++;
+
+  /* Arm the next frame first, then check whether it has already started (with the address armed before) */
+  if (in_flight == done)
+  {
+    CMW_FRAME_RING_Arm(ring, CMW_FRAME_RING_PickNext(ring, done));
+  }
+
+  late = CMW_CAMERA_IsCaptureActive(pipe);
+  if (late)
+  {
+    ring->stats.late++;
+  }
+  else
+  {
+    in_flight = ring->armed_index;
+  }
+
+  if (in_flight == done)
+  {
+    /* Being overwritten by the frame in progress */
+    ring->stats.dropped++;
+  }
+  else
+  {
+    CMW_FRAME_RING_Publish(ring, done);
+  }
+  ring->capture_index = in_flight;
+
+  /* Late with the address already latched: arm the frame after the one in progress */
+  if (late && (ring->armed_index == in_flight))
+  {
+    CMW_FRAME_RING_Arm(ring, CMW_FRAME_RING_PickNext(ring, in_flight));
+  }
+}
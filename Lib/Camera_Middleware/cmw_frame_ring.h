@@ -0,0 +1,101 @@
+/**
+ ******************************************************************************
+ * @file    cmw_frame_ring.h
+ * @author  GPM Application Team
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2024 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef CMW_FRAME_RING_H
+#define CMW_FRAME_RING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "cmw_errno.h"
+
+/*
+ * N-buffer frame ring on a DCMIPP pipe
+ *
+ * The pipe captures continuously. At each frame event the complete buffer is published and the pipe is given a
+ * free buffer for the next frame. The buffers acquired by the application are never given back to the DCMIPP
+ * before being released, so a frame can't be overwritten while it is used (no tearing). When no buffer is free,
+ * a published frame is dropped according to the policy and its buffer reused. A frame event handled after the
+ * start of the next frame (late interrupt) drops the frame being overwritten and re-arms the pipe.
+ *
+ * Buffers: 1 being captured + 1 per frame held by the application + at least 1 to publish the next frame.
+ */
+#define CMW_FRAME_RING_MAX_BUFFERS 8
+
+typedef enum {
+  CMW_FRAME_RING_DROP_OLDEST = 0x0, /* Frames are acquired in capture order, the oldest is dropped when full */
+  CMW_FRAME_RING_LATEST_ONLY,       /* Only the freshest frame is kept, older ones are dropped when a new one is
+                                       published */
+} CMW_FrameRing_Policy_t;
+
+typedef struct {
+  uint8_t *buffer;
+  uint32_t index;        /* Buffer index in the ring, to be given back on release */
+  uint32_t sequence;     /* Frame number since start, gaps are dropped frames */
+  uint32_t timestamp_ms; /* HAL tick at the end of the capture */
+} CMW_Frame_t;
+
+typedef struct {
+  uint32_t captured;
+  uint32_t dropped;
+  uint32_t acquired;
+  uint32_t late;     /* Frame events handled after the start of the next frame */
+} CMW_FrameRing_Stats_t;
+
+typedef enum {
+  CMW_FRAME_BUFFER_FREE = 0x0,
+  CMW_FRAME_BUFFER_CAPTURE,  /* Written by the DCMIPP */
+  CMW_FRAME_BUFFER_READY,    /* Complete, waiting to be acquired */
+  CMW_FRAME_BUFFER_ACQUIRED, /* Owned by the application */
+} CMW_FrameBuffer_State_t;
+
+typedef struct {
+  uint32_t pipe;
+  CMW_FrameRing_Policy_t policy;
+  uint32_t nb_buffers;
+  uint8_t *buffers[CMW_FRAME_RING_MAX_BUFFERS];
+  volatile CMW_FrameBuffer_State_t state[CMW_FRAME_RING_MAX_BUFFERS];
+  uint32_t sequence[CMW_FRAME_RING_MAX_BUFFERS];
+  uint32_t timestamp_ms[CMW_FRAME_RING_MAX_BUFFERS];
+  uint32_t capture_index; /* Buffer of the frame in progress */
+  uint32_t armed_index;   /* Buffer in the DCMIPP address register, latched at the next frame start */
+  uint32_t next_sequence;
+  CMW_FrameRing_Stats_t stats;
+} CMW_FrameRing_t;
+
+int32_t CMW_CAMERA_FrameRingStart(CMW_FrameRing_t *ring, uint32_t pipe, uint8_t **buffers, uint32_t nb_buffers,
+                                  CMW_FrameRing_Policy_t policy);
+int32_t CMW_CAMERA_FrameRingStop(CMW_FrameRing_t *ring);
+
+int32_t CMW_CAMERA_FrameRingAcquire(CMW_FrameRing_t *ring, CMW_Frame_t *frame);
+int32_t CMW_CAMERA_FrameRingRelease(CMW_FrameRing_t *ring, const CMW_Frame_t *frame);
+
+void CMW_CAMERA_FrameRingGetStats(CMW_FrameRing_t *ring, CMW_FrameRing_Stats_t *stats);
+
+/* Called by the camera middleware on frame events (interrupt context) */
+void CMW_FRAME_RING_FrameEventCallback(uint32_t pipe);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CMW_FRAME_RING_H */
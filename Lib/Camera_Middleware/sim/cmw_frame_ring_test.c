@@ -0,0 +1,441 @@
+/**
+ ******************************************************************************
+ * @file    cmw_frame_ring_test.c
+ * @author  GPM Application Team
+ * @brief   Host test of the frame ring state machine against a model of the
+ *          DCMIPP single address mode: the memory address is latched at the
+ *          start of each frame, the frame event is handled before (in time)
+ *          or after (late) the start of the next frame. A buffer published
+ *          or acquired must never be the one written by the pipe.
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Replaces cmw_camera.h and the HAL by the pipe model below */
+#define CMW_CAMERA_H
+
+#define DCMIPP_NUM_OF_PIPES 3
+#define DCMIPP_MEMORY_ADDRESS_0 0
+#define DCMIPP_VIRTUAL_CHANNEL0 0
+#define CAMERA_MODE_CONTINUOUS 1
+
+typedef enum {
+  HAL_OK = 0,
+  HAL_ERROR,
+} HAL_StatusTypeDef;
+
+typedef struct {
+  int dummy;
+} DCMIPP_HandleTypeDef;
+
+static DCMIPP_HandleTypeDef *CMW_CAMERA_GetDCMIPPHandle(void);
+static HAL_StatusTypeDef HAL_DCMIPP_PIPE_SetMemoryAddress(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                          uint32_t MemoryAddressType, uint32_t MemoryAddress);
+static HAL_StatusTypeDef HAL_DCMIPP_CSI_PIPE_Stop(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                  uint32_t VirtualChannel);
+static int32_t CMW_CAMERA_Start(uint32_t pipe, uint8_t *pbuff, uint32_t Mode);
+static int CMW_CAMERA_IsCaptureActive(uint32_t pipe);
+static uint32_t HAL_GetTick(void);
+static uint32_t __get_PRIMASK(void);
+static void __set_PRIMASK(uint32_t primask);
+static void __disable_irq(void);
+
+/* Unit under test: included to reach its frame event with the model in place of the HAL */
+#include "cmw_frame_ring.c"
+
+#define NB_BUFFERS_MAX 5
+#define NB_FRAMES 20000
+#define PIPE 1
+
+static uint32_t nb_checks;
+static uint32_t nb_failures;
+
+#define CHECK(_cond) \
+  do \
+  { \
+    nb_checks++; \
+    if (!(_cond)) \
+    { \
+      if (nb_failures++ < 10) \
+      { \
+        printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #_cond); \
+      } \
+    } \
+  } while (0)
+
+static uint32_t seed = 0x2545F491;
+
+/* Pipe model */
+static DCMIPP_HandleTypeDef hdcmipp;
+static uint8_t frame_buffers[NB_BUFFERS_MAX][16];
+static uint32_t nb_buffers;
+static uint32_t address;   /* Memory address register */
+static int32_t writing;    /* Buffer latched by the frame in progress, -1 between frames */
+static uint32_t hw_frame;  /* Frames completed by the pipe */
+static uint32_t content[NB_BUFFERS_MAX]; /* Frame completed in each buffer, 0 while being written */
+static uint32_t tick;
+static uint32_t primask;
+
+static uint32_t rnd(void)
+{
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+
+  return seed;
+}
+
+static int32_t buffer_of(uint32_t addr)
+{
+  for (uint32_t i = 0; i < nb_buffers; i++)
+  {
+    if ((uint32_t)(uintptr_t)frame_buffers[i] == addr)
+    {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+static DCMIPP_HandleTypeDef *CMW_CAMERA_GetDCMIPPHandle(void)
+{
+  return &hdcmipp;
+}
+
+static HAL_StatusTypeDef HAL_DCMIPP_PIPE_SetMemoryAddress(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                          uint32_t MemoryAddressType, uint32_t MemoryAddress)
+{
+  CHECK(hdcmipp == CMW_CAMERA_GetDCMIPPHandle());
+  CHECK(Pipe == PIPE);
+  CHECK(MemoryAddressType == DCMIPP_MEMORY_ADDRESS_0);
+  CHECK(buffer_of(MemoryAddress) >= 0);
+  address = MemoryAddress;
+
+  return HAL_OK;
+}
+
+static HAL_StatusTypeDef HAL_DCMIPP_CSI_PIPE_Stop(DCMIPP_HandleTypeDef *hdcmipp, uint32_t Pipe,
+                                                  uint32_t VirtualChannel)
+{
+  (void)hdcmipp;
+  (void)Pipe;
+  (void)VirtualChannel;
+
+  return HAL_OK;
+}
+
+static int32_t CMW_CAMERA_Start(uint32_t pipe, uint8_t *pbuff, uint32_t Mode)
+{
+  CHECK(pipe == PIPE);
+  CHECK(Mode == CAMERA_MODE_CONTINUOUS);
+  address = (uint32_t)(uintptr_t)pbuff;
+  writing = -1;
+
+  return CMW_ERROR_NONE;
+}
+
+static int CMW_CAMERA_IsCaptureActive(uint32_t pipe)
+{
+  CHECK(pipe == PIPE);
+
+  return writing >= 0;
+}
+
+static uint32_t HAL_GetTick(void)
+{
+  return tick;
+}
+
+static uint32_t __get_PRIMASK(void)
+{
+  return primask;
+}
+
+static void __set_PRIMASK(uint32_t value)
+{
+  primask = value;
+}
+
+static void __disable_irq(void)
+{
+  primask = 1;
+}
+
+static void frame_start(void)
+{
+  writing = buffer_of(address);
+  CHECK(writing >= 0);
+  content[writing] = 0;
+}
+
+static void frame_end(void)
+{
+  content[writing] = ++hw_frame;
+  writing = -1;
+  tick++;
+}
+
+/* The buffers written or about to be written by the pipe are owned by the ring, the others hold complete frames */
+static void check_ownership(const CMW_FrameRing_t *ring)
+{
+  int32_t armed = buffer_of(address);
+
+  CHECK(armed == (int32_t)ring->armed_index);
+  CHECK(ring->state[armed] == CMW_FRAME_BUFFER_CAPTURE);
+  if (writing >= 0)
+  {
+    CHECK(writing == (int32_t)ring->capture_index);
+    CHECK(ring->state[writing] == CMW_FRAME_BUFFER_CAPTURE);
+  }
+  for (uint32_t i = 0; i < nb_buffers; i++)
+  {
+    if ((ring->state[i] == CMW_FRAME_BUFFER_READY) || (ring->state[i] == CMW_FRAME_BUFFER_ACQUIRED))
+    {
+      CHECK(content[i] != 0);
+    }
+  }
+}
+
+/* One frame period: the frame in progress completes, its event is handled before or after the next frame start */
+static void frame_period(CMW_FrameRing_t *ring, int late)
+{
+  frame_end();
+  if (late)
+  {
+    frame_start();
+    CMW_FRAME_RING_FrameEventCallback(PIPE);
+  }
+  else
+  {
+    CMW_FRAME_RING_FrameEventCallback(PIPE);
+    frame_start();
+  }
+  check_ownership(ring);
+}
+
+static void ring_start(CMW_FrameRing_t *ring, uint32_t nb, CMW_FrameRing_Policy_t policy)
+{
+  uint8_t *buffers[NB_BUFFERS_MAX];
+
+  nb_buffers = nb;
+  hw_frame = 0;
+  for (uint32_t i = 0; i < nb; i++)
+  {
+    buffers[i] = frame_buffers[i];
+    content[i] = 0;
+  }
+  CHECK(CMW_CAMERA_FrameRingStart(ring, PIPE, buffers, nb, policy) == CMW_ERROR_NONE);
+  frame_start();
+  check_ownership(ring);
+}
+
+static void ring_stop(CMW_FrameRing_t *ring)
+{
+  CHECK(CMW_CAMERA_FrameRingStop(ring) == CMW_ERROR_NONE);
+}
+
+static int acquire(CMW_FrameRing_t *ring, CMW_Frame_t *frame)
+{
+  if (CMW_CAMERA_FrameRingAcquire(ring, frame) != CMW_ERROR_NONE)
+  {
+    return 0;
+  }
+  CHECK(frame->buffer == frame_buffers[frame->index]);
+  CHECK(content[frame->index] != 0);
+  CHECK((int32_t)frame->index != writing);
+
+  return 1;
+}
+
+/* Late event while the ring is re-armed at each frame: the frame being overwritten is dropped, not published */
+static void test_late(void)
+{
+  CMW_FrameRing_t ring;
+  CMW_FrameRing_Stats_t stats;
+  CMW_Frame_t frame;
+
+  ring_start(&ring, 3, CMW_FRAME_RING_DROP_OLDEST);
+
+  /* Frame 2 started in buffer 0 before frame 1 was handled */
+  frame_period(&ring, 1);
+  CHECK(!acquire(&ring, &frame));
+  CHECK(ring.capture_index == 0);
+  CHECK(ring.armed_index != 0);
+
+  /* Handled in time: frame 2 is published, frame 3 goes to the buffer armed at the late event */
+  frame_period(&ring, 0);
+  CHECK(acquire(&ring, &frame));
+  CHECK(frame.index == 0);
+  CHECK(content[0] == 2);
+  CHECK(frame.sequence == 0);
+  CHECK(CMW_CAMERA_FrameRingRelease(&ring, &frame) == CMW_ERROR_NONE);
+
+  /* Late events in a row: with a buffer armed ahead of the frame in progress, only the first one loses a frame */
+  frame_period(&ring, 1);
+  CHECK(!acquire(&ring, &frame));
+  for (uint32_t i = 0; i < 3; i++)
+  {
+    frame_period(&ring, i < 2);
+    CHECK(acquire(&ring, &frame));
+    CHECK(frame.sequence == 1 + i);
+    CHECK(content[frame.index] == 4 + i);
+    CHECK(CMW_CAMERA_FrameRingRelease(&ring, &frame) == CMW_ERROR_NONE);
+  }
+
+  CMW_CAMERA_FrameRingGetStats(&ring, &stats);
+  CHECK(stats.captured == 6);
+  CHECK(stats.late == 4);
+  CHECK(stats.dropped == 2);
+  CHECK(stats.acquired == 4);
+
+  ring_stop(&ring);
+}
+
+/* All the other buffers acquired: the pipe keeps writing the same buffer, nothing is published until a release */
+static void test_all_acquired(int late)
+{
+  CMW_FrameRing_t ring;
+  CMW_FrameRing_Stats_t stats;
+  CMW_Frame_t held[2];
+  CMW_Frame_t frame;
+
+  ring_start(&ring, 3, CMW_FRAME_RING_DROP_OLDEST);
+
+  frame_period(&ring, 0);
+  CHECK(acquire(&ring, &held[0]));
+  frame_period(&ring, 0);
+  CHECK(acquire(&ring, &held[1]));
+
+  for (int i = 0; i < 4; i++)
+  {
+    frame_period(&ring, late);
+    CHECK(!acquire(&ring, &frame));
+    CHECK(ring.capture_index == ring.armed_index);
+  }
+  CHECK(content[held[0].index] == 1);
+  CHECK(content[held[1].index] == 2);
+
+  CHECK(CMW_CAMERA_FrameRingRelease(&ring, &held[0]) == CMW_ERROR_NONE);
+  frame_period(&ring, late);
+  if (late)
+  {
+    /* The released buffer is armed for the frame after the one in progress: while late, the pipe holds two
+     * buffers and the remaining one is still acquired, back in time the frame can be published */
+    CHECK(!acquire(&ring, &frame));
+    CHECK(ring.armed_index == held[0].index);
+    frame_period(&ring, 0);
+  }
+  CHECK(acquire(&ring, &frame));
+  CHECK(content[frame.index] == hw_frame);
+  CHECK(CMW_CAMERA_FrameRingRelease(&ring, &frame) == CMW_ERROR_NONE);
+  CHECK(CMW_CAMERA_FrameRingRelease(&ring, &held[1]) == CMW_ERROR_NONE);
+
+  CMW_CAMERA_FrameRingGetStats(&ring, &stats);
+  CHECK(stats.dropped == (late ? 5 : 4));
+
+  ring_stop(&ring);
+}
+
+/* Random late events, hold times and buffer counts: ownership, frame order and counters stay consistent */
+static void test_random(CMW_FrameRing_Policy_t policy)
+{
+  for (uint32_t nb = 3; nb <= NB_BUFFERS_MAX; nb++)
+  {
+    CMW_FrameRing_t ring;
+    CMW_FrameRing_Stats_t stats;
+    CMW_Frame_t held[NB_BUFFERS_MAX];
+    uint32_t held_content[NB_BUFFERS_MAX];
+    uint32_t nb_held = 0;
+    uint32_t nb_late = 0;
+    uint32_t nb_acquired = 0;
+    uint32_t last_sequence = 0;
+    uint32_t last_frame = 0;
+
+    ring_start(&ring, nb, policy);
+
+    for (uint32_t f = 0; f < NB_FRAMES; f++)
+    {
+      int late = (rnd() % 4) == 0;
+
+      nb_late += late;
+      frame_period(&ring, late);
+
+      /* Hold up to all buffers but the ones of the pipe */
+      if ((nb_held < nb - 1) && (rnd() % 2))
+      {
+        CMW_Frame_t *frame = &held[nb_held];
+
+        if (acquire(&ring, frame))
+        {
+          CHECK((nb_acquired == 0) || (frame->sequence > last_sequence));
+          CHECK(content[frame->index] > last_frame);
+          if (policy == CMW_FRAME_RING_LATEST_ONLY)
+          {
+            CHECK(CMW_FRAME_RING_FindReady(&ring, 0) < 0);
+          }
+          last_sequence = frame->sequence;
+          last_frame = content[frame->index];
+          held_content[nb_held] = content[frame->index];
+          nb_held++;
+          nb_acquired++;
+        }
+      }
+      if ((nb_held > 0) && ((rnd() % 3) == 0))
+      {
+        uint32_t i = rnd() % nb_held;
+
+        /* Not overwritten while held */
+        CHECK(content[held[i].index] == held_content[i]);
+        CHECK(CMW_CAMERA_FrameRingRelease(&ring, &held[i]) == CMW_ERROR_NONE);
+        CHECK(CMW_CAMERA_FrameRingRelease(&ring, &held[i]) == CMW_ERROR_WRONG_PARAM);
+        nb_held--;
+        held[i] = held[nb_held];
+        held_content[i] = held_content[nb_held];
+      }
+    }
+
+    CMW_CAMERA_FrameRingGetStats(&ring, &stats);
+    CHECK(stats.captured == NB_FRAMES);
+    CHECK(stats.late == nb_late);
+    CHECK(stats.acquired == nb_acquired);
+    CHECK(stats.dropped < NB_FRAMES);
+    CHECK(nb_acquired > NB_FRAMES / 8);
+
+    /* Every frame captured is acquired, still ready or dropped */
+    uint32_t nb_ready = 0;
+    for (uint32_t i = 0; i < nb; i++)
+    {
+      nb_ready += ring.state[i] == CMW_FRAME_BUFFER_READY;
+    }
+    CHECK(stats.dropped + nb_acquired + nb_ready == NB_FRAMES);
+
+    ring_stop(&ring);
+  }
+}
+
+int main(void)
+{
+  test_late();
+  test_all_acquired(0);
+  test_all_acquired(1);
+  test_random(CMW_FRAME_RING_DROP_OLDEST);
+  test_random(CMW_FRAME_RING_LATEST_ONLY);
+
+  printf("cmw_frame_ring_test: %u checks, %u failures\n", nb_checks, nb_failures);
+
+  return nb_failures ? 1 : 0;
+}
@@ -16,10 +16,12 @@
 #endif
 
 #include "arm_math.h"
+#include "objdetect_pp_output_if.h"
 
 #ifdef ARM_MATH_MVEF
 #define AI_YOLOV5_PP_MVEF_OPTIM
 #define AI_YOLOV8_PP_MVEF_OPTIM
+#define AI_OBJDETECT_PP_MVEF_OPTIM
 #endif
 #ifdef ARM_MATH_MVEI
 #define AI_YOLOV5_PP_MVEI_OPTIM
@@ -51,9 +53,30 @@ extern void objdetect_maxi_transpose_int8_large(int8_t *arr, int32_t len_arr, in
 extern float32_t objdetect_sigmoid_f(float32_t x);
 extern void objdetect_softmax_f(float32_t *input_x, float32_t *output_x, int32_t len_x, float32_t *tmp_x);
 extern float32_t objdetect_box_iou(float32_t *a, float32_t *b);
+
+/* Structure-of-arrays box store used by NMS: corners and area are precomputed once per box */
+typedef struct objdetect_pp_soa
+{
+  float32_t *pX1;
+  float32_t *pY1;
+  float32_t *pX2;
+  float32_t *pY2;
+  float32_t *pArea;
+  int32_t   nb;
+} objdetect_pp_soa_t;
+
+extern uint32_t objdetect_box_iou_above_x4(const objdetect_pp_soa_t *pSoa, int32_t i, int32_t j, float32_t iou_threshold);
 extern void transpose_flattened_2D(float32_t *arr, int32_t rows, int32_t cols, float32_t *tmp_x);
 extern void dequantize(int32_t* arr, float32_t* tmp, int32_t n, int32_t zero_point, float32_t scale);
 
+/* Shared NMS engine (objdetect_pp_nms.c) */
+extern void objdetect_sort_index_desc(const float32_t *pScores, int32_t score_stride, int32_t *pIndex, int32_t nb);
+extern int32_t objdetect_nms_bucketed(postprocess_outBuffer_t *pBoxes, int32_t nb_boxes, int32_t nb_classes,
+                                      float32_t iou_threshold, int32_t max_boxes_limit, int32_t *pScratch);
+extern int32_t objdetect_nms_single_class(float32_t *pScores, int32_t score_stride, float32_t *pBoxes, int32_t box_stride,
+                                          int32_t nb_boxes, float32_t conf_threshold, float32_t iou_threshold,
+                                          int32_t max_boxes_limit, int32_t *pScratch);
+
 
 /*-----------------------------     YOLO_V2      -----------------------------*/
 /* Offsets to access YoloV2 input data */
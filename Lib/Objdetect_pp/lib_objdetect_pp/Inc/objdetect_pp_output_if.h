@@ -18,6 +18,12 @@
 #include "arm_math.h"
 
 
+/* Maximum number of same class candidates handled by the vectorised NMS, larger sets use the scalar path */
+#ifndef AI_OBJDETECT_PP_NMS_SOA_MAX
+#define AI_OBJDETECT_PP_NMS_SOA_MAX                         (128)
+#endif
+#define AI_OBJDETECT_PP_NMS_SOA_SCRATCH_SIZE                (5 * AI_OBJDETECT_PP_NMS_SOA_MAX)
+
 /* Error return codes */
 #define AI_OBJDETECT_POSTPROCESS_ERROR_NO                    (0)
 #define AI_OBJDETECT_POSTPROCESS_ERROR_BAD_HW                (-1)
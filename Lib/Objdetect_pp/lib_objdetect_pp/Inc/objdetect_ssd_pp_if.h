@@ -29,6 +29,9 @@ typedef struct ssd_pp_in_centroid
 
 /* Generic Static parameters */
 /* ------------------------- */
+/* Size in int32_t words of the optional per instance scratch buffer (pScratch) */
+#define AI_OBJDETECT_SSD_PP_SCRATCH_SIZE(nb_detections) (AI_OBJDETECT_PP_NMS_SOA_SCRATCH_SIZE + (nb_detections))
+
 typedef struct ssd_pp_static_param
 {
 	int32_t   nb_classes;
@@ -39,6 +42,7 @@ typedef struct ssd_pp_static_param
 	float32_t	conf_threshold;
 	float32_t	iou_threshold;
 	int32_t   nb_detect;
+	int32_t   *pScratch;
 } ssd_pp_static_param_t;
 
 
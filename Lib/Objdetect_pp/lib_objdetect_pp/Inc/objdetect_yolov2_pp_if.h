@@ -35,6 +35,9 @@ typedef enum yolov2_pp_optim {
 } yolov2_pp_optim_e;
 
 
+/* Size in int32_t words of the optional per instance scratch buffer (pScratch) */
+#define AI_OBJDETECT_YOLOV2_PP_SCRATCH_SIZE(nb_input_boxes, nb_anchors) (AI_OBJDETECT_PP_NMS_SOA_SCRATCH_SIZE + (nb_input_boxes) * (nb_anchors))
+
 typedef struct yolov2_pp_static_param {
   int32_t  nb_classes;
   int32_t  nb_anchors;
@@ -47,6 +50,7 @@ typedef struct yolov2_pp_static_param {
   const float32_t	*pAnchors;
   yolov2_pp_optim_e optim;
   int32_t nb_detect;
+  int32_t *pScratch;
 } yolov2_pp_static_param_t;
 
 
@@ -31,6 +31,9 @@ typedef struct yolov5_pp_in_centroid_uint8
 } yolov5_pp_in_centroid_uint8_t;
 
 
+/* Size in int32_t words of the optional per instance scratch buffer (pScratch) */
+#define AI_OBJDETECT_YOLOV5_PP_SCRATCH_SIZE(nb_classes) (AI_OBJDETECT_PP_NMS_SOA_SCRATCH_SIZE + 2 * (nb_classes) + 1)
+
 typedef struct yolov5_pp_static_param {
   int32_t  nb_classes;
   int32_t  nb_total_boxes;
@@ -40,6 +43,7 @@ typedef struct yolov5_pp_static_param {
   float32_t raw_output_scale;
   uint8_t raw_output_zero_point;
   int32_t nb_detect;
+  int32_t *pScratch;
 } yolov5_pp_static_param_t;
 
 
@@ -81,6 +85,51 @@ int32_t objdetect_yolov5_pp_process_uint8(yolov5_pp_in_centroid_uint8_t *pInput,
                                          postprocess_out_t *pOutput,
                                          yolov5_pp_static_param_t *pInput_static_param);
 
+
+/*!
+ * @brief Streaming object detector post processing : output detector remapping
+ *        of one output head of YoloV5, so that decoding starts as soon as the head
+ *        has been produced. objdetect_yolov5_pp_reset() must be called before the
+ *        first head of a frame, and objdetect_yolov5_pp_process_heads_end() after the last one.
+ *
+ * @param [IN] Pointer on input data of the head
+ *             Number of boxes of the head
+ *             Pointer on output data
+ *             pointer on static parameters
+ * @retval Error code
+ */
+int32_t objdetect_yolov5_pp_process_head(yolov5_pp_in_centroid_t *pInput,
+                                         int32_t nb_head_boxes,
+                                         postprocess_out_t *pOutput,
+                                         yolov5_pp_static_param_t *pInput_static_param);
+
+
+/*!
+ * @brief Same as objdetect_yolov5_pp_process_head() with 8-bits quantized inputs.
+ *
+ * @param [IN] Pointer on input data of the head
+ *             Number of boxes of the head
+ *             Pointer on output data
+ *             pointer on static parameters
+ * @retval Error code
+ */
+int32_t objdetect_yolov5_pp_process_head_uint8(yolov5_pp_in_centroid_uint8_t *pInput,
+                                               int32_t nb_head_boxes,
+                                               postprocess_out_t *pOutput,
+                                               yolov5_pp_static_param_t *pInput_static_param);
+
+
+/*!
+ * @brief Streaming object detector post processing : nms and score filtering
+ *        over the detections of all the heads given to objdetect_yolov5_pp_process_head().
+ *
+ * @param [IN] Pointer on output data
+ *             pointer on static parameters
+ * @retval Error code
+ */
+int32_t objdetect_yolov5_pp_process_heads_end(postprocess_out_t *pOutput,
+                                              yolov5_pp_static_param_t *pInput_static_param);
+
 #endif      /* __OBJDETECT_YOLOV5_PP_IF_H__  */
 
 
@@ -31,6 +31,12 @@ typedef struct yolov8_pp_in_centroid_int8
 } yolov8_pp_in_centroid_int8_t;
 
 
+/* Size in int32_t words of the optional per instance scratch buffer (pScratch) */
+#define AI_OBJDETECT_YOLOV8_PP_NMS_SCRATCH_SIZE(nb_classes) (AI_OBJDETECT_PP_NMS_SOA_SCRATCH_SIZE + 2 * (nb_classes) + 1)
+#define AI_OBJDETECT_YOLOV8_PP_SCRATCH_SIZE(nb_classes, max_candidates) \
+  ((AI_OBJDETECT_YOLOV8_PP_NMS_SCRATCH_SIZE(nb_classes) > 2 * (max_candidates)) ? \
+   AI_OBJDETECT_YOLOV8_PP_NMS_SCRATCH_SIZE(nb_classes) : 2 * (max_candidates))
+
 typedef struct yolov8_pp_static_param {
   int32_t  nb_classes;
   int32_t  nb_total_boxes;
@@ -40,6 +46,8 @@ typedef struct yolov8_pp_static_param {
   float32_t raw_output_scale;
   int8_t raw_output_zero_point;
   int32_t nb_detect;
+  int32_t *pScratch;
+  int32_t max_candidates;
 } yolov8_pp_static_param_t;
 
 
@@ -416,6 +416,55 @@ float32_t objdetect_box_iou(float32_t *a, float32_t *b)
 }
 
 
+/* Tests box i against boxes [j, j + 4) of the store: bit k is set when IoU(i, j + k) > iou_threshold.
+   IoU is compared as I > threshold * U to avoid the division. */
+#ifdef AI_OBJDETECT_PP_MVEF_OPTIM
+uint32_t objdetect_box_iou_above_x4(const objdetect_pp_soa_t *pSoa, int32_t i, int32_t j, float32_t iou_threshold)
+{
+    mve_pred16_t p = vctp32q(pSoa->nb - j);
+
+    float32x4_t f32x4_left = vmaxnmq_f32(vldrwq_z_f32(&pSoa->pX1[j], p), vdupq_n_f32(pSoa->pX1[i]));
+    float32x4_t f32x4_right = vminnmq_f32(vldrwq_z_f32(&pSoa->pX2[j], p), vdupq_n_f32(pSoa->pX2[i]));
+    float32x4_t f32x4_top = vmaxnmq_f32(vldrwq_z_f32(&pSoa->pY1[j], p), vdupq_n_f32(pSoa->pY1[i]));
+    float32x4_t f32x4_bottom = vminnmq_f32(vldrwq_z_f32(&pSoa->pY2[j], p), vdupq_n_f32(pSoa->pY2[i]));
+    float32x4_t f32x4_w = vsubq_f32(f32x4_right, f32x4_left);
+    float32x4_t f32x4_h = vsubq_f32(f32x4_bottom, f32x4_top);
+
+    // disjoint boxes have a null intersection
+    mve_pred16_t p0 = vcmpgeq_m_n_f32(f32x4_w, 0.0f, p);
+    p0 = vcmpgeq_m_n_f32(f32x4_h, 0.0f, p0);
+
+    float32x4_t f32x4_inter = vmulq_f32(f32x4_w, f32x4_h);
+    float32x4_t f32x4_union = vsubq_f32(vaddq_f32(vdupq_n_f32(pSoa->pArea[i]), vldrwq_z_f32(&pSoa->pArea[j], p)),
+                                        f32x4_inter);
+    p0 = vcmpgtq_m_f32(f32x4_inter, vmulq_n_f32(f32x4_union, iou_threshold), p0);
+
+    // one predicate bit per byte: keep the first bit of each 32-bit lane
+    return ((p0 >> 0) & 1) | ((p0 >> 3) & 2) | ((p0 >> 6) & 4) | ((p0 >> 9) & 8);
+}
+#else
+uint32_t objdetect_box_iou_above_x4(const objdetect_pp_soa_t *pSoa, int32_t i, int32_t j, float32_t iou_threshold)
+{
+    uint32_t mask = 0;
+    int32_t nb = MIN(pSoa->nb - j, 4);
+
+    for (int32_t k = 0; k < nb; k++)
+    {
+        float32_t w = MIN(pSoa->pX2[i], pSoa->pX2[j + k]) - MAX(pSoa->pX1[i], pSoa->pX1[j + k]);
+        float32_t h = MIN(pSoa->pY2[i], pSoa->pY2[j + k]) - MAX(pSoa->pY1[i], pSoa->pY1[j + k]);
+        if (w < 0 || h < 0) continue;
+        float32_t inter = w * h;
+        float32_t uni = pSoa->pArea[i] + pSoa->pArea[j + k] - inter;
+        if (inter > iou_threshold * uni)
+        {
+            mask |= (1U << k);
+        }
+    }
+    return (mask);
+}
+#endif
+
+
 void transpose_flattened_2D(float32_t *arr, int32_t rows, int32_t cols, float32_t *tmp_x)
 {
     int32_t i, j, k;
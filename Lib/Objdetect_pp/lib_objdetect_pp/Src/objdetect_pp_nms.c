@@ -0,0 +1,524 @@
+/*---------------------------------------------------------------------------------------------
+ * Copyright (c) 2023 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *--------------------------------------------------------------------------------------------*/
+
+#include "objdetect_pp_loc.h"
+
+
+/* Below this size an insertion sort beats the heap sort */
+#define AI_OBJDETECT_NMS_INSERTION_SORT_MAX   (16)
+
+
+static void objdetect_nms_soa_init(objdetect_pp_soa_t *pSoa,
+                                   float32_t *pBuffer)
+{
+    pSoa->pX1 = &pBuffer[0 * AI_OBJDETECT_PP_NMS_SOA_MAX];
+    pSoa->pY1 = &pBuffer[1 * AI_OBJDETECT_PP_NMS_SOA_MAX];
+    pSoa->pX2 = &pBuffer[2 * AI_OBJDETECT_PP_NMS_SOA_MAX];
+    pSoa->pY2 = &pBuffer[3 * AI_OBJDETECT_PP_NMS_SOA_MAX];
+    pSoa->pArea = &pBuffer[4 * AI_OBJDETECT_PP_NMS_SOA_MAX];
+    pSoa->nb = 0;
+}
+
+
+/* Boxes are given as centre and size: a[0], a[1], a[2], a[3] as expected by objdetect_box_iou */
+static inline void objdetect_nms_soa_push(objdetect_pp_soa_t *pSoa,
+                                          const float32_t *a)
+{
+    pSoa->pX1[pSoa->nb] = a[0] - a[2] / 2;
+    pSoa->pY1[pSoa->nb] = a[1] - a[3] / 2;
+    pSoa->pX2[pSoa->nb] = a[0] + a[2] / 2;
+    pSoa->pY2[pSoa->nb] = a[1] + a[3] / 2;
+    pSoa->pArea[pSoa->nb] = a[2] * a[3];
+    pSoa->nb++;
+}
+
+
+static inline void objdetect_nms_swap(postprocess_outBuffer_t *pA,
+                                      postprocess_outBuffer_t *pB)
+{
+    postprocess_outBuffer_t tmp = *pA;
+    *pA = *pB;
+    *pB = tmp;
+}
+
+
+/* Min-heap on conf: the heap sort below then leaves the buffer in descending order */
+static void objdetect_nms_sift_down(postprocess_outBuffer_t *pBoxes,
+                                    int32_t root,
+                                    int32_t len)
+{
+    for (;;)
+    {
+        int32_t child = 2 * root + 1;
+        if (child >= len) break;
+        if ((child + 1 < len) && (pBoxes[child + 1].conf < pBoxes[child].conf))
+        {
+            child++;
+        }
+        if (pBoxes[root].conf <= pBoxes[child].conf) break;
+        objdetect_nms_swap(&pBoxes[root], &pBoxes[child]);
+        root = child;
+    }
+}
+
+
+/* Non-recursive sort by descending confidence */
+static void objdetect_nms_sort_desc(postprocess_outBuffer_t *pBoxes,
+                                    int32_t len)
+{
+    if (len <= AI_OBJDETECT_NMS_INSERTION_SORT_MAX)
+    {
+        for (int32_t i = 1; i < len; i++)
+        {
+            postprocess_outBuffer_t tmp = pBoxes[i];
+            int32_t j = i - 1;
+            while ((j >= 0) && (pBoxes[j].conf < tmp.conf))
+            {
+                pBoxes[j + 1] = pBoxes[j];
+                j--;
+            }
+            pBoxes[j + 1] = tmp;
+        }
+        return;
+    }
+
+    for (int32_t i = len / 2 - 1; i >= 0; i--)
+    {
+        objdetect_nms_sift_down(pBoxes, i, len);
+    }
+    for (int32_t end = len - 1; end > 0; end--)
+    {
+        objdetect_nms_swap(&pBoxes[0], &pBoxes[end]);
+        objdetect_nms_sift_down(pBoxes, 0, end);
+    }
+}
+
+
+/* Max-heap on (class, -conf): the heap sort below then leaves the classes contiguous, by descending conf */
+static inline int32_t objdetect_nms_after(const postprocess_outBuffer_t *pA,
+                                          const postprocess_outBuffer_t *pB)
+{
+    return (pA->class_index > pB->class_index) ||
+           ((pA->class_index == pB->class_index) && (pA->conf < pB->conf));
+}
+
+
+static void objdetect_nms_sift_down_class(postprocess_outBuffer_t *pBoxes,
+                                          int32_t root,
+                                          int32_t len)
+{
+    for (;;)
+    {
+        int32_t child = 2 * root + 1;
+        if (child >= len) break;
+        if ((child + 1 < len) && objdetect_nms_after(&pBoxes[child + 1], &pBoxes[child]))
+        {
+            child++;
+        }
+        if (!objdetect_nms_after(&pBoxes[child], &pBoxes[root])) break;
+        objdetect_nms_swap(&pBoxes[root], &pBoxes[child]);
+        root = child;
+    }
+}
+
+
+/* In place sort by class, then descending confidence: the buckets without scratch */
+static void objdetect_nms_sort_class_desc(postprocess_outBuffer_t *pBoxes,
+                                          int32_t len)
+{
+    for (int32_t i = len / 2 - 1; i >= 0; i--)
+    {
+        objdetect_nms_sift_down_class(pBoxes, i, len);
+    }
+    for (int32_t end = len - 1; end > 0; end--)
+    {
+        objdetect_nms_swap(&pBoxes[0], &pBoxes[end]);
+        objdetect_nms_sift_down_class(pBoxes, 0, end);
+    }
+}
+
+
+/* Pairwise suppression and limit of a bucket sorted by descending confidence */
+static void objdetect_nms_suppress_scalar(postprocess_outBuffer_t *pBucket,
+                                          int32_t len,
+                                          float32_t iou_threshold,
+                                          int32_t max_boxes_limit)
+{
+    int32_t limit_counter = 0;
+
+    for (int32_t i = 0; i < len; i++)
+    {
+        if (pBucket[i].conf == 0) continue;
+        float32_t *a = &(pBucket[i].x_center);
+        for (int32_t j = i + 1; j < len; j++)
+        {
+            if (pBucket[j].conf == 0) continue;
+            float32_t *b = &(pBucket[j].x_center);
+            if (objdetect_box_iou(a, b) > iou_threshold)
+            {
+                pBucket[j].conf = 0;
+            }
+        }
+    }
+
+    /* Limits detections count */
+    for (int32_t i = 0; i < len; i++)
+    {
+        if ((limit_counter < max_boxes_limit) && (pBucket[i].conf != 0))
+        {
+            limit_counter++;
+        }
+        else
+        {
+            pBucket[i].conf = 0;
+        }
+    }
+}
+
+
+/* Without scratch: one sort of the whole buffer by class and confidence, then scalar suppression per class */
+static int32_t objdetect_nms_bucketed_noscratch(postprocess_outBuffer_t *pBoxes,
+                                                int32_t nb_boxes,
+                                                int32_t nb_classes,
+                                                float32_t iou_threshold,
+                                                int32_t max_boxes_limit)
+{
+    for (int32_t i = 0; i < nb_boxes; i++)
+    {
+        int32_t c = pBoxes[i].class_index;
+        if ((c < 0) || (c >= nb_classes)) return (AI_OBJDETECT_POSTPROCESS_ERROR);
+    }
+
+    objdetect_nms_sort_class_desc(pBoxes, nb_boxes);
+
+    for (int32_t start = 0; start < nb_boxes; )
+    {
+        int32_t end = start + 1;
+        while ((end < nb_boxes) && (pBoxes[end].class_index == pBoxes[start].class_index))
+        {
+            end++;
+        }
+        objdetect_nms_suppress_scalar(&pBoxes[start], end - start, iou_threshold, max_boxes_limit);
+        start = end;
+    }
+
+    return (AI_OBJDETECT_POSTPROCESS_ERROR_NO);
+}
+
+
+static void objdetect_nms_sift_down_index(const float32_t *pScores,
+                                          int32_t score_stride,
+                                          int32_t *pIndex,
+                                          int32_t root,
+                                          int32_t len)
+{
+    for (;;)
+    {
+        int32_t child = 2 * root + 1;
+        if (child >= len) break;
+        if ((child + 1 < len) &&
+            (pScores[pIndex[child + 1] * score_stride] < pScores[pIndex[child] * score_stride]))
+        {
+            child++;
+        }
+        if (pScores[pIndex[root] * score_stride] <= pScores[pIndex[child] * score_stride]) break;
+        int32_t tmp = pIndex[root];
+        pIndex[root] = pIndex[child];
+        pIndex[child] = tmp;
+        root = child;
+    }
+}
+
+
+void objdetect_sort_index_desc(const float32_t *pScores,
+                               int32_t score_stride,
+                               int32_t *pIndex,
+                               int32_t nb)
+{
+    for (int32_t i = nb / 2 - 1; i >= 0; i--)
+    {
+        objdetect_nms_sift_down_index(pScores, score_stride, pIndex, i, nb);
+    }
+    for (int32_t end = nb - 1; end > 0; end--)
+    {
+        int32_t tmp = pIndex[0];
+        pIndex[0] = pIndex[end];
+        pIndex[end] = tmp;
+        objdetect_nms_sift_down_index(pScores, score_stride, pIndex, 0, end);
+    }
+}
+
+
+int32_t objdetect_nms_bucketed(postprocess_outBuffer_t *pBoxes,
+                               int32_t nb_boxes,
+                               int32_t nb_classes,
+                               float32_t iou_threshold,
+                               int32_t max_boxes_limit,
+                               int32_t *pScratch)
+{
+    objdetect_pp_soa_t soa;
+    int32_t *bucket_start;
+    int32_t *bucket_fill;
+
+    if (nb_boxes <= 0) return (AI_OBJDETECT_POSTPROCESS_ERROR_NO);
+    if (pScratch == NULL)
+    {
+        return objdetect_nms_bucketed_noscratch(pBoxes, nb_boxes, nb_classes, iou_threshold, max_boxes_limit);
+    }
+
+    bucket_start = &pScratch[AI_OBJDETECT_PP_NMS_SOA_SCRATCH_SIZE];
+    bucket_fill = &bucket_start[nb_classes + 1];
+    objdetect_nms_soa_init(&soa, (float32_t *)pScratch);
+
+    /* Counts detections per class */
+    memset(bucket_start, 0, (nb_classes + 1) * sizeof(*bucket_start));
+    for (int32_t i = 0; i < nb_boxes; i++)
+    {
+        int32_t c = pBoxes[i].class_index;
+        if ((c < 0) || (c >= nb_classes)) return (AI_OBJDETECT_POSTPROCESS_ERROR);
+        bucket_start[c + 1]++;
+    }
+    for (int32_t k = 0; k < nb_classes; k++)
+    {
+        bucket_start[k + 1] += bucket_start[k];
+        bucket_fill[k] = bucket_start[k];
+    }
+
+    /* In-place permutation: every swap moves one detection to its final bucket */
+    for (int32_t k = 0; k < nb_classes; k++)
+    {
+        while (bucket_fill[k] < bucket_start[k + 1])
+        {
+            int32_t c = pBoxes[bucket_fill[k]].class_index;
+            if (c == k)
+            {
+                bucket_fill[k]++;
+            }
+            else
+            {
+                objdetect_nms_swap(&pBoxes[bucket_fill[k]], &pBoxes[bucket_fill[c]]);
+                bucket_fill[c]++;
+            }
+        }
+    }
+
+    for (int32_t k = 0; k < nb_classes; k++)
+    {
+        postprocess_outBuffer_t *pBucket = &pBoxes[bucket_start[k]];
+        int32_t len = bucket_start[k + 1] - bucket_start[k];
+        int32_t limit_counter = 0;
+
+        if (len == 0) continue;
+
+        objdetect_nms_sort_desc(pBucket, len);
+
+        if (len > AI_OBJDETECT_PP_NMS_SOA_MAX)
+        {
+            objdetect_nms_suppress_scalar(pBucket, len, iou_threshold, max_boxes_limit);
+            continue;
+        }
+
+        soa.nb = 0;
+        for (int32_t i = 0; i < len; i++)
+        {
+            objdetect_nms_soa_push(&soa, &(pBucket[i].x_center));
+        }
+        for (int32_t i = 0; i < len; i++)
+        {
+            if (pBucket[i].conf == 0) continue;
+            for (int32_t j = i + 1; j < len; j += 4)
+            {
+                uint32_t mask = objdetect_box_iou_above_x4(&soa, i, j, iou_threshold);
+                for (int32_t l = 0; mask != 0; l++, mask >>= 1)
+                {
+                    if (mask & 1) pBucket[j + l].conf = 0;
+                }
+            }
+        }
+
+        /* Limits detections count */
+        for (int32_t i = 0; i < len; i++)
+        {
+            if ((limit_counter < max_boxes_limit) && (pBucket[i].conf != 0))
+            {
+                limit_counter++;
+            }
+            else
+            {
+                pBucket[i].conf = 0;
+            }
+        }
+    }
+
+    return (AI_OBJDETECT_POSTPROCESS_ERROR_NO);
+}
+
+
+/* Candidate i comes after candidate ref in the processing order: descending score, then ascending index */
+static inline int32_t objdetect_nms_is_after(float32_t score, int32_t i, float32_t ref_score, int32_t ref)
+{
+    return (score < ref_score) || ((score == ref_score) && (i > ref));
+}
+
+
+/* Without scratch: the candidates are visited in the same order as the sorted index, by selecting the next one at
+ * each step. No index buffer, quadratic in the number of kept boxes. */
+static int32_t objdetect_nms_single_class_noscratch(float32_t *pScores,
+                                                    int32_t score_stride,
+                                                    float32_t *pBoxes,
+                                                    int32_t box_stride,
+                                                    int32_t nb_boxes,
+                                                    float32_t conf_threshold,
+                                                    float32_t iou_threshold,
+                                                    int32_t max_boxes_limit)
+{
+    int32_t limit_counter = 0;
+    int32_t prev = -1;
+    float32_t prev_score = 0;
+
+    for (;;)
+    {
+        int32_t best = -1;
+        float32_t best_score = 0;
+
+        for (int32_t i = 0; i < nb_boxes; i++)
+        {
+            float32_t score = pScores[i * score_stride];
+            if ((score < conf_threshold) || (score == 0)) continue;
+            if ((prev >= 0) && !objdetect_nms_is_after(score, i, prev_score, prev)) continue;
+            if ((best < 0) || (score > best_score))
+            {
+                best = i;
+                best_score = score;
+            }
+        }
+        if (best < 0) break;
+
+        /* Limits detections count: the remaining candidates are all dropped */
+        if (limit_counter >= max_boxes_limit)
+        {
+            for (int32_t i = 0; i < nb_boxes; i++)
+            {
+                float32_t score = pScores[i * score_stride];
+                if ((score >= conf_threshold) && ((i == best) || objdetect_nms_is_after(score, i, best_score, best)))
+                {
+                    pScores[i * score_stride] = 0;
+                }
+            }
+            break;
+        }
+        limit_counter++;
+
+        float32_t *pA = &pBoxes[best * box_stride];
+        for (int32_t j = 0; j < nb_boxes; j++)
+        {
+            float32_t score = pScores[j * score_stride];
+            if ((score < conf_threshold) || (score == 0)) continue;
+            if (!objdetect_nms_is_after(score, j, best_score, best)) continue;
+            if (objdetect_box_iou(pA, &pBoxes[j * box_stride]) > iou_threshold)
+            {
+                pScores[j * score_stride] = 0;
+            }
+        }
+        prev = best;
+        prev_score = best_score;
+    }
+
+    return (AI_OBJDETECT_POSTPROCESS_ERROR_NO);
+}
+
+
+int32_t objdetect_nms_single_class(float32_t *pScores,
+                                   int32_t score_stride,
+                                   float32_t *pBoxes,
+                                   int32_t box_stride,
+                                   int32_t nb_boxes,
+                                   float32_t conf_threshold,
+                                   float32_t iou_threshold,
+                                   int32_t max_boxes_limit,
+                                   int32_t *pScratch)
+{
+    objdetect_pp_soa_t soa;
+    int32_t *pIndex;
+    int32_t nb_candidates = 0;
+    int32_t limit_counter = 0;
+
+    if (pScratch == NULL)
+    {
+        return objdetect_nms_single_class_noscratch(pScores, score_stride, pBoxes, box_stride, nb_boxes,
+                                                    conf_threshold, iou_threshold, max_boxes_limit);
+    }
+
+    pIndex = &pScratch[AI_OBJDETECT_PP_NMS_SOA_SCRATCH_SIZE];
+    objdetect_nms_soa_init(&soa, (float32_t *)pScratch);
+
+    /* Scores below the threshold can only suppress boxes that are dropped anyway */
+    for (int32_t i = 0; i < nb_boxes; i++)
+    {
+        if (pScores[i * score_stride] >= conf_threshold)
+        {
+            pIndex[nb_candidates++] = i;
+        }
+    }
+    if (nb_candidates == 0) return (AI_OBJDETECT_POSTPROCESS_ERROR_NO);
+
+    objdetect_sort_index_desc(pScores, score_stride, pIndex, nb_candidates);
+
+    if (nb_candidates <= AI_OBJDETECT_PP_NMS_SOA_MAX)
+    {
+        for (int32_t i = 0; i < nb_candidates; i++)
+        {
+            objdetect_nms_soa_push(&soa, &pBoxes[pIndex[i] * box_stride]);
+        }
+        for (int32_t i = 0; i < nb_candidates; i++)
+        {
+            if (pScores[pIndex[i] * score_stride] == 0) continue;
+            for (int32_t j = i + 1; j < nb_candidates; j += 4)
+            {
+                uint32_t mask = objdetect_box_iou_above_x4(&soa, i, j, iou_threshold);
+                for (int32_t l = 0; mask != 0; l++, mask >>= 1)
+                {
+                    if (mask & 1) pScores[pIndex[j + l] * score_stride] = 0;
+                }
+            }
+        }
+    }
+    else
+    {
+        for (int32_t i = 0; i < nb_candidates; i++)
+        {
+            if (pScores[pIndex[i] * score_stride] == 0) continue;
+            float32_t *pA = &pBoxes[pIndex[i] * box_stride];
+            for (int32_t j = i + 1; j < nb_candidates; j++)
+            {
+                if (pScores[pIndex[j] * score_stride] == 0) continue;
+                float32_t *pB = &pBoxes[pIndex[j] * box_stride];
+                if (objdetect_box_iou(pA, pB) > iou_threshold)
+                {
+                    pScores[pIndex[j] * score_stride] = 0;
+                }
+            }
+        }
+    }
+
+    /* Limits detections count */
+    for (int32_t i = 0; i < nb_candidates; i++)
+    {
+        if ((limit_counter < max_boxes_limit) && (pScores[pIndex[i] * score_stride] != 0))
+        {
+            limit_counter++;
+        }
+        else
+        {
+            pScores[pIndex[i] * score_stride] = 0;
+        }
+    }
+
+    return (AI_OBJDETECT_POSTPROCESS_ERROR_NO);
+}
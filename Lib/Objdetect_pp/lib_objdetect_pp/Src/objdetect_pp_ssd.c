@@ -11,107 +11,6 @@
 #include "objdetect_ssd_pp_if.h"
 
 
-static int32_t SSD_quick_sort_partition(float32_t *pScores,
-                                        float32_t *pBoxes,
-                                        int32_t first,
-                                        int32_t last,
-                                        int32_t dir,
-                                        int32_t ssd_sort_class,
-                                        int32_t ssd_nb_classes,
-                                        float32_t *pTmp)
-{
-    int32_t i, j, pivot_index;
-    float32_t pivot;
-    pivot_index = first;
-    pivot = pScores[pivot_index * ssd_nb_classes + ssd_sort_class];
-    i = first - 1;
-    j = last + 1;
-
-    while (i < j)
-    {
-        if (dir)
-        {
-            do
-            {
-                i++;
-            } while ((pScores[i * ssd_nb_classes + ssd_sort_class] < pivot) &&
-                     (i < last));
-            do
-            {
-                j--;
-            } while (pScores[j * ssd_nb_classes + ssd_sort_class] > pivot);
-        }
-        else
-        {
-            do
-            {
-                i++;
-            } while ((pScores[i * ssd_nb_classes + ssd_sort_class] > pivot) &&
-                     (i < last));
-            do
-            {
-                j--;
-            } while (pScores[j * ssd_nb_classes + ssd_sort_class] < pivot);
-        }
-
-        if (i < j)
-        {
-            memcpy(pTmp, &pScores[i * ssd_nb_classes], ssd_nb_classes * sizeof(*pScores));
-            memcpy(&pScores[i * ssd_nb_classes], &pScores[j * ssd_nb_classes], ssd_nb_classes * sizeof(*pScores));
-            memcpy(&pScores[j * ssd_nb_classes], pTmp, ssd_nb_classes * sizeof(*pScores));
-
-            memcpy(pTmp, &pBoxes[i * AI_SSD_PP_BOX_STRIDE], AI_SSD_PP_BOX_STRIDE * sizeof(*pTmp));
-            memcpy(&pBoxes[i * AI_SSD_PP_BOX_STRIDE], &pBoxes[j * AI_SSD_PP_BOX_STRIDE], AI_SSD_PP_BOX_STRIDE * sizeof(*pTmp));
-            memcpy(&pBoxes[j * AI_SSD_PP_BOX_STRIDE], pTmp, AI_SSD_PP_BOX_STRIDE * sizeof(*pTmp));
-        }
-    }
-    return j;
-}
-
-static void SSD_quick_sort_core(float32_t *pScores,
-                                float32_t *pBoxes,
-                                int32_t first,
-                                int32_t last,
-                                int32_t dir,
-                                int32_t ssd_sort_class,
-                                int32_t ssd_nb_classes,
-                                float32_t *pTmp)
-{
-    /*
-     dir 0  : descending
-     dir 1  : ascending
-    */
-    if (first < last)
-    {
-        int32_t pivot;
-        pivot = SSD_quick_sort_partition(pScores,
-                                         pBoxes,
-                                         first,
-                                         last,
-                                         dir,
-                                         ssd_sort_class,
-                                         ssd_nb_classes,
-                                         pTmp);
-        SSD_quick_sort_core(pScores,
-                            pBoxes,
-                            first,
-                            pivot,
-                            dir,
-                            ssd_sort_class,
-                            ssd_nb_classes,
-                            pTmp);
-        SSD_quick_sort_core(pScores,
-                            pBoxes,
-                            pivot + 1,
-                            last,
-                            dir,
-                            ssd_sort_class,
-                            ssd_nb_classes,
-                            pTmp);
-    }
-}
-
-
 int32_t ssd_pp_getNNBoxes(ssd_pp_in_centroid_t *pInput,
                           ssd_pp_static_param_t *pInput_static_param)
 {
@@ -148,55 +47,25 @@ int32_t ssd_pp_getNNBoxes(ssd_pp_in_centroid_t *pInput,
 int32_t ssd_pp_nms_filtering(ssd_pp_in_centroid_t *pInput,
                              ssd_pp_static_param_t *pInput_static_param)
 {
-    int32_t i, j, k, ssd_sort_class, limit_counter;
-    float32_t tmp[pInput_static_param->nb_classes];
+    int32_t error = AI_OBJDETECT_POSTPROCESS_ERROR_NO;
+    /* NULL: scalar NMS without scratch */
+    int32_t *pScratch = pInput_static_param->pScratch;
 
-    for (k = 0; k < pInput_static_param->nb_classes; ++k)
+    for (int32_t k = 0; k < pInput_static_param->nb_classes; ++k)
     {
-        limit_counter = 0;
-        ssd_sort_class = k;
-
-        SSD_quick_sort_core(pInput->pScores,
-                            pInput->pBoxes,
-                            0,
-                            pInput_static_param->nb_detect - 1,
-                            0,
-                            ssd_sort_class,
-                            pInput_static_param->nb_classes,
-                            tmp);
-
-        for (i = 0; i < pInput_static_param->nb_detect; ++i)
-        {
-            if (pInput->pScores[i * pInput_static_param->nb_classes + k] == 0)
-            {
-                continue;
-            }
-            float32_t *pA = &(pInput->pBoxes[AI_SSD_PP_BOX_STRIDE * i + AI_SSD_PP_CENTROID_YCENTER]);
-            for (j = i + 1; j < pInput_static_param->nb_detect; ++j)
-            {
-                float32_t *pB = &(pInput->pBoxes[AI_SSD_PP_BOX_STRIDE * j + AI_SSD_PP_CENTROID_YCENTER]);
-                if (objdetect_box_iou(pA, pB) > pInput_static_param->iou_threshold)
-                {
-                    pInput->pScores[j * pInput_static_param->nb_classes + k] = 0;
-                }
-            }
-        }
-
-        for (int32_t it = 0; it < pInput_static_param->nb_detect; ++it)
-        {
-            if ((pInput->pScores[it * pInput_static_param->nb_classes + k] != 0) &&
-                (limit_counter < pInput_static_param->max_boxes_limit))
-            {
-                limit_counter++;
-            }
-            else
-            {
-                pInput->pScores[it * pInput_static_param->nb_classes + k] = 0;
-            }
-        }
+        error = objdetect_nms_single_class(&pInput->pScores[k],
+                                           pInput_static_param->nb_classes,
+                                           &pInput->pBoxes[AI_SSD_PP_CENTROID_YCENTER],
+                                           AI_SSD_PP_BOX_STRIDE,
+                                           pInput_static_param->nb_detect,
+                                           pInput_static_param->conf_threshold,
+                                           pInput_static_param->iou_threshold,
+                                           pInput_static_param->max_boxes_limit,
+                                           pScratch);
+        if (error != AI_OBJDETECT_POSTPROCESS_ERROR_NO) break;
     }
 
-    return (AI_OBJDETECT_POSTPROCESS_ERROR_NO);
+    return (error);
 }
 
 
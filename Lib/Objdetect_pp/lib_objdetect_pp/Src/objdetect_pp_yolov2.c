@@ -11,68 +11,30 @@
 #include "objdetect_yolov2_pp_if.h"
 
 
-/* Can't be removed if qsort is not re-written... */
-static int32_t AI_YOLOV2_PP_SORT_CLASS;
-
-
-int32_t yolov2_nms_comparator(const void *pa, const void *pb)
-{
-    float32_t a = *((float32_t *)pa + AI_YOLOV2_PP_CLASSPROB + AI_YOLOV2_PP_SORT_CLASS);
-    float32_t b = *((float32_t *)pb + AI_YOLOV2_PP_CLASSPROB + AI_YOLOV2_PP_SORT_CLASS);
-    float32_t diff = 0;
-
-    diff = a - b;
-
-    if (diff < 0) return 1;
-    else if (diff > 0) return -1;
-    return 0;
-}
-
-
 int32_t yolov2_pp_nmsFiltering_centroid(yolov2_pp_in_t  *pInput,
                                         yolov2_pp_static_param_t *pInput_static_param)
 {
-    int32_t i, j, k, limit_counter;
+    int32_t error = AI_OBJDETECT_POSTPROCESS_ERROR_NO;
     int32_t anch_stride = (pInput_static_param->nb_classes + AI_YOLOV2_PP_CLASSPROB);
     float32_t *pInbuff = (float32_t *)pInput->pRaw_detections;
+    /* NULL: scalar NMS without scratch */
+    int32_t *pScratch = pInput_static_param->pScratch;
 
-    for (k = 0; k < pInput_static_param->nb_classes; ++k)
+    for (int32_t k = 0; k < pInput_static_param->nb_classes; ++k)
     {
-        limit_counter = 0;
-        AI_YOLOV2_PP_SORT_CLASS = k;
-
-        qsort(pInbuff,
-              pInput_static_param->nb_detect,
-              anch_stride * sizeof(float32_t),
-              (_Cmpfun *)yolov2_nms_comparator);
-        for (i = 0; i < (pInput_static_param->nb_detect * anch_stride) ; i += anch_stride)
-        {
-            if (pInbuff[i + AI_YOLOV2_PP_CLASSPROB + k] == 0) continue;
-            float32_t *a = &(pInbuff[i + AI_YOLOV2_PP_XCENTER]);
-            for (j = i + anch_stride; j < (pInput_static_param->nb_detect * anch_stride); j += anch_stride)
-            {
-                float32_t *b = &(pInbuff[j + AI_YOLOV2_PP_XCENTER]);
-                if (objdetect_box_iou(a, b) > pInput_static_param->iou_threshold)
-                {
-                    pInbuff[j + AI_YOLOV2_PP_CLASSPROB + k] = 0;
-                }
-            }
-        }
-        for (int32_t y = 0; y <= (pInput_static_param->nb_detect * anch_stride); y += anch_stride)
-        {
-            if ((limit_counter < pInput_static_param->max_boxes_limit) &&
-                (pInbuff[y + AI_YOLOV2_PP_CLASSPROB + k] != 0))
-            {
-                limit_counter++;
-            }
-            else
-            {
-                pInbuff[y + AI_YOLOV2_PP_CLASSPROB + k] = 0;
-            }
-        }
+        error = objdetect_nms_single_class(&pInbuff[AI_YOLOV2_PP_CLASSPROB + k],
+                                           anch_stride,
+                                           &pInbuff[AI_YOLOV2_PP_XCENTER],
+                                           anch_stride,
+                                           pInput_static_param->nb_detect,
+                                           pInput_static_param->conf_threshold,
+                                           pInput_static_param->iou_threshold,
+                                           pInput_static_param->max_boxes_limit,
+                                           pScratch);
+        if (error != AI_OBJDETECT_POSTPROCESS_ERROR_NO) break;
     }
 
-    return (AI_OBJDETECT_POSTPROCESS_ERROR_NO);
+    return (error);
 }
 
 
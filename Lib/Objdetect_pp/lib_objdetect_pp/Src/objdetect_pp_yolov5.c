@@ -11,104 +11,19 @@
 #include "objdetect_yolov5_pp_if.h"
 
 
-/* Can't be removed if qsort is not re-written... */
-static int32_t AI_YOLOV5_PP_SORT_CLASS;
-
-
-int32_t yolov5_nms_comparator(const void *pa, const void *pb)
-{
-    postprocess_outBuffer_t a = *(postprocess_outBuffer_t *)pa;
-    postprocess_outBuffer_t b = *(postprocess_outBuffer_t *)pb;
-
-    float32_t diff = 0.0;
-    float32_t a_weighted_conf = 0.0;
-    float32_t b_weighted_conf = 0.0;
-
-    if (a.class_index == AI_YOLOV5_PP_SORT_CLASS)
-    {
-        a_weighted_conf = a.conf;
-    }
-    else
-    {
-         a_weighted_conf = 0.0;
-    }
-
-    if (b.class_index == AI_YOLOV5_PP_SORT_CLASS)
-    {
-        b_weighted_conf = b.conf;
-    }
-    else
-    {
-         b_weighted_conf = 0.0;
-    }
-
-    diff = a_weighted_conf - b_weighted_conf;
-
-    if (diff < 0) return 1;
-    else if (diff > 0) return -1;
-    return 0;
-}
-
-
 int32_t yolov5_pp_nmsFiltering_centroid(postprocess_out_t *pOutput,
                                         yolov5_pp_static_param_t *pInput_static_param)
 {
-    int32_t j, k, limit_counter, detections_per_class;
-
-    for (k = 0; k < pInput_static_param->nb_classes; ++k)
-    {
-        limit_counter = 0;
-        detections_per_class = 0;
-        AI_YOLOV5_PP_SORT_CLASS = k;
-
-
-        /* Counts the number of detections with class k */
-        for (int32_t i = 0; i < pInput_static_param->nb_detect ; i ++)
-        {
-            if(pOutput->pOutBuff[i].class_index == k)
-            {
-                detections_per_class++;
-            }
-        }
-
-        if (detections_per_class > 0)
-        {
-            /* Sorts detections based on class k */
-            qsort(pOutput->pOutBuff,
-                  pInput_static_param->nb_detect,
-                  sizeof(postprocess_outBuffer_t),
-                  yolov5_nms_comparator);
-
-            for (int32_t i = 0; i < detections_per_class ; i ++)
-            {
-                if (pOutput->pOutBuff[i].conf == 0) continue;
-                float32_t *a = &(pOutput->pOutBuff[i].x_center);
-                for (j = i + 1; j < detections_per_class; j ++)
-                {
-                    float32_t *b = &(pOutput->pOutBuff[j].x_center);
-                    if (objdetect_box_iou(a, b) > pInput_static_param->iou_threshold)
-                    {
-                        pOutput->pOutBuff[j].conf = 0;
-                    }
-                }
-            }
-
-            /* Limits detections count */
-            for (int32_t i = 0; i < detections_per_class; i++)
-            {
-                if ((limit_counter < pInput_static_param->max_boxes_limit) &&
-                    (pOutput->pOutBuff[i].conf != 0))
-                {
-                    limit_counter++;
-                }
-                else
-                {
-                    pOutput->pOutBuff[i].conf = 0;
-                }
-            }
-        }
-    }
-    return (AI_OBJDETECT_POSTPROCESS_ERROR_NO);
+    /* NULL: scalar NMS without scratch */
+    int32_t *pScratch = pInput_static_param->pScratch;
+
+    /* Buckets detections by class once, then sorts and suppresses each bucket */
+    return objdetect_nms_bucketed(pOutput->pOutBuff,
+                                  pInput_static_param->nb_detect,
+                                  pInput_static_param->nb_classes,
+                                  pInput_static_param->iou_threshold,
+                                  pInput_static_param->max_boxes_limit,
+                                  pScratch);
 }
 
 
@@ -136,7 +51,9 @@ int32_t yolov5_pp_scoreFiltering_centroid(postprocess_out_t *pOutput,
 }
 
 
+/* Appends the boxes of nb_boxes detections to pOutput, nb_detect is not reset */
 int32_t yolov5_pp_getNNBoxes_centroid(yolov5_pp_in_centroid_t *pInput,
+                                      int32_t nb_total_boxes,
                                       postprocess_out_t *pOutput,
                                       yolov5_pp_static_param_t *pInput_static_param)
 {
@@ -145,12 +62,9 @@ int32_t yolov5_pp_getNNBoxes_centroid(yolov5_pp_in_centroid_t *pInput,
     float32_t confidence = 0;
     int32_t class_index = 0;
     int32_t nb_classes = pInput_static_param->nb_classes;
-    int32_t nb_total_boxes = pInput_static_param->nb_total_boxes;
     int32_t detection_len = pInput_static_param->nb_classes + AI_YOLOV5_PP_BOX_STRIDE + 1;
     float32_t *pRaw_detections = (float32_t *)pInput->pRaw_detections;
 
-    pInput_static_param->nb_detect =0;
-
     for (int32_t i = 0; i < nb_total_boxes; i++)
     {
         confidence = pRaw_detections[ i*detection_len + AI_YOLOV5_PP_CONFIDENCE];
@@ -180,6 +94,7 @@ int32_t yolov5_pp_getNNBoxes_centroid(yolov5_pp_in_centroid_t *pInput,
 
 
 int32_t yolov5_pp_getNNBoxes_centroid_uint8(yolov5_pp_in_centroid_uint8_t *pInput,
+                                      int32_t nb_total_boxes,
                                       postprocess_out_t *pOutput,
                                       yolov5_pp_static_param_t *pInput_static_param)
 {
@@ -188,15 +103,12 @@ int32_t yolov5_pp_getNNBoxes_centroid_uint8(yolov5_pp_in_centroid_uint8_t *pInpu
     uint8_t confidence = 0;
     int32_t class_index = 0;
     int32_t nb_classes = pInput_static_param->nb_classes;
-    int32_t nb_total_boxes = pInput_static_param->nb_total_boxes;
     int32_t detection_len = pInput_static_param->nb_classes + AI_YOLOV5_PP_BOX_STRIDE + 1;
     uint8_t *pRaw_detections = pInput->pRaw_detections;
 
     uint8_t zero_point = pInput_static_param->raw_output_zero_point;
     float32_t scale = pInput_static_param->raw_output_scale;
 
-    pInput_static_param->nb_detect = 0;
-
     // scale must be strictly positive
     if (scale <= 0.0f) {
         return AI_OBJDETECT_POSTPROCESS_ERROR;
@@ -249,7 +161,9 @@ int32_t objdetect_yolov5_pp_process(yolov5_pp_in_centroid_t *pInput,
     int32_t error   = AI_OBJDETECT_POSTPROCESS_ERROR_NO;
 
     /* Call Get NN boxes first */
+    pInput_static_param->nb_detect = 0;
     error = yolov5_pp_getNNBoxes_centroid(pInput,
+                                          pInput_static_param->nb_total_boxes,
                                           pOutput,
                                           pInput_static_param);
     if (error != AI_OBJDETECT_POSTPROCESS_ERROR_NO) return (error);
@@ -274,7 +188,9 @@ int32_t objdetect_yolov5_pp_process_uint8(yolov5_pp_in_centroid_uint8_t *pInput,
     int32_t error   = AI_OBJDETECT_POSTPROCESS_ERROR_NO;
 
     /* Call Get NN boxes first */
+    pInput_static_param->nb_detect = 0;
     error = yolov5_pp_getNNBoxes_centroid_uint8(pInput,
+                                               pInput_static_param->nb_total_boxes,
                                                pOutput,
                                                pInput_static_param);
     if (error != AI_OBJDETECT_POSTPROCESS_ERROR_NO) return (error);
@@ -291,3 +207,56 @@ int32_t objdetect_yolov5_pp_process_uint8(yolov5_pp_in_centroid_uint8_t *pInput,
     return (error);
 }
 
+
+int32_t objdetect_yolov5_pp_process_head(yolov5_pp_in_centroid_t *pInput,
+                                         int32_t nb_head_boxes,
+                                         postprocess_out_t *pOutput,
+                                         yolov5_pp_static_param_t *pInput_static_param)
+{
+    if (pInput_static_param->nb_detect + nb_head_boxes > pInput_static_param->nb_total_boxes)
+    {
+        return (AI_OBJDETECT_POSTPROCESS_ERROR);
+    }
+
+    /* Only Get NN boxes, detections of the successive heads are accumulated */
+    return (yolov5_pp_getNNBoxes_centroid(pInput,
+                                          nb_head_boxes,
+                                          pOutput,
+                                          pInput_static_param));
+}
+
+
+int32_t objdetect_yolov5_pp_process_head_uint8(yolov5_pp_in_centroid_uint8_t *pInput,
+                                               int32_t nb_head_boxes,
+                                               postprocess_out_t *pOutput,
+                                               yolov5_pp_static_param_t *pInput_static_param)
+{
+    if (pInput_static_param->nb_detect + nb_head_boxes > pInput_static_param->nb_total_boxes)
+    {
+        return (AI_OBJDETECT_POSTPROCESS_ERROR);
+    }
+
+    /* Only Get NN boxes, detections of the successive heads are accumulated */
+    return (yolov5_pp_getNNBoxes_centroid_uint8(pInput,
+                                                nb_head_boxes,
+                                                pOutput,
+                                                pInput_static_param));
+}
+
+
+int32_t objdetect_yolov5_pp_process_heads_end(postprocess_out_t *pOutput,
+                                              yolov5_pp_static_param_t *pInput_static_param)
+{
+    int32_t error   = AI_OBJDETECT_POSTPROCESS_ERROR_NO;
+
+    /* NMS over the detections of all heads */
+    error = yolov5_pp_nmsFiltering_centroid(pOutput,
+                                            pInput_static_param);
+    if (error != AI_OBJDETECT_POSTPROCESS_ERROR_NO) return (error);
+
+    /* And score re-filtering */
+    error = yolov5_pp_scoreFiltering_centroid(pOutput,
+                                              pInput_static_param);
+
+    return (error);
+}
@@ -11,104 +11,19 @@
 #include "objdetect_yolov8_pp_if.h"
 
 
-/* Can't be removed if qsort is not re-written... */
-static int32_t AI_YOLOV8_PP_SORT_CLASS;
-
-
-int32_t yolov8_nms_comparator(const void *pa, const void *pb)
-{
-    postprocess_outBuffer_t a = *(postprocess_outBuffer_t *)pa;
-    postprocess_outBuffer_t b = *(postprocess_outBuffer_t *)pb;
-
-    float32_t diff = 0.0;
-    float32_t a_weighted_conf = 0.0;
-    float32_t b_weighted_conf = 0.0;
-
-    if (a.class_index == AI_YOLOV8_PP_SORT_CLASS)
-    {
-        a_weighted_conf = a.conf;
-    }
-    else
-    {
-         a_weighted_conf = 0.0;
-    }
-
-    if (b.class_index == AI_YOLOV8_PP_SORT_CLASS)
-    {
-        b_weighted_conf = b.conf;
-    }
-    else
-    {
-         b_weighted_conf = 0.0;
-    }
-
-    diff = a_weighted_conf - b_weighted_conf;
-
-    if (diff < 0) return 1;
-    else if (diff > 0) return -1;
-    return 0;
-}
-
-
 int32_t yolov8_pp_nmsFiltering_centroid(postprocess_out_t *pOutput,
                                         yolov8_pp_static_param_t *pInput_static_param)
 {
-    int32_t j, k, limit_counter, detections_per_class;
-
-    for (k = 0; k < pInput_static_param->nb_classes; ++k)
-    {
-        limit_counter = 0;
-        detections_per_class = 0;
-        AI_YOLOV8_PP_SORT_CLASS = k;
-
-
-        /* Counts the number of detections with class k */
-        for (int32_t i = 0; i < pInput_static_param->nb_detect ; i ++)
-        {
-            if(pOutput->pOutBuff[i].class_index == k)
-            {
-                detections_per_class++;
-            }
-        }
-
-        if (detections_per_class > 0)
-        {
-            /* Sorts detections based on class k */
-            qsort(pOutput->pOutBuff,
-                  pInput_static_param->nb_detect,
-                  sizeof(postprocess_outBuffer_t),
-                  yolov8_nms_comparator);
-
-            for (int32_t i = 0; i < detections_per_class ; i ++)
-            {
-                if (pOutput->pOutBuff[i].conf == 0) continue;
-                float32_t *a = &(pOutput->pOutBuff[i].x_center);
-                for (j = i + 1; j < detections_per_class; j ++)
-                {
-                    float32_t *b = &(pOutput->pOutBuff[j].x_center);
-                    if (objdetect_box_iou(a, b) > pInput_static_param->iou_threshold)
-                    {
-                        pOutput->pOutBuff[j].conf = 0;
-                    }
-                }
-            }
-
-            /* Limits detections count */
-            for (int32_t i = 0; i < detections_per_class; i++)
-            {
-                if ((limit_counter < pInput_static_param->max_boxes_limit) &&
-                    (pOutput->pOutBuff[i].conf != 0))
-                {
-                    limit_counter++;
-                }
-                else
-                {
-                    pOutput->pOutBuff[i].conf = 0;
-                }
-            }
-        }
-    }
-    return (AI_OBJDETECT_POSTPROCESS_ERROR_NO);
+    /* NULL: scalar NMS without scratch */
+    int32_t *pScratch = pInput_static_param->pScratch;
+
+    /* Buckets detections by class once, then sorts and suppresses each bucket */
+    return objdetect_nms_bucketed(pOutput->pOutBuff,
+                                  pInput_static_param->nb_detect,
+                                  pInput_static_param->nb_classes,
+                                  pInput_static_param->iou_threshold,
+                                  pInput_static_param->max_boxes_limit,
+                                  pScratch);
 }
 
 
@@ -213,105 +128,258 @@ int32_t yolov8_pp_getNNBoxes_centroid(yolov8_pp_in_centroid_t *pInput,
 }
 #endif
 
-#ifdef AI_YOLOV8_PP_MVEI_OPTIM
+/* Bounded min-heap on the quantized score, keeps the max_candidates best boxes */
+typedef struct yolov8_pp_topk
+{
+    int32_t *pKey;      /* (score - Q7_MIN) << 23 | (0x7FFFFF - anchor index), stays positive */
+    int32_t *pClass;
+    int32_t nb;
+    int32_t size;
+} yolov8_pp_topk_t;
+
+/* Among equal scores the latest anchor has the smallest key: it is the root of the heap and evicted first */
+#define YOLOV8_PP_TOPK_KEY(score, anchor) ((((int32_t)(score) - Q7_MIN) << 23) | (0x7FFFFF - (anchor)))
+#define YOLOV8_PP_TOPK_ANCHOR(key)        (0x7FFFFF - ((key) & 0x7FFFFF))
+#define YOLOV8_PP_TOPK_SCORE(key)         ((int8_t)(((key) >> 23) + Q7_MIN))
+
+
+static inline void yolov8_pp_topk_swap(yolov8_pp_topk_t *pTopk, int32_t i, int32_t j)
+{
+    int32_t tmp = pTopk->pKey[i];
+    pTopk->pKey[i] = pTopk->pKey[j];
+    pTopk->pKey[j] = tmp;
+    tmp = pTopk->pClass[i];
+    pTopk->pClass[i] = pTopk->pClass[j];
+    pTopk->pClass[j] = tmp;
+}
+
+
+static void yolov8_pp_topk_sift_down(yolov8_pp_topk_t *pTopk, int32_t root)
+{
+    for (;;)
+    {
+        int32_t child = 2 * root + 1;
+        if (child >= pTopk->nb) break;
+        if ((child + 1 < pTopk->nb) && (pTopk->pKey[child + 1] < pTopk->pKey[child]))
+        {
+            child++;
+        }
+        if (pTopk->pKey[root] <= pTopk->pKey[child]) break;
+        yolov8_pp_topk_swap(pTopk, root, child);
+        root = child;
+    }
+}
+
+
+/* Max-heap on the anchor index */
+static void yolov8_pp_topk_sift_down_anchor(yolov8_pp_topk_t *pTopk, int32_t root, int32_t len)
+{
+    for (;;)
+    {
+        int32_t child = 2 * root + 1;
+        if (child >= len) break;
+        if ((child + 1 < len) && (YOLOV8_PP_TOPK_ANCHOR(pTopk->pKey[child + 1]) > YOLOV8_PP_TOPK_ANCHOR(pTopk->pKey[child])))
+        {
+            child++;
+        }
+        if (YOLOV8_PP_TOPK_ANCHOR(pTopk->pKey[root]) >= YOLOV8_PP_TOPK_ANCHOR(pTopk->pKey[child])) break;
+        yolov8_pp_topk_swap(pTopk, root, child);
+        root = child;
+    }
+}
+
+
+/* Survivors are output in anchor order, as without top-K, so that NMS ties resolve the same way */
+static void yolov8_pp_topk_sort_anchor(yolov8_pp_topk_t *pTopk)
+{
+    for (int32_t i = pTopk->nb / 2 - 1; i >= 0; i--)
+    {
+        yolov8_pp_topk_sift_down_anchor(pTopk, i, pTopk->nb);
+    }
+    for (int32_t end = pTopk->nb - 1; end > 0; end--)
+    {
+        yolov8_pp_topk_swap(pTopk, 0, end);
+        yolov8_pp_topk_sift_down_anchor(pTopk, 0, end);
+    }
+}
+
+
+static void yolov8_pp_topk_push(yolov8_pp_topk_t *pTopk, int8_t score, int32_t anchor, int32_t class_index)
+{
+    int32_t key = YOLOV8_PP_TOPK_KEY(score, anchor);
+
+    if (pTopk->nb < pTopk->size)
+    {
+        /* Sift up */
+        int32_t i = pTopk->nb++;
+        while (i > 0)
+        {
+            int32_t parent = (i - 1) / 2;
+            if (pTopk->pKey[parent] <= key) break;
+            pTopk->pKey[i] = pTopk->pKey[parent];
+            pTopk->pClass[i] = pTopk->pClass[parent];
+            i = parent;
+        }
+        pTopk->pKey[i] = key;
+        pTopk->pClass[i] = class_index;
+    }
+    else if ((key >> 23) > (pTopk->pKey[0] >> 23))
+    {
+        /* Replaces the weakest candidate (the latest anchor among the lowest scores), ties keep the earliest anchors */
+        pTopk->pKey[0] = key;
+        pTopk->pClass[0] = class_index;
+        yolov8_pp_topk_sift_down(pTopk, 0);
+    }
+}
+
+
+/* Only boxes that passed the threshold get their geometry dequantized */
+static inline void yolov8_pp_store_int8(postprocess_outBuffer_t *pOut,
+                                        int8_t *pRaw_detections,
+                                        int32_t anchor,
+                                        int32_t nb_total_boxes,
+                                        int8_t score,
+                                        int32_t class_index,
+                                        int8_t zero_point,
+                                        float32_t scale)
+{
+    pOut->x_center = scale * (float32_t)((int32_t)pRaw_detections[anchor + AI_YOLOV8_PP_XCENTER * nb_total_boxes] - (int32_t)zero_point);
+    pOut->y_center = scale * (float32_t)((int32_t)pRaw_detections[anchor + AI_YOLOV8_PP_YCENTER * nb_total_boxes] - (int32_t)zero_point);
+    pOut->width = scale * (float32_t)((int32_t)pRaw_detections[anchor + AI_YOLOV8_PP_WIDTHREL * nb_total_boxes] - (int32_t)zero_point);
+    pOut->height = scale * (float32_t)((int32_t)pRaw_detections[anchor + AI_YOLOV8_PP_HEIGHTREL * nb_total_boxes] - (int32_t)zero_point);
+    pOut->conf = scale * (float32_t)((int32_t)score - (int32_t)zero_point);
+    pOut->class_index = class_index;
+}
+
+
+static inline void yolov8_pp_keep_int8(yolov8_pp_in_centroid_int8_t *pInput,
+                                       postprocess_out_t *pOutput,
+                                       yolov8_pp_static_param_t *pInput_static_param,
+                                       yolov8_pp_topk_t *pTopk,
+                                       int8_t score,
+                                       int32_t anchor,
+                                       int32_t class_index)
+{
+    if (pTopk->size > 0)
+    {
+        yolov8_pp_topk_push(pTopk, score, anchor, class_index);
+    }
+    else
+    {
+        yolov8_pp_store_int8(&pOutput->pOutBuff[pInput_static_param->nb_detect],
+                             pInput->pRaw_detections,
+                             anchor,
+                             pInput_static_param->nb_total_boxes,
+                             score,
+                             class_index,
+                             pInput_static_param->raw_output_zero_point,
+                             pInput_static_param->raw_output_scale);
+        pInput_static_param->nb_detect++;
+    }
+}
+
+
+/* Smallest quantized score whose dequantized value passes conf_threshold, Q7_MAX + 1 if none */
+static int32_t yolov8_pp_quantize_threshold(yolov8_pp_static_param_t *pInput_static_param)
+{
+    float32_t scale = pInput_static_param->raw_output_scale;
+    int32_t zero_point = pInput_static_param->raw_output_zero_point;
+    float32_t conf_threshold = pInput_static_param->conf_threshold;
+    float32_t q = ceilf(conf_threshold / scale) + (float32_t)zero_point;
+    int32_t conf_threshold_q = (int32_t)MAX(MIN(q, (float32_t)(Q7_MAX + 1)), (float32_t)Q7_MIN);
+
+    /* Matches the float comparison exactly despite rounding of the division */
+    while ((conf_threshold_q > Q7_MIN) &&
+           (scale * (float32_t)(conf_threshold_q - 1 - zero_point) >= conf_threshold))
+    {
+        conf_threshold_q--;
+    }
+    while ((conf_threshold_q <= Q7_MAX) &&
+           (scale * (float32_t)(conf_threshold_q - zero_point) < conf_threshold))
+    {
+        conf_threshold_q++;
+    }
+    return (conf_threshold_q);
+}
+
+
 int32_t yolov8_pp_getNNBoxes_centroid_int8(yolov8_pp_in_centroid_int8_t *pInput,
                                            postprocess_out_t *pOutput,
                                            yolov8_pp_static_param_t *pInput_static_param)
 {
-    int32_t error   = AI_OBJDETECT_POSTPROCESS_ERROR_NO;
-    int32_t class_index = 0;
     int32_t nb_classes = pInput_static_param->nb_classes;
     int32_t nb_total_boxes = pInput_static_param->nb_total_boxes;
     int8_t *pRaw_detections = (int8_t *)pInput->pRaw_detections;
-    int8_t zero_point = pInput_static_param->raw_output_zero_point;
-    float32_t scale = pInput_static_param->raw_output_scale;
-    float32_t best_score_f;
+    int32_t max_candidates = MAX(pInput_static_param->max_candidates, 0);
+    int32_t *pTopk_buffer = pInput_static_param->pScratch;
+    yolov8_pp_topk_t topk = {pTopk_buffer, (pTopk_buffer != NULL) ? &pTopk_buffer[max_candidates] : NULL, 0,
+                             max_candidates};
 
-    pInput_static_param->nb_detect =0;
+    pInput_static_param->nb_detect = 0;
+
+    /* The top-K heap lives in pScratch */
+    if ((max_candidates > 0) && (pTopk_buffer == NULL)) {
+        return AI_OBJDETECT_POSTPROCESS_ERROR;
+    }
+
+    // scale must be strictly positive
+    if (pInput_static_param->raw_output_scale <= 0.0f) {
+        return AI_OBJDETECT_POSTPROCESS_ERROR;
+    }
+
+    /* Threshold is moved to the quantized domain once per frame */
+    int32_t conf_threshold_q = yolov8_pp_quantize_threshold(pInput_static_param);
+    if (conf_threshold_q > Q7_MAX) {
+        return (AI_OBJDETECT_POSTPROCESS_ERROR_NO);
+    }
+
+#ifdef AI_YOLOV8_PP_MVEI_OPTIM
     int32_t remaining_boxes = nb_total_boxes;
-#ifdef _YOLOV8_PP_INT8_CMP_INT8
-     int8_t conf_threshold_s8 = (int8_t)(pInput_static_param->conf_threshold / scale + 0.5f) + zero_point;
-#endif
-   if (nb_classes < 256) {
-        int8_t best_score_array[16];
-        uint8_t class_index_array[16];
-        for (int32_t i = 0; i < nb_total_boxes; i+=16)
-        {
+    int8_t best_score_array[16];
+    uint16_t class_index_array[16];
+    uint8_t class_index_array_u8[16];
+
+    for (int32_t i = 0; i < nb_total_boxes; i+=16)
+    {
+        if (nb_classes < 256) {
             objdetect_maxi_transpose_int8(&pRaw_detections[i + AI_YOLOV8_PP_CLASSPROB * nb_total_boxes],
                                           nb_classes,
                                           nb_total_boxes,
                                           best_score_array,
-                                          class_index_array,
+                                          class_index_array_u8,
                                           remaining_boxes);
-            for (int _i = 0; _i < ((remaining_boxes>16)?16:remaining_boxes); _i++) {
-
-#ifdef _YOLOV8_PP_INT8_CMP_INT8
-                if ( best_score_array[_i] >= conf_threshold_s8) {
-                best_score_f = scale * (float32_t)(best_score_array[_i] - zero_point);
-#else
-                best_score_f = scale * (float32_t)(best_score_array[_i] - zero_point);
-                if (best_score_f >= pInput_static_param->conf_threshold) {
-#endif
-                class_index = class_index_array[_i];
-                    pOutput->pOutBuff[pInput_static_param->nb_detect].x_center = scale * (float32_t)((int32_t)pRaw_detections[i + _i + AI_YOLOV8_PP_XCENTER * nb_total_boxes] - (int32_t)zero_point);
-                    pOutput->pOutBuff[pInput_static_param->nb_detect].y_center = scale * (float32_t)((int32_t)pRaw_detections[i + _i + AI_YOLOV8_PP_YCENTER * nb_total_boxes] - (int32_t)zero_point);
-                    pOutput->pOutBuff[pInput_static_param->nb_detect].width = scale * (float32_t)((int32_t)pRaw_detections[i + _i + AI_YOLOV8_PP_WIDTHREL * nb_total_boxes] - (int32_t)zero_point);
-                    pOutput->pOutBuff[pInput_static_param->nb_detect].height = scale * (float32_t)((int32_t)pRaw_detections[i + _i + AI_YOLOV8_PP_HEIGHTREL * nb_total_boxes] - (int32_t)zero_point);
-                    pOutput->pOutBuff[pInput_static_param->nb_detect].conf = best_score_f;
-                    pOutput->pOutBuff[pInput_static_param->nb_detect].class_index = class_index;
-                    pInput_static_param->nb_detect++;
-                }
-            }
-            remaining_boxes-=16;
-        }
-    } else {
-        int8_t best_score_array[16];
-        uint16_t class_index_array[16];
-        for (int32_t i = 0; i < nb_total_boxes; i+=16)
-        {
+        } else {
             objdetect_maxi_transpose_int8_large(&pRaw_detections[i + AI_YOLOV8_PP_CLASSPROB * nb_total_boxes],
                                                 nb_classes,
                                                 nb_total_boxes,
                                                 best_score_array,
                                                 class_index_array,
                                                 remaining_boxes);
+        }
 
+        // reject the whole block at once when no lane reaches the threshold
+        mve_pred16_t p = vcmpgeq_m_n_s8(vld1q_s8(best_score_array), (int8_t)conf_threshold_q, vctp8q(remaining_boxes));
+        if (p != 0)
+        {
             for (int _i = 0; _i < ((remaining_boxes>16)?16:remaining_boxes); _i++) {
-                best_score_f = scale * (float32_t)(best_score_array[_i] - zero_point);
-                class_index = class_index_array[_i];
-                if (best_score_f >= pInput_static_param->conf_threshold)
+                if (best_score_array[_i] >= conf_threshold_q)
                 {
-                    pOutput->pOutBuff[pInput_static_param->nb_detect].x_center = scale * (float32_t)((int32_t)pRaw_detections[i + AI_YOLOV8_PP_XCENTER * nb_total_boxes] - (int32_t)zero_point);
-                    pOutput->pOutBuff[pInput_static_param->nb_detect].y_center = scale * (float32_t)((int32_t)pRaw_detections[i + AI_YOLOV8_PP_YCENTER * nb_total_boxes] - (int32_t)zero_point);
-                    pOutput->pOutBuff[pInput_static_param->nb_detect].width = scale * (float32_t)((int32_t)pRaw_detections[i + AI_YOLOV8_PP_WIDTHREL * nb_total_boxes] - (int32_t)zero_point);
-                    pOutput->pOutBuff[pInput_static_param->nb_detect].height = scale * (float32_t)((int32_t)pRaw_detections[i + AI_YOLOV8_PP_HEIGHTREL * nb_total_boxes] - (int32_t)zero_point);
-                    pOutput->pOutBuff[pInput_static_param->nb_detect].conf = best_score_f;
-                    pOutput->pOutBuff[pInput_static_param->nb_detect].class_index = class_index;
-                    pInput_static_param->nb_detect++;
+                    yolov8_pp_keep_int8(pInput,
+                                        pOutput,
+                                        pInput_static_param,
+                                        &topk,
+                                        best_score_array[_i],
+                                        i + _i,
+                                        (nb_classes < 256) ? class_index_array_u8[_i] : class_index_array[_i]);
                 }
             }
-            remaining_boxes-=16;
         }
-
+        remaining_boxes-=16;
     }
-    return (error);
-}
 #else
-int32_t yolov8_pp_getNNBoxes_centroid_int8(yolov8_pp_in_centroid_int8_t *pInput,
-                                           postprocess_out_t *pOutput,
-                                           yolov8_pp_static_param_t *pInput_static_param)
-{
-    int32_t error   = AI_OBJDETECT_POSTPROCESS_ERROR_NO;
     int8_t best_score = 0;
     int32_t class_index = 0;
-    int32_t nb_classes = pInput_static_param->nb_classes;
-    int32_t nb_total_boxes = pInput_static_param->nb_total_boxes;
-    int8_t *pRaw_detections = (int8_t *)pInput->pRaw_detections;
-    int8_t zero_point = pInput_static_param->raw_output_zero_point;
-    float32_t scale = pInput_static_param->raw_output_scale;
-    float32_t best_score_f;
 
-    pInput_static_param->nb_detect =0;
     for (int32_t i = 0; i < nb_total_boxes; i++)
     {
         objdetect_maxi_transpose_int8(&pRaw_detections[i + AI_YOLOV8_PP_CLASSPROB * nb_total_boxes],
@@ -319,22 +387,39 @@ int32_t yolov8_pp_getNNBoxes_centroid_int8(yolov8_pp_in_centroid_int8_t *pInput,
                                       nb_total_boxes,
                                       &best_score,
                                       &class_index);
-        best_score_f = scale * (float32_t)(best_score - zero_point);
-        if (best_score_f >= pInput_static_param->conf_threshold)
+        if (best_score >= conf_threshold_q)
         {
-            pOutput->pOutBuff[pInput_static_param->nb_detect].x_center = scale * (float32_t)((int32_t)pRaw_detections[i + AI_YOLOV8_PP_XCENTER * nb_total_boxes] - (int32_t)zero_point);
-            pOutput->pOutBuff[pInput_static_param->nb_detect].y_center = scale * (float32_t)((int32_t)pRaw_detections[i + AI_YOLOV8_PP_YCENTER * nb_total_boxes] - (int32_t)zero_point);
-            pOutput->pOutBuff[pInput_static_param->nb_detect].width = scale * (float32_t)((int32_t)pRaw_detections[i + AI_YOLOV8_PP_WIDTHREL * nb_total_boxes] - (int32_t)zero_point);
-            pOutput->pOutBuff[pInput_static_param->nb_detect].height = scale * (float32_t)((int32_t)pRaw_detections[i + AI_YOLOV8_PP_HEIGHTREL * nb_total_boxes] - (int32_t)zero_point);
-            pOutput->pOutBuff[pInput_static_param->nb_detect].conf = best_score_f;
-            pOutput->pOutBuff[pInput_static_param->nb_detect].class_index = class_index;
-            pInput_static_param->nb_detect++;
+            yolov8_pp_keep_int8(pInput,
+                                pOutput,
+                                pInput_static_param,
+                                &topk,
+                                best_score,
+                                i,
+                                class_index);
         }
     }
+#endif
 
-    return (error);
+    /* Dequantizes the top-K survivors */
+    yolov8_pp_topk_sort_anchor(&topk);
+    for (int32_t k = 0; k < topk.nb; k++)
+    {
+        yolov8_pp_store_int8(&pOutput->pOutBuff[k],
+                             pRaw_detections,
+                             YOLOV8_PP_TOPK_ANCHOR(topk.pKey[k]),
+                             nb_total_boxes,
+                             YOLOV8_PP_TOPK_SCORE(topk.pKey[k]),
+                             topk.pClass[k],
+                             pInput_static_param->raw_output_zero_point,
+                             pInput_static_param->raw_output_scale);
+    }
+    if (topk.size > 0)
+    {
+        pInput_static_param->nb_detect = topk.nb;
+    }
+
+    return (AI_OBJDETECT_POSTPROCESS_ERROR_NO);
 }
-#endif
 
 
 /* ----------------------       Exported routines      ---------------------- */
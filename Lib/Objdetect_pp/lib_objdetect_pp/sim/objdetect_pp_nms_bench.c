@@ -0,0 +1,289 @@
+/*---------------------------------------------------------------------------------------------
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *--------------------------------------------------------------------------------------------*/
+
+/* NMS of YOLOv5/v8: class-bucketed engine against the former qsort of the whole buffer per class.
+ * The boxes kept by both must be the same, the time of each is reported. The paths taken without pScratch, for
+ * the bucketed and the single class (SSD, YOLOv2) NMS, must keep the same boxes as with it. */
+
+#include <stdlib.h>
+#include <string.h>
+#include "objdetect_pp_loc.h"
+#include "objdetect_yolov8_pp_if.h"
+#include "objdetect_pp_sim.h"
+
+
+#define SIM_NMS_IOU_THRESHOLD     (0.5f)
+#define SIM_NMS_MAX_BOXES_LIMIT   (10)
+#define SIM_NMS_MAX_CLASSES       (80)
+#define SIM_NMS_MAX_DETECT        (2000)
+
+
+/* Former implementation: the whole buffer is sorted once per class through a static key */
+static int32_t SIM_NMS_SORT_CLASS;
+
+
+static int32_t sim_nms_comparator(const void *pa, const void *pb)
+{
+    postprocess_outBuffer_t a = *(postprocess_outBuffer_t *)pa;
+    postprocess_outBuffer_t b = *(postprocess_outBuffer_t *)pb;
+
+    float32_t a_weighted_conf = (a.class_index == SIM_NMS_SORT_CLASS) ? a.conf : 0.0f;
+    float32_t b_weighted_conf = (b.class_index == SIM_NMS_SORT_CLASS) ? b.conf : 0.0f;
+    float32_t diff = a_weighted_conf - b_weighted_conf;
+
+    if (diff < 0) return 1;
+    else if (diff > 0) return -1;
+    return 0;
+}
+
+
+static void sim_nms_qsort_per_class(postprocess_outBuffer_t *pBoxes,
+                                    int32_t nb_boxes,
+                                    int32_t nb_classes,
+                                    float32_t iou_threshold,
+                                    int32_t max_boxes_limit)
+{
+    for (int32_t k = 0; k < nb_classes; ++k)
+    {
+        int32_t limit_counter = 0;
+        int32_t detections_per_class = 0;
+        SIM_NMS_SORT_CLASS = k;
+
+        for (int32_t i = 0; i < nb_boxes; i++)
+        {
+            if (pBoxes[i].class_index == k)
+            {
+                detections_per_class++;
+            }
+        }
+        if (detections_per_class == 0) continue;
+
+        qsort(pBoxes, nb_boxes, sizeof(postprocess_outBuffer_t), sim_nms_comparator);
+
+        for (int32_t i = 0; i < detections_per_class; i++)
+        {
+            if (pBoxes[i].conf == 0) continue;
+            float32_t *a = &(pBoxes[i].x_center);
+            for (int32_t j = i + 1; j < detections_per_class; j++)
+            {
+                float32_t *b = &(pBoxes[j].x_center);
+                if (objdetect_box_iou(a, b) > iou_threshold)
+                {
+                    pBoxes[j].conf = 0;
+                }
+            }
+        }
+
+        for (int32_t i = 0; i < detections_per_class; i++)
+        {
+            if ((limit_counter < max_boxes_limit) && (pBoxes[i].conf != 0))
+            {
+                limit_counter++;
+            }
+            else
+            {
+                pBoxes[i].conf = 0;
+            }
+        }
+    }
+}
+
+
+/* Clusters of overlapping boxes, so that suppression and the per-class limit both come into play. The scores are
+ * all different: the order of the kept boxes does not depend on how each sort breaks ties. */
+static void sim_nms_generate(postprocess_outBuffer_t *pBoxes,
+                             int32_t nb_boxes,
+                             int32_t nb_classes,
+                             uint32_t seed)
+{
+    uint32_t state = seed;
+    int32_t nb_clusters = nb_boxes / 8 + 1;
+
+    for (int32_t i = 0; i < nb_boxes; i++)
+    {
+        uint32_t cluster = sim_rand(&state) % nb_clusters;
+        uint32_t cluster_state = cluster * 2654435761U + seed;
+        float32_t cx = sim_randf(&cluster_state);
+        float32_t cy = sim_randf(&cluster_state);
+        float32_t size = 0.05f + 0.2f * sim_randf(&cluster_state);
+
+        pBoxes[i].x_center = cx + 0.05f * (sim_randf(&state) - 0.5f);
+        pBoxes[i].y_center = cy + 0.05f * (sim_randf(&state) - 0.5f);
+        pBoxes[i].width = size * (0.8f + 0.4f * sim_randf(&state));
+        pBoxes[i].height = size * (0.8f + 0.4f * sim_randf(&state));
+        pBoxes[i].conf = 0.25f + 0.75f * ((float32_t)(nb_boxes - i) / (float32_t)(nb_boxes + 1));
+        pBoxes[i].class_index = (int32_t)(cluster % (uint32_t)nb_classes);
+    }
+    /* Scores do not follow the generation order */
+    for (int32_t i = nb_boxes - 1; i > 0; i--)
+    {
+        int32_t j = (int32_t)(sim_rand(&state) % (uint32_t)(i + 1));
+        float32_t tmp = pBoxes[i].conf;
+        pBoxes[i].conf = pBoxes[j].conf;
+        pBoxes[j].conf = tmp;
+    }
+}
+
+
+static int sim_nms_cmp_kept(const void *pa, const void *pb)
+{
+    const postprocess_outBuffer_t *a = pa;
+    const postprocess_outBuffer_t *b = pb;
+
+    if (a->class_index != b->class_index) return (a->class_index < b->class_index) ? -1 : 1;
+    if (a->conf != b->conf) return (a->conf > b->conf) ? -1 : 1;
+    return 0;
+}
+
+
+/* Moves the kept boxes first, ordered by class then score, returns their number */
+static int32_t sim_nms_kept(postprocess_outBuffer_t *pBoxes,
+                            int32_t nb_boxes)
+{
+    int32_t nb_kept = 0;
+
+    for (int32_t i = 0; i < nb_boxes; i++)
+    {
+        if (pBoxes[i].conf != 0)
+        {
+            pBoxes[nb_kept++] = pBoxes[i];
+        }
+    }
+    qsort(pBoxes, nb_kept, sizeof(*pBoxes), sim_nms_cmp_kept);
+
+    return nb_kept;
+}
+
+
+static postprocess_outBuffer_t sim_input[SIM_NMS_MAX_DETECT];
+static postprocess_outBuffer_t sim_ref[SIM_NMS_MAX_DETECT];
+static postprocess_outBuffer_t sim_out[SIM_NMS_MAX_DETECT];
+static postprocess_outBuffer_t sim_out_noscratch[SIM_NMS_MAX_DETECT];
+static int32_t sim_scratch[AI_OBJDETECT_PP_NMS_SOA_SCRATCH_SIZE + SIM_NMS_MAX_DETECT];
+
+/* Single class NMS: SSD like layout, scores per class of each box and boxes on 4 words */
+#define SIM_NMS_SC_CLASSES        (4)
+static float32_t sim_sc_boxes[4 * SIM_NMS_MAX_DETECT];
+static float32_t sim_sc_scores[SIM_NMS_SC_CLASSES * SIM_NMS_MAX_DETECT];
+static float32_t sim_sc_scores_noscratch[SIM_NMS_SC_CLASSES * SIM_NMS_MAX_DETECT];
+
+
+static void sim_nms_run(int32_t nb_boxes,
+                        int32_t nb_classes,
+                        int32_t nb_runs)
+{
+    uint64_t ref_ns = 0;
+    uint64_t out_ns = 0;
+    int32_t nb_ref = 0;
+    int32_t nb_out = 0;
+
+    for (int32_t run = 0; run < nb_runs; run++)
+    {
+        uint64_t t0, t1, t2;
+
+        sim_nms_generate(sim_input, nb_boxes, nb_classes, 0x9E3779B9U + (uint32_t)run);
+        memcpy(sim_ref, sim_input, nb_boxes * sizeof(*sim_input));
+        memcpy(sim_out, sim_input, nb_boxes * sizeof(*sim_input));
+        memcpy(sim_out_noscratch, sim_input, nb_boxes * sizeof(*sim_input));
+
+        t0 = sim_time_ns();
+        sim_nms_qsort_per_class(sim_ref, nb_boxes, nb_classes, SIM_NMS_IOU_THRESHOLD, SIM_NMS_MAX_BOXES_LIMIT);
+        t1 = sim_time_ns();
+        SIM_CHECK(objdetect_nms_bucketed(sim_out, nb_boxes, nb_classes, SIM_NMS_IOU_THRESHOLD,
+                                         SIM_NMS_MAX_BOXES_LIMIT, sim_scratch) == AI_OBJDETECT_POSTPROCESS_ERROR_NO);
+        t2 = sim_time_ns();
+        ref_ns += t1 - t0;
+        out_ns += t2 - t1;
+        SIM_CHECK(objdetect_nms_bucketed(sim_out_noscratch, nb_boxes, nb_classes, SIM_NMS_IOU_THRESHOLD,
+                                         SIM_NMS_MAX_BOXES_LIMIT, NULL) == AI_OBJDETECT_POSTPROCESS_ERROR_NO);
+
+        nb_ref = sim_nms_kept(sim_ref, nb_boxes);
+        nb_out = sim_nms_kept(sim_out, nb_boxes);
+        SIM_CHECK(nb_ref == nb_out);
+        SIM_CHECK((nb_ref == nb_out) && (memcmp(sim_ref, sim_out, nb_ref * sizeof(*sim_ref)) == 0));
+        SIM_CHECK(sim_nms_kept(sim_out_noscratch, nb_boxes) == nb_out);
+        SIM_CHECK(memcmp(sim_out_noscratch, sim_out, nb_out * sizeof(*sim_out)) == 0);
+    }
+
+    printf("%5ld boxes %3ld classes: %4ld kept, qsort per class %9.1f us, bucketed %7.1f us (x%.1f)\n",
+           (long)nb_boxes, (long)nb_classes, (long)nb_out,
+           ref_ns / 1000.0 / nb_runs, out_ns / 1000.0 / nb_runs, (double)ref_ns / (double)(out_ns + 1));
+}
+
+
+/* Same boxes and scores kept with and without scratch, for each class of a score matrix */
+static void sim_nms_single_class_run(int32_t nb_boxes,
+                                     float32_t conf_threshold,
+                                     int32_t max_boxes_limit)
+{
+    for (int32_t run = 0; run < 20; run++)
+    {
+        uint32_t state = 0x85EBCA6BU + (uint32_t)run;
+
+        sim_nms_generate(sim_input, nb_boxes, 1, 0x27D4EB2FU + (uint32_t)run);
+        for (int32_t i = 0; i < nb_boxes; i++)
+        {
+            memcpy(&sim_sc_boxes[4 * i], &sim_input[i].x_center, 4 * sizeof(float32_t));
+        }
+        /* Different scores, as both paths may break ties differently, and some at 0 */
+        for (int32_t k = 0; k < SIM_NMS_SC_CLASSES; k++)
+        {
+            for (int32_t i = 0; i < nb_boxes; i++)
+            {
+                sim_sc_scores[i * SIM_NMS_SC_CLASSES + k] = (float32_t)(i + 1) / (float32_t)(nb_boxes + 1);
+            }
+            for (int32_t i = nb_boxes - 1; i > 0; i--)
+            {
+                int32_t j = (int32_t)(sim_rand(&state) % (uint32_t)(i + 1));
+                float32_t tmp = sim_sc_scores[i * SIM_NMS_SC_CLASSES + k];
+                sim_sc_scores[i * SIM_NMS_SC_CLASSES + k] = sim_sc_scores[j * SIM_NMS_SC_CLASSES + k];
+                sim_sc_scores[j * SIM_NMS_SC_CLASSES + k] = tmp;
+            }
+            for (int32_t i = 0; i < nb_boxes; i++)
+            {
+                if ((sim_rand(&state) % 8) == 0) sim_sc_scores[i * SIM_NMS_SC_CLASSES + k] = 0;
+            }
+        }
+        memcpy(sim_sc_scores_noscratch, sim_sc_scores, nb_boxes * SIM_NMS_SC_CLASSES * sizeof(float32_t));
+
+        for (int32_t k = 0; k < SIM_NMS_SC_CLASSES; k++)
+        {
+            SIM_CHECK(objdetect_nms_single_class(&sim_sc_scores[k], SIM_NMS_SC_CLASSES, sim_sc_boxes, 4, nb_boxes,
+                                                 conf_threshold, SIM_NMS_IOU_THRESHOLD, max_boxes_limit,
+                                                 sim_scratch) == AI_OBJDETECT_POSTPROCESS_ERROR_NO);
+            SIM_CHECK(objdetect_nms_single_class(&sim_sc_scores_noscratch[k], SIM_NMS_SC_CLASSES, sim_sc_boxes, 4,
+                                                 nb_boxes, conf_threshold, SIM_NMS_IOU_THRESHOLD, max_boxes_limit,
+                                                 NULL) == AI_OBJDETECT_POSTPROCESS_ERROR_NO);
+        }
+        SIM_CHECK(memcmp(sim_sc_scores, sim_sc_scores_noscratch,
+                         nb_boxes * SIM_NMS_SC_CLASSES * sizeof(float32_t)) == 0);
+    }
+}
+
+
+int main(void)
+{
+    static const int32_t nb_boxes[] = {100, 500, SIM_NMS_MAX_DETECT};
+    static const int32_t nb_classes[] = {1, 10, SIM_NMS_MAX_CLASSES};
+
+    for (uint32_t b = 0; b < sizeof(nb_boxes) / sizeof(*nb_boxes); b++)
+    {
+        for (uint32_t c = 0; c < sizeof(nb_classes) / sizeof(*nb_classes); c++)
+        {
+            sim_nms_run(nb_boxes[b], nb_classes[c], 20);
+        }
+    }
+
+    sim_nms_single_class_run(100, 0.5f, SIM_NMS_MAX_BOXES_LIMIT);
+    sim_nms_single_class_run(500, 0.0f, SIM_NMS_MAX_BOXES_LIMIT);
+    sim_nms_single_class_run(SIM_NMS_MAX_DETECT, 0.3f, 1000);
+    sim_nms_single_class_run(50, 0.2f, 0);
+
+    return sim_report("objdetect_pp_nms_bench");
+}
@@ -0,0 +1,71 @@
+/*---------------------------------------------------------------------------------------------
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *--------------------------------------------------------------------------------------------*/
+
+/* Checks, timings and report shared by the host tests and benchmarks of the post processing */
+
+#ifndef __OBJDETECT_PP_SIM_H__
+#define __OBJDETECT_PP_SIM_H__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+static uint32_t sim_nr_of_checks;
+static uint32_t sim_nr_of_failures;
+
+/* Counts and reports a failed condition, the test goes on */
+#define SIM_CHECK(_cond)                                                        \
+    do                                                                          \
+    {                                                                           \
+        sim_nr_of_checks++;                                                     \
+        if (!(_cond))                                                           \
+        {                                                                       \
+            sim_nr_of_failures++;                                               \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #_cond);   \
+        }                                                                       \
+    } while (0)
+
+
+static inline uint64_t sim_time_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+
+/* Deterministic generator, the runs are reproducible from one host to another */
+static inline uint32_t sim_rand(uint32_t *pState)
+{
+    *pState ^= *pState << 13;
+    *pState ^= *pState >> 17;
+    *pState ^= *pState << 5;
+
+    return *pState;
+}
+
+
+/* Uniform in [0, 1) */
+static inline float sim_randf(uint32_t *pState)
+{
+    return (float)(sim_rand(pState) >> 8) / (float)(1U << 24);
+}
+
+
+/* Prints the summary, returns the exit code of the test (1 on failure) */
+static inline int sim_report(const char *name)
+{
+    printf("%s: %lu checks, %lu failures\n", name, (unsigned long)sim_nr_of_checks, (unsigned long)sim_nr_of_failures);
+
+    return (sim_nr_of_failures != 0) ? 1 : 0;
+}
+
+#endif      /* __OBJDETECT_PP_SIM_H__  */
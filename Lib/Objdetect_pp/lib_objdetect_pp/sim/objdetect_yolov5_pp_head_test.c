@@ -0,0 +1,198 @@
+/*---------------------------------------------------------------------------------------------
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *--------------------------------------------------------------------------------------------*/
+
+/* YOLOv5 decoded one head at a time: objdetect_yolov5_pp_process_head(_uint8) over the successive heads, then
+ * objdetect_yolov5_pp_process_heads_end(), must give the same detections as objdetect_yolov5_pp_process(_uint8) on
+ * the concatenated heads, with and without pScratch. A head which could overflow the nb_total_boxes detections of
+ * the output buffer is rejected. */
+
+#include <string.h>
+#include "objdetect_pp_loc.h"
+#include "objdetect_yolov5_pp_if.h"
+#include "objdetect_pp_sim.h"
+
+
+#define SIM_HEAD_NB_CLASSES       (12)
+#define SIM_HEAD_DETECTION_LEN    (SIM_HEAD_NB_CLASSES + AI_YOLOV5_PP_BOX_STRIDE + 1)
+#define SIM_HEAD_NB_HEADS         (3)
+#define SIM_HEAD_NB_TOTAL_BOXES   (1200 + 300 + 75)
+#define SIM_HEAD_NB_RUNS          (20)
+
+
+/* Boxes of each head, from the finest grid to the coarsest one */
+static const int32_t sim_head_boxes[SIM_HEAD_NB_HEADS] = {1200, 300, 75};
+
+static float32_t sim_raw[SIM_HEAD_NB_TOTAL_BOXES * SIM_HEAD_DETECTION_LEN];
+static uint8_t sim_raw_u8[SIM_HEAD_NB_TOTAL_BOXES * SIM_HEAD_DETECTION_LEN];
+static postprocess_outBuffer_t sim_out_ref[SIM_HEAD_NB_TOTAL_BOXES];
+static postprocess_outBuffer_t sim_out_heads[SIM_HEAD_NB_TOTAL_BOXES];
+static int32_t sim_scratch[AI_OBJDETECT_YOLOV5_PP_SCRATCH_SIZE(SIM_HEAD_NB_CLASSES) + SIM_HEAD_NB_TOTAL_BOXES];
+
+
+/* Boxes clustered around a few objects, so that the NMS suppresses some of them, about a third above threshold */
+static void sim_head_generate(uint32_t *pState)
+{
+    for (int32_t i = 0; i < SIM_HEAD_NB_TOTAL_BOXES; i++)
+    {
+        float32_t *pDet = &sim_raw[i * SIM_HEAD_DETECTION_LEN];
+        uint32_t object = sim_rand(pState) % 16;
+
+        pDet[AI_YOLOV5_PP_XCENTER] = 0.1f + 0.05f * (float32_t)object + 0.02f * sim_randf(pState);
+        pDet[AI_YOLOV5_PP_YCENTER] = 0.8f - 0.04f * (float32_t)object + 0.02f * sim_randf(pState);
+        pDet[AI_YOLOV5_PP_WIDTHREL] = 0.1f + 0.05f * sim_randf(pState);
+        pDet[AI_YOLOV5_PP_HEIGHTREL] = 0.1f + 0.05f * sim_randf(pState);
+        pDet[AI_YOLOV5_PP_CONFIDENCE] = sim_randf(pState);
+        for (int32_t c = 0; c < SIM_HEAD_NB_CLASSES; c++)
+        {
+            pDet[AI_YOLOV5_PP_CLASSPROB + c] = 0.7f * sim_randf(pState);
+        }
+        pDet[AI_YOLOV5_PP_CLASSPROB + (object % SIM_HEAD_NB_CLASSES)] += 0.3f;
+    }
+
+    for (int32_t i = 0; i < SIM_HEAD_NB_TOTAL_BOXES * SIM_HEAD_DETECTION_LEN; i++)
+    {
+        sim_raw_u8[i] = (uint8_t)(sim_raw[i] * 255.0f);
+    }
+}
+
+
+static void sim_head_param_init(yolov5_pp_static_param_t *pParam, int32_t *pScratch)
+{
+    memset(pParam, 0, sizeof(*pParam));
+    pParam->nb_classes = SIM_HEAD_NB_CLASSES;
+    pParam->nb_total_boxes = SIM_HEAD_NB_TOTAL_BOXES;
+    pParam->max_boxes_limit = 10;
+    pParam->conf_threshold = 0.6f;
+    pParam->iou_threshold = 0.5f;
+    pParam->raw_output_scale = 1.0f / 255.0f;
+    pParam->raw_output_zero_point = 0;
+    pParam->pScratch = pScratch;
+    objdetect_yolov5_pp_reset(pParam);
+}
+
+
+static int sim_head_same(const postprocess_out_t *pRef, const postprocess_out_t *pOut)
+{
+    if (pRef->nb_detect != pOut->nb_detect)
+    {
+        return 0;
+    }
+
+    for (int32_t i = 0; i < pRef->nb_detect; i++)
+    {
+        const postprocess_outBuffer_t *a = &pRef->pOutBuff[i];
+        const postprocess_outBuffer_t *b = &pOut->pOutBuff[i];
+
+        if ((a->x_center != b->x_center) || (a->y_center != b->y_center) ||
+            (a->width != b->width) || (a->height != b->height) ||
+            (a->conf != b->conf) || (a->class_index != b->class_index))
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+
+static void sim_head_run(int32_t quantized, int32_t *pScratch)
+{
+    yolov5_pp_static_param_t param_ref, param_heads;
+    postprocess_out_t out_ref = {sim_out_ref, 0};
+    postprocess_out_t out_heads = {sim_out_heads, 0};
+    int32_t offset = 0;
+
+    sim_head_param_init(&param_ref, pScratch);
+    sim_head_param_init(&param_heads, pScratch);
+
+    if (quantized)
+    {
+        yolov5_pp_in_centroid_uint8_t in = {sim_raw_u8};
+
+        SIM_CHECK(objdetect_yolov5_pp_process_uint8(&in, &out_ref, &param_ref) == AI_OBJDETECT_POSTPROCESS_ERROR_NO);
+    }
+    else
+    {
+        yolov5_pp_in_centroid_t in = {sim_raw};
+
+        SIM_CHECK(objdetect_yolov5_pp_process(&in, &out_ref, &param_ref) == AI_OBJDETECT_POSTPROCESS_ERROR_NO);
+    }
+
+    for (int32_t h = 0; h < SIM_HEAD_NB_HEADS; h++)
+    {
+        int32_t error;
+
+        if (quantized)
+        {
+            yolov5_pp_in_centroid_uint8_t in = {&sim_raw_u8[offset * SIM_HEAD_DETECTION_LEN]};
+
+            error = objdetect_yolov5_pp_process_head_uint8(&in, sim_head_boxes[h], &out_heads, &param_heads);
+        }
+        else
+        {
+            yolov5_pp_in_centroid_t in = {&sim_raw[offset * SIM_HEAD_DETECTION_LEN]};
+
+            error = objdetect_yolov5_pp_process_head(&in, sim_head_boxes[h], &out_heads, &param_heads);
+        }
+        SIM_CHECK(error == AI_OBJDETECT_POSTPROCESS_ERROR_NO);
+        offset += sim_head_boxes[h];
+    }
+    SIM_CHECK(objdetect_yolov5_pp_process_heads_end(&out_heads, &param_heads) == AI_OBJDETECT_POSTPROCESS_ERROR_NO);
+
+    SIM_CHECK(out_ref.nb_detect > 0);
+    SIM_CHECK(sim_head_same(&out_ref, &out_heads));
+}
+
+
+/* A head which could overflow the output buffer is rejected, nothing is appended */
+static void sim_head_overflow(void)
+{
+    yolov5_pp_static_param_t param;
+    postprocess_out_t out = {sim_out_heads, 0};
+    yolov5_pp_in_centroid_t in = {sim_raw};
+    yolov5_pp_in_centroid_uint8_t in_u8 = {sim_raw_u8};
+
+    sim_head_param_init(&param, sim_scratch);
+    SIM_CHECK(objdetect_yolov5_pp_process_head(&in, SIM_HEAD_NB_TOTAL_BOXES, &out, &param) ==
+              AI_OBJDETECT_POSTPROCESS_ERROR_NO);
+
+    int32_t nb_detect = param.nb_detect;
+    int32_t nb_free = SIM_HEAD_NB_TOTAL_BOXES - nb_detect;
+
+    SIM_CHECK(nb_detect > 0);
+    SIM_CHECK(objdetect_yolov5_pp_process_head(&in, nb_free + 1, &out, &param) == AI_OBJDETECT_POSTPROCESS_ERROR);
+    SIM_CHECK(objdetect_yolov5_pp_process_head_uint8(&in_u8, nb_free + 1, &out, &param) ==
+              AI_OBJDETECT_POSTPROCESS_ERROR);
+    SIM_CHECK(param.nb_detect == nb_detect);
+    SIM_CHECK(objdetect_yolov5_pp_process_head(&in, nb_free, &out, &param) == AI_OBJDETECT_POSTPROCESS_ERROR_NO);
+    SIM_CHECK(param.nb_detect <= SIM_HEAD_NB_TOTAL_BOXES);
+
+    /* objdetect_yolov5_pp_reset() starts a new frame */
+    objdetect_yolov5_pp_reset(&param);
+    SIM_CHECK(objdetect_yolov5_pp_process_head(&in, SIM_HEAD_NB_TOTAL_BOXES, &out, &param) ==
+              AI_OBJDETECT_POSTPROCESS_ERROR_NO);
+}
+
+
+int main(void)
+{
+    uint32_t state = 0x2545F491u;
+
+    for (int32_t run = 0; run < SIM_HEAD_NB_RUNS; run++)
+    {
+        sim_head_generate(&state);
+        sim_head_run(0, sim_scratch);
+        sim_head_run(0, NULL);
+        sim_head_run(1, sim_scratch);
+        sim_head_run(1, NULL);
+    }
+    sim_head_overflow();
+
+    return sim_report("objdetect_yolov5_pp_head_test");
+}
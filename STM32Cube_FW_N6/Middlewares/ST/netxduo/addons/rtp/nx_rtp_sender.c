@@ -67,6 +67,11 @@ static UINT _nx_rtcp_sdes_data_append(NX_RTP_SESSION *session, NX_PACKET *packet
 static UINT _nx_rtcp_packet_send(NX_RTP_SESSION *session);
 static VOID _nx_rtcp_packet_receive_notify(NX_UDP_SOCKET *socket_ptr);
 
+static UCHAR *_nx_rtp_sender_h264_start_code_find(UCHAR *data_ptr, UCHAR *data_end);
+static UINT _nx_rtp_sender_session_h264_nal_unit_send(NX_RTP_SESSION *session, UCHAR *nal_unit, ULONG nal_unit_size,
+                                                      ULONG timestamp, ULONG ntp_msw, ULONG ntp_lsw, UINT last);
+static UINT _nx_rtp_sender_session_reference_append(NX_RTP_SESSION *session, NX_PACKET *packet_ptr, UCHAR *data, ULONG data_size);
+
 
 /**************************************************************************/
 /*                                                                        */
@@ -1204,16 +1209,26 @@ UINT status;
 /*    DATE              NAME                      DESCRIPTION             */
 /*                                                                        */
 /*  10-31-2023     Haiqing Zhao            Initial Version 6.3.0          */
+/*  10-17-2026     MCD Application Team    Modified comment(s),           */
+/*                                           supported header extension,  */
+/*                                           resulting in version 6.4.0   */
 /*                                                                        */
 /**************************************************************************/
 UINT _nx_rtp_sender_session_packet_allocate(NX_RTP_SESSION *session, NX_PACKET **packet_ptr, ULONG wait_option)
 {
 
-UINT status;
+UINT  status;
+ULONG packet_type = NX_RTP_PACKET;
+
 
+    /* Keep room for the header extension of the next frame. */
+    if (session -> nx_rtp_session_header_extension_ptr)
+    {
+        packet_type += NX_RTP_HEADER_EXTENSION_HEADER_LENGTH + session -> nx_rtp_session_header_extension_length;
+    }
 
     /* Allocate and get the packet from IP default packet pool. */
-    status = nx_packet_allocate(session -> nx_rtp_sender -> nx_rtp_sender_packet_pool_ptr, packet_ptr, NX_RTP_PACKET, wait_option);
+    status = nx_packet_allocate(session -> nx_rtp_sender -> nx_rtp_sender_packet_pool_ptr, packet_ptr, packet_type, wait_option);
 
     return(status);
 }
@@ -1324,6 +1339,7 @@ UINT status;
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    NX_CHANGE_USHORT_ENDIAN              Adjust USHORT variable endian  */
+/*    memcpy                               Copy header extension          */
 /*    _nx_rtcp_packet_send                 Send RTCP report               */
 /*    nxd_udp_socket_source_send           Send RTP packet through UDP    */
 /*                                                                        */
@@ -1339,6 +1355,9 @@ UINT status;
 /*  12-31-2023     Haiqing Zhao            Modified comments(s),          */
 /*                                           supported VLAN,              */
 /*                                           resulting in version 6.4.0   */
+/*  10-17-2026     MCD Application Team    Modified comment(s),           */
+/*                                           supported header extension,  */
+/*                                           resulting in version 6.4.0   */
 /*                                                                        */
 /**************************************************************************/
 UINT _nx_rtp_sender_session_packet_send(NX_RTP_SESSION *session, NX_PACKET *packet_ptr, ULONG timestamp, ULONG ntp_msw, ULONG ntp_lsw, UINT marker)
@@ -1355,6 +1374,8 @@ ULONG          remaining_bytes = packet_ptr -> nx_packet_length;
 ULONG          payload_data_length;
 ULONG          copy_size;
 UINT           fragmentation = NX_FALSE;
+ULONG          extension_length;
+UCHAR         *extension_ptr;
 
 
     /* Transfer marker bit into rtp header field. */
@@ -1437,6 +1458,43 @@ UINT           fragmentation = NX_FALSE;
 
         /* Obtain payload data length and decrease remaining bytes with it. */
         payload_data_length = send_packet -> nx_packet_length;
+
+        /* Add the header extension of the frame to its first packet.
+             0                   1                   2                   3
+             0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+            +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+            |      defined by profile       |           length              |
+            +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+            |                        header extension                       |
+            |                             ....                              |
+        */
+        extension_length = 0;
+        if (session -> nx_rtp_session_header_extension_ptr)
+        {
+            extension_length = NX_RTP_HEADER_EXTENSION_HEADER_LENGTH + session -> nx_rtp_session_header_extension_length;
+
+            /* Check the room left by the packet allocation for the extension and the headers. */
+            if ((ULONG)(send_packet -> nx_packet_prepend_ptr - send_packet -> nx_packet_data_start) < (NX_RTP_PACKET + extension_length))
+            {
+                if (fragmentation)
+                {
+                    nx_packet_release(send_packet);
+                }
+
+                return(NX_UNDERFLOW);
+            }
+
+            send_packet -> nx_packet_length += extension_length;
+            send_packet -> nx_packet_prepend_ptr -= extension_length;
+            extension_ptr = send_packet -> nx_packet_prepend_ptr;
+            extension_ptr[0] = (UCHAR)(session -> nx_rtp_session_header_extension_profile >> 8);
+            extension_ptr[1] = (UCHAR)(session -> nx_rtp_session_header_extension_profile);
+            extension_ptr[2] = (UCHAR)((session -> nx_rtp_session_header_extension_length >> 2) >> 8);
+            extension_ptr[3] = (UCHAR)(session -> nx_rtp_session_header_extension_length >> 2);
+            memcpy(extension_ptr + NX_RTP_HEADER_EXTENSION_HEADER_LENGTH, session -> nx_rtp_session_header_extension_ptr,
+                   session -> nx_rtp_session_header_extension_length); /* Use case of memcpy is verified. */
+        }
+
         remaining_bytes -= payload_data_length;
 
         /* Add rtp header information.
@@ -1459,9 +1517,13 @@ UINT           fragmentation = NX_FALSE;
         /* Fill field 0 which contains following 4 sub-fields (3 of them are considered no need to support so far).
         1) The RTP protocol version number is always 2.
         2) The padding feature is ignored (i.e not supported) by using lower level padding if required (e.g. tls)
-        3) The extension bit/feature is set to zero (i.e. not supported)
+        3) The extension bit is set when a header extension follows the fixed header
         4) The contributing source identifiers count is set to zero (i.e. not supported) */
         rtp_header_ptr -> nx_rtp_header_field0 = (NX_RTP_VERSION << 6);
+        if (extension_length)
+        {
+            rtp_header_ptr -> nx_rtp_header_field0 |= NX_RTP_HEADER_EXTENSION_BIT;
+        }
 
         /* Fill the second byte by the payload type recorded in the session context. */
         rtp_header_ptr -> nx_rtp_header_field1 = session -> nx_rtp_session_payload_type;
@@ -1521,14 +1583,22 @@ UINT           fragmentation = NX_FALSE;
             {
 
                 /* Reset the user packet prepend pointer and the total packet length. */
-                packet_ptr -> nx_packet_prepend_ptr += NX_RTP_HEADER_LENGTH;
-                packet_ptr -> nx_packet_length -= NX_RTP_HEADER_LENGTH;
+                packet_ptr -> nx_packet_prepend_ptr += NX_RTP_HEADER_LENGTH + extension_length;
+                packet_ptr -> nx_packet_length -= NX_RTP_HEADER_LENGTH + extension_length;
             }
 
             /* Return error status and let the user to determine when to release the packet. */
             return(status);
         }
 
+        /* The header extension is sent, give its room back to the next packets. */
+        if (extension_length)
+        {
+            session -> nx_rtp_session_header_extension_ptr = NX_NULL;
+            session -> nx_rtp_session_header_extension_length = 0;
+            session -> nx_rtp_session_max_packet_size += extension_length;
+        }
+
         /* Update sender report statistic. */
         session -> nx_rtp_session_packet_count++;
         session -> nx_rtp_session_octet_count += payload_data_length;
@@ -2006,6 +2076,151 @@ UINT _nx_rtp_sender_session_vlan_priority_set(NX_RTP_SESSION *session, UINT vlan
 #endif /* NX_ENABLE_VLAN */
 }
 
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nxe_rtp_sender_session_header_extension_set       PORTABLE C       */
+/*                                                           6.4.0        */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    MCD Application Team, STMicroelectronics                            */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks errors in the RTP sender session header        */
+/*    extension set function call.                                        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    session                              Pointer to RTP session         */
+/*    profile                              Profile defined 16-bit value   */
+/*    data                                 Pointer to extension data, or  */
+/*                                           NX_NULL to cancel it         */
+/*    data_length                          Size of extension data         */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                               Completion status              */
+/*    NX_PTR_ERROR                         Invalid pointer input          */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_rtp_sender_session_header_extension_set                         */
+/*                                         Set the header extension       */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  10-17-2026     MCD Application Team    Initial Version 6.4.0          */
+/*                                                                        */
+/**************************************************************************/
+UINT _nxe_rtp_sender_session_header_extension_set(NX_RTP_SESSION *session, USHORT profile, UCHAR *data, ULONG data_length)
+{
+
+UINT status;
+
+
+    /* Check for invalid input pointers. */
+    if ((session == NX_NULL) || (session -> nx_rtp_sender == NX_NULL) || (session -> nx_rtp_session_id != NX_RTP_SESSION_ID))
+    {
+        return(NX_PTR_ERROR);
+    }
+
+    /* Call actual RTP sender session header extension set service. */
+    status = _nx_rtp_sender_session_header_extension_set(session, profile, data, data_length);
+
+    /* Return status. */
+    return(status);
+}
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_rtp_sender_session_header_extension_set        PORTABLE C       */
+/*                                                           6.4.0        */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    MCD Application Team, STMicroelectronics                            */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function sets the header extension added to the first RTP     */
+/*    packet sent after it in the specific session, e.g. metadata of the  */
+/*    next frame carried with the frame timestamp. The data is not        */
+/*    copied: it shall be kept until the packet is sent.                  */
+/*                                                                        */
+/*    Until then the maximum packet size of the session is reduced by the */
+/*    extension size, so that the frame is split in packets leaving room  */
+/*    for it, and the packets allocated in the session get the room to    */
+/*    prepend it.                                                         */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    session                              Pointer to RTP session         */
+/*    profile                              Profile defined 16-bit value   */
+/*    data                                 Pointer to extension data, or  */
+/*                                           NX_NULL to cancel it         */
+/*    data_length                          Size of extension data,        */
+/*                                           multiple of 4 bytes          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                               Completion status              */
+/*    NX_SIZE_ERROR                        Invalid extension size         */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  10-17-2026     MCD Application Team    Initial Version 6.4.0          */
+/*                                                                        */
+/**************************************************************************/
+UINT _nx_rtp_sender_session_header_extension_set(NX_RTP_SESSION *session, USHORT profile, UCHAR *data, ULONG data_length)
+{
+
+    /* Give back the room of the extension not sent yet. */
+    if (session -> nx_rtp_session_header_extension_ptr)
+    {
+        session -> nx_rtp_session_max_packet_size += NX_RTP_HEADER_EXTENSION_HEADER_LENGTH + session -> nx_rtp_session_header_extension_length;
+        session -> nx_rtp_session_header_extension_ptr = NX_NULL;
+        session -> nx_rtp_session_header_extension_length = 0;
+    }
+
+    if (data == NX_NULL)
+    {
+        return(NX_SUCCESS);
+    }
+
+    /* The extension length is counted in 32-bit words, and the packets shall keep room for payload data. */
+    if ((data_length & 3) || ((NX_RTP_HEADER_EXTENSION_HEADER_LENGTH + data_length) >= session -> nx_rtp_session_max_packet_size))
+    {
+        return(NX_SIZE_ERROR);
+    }
+
+    /* Store the extension, and reserve its room in the packets of the frame. */
+    session -> nx_rtp_session_header_extension_ptr = data;
+    session -> nx_rtp_session_header_extension_length = data_length;
+    session -> nx_rtp_session_header_extension_profile = profile;
+    session -> nx_rtp_session_max_packet_size -= NX_RTP_HEADER_EXTENSION_HEADER_LENGTH + data_length;
+
+    return(NX_SUCCESS);
+}
+
 /**************************************************************************/
 /*                                                                        */
 /*  FUNCTION                                               RELEASE        */
@@ -3911,6 +4126,643 @@ NX_PACKET *send_packet = NX_NULL;
     return(NX_SUCCESS);
 }
 
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nxe_rtp_sender_session_h264_nal_send              PORTABLE C       */
+/*                                                           6.4.0        */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    MCD Application Team, STMicroelectronics                            */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function checks errors in the RTP sender session h264 nal      */
+/*    send function call.                                                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    session                              Pointer to RTP session         */
+/*    frame_data                           Pointer to data buffer to send */
+/*    frame_data_size                      Size of data to send           */
+/*    nal_unit_size_table                  Size of each NAL unit, or      */
+/*                                           NX_NULL to search them       */
+/*    nal_unit_count                       Number of NAL unit sizes       */
+/*    timestamp                            RTP timestamp for current data */
+/*    ntp_msw                              Most significant word of       */
+/*                                           network time                 */
+/*    ntp_lsw                              Least significant word of      */
+/*                                           network time                 */
+/*    marker                               Marker bit for significant     */
+/*                                           event such as frame boundary */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                               Completion status              */
+/*    NX_PTR_ERROR                         Invalid pointer input          */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_rtp_sender_session_h264_nal_send Send h264 NAL units            */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  10-17-2026     MCD Application Team    Initial Version 6.4.0          */
+/*                                                                        */
+/**************************************************************************/
+UINT _nxe_rtp_sender_session_h264_nal_send(NX_RTP_SESSION *session, UCHAR *frame_data, ULONG frame_data_size,
+                                           ULONG *nal_unit_size_table, UINT nal_unit_count,
+                                           ULONG timestamp, ULONG ntp_msw, ULONG ntp_lsw, UINT marker)
+{
+
+UINT status;
+
+
+    /* Check for invalid input pointers. */
+    if ((session == NX_NULL) || (session -> nx_rtp_sender == NX_NULL) || (session -> nx_rtp_session_id != NX_RTP_SESSION_ID) || (frame_data == NX_NULL))
+    {
+        return(NX_PTR_ERROR);
+    }
+
+    /* Call actual RTP sender session h264 nal send service. */
+    status = _nx_rtp_sender_session_h264_nal_send(session, frame_data, frame_data_size, nal_unit_size_table, nal_unit_count,
+                                                  timestamp, ntp_msw, ntp_lsw, marker);
+
+    /* Return status. */
+    return(status);
+}
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_rtp_sender_session_h264_nal_send               PORTABLE C       */
+/*                                                           6.4.0        */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    MCD Application Team, STMicroelectronics                            */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function sends the NAL units of a h264 frame in RTP packets    */
+/*    (single NAL unit and FU-A packets, RFC 6184 non-interleaved mode),  */
+/*    like _nx_rtp_sender_session_h264_send, without copying the frame:   */
+/*    1) The NAL unit boundaries are taken from the size table filled by  */
+/*       the encoder (e.g. H264EncOut pNaluSizeBuf and numNalus), each    */
+/*       size including the start code of the NAL unit. Without a table,  */
+/*       the start codes are searched a word at a time.                   */
+/*    2) The payload of each RTP packet is a packet chained to the RTP    */
+/*       header packet, referencing the frame data buffer, when the UDP   */
+/*       checksum is computed by the interface or disabled. Payloads up   */
+/*       to NX_RTP_SENDER_H264_COPY_THRESHOLD bytes (e.g. SPS and PPS)    */
+/*       are copied.                                                      */
+/*    The frame data buffer shall not be modified until the driver has    */
+/*    released the packets referencing it (e.g. use two encoder output    */
+/*    buffers in turn).                                                   */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    session                              Pointer to RTP session         */
+/*    frame_data                           Pointer to data buffer to send */
+/*    frame_data_size                      Size of data to send           */
+/*    nal_unit_size_table                  Size of each NAL unit, or      */
+/*                                           NX_NULL to search them       */
+/*    nal_unit_count                       Number of NAL unit sizes       */
+/*    timestamp                            RTP timestamp for current data */
+/*    ntp_msw                              Most significant word of       */
+/*                                           network time                 */
+/*    ntp_lsw                              Least significant word of      */
+/*                                           network time                 */
+/*    marker                               Marker bit for significant     */
+/*                                           event such as frame boundary */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                               Completion status              */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_rtp_sender_h264_start_code_find  Find the next start code       */
+/*    _nx_rtp_sender_session_h264_nal_unit_send                           */
+/*                                         Send a NAL unit                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  10-17-2026     MCD Application Team    Initial Version 6.4.0          */
+/*                                                                        */
+/**************************************************************************/
+UINT _nx_rtp_sender_session_h264_nal_send(NX_RTP_SESSION *session, UCHAR *frame_data, ULONG frame_data_size,
+                                          ULONG *nal_unit_size_table, UINT nal_unit_count,
+                                          ULONG timestamp, ULONG ntp_msw, ULONG ntp_lsw, UINT marker)
+{
+
+UINT   status;
+UINT   i;
+UINT   last;
+UCHAR *frame_end = frame_data + frame_data_size;
+UCHAR *data_ptr = frame_data;
+UCHAR *nal_unit_start;
+UCHAR *nal_unit_end;
+UCHAR *next_nal_unit;
+
+
+    /* In current design, the marker bit shall be always 1 (i.e. a complete h264 frame required to be passed). */
+    if (marker != NX_TRUE)
+    {
+        return(NX_NOT_SUPPORTED);
+    }
+
+    if (nal_unit_size_table)
+    {
+
+        /* Check the NAL unit sizes against the frame size. */
+        for (i = 0; i < nal_unit_count; i++)
+        {
+            if (nal_unit_size_table[i] > (ULONG)(frame_end - data_ptr))
+            {
+                return(NX_SIZE_ERROR);
+            }
+            data_ptr += nal_unit_size_table[i];
+        }
+        data_ptr = frame_data;
+
+        for (i = 0; i < nal_unit_count; i++)
+        {
+
+            /* Skip the 4 bytes or 3 bytes start code of the NAL unit. */
+            nal_unit_start = data_ptr;
+            nal_unit_end = data_ptr + nal_unit_size_table[i];
+            data_ptr = nal_unit_end;
+            if (((nal_unit_end - nal_unit_start) >= 4) &&
+                (nal_unit_start[0] == 0x00) && (nal_unit_start[1] == 0x00) && (nal_unit_start[2] == 0x00) && (nal_unit_start[3] == 0x01))
+            {
+                nal_unit_start += 4;
+            }
+            else if (((nal_unit_end - nal_unit_start) >= 3) &&
+                     (nal_unit_start[0] == 0x00) && (nal_unit_start[1] == 0x00) && (nal_unit_start[2] == 0x01))
+            {
+                nal_unit_start += 3;
+            }
+
+            /* Skip empty NAL units. */
+            if (nal_unit_start == nal_unit_end)
+            {
+                continue;
+            }
+
+            /* The last non-empty NAL unit ends the frame. */
+            last = NX_TRUE;
+            while (((i + 1) < nal_unit_count) && (nal_unit_size_table[i + 1] == 0))
+            {
+                i++;
+            }
+            if ((i + 1) < nal_unit_count)
+            {
+                last = NX_FALSE;
+            }
+
+            status = _nx_rtp_sender_session_h264_nal_unit_send(session, nal_unit_start, (ULONG)(nal_unit_end - nal_unit_start),
+                                                                timestamp, ntp_msw, ntp_lsw, last);
+            if (status)
+            {
+                return(status);
+            }
+        }
+
+        /* Return success status. */
+        return(NX_SUCCESS);
+    }
+
+    /* No NAL unit sizes, the frame shall start with a start code. */
+    nal_unit_start = _nx_rtp_sender_h264_start_code_find(frame_data, frame_end);
+    if ((frame_data_size <= 4) || (nal_unit_start > (frame_data + 1)) || (frame_data[0] != 0x00))
+    {
+        return(NX_NOT_SUCCESSFUL);
+    }
+    nal_unit_start += 3;
+
+    while (nal_unit_start < frame_end)
+    {
+
+        /* The NAL unit ends before the next start code and its leading zero bytes. */
+        next_nal_unit = _nx_rtp_sender_h264_start_code_find(nal_unit_start, frame_end);
+        nal_unit_end = next_nal_unit;
+        while ((nal_unit_end > nal_unit_start) && (nal_unit_end[-1] == 0x00))
+        {
+            nal_unit_end--;
+        }
+
+        if (nal_unit_end > nal_unit_start)
+        {
+            status = _nx_rtp_sender_session_h264_nal_unit_send(session, nal_unit_start, (ULONG)(nal_unit_end - nal_unit_start),
+                                                                timestamp, ntp_msw, ntp_lsw, (next_nal_unit == frame_end));
+            if (status)
+            {
+                return(status);
+            }
+        }
+
+        if (next_nal_unit == frame_end)
+        {
+            break;
+        }
+        nal_unit_start = next_nal_unit + 3;
+    }
+
+    /* Return success status. */
+    return(NX_SUCCESS);
+}
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_rtp_sender_h264_start_code_find                PORTABLE C       */
+/*                                                           6.4.0        */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    MCD Application Team, STMicroelectronics                            */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function finds the next 0x000001 start code in h264 data. The  */
+/*    data is read a 32-bit word at a time: a start code begins with a    */
+/*    zero byte, and the words without zero byte (most of the coded data) */
+/*    are skipped with a single test.                                     */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    data_ptr                             Pointer to the data to search  */
+/*    data_end                             End of the data                */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    pointer                              First byte of the start code,  */
+/*                                           data_end if not found        */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_rtp_sender_session_h264_nal_send Send h264 NAL units            */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  10-17-2026     MCD Application Team    Initial Version 6.4.0          */
+/*                                                                        */
+/**************************************************************************/
+UCHAR *_nx_rtp_sender_h264_start_code_find(UCHAR *data_ptr, UCHAR *data_end)
+{
+
+UINT word;
+
+
+    /* A start code needs 3 bytes. */
+    if ((data_end - data_ptr) < 3)
+    {
+        return(data_end);
+    }
+
+    /* Stop before the last 2 bytes, a start code found at data_ptr can be read entirely. */
+    data_end -= 2;
+
+    while (data_ptr < data_end)
+    {
+
+        /* Skip the aligned words without zero byte. */
+        /*lint -e{923} suppress cast between pointer and ULONG, since it is necessary  */
+        if ((((ALIGN_TYPE)data_ptr & 3) == 0) && ((data_end - data_ptr) >= 4))
+        {
+            word = *(UINT *)data_ptr;
+            if (((word - 0x01010101u) & ~word & 0x80808080u) == 0)
+            {
+                data_ptr += 4;
+                continue;
+            }
+        }
+
+        if ((data_ptr[0] == 0x00) && (data_ptr[1] == 0x00) && (data_ptr[2] == 0x01))
+        {
+            return(data_ptr);
+        }
+
+        data_ptr++;
+    }
+
+    return(data_end + 2);
+}
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_rtp_sender_session_h264_nal_unit_send          PORTABLE C       */
+/*                                                           6.4.0        */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    MCD Application Team, STMicroelectronics                            */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function sends a NAL unit (without start code) in a single NAL */
+/*    unit packet, or in FU-A packets when it exceeds the maximum packet  */
+/*    size. The fragments are the ones of _nx_rtp_sender_session_h264_send*/
+/*    and their payload references the NAL unit data.                     */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    session                              Pointer to RTP session         */
+/*    nal_unit                             Pointer to the NAL unit        */
+/*    nal_unit_size                        Size of the NAL unit           */
+/*    timestamp                            RTP timestamp for current data */
+/*    ntp_msw                              Most significant word of       */
+/*                                           network time                 */
+/*    ntp_lsw                              Least significant word of      */
+/*                                           network time                 */
+/*    last                                 Last NAL unit of the frame     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                               Completion status              */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_rtp_sender_session_packet_allocate                              */
+/*                                         Allocate a packet for the user */
+/*    nx_packet_data_append                Copy the specified data to     */
+/*                                            the end of specified packet */
+/*    _nx_rtp_sender_session_reference_append                             */
+/*                                         Chain a packet referencing     */
+/*                                            the specified data          */
+/*    nx_packet_release                    Release the packet             */
+/*    _nx_rtp_sender_session_packet_send   Send RTP packet                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_rtp_sender_session_h264_nal_send Send h264 NAL units            */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  10-17-2026     MCD Application Team    Initial Version 6.4.0          */
+/*                                                                        */
+/**************************************************************************/
+UINT _nx_rtp_sender_session_h264_nal_unit_send(NX_RTP_SESSION *session, UCHAR *nal_unit, ULONG nal_unit_size,
+                                               ULONG timestamp, ULONG ntp_msw, ULONG ntp_lsw, UINT last)
+{
+
+UINT       status;
+ULONG      max_packet_length = session -> nx_rtp_session_max_packet_size;
+ULONG      fragment_length;
+ULONG      offset;
+ULONG      send_packet_length;
+UCHAR      nal_unit_type = nal_unit[0];
+UCHAR      fu_a_header[2];
+UINT       send_marker = last;
+UINT       temp_marker;
+NX_PACKET *send_packet;
+
+
+    /* Special frames do not end the frame. */
+    if (((nal_unit_type & NX_RTP_SENDER_H264_TYPE_MASK_BITS) == NX_RTP_SENDER_H264_TYPE_SEI) ||
+        ((nal_unit_type & NX_RTP_SENDER_H264_TYPE_MASK_BITS) == NX_RTP_SENDER_H264_TYPE_SPS) ||
+        ((nal_unit_type & NX_RTP_SENDER_H264_TYPE_MASK_BITS) == NX_RTP_SENDER_H264_TYPE_PPS))
+    {
+        send_marker = NX_FALSE;
+    }
+
+    if (nal_unit_size <= max_packet_length)
+    {
+
+        /* Single NAL unit packet. */
+        status = _nx_rtp_sender_session_packet_allocate(session, &send_packet, NX_RTP_SENDER_PACKET_TIMEOUT);
+        if (status)
+        {
+            return(status);
+        }
+
+        if (nal_unit_size <= NX_RTP_SENDER_H264_COPY_THRESHOLD)
+        {
+            status = nx_packet_data_append(send_packet, (void *)nal_unit, nal_unit_size,
+                                           session -> nx_rtp_sender -> nx_rtp_sender_packet_pool_ptr,
+                                           NX_RTP_SENDER_PACKET_TIMEOUT);
+        }
+        else
+        {
+            status = _nx_rtp_sender_session_reference_append(session, send_packet, nal_unit, nal_unit_size);
+        }
+        if (status)
+        {
+            nx_packet_release(send_packet);
+            return(status);
+        }
+
+        status = _nx_rtp_sender_session_packet_send(session, send_packet, timestamp, ntp_msw, ntp_lsw, send_marker);
+        if (status)
+        {
+            nx_packet_release(send_packet);
+        }
+
+        return(status);
+    }
+
+    /* FU-A packets: each fragment carries up to max_packet_length - 2 bytes of the NAL unit, the NAL unit header byte
+       of the first fragment being replaced by the fu-a header. */
+    fragment_length = max_packet_length - sizeof(fu_a_header);
+    fu_a_header[0] = (UCHAR)((nal_unit_type & NX_RTP_SENDER_H264_NRI_MASK_BITS) | NX_RTP_SENDER_H264_TYPE_FU_A);
+
+    for (offset = 0; offset < nal_unit_size; offset += fragment_length)
+    {
+
+        /* Set the fu-a header with the start and end bits and the source nal unit type. */
+        fu_a_header[1] = (UCHAR)(nal_unit_type & NX_RTP_SENDER_H264_TYPE_MASK_BITS);
+        temp_marker = NX_FALSE;
+        if (offset == 0)
+        {
+            fu_a_header[1] |= NX_RTP_SENDER_H264_FU_A_S_MASK_BIT;
+        }
+        if ((nal_unit_size - offset) <= fragment_length)
+        {
+            fu_a_header[1] |= NX_RTP_SENDER_H264_FU_A_E_MASK_BIT;
+            temp_marker = send_marker;
+            send_packet_length = nal_unit_size - offset;
+        }
+        else
+        {
+            send_packet_length = fragment_length;
+        }
+
+        /* Allocate a packet */
+        status = _nx_rtp_sender_session_packet_allocate(session, &send_packet, NX_RTP_SENDER_PACKET_TIMEOUT);
+        if (status)
+        {
+            return(status);
+        }
+
+        /* Copy fu-a header into the packet, the fragment payload follows in the referenced data. */
+        status = nx_packet_data_append(send_packet, (void *)fu_a_header, sizeof(fu_a_header),
+                                       session -> nx_rtp_sender -> nx_rtp_sender_packet_pool_ptr,
+                                       NX_RTP_SENDER_PACKET_TIMEOUT);
+        if (status == NX_SUCCESS)
+        {
+            if (offset == 0)
+            {
+                status = _nx_rtp_sender_session_reference_append(session, send_packet, nal_unit + 1, send_packet_length - 1);
+            }
+            else
+            {
+                status = _nx_rtp_sender_session_reference_append(session, send_packet, nal_unit + offset, send_packet_length);
+            }
+        }
+        if (status)
+        {
+            nx_packet_release(send_packet);
+            return(status);
+        }
+
+        /* Send packet data */
+        status = _nx_rtp_sender_session_packet_send(session, send_packet, timestamp, ntp_msw, ntp_lsw, temp_marker);
+        if (status)
+        {
+            nx_packet_release(send_packet);
+            return(status);
+        }
+    }
+
+    /* Return success status. */
+    return(NX_SUCCESS);
+}
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_rtp_sender_session_reference_append            PORTABLE C       */
+/*                                                           6.4.0        */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    MCD Application Team, STMicroelectronics                            */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function appends data to a packet without copying it: a packet */
+/*    of the sender pool is chained at the end of the packet, its prepend */
+/*    and append pointers delimiting the data. The chained packet gets    */
+/*    its own buffer back when it is allocated again, and nothing shall   */
+/*    be appended to the packet after it.                                 */
+/*    The UDP checksum computed in software reads the chained packets by  */
+/*    aligned words and pads their end: the data is copied instead when   */
+/*    the checksum is not disabled or computed by the interface.          */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    session                              Pointer to RTP session         */
+/*    packet_ptr                           Pointer to the packet          */
+/*    data                                 Pointer to the data            */
+/*    data_size                            Size of the data               */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                               Completion status              */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    nx_packet_allocate                   Allocate a packet              */
+/*    nx_packet_data_append                Copy the specified data to     */
+/*                                            the end of specified packet */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_rtp_sender_session_h264_nal_unit_send                           */
+/*                                         Send a NAL unit                */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  10-17-2026     MCD Application Team    Initial Version 6.4.0          */
+/*                                                                        */
+/**************************************************************************/
+UINT _nx_rtp_sender_session_reference_append(NX_RTP_SESSION *session, NX_PACKET *packet_ptr, UCHAR *data, ULONG data_size)
+{
+
+UINT       status;
+NX_PACKET *reference_packet;
+UINT       reference = NX_FALSE;
+
+
+#ifndef NX_IPSEC_ENABLE
+#ifdef NX_DISABLE_UDP_TX_CHECKSUM
+    reference = NX_TRUE;
+#else
+
+    /* Check if the checksum is disabled on the socket (IPv4 only) or computed by the interface. */
+    if ((session -> nx_rtp_sender -> nx_rtp_sender_rtp_socket.nx_udp_socket_disable_checksum) &&
+        (session -> nx_rtp_session_peer_ip_address.nxd_ip_version == NX_IP_VERSION_V4))
+    {
+        reference = NX_TRUE;
+    }
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+    if (session -> nx_rtp_sender -> nx_rtp_sender_ip_ptr -> nx_ip_interface[session -> nx_rtp_session_interface_index].nx_interface_capability_flag &
+        NX_INTERFACE_CAPABILITY_UDP_TX_CHECKSUM)
+    {
+        reference = NX_TRUE;
+    }
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+#endif /* NX_DISABLE_UDP_TX_CHECKSUM */
+#endif /* NX_IPSEC_ENABLE */
+
+    if (reference == NX_FALSE)
+    {
+        return(nx_packet_data_append(packet_ptr, (void *)data, data_size,
+                                     session -> nx_rtp_sender -> nx_rtp_sender_packet_pool_ptr,
+                                     NX_RTP_SENDER_PACKET_TIMEOUT));
+    }
+
+    status = nx_packet_allocate(session -> nx_rtp_sender -> nx_rtp_sender_packet_pool_ptr, &reference_packet,
+                                NX_RECEIVE_PACKET, NX_RTP_SENDER_PACKET_TIMEOUT);
+    if (status)
+    {
+        return(status);
+    }
+
+    /* Point the packet to the data. */
+    reference_packet -> nx_packet_prepend_ptr = data;
+    reference_packet -> nx_packet_append_ptr = data + data_size;
+
+    /* Link it at the end of the packet chain. */
+    if (packet_ptr -> nx_packet_last)
+    {
+        (packet_ptr -> nx_packet_last) -> nx_packet_next = reference_packet;
+    }
+    else
+    {
+        packet_ptr -> nx_packet_next = reference_packet;
+    }
+    packet_ptr -> nx_packet_last = reference_packet;
+    packet_ptr -> nx_packet_length += data_size;
+
+    return(NX_SUCCESS);
+}
+
 /**************************************************************************/
 /*                                                                        */
 /*  FUNCTION                                               RELEASE        */
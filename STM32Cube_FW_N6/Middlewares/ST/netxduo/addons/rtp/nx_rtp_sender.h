@@ -87,6 +87,11 @@ extern   "C" {
 #define NX_RTP_SENDER_PACKET_TIMEOUT                    (1 * NX_IP_PERIODIC_RATE)
 #endif /* NX_RTP_SENDER_PACKET_TIMEOUT */
 
+/* Payloads up to this size are copied by nx_rtp_sender_session_h264_nal_send, larger ones are referenced. */
+#ifndef NX_RTP_SENDER_H264_COPY_THRESHOLD
+#define NX_RTP_SENDER_H264_COPY_THRESHOLD               64
+#endif /* NX_RTP_SENDER_H264_COPY_THRESHOLD */
+
 /* 5 seconds is the recommended minimum interval by RFC 3550, Chapter 6.2. */
 #ifndef NX_RTCP_INTERVAL
 #define NX_RTCP_INTERVAL                                5
@@ -136,6 +141,10 @@ extern   "C" {
 
 /* Define RTP header field(s) */
 #define NX_RTP_HEADER_MARKER_BIT                        0x80
+#define NX_RTP_HEADER_EXTENSION_BIT                     0x10
+
+/* The header of a rtp header extension: profile and length in 32-bit words - Reference RFC 3550, section 5.3.1 */
+#define NX_RTP_HEADER_EXTENSION_HEADER_LENGTH           4
 
 /* Define RTCP packet types.  */
 #define NX_RTCP_TYPE_SR                                 200
@@ -337,6 +346,12 @@ struct NX_RTP_SESSION_STRUCT
     /* The last time an RTCP packet was transmitted. */
     ULONG                         nx_rtp_session_rtcp_time;
 
+    /* The header extension to add to the first packet of the next frame, NX_NULL if none. */
+    UCHAR                        *nx_rtp_session_header_extension_ptr;
+    ULONG                         nx_rtp_session_header_extension_length;
+    USHORT                        nx_rtp_session_header_extension_profile;
+    USHORT                        nx_rtp_session_header_extension_reserved;  /* Alignment */
+
     struct NX_RTP_SESSION_STRUCT *nx_rtp_session_next;
 };
 
@@ -371,10 +386,12 @@ typedef struct NX_RTP_HEADER_STRUCT
 #define nx_rtp_sender_session_packet_send               _nx_rtp_sender_session_packet_send
 #define nx_rtp_sender_session_jpeg_send                 _nx_rtp_sender_session_jpeg_send
 #define nx_rtp_sender_session_h264_send                 _nx_rtp_sender_session_h264_send
+#define nx_rtp_sender_session_h264_nal_send             _nx_rtp_sender_session_h264_nal_send
 #define nx_rtp_sender_session_aac_send                  _nx_rtp_sender_session_aac_send
 #define nx_rtp_sender_session_sequence_number_get       _nx_rtp_sender_session_sequence_number_get
 #define nx_rtp_sender_session_ssrc_get                  _nx_rtp_sender_session_ssrc_get
 #define nx_rtp_sender_session_vlan_priority_set         _nx_rtp_sender_session_vlan_priority_set
+#define nx_rtp_sender_session_header_extension_set      _nx_rtp_sender_session_header_extension_set
 
 #define nx_rtp_sender_rtcp_receiver_report_callback_set _nx_rtp_sender_rtcp_receiver_report_callback_set
 #define nx_rtp_sender_rtcp_sdes_callback_set            _nx_rtp_sender_rtcp_sdes_callback_set
@@ -392,10 +409,12 @@ typedef struct NX_RTP_HEADER_STRUCT
 #define nx_rtp_sender_session_packet_send               _nxe_rtp_sender_session_packet_send
 #define nx_rtp_sender_session_jpeg_send                 _nxe_rtp_sender_session_jpeg_send
 #define nx_rtp_sender_session_h264_send                 _nxe_rtp_sender_session_h264_send
+#define nx_rtp_sender_session_h264_nal_send             _nxe_rtp_sender_session_h264_nal_send
 #define nx_rtp_sender_session_aac_send                  _nxe_rtp_sender_session_aac_send
 #define nx_rtp_sender_session_sequence_number_get       _nxe_rtp_sender_session_sequence_number_get
 #define nx_rtp_sender_session_ssrc_get                  _nxe_rtp_sender_session_ssrc_get
 #define nx_rtp_sender_session_vlan_priority_set         _nxe_rtp_sender_session_vlan_priority_set
+#define nx_rtp_sender_session_header_extension_set      _nxe_rtp_sender_session_header_extension_set
 
 #define nx_rtp_sender_rtcp_receiver_report_callback_set _nxe_rtp_sender_rtcp_receiver_report_callback_set
 #define nx_rtp_sender_rtcp_sdes_callback_set            _nxe_rtp_sender_rtcp_sdes_callback_set
@@ -436,6 +455,12 @@ UINT nx_rtp_sender_session_jpeg_send(NX_RTP_SESSION *session, UCHAR *frame_data,
 UINT nx_rtp_sender_session_h264_send(NX_RTP_SESSION *session, UCHAR *frame_data, ULONG frame_data_size,
                                      ULONG timestamp, ULONG ntp_msw, ULONG ntp_lsw, UINT marker);
 
+/* Send a h264 frame without copying it, the NAL unit sizes given by the encoder (NX_NULL to search the start codes).
+   The frame data shall be kept until the packets referencing it are released by the driver. */
+UINT nx_rtp_sender_session_h264_nal_send(NX_RTP_SESSION *session, UCHAR *frame_data, ULONG frame_data_size,
+                                         ULONG *nal_unit_size_table, UINT nal_unit_count,
+                                         ULONG timestamp, ULONG ntp_msw, ULONG ntp_lsw, UINT marker);
+
 /* API functions for sending audio payload over rtp. */
 UINT nx_rtp_sender_session_aac_send(NX_RTP_SESSION *session, UCHAR *frame_data, ULONG frame_data_size, ULONG timestamp, ULONG ntp_msw, ULONG ntp_lsw, UINT marker);
 
@@ -448,6 +473,10 @@ UINT nx_rtp_sender_session_ssrc_get(NX_RTP_SESSION *session, ULONG *ssrc);
 /* Set the vlan priority inside the specific session. */
 UINT nx_rtp_sender_session_vlan_priority_set(NX_RTP_SESSION *session, UINT vlan_priority);
 
+/* Set the header extension of the first packet of the next frame (data length multiple of 4, NX_NULL to cancel).
+   The data shall be kept until the frame is sent. */
+UINT nx_rtp_sender_session_header_extension_set(NX_RTP_SESSION *session, USHORT profile, UCHAR *data, ULONG data_length);
+
 /* Set a callback function to handle incoming RTCP message. */
 UINT nx_rtp_sender_rtcp_receiver_report_callback_set(NX_RTP_SENDER *rtp_sender, UINT (*rtcp_rr_cb)(NX_RTP_SESSION *, NX_RTCP_RECEIVER_REPORT *));
 UINT nx_rtp_sender_rtcp_sdes_callback_set(NX_RTP_SENDER *rtp_sender, UINT (*rtcp_sdes_cb)(NX_RTCP_SDES_INFO *));
@@ -489,6 +518,12 @@ UINT _nxe_rtp_sender_session_h264_send(NX_RTP_SESSION *session, UCHAR *frame_dat
                                        ULONG timestamp, ULONG ntp_msw, ULONG ntp_lsw, UINT marker);
 UINT _nx_rtp_sender_session_h264_send(NX_RTP_SESSION *session, UCHAR *frame_data, ULONG frame_data_size,
                                       ULONG timestamp, ULONG ntp_msw, ULONG ntp_lsw, UINT marker);
+UINT _nxe_rtp_sender_session_h264_nal_send(NX_RTP_SESSION *session, UCHAR *frame_data, ULONG frame_data_size,
+                                           ULONG *nal_unit_size_table, UINT nal_unit_count,
+                                           ULONG timestamp, ULONG ntp_msw, ULONG ntp_lsw, UINT marker);
+UINT _nx_rtp_sender_session_h264_nal_send(NX_RTP_SESSION *session, UCHAR *frame_data, ULONG frame_data_size,
+                                          ULONG *nal_unit_size_table, UINT nal_unit_count,
+                                          ULONG timestamp, ULONG ntp_msw, ULONG ntp_lsw, UINT marker);
 UINT _nxe_rtp_sender_session_aac_send(NX_RTP_SESSION *session, UCHAR *frame_data, ULONG frame_data_size,
                                       ULONG timestamp, ULONG ntp_msw, ULONG ntp_lsw, UINT marker);
 UINT _nx_rtp_sender_session_aac_send(NX_RTP_SESSION *session, UCHAR *frame_data, ULONG frame_data_size,
@@ -497,6 +532,8 @@ UINT _nxe_rtp_sender_session_ssrc_get(NX_RTP_SESSION *session, ULONG *ssrc);
 UINT _nx_rtp_sender_session_ssrc_get(NX_RTP_SESSION *session, ULONG *ssrc);
 UINT _nxe_rtp_sender_session_vlan_priority_set(NX_RTP_SESSION *session, UINT vlan_priority);
 UINT _nx_rtp_sender_session_vlan_priority_set(NX_RTP_SESSION *session, UINT vlan_priority);
+UINT _nxe_rtp_sender_session_header_extension_set(NX_RTP_SESSION *session, USHORT profile, UCHAR *data, ULONG data_length);
+UINT _nx_rtp_sender_session_header_extension_set(NX_RTP_SESSION *session, USHORT profile, UCHAR *data, ULONG data_length);
 
 UINT _nxe_rtp_sender_rtcp_receiver_report_callback_set(NX_RTP_SENDER *rtp_sender, UINT (*rtcp_rr_cb)(NX_RTP_SESSION *, NX_RTCP_RECEIVER_REPORT *));
 UINT _nx_rtp_sender_rtcp_receiver_report_callback_set(NX_RTP_SENDER *rtp_sender, UINT (*rtcp_rr_cb)(NX_RTP_SESSION *, NX_RTCP_RECEIVER_REPORT *));
@@ -0,0 +1,380 @@
+#include "tx_api.h"
+#include "nx_api.h"
+#include "netxtestcontrol.h"
+
+extern void test_control_return(UINT);
+
+#if !defined(NX_DISABLE_IPV4) && defined(__PRODUCT_NETXDUO__) && !defined(NX_DISABLE_PACKET_CHAIN)
+#include    "nx_rtp_sender.h"
+
+#define DEMO_STACK_SIZE            4096
+
+#define NUM_PACKETS                40
+#define PACKET_SIZE                1536
+#define PACKET_POOL_SIZE           (NUM_PACKETS * (PACKET_SIZE + sizeof(NX_PACKET)))
+
+#define RTP_SERVER_ADDRESS         IP_ADDRESS(1,2,3,4)
+#define RTP_CLIENT_ADDRESS         IP_ADDRESS(1,2,3,5)
+#define RTP_CLIENT_RTP_PORT        6002
+#define RTP_CLIENT_RTCP_PORT       6003
+#define RTP_PAYLOAD_TYPE           96
+#define CNAME                      "AzureRTOS@microsoft.com"
+
+/* Define test data. */
+#define TEST_TIMESTAMP             1234
+#define TEST_MSW                   123
+#define TEST_LSW                   456
+
+/* Define the maximum number of packets and payload size of a frame. */
+#define MAX_FRAME_PACKETS          16
+#define MAX_PAYLOAD_SIZE           128
+
+/* Define h264 test data */
+static UCHAR test_rtp_packet_data[] = { 0x00, 0x00, 0x01, 0x65, /* h264 header started with 0x000001 */
+                                        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, /* Test data */
+}; /* test_rtp_packet_data */
+
+static UCHAR test_long_rtp_packet_data[] = { 0x00, 0x00, 0x00, 0x01, 0x65, /* h264 header started with 0x00000001 */
+
+                                            /* Test data */
+                                            0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+                                            0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+                                            0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+                                            0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+                                            0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+                                            0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+                                            0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+                                            0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+                                            0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+                                            0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+                                            0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+                                            0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+}; /* test_long_rtp_packet_data */
+
+/* SPS, PPS and an IDR picture of 3 fragments, as given by an encoder. */
+static UCHAR test_idr_rtp_packet_data[] = { 0x00, 0x00, 0x00, 0x01, 0x67, 0x42, 0xC0, 0x1F, 0xDA, 0x01, 0x40, 0x16, 0xE8, /* SPS */
+                                            0x00, 0x00, 0x00, 0x01, 0x68, 0xCE, 0x3C, 0x80, /* PPS */
+                                            0x00, 0x00, 0x01, 0x65, /* IDR */
+                                            0x88, 0x84, 0x00, 0x33, 0xFF, 0xFE, 0xF6, 0xF0, 0xFE, 0x05, 0x36, 0x56, 0x04, 0x50, 0x96, 0x7B,
+                                            0x3F, 0x53, 0xE1, 0x00, 0x00, 0x03, 0x00, 0x00, 0x03, 0x00, 0x00, 0x03, 0x00, 0x00, 0x03, 0x01,
+                                            0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+                                            0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F,
+                                            0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+                                            0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F,
+                                            0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+                                            0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F,
+                                            0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+                                            0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F,
+                                            0x80,
+}; /* test_idr_rtp_packet_data */
+static ULONG test_idr_nal_unit_sizes[] = { 13, 8, 4 + 16 * 10 + 1 };
+
+static UCHAR test_rtp_packet_slices_data[] = { 0x00, 0x00, 0x00, 0x01, 0x61, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A,
+                                               0x00, 0x00, 0x00, 0x01, 0x61, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A,
+                                               0x00, 0x00, 0x00, 0x01, 0x61, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A,
+                                               0x00, 0x00, 0x00, 0x01, 0x61, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A,
+                                               0x00, 0x00, 0x00, 0x01, 0x61, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A,
+                                               0x00, 0x00, 0x00, 0x01, 0x61, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A,
+                                               0x00, 0x00, 0x00, 0x01, 0x61, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A,
+                                               0x00, 0x00, 0x00, 0x01, 0x61, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A,
+}; /* test_rtp_packet_slices_data */
+static ULONG test_slices_nal_unit_sizes[] = { 16, 16, 16, 16, 16, 16, 16, 16 };
+
+/* Frame copy at an unaligned address, for the start code search. */
+static UCHAR test_unaligned_buffer[sizeof(test_long_rtp_packet_data) + 4];
+
+/* Define the ThreadX object control blocks...  */
+
+static TX_THREAD                   ntest_0;
+
+static NX_PACKET_POOL              pool_0;
+static NX_IP                       ip_0;
+static NX_IP                       ip_1;
+static NX_UDP_SOCKET               rtp_client_socket;
+
+/* Define rtp sender control block.  */
+static NX_RTP_SENDER               rtp_0;
+static NX_RTP_SESSION              rtp_session_0;
+static UINT                        rtp_port;
+static UINT                        rtcp_port;
+
+/* Define the payloads received for a frame sent by nx_rtp_sender_session_h264_send. */
+static UCHAR                       reference_payload[MAX_FRAME_PACKETS][MAX_PAYLOAD_SIZE];
+static ULONG                       reference_payload_length[MAX_FRAME_PACKETS];
+static UINT                        reference_packet_count;
+static UINT                        error_counter;
+
+
+/* Define thread prototypes.  */
+
+static void ntest_0_entry(ULONG thread_input);
+extern void _nx_ram_network_driver(struct NX_IP_DRIVER_STRUCT *driver_req);
+extern void test_control_return(UINT status);
+
+#ifdef CTEST
+VOID test_application_define(void *first_unused_memory)
+#else
+void    netx_rtp_session_h264_nal_send_test_application_define(void *first_unused_memory)
+#endif
+{
+
+CHAR       *pointer;
+UINT        status;
+
+    /* Print out test information banner.  */
+    printf("NetX Test:   RTP Session H264 NAL Send Test........................................");
+
+    /* Setup the working pointer.  */
+    pointer = (CHAR *)first_unused_memory;
+
+    /* Create the test thread.  */
+    tx_thread_create(&ntest_0, "thread 0", ntest_0_entry, 0,
+                     pointer, DEMO_STACK_SIZE,
+                     4, 4, TX_NO_TIME_SLICE, TX_AUTO_START);
+
+    pointer = pointer + DEMO_STACK_SIZE;
+
+    /* Initialize the NetX system.  */
+    nx_system_initialize();
+
+    /* Create a packet pool.  */
+    status = nx_packet_pool_create(&pool_0, "NetX Main Packet Pool", PACKET_SIZE, pointer, PACKET_POOL_SIZE);
+    pointer = pointer + PACKET_POOL_SIZE;
+    CHECK_STATUS(0, status);
+
+    /* Create server IP instance.  */
+    status = nx_ip_create(&ip_0, "NetX IP Instance 0", RTP_SERVER_ADDRESS, 0xFFFFFF00UL, &pool_0, _nx_ram_network_driver,
+                          pointer, 2048, 1);
+    pointer = pointer + 2048;
+    CHECK_STATUS(0, status);
+
+    /* Create client IP instance.  */
+    status = nx_ip_create(&ip_1, "NetX IP Instance 1", RTP_CLIENT_ADDRESS, 0xFFFFFF00UL, &pool_0, _nx_ram_network_driver,
+                          pointer, 2048, 1);
+    pointer = pointer + 2048;
+    CHECK_STATUS(0, status);
+
+    /* Enable ARP and supply ARP cache memory for IP Instance 0.  */
+    status = nx_arp_enable(&ip_0, (void *) pointer, 1024);
+    pointer = pointer + 1024;
+    CHECK_STATUS(0, status);
+
+    /* Enable ARP and supply ARP cache memory for IP Instance 1.  */
+    status = nx_arp_enable(&ip_1, (void *) pointer, 1024);
+    pointer = pointer + 1024;
+    CHECK_STATUS(0, status);
+
+    /* Enable UDP processing for both IP instances.  */
+    status = nx_udp_enable(&ip_0);
+    CHECK_STATUS(0, status);
+    status = nx_udp_enable(&ip_1);
+    CHECK_STATUS(0, status);
+}
+
+/* Receive the packets of a frame, until the one with the marker bit. Record them as the reference, or compare them
+   to the reference. */
+static VOID    receive_frame(UINT record)
+{
+NX_PACKET *received_packet;
+UINT       status;
+UCHAR     *data;
+ULONG      payload_length;
+UINT       marker = NX_FALSE;
+UINT       packet_count = 0;
+
+
+    while (marker == NX_FALSE)
+    {
+
+        /* Receive rtp data packet. */
+        status = nx_udp_socket_receive(&rtp_client_socket, &received_packet, 5 * NX_IP_PERIODIC_RATE);
+        CHECK_STATUS(0, status);
+
+        /* Check RTP version byte and payload type */
+        data = received_packet -> nx_packet_prepend_ptr;
+        CHECK_STATUS(0x80, data[0]);
+        CHECK_STATUS(RTP_PAYLOAD_TYPE, data[1] & ~NX_RTP_HEADER_MARKER_BIT);
+        marker = (data[1] & NX_RTP_HEADER_MARKER_BIT) ? NX_TRUE : NX_FALSE;
+
+        /* Check RTP timestamp */
+        CHECK_STATUS(TEST_TIMESTAMP, (ULONG)(data[4] << 24 | data[5] << 16 | data[6] << 8 | data[7]));
+
+        payload_length = received_packet -> nx_packet_length - NX_RTP_HEADER_LENGTH;
+        data += NX_RTP_HEADER_LENGTH;
+        if ((packet_count >= MAX_FRAME_PACKETS) || (payload_length > MAX_PAYLOAD_SIZE))
+        {
+            error_counter++;
+        }
+        else if (record)
+        {
+            memcpy(reference_payload[packet_count], data, payload_length);
+            reference_payload_length[packet_count] = payload_length;
+        }
+        else
+        {
+
+            /* The reference NAL units end with the first zero byte of the next start code. */
+            if ((payload_length != reference_payload_length[packet_count]) &&
+                ((marker == NX_TRUE) || ((payload_length + 1) != reference_payload_length[packet_count]) ||
+                 (reference_payload[packet_count][payload_length] != 0x00)))
+            {
+                error_counter++;
+            }
+            else if (memcmp(reference_payload[packet_count], data, payload_length))
+            {
+                error_counter++;
+            }
+        }
+        packet_count++;
+
+        /* Release the receive packet when the check finishes. */
+        nx_packet_release(received_packet);
+    }
+
+    if (record)
+    {
+        reference_packet_count = packet_count;
+    }
+    else if (packet_count != reference_packet_count)
+    {
+        error_counter++;
+    }
+}
+
+/* Send a frame with nx_rtp_sender_session_h264_send, then with nx_rtp_sender_session_h264_nal_send, with and
+   without NAL unit sizes, and compare the packets. */
+static VOID    send_frame(UCHAR *frame_data, ULONG frame_data_size, ULONG *nal_unit_sizes, UINT nal_unit_count)
+{
+UINT status;
+
+
+    status = nx_rtp_sender_session_h264_send(&rtp_session_0, frame_data, frame_data_size, TEST_TIMESTAMP, TEST_MSW, TEST_LSW, 1);
+    CHECK_STATUS(NX_SUCCESS, status);
+    receive_frame(NX_TRUE);
+
+    status = nx_rtp_sender_session_h264_nal_send(&rtp_session_0, frame_data, frame_data_size, nal_unit_sizes, nal_unit_count,
+                                                 TEST_TIMESTAMP, TEST_MSW, TEST_LSW, 1);
+    CHECK_STATUS(NX_SUCCESS, status);
+    receive_frame(NX_FALSE);
+
+    status = nx_rtp_sender_session_h264_nal_send(&rtp_session_0, frame_data, frame_data_size, NX_NULL, 0,
+                                                 TEST_TIMESTAMP, TEST_MSW, TEST_LSW, 1);
+    CHECK_STATUS(NX_SUCCESS, status);
+    receive_frame(NX_FALSE);
+}
+
+/* Define the test thread.  */
+static void    ntest_0_entry(ULONG thread_input)
+{
+UINT          status;
+NXD_ADDRESS   client_ip_address;
+ULONG         nal_unit_size;
+UINT          pass;
+
+
+    /* Create the rtp client socket.  */
+    status = nx_udp_socket_create(&ip_1, &rtp_client_socket, "RTP Client Socket", NX_IP_NORMAL, NX_FRAGMENT_OKAY, 0x80, MAX_FRAME_PACKETS);
+    CHECK_STATUS(0, status);
+
+    status =  nx_udp_socket_bind(&rtp_client_socket, RTP_CLIENT_RTP_PORT, NX_IP_PERIODIC_RATE);
+    CHECK_STATUS(0, status);
+
+    /* Create RTP sender.  */
+    status = nx_rtp_sender_create(&rtp_0, &ip_0, &pool_0, CNAME, sizeof(CNAME) - 1);
+    CHECK_STATUS(0, status);
+
+    /* Get the udp port pair for rtp and rtcp */
+    status = nx_rtp_sender_port_get(&rtp_0, &rtp_port, &rtcp_port);
+    CHECK_STATUS(0, status);
+
+    /* Setup rtp sender session.  */
+    client_ip_address.nxd_ip_version = NX_IP_VERSION_V4;
+    client_ip_address.nxd_ip_address.v4 = RTP_CLIENT_ADDRESS;
+    status = nx_rtp_sender_session_create(&rtp_0, &rtp_session_0, RTP_PAYLOAD_TYPE,
+                                          0, &client_ip_address,
+                                          RTP_CLIENT_RTP_PORT, RTP_CLIENT_RTCP_PORT);
+    CHECK_STATUS(0, status);
+
+    /* If more than one rtp packet is sent during the first tick, rtcp packet will also be sent more than once.
+       To make a stable test result, wait for a tick here to avoid this situation. */
+    tx_thread_sleep(1);
+
+    /* The payloads are copied while the UDP checksum is computed in software, then referenced once it is disabled. */
+    for (pass = 0; pass < 2; pass++)
+    {
+        if (pass == 1)
+        {
+            status = nx_udp_socket_checksum_disable(&rtp_0.nx_rtp_sender_rtp_socket);
+            CHECK_STATUS(0, status);
+        }
+
+        /* Single NAL unit packet. */
+        nal_unit_size = sizeof(test_rtp_packet_data);
+        send_frame(test_rtp_packet_data, sizeof(test_rtp_packet_data), &nal_unit_size, 1);
+
+        /* FU-A packets. */
+        nal_unit_size = sizeof(test_long_rtp_packet_data);
+        send_frame(test_long_rtp_packet_data, sizeof(test_long_rtp_packet_data), &nal_unit_size, 1);
+
+        /* SPS, PPS and FU-A packets. */
+        send_frame(test_idr_rtp_packet_data, sizeof(test_idr_rtp_packet_data), test_idr_nal_unit_sizes,
+                   sizeof(test_idr_nal_unit_sizes) / sizeof(ULONG));
+
+        /* Slices. */
+        send_frame(test_rtp_packet_slices_data, sizeof(test_rtp_packet_slices_data), test_slices_nal_unit_sizes,
+                   sizeof(test_slices_nal_unit_sizes) / sizeof(ULONG));
+
+        /* Unaligned frame. */
+        memcpy(test_unaligned_buffer + 1, test_long_rtp_packet_data, sizeof(test_long_rtp_packet_data));
+        nal_unit_size = sizeof(test_long_rtp_packet_data);
+        send_frame(test_unaligned_buffer + 1, sizeof(test_long_rtp_packet_data), &nal_unit_size, 1);
+    }
+
+    /* NAL unit sizes larger than the frame. */
+    nal_unit_size = sizeof(test_rtp_packet_data) + 1;
+    status = nx_rtp_sender_session_h264_nal_send(&rtp_session_0, test_rtp_packet_data, sizeof(test_rtp_packet_data), &nal_unit_size, 1,
+                                                 TEST_TIMESTAMP, TEST_MSW, TEST_LSW, 1);
+    CHECK_STATUS(NX_SIZE_ERROR, status);
+
+    /* No start code. */
+    status = nx_rtp_sender_session_h264_nal_send(&rtp_session_0, test_rtp_packet_data + 3, sizeof(test_rtp_packet_data) - 3, NX_NULL, 0,
+                                                 TEST_TIMESTAMP, TEST_MSW, TEST_LSW, 1);
+    CHECK_STATUS(NX_NOT_SUCCESSFUL, status);
+
+    /* Incomplete frame. */
+    status = nx_rtp_sender_session_h264_nal_send(&rtp_session_0, test_rtp_packet_data, sizeof(test_rtp_packet_data), NX_NULL, 0,
+                                                 TEST_TIMESTAMP, TEST_MSW, TEST_LSW, 0);
+    CHECK_STATUS(NX_NOT_SUPPORTED, status);
+
+    CHECK_STATUS(0, error_counter);
+
+    /* Delete and release resources */
+    status = nx_rtp_sender_session_delete(&rtp_session_0);
+    CHECK_STATUS(0, status);
+
+    status = nx_rtp_sender_delete(&rtp_0);
+    CHECK_STATUS(0, status);
+
+    /* Check if there is memory leak. */
+    CHECK_STATUS(pool_0.nx_packet_pool_total, pool_0.nx_packet_pool_available);
+
+    /* Return the test result.  */
+    printf("SUCCESS!\n");
+    test_control_return(0);
+}
+
+#else
+
+#ifdef CTEST
+VOID test_application_define(void *first_unused_memory)
+#else
+void    netx_rtp_session_h264_nal_send_test_application_define(void *first_unused_memory)
+#endif
+{
+
+    /* Print out test information banner.  */
+    printf("NetX Test:   RTP Session H264 NAL Send Test........................................N/A\n");
+
+    test_control_return(3);
+}
+#endif
@@ -0,0 +1,338 @@
+#include "tx_api.h"
+#include "nx_api.h"
+#include "netxtestcontrol.h"
+
+extern void test_control_return(UINT);
+
+#if !defined(NX_DISABLE_IPV4) && defined(__PRODUCT_NETXDUO__) && !defined(NX_DISABLE_PACKET_CHAIN)
+#include    "nx_rtp_sender.h"
+
+#define DEMO_STACK_SIZE            4096
+
+#define NUM_PACKETS                20
+#define PACKET_SIZE                1536
+#define PACKET_POOL_SIZE           (NUM_PACKETS * (PACKET_SIZE + sizeof(NX_PACKET)))
+
+#define RTP_SERVER_ADDRESS         IP_ADDRESS(1,2,3,4)
+#define RTP_CLIENT_ADDRESS         IP_ADDRESS(1,2,3,5)
+#define RTP_CLIENT_RTP_PORT        6002
+#define RTP_CLIENT_RTCP_PORT       6003
+#define RTP_PAYLOAD_TYPE           96
+#define CNAME                      "AzureRTOS@microsoft.com"
+
+/* Define test data. */
+#define TEST_TIMESTAMP             1234
+#define TEST_MSW                   123
+#define TEST_LSW                   456
+#define TEST_PROFILE               0x1000
+
+static UCHAR test_extension[] = { 0x10, 0x06, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 };
+static UCHAR test_rtp_packet_data[] = "test rtp packet data";
+static UCHAR test_long_rtp_packet_data[200];
+static UCHAR test_received_data[2 * sizeof(test_long_rtp_packet_data)];
+static UCHAR test_h264_frame_data[4 + sizeof(test_long_rtp_packet_data)] = { 0x00, 0x00, 0x00, 0x01, 0x65 };
+
+/* Define the ThreadX object control blocks...  */
+
+static TX_THREAD                   ntest_0;
+
+static NX_PACKET_POOL              pool_0;
+static NX_IP                       ip_0;
+static NX_IP                       ip_1;
+static NX_UDP_SOCKET               rtp_client_socket;
+
+/* Define rtp sender control block.  */
+static NX_RTP_SENDER               rtp_0;
+static NX_RTP_SESSION              rtp_session_0;
+static UINT                        rtp_port;
+static UINT                        rtcp_port;
+static ULONG                       max_packet_size;
+static UINT                        error_counter;
+
+
+/* Define thread prototypes.  */
+
+static void ntest_0_entry(ULONG thread_input);
+extern void _nx_ram_network_driver(struct NX_IP_DRIVER_STRUCT *driver_req);
+extern void test_control_return(UINT status);
+
+#ifdef CTEST
+VOID test_application_define(void *first_unused_memory)
+#else
+void    netx_rtp_session_header_extension_test_application_define(void *first_unused_memory)
+#endif
+{
+
+CHAR       *pointer;
+UINT        status;
+
+    /* Print out test information banner.  */
+    printf("NetX Test:   RTP Session Header Extension Test.....................................");
+
+    /* Setup the working pointer.  */
+    pointer = (CHAR *)first_unused_memory;
+
+    /* Create the test thread.  */
+    tx_thread_create(&ntest_0, "thread 0", ntest_0_entry, 0,
+                     pointer, DEMO_STACK_SIZE,
+                     4, 4, TX_NO_TIME_SLICE, TX_AUTO_START);
+
+    pointer = pointer + DEMO_STACK_SIZE;
+
+    /* Initialize the NetX system.  */
+    nx_system_initialize();
+
+    /* Create a packet pool.  */
+    status = nx_packet_pool_create(&pool_0, "NetX Main Packet Pool", PACKET_SIZE, pointer, PACKET_POOL_SIZE);
+    pointer = pointer + PACKET_POOL_SIZE;
+    CHECK_STATUS(0, status);
+
+    /* Create server IP instance.  */
+    status = nx_ip_create(&ip_0, "NetX IP Instance 0", RTP_SERVER_ADDRESS, 0xFFFFFF00UL, &pool_0, _nx_ram_network_driver,
+                          pointer, 2048, 1);
+    pointer = pointer + 2048;
+    CHECK_STATUS(0, status);
+
+    /* Create client IP instance.  */
+    status = nx_ip_create(&ip_1, "NetX IP Instance 1", RTP_CLIENT_ADDRESS, 0xFFFFFF00UL, &pool_0, _nx_ram_network_driver,
+                          pointer, 2048, 1);
+    pointer = pointer + 2048;
+    CHECK_STATUS(0, status);
+
+    /* Enable ARP and supply ARP cache memory for IP Instance 0.  */
+    status = nx_arp_enable(&ip_0, (void *) pointer, 1024);
+    pointer = pointer + 1024;
+    CHECK_STATUS(0, status);
+
+    /* Enable ARP and supply ARP cache memory for IP Instance 1.  */
+    status = nx_arp_enable(&ip_1, (void *) pointer, 1024);
+    pointer = pointer + 1024;
+    CHECK_STATUS(0, status);
+
+    /* Enable UDP processing for both IP instances.  */
+    status = nx_udp_enable(&ip_0);
+    CHECK_STATUS(0, status);
+    status = nx_udp_enable(&ip_1);
+    CHECK_STATUS(0, status);
+}
+
+/* Receive the packets of a frame, until the one with the marker bit. Check the header extension is in the first
+   packet only and the packets fit in the maximum packet size, and return the payload of the frame. */
+static ULONG   receive_frame(UINT extension)
+{
+NX_PACKET *received_packet;
+UINT       status;
+UCHAR     *data;
+ULONG      payload_length;
+ULONG      received_length = 0;
+UINT       marker = NX_FALSE;
+UINT       packet_count = 0;
+
+
+    while (marker == NX_FALSE)
+    {
+
+        /* Receive rtp data packet. */
+        status = nx_udp_socket_receive(&rtp_client_socket, &received_packet, 5 * NX_IP_PERIODIC_RATE);
+        CHECK_STATUS(0, status);
+
+        /* The packet shall not exceed the size of a packet without header extension. */
+        if (received_packet -> nx_packet_length > (max_packet_size + NX_RTP_HEADER_LENGTH))
+        {
+            error_counter++;
+        }
+
+        /* Check RTP version byte, extension bit and payload type */
+        data = received_packet -> nx_packet_prepend_ptr;
+        if ((extension == NX_TRUE) && (packet_count == 0))
+        {
+            CHECK_STATUS(0x80 | NX_RTP_HEADER_EXTENSION_BIT, data[0]);
+        }
+        else
+        {
+            CHECK_STATUS(0x80, data[0]);
+        }
+        CHECK_STATUS(RTP_PAYLOAD_TYPE, data[1] & ~NX_RTP_HEADER_MARKER_BIT);
+        marker = (data[1] & NX_RTP_HEADER_MARKER_BIT) ? NX_TRUE : NX_FALSE;
+
+        /* Check RTP timestamp */
+        CHECK_STATUS(TEST_TIMESTAMP, (ULONG)(data[4] << 24 | data[5] << 16 | data[6] << 8 | data[7]));
+        data += NX_RTP_HEADER_LENGTH;
+
+        /* Check the header extension. */
+        if ((extension == NX_TRUE) && (packet_count == 0))
+        {
+            CHECK_STATUS(TEST_PROFILE, (ULONG)(data[0] << 8 | data[1]));
+            CHECK_STATUS(sizeof(test_extension) / 4, (ULONG)(data[2] << 8 | data[3]));
+            if (memcmp(data + NX_RTP_HEADER_EXTENSION_HEADER_LENGTH, test_extension, sizeof(test_extension)))
+            {
+                error_counter++;
+            }
+            data += NX_RTP_HEADER_EXTENSION_HEADER_LENGTH + sizeof(test_extension);
+        }
+
+        payload_length = (ULONG)(received_packet -> nx_packet_append_ptr - data);
+        if ((received_length + payload_length) > sizeof(test_received_data))
+        {
+            error_counter++;
+        }
+        else
+        {
+            memcpy(test_received_data + received_length, data, payload_length);
+            received_length += payload_length;
+        }
+        packet_count++;
+
+        /* Release the receive packet when the check finishes. */
+        nx_packet_release(received_packet);
+    }
+
+    return(received_length);
+}
+
+/* Define the test thread.  */
+static void    ntest_0_entry(ULONG thread_input)
+{
+UINT          status;
+NXD_ADDRESS   client_ip_address;
+NX_PACKET    *send_packet;
+ULONG         received_length;
+
+
+    for (UINT i = 0; i < sizeof(test_long_rtp_packet_data); i++)
+    {
+        test_long_rtp_packet_data[i] = i % 100;
+    }
+    for (UINT i = 5; i < sizeof(test_h264_frame_data); i++)
+    {
+        test_h264_frame_data[i] = (UCHAR)(i % 100 + 1);
+    }
+
+    /* Create the rtp client socket.  */
+    status = nx_udp_socket_create(&ip_1, &rtp_client_socket, "RTP Client Socket", NX_IP_NORMAL, NX_FRAGMENT_OKAY, 0x80, 5);
+    CHECK_STATUS(0, status);
+
+    status =  nx_udp_socket_bind(&rtp_client_socket, RTP_CLIENT_RTP_PORT, NX_IP_PERIODIC_RATE);
+    CHECK_STATUS(0, status);
+
+    /* Create RTP sender.  */
+    status = nx_rtp_sender_create(&rtp_0, &ip_0, &pool_0, CNAME, sizeof(CNAME) - 1);
+    CHECK_STATUS(0, status);
+
+    /* Get the udp port pair for rtp and rtcp */
+    status = nx_rtp_sender_port_get(&rtp_0, &rtp_port, &rtcp_port);
+    CHECK_STATUS(0, status);
+
+    /* Setup rtp sender session.  */
+    client_ip_address.nxd_ip_version = NX_IP_VERSION_V4;
+    client_ip_address.nxd_ip_address.v4 = RTP_CLIENT_ADDRESS;
+    status = nx_rtp_sender_session_create(&rtp_0, &rtp_session_0, RTP_PAYLOAD_TYPE,
+                                          0, &client_ip_address,
+                                          RTP_CLIENT_RTP_PORT, RTP_CLIENT_RTCP_PORT);
+    CHECK_STATUS(0, status);
+    max_packet_size = rtp_session_0.nx_rtp_session_max_packet_size;
+
+    /* If more than one rtp packet is sent during the first tick, rtcp packet will also be sent more than once.
+       To make a stable test result, wait for a tick here to avoid this situation. */
+    tx_thread_sleep(1);
+
+    /* Invalid extension sizes. */
+    status = nx_rtp_sender_session_header_extension_set(&rtp_session_0, TEST_PROFILE, test_extension, sizeof(test_extension) - 2);
+    CHECK_STATUS(NX_SIZE_ERROR, status);
+    status = nx_rtp_sender_session_header_extension_set(&rtp_session_0, TEST_PROFILE, test_long_rtp_packet_data, (max_packet_size + 3) & ~3UL);
+    CHECK_STATUS(NX_SIZE_ERROR, status);
+    CHECK_STATUS(max_packet_size, rtp_session_0.nx_rtp_session_max_packet_size);
+
+    /* Cancelled extension. */
+    status = nx_rtp_sender_session_header_extension_set(&rtp_session_0, TEST_PROFILE, test_extension, sizeof(test_extension));
+    CHECK_STATUS(0, status);
+    CHECK_STATUS(max_packet_size - NX_RTP_HEADER_EXTENSION_HEADER_LENGTH - sizeof(test_extension), rtp_session_0.nx_rtp_session_max_packet_size);
+    status = nx_rtp_sender_session_header_extension_set(&rtp_session_0, TEST_PROFILE, NX_NULL, 0);
+    CHECK_STATUS(0, status);
+    CHECK_STATUS(max_packet_size, rtp_session_0.nx_rtp_session_max_packet_size);
+
+    status = nx_rtp_sender_session_packet_allocate(&rtp_session_0, &send_packet, 5 * NX_IP_PERIODIC_RATE);
+    CHECK_STATUS(0, status);
+    status = nx_packet_data_append(send_packet, (void*)test_rtp_packet_data, sizeof(test_rtp_packet_data), &pool_0, 5 * NX_IP_PERIODIC_RATE);
+    CHECK_STATUS(0, status);
+    status = nx_rtp_sender_session_packet_send(&rtp_session_0, send_packet, TEST_TIMESTAMP, TEST_MSW, TEST_LSW, 1);
+    CHECK_STATUS(0, status);
+    received_length = receive_frame(NX_FALSE);
+    CHECK_STATUS(sizeof(test_rtp_packet_data), received_length);
+
+    /* Extension in the first of the fragments of a packet. */
+    status = nx_rtp_sender_session_header_extension_set(&rtp_session_0, TEST_PROFILE, test_extension, sizeof(test_extension));
+    CHECK_STATUS(0, status);
+    status = nx_rtp_sender_session_packet_allocate(&rtp_session_0, &send_packet, 5 * NX_IP_PERIODIC_RATE);
+    CHECK_STATUS(0, status);
+    status = nx_packet_data_append(send_packet, (void*)test_long_rtp_packet_data, sizeof(test_long_rtp_packet_data), &pool_0, 5 * NX_IP_PERIODIC_RATE);
+    CHECK_STATUS(0, status);
+    status = nx_rtp_sender_session_packet_send(&rtp_session_0, send_packet, TEST_TIMESTAMP, TEST_MSW, TEST_LSW, 1);
+    CHECK_STATUS(0, status);
+    received_length = receive_frame(NX_TRUE);
+    CHECK_STATUS(sizeof(test_long_rtp_packet_data), received_length);
+    CHECK_STATUS(0, memcmp(test_received_data, test_long_rtp_packet_data, sizeof(test_long_rtp_packet_data)));
+    CHECK_STATUS(max_packet_size, rtp_session_0.nx_rtp_session_max_packet_size);
+
+    /* Packet allocated without room for the extension, which stays pending. */
+    status = nx_rtp_sender_session_packet_allocate(&rtp_session_0, &send_packet, 5 * NX_IP_PERIODIC_RATE);
+    CHECK_STATUS(0, status);
+    status = nx_packet_data_append(send_packet, (void*)test_rtp_packet_data, sizeof(test_rtp_packet_data), &pool_0, 5 * NX_IP_PERIODIC_RATE);
+    CHECK_STATUS(0, status);
+    status = nx_rtp_sender_session_header_extension_set(&rtp_session_0, TEST_PROFILE, test_extension, sizeof(test_extension));
+    CHECK_STATUS(0, status);
+    status = nx_rtp_sender_session_packet_send(&rtp_session_0, send_packet, TEST_TIMESTAMP, TEST_MSW, TEST_LSW, 1);
+    CHECK_STATUS(NX_UNDERFLOW, status);
+    nx_packet_release(send_packet);
+
+    status = nx_rtp_sender_session_packet_allocate(&rtp_session_0, &send_packet, 5 * NX_IP_PERIODIC_RATE);
+    CHECK_STATUS(0, status);
+    status = nx_packet_data_append(send_packet, (void*)test_rtp_packet_data, sizeof(test_rtp_packet_data), &pool_0, 5 * NX_IP_PERIODIC_RATE);
+    CHECK_STATUS(0, status);
+    status = nx_rtp_sender_session_packet_send(&rtp_session_0, send_packet, TEST_TIMESTAMP, TEST_MSW, TEST_LSW, 1);
+    CHECK_STATUS(0, status);
+    received_length = receive_frame(NX_TRUE);
+    CHECK_STATUS(sizeof(test_rtp_packet_data), received_length);
+    CHECK_STATUS(0, memcmp(test_received_data, test_rtp_packet_data, sizeof(test_rtp_packet_data)));
+
+    /* Extension in the first FU-A packet of a h264 frame. */
+    status = nx_rtp_sender_session_header_extension_set(&rtp_session_0, TEST_PROFILE, test_extension, sizeof(test_extension));
+    CHECK_STATUS(0, status);
+    status = nx_rtp_sender_session_h264_send(&rtp_session_0, test_h264_frame_data, sizeof(test_h264_frame_data),
+                                             TEST_TIMESTAMP, TEST_MSW, TEST_LSW, 1);
+    CHECK_STATUS(0, status);
+    receive_frame(NX_TRUE);
+    CHECK_STATUS(max_packet_size, rtp_session_0.nx_rtp_session_max_packet_size);
+
+    CHECK_STATUS(0, error_counter);
+
+    /* Delete and release resources */
+    status = nx_rtp_sender_session_delete(&rtp_session_0);
+    CHECK_STATUS(0, status);
+
+    status = nx_rtp_sender_delete(&rtp_0);
+    CHECK_STATUS(0, status);
+
+    /* Check if there is memory leak. */
+    CHECK_STATUS(pool_0.nx_packet_pool_total, pool_0.nx_packet_pool_available);
+
+    /* Return the test result.  */
+    printf("SUCCESS!\n");
+    test_control_return(0);
+}
+
+#else
+
+#ifdef CTEST
+VOID test_application_define(void *first_unused_memory)
+#else
+void    netx_rtp_session_header_extension_test_application_define(void *first_unused_memory)
+#endif
+{
+
+    /* Print out test information banner.  */
+    printf("NetX Test:   RTP Session Header Extension Test.....................................N/A\n");
+
+    test_control_return(3);
+}
+#endif
@@ -786,6 +786,8 @@ void    netx_rtp_multi_interfaces_test_application_define(void *first_unused_mem
 void    netx_rtp_session_packet_send_test_application_define(void *first_unused_memory);
 void    netx_rtp_session_jpeg_send_test_application_define(void *first_unused_memory);
 void    netx_rtp_session_h264_send_test_application_define(void *first_unused_memory);
+void    netx_rtp_session_h264_nal_send_test_application_define(void *first_unused_memory);
+void    netx_rtp_session_header_extension_test_application_define(void *first_unused_memory);
 void    netx_rtp_session_aac_send_test_application_define(void *first_unused_memory);
 void    netx_rtp_free_udp_port_find_test_application_define(void *first_unused_memory);
 void    netx_rtp_multi_clients_test_application_define(void *first_unused_memory);
@@ -2060,6 +2062,8 @@ TEST_ENTRY  test_control_tests[] =
     {netx_rtp_session_packet_send_test_application_define, TEST_TIMEOUT_LOW},
     {netx_rtp_session_jpeg_send_test_application_define, TEST_TIMEOUT_LOW},
     {netx_rtp_session_h264_send_test_application_define, TEST_TIMEOUT_LOW},
+    {netx_rtp_session_h264_nal_send_test_application_define, TEST_TIMEOUT_LOW},
+    {netx_rtp_session_header_extension_test_application_define, TEST_TIMEOUT_LOW},
     {netx_rtp_session_aac_send_test_application_define, TEST_TIMEOUT_LOW},
     {netx_rtp_free_udp_port_find_test_application_define, TEST_TIMEOUT_MID},
     {netx_rtp_multi_clients_test_application_define, TEST_TIMEOUT_LOW},
@@ -0,0 +1,158 @@
+/**
+ ******************************************************************************
+ * @file    app_camera_nn.c
+ * @author  GPM Application Team
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2023 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "app_camera_nn.h"
+#include "app_config.h"
+#include "cmw_camera.h"
+#include "stm32n6xx_hal.h"
+
+/* DCMIPP double buffer mode alternates between two buffers */
+#if APP_PIPELINE_NB_SLOTS != 2
+#error "zero-copy capture expects one pipeline slot per DCMIPP buffer"
+#endif
+
+int app_camera_nn_init(app_camera_nn_t *pCam, app_pipeline_t *pPipe, uint32_t dcmipp_pipe)
+{
+  DCMIPP_Conf_t dcmipp_conf = {0};
+
+  if ((pPipe->nb_inputs == 0) || (pPipe->input_sizes[0] != NN_WIDTH * NN_HEIGHT * NN_BPP))
+  {
+    return -1;
+  }
+
+  memset(pCam, 0, sizeof(*pCam));
+  pCam->pPipe = pPipe;
+  pCam->dcmipp_pipe = dcmipp_pipe;
+
+  dcmipp_conf.output_width = NN_WIDTH;
+  dcmipp_conf.output_height = NN_HEIGHT;
+  dcmipp_conf.output_format = NN_FORMAT;
+  dcmipp_conf.output_bpp = NN_BPP;
+  dcmipp_conf.mode = CAM_Aspect_ratio_crop;
+  dcmipp_conf.enable_swap = 1;
+  dcmipp_conf.enable_gamma_conversion = 0;
+  if (CMW_CAMERA_SetPipeConfig(dcmipp_pipe, &dcmipp_conf) != CMW_ERROR_NONE)
+  {
+    return -1;
+  }
+
+  return 0;
+}
+
+int app_camera_nn_start(app_camera_nn_t *pCam)
+{
+  app_pipeline_t *pPipe = pCam->pPipe;
+
+  for (int32_t s = 0; s < APP_PIPELINE_NB_SLOTS; s++)
+  {
+    if (!app_pipeline_slot_is_free(pPipe, s))
+    {
+      return -1;
+    }
+    pCam->owner[s] = APP_CAMERA_NN_BUF_CAMERA;
+  }
+  pCam->next_buf = 0;
+  pCam->suspended = 0;
+  pCam->late_frame = 0;
+
+  if (CMW_CAMERA_DoubleBufferStart(pCam->dcmipp_pipe, pPipe->slots[0].pInputs[0], pPipe->slots[1].pInputs[0],
+                                   CAMERA_MODE_CONTINUOUS) != CMW_ERROR_NONE)
+  {
+    return -1;
+  }
+
+  return 0;
+}
+
+void app_camera_nn_process(app_camera_nn_t *pCam)
+{
+  app_pipeline_t *pPipe = pCam->pPipe;
+
+  /* The stop requested by the frame event is effective once no frame is written anymore (a late frame ends with
+   * its own frame event) */
+  if (pCam->suspended && (pCam->late_frame || CMW_CAMERA_IsCaptureActive(pCam->dcmipp_pipe)))
+  {
+    return;
+  }
+
+  for (int32_t s = 0; s < APP_PIPELINE_NB_SLOTS; s++)
+  {
+    if (pCam->owner[s] == APP_CAMERA_NN_BUF_CAPTURED)
+    {
+      /* Slot is free: it has been given back to the camera before this frame was captured */
+      if (app_pipeline_push_slot(pPipe, s) == 0)
+      {
+        pCam->owner[s] = APP_CAMERA_NN_BUF_NPU;
+      }
+    }
+    else if ((pCam->owner[s] == APP_CAMERA_NN_BUF_NPU) && app_pipeline_slot_is_free(pPipe, s))
+    {
+      /* Post-processing of the frame is over */
+      pCam->owner[s] = APP_CAMERA_NN_BUF_CAMERA;
+    }
+  }
+
+  /* Stop confirmed: no frame event until resumed, no race with the interrupt handler */
+  if (pCam->suspended && (pCam->owner[pCam->next_buf] == APP_CAMERA_NN_BUF_CAMERA))
+  {
+    pCam->suspended = 0;
+    if (CMW_CAMERA_Resume(pCam->dcmipp_pipe) != CMW_ERROR_NONE)
+    {
+      assert(0);
+    }
+  }
+}
+
+void app_camera_nn_frame_event(app_camera_nn_t *pCam, uint32_t dcmipp_pipe)
+{
+  uint32_t buf = pCam->next_buf;
+
+  if (dcmipp_pipe != pCam->dcmipp_pipe)
+  {
+    return;
+  }
+
+  /* The DCMIPP alternates between its buffers whatever the owner */
+  pCam->next_buf = buf ^ 1;
+
+  if (pCam->suspended)
+  {
+    /* Frame started before the stop request: written to the buffer held by the NPU side, left to it */
+    pCam->late_frame = 0;
+    pCam->nb_late_frames++;
+    return;
+  }
+
+  pCam->owner[buf] = APP_CAMERA_NN_BUF_CAPTURED;
+  pCam->nb_frames++;
+
+  if (pCam->owner[pCam->next_buf] != APP_CAMERA_NN_BUF_CAMERA)
+  {
+    /* Interrupt context: no waiting for the end of the capture, confirmed by app_camera_nn_process() */
+    if (CMW_CAMERA_RequestSuspend(dcmipp_pipe) == CMW_ERROR_NONE)
+    {
+      pCam->suspended = 1;
+      pCam->nb_suspends++;
+      /* Late frame event: the next frame has already started */
+      pCam->late_frame = CMW_CAMERA_IsCaptureActive(dcmipp_pipe);
+    }
+  }
+}
@@ -0,0 +1,215 @@
+/**
+ ******************************************************************************
+ * @file    app_enc_lines.c
+ * @author  GPM Application Team
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2023 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <string.h>
+
+#include "app_enc_lines.h"
+#include "cmw_camera.h"
+#include "stm32n6xx_hal.h"
+
+#define MB_SIZE 16
+
+static void wait_rows(app_enc_lines_t *pEnc)
+{
+  if (pEnc->conf.wait != NULL)
+  {
+    pEnc->conf.wait(pEnc->conf.pUserData);
+  }
+  else
+  {
+    /* Woken up by the next line event at the latest */
+    __WFI();
+  }
+}
+
+static void signal_rows(app_enc_lines_t *pEnc)
+{
+  if (pEnc->conf.signal != NULL)
+  {
+    pEnc->conf.signal(pEnc->conf.pUserData);
+  }
+}
+
+/* Line buffer interrupt of the encoder, in the context of H264EncStrmEncode(): the rows given so far are read */
+static void line_buffer_cb(void *pAppData)
+{
+  app_enc_lines_t *pEnc = (app_enc_lines_t *)pAppData;
+  uint32_t read = H264EncGetEncodedMbLines(pEnc->conf.encoder);
+  uint32_t buf = pEnc->encode_buf;
+  uint32_t rows;
+  int waited = 0;
+
+  while (1)
+  {
+    if (pEnc->overrun || (pEnc->buf_frame_id[buf] != pEnc->encode_frame_id))
+    {
+      /* The camera writes the next frame in this buffer: complete the frame with what is in memory */
+      pEnc->nb_overruns += !pEnc->overrun;
+      pEnc->overrun = 1;
+      rows = pEnc->mb_per_col;
+      break;
+    }
+    rows = pEnc->mb_rows[buf];
+    if (rows > read)
+    {
+      break;
+    }
+    waited = 1;
+    wait_rows(pEnc);
+  }
+  pEnc->nb_waits += waited;
+
+  (void)H264EncSetInputMbLines(pEnc->conf.encoder, rows);
+}
+
+int app_enc_lines_init(app_enc_lines_t *pEnc, const app_enc_lines_conf_t *pConf)
+{
+  uint32_t mb_per_row = (pConf->width + MB_SIZE - 1) / MB_SIZE;
+
+  if ((pConf->encoder == NULL) || (pConf->width == 0) || (pConf->height == 0) || (pConf->pBuffers[0] == NULL) ||
+      (pConf->pBuffers[1] == NULL) || (pConf->depth == 0) || ((mb_per_row * pConf->depth) & 3))
+  {
+    return -1;
+  }
+
+  memset(pEnc, 0, sizeof(*pEnc));
+  pEnc->conf = *pConf;
+  pEnc->mb_per_row = mb_per_row;
+  pEnc->mb_per_col = (pConf->height + MB_SIZE - 1) / MB_SIZE;
+
+  return 0;
+}
+
+void app_enc_lines_coding_ctrl(const app_enc_lines_t *pEnc, H264EncCodingCtrl *pCodingCtrl)
+{
+  /* The input is the frame buffer itself: no loopback, the write pointer is the number of rows in memory */
+  pCodingCtrl->inputLineBufEn = 1;
+  pCodingCtrl->inputLineBufLoopBackEn = 0;
+  pCodingCtrl->inputLineBufHwModeEn = 0;
+  pCodingCtrl->inputLineBufDepth = pEnc->conf.depth;
+  pCodingCtrl->sliceSize = pEnc->conf.slice_rows;
+}
+
+int app_enc_lines_start(app_enc_lines_t *pEnc)
+{
+  pEnc->capture_buf = 0;
+  pEnc->frame_id = 0;
+  pEnc->mb_rows[0] = 0;
+  pEnc->mb_rows[1] = 0;
+  pEnc->buf_frame_id[0] = 0;
+  /* Not captured yet */
+  pEnc->buf_frame_id[1] = UINT32_MAX;
+  pEnc->encoded = 0;
+
+  if (CMW_CAMERA_EnableLineEvent(pEnc->conf.dcmipp_pipe, DCMIPP_MULTILINE_16_LINES) != CMW_ERROR_NONE)
+  {
+    return -1;
+  }
+
+  if (CMW_CAMERA_DoubleBufferStart(pEnc->conf.dcmipp_pipe, pEnc->conf.pBuffers[0], pEnc->conf.pBuffers[1],
+                                   CAMERA_MODE_CONTINUOUS) != CMW_ERROR_NONE)
+  {
+    return -1;
+  }
+
+  return 0;
+}
+
+H264EncRet app_enc_lines_encode(app_enc_lines_t *pEnc, H264EncIn *pEncIn, H264EncOut *pEncOut)
+{
+  uint32_t primask;
+  uint32_t buf;
+  uint32_t frame_id;
+  uint32_t rows;
+  H264EncRet ret;
+
+  /* Frame being captured, as soon as its first row is in memory */
+  while (1)
+  {
+    primask = __get_PRIMASK();
+    __disable_irq();
+    buf = pEnc->capture_buf;
+    frame_id = pEnc->buf_frame_id[buf];
+    rows = pEnc->mb_rows[buf];
+    __set_PRIMASK(primask);
+
+    if ((rows > 0) && (!pEnc->encoded || (frame_id != pEnc->last_frame_id)))
+    {
+      break;
+    }
+    wait_rows(pEnc);
+  }
+
+  if (pEnc->encoded)
+  {
+    pEnc->nb_skipped += frame_id - pEnc->last_frame_id - 1;
+  }
+  pEnc->encode_buf = buf;
+  pEnc->encode_frame_id = frame_id;
+  pEnc->overrun = 0;
+
+  pEncIn->busLuma = (ptr_t)pEnc->conf.pBuffers[buf];
+  pEncIn->busChromaU = (pEnc->conf.chroma_offset != 0) ? pEncIn->busLuma + pEnc->conf.chroma_offset : 0;
+  pEncIn->busChromaV = 0;
+  pEncIn->lineBufWrCnt = rows;
+
+  ret = H264EncStrmEncode(pEnc->conf.encoder, pEncIn, pEncOut, pEnc->conf.slice_cb, line_buffer_cb, pEnc);
+
+  pEnc->last_frame_id = frame_id;
+  pEnc->encoded = 1;
+  pEnc->nb_frames++;
+
+  return ret;
+}
+
+void app_enc_lines_line_event(app_enc_lines_t *pEnc, uint32_t dcmipp_pipe)
+{
+  uint32_t buf = pEnc->capture_buf;
+
+  if (dcmipp_pipe != pEnc->conf.dcmipp_pipe)
+  {
+    return;
+  }
+
+  /* The last row, possibly partial, is completed by the frame event */
+  if (pEnc->mb_rows[buf] < pEnc->mb_per_col)
+  {
+    pEnc->mb_rows[buf]++;
+  }
+  signal_rows(pEnc);
+}
+
+void app_enc_lines_frame_event(app_enc_lines_t *pEnc, uint32_t dcmipp_pipe)
+{
+  uint32_t buf = pEnc->capture_buf;
+  uint32_t next = buf ^ 1;
+
+  if (dcmipp_pipe != pEnc->conf.dcmipp_pipe)
+  {
+    return;
+  }
+
+  pEnc->mb_rows[buf] = pEnc->mb_per_col;
+
+  /* The DCMIPP switches to the other buffer for the next frame */
+  pEnc->frame_id++;
+  pEnc->mb_rows[next] = 0;
+  pEnc->buf_frame_id[next] = pEnc->frame_id;
+  pEnc->capture_buf = next;
+  signal_rows(pEnc);
+}
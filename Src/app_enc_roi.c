@@ -0,0 +1,217 @@
+/**
+ ******************************************************************************
+ * @file    app_enc_roi.c
+ * @author  GPM Application Team
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2023 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "app_enc_roi.h"
+
+typedef struct
+{
+  uint32_t x0;
+  uint32_t y0;
+  uint32_t x1; /* Exclusive */
+  uint32_t y1;
+} mb_rect_t;
+
+/* QP delta applied by the encoder to a ROI index, used as the priority of overlapping boxes */
+static int32_t index_qp_delta(const app_enc_roi_conf_t *pConf, uint8_t index)
+{
+  return (index == 0) ? 0 : pConf->qp_delta[index - 1];
+}
+
+static uint32_t clamp_mb(float pos, uint32_t nb_mb)
+{
+  if (pos <= 0.0f)
+  {
+    return 0;
+  }
+
+  return (pos >= (float)nb_mb) ? nb_mb : (uint32_t)pos;
+}
+
+/* Macroblocks covered, even partially, by the padded box. Returns 0 if the box is in the picture */
+static int box_to_mb_rect(const app_enc_roi_t *pRoi, const postprocess_outBuffer_t *pBox, mb_rect_t *pRect)
+{
+  const app_enc_roi_conf_t *pConf = &pRoi->conf;
+  float half_w = pBox->width * (0.5f + pConf->padding);
+  float half_h = pBox->height * (0.5f + pConf->padding);
+  float scale_x = pConf->fov_w * (float)pConf->width / APP_ENC_ROI_MB_SIZE;
+  float scale_y = pConf->fov_h * (float)pConf->height / APP_ENC_ROI_MB_SIZE;
+  float org_x = pConf->fov_x * (float)pConf->width / APP_ENC_ROI_MB_SIZE;
+  float org_y = pConf->fov_y * (float)pConf->height / APP_ENC_ROI_MB_SIZE;
+
+  pRect->x0 = clamp_mb(floorf(org_x + (pBox->x_center - half_w) * scale_x), pRoi->mb_per_row);
+  pRect->x1 = clamp_mb(ceilf(org_x + (pBox->x_center + half_w) * scale_x), pRoi->mb_per_row);
+  pRect->y0 = clamp_mb(floorf(org_y + (pBox->y_center - half_h) * scale_y), pRoi->mb_per_col);
+  pRect->y1 = clamp_mb(ceilf(org_y + (pBox->y_center + half_h) * scale_y), pRoi->mb_per_col);
+
+  /* Centroid models: a box without size still covers the macroblock of its center */
+  if ((pRect->x1 == pRect->x0) && (pRect->x0 < pRoi->mb_per_row))
+  {
+    pRect->x1 = pRect->x0 + 1;
+  }
+  if ((pRect->y1 == pRect->y0) && (pRect->y0 < pRoi->mb_per_col))
+  {
+    pRect->y1 = pRect->y0 + 1;
+  }
+
+  return ((pRect->x1 > pRect->x0) && (pRect->y1 > pRect->y0)) ? 0 : -1;
+}
+
+int app_enc_roi_init(app_enc_roi_t *pRoi, const app_enc_roi_conf_t *pConf, uint8_t *pMap, uint8_t *pAge)
+{
+  if ((pConf->width == 0) || (pConf->height == 0) || (pConf->fov_w <= 0.0f) || (pConf->fov_h <= 0.0f) ||
+      (pConf->hold_frames == UINT8_MAX) || (pConf->background_index >= APP_ENC_ROI_NB_INDEX) ||
+      ((pConf->nb_classes != 0) && (pConf->class_index == NULL)) || (pMap == NULL) || (pAge == NULL))
+  {
+    return -1;
+  }
+
+  /* Ranges of H264EncCodingCtrl.qpOffset, clipped by the encoder for index 2 and 3 */
+  if ((pConf->qp_delta[0] < -8) || (pConf->qp_delta[0] > 7))
+  {
+    return -1;
+  }
+  for (int i = 1; i < APP_ENC_ROI_NB_INDEX - 1; i++)
+  {
+    if ((pConf->qp_delta[i] < -30) || (pConf->qp_delta[i] > 30))
+    {
+      return -1;
+    }
+  }
+
+  memset(pRoi, 0, sizeof(*pRoi));
+  pRoi->conf = *pConf;
+  pRoi->mb_per_row = (pConf->width + APP_ENC_ROI_MB_SIZE - 1) / APP_ENC_ROI_MB_SIZE;
+  pRoi->mb_per_col = (pConf->height + APP_ENC_ROI_MB_SIZE - 1) / APP_ENC_ROI_MB_SIZE;
+  pRoi->pMap = pMap;
+  pRoi->pAge = pAge;
+  memset(pMap, pConf->background_index, pRoi->mb_per_row * pRoi->mb_per_col);
+  memset(pAge, 0, pRoi->mb_per_row * pRoi->mb_per_col);
+  pRoi->nb_roi_mb[pConf->background_index] = pRoi->mb_per_row * pRoi->mb_per_col;
+  pRoi->changed = 1;
+
+  return 0;
+}
+
+void app_enc_roi_coding_ctrl(const app_enc_roi_t *pRoi, H264EncCodingCtrl *pCodingCtrl)
+{
+  /* The ROI map excludes the rectangle and adaptive ROIs of the encoder */
+  pCodingCtrl->roi1Area.enable = 0;
+  pCodingCtrl->roi2Area.enable = 0;
+  pCodingCtrl->adaptiveRoi = 0;
+  pCodingCtrl->roiMapEnable = 1;
+  for (int i = 0; i < APP_ENC_ROI_NB_INDEX - 1; i++)
+  {
+    pCodingCtrl->qpOffset[i] = pRoi->conf.qp_delta[i];
+  }
+}
+
+void app_enc_roi_update(app_enc_roi_t *pRoi, const postprocess_out_t *pOutput)
+{
+  const app_enc_roi_conf_t *pConf = &pRoi->conf;
+  uint32_t nb_mb = pRoi->mb_per_row * pRoi->mb_per_col;
+  /* Age of the macroblocks covered in this frame, above any held one */
+  uint8_t fresh = pConf->hold_frames + 1;
+  mb_rect_t rect;
+
+  /* Macroblocks not seen for hold_frames frames go back to the background */
+  for (uint32_t mb = 0; mb < nb_mb; mb++)
+  {
+    if (pRoi->pAge[mb] > 0)
+    {
+      pRoi->pAge[mb]--;
+    }
+    if ((pRoi->pAge[mb] == 0) && (pRoi->pMap[mb] != pConf->background_index))
+    {
+      pRoi->pMap[mb] = pConf->background_index;
+      pRoi->changed = 1;
+    }
+  }
+
+  pRoi->nb_boxes = 0;
+  for (int32_t i = 0; i < pOutput->nb_detect; i++)
+  {
+    const postprocess_outBuffer_t *pBox = &pOutput->pOutBuff[i];
+    uint8_t index;
+
+    if ((pBox->conf < pConf->conf_threshold) || (pBox->class_index < 0) ||
+        ((uint32_t)pBox->class_index >= pConf->nb_classes))
+    {
+      continue;
+    }
+    index = pConf->class_index[pBox->class_index];
+    if ((index == pConf->background_index) || (index >= APP_ENC_ROI_NB_INDEX))
+    {
+      continue;
+    }
+    if (box_to_mb_rect(pRoi, pBox, &rect) != 0)
+    {
+      continue;
+    }
+    pRoi->nb_boxes++;
+
+    int32_t qp_delta = index_qp_delta(pConf, index);
+    for (uint32_t y = rect.y0; y < rect.y1; y++)
+    {
+      uint8_t *pMap = &pRoi->pMap[y * pRoi->mb_per_row];
+      uint8_t *pAge = &pRoi->pAge[y * pRoi->mb_per_row];
+
+      for (uint32_t x = rect.x0; x < rect.x1; x++)
+      {
+        /* Already covered in this frame by a box of higher or equal priority */
+        if ((pAge[x] == fresh) && (index_qp_delta(pConf, pMap[x]) <= qp_delta))
+        {
+          continue;
+        }
+        if (pMap[x] != index)
+        {
+          pMap[x] = index;
+          pRoi->changed = 1;
+        }
+        pAge[x] = fresh;
+      }
+    }
+  }
+
+  memset(pRoi->nb_roi_mb, 0, sizeof(pRoi->nb_roi_mb));
+  for (uint32_t mb = 0; mb < nb_mb; mb++)
+  {
+    pRoi->nb_roi_mb[pRoi->pMap[mb]]++;
+  }
+}
+
+H264EncRet app_enc_roi_apply(app_enc_roi_t *pRoi, H264EncInst encoder)
+{
+  H264EncRet ret;
+
+  /* The encoder keeps using its segment map until a new one is set: skip the repacking of an unchanged map */
+  if (!pRoi->changed)
+  {
+    return H264ENC_OK;
+  }
+
+  ret = H264EncSetRoiMap(encoder, pRoi->pMap);
+  if (ret == H264ENC_OK)
+  {
+    pRoi->changed = 0;
+  }
+
+  return ret;
+}
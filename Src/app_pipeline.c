@@ -0,0 +1,329 @@
+/**
+ ******************************************************************************
+ * @file    app_pipeline.c
+ * @author  GPM Application Team
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2023 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "app_config.h"
+#include "app_pipeline.h"
+#include "mcu_cache.h"
+#include "stm32n6xx_hal.h"
+#if defined(USE_NS_TIMER) && (USE_NS_TIMER == 1)
+#include "timer_config.h"
+/* TIM2 runs at 1 MHz: timer_config_read_ns() counts microseconds */
+#define APP_PIPELINE_NOW_NS() (timer_config_read_ns() * 1000ULL)
+#else
+/* One tick every HAL_GetTickFreq() ms */
+#define APP_PIPELINE_NOW_NS() ((uint64_t)HAL_GetTick() * (uint64_t)HAL_GetTickFreq() * 1000000ULL)
+#endif
+
+static uint32_t buffers_len(const LL_Buffer_InfoTypeDef *pInfo, uint32_t nb, uint32_t *pSizes)
+{
+  uint32_t i;
+
+  for (i = 0; (i < nb) && (pInfo[i].name != NULL); i++)
+  {
+    pSizes[i] = LL_Buffer_len(&pInfo[i]);
+  }
+
+  return i;
+}
+
+/* Oldest slot in the given state (lowest frame id), -1 if none */
+static int32_t oldest_slot(app_pipeline_t *pPipe, app_pipeline_slot_state_t state)
+{
+  int32_t oldest = -1;
+
+  for (int32_t s = 0; s < APP_PIPELINE_NB_SLOTS; s++)
+  {
+    if (pPipe->slots[s].state != state)
+    {
+      continue;
+    }
+    if ((oldest < 0) || ((int32_t)(pPipe->slots[s].frame_id - pPipe->slots[oldest].frame_id) < 0))
+    {
+      oldest = s;
+    }
+  }
+
+  return oldest;
+}
+
+static int start_inference(app_pipeline_t *pPipe, int32_t s)
+{
+  app_pipeline_slot_t *pSlot = &pPipe->slots[s];
+
+  for (uint32_t i = 0; i < pPipe->nb_inputs; i++)
+  {
+    if (LL_ATON_Set_User_Input_Buffer(pPipe->nn_instance, i, pSlot->pInputs[i], pPipe->input_sizes[i]) !=
+        LL_ATON_User_IO_NOERROR)
+    {
+      return -1;
+    }
+    if (!pSlot->input_dma)
+    {
+      /* Input has been written by the CPU */
+      mcu_cache_clean_range((uint32_t)pSlot->pInputs[i], (uint32_t)pSlot->pInputs[i] + pPipe->input_sizes[i]);
+    }
+  }
+  for (uint32_t i = 0; i < pPipe->nb_outputs; i++)
+  {
+    if (LL_ATON_Set_User_Output_Buffer(pPipe->nn_instance, i, pSlot->pOutputs[i], pPipe->output_sizes[i]) !=
+        LL_ATON_User_IO_NOERROR)
+    {
+      return -1;
+    }
+  }
+
+  pSlot->state = APP_PIPELINE_SLOT_RUNNING;
+  pSlot->ts_start_ns = APP_PIPELINE_NOW_NS();
+  if (!pPipe->stats.started)
+  {
+    /* Frames are released after the next one has started: nb_frames can't tell the first start */
+    pPipe->stats.started = 1;
+    pPipe->stats.first_start_ns = pSlot->ts_start_ns;
+  }
+  pPipe->running_slot = s;
+
+  return 0;
+}
+
+static void end_inference(app_pipeline_t *pPipe)
+{
+  app_pipeline_slot_t *pSlot = &pPipe->slots[pPipe->running_slot];
+
+  pSlot->ts_done_ns = APP_PIPELINE_NOW_NS();
+  for (uint32_t i = 0; i < pPipe->nb_outputs; i++)
+  {
+    /* Output has been written by the NPU */
+    mcu_cache_invalidate_range((uint32_t)pSlot->pOutputs[i], (uint32_t)pSlot->pOutputs[i] + pPipe->output_sizes[i]);
+  }
+  pSlot->state = APP_PIPELINE_SLOT_DONE;
+  pPipe->running_slot = -1;
+  pPipe->nb_inferences++;
+
+  /* Network stays initialized, only its execution state is re-armed for the next inference */
+  LL_ATON_RT_Reset_Network(pPipe->nn_instance);
+}
+
+int app_pipeline_init(app_pipeline_t *pPipe, NN_Instance_TypeDef *nn_instance,
+                      void *pInputs[APP_PIPELINE_NB_SLOTS][APP_PIPELINE_MAX_IO], uint32_t nb_inputs,
+                      void *pOutputs[APP_PIPELINE_NB_SLOTS][APP_PIPELINE_MAX_IO], uint32_t nb_outputs)
+{
+  assert(nb_inputs <= APP_PIPELINE_MAX_IO);
+  assert(nb_outputs <= APP_PIPELINE_MAX_IO);
+
+  memset(pPipe, 0, sizeof(*pPipe));
+  pPipe->nn_instance = nn_instance;
+  pPipe->filling_slot = -1;
+  pPipe->running_slot = -1;
+  pPipe->pp_slot = -1;
+
+  LL_ATON_RT_RuntimeInit();
+  LL_ATON_RT_Init_Network(nn_instance);
+
+  if ((buffers_len(LL_ATON_Input_Buffers_Info(nn_instance), nb_inputs, pPipe->input_sizes) != nb_inputs) ||
+      (buffers_len(LL_ATON_Output_Buffers_Info(nn_instance), nb_outputs, pPipe->output_sizes) != nb_outputs))
+  {
+    return -1;
+  }
+  pPipe->nb_inputs = nb_inputs;
+  pPipe->nb_outputs = nb_outputs;
+
+  for (int32_t s = 0; s < APP_PIPELINE_NB_SLOTS; s++)
+  {
+    memcpy(pPipe->slots[s].pInputs, pInputs[s], nb_inputs * sizeof(void *));
+    memcpy(pPipe->slots[s].pOutputs, pOutputs[s], nb_outputs * sizeof(void *));
+    pPipe->slots[s].state = APP_PIPELINE_SLOT_FREE;
+  }
+
+  return 0;
+}
+
+void app_pipeline_deinit(app_pipeline_t *pPipe)
+{
+  LL_ATON_RT_DeInit_Network(pPipe->nn_instance);
+  LL_ATON_RT_RuntimeDeInit();
+}
+
+void **app_pipeline_get_input(app_pipeline_t *pPipe)
+{
+  if (pPipe->filling_slot < 0)
+  {
+    pPipe->filling_slot = oldest_slot(pPipe, APP_PIPELINE_SLOT_FREE);
+    if (pPipe->filling_slot < 0)
+    {
+      return NULL;
+    }
+    pPipe->slots[pPipe->filling_slot].state = APP_PIPELINE_SLOT_FILLING;
+  }
+
+  return pPipe->slots[pPipe->filling_slot].pInputs;
+}
+
+void app_pipeline_push_input(app_pipeline_t *pPipe)
+{
+  assert(pPipe->filling_slot >= 0);
+
+  app_pipeline_slot_t *pSlot = &pPipe->slots[pPipe->filling_slot];
+
+  pSlot->frame_id = pPipe->next_frame_id++;
+  pSlot->ts_queued_ns = APP_PIPELINE_NOW_NS();
+  pSlot->input_dma = 0;
+  pSlot->state = APP_PIPELINE_SLOT_QUEUED;
+  pPipe->filling_slot = -1;
+}
+
+int app_pipeline_slot_is_free(const app_pipeline_t *pPipe, int32_t slot)
+{
+  assert((slot >= 0) && (slot < APP_PIPELINE_NB_SLOTS));
+
+  return (pPipe->slots[slot].state == APP_PIPELINE_SLOT_FREE) && (pPipe->filling_slot != slot);
+}
+
+int app_pipeline_push_slot(app_pipeline_t *pPipe, int32_t slot)
+{
+  if (!app_pipeline_slot_is_free(pPipe, slot))
+  {
+    return -1;
+  }
+
+  app_pipeline_slot_t *pSlot = &pPipe->slots[slot];
+
+  pSlot->frame_id = pPipe->next_frame_id++;
+  pSlot->ts_queued_ns = APP_PIPELINE_NOW_NS();
+  pSlot->input_dma = 1;
+  pSlot->state = APP_PIPELINE_SLOT_QUEUED;
+
+  return 0;
+}
+
+LL_ATON_RT_RetValues_t app_pipeline_run(app_pipeline_t *pPipe)
+{
+  LL_ATON_RT_RetValues_t ret;
+
+  if (pPipe->running_slot < 0)
+  {
+    int32_t s = oldest_slot(pPipe, APP_PIPELINE_SLOT_QUEUED);
+    if (s < 0)
+    {
+      /* NPU idle: the caller has to produce an input first */
+      return LL_ATON_RT_NO_WFE;
+    }
+    if (start_inference(pPipe, s) != 0)
+    {
+      /* Not user allocated I/O or wrong buffer: drop the frame */
+      pPipe->slots[s].state = APP_PIPELINE_SLOT_FREE;
+      return LL_ATON_RT_NO_WFE;
+    }
+  }
+
+  ret = LL_ATON_RT_RunEpochBlock(pPipe->nn_instance);
+  if (ret == LL_ATON_RT_DONE)
+  {
+    end_inference(pPipe);
+    ret = LL_ATON_RT_NO_WFE;
+  }
+
+  return ret;
+}
+
+void **app_pipeline_get_output(app_pipeline_t *pPipe, uint32_t *pFrame_id)
+{
+  if (pPipe->pp_slot < 0)
+  {
+    pPipe->pp_slot = oldest_slot(pPipe, APP_PIPELINE_SLOT_DONE);
+    if (pPipe->pp_slot < 0)
+    {
+      return NULL;
+    }
+    pPipe->slots[pPipe->pp_slot].state = APP_PIPELINE_SLOT_POSTPROCESSING;
+    pPipe->slots[pPipe->pp_slot].ts_pp_start_ns = APP_PIPELINE_NOW_NS();
+  }
+
+  if (pFrame_id != NULL)
+  {
+    *pFrame_id = pPipe->slots[pPipe->pp_slot].frame_id;
+  }
+
+  return pPipe->slots[pPipe->pp_slot].pOutputs;
+}
+
+void app_pipeline_release_output(app_pipeline_t *pPipe)
+{
+  assert(pPipe->pp_slot >= 0);
+
+  app_pipeline_slot_t *pSlot = &pPipe->slots[pPipe->pp_slot];
+  uint64_t now = APP_PIPELINE_NOW_NS();
+
+  pPipe->stats.queue_ns += pSlot->ts_start_ns - pSlot->ts_queued_ns;
+  pPipe->stats.inference_ns += pSlot->ts_done_ns - pSlot->ts_start_ns;
+  pPipe->stats.ready_ns += pSlot->ts_pp_start_ns - pSlot->ts_done_ns;
+  pPipe->stats.postprocess_ns += now - pSlot->ts_pp_start_ns;
+  pPipe->stats.last_release_ns = now;
+  pPipe->stats.nb_frames++;
+
+  pSlot->state = APP_PIPELINE_SLOT_FREE;
+  pPipe->pp_slot = -1;
+}
+
+void app_pipeline_report(app_pipeline_t *pPipe)
+{
+  app_pipeline_stats_t *pStats = &pPipe->stats;
+  uint32_t nb = pStats->nb_frames;
+  uint64_t wall_ns = pStats->last_release_ns - pStats->first_start_ns;
+
+  if ((nb == 0) || (wall_ns == 0))
+  {
+    printf("pipeline: no frame\r\n");
+    return;
+  }
+
+  uint32_t inference_us = (uint32_t)(pStats->inference_ns / nb / 1000);
+  uint32_t postprocess_us = (uint32_t)(pStats->postprocess_ns / nb / 1000);
+
+  /* Without overlap the frame period would be at least inference + post-processing */
+  printf("pipeline: %lu frames, %lu.%02lu fps (serial bound %lu.%02lu fps), NPU load %lu%%\r\n",
+         (unsigned long)nb,
+         (unsigned long)(nb * 1000000000ULL / wall_ns),
+         (unsigned long)((nb * 100000000000ULL / wall_ns) % 100),
+         (unsigned long)(1000000UL / (inference_us + postprocess_us + 1)),
+         (unsigned long)((100000000UL / (inference_us + postprocess_us + 1)) % 100),
+         (unsigned long)(pStats->inference_ns * 100 / wall_ns));
+  printf("pipeline: avg us queue %lu, inference %lu, ready %lu, post-processing %lu\r\n",
+         (unsigned long)(pStats->queue_ns / nb / 1000),
+         (unsigned long)inference_us,
+         (unsigned long)(pStats->ready_ns / nb / 1000),
+         (unsigned long)postprocess_us);
+
+  memset(pStats, 0, sizeof(*pStats));
+
+  /* Frames in flight are counted in the next window: it starts with the oldest of them */
+  for (uint32_t s = 0; s < APP_PIPELINE_NB_SLOTS; s++)
+  {
+    app_pipeline_slot_t *pSlot = &pPipe->slots[s];
+
+    if ((pSlot->state >= APP_PIPELINE_SLOT_RUNNING) &&
+        (!pStats->started || (pSlot->ts_start_ns < pStats->first_start_ns)))
+    {
+      pStats->started = 1;
+      pStats->first_start_ns = pSlot->ts_start_ns;
+    }
+  }
+}
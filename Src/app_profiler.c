@@ -0,0 +1,413 @@
+/**
+ ******************************************************************************
+ * @file    app_profiler.c
+ * @author  GPM Application Team
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2023 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "app_config.h"
+#include "app_profiler.h"
+#if LL_ATON_SW_FALLBACK == 1
+#include "ll_sw.h"
+#endif
+
+#if defined(__ARM_ARCH)
+#include "stm32n6xx_hal.h"
+/* DWT cycle counter, enabled by app_profiler_attach(): durations up to 2^32 cycles (~5 s at 800 MHz) */
+#define APP_PROFILER_NOW() DWT->CYCCNT
+#define APP_PROFILER_ELAPSED_NS(t0, t1) ((uint64_t)(uint32_t)((t1) - (t0)) * 1000000000ULL / SystemCoreClock)
+#else
+#include <time.h>
+static uint64_t app_profiler_now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+#define APP_PROFILER_NOW() app_profiler_now_ns()
+#define APP_PROFILER_ELAPSED_NS(t0, t1) ((t1) - (t0))
+#endif
+
+#ifdef __ARM_ARCH
+#include "stm32n6xx_hal.h"
+extern UART_HandleTypeDef UartHandle;
+#define APP_PROFILER_WRITE(pData, size) HAL_UART_Transmit(&UartHandle, (const uint8_t *)(pData), (size), HAL_MAX_DELAY)
+#else
+#define APP_PROFILER_WRITE(pData, size) fwrite((pData), 1, (size), stdout)
+#endif
+
+#define APP_PROFILER_BIN_VERSION 2
+#define APP_PROFILER_BIN_ENTRY_SIZE (1 + 2 + 2 + 1 + 1 + 4 + 4 + 4 + 8 + 2 * APP_PROFILER_NB_BINS)
+
+typedef struct
+{
+  NN_Instance_TypeDef *nn_instance;
+  TraceEpochBlock_FuncPtr_t chained_cb;
+  int32_t last_entry;
+} app_profiler_network_t;
+
+static app_profiler_entry_t entries[APP_PROFILER_MAX_ENTRIES];
+static uint32_t nb_entries;
+static uint32_t nb_dropped;
+static app_profiler_network_t networks[APP_PROFILER_MAX_NETWORKS];
+
+static const char *const kind_names[APP_PROFILER_NB_KINDS] = {"hw", "sw", "hybrid", "internal"};
+
+static uint32_t duration_bin(uint32_t ns)
+{
+  if (ns < 1024)
+  {
+    return 0;
+  }
+
+  uint32_t octave = 31 - __builtin_clz(ns);
+  uint32_t half = (ns >> (octave - 1)) & 1;
+  uint32_t bin = 1 + 2 * (octave - 10) + half;
+
+  return (bin < APP_PROFILER_NB_BINS) ? bin : APP_PROFILER_NB_BINS - 1;
+}
+
+/* Upper bound of a histogram bin, in ns */
+static uint64_t bin_upper_ns(uint32_t bin)
+{
+  if (bin == 0)
+  {
+    return 1024;
+  }
+
+  uint32_t octave = 10 + (bin - 1) / 2;
+
+  return ((bin - 1) & 1) ? (2ULL << octave) : (3ULL << (octave - 1));
+}
+
+static uint64_t entry_p99_ns(const app_profiler_entry_t *pEntry)
+{
+  uint32_t target = pEntry->count - pEntry->count / 100;
+  uint32_t cumul = 0;
+
+  for (uint32_t b = 0; b < APP_PROFILER_NB_BINS; b++)
+  {
+    cumul += pEntry->hist[b];
+    if (cumul >= target)
+    {
+      uint64_t upper = bin_upper_ns(b);
+      return (upper < pEntry->max_ns) ? upper : pEntry->max_ns;
+    }
+  }
+
+  return pEntry->max_ns;
+}
+
+static app_profiler_network_t *find_network(const NN_Instance_TypeDef *nn_instance)
+{
+  for (uint32_t i = 0; i < APP_PROFILER_MAX_NETWORKS; i++)
+  {
+    if (networks[i].nn_instance == nn_instance)
+    {
+      return &networks[i];
+    }
+  }
+
+  return NULL;
+}
+
+static app_profiler_kind_t eb_kind(const LL_ATON_RT_EpochBlockItem_t *eb)
+{
+  if (EpochBlock_IsEpochInternal(eb))
+  {
+    return APP_PROFILER_KIND_INTERNAL;
+  }
+  if (EpochBlock_IsEpochHybrid(eb))
+  {
+    return APP_PROFILER_KIND_HYBRID;
+  }
+  if (EpochBlock_IsEpochPureSW(eb))
+  {
+    return APP_PROFILER_KIND_SW;
+  }
+
+  return APP_PROFILER_KIND_HW;
+}
+
+/* Epoch blocks run in the same order at every inference: the entry following the last one used is tried first */
+static app_profiler_entry_t *find_entry(app_profiler_network_t *pNet, const NN_Instance_TypeDef *nn_instance,
+                                        const LL_ATON_RT_EpochBlockItem_t *eb, bool create)
+{
+  app_profiler_kind_t kind = eb_kind(eb);
+  const LL_ATON_RT_EpochBlockItem_t *key = eb;
+  const LL_ATON_RT_EpochBlockItem_t *first = nn_instance->exec_state.first_epoch_block;
+
+  /* Epoch blocks inserted by the ATON lib live in a temporary list: they are accounted to their hybrid parent */
+  if (kind == APP_PROFILER_KIND_INTERNAL)
+  {
+    key = nn_instance->exec_state.saved_current_epoch_block;
+    first = nn_instance->exec_state.saved_first_epoch_block;
+    if (key == NULL)
+    {
+      return NULL;
+    }
+  }
+
+  int32_t hint = pNet->last_entry;
+  for (uint32_t n = 0; n < nb_entries; n++)
+  {
+    int32_t i = (int32_t)((hint + 1 + n) % nb_entries);
+    app_profiler_entry_t *pEntry = &entries[i];
+    if ((pEntry->eb == key) && (pEntry->kind == kind) && (pEntry->nn_instance == nn_instance))
+    {
+      pNet->last_entry = i;
+      return pEntry;
+    }
+  }
+
+  if (!create)
+  {
+    return NULL;
+  }
+  if (nb_entries == APP_PROFILER_MAX_ENTRIES)
+  {
+    nb_dropped++;
+    return NULL;
+  }
+
+  app_profiler_entry_t *pEntry = &entries[nb_entries];
+  memset(pEntry, 0, sizeof(*pEntry));
+  pEntry->nn_instance = nn_instance;
+  pEntry->net = (uint8_t)(pNet - networks);
+  pEntry->eb = key;
+  pEntry->index = (uint16_t)(key - first);
+#ifdef LL_ATON_EB_DBG_INFO
+  pEntry->epoch_num = key->epoch_num;
+#else
+  pEntry->epoch_num = -1;
+#endif
+  pEntry->kind = (uint8_t)kind;
+  pEntry->sw_node_type = -1;
+  pEntry->min_ns = UINT32_MAX;
+  pNet->last_entry = (int32_t)nb_entries;
+  nb_entries++;
+
+  return pEntry;
+}
+
+static void add_sample(app_profiler_entry_t *pEntry, uint64_t duration_ns)
+{
+  uint32_t ns = (duration_ns > UINT32_MAX) ? UINT32_MAX : (uint32_t)duration_ns;
+
+  pEntry->count++;
+  pEntry->sum_ns += ns;
+  if (ns < pEntry->min_ns)
+  {
+    pEntry->min_ns = ns;
+  }
+  if (ns > pEntry->max_ns)
+  {
+    pEntry->max_ns = ns;
+  }
+  uint16_t *pBin = &pEntry->hist[duration_bin(ns)];
+  if (*pBin != UINT16_MAX)
+  {
+    (*pBin)++;
+  }
+}
+
+static void app_profiler_epoch_cb(LL_ATON_RT_Callbacktype_t ctype, const NN_Instance_TypeDef *nn_instance,
+                                  const LL_ATON_RT_EpochBlockItem_t *eb)
+{
+  uint64_t now = APP_PROFILER_NOW();
+  app_profiler_network_t *pNet = find_network(nn_instance);
+  app_profiler_entry_t *pEntry;
+
+  if (pNet == NULL)
+  {
+    return;
+  }
+
+  switch (ctype)
+  {
+  case LL_ATON_RT_Callbacktype_PRE_START:
+    pEntry = find_entry(pNet, nn_instance, eb, true);
+    if (pEntry != NULL)
+    {
+#if LL_ATON_SW_FALLBACK == 1
+      ll_sw_last_node_type = -1;
+#endif
+      pEntry->started = 1;
+      pEntry->ts_start = APP_PROFILER_NOW(); /* Excludes the look-up above */
+    }
+    break;
+  case LL_ATON_RT_Callbacktype_POST_END:
+    pEntry = find_entry(pNet, nn_instance, eb, false);
+    if ((pEntry != NULL) && pEntry->started)
+    {
+      add_sample(pEntry, APP_PROFILER_ELAPSED_NS(pEntry->ts_start, now));
+      pEntry->started = 0;
+#if LL_ATON_SW_FALLBACK == 1
+      if (pEntry->kind == APP_PROFILER_KIND_SW)
+      {
+        pEntry->sw_node_type = (int8_t)ll_sw_last_node_type;
+      }
+#endif
+    }
+    break;
+  default:
+    break;
+  }
+
+  if (pNet->chained_cb != NULL)
+  {
+    pNet->chained_cb(ctype, nn_instance, eb);
+  }
+}
+
+int app_profiler_attach(NN_Instance_TypeDef *nn_instance)
+{
+  app_profiler_network_t *pNet;
+
+  assert(nn_instance != NULL);
+
+  if (find_network(nn_instance) != NULL)
+  {
+    return 0;
+  }
+  pNet = find_network(NULL);
+  if (pNet == NULL)
+  {
+    return -1;
+  }
+
+  pNet->nn_instance = nn_instance;
+  pNet->chained_cb = nn_instance->exec_state.epoch_callback_function;
+  pNet->last_entry = -1;
+#ifdef __ARM_ARCH
+  DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+  LL_ATON_RT_SetNetworkCallback(nn_instance, app_profiler_epoch_cb);
+
+  return 0;
+}
+
+void app_profiler_detach(NN_Instance_TypeDef *nn_instance)
+{
+  app_profiler_network_t *pNet = find_network(nn_instance);
+
+  if (pNet == NULL)
+  {
+    return;
+  }
+
+  LL_ATON_RT_SetNetworkCallback(nn_instance, pNet->chained_cb);
+  memset(pNet, 0, sizeof(*pNet));
+}
+
+void app_profiler_reset(void)
+{
+  nb_entries = 0;
+  nb_dropped = 0;
+  for (uint32_t i = 0; i < APP_PROFILER_MAX_NETWORKS; i++)
+  {
+    networks[i].last_entry = -1;
+  }
+}
+
+void app_profiler_export_csv(void)
+{
+  uint64_t kind_ns[APP_PROFILER_NB_KINDS] = {0};
+  uint64_t total_ns = 0;
+
+  printf("net,eb,epoch,kind,sw_node,count,min_us,avg_us,p99_us,max_us,total_us\r\n");
+  for (uint32_t i = 0; i < nb_entries; i++)
+  {
+    const app_profiler_entry_t *pEntry = &entries[i];
+    if (pEntry->count == 0)
+    {
+      continue;
+    }
+    printf("%s,%u,%d,%s,%d,%lu,%lu,%lu,%lu,%lu,%lu\r\n",
+           pEntry->nn_instance->network->network_name,
+           (unsigned)pEntry->index,
+           (int)pEntry->epoch_num,
+           kind_names[pEntry->kind],
+           (int)pEntry->sw_node_type,
+           (unsigned long)pEntry->count,
+           (unsigned long)(pEntry->min_ns / 1000),
+           (unsigned long)(pEntry->sum_ns / pEntry->count / 1000),
+           (unsigned long)(entry_p99_ns(pEntry) / 1000),
+           (unsigned long)(pEntry->max_ns / 1000),
+           (unsigned long)(pEntry->sum_ns / 1000));
+    kind_ns[pEntry->kind] += pEntry->sum_ns;
+    total_ns += pEntry->sum_ns;
+  }
+
+  for (uint32_t k = 0; k < APP_PROFILER_NB_KINDS; k++)
+  {
+    printf("# %s: %lu us (%lu%%)\r\n", kind_names[k], (unsigned long)(kind_ns[k] / 1000),
+           (unsigned long)(total_ns ? kind_ns[k] * 100 / total_ns : 0));
+  }
+  if (nb_dropped != 0)
+  {
+    printf("# %lu epoch blocks not tracked, raise APP_PROFILER_MAX_ENTRIES\r\n", (unsigned long)nb_dropped);
+  }
+}
+
+static uint8_t *put_le(uint8_t *p, uint64_t value, uint32_t size)
+{
+  for (uint32_t i = 0; i < size; i++)
+  {
+    *p++ = (uint8_t)(value >> (8 * i));
+  }
+
+  return p;
+}
+
+void app_profiler_export_bin(void)
+{
+  uint8_t buf[APP_PROFILER_BIN_ENTRY_SIZE];
+  uint8_t *p = buf;
+
+  memcpy(p, "EBPF", 4);
+  p += 4;
+  p = put_le(p, APP_PROFILER_BIN_VERSION, 2);
+  p = put_le(p, nb_entries, 2);
+  p = put_le(p, APP_PROFILER_NB_BINS, 2);
+  p = put_le(p, APP_PROFILER_BIN_ENTRY_SIZE, 2);
+  APP_PROFILER_WRITE(buf, p - buf);
+
+  for (uint32_t i = 0; i < nb_entries; i++)
+  {
+    const app_profiler_entry_t *pEntry = &entries[i];
+    p = buf;
+    p = put_le(p, pEntry->net, 1);
+    p = put_le(p, pEntry->index, 2);
+    p = put_le(p, (uint16_t)pEntry->epoch_num, 2);
+    p = put_le(p, pEntry->kind, 1);
+    p = put_le(p, (uint8_t)pEntry->sw_node_type, 1);
+    p = put_le(p, pEntry->count, 4);
+    p = put_le(p, pEntry->count ? pEntry->min_ns : 0, 4);
+    p = put_le(p, pEntry->max_ns, 4);
+    p = put_le(p, pEntry->sum_ns, 8);
+    for (uint32_t b = 0; b < APP_PROFILER_NB_BINS; b++)
+    {
+      p = put_le(p, pEntry->hist[b], 2);
+    }
+    assert(p - buf == APP_PROFILER_BIN_ENTRY_SIZE);
+    APP_PROFILER_WRITE(buf, p - buf);
+  }
+}
@@ -0,0 +1,139 @@
+/**
+ ******************************************************************************
+ * @file    app_vision_stream.c
+ * @author  GPM Application Team
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2023 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <string.h>
+
+#include "app_vision_stream.h"
+
+static uint8_t *put_u16(uint8_t *p, uint16_t value)
+{
+  p[0] = (uint8_t)(value >> 8);
+  p[1] = (uint8_t)value;
+
+  return p + 2;
+}
+
+static uint8_t *put_u32(uint8_t *p, uint32_t value)
+{
+  p = put_u16(p, (uint16_t)(value >> 16));
+
+  return put_u16(p, (uint16_t)value);
+}
+
+/* Fraction of the picture in 1/65535 */
+static uint16_t to_q16(float value)
+{
+  if (value <= 0.0f)
+  {
+    return 0;
+  }
+
+  return (value >= 1.0f) ? UINT16_MAX : (uint16_t)(value * UINT16_MAX + 0.5f);
+}
+
+static uint8_t to_score(float conf)
+{
+  if (conf <= 0.0f)
+  {
+    return 0;
+  }
+
+  return (conf >= 1.0f) ? UINT8_MAX : (uint8_t)(conf * UINT8_MAX + 0.5f);
+}
+
+/* RTP header extension: one RFC 8285 two-byte header element holding the record, zero padded */
+static void build_ext(app_vision_stream_t *pVs)
+{
+  const uint8_t *pRecord = &pVs->sei[APP_VISION_STREAM_UUID_SIZE];
+  uint32_t size = 2 + pVs->record_size;
+
+  pVs->ext_size = (size + 3) & ~3U;
+  pVs->ext[0] = pVs->conf.ext_id;
+  pVs->ext[1] = (uint8_t)pVs->record_size;
+  memcpy(&pVs->ext[2], pRecord, pVs->record_size);
+  memset(&pVs->ext[size], 0, pVs->ext_size - size);
+}
+
+int app_vision_stream_init(app_vision_stream_t *pVs, const app_vision_stream_conf_t *pConf)
+{
+  if ((pConf->fov_w <= 0.0f) || (pConf->fov_h <= 0.0f) || (pConf->ext_id == 0))
+  {
+    return -1;
+  }
+
+  memset(pVs, 0, sizeof(*pVs));
+  pVs->conf = *pConf;
+  memcpy(pVs->sei, pConf->uuid, APP_VISION_STREAM_UUID_SIZE);
+
+  /* No detection until the first update */
+  app_vision_stream_update(pVs, NULL, 0);
+
+  return 0;
+}
+
+void app_vision_stream_update(app_vision_stream_t *pVs, const postprocess_out_t *pOutput, uint32_t source_timestamp)
+{
+  const app_vision_stream_conf_t *pConf = &pVs->conf;
+  uint8_t *pRecord = &pVs->sei[APP_VISION_STREAM_UUID_SIZE];
+  uint8_t *p = pRecord + APP_VISION_STREAM_HEADER_SIZE;
+  int32_t nb_detect = (pOutput != NULL) ? pOutput->nb_detect : 0;
+  uint32_t nb = 0;
+
+  for (int32_t i = 0; i < nb_detect; i++)
+  {
+    const postprocess_outBuffer_t *pBox = &pOutput->pOutBuff[i];
+
+    if ((pBox->conf < pConf->conf_threshold) || (pBox->class_index < 0) || (pBox->class_index > UINT8_MAX))
+    {
+      continue;
+    }
+    if (nb == APP_VISION_STREAM_MAX_DETECTIONS)
+    {
+      pVs->nb_dropped++;
+      continue;
+    }
+
+    /* From the network input to the encoded picture */
+    *p++ = (uint8_t)pBox->class_index;
+    *p++ = to_score(pBox->conf);
+    p = put_u16(p, to_q16(pConf->fov_x + pBox->x_center * pConf->fov_w));
+    p = put_u16(p, to_q16(pConf->fov_y + pBox->y_center * pConf->fov_h));
+    p = put_u16(p, to_q16(pBox->width * pConf->fov_w));
+    p = put_u16(p, to_q16(pBox->height * pConf->fov_h));
+    nb++;
+  }
+
+  pRecord[0] = APP_VISION_STREAM_VERSION;
+  pRecord[1] = (uint8_t)nb;
+  put_u32(&pRecord[2], source_timestamp);
+  pVs->record_size = (uint32_t)(p - pRecord);
+  pVs->nb_detections = nb;
+
+  build_ext(pVs);
+}
+
+H264EncRet app_vision_stream_h264_attach(app_vision_stream_t *pVs, H264EncInst encoder)
+{
+  /* The encoder keeps the pointer: the SEI message is inserted in each frame until the next update */
+  return H264EncSetSeiUserData(encoder, pVs->sei, APP_VISION_STREAM_UUID_SIZE + pVs->record_size);
+}
+
+UINT app_vision_stream_rtp_attach(app_vision_stream_t *pVs, NX_RTP_SESSION *pSession)
+{
+  return nx_rtp_sender_session_header_extension_set(pSession, APP_VISION_STREAM_RTP_PROFILE, pVs->ext, pVs->ext_size);
+}
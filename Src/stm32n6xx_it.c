@@ -19,6 +19,10 @@
 /* Includes ------------------------------------------------------------------*/
 #include "stm32n6xx_hal.h"
 #include "stm32n6xx_it.h"
+#include "cmw_camera.h"
+#if defined(EI_CONTINUOUS_AUDIO) && (EI_CONTINUOUS_AUDIO == 1)
+#include "stm32n6570_discovery_audio.h"
+#endif
 
 /**
   * @brief   This function handles NMI exception.
@@ -147,3 +151,19 @@ void DCMIPP_IRQHandler(void)
 {
   HAL_DCMIPP_IRQHandler(CMW_CAMERA_GetDCMIPPHandle());
 }
+
+#if defined(CMW_ISP_TASK_IRQHandler)
+/* ISP task pended by the camera middleware on VSYNC, see CMW_CAMERA_EnableISPTask() */
+void CMW_ISP_TASK_IRQHandler(void)
+{
+  CMW_CAMERA_ISPTaskHandler();
+}
+#endif
+
+#if defined(EI_CONTINUOUS_AUDIO) && (EI_CONTINUOUS_AUDIO == 1)
+/* MDF DMA of the digital microphones (AUDIO_IN_MDF1_DMA_IRQ) */
+void GPDMA1_Channel0_IRQHandler(void)
+{
+  BSP_AUDIO_IN_IRQHandler(1, AUDIO_IN_DEVICE_DIGITAL_MIC);
+}
+#endif
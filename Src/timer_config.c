@@ -57,7 +57,7 @@ HAL_StatusTypeDef timer_config_init(void)
     }
 
     fact = __HAL_TIM_CALC_PSC(uwTimclock, TIM_CNT_FREQ_NS);
-    overflow_time = ((uint64_t)1 << 32) / fact;
+    overflow_time = (uint64_t)1 << 32; /* Counter period at 1 MHz, in us */
     
     /* Initialize TIM2 */
     TimHandle.Instance = TIM2;
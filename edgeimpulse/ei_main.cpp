@@ -37,7 +37,171 @@
 #include "edge-impulse-sdk/porting/ei_classifier_porting.h"
 #include "model-parameters/model_variables.h"
 #include "stm32n6xx_hal.h"
+#if defined(EI_CONTINUOUS_AUDIO) && (EI_CONTINUOUS_AUDIO == 1)
+#include "stm32n6570_discovery_audio.h"
+#endif
+
+#if defined(EI_CONTINUOUS_AUDIO) && (EI_CONTINUOUS_AUDIO == 1)
+/* Continuous classification of the digital microphone: the MDF fills a DMA buffer through the BSP, its halves are
+ * copied into slices of EI_CLASSIFIER_SLICE_SIZE samples (the hop), and each slice is given to
+ * run_classifier_continuous(). The SDK only computes the MFCC frames of the new slice and keeps the features of the
+ * previous ones in its ring, inference runs every slice on the last model window.
+ */
+#define AUDIO_INSTANCE          1U
+/* Samples per half of the DMA buffer, the BSP converts at most DEFAULT_AUDIO_IN_BUFFER_SIZE samples */
+#define AUDIO_HALF_SAMPLES      (DEFAULT_AUDIO_IN_BUFFER_SIZE / 4U)
 
+/* Private variables ------------------------------------------------------- */
+static int16_t audio_rec_buf[2 * AUDIO_HALF_SAMPLES] __attribute__((aligned(32)));
+/* One slice filled by the microphone, one waiting and one classified */
+static int16_t slices[3][EI_CLASSIFIER_SLICE_SIZE];
+static volatile uint32_t slice_fill;          /* Samples in the slice being filled */
+static volatile int slice_filling;            /* Slice being filled by the microphone */
+static volatile int slice_ready = -1;         /* Full slice waiting for the classifier, -1 if none */
+static volatile int slice_busy = -1;          /* Slice being classified, -1 if none */
+static volatile uint32_t nb_overruns;         /* Slices dropped because the classifier was late */
+static int16_t *slice_classified;
+
+/* Interrupt context: copies a half of the DMA buffer into the slices */
+static void audio_push(const int16_t *samples, uint32_t nb)
+{
+    while (nb > 0) {
+        uint32_t n = EI_CLASSIFIER_SLICE_SIZE - slice_fill;
+
+        if (n > nb) {
+            n = nb;
+        }
+        memcpy(&slices[slice_filling][slice_fill], samples, n * sizeof(int16_t));
+        slice_fill += n;
+        samples += n;
+        nb -= n;
+
+        if (slice_fill == EI_CLASSIFIER_SLICE_SIZE) {
+            if (slice_ready >= 0) {
+                /* The previous slice was not classified yet: it is replaced, the features skip a hop */
+                nb_overruns++;
+            }
+            slice_ready = slice_filling;
+            /* Neither the waiting nor the classified slice */
+            slice_filling = 0;
+            while ((slice_filling == slice_ready) || (slice_filling == slice_busy)) {
+                slice_filling++;
+            }
+            slice_fill = 0;
+        }
+    }
+}
+
+extern "C" void BSP_AUDIO_IN_HalfTransfer_CallBack(uint32_t Instance)
+{
+    if (Instance == AUDIO_INSTANCE) {
+        audio_push(&audio_rec_buf[0], AUDIO_HALF_SAMPLES);
+    }
+}
+
+extern "C" void BSP_AUDIO_IN_TransferComplete_CallBack(uint32_t Instance)
+{
+    if (Instance == AUDIO_INSTANCE) {
+        audio_push(&audio_rec_buf[AUDIO_HALF_SAMPLES], AUDIO_HALF_SAMPLES);
+    }
+}
+
+static int audio_slice_get_data(size_t offset, size_t length, float *out_ptr)
+{
+    return ei::numpy::int16_to_float(slice_classified + offset, out_ptr, length);
+}
+
+/* Waits for the next slice of the microphone, its buffer is not written until the next wait */
+static int16_t *audio_slice_wait(void)
+{
+    int ready;
+
+    while (1) {
+        __disable_irq();
+        ready = slice_ready;
+        if (ready >= 0) {
+            slice_ready = -1;
+            slice_busy = ready;
+        }
+        __enable_irq();
+
+        if (ready >= 0) {
+            return slices[ready];
+        }
+        /* Woken up by the next DMA interrupt at the latest */
+        __WFI();
+    }
+}
+
+static int audio_start(void)
+{
+    BSP_AUDIO_Init_t audio_init;
+
+    audio_init.Device = AUDIO_IN_DEVICE_DIGITAL_MIC;
+    audio_init.SampleRate = EI_CLASSIFIER_FREQUENCY;
+    audio_init.BitsPerSample = AUDIO_RESOLUTION_16B;
+    audio_init.ChannelsNbr = 1;
+    audio_init.Volume = 100;
+
+    if (BSP_AUDIO_IN_Init(AUDIO_INSTANCE, &audio_init) != BSP_ERROR_NONE) {
+        return -1;
+    }
+    if (BSP_AUDIO_IN_Record(AUDIO_INSTANCE, (uint8_t *)audio_rec_buf, sizeof(audio_rec_buf)) != BSP_ERROR_NONE) {
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * Classifies the microphone stream, a result every EI_CLASSIFIER_SLICE_SIZE samples
+ */
+extern "C" int ei_main(void)
+{
+    ei_impulse_result_t result = {nullptr};
+    uint32_t nb_slices = 0;
+    uint32_t last_overruns = 0;
+
+    ei_printf("Edge Impulse continuous audio inferencing (ST STM32N6570-DK)\n");
+    ei_printf("SystemCoreClock: %ld\n", SystemCoreClock);
+    ei_printf("Slice: %d samples, %d slices per model window\n",
+            EI_CLASSIFIER_SLICE_SIZE, EI_CLASSIFIER_SLICES_PER_MODEL_WINDOW);
+
+    run_classifier_init();
+
+    if (audio_start() != 0) {
+        ei_printf("Failed to start the microphone\n");
+        return 1;
+    }
+
+    signal_t slice_signal;
+    slice_signal.total_length = EI_CLASSIFIER_SLICE_SIZE;
+    slice_signal.get_data = &audio_slice_get_data;
+
+    do {
+        slice_classified = audio_slice_wait();
+
+        // MFCC of the new slice only, the features of the previous slices are reused
+        EI_IMPULSE_ERROR res = run_classifier_continuous(&slice_signal, &result, false, true);
+
+        if (res != 0) {
+            ei_printf("Error while running classifier: %d\n", res);
+            return 1;
+        }
+
+        if (++nb_slices % EI_CLASSIFIER_SLICES_PER_MODEL_WINDOW == 0) {
+            display_results(&ei_default_impulse, &result);
+            if (nb_overruns != last_overruns) {
+                last_overruns = nb_overruns;
+                ei_printf("Audio overruns: %lu\n", last_overruns);
+            }
+        }
+    } while (1);
+
+    return 0;
+}
+
+#else
 /* Private variables ------------------------------------------------------- */
 static const float features[] = {
     // copy raw features here
@@ -85,3 +249,5 @@ extern "C" int ei_main(void)
 
     return  0;
 }
+
+#endif /* EI_CONTINUOUS_AUDIO */
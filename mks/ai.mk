@@ -6,13 +6,18 @@ C_SOURCES_AI += $(AI_REL_DIR)/Npu/ll_aton/ll_aton_debug.c
 C_SOURCES_AI += $(AI_REL_DIR)/Npu/ll_aton/ll_aton_lib.c
 C_SOURCES_AI += $(AI_REL_DIR)/Npu/ll_aton/ll_aton_lib_sw_operators.c
 C_SOURCES_AI += $(AI_REL_DIR)/Npu/ll_aton/ll_aton_rt_main.c
+C_SOURCES_AI += $(AI_REL_DIR)/Npu/ll_aton/ll_aton_rt_scheduler.c
+C_SOURCES_AI += $(AI_REL_DIR)/Npu/ll_aton/ll_aton_dma_copy.c
+C_SOURCES_AI += $(AI_REL_DIR)/Npu/ll_aton/ll_aton_cache_batch.c
 C_SOURCES_AI += $(AI_REL_DIR)/Npu/ll_aton/ll_aton_runtime.c
 C_SOURCES_AI += $(AI_REL_DIR)/Npu/ll_aton/ll_aton_util.c
 C_SOURCES_AI += $(AI_REL_DIR)/Npu/ll_aton/ll_sw_float.c
 C_SOURCES_AI += $(AI_REL_DIR)/Npu/ll_aton/ll_sw_integer.c
+C_SOURCES_AI += $(AI_REL_DIR)/Npu/ll_aton/ll_sw_kernels.c
 C_SOURCES_AI += $(AI_REL_DIR)/Npu/Devices/STM32N6XX/npu_cache.c
 C_SOURCES_AI += $(AI_REL_DIR)/Npu/Devices/STM32N6XX/mcu_cache.c
 C_SOURCES_AI += $(PP_REL_DIR)/lib_objdetect_pp/Src/objdetect_pp.c
+C_SOURCES_AI += $(PP_REL_DIR)/lib_objdetect_pp/Src/objdetect_pp_nms.c
 C_SOURCES_AI += $(PP_REL_DIR)/lib_objdetect_pp/Src/objdetect_pp_yolov2.c
 C_SOURCES_AI += $(PP_REL_DIR)/lib_objdetect_pp/Src/objdetect_pp_yolov5.c
 C_SOURCES_AI += $(PP_REL_DIR)/lib_objdetect_pp/Src/objdetect_pp_yolov8.c
@@ -29,6 +34,14 @@ C_DEFS_AI += -DLL_ATON_RT_MODE=LL_ATON_RT_ASYNC
 C_DEFS_AI += -DLL_ATON_SW_FALLBACK
 C_DEFS_AI += -DTX_HAS_PARALLEL_NETWORKS=0
 
+# Native kernels of the SW fallback operators, one step away from the generic layers next to a half (ll_sw_kernels.h)
+LL_SW_NATIVE_KERNELS ?= 0
+C_DEFS_AI += -DLL_SW_NATIVE_KERNELS=$(LL_SW_NATIVE_KERNELS)
+
+# Coalescing of the cache cleans of the SW and end of epoch blocks (ll_aton_cache_batch.h)
+LL_ATON_CACHE_BATCH ?= 0
+C_DEFS_AI += -DLL_ATON_CACHE_BATCH=$(LL_ATON_CACHE_BATCH)
+
 C_SOURCES += $(C_SOURCES_AI)
 C_INCLUDES += $(C_INCLUDES_AI)
 C_DEFS += $(C_DEFS_AI)
@@ -3,6 +3,7 @@ ISP_REL_DIR := $(CMW_REL_DIR)/ISP_Library
 
 C_SOURCES_CMW += $(CMW_REL_DIR)/cmw_camera.c
 C_SOURCES_CMW += $(CMW_REL_DIR)/cmw_utils.c
+C_SOURCES_CMW += $(CMW_REL_DIR)/cmw_frame_ring.c
 C_SOURCES_CMW += $(CMW_REL_DIR)/sensors/cmw_vd55g1.c
 C_SOURCES_CMW += $(CMW_REL_DIR)/sensors/vd55g1/vd55g1.c
 C_SOURCES_CMW += $(CMW_REL_DIR)/sensors/cmw_ov5640.c
@@ -41,3 +41,21 @@ C_DEFS += -DEI_PORTING_STM32_CUBEAI
 C_DEFS += -DEI_TENSOR_ARENA_LOCATION=".tensor_arena_buf"
 C_DEFS += -DEI_CLASSIFIER_ALLOCATION_STATIC
 C_DEFS += -DUSE_NS_TIMER=1
+
+# Continuous audio classification from the digital microphones (MDF), instead of the static features
+EI_CONTINUOUS_AUDIO ?= 0
+ifeq ($(EI_CONTINUOUS_AUDIO), 1)
+C_DEFS += -DEI_CONTINUOUS_AUDIO=1
+# Inferences per model window, the features of the previous slices are kept (SDK default is 4)
+ifdef EI_SLICES_PER_MODEL_WINDOW
+C_DEFS += -DEI_CLASSIFIER_SLICES_PER_MODEL_WINDOW=$(EI_SLICES_PER_MODEL_WINDOW)
+endif
+C_SOURCES += STM32Cube_FW_N6/Drivers/STM32N6xx_HAL_Driver/Src/stm32n6xx_hal_dma.c
+C_SOURCES += STM32Cube_FW_N6/Drivers/STM32N6xx_HAL_Driver/Src/stm32n6xx_hal_dma_ex.c
+C_SOURCES += STM32Cube_FW_N6/Drivers/STM32N6xx_HAL_Driver/Src/stm32n6xx_hal_mdf.c
+C_SOURCES += STM32Cube_FW_N6/Drivers/STM32N6xx_HAL_Driver/Src/stm32n6xx_hal_sai.c
+C_SOURCES += STM32Cube_FW_N6/Drivers/STM32N6xx_HAL_Driver/Src/stm32n6xx_hal_sai_ex.c
+C_SOURCES += STM32Cube_FW_N6/Drivers/BSP/STM32N6570-DK/stm32n6570_discovery_audio.c
+C_SOURCES += STM32Cube_FW_N6/Drivers/BSP/Components/wm8904/wm8904.c
+C_SOURCES += STM32Cube_FW_N6/Drivers/BSP/Components/wm8904/wm8904_reg.c
+endif
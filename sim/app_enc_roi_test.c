@@ -0,0 +1,421 @@
+/**
+ ******************************************************************************
+ * @file    app_enc_roi_test.c
+ * @author  GPM Application Team
+ * @brief   Host test of the detection driven ROI map of the H.264 encoder:
+ *          random boxes are rasterised by app_enc_roi and compared with a
+ *          per macroblock reference (overlap priority, padding, field of
+ *          view, hold time), the map is checked to reach the encoder each
+ *          time it changes. Also reports the cost of an update.
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "app_enc_roi.h"
+
+#define MAX_WIDTH 1920
+#define MAX_HEIGHT 1088
+#define MAX_NB_MB APP_ENC_ROI_NB_MB(MAX_WIDTH, MAX_HEIGHT)
+#define MAX_BOXES 32
+#define NB_CLASSES 6
+#define NB_FRAMES 200
+/* Box edges closer than this to a macroblock edge are moved: float rounding may put them on either side */
+#define EDGE_MARGIN 1e-3
+
+static uint32_t nb_checks;
+static uint32_t nb_failures;
+
+#define CHECK(_cond) \
+  do \
+  { \
+    nb_checks++; \
+    if (!(_cond)) \
+    { \
+      if (nb_failures++ < 10) \
+      { \
+        printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #_cond); \
+      } \
+    } \
+  } while (0)
+
+static uint32_t seed = 0x2545F491;
+
+static uint8_t map[MAX_NB_MB];
+static uint8_t age[MAX_NB_MB];
+static uint8_t ref_map[MAX_NB_MB];
+static int32_t ref_last_frame[MAX_NB_MB];
+static uint8_t ref_last_index[MAX_NB_MB];
+static postprocess_outBuffer_t boxes[MAX_BOXES];
+
+/* Encoder stand-in: keeps the last map it was given */
+static H264EncInst encoder_inst = (H264EncInst)&seed;
+static uint8_t encoder_map[MAX_NB_MB];
+static uint32_t encoder_nb_maps;
+static H264EncRet encoder_ret = H264ENC_OK;
+
+H264EncRet H264EncSetRoiMap(H264EncInst inst, u8 *pMap)
+{
+  CHECK(inst == encoder_inst);
+  if (encoder_ret == H264ENC_OK)
+  {
+    memcpy(encoder_map, pMap, sizeof(encoder_map));
+    encoder_nb_maps++;
+  }
+
+  return encoder_ret;
+}
+
+static uint32_t rand_u32(void)
+{
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+
+  return seed;
+}
+
+/* Uniform in [0, 1) */
+static float rand_f(void)
+{
+  return (float)(rand_u32() >> 8) / (float)(1U << 24);
+}
+
+static uint64_t time_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int near_mb_edge(double pos)
+{
+  return fabs(pos - round(pos)) < EDGE_MARGIN;
+}
+
+/* Padded box in the picture, in macroblocks */
+static void box_to_mb(const app_enc_roi_conf_t *pConf, const postprocess_outBuffer_t *pBox, double *px0, double *px1,
+                      double *py0, double *py1)
+{
+  double half_w = pBox->width * (0.5 + pConf->padding);
+  double half_h = pBox->height * (0.5 + pConf->padding);
+
+  *px0 = (pConf->fov_x + (pBox->x_center - half_w) * pConf->fov_w) * pConf->width / APP_ENC_ROI_MB_SIZE;
+  *px1 = (pConf->fov_x + (pBox->x_center + half_w) * pConf->fov_w) * pConf->width / APP_ENC_ROI_MB_SIZE;
+  *py0 = (pConf->fov_y + (pBox->y_center - half_h) * pConf->fov_h) * pConf->height / APP_ENC_ROI_MB_SIZE;
+  *py1 = (pConf->fov_y + (pBox->y_center + half_h) * pConf->fov_h) * pConf->height / APP_ENC_ROI_MB_SIZE;
+}
+
+/* Box in the network input, some of them across the border or without size (centroid models) */
+static void random_box(const app_enc_roi_conf_t *pConf, postprocess_outBuffer_t *pBox)
+{
+  double x0, x1, y0, y1;
+
+  do
+  {
+    memset(pBox, 0, sizeof(*pBox));
+    pBox->x_center = 1.2f * rand_f() - 0.1f;
+    pBox->y_center = 1.2f * rand_f() - 0.1f;
+    if ((rand_u32() % 8) != 0)
+    {
+      pBox->width = 0.4f * rand_f();
+      pBox->height = 0.4f * rand_f();
+    }
+    pBox->conf = rand_f();
+    pBox->class_index = (int32_t)(rand_u32() % (NB_CLASSES + 1)) - ((rand_u32() % 16) == 0);
+    box_to_mb(pConf, pBox, &x0, &x1, &y0, &y1);
+  } while (near_mb_edge(x0) || near_mb_edge(x1) || near_mb_edge(y0) || near_mb_edge(y1));
+}
+
+static int32_t ref_qp_delta(const app_enc_roi_conf_t *pConf, uint8_t index)
+{
+  return (index == 0) ? 0 : pConf->qp_delta[index - 1];
+}
+
+static int32_t ref_clamp(double pos, uint32_t nb_mb)
+{
+  return (pos <= 0) ? 0 : (pos >= nb_mb) ? (int32_t)nb_mb : (int32_t)pos;
+}
+
+/* Reference rasterisation, per macroblock: the covering box of lowest QP delta, the first one on a tie */
+static uint32_t ref_update(const app_enc_roi_conf_t *pConf, const postprocess_out_t *pOutput, int32_t frame)
+{
+  uint32_t mb_per_row = (pConf->width + APP_ENC_ROI_MB_SIZE - 1) / APP_ENC_ROI_MB_SIZE;
+  uint32_t mb_per_col = (pConf->height + APP_ENC_ROI_MB_SIZE - 1) / APP_ENC_ROI_MB_SIZE;
+  uint32_t nb_boxes = 0;
+
+  for (int32_t i = 0; i < pOutput->nb_detect; i++)
+  {
+    const postprocess_outBuffer_t *pBox = &pOutput->pOutBuff[i];
+    double x0, x1, y0, y1;
+    int32_t mx0, mx1, my0, my1;
+    uint8_t index;
+
+    if ((pBox->conf < pConf->conf_threshold) || (pBox->class_index < 0) || (pBox->class_index >= NB_CLASSES))
+    {
+      continue;
+    }
+    index = pConf->class_index[pBox->class_index];
+    if (index == pConf->background_index)
+    {
+      continue;
+    }
+
+    box_to_mb(pConf, pBox, &x0, &x1, &y0, &y1);
+    mx0 = ref_clamp(floor(x0), mb_per_row);
+    mx1 = ref_clamp(ceil(x1), mb_per_row);
+    my0 = ref_clamp(floor(y0), mb_per_col);
+    my1 = ref_clamp(ceil(y1), mb_per_col);
+    if ((mx1 == mx0) && (mx0 < (int32_t)mb_per_row))
+    {
+      mx1++;
+    }
+    if ((my1 == my0) && (my0 < (int32_t)mb_per_col))
+    {
+      my1++;
+    }
+    if ((mx1 <= mx0) || (my1 <= my0))
+    {
+      continue;
+    }
+    nb_boxes++;
+
+    for (int32_t y = my0; y < my1; y++)
+    {
+      for (int32_t x = mx0; x < mx1; x++)
+      {
+        uint32_t mb = y * mb_per_row + x;
+
+        if ((ref_last_frame[mb] == frame) &&
+            (ref_qp_delta(pConf, ref_last_index[mb]) <= ref_qp_delta(pConf, index)))
+        {
+          continue;
+        }
+        ref_last_frame[mb] = frame;
+        ref_last_index[mb] = index;
+      }
+    }
+  }
+
+  for (uint32_t mb = 0; mb < mb_per_row * mb_per_col; mb++)
+  {
+    ref_map[mb] = (frame - ref_last_frame[mb] <= pConf->hold_frames) ? ref_last_index[mb] : pConf->background_index;
+  }
+
+  return nb_boxes;
+}
+
+static void test_init(void)
+{
+  static const uint8_t class_index[NB_CLASSES] = {0};
+  app_enc_roi_conf_t conf = {
+    .width = 640, .height = 480, .fov_w = 1.0f, .fov_h = 1.0f,
+    .class_index = class_index, .nb_classes = NB_CLASSES, .qp_delta = {-8, -30, 30},
+  };
+  app_enc_roi_conf_t bad;
+  app_enc_roi_t roi;
+  H264EncCodingCtrl ctrl;
+
+  CHECK(app_enc_roi_init(&roi, &conf, map, age) == 0);
+  CHECK((roi.mb_per_row == 40) && (roi.mb_per_col == 30));
+  CHECK(roi.nb_roi_mb[0] == 40 * 30);
+  CHECK(roi.changed);
+
+  memset(&ctrl, 0, sizeof(ctrl));
+  ctrl.roi1Area.enable = 1;
+  ctrl.adaptiveRoi = -10;
+  app_enc_roi_coding_ctrl(&roi, &ctrl);
+  CHECK(ctrl.roiMapEnable == 1);
+  CHECK((ctrl.roi1Area.enable == 0) && (ctrl.roi2Area.enable == 0) && (ctrl.adaptiveRoi == 0));
+  CHECK((ctrl.qpOffset[0] == -8) && (ctrl.qpOffset[1] == -30) && (ctrl.qpOffset[2] == 30));
+
+  bad = conf;
+  bad.width = 0;
+  CHECK(app_enc_roi_init(&roi, &bad, map, age) != 0);
+  bad = conf;
+  bad.fov_h = 0.0f;
+  CHECK(app_enc_roi_init(&roi, &bad, map, age) != 0);
+  bad = conf;
+  bad.hold_frames = UINT8_MAX;
+  CHECK(app_enc_roi_init(&roi, &bad, map, age) != 0);
+  bad = conf;
+  bad.background_index = APP_ENC_ROI_NB_INDEX;
+  CHECK(app_enc_roi_init(&roi, &bad, map, age) != 0);
+  bad = conf;
+  bad.class_index = NULL;
+  CHECK(app_enc_roi_init(&roi, &bad, map, age) != 0);
+  bad = conf;
+  bad.qp_delta[0] = 8;
+  CHECK(app_enc_roi_init(&roi, &bad, map, age) != 0);
+  bad = conf;
+  bad.qp_delta[2] = -31;
+  CHECK(app_enc_roi_init(&roi, &bad, map, age) != 0);
+  CHECK(app_enc_roi_init(&roi, &conf, NULL, age) != 0);
+}
+
+/* A single box fully inside the picture, edges in the middle of the macroblocks */
+static void test_single_box(void)
+{
+  static const uint8_t class_index[NB_CLASSES] = {1, 0, 0, 0, 0, 0};
+  app_enc_roi_conf_t conf = {
+    .width = 320, .height = 240, .fov_w = 1.0f, .fov_h = 1.0f,
+    .class_index = class_index, .nb_classes = NB_CLASSES, .qp_delta = {-4, 0, 0},
+  };
+  /* Pixels [40, 120) x [56, 136): macroblocks [2, 8) x [3, 9) */
+  postprocess_outBuffer_t box = {
+    .x_center = 80.0f / 320, .y_center = 96.0f / 240, .width = 80.0f / 320, .height = 80.0f / 240, .conf = 0.9f,
+  };
+  postprocess_out_t output = {.pOutBuff = &box, .nb_detect = 1};
+  app_enc_roi_t roi;
+  uint32_t nb_roi = 0;
+
+  CHECK(app_enc_roi_init(&roi, &conf, map, age) == 0);
+  app_enc_roi_update(&roi, &output);
+  for (uint32_t y = 0; y < roi.mb_per_col; y++)
+  {
+    for (uint32_t x = 0; x < roi.mb_per_row; x++)
+    {
+      uint8_t expected = ((x >= 2) && (x < 8) && (y >= 3) && (y < 9)) ? 1 : 0;
+
+      CHECK(map[y * roi.mb_per_row + x] == expected);
+      nb_roi += expected;
+    }
+  }
+  CHECK(roi.nb_boxes == 1);
+  CHECK((roi.nb_roi_mb[1] == nb_roi) && (roi.nb_roi_mb[0] == 20 * 15 - nb_roi));
+
+  /* Held for hold_frames = 0 frames: back to the background at the next frame without detection */
+  output.nb_detect = 0;
+  app_enc_roi_update(&roi, &output);
+  CHECK(roi.nb_roi_mb[0] == 20 * 15);
+}
+
+/* Random sequences: the map follows the reference frame by frame and reaches the encoder when it changed */
+static void test_sequence(uint32_t width, uint32_t height, float fov_x, float fov_y, float fov_w, float fov_h,
+                          float padding, uint8_t hold_frames, uint8_t background_index, const int8_t *qp_delta)
+{
+  const uint8_t class_index[NB_CLASSES] = {1, 2, 3, 1, background_index, 2};
+  app_enc_roi_conf_t conf = {
+    .width = width, .height = height, .fov_x = fov_x, .fov_y = fov_y, .fov_w = fov_w, .fov_h = fov_h,
+    .padding = padding, .conf_threshold = 0.3f, .hold_frames = hold_frames, .background_index = background_index,
+    .class_index = class_index, .nb_classes = NB_CLASSES, .qp_delta = {qp_delta[0], qp_delta[1], qp_delta[2]},
+  };
+  postprocess_out_t output = {.pOutBuff = boxes};
+  app_enc_roi_t roi;
+  uint32_t nb_mb = APP_ENC_ROI_NB_MB(width, height);
+  uint32_t nb_sent = 0, nb_roi = 0;
+
+  CHECK(app_enc_roi_init(&roi, &conf, map, age) == 0);
+  CHECK(app_enc_roi_apply(&roi, encoder_inst) == H264ENC_OK);
+  CHECK(memcmp(encoder_map, map, nb_mb) == 0);
+  for (uint32_t mb = 0; mb < nb_mb; mb++)
+  {
+    ref_last_frame[mb] = -1000;
+  }
+  encoder_nb_maps = 0;
+
+  for (int32_t frame = 0; frame < NB_FRAMES; frame++)
+  {
+    uint32_t counts[APP_ENC_ROI_NB_INDEX] = {0};
+    uint32_t nb_ref_boxes;
+
+    /* Some frames without detection exercise the hold time */
+    output.nb_detect = ((rand_u32() % 4) == 0) ? 0 : (int32_t)(rand_u32() % MAX_BOXES);
+    for (int32_t i = 0; i < output.nb_detect; i++)
+    {
+      random_box(&conf, &boxes[i]);
+    }
+
+    app_enc_roi_update(&roi, &output);
+    nb_ref_boxes = ref_update(&conf, &output, frame);
+    CHECK(memcmp(map, ref_map, nb_mb) == 0);
+    CHECK(roi.nb_boxes == nb_ref_boxes);
+    for (uint32_t mb = 0; mb < nb_mb; mb++)
+    {
+      counts[map[mb]]++;
+    }
+    CHECK(memcmp(counts, roi.nb_roi_mb, sizeof(counts)) == 0);
+    nb_roi += nb_mb - counts[background_index];
+
+    /* An unchanged map is not sent, a refused one is sent again at the next frame */
+    encoder_ret = (roi.changed && ((rand_u32() % 16) == 0)) ? H264ENC_ERROR : H264ENC_OK;
+    CHECK(app_enc_roi_apply(&roi, encoder_inst) == encoder_ret);
+    CHECK(roi.changed == (encoder_ret != H264ENC_OK));
+    if (encoder_ret == H264ENC_OK)
+    {
+      CHECK(memcmp(encoder_map, map, nb_mb) == 0);
+    }
+  }
+  encoder_ret = H264ENC_OK;
+  nb_sent = encoder_nb_maps;
+
+  printf("%4lux%-4lu fov (%.2f, %.2f, %.2f, %.2f), padding %.2f, hold %u: %4.1f%% of ROI macroblocks, "
+         "%lu maps sent in %u frames\n", (unsigned long)width, (unsigned long)height, fov_x, fov_y, fov_w, fov_h,
+         padding, hold_frames, 100.0 * nb_roi / ((double)nb_mb * NB_FRAMES), (unsigned long)nb_sent, NB_FRAMES);
+}
+
+static void bench_update(uint32_t width, uint32_t height, int32_t nb_detect)
+{
+  static const uint8_t class_index[NB_CLASSES] = {1, 2, 3, 1, 0, 2};
+  const uint32_t nb_runs = 2000;
+  app_enc_roi_conf_t conf = {
+    .width = width, .height = height, .fov_w = 1.0f, .fov_h = 1.0f, .padding = 0.1f, .hold_frames = 5,
+    .class_index = class_index, .nb_classes = NB_CLASSES, .qp_delta = {-6, -3, 5},
+  };
+  postprocess_out_t output = {.pOutBuff = boxes, .nb_detect = nb_detect};
+  app_enc_roi_t roi;
+  uint64_t t0, t;
+
+  CHECK(app_enc_roi_init(&roi, &conf, map, age) == 0);
+  for (int32_t i = 0; i < nb_detect; i++)
+  {
+    random_box(&conf, &boxes[i]);
+  }
+
+  t0 = time_ns();
+  for (uint32_t run = 0; run < nb_runs; run++)
+  {
+    app_enc_roi_update(&roi, &output);
+  }
+  t = time_ns() - t0;
+
+  printf("%4lux%-4lu %2ld boxes: update %.2f us (host)\n", (unsigned long)width, (unsigned long)height,
+         (long)nb_detect, t / 1e3 / nb_runs);
+}
+
+int main(void)
+{
+  static const int8_t qp_delta[] = {-6, -3, 5};
+  /* Index 1 and 2 on a tie: the first box wins */
+  static const int8_t qp_delta_tie[] = {-6, -6, 5};
+
+  test_init();
+  test_single_box();
+
+  test_sequence(320, 240, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0, 0, qp_delta);
+  test_sequence(1280, 720, 0.125f, 0.0f, 0.75f, 1.0f, 0.1f, 3, 0, qp_delta);
+  test_sequence(1920, 1080, 0.21875f, 0.0f, 0.5625f, 1.0f, 0.2f, 10, 3, qp_delta_tie);
+  test_sequence(800, 600, 0.1f, 0.05f, 0.8f, 0.9f, 0.05f, 254 - 1, 2, qp_delta);
+
+  bench_update(1280, 720, 10);
+  bench_update(1920, 1080, MAX_BOXES);
+
+  printf("app_enc_roi_test: %lu checks, %lu failures\n", (unsigned long)nb_checks, (unsigned long)nb_failures);
+
+  return nb_failures ? 1 : 0;
+}